@@ -24,6 +24,7 @@
 #include "core/filesystem/read_file_contents.hpp"
 #include "core/filesystem/write_to_file.hpp"
 #include "ledger/chain/block_db_record.hpp"
+#include "ledger/chain/block_store.hpp"
 #include "meta/log2.hpp"
 
 #include "storage/object_store.hpp"
@@ -45,7 +46,7 @@ struct BlockChain;
 
 using DIRPtr          = std::unique_ptr<DIR, DIRDeleter>;
 using LaneIdx         = uint64_t;
-using BlockStore      = ObjectStore<BlockDbRecord>;
+using BlockStore      = ledger::BlockStore;
 using TxStore         = ObjectStore<chain::Transaction>;
 using TxStores        = std::unordered_map<LaneIdx, TxStore>;
 using TxStoresPtr     = std::shared_ptr<TxStores>;
@@ -277,14 +278,14 @@ public:
   void SaveChainToDbStore(BlockChain const &chain, std::string const &suffix) const
   {
     BlockStore repaired_block_store;
-    repaired_block_store.New("chain_" + suffix + ".db", "chain_" + suffix + ".index.db");
+    repaired_block_store.New("chain_" + suffix);
 
     IterateChainBackward(chain, [&repaired_block_store](BlockNode const &node, BlockHash const &) {
-      repaired_block_store.Set(ResourceID{node.db_record.hash()}, node.db_record);
+      repaired_block_store.Add(node.db_record.block, node.db_record.next_hash);
       return true;
     });
 
-    repaired_block_store.Flush(false);
+    repaired_block_store.Flush();
 
     ChainHeadStore head_store{"chain_" + suffix + ".head.db"};
     head_store.SetHead(chain.leaf);
@@ -500,10 +501,16 @@ private:
                                     num_of_progress_steps};
 
     std::size_t count{0};
-    auto const  end{block_store.end()};
-    for (auto it{block_store.begin()}; it != end; ++it)
+    for (uint64_t index = 0; index < expected_number_of_blocks; ++index)
     {
-      BlockNode  new_node{*it, BlockNode::BlockChildren{}, true};
+      BlockDbRecord record{};
+      if (!block_store.GetByIndex(index, record))
+      {
+        std::cerr << "INCONSISTENCY: Unreadable Block! index: " << index << std::endl;
+        continue;
+      }
+
+      BlockNode  new_node{std::move(record), BlockNode::BlockChildren{}, true};
       auto const new_node_hash{new_node.db_record.hash()};
       auto       node_it{bch.find(new_node_hash)};
 
@@ -908,7 +915,7 @@ int main(int argc, char **argv)
   parser.Parse(argc, argv);
 
   BlockStore block_store;
-  block_store.Load("chain.db", "chain.index.db", false);
+  block_store.Load("chain", false);
 
   std::cout << "Blocks count reported by block db store: " << block_store.size() << std::endl;
 
@@ -37,6 +37,7 @@
 #include "logging/logging.hpp"
 #include "network/adapters.hpp"
 #include "network/peer.hpp"
+#include "network/tcp/local_socket.hpp"
 #include "network/uri.hpp"
 #include "settings.hpp"
 #include "shards/manifest.hpp"
@@ -272,6 +273,9 @@ int main(int argc, char **argv)
       // setting policy for critical signals
       shutdown_on_critical_failure = settings.graceful_failure.value();
 
+      // allow peers on this host to connect over Unix domain sockets (if configured to do so)
+      fetch::network::SetLocalSocketDirectory(settings.local_socket_dir.value());
+
       // create the bootrap monitor (if configued to do so)
       auto initial_peers = ToUriSet(settings.peers.value());
       auto bootstrap     = CreateBootstrap(settings, cfg, p2p_key, initial_peers);
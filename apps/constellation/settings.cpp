@@ -66,6 +66,7 @@ Settings::Settings()
   , peer_update_interval  {*this, "peers-update-cycle-ms",   0,                            "How fast to do peering updates"}
   , disable_signing       {*this, "disable-signing",         false,                        "Disable the signing of all network messages"}
   , kademlia_routing      {*this, "kademlia-routing",        true,                         "Controls if kademalia routing is used in the main P2P network"}
+  , local_socket_dir      {*this, "local-socket-dir",        "",                           "The directory for Unix domain sockets used by local:// peers (disabled when empty)"}
   , bootstrap             {*this, "bootstrap",               false,                        "Signal that we should connect to the bootstrap server"}
   , discoverable          {*this, "discoverable",            false,                        "Signal that this node can be advertised on the bootstrap server"}
   , hostname              {*this, "host-name",               "",                           "The hostname or identifier for this node"}
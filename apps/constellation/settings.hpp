@@ -78,6 +78,7 @@ public:
   settings::Setting<uint32_t>    peer_update_interval;
   settings::Setting<bool>        disable_signing;
   settings::Setting<bool>        kademlia_routing;
+  settings::Setting<std::string> local_socket_dir;
   /// @}
 
   /// @name Bootstrap Config
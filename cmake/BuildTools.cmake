@@ -282,6 +282,12 @@ function (add_fetch_gbench
 
       target_include_directories(${name} PRIVATE ${FETCH_ROOT_VENDOR_DIR}/benchmark/include)
 
+      get_filename_component(internal_headers_path "${CMAKE_CURRENT_SOURCE_DIR}/../internal"
+                             ABSOLUTE)
+      if (EXISTS ${internal_headers_path})
+        target_include_directories(${name} PRIVATE ${internal_headers_path})
+      endif ()
+
     endif ()
 
   endif (FETCH_ENABLE_BENCHMARKS)
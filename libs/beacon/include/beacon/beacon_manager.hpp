@@ -98,6 +98,8 @@ public:
   void          SetMessage(MessagePayload next_message);
   SignedMessage Sign();
 
+  std::vector<AddResult> AddSignatureParts(std::vector<SignedMessage> const &signed_messages);
+
   /// Property methods
   /// @{
   bool                           InQual(MuddleAddress const &address) const;
@@ -144,7 +144,7 @@ protected:
   std::deque<SharedAeonExecutionUnit> aeon_exe_queue_;
 
 private:
-  bool AddSignature(SignatureShare share);
+  void AddSignatures(std::vector<SignatureShare> const &shares);
 
   Identity         identity_;
   MuddleInterface &muddle_;
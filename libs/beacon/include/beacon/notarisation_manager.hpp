@@ -20,7 +20,10 @@
 #include "core/byte_array/const_byte_array.hpp"
 #include "crypto/mcl_dkg.hpp"
 
+#include <map>
 #include <mutex>
+#include <set>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -52,6 +55,8 @@ public:
   Signature          Sign(MessagePayload const &message);
   bool               Verify(MessagePayload const &message, Signature const &signature,
                             MuddleAddress const &member);
+  std::set<MuddleAddress> FindInvalidShares(
+      MessagePayload const &message, std::map<MuddleAddress, Signature> const &member_signatures);
   AggregateSignature ComputeAggregateSignature(
       std::unordered_map<MuddleAddress, Signature> const &cabinet_signatures);
   bool        VerifyAggregateSignature(MessagePayload const &    message,
@@ -22,6 +22,7 @@
 #include "network/generics/milli_timer.hpp"
 
 #include <mutex>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -601,6 +602,63 @@ BeaconManager::AddResult BeaconManager::AddSignaturePart(Identity const & from,
   return AddResult::SUCCESS;
 }
 
+/**
+ * @brief adds a collection of signature shares, verifying them together as a single batch.
+ * @param signed_messages are the signature parts and the identities of their senders.
+ * @return the result of adding each of the signature parts, in the same order.
+ */
+std::vector<BeaconManager::AddResult> BeaconManager::AddSignatureParts(
+    std::vector<SignedMessage> const &signed_messages)
+{
+  std::vector<AddResult>            results(signed_messages.size(), AddResult::SUCCESS);
+  std::vector<std::size_t>          candidates;
+  std::vector<CabinetIndex>         candidate_indices;
+  std::unordered_set<MuddleAddress> batch_senders;
+  crypto::mcl::SignedMessageShares  shares;
+
+  for (std::size_t i = 0; i < signed_messages.size(); ++i)
+  {
+    auto const &from = signed_messages[i].identity.identifier();
+    auto        it   = identity_to_index_.find(from);
+
+    if (it == identity_to_index_.end() || qual_.find(from) == qual_.end())
+    {
+      results[i] = AddResult::NOT_MEMBER;
+      continue;
+    }
+
+    if (already_signed_.find(from) != already_signed_.end() ||
+        batch_senders.find(from) != batch_senders.end())
+    {
+      results[i] = AddResult::SIGNATURE_ALREADY_ADDED;
+      continue;
+    }
+
+    batch_senders.insert(from);
+    candidates.push_back(i);
+    candidate_indices.push_back(it->second);
+    shares.emplace_back(public_key_shares_[it->second], current_message_,
+                        signed_messages[i].signature);
+  }
+
+  for (auto const invalid : crypto::mcl::FindInvalidSignatures(shares, GetGroupG()))
+  {
+    results[candidates[invalid]] = AddResult::INVALID_SIGNATURE;
+  }
+
+  for (std::size_t j = 0; j < candidates.size(); ++j)
+  {
+    auto const i = candidates[j];
+    if (results[i] == AddResult::SUCCESS)
+    {
+      signature_buffer_.insert({candidate_indices[j], signed_messages[i].signature});
+      already_signed_.insert(signed_messages[i].identity.identifier());
+    }
+  }
+
+  return results;
+}
+
 /**
  * @brief verifies the group signature.
  */
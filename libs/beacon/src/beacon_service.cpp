@@ -467,19 +467,35 @@ BeaconService::State BeaconService::OnVerifySignaturesState()
     auto &signatures_struct = signatures_being_built_[index];
     auto &all_sigs_map      = signatures_struct.threshold_signatures;
 
+    // Verify the shares in batches of the size needed to construct the group signature
+    std::size_t const           batch_size = active_exe_unit_->manager.polynomial_degree() + 1u;
+    std::vector<SignatureShare> batch;
+    batch.reserve(batch_size);
+
     for (auto const &address_sig_pair : ret.threshold_signatures)
     {
       all_sigs_map[address_sig_pair.first] = address_sig_pair.second;
-      // Let the manager know
-      AddSignature(address_sig_pair.second);
+      batch.push_back(address_sig_pair.second);
 
-      // If we have collected enough signatures already then break
-      if (active_exe_unit_->manager.can_verify())
+      if (batch.size() == batch_size)
       {
-        break;
+        // Let the manager know
+        AddSignatures(batch);
+        batch.clear();
+
+        // If we have collected enough signatures already then break
+        if (active_exe_unit_->manager.can_verify())
+        {
+          break;
+        }
       }
     }
 
+    if (!batch.empty())
+    {
+      AddSignatures(batch);
+    }
+
     FETCH_LOG_DEBUG(LOGGING_NAME, "After adding, we have ", all_sigs_map.size(),
                     " signatures. Round: ", index);
   }  // Mutex unlocks here since verification can take some time
@@ -548,45 +564,43 @@ BeaconService::State BeaconService::OnCompleteState()
   return State::WAIT_FOR_SETUP_COMPLETION;
 }
 
-bool BeaconService::AddSignature(SignatureShare share)
+void BeaconService::AddSignatures(std::vector<SignatureShare> const &shares)
 {
   assert(active_exe_unit_ != nullptr);
-  auto ret = active_exe_unit_->manager.AddSignaturePart(share.identity, share.signature);
+  auto const results = active_exe_unit_->manager.AddSignatureParts(shares);
 
-  // Checking that the signature is valid
-  if (ret == BeaconManager::AddResult::INVALID_SIGNATURE)
+  for (std::size_t i = 0; i < results.size(); ++i)
   {
-    FETCH_LOG_ERROR(LOGGING_NAME, "Signature invalid.");
-
-    EventInvalidSignature event;
-    // TODO(tfr): Received invalid signature - fill event details
-    event_manager_->Dispatch(event);
+    auto const &share = shares[i];
 
-    return false;
-  }
-  if (ret == BeaconManager::AddResult::NOT_MEMBER)
-  {  // And that it was sent by a member of the cabinet
-    FETCH_LOG_ERROR(LOGGING_NAME, "Signature from non-member! Identity: ",
-                    share.identity.identifier().ToBase64());
-
-    for (auto const &i : active_exe_unit_->manager.qual())
+    // Checking that the signature is valid
+    if (results[i] == BeaconManager::AddResult::INVALID_SIGNATURE)
     {
-      FETCH_LOG_INFO(LOGGING_NAME, "Note: qual is: ", i.ToBase64());
-    }
+      FETCH_LOG_ERROR(LOGGING_NAME, "Signature invalid.");
 
-    EventSignatureFromNonMember event;
-    // TODO(tfr): Received signature from non-member - deal with it.
-    event_manager_->Dispatch(event);
+      EventInvalidSignature event;
+      // TODO(tfr): Received invalid signature - fill event details
+      event_manager_->Dispatch(event);
+    }
+    else if (results[i] == BeaconManager::AddResult::NOT_MEMBER)
+    {  // And that it was sent by a member of the cabinet
+      FETCH_LOG_ERROR(LOGGING_NAME, "Signature from non-member! Identity: ",
+                      share.identity.identifier().ToBase64());
 
-    return false;
-  }
+      for (auto const &member : active_exe_unit_->manager.qual())
+      {
+        FETCH_LOG_INFO(LOGGING_NAME, "Note: qual is: ", member.ToBase64());
+      }
 
-  if (ret == BeaconManager::AddResult::SIGNATURE_ALREADY_ADDED)
-  {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Accidental duplicate signature added!");
+      EventSignatureFromNonMember event;
+      // TODO(tfr): Received signature from non-member - deal with it.
+      event_manager_->Dispatch(event);
+    }
+    else if (results[i] == BeaconManager::AddResult::SIGNATURE_ALREADY_ADDED)
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Accidental duplicate signature added!");
+    }
   }
-
-  return true;
 }
 
 std::weak_ptr<core::Runnable> BeaconService::GetWeakRunnable()
@@ -48,6 +48,42 @@ bool NotarisationManager::Verify(MessagePayload const &message, Signature const
                                  signature, GetGenerator());
 }
 
+/**
+ * Verifies the signature shares of several cabinet members on the same message as a single batch
+ *
+ * @param message Message that was signed
+ * @param member_signatures Map of cabinet member to their signature share
+ * @return The members whose signature shares are invalid
+ */
+std::set<NotarisationManager::MuddleAddress> NotarisationManager::FindInvalidShares(
+    MessagePayload const &message, std::map<MuddleAddress, Signature> const &member_signatures)
+{
+  std::set<MuddleAddress>          invalid_members;
+  std::vector<MuddleAddress>       batch_members;
+  crypto::mcl::SignedMessageShares shares;
+
+  for (auto const &member_signature : member_signatures)
+  {
+    auto it = identity_to_index_.find(member_signature.first);
+    if (it == identity_to_index_.end())
+    {
+      invalid_members.insert(member_signature.first);
+      continue;
+    }
+
+    batch_members.push_back(member_signature.first);
+    shares.emplace_back(cabinet_public_keys_[it->second].aggregate_public_key, message,
+                        member_signature.second);
+  }
+
+  for (auto const index : crypto::mcl::FindInvalidSignatures(shares, GetGenerator()))
+  {
+    invalid_members.insert(batch_members[index]);
+  }
+
+  return invalid_members;
+}
+
 NotarisationManager::AggregateSignature NotarisationManager::ComputeAggregateSignature(
     std::unordered_map<MuddleAddress, Signature> const &cabinet_signatures)
 {
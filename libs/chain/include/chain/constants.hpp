@@ -36,6 +36,9 @@ void   InitialiseTestConstants();
 extern uint64_t STAKE_WARM_UP_PERIOD;
 extern uint64_t STAKE_COOL_DOWN_PERIOD;
 
+// the block from which smart contracts write large values in the paged state representation
+extern uint64_t PAGED_STATE_ACTIVATION_HEIGHT;
+
 extern Digest const GENESIS_DIGEST_DEFAULT;
 extern Digest const GENESIS_MERKLE_ROOT_DEFAULT;
 
@@ -22,6 +22,7 @@
 #include "core/digest.hpp"
 #include "crypto/identity.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -132,6 +133,12 @@ public:
   Signatories const &   signatories() const;
   /// @}
 
+  /// @name Encoding
+  /// @{
+  ConstByteArray const &encoding() const;
+  void                  DetachFromBuffer();
+  /// @}
+
   /// @name Validation / Verification
   /// @{
   bool Verify();
@@ -164,9 +171,11 @@ private:
 
   /// @name Metadata
   /// @{
-  Digest digest_{};                       ///< The digest of the transaction
-  bool   verification_completed_{false};  ///< Signal that the verification has been done
-  bool   verified_{false};                ///< The cached result of the verification
+  Digest         digest_{};                       ///< The digest of the transaction
+  ConstByteArray encoding_{};                     ///< The serialised transaction (if known)
+  std::size_t    payload_size_{0};                ///< The size of the signed part of encoding_
+  bool           verification_completed_{false};  ///< Signal that the verification has been done
+  bool           verified_{false};                ///< The cached result of the verification
   /// @}
 
   // There are only two ways to generate a transaction, each from one of the two companion classes:
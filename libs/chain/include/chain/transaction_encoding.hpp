@@ -28,6 +28,46 @@ namespace fetch {
 namespace chain {
 namespace detail {
 
+constexpr uint8_t MAGIC              = 0xA1;
+constexpr uint8_t VERSION            = 3u;
+constexpr int8_t  UNIT_MEGA          = -2;
+constexpr int8_t  UNIT_KILO          = -1;
+constexpr int8_t  UNIT_DEFAULT       = 0;
+constexpr int8_t  UNIT_MILLI         = 1;
+constexpr int8_t  UNIT_MICRO         = 2;
+constexpr int8_t  UNIT_NANO          = 3;
+constexpr int8_t  CONTRACT_PRESENT   = 1;
+constexpr int8_t  CHAIN_CODE_PRESENT = 2;
+constexpr int8_t  SYNERGETIC_PRESENT = 3;
+
+/**
+ * Scale a charge rate which has been signalled with a charge unit
+ *
+ * @param charge_rate The charge rate as read from the wire
+ * @param charge_unit The charge unit signalled in the transaction
+ * @return The charge rate in the base unit
+ */
+inline uint64_t ApplyChargeUnit(uint64_t charge_rate, int8_t charge_unit)
+{
+  switch (charge_unit)
+  {
+  case UNIT_MEGA:
+    return charge_rate * 10000000000000000ull;
+  case UNIT_KILO:
+    return charge_rate * 10000000000000ull;
+  case UNIT_DEFAULT:
+    return charge_rate * 10000000000ull;
+  case UNIT_MILLI:
+    return charge_rate * 10000000ull;
+  case UNIT_MICRO:
+    return charge_rate * 10000ull;
+  case UNIT_NANO:
+    return charge_rate * 10ull;
+  default:
+    return charge_rate;
+  }
+}
+
 template <typename T>
 meta::IfIsUnsignedInteger<T, uint64_t> ToU64(T value)
 {
@@ -121,8 +161,9 @@ meta::IfIsSignedInteger<T, T> Negate(T value)
   return static_cast<T>(-value);
 }
 
-template <typename T>
-meta::IfIsInteger<T, T> DecodeInteger(fetch::serializers::MsgPackSerializer &buffer)
+// the buffer type only needs to provide ReadBytes(uint8_t *, std::size_t)
+template <typename T, typename Buffer = fetch::serializers::MsgPackSerializer>
+meta::IfIsInteger<T, T> DecodeInteger(Buffer &buffer)
 {
   // determine the traits of the output type
   constexpr bool        output_is_signed   = meta::IsSignedInteger<T>;
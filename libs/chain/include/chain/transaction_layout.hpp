@@ -25,6 +25,7 @@ namespace fetch {
 namespace chain {
 
 class Transaction;
+class TransactionView;
 
 /**
  * A Transaction Layout is a summary class that extracts certain subset of information
@@ -42,6 +43,7 @@ public:
   // Construction / Destruction
   TransactionLayout() = default;
   TransactionLayout(Transaction const &tx, uint32_t log2_num_lanes);
+  TransactionLayout(TransactionView const &tx, uint32_t log2_num_lanes);
   TransactionLayout(Digest digest, BitVector const &mask, TokenAmount charge_rate,
                     BlockIndex valid_from, BlockIndex valid_until);
   TransactionLayout(TransactionLayout const &) = default;
@@ -51,6 +51,7 @@ public:
 
   // Transaction Payload Serialisation
   static ByteArray SerializePayload(Transaction const &tx);
+  static ByteArray AppendSignatures(ByteArray payload, Transaction const &tx);
 
   /// @name  Serialisation / Deserialization
   /// @{
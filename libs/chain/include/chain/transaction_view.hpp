@@ -0,0 +1,147 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/digest.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace chain {
+
+/**
+ * A read-only view over a transaction in the wire format produced by the TransactionSerializer.
+ *
+ * Constructing the view makes a single pass over the encoded bytes which validates the structure
+ * and records the offset of each field. Fields are only decoded when they are accessed and byte
+ * array fields are returned as sub arrays of the encoded buffer. This allows paths that only need
+ * a small number of fields (for example the digest, validity window or shard mask) to avoid
+ * building a complete Transaction.
+ *
+ * The digest is computed on first access and cached, therefore a single view should not be shared
+ * between threads without external synchronisation.
+ */
+class TransactionView
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using TokenAmount    = Transaction::TokenAmount;
+  using BlockIndex     = Transaction::BlockIndex;
+  using Counter        = Transaction::Counter;
+  using ContractMode   = Transaction::ContractMode;
+  using Transfers      = Transaction::Transfers;
+  using Signatories    = Transaction::Signatories;
+
+  // Construction / Destruction
+  TransactionView() = default;
+  explicit TransactionView(ConstByteArray encoded);
+  TransactionView(TransactionView const &) = default;
+  TransactionView(TransactionView &&)      = default;
+  ~TransactionView()                       = default;
+
+  bool                  IsValid() const;
+  ConstByteArray const &encoded() const;
+  ConstByteArray        payload() const;
+
+  /// @name Identification
+  /// @{
+  Digest const &digest() const;
+  Counter       counter() const;
+  /// @}
+
+  /// @name Transfer Accessors
+  /// @{
+  Address     from() const;
+  std::size_t num_transfers() const;
+  Transfers   transfers() const;
+  /// @}
+
+  /// @name Validity Accessors
+  /// @{
+  BlockIndex valid_from() const;
+  BlockIndex valid_until() const;
+  /// @}
+
+  /// @name Charge Accessors
+  /// @{
+  TokenAmount charge_rate() const;
+  TokenAmount charge_limit() const;
+  /// @}
+
+  /// @name Contract Accessors
+  /// @{
+  ContractMode   contract_mode() const;
+  Address        contract_address() const;
+  ConstByteArray chain_code() const;
+  ConstByteArray action() const;
+  BitVector      shard_mask() const;
+  ConstByteArray data() const;
+  /// @}
+
+  /// @name Signatory Accessors
+  /// @{
+  std::size_t num_signatories() const;
+  Signatories signatories() const;
+  /// @}
+
+  bool ToTransaction(Transaction &tx) const;
+
+  // Operators
+  TransactionView &operator=(TransactionView const &) = default;
+  TransactionView &operator=(TransactionView &&) = default;
+
+private:
+  static constexpr std::size_t NOT_PRESENT = 0;
+
+  bool Parse();
+
+  ConstByteArray encoded_{};
+  bool           valid_{false};
+
+  /// @name Field Offsets
+  /// @{
+  std::size_t from_offset_{NOT_PRESENT};
+  std::size_t transfers_offset_{NOT_PRESENT};
+  std::size_t valid_from_offset_{NOT_PRESENT};
+  std::size_t valid_until_offset_{NOT_PRESENT};
+  std::size_t charge_rate_offset_{NOT_PRESENT};
+  std::size_t charge_unit_offset_{NOT_PRESENT};
+  std::size_t charge_limit_offset_{NOT_PRESENT};
+  std::size_t contract_header_offset_{NOT_PRESENT};
+  std::size_t contract_offset_{NOT_PRESENT};
+  std::size_t action_offset_{NOT_PRESENT};
+  std::size_t data_offset_{NOT_PRESENT};
+  std::size_t counter_offset_{NOT_PRESENT};
+  std::size_t signatories_offset_{NOT_PRESENT};
+  std::size_t signatures_offset_{NOT_PRESENT};
+  /// @}
+
+  std::size_t  num_transfers_{0};
+  std::size_t  num_signatories_{0};
+  ContractMode contract_mode_{ContractMode::NOT_PRESENT};
+
+  mutable Digest digest_{};
+};
+
+}  // namespace chain
+}  // namespace fetch
@@ -22,6 +22,8 @@
 #include "core/digest.hpp"
 #include "core/synchronisation/protected.hpp"
 
+#include <limits>
+
 namespace fetch {
 namespace chain {
 namespace {
@@ -108,6 +110,9 @@ void InitialiseTestConstants()
 uint64_t STAKE_WARM_UP_PERIOD   = 100;
 uint64_t STAKE_COOL_DOWN_PERIOD = 100;
 
+// disabled until an activation height has been agreed for the network
+uint64_t PAGED_STATE_ACTIVATION_HEIGHT = std::numeric_limits<uint64_t>::max();
+
 Digest const GENESIS_DIGEST_DEFAULT = FromBase64("0+++++++++++++++++Genesis+++++++++++++++++0=");
 Digest const GENESIS_MERKLE_ROOT_DEFAULT =
     FromBase64("AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=");
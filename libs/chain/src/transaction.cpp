@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 namespace fetch {
 namespace chain {
@@ -56,8 +57,16 @@ bool Transaction::Verify()
     // clear the verified flag
     verified_ = false;
 
-    // generate the payload for this transaction
-    ConstByteArray payload = TransactionSerializer::SerializePayload(*this);
+    // signatures are always checked against the canonical payload
+    ConstByteArray const payload = TransactionSerializer::SerializePayload(*this);
+
+    // a transaction received with a different, but decodable, payload encoding must not be relayed
+    // in that form, it is serialised again instead
+    if (!encoding_.empty() && (encoding_.SubArray(0, payload_size_) != payload))
+    {
+      encoding_     = ConstByteArray{};
+      payload_size_ = 0;
+    }
 
     // ensure that there are some signatories (otherwise it is invalid)
     if (!signatories_.empty())
@@ -260,6 +269,65 @@ Transaction::Signatories const &Transaction::signatories() const
   return signatories_;
 }
 
+/**
+ * Get the serialised form of this transaction. This is the exact encoding the transaction was
+ * received or built with, which allows it to be relayed and stored without being serialised again.
+ *
+ * @return The encoded transaction, or an empty array if this is not known
+ */
+Transaction::ConstByteArray const &Transaction::encoding() const
+{
+  return encoding_;
+}
+
+/**
+ * Release the buffer the transaction was decoded from, for transactions which are retained long
+ * term. The encoding and the variable length fields of a decoded transaction are views over the
+ * received buffer, which may hold many other transactions, so they are moved to a copy of the
+ * encoding.
+ */
+void Transaction::DetachFromBuffer()
+{
+  // transactions which have been built, or decoded from a buffer of their own, hold no views over
+  // other data
+  if (encoding_.empty() || (encoding_.capacity() == encoding_.size()))
+  {
+    return;
+  }
+
+  ConstByteArray const previous = encoding_;
+  ConstByteArray const encoding = previous.Copy();
+  auto const           begin    = reinterpret_cast<std::uintptr_t>(previous.pointer());
+
+  // point a view over the previous encoding at the same bytes of the copy
+  auto const rebase = [&](ConstByteArray const &value) -> ConstByteArray {
+    if (value.empty())
+    {
+      return value;
+    }
+
+    auto const address = reinterpret_cast<std::uintptr_t>(value.pointer());
+    if ((address < begin) || ((address - begin) + value.size() > encoding.size()))
+    {
+      return value;
+    }
+
+    return encoding.SubArray(address - begin, value.size());
+  };
+
+  chain_code_ = rebase(chain_code_);
+  action_     = rebase(action_);
+  data_       = rebase(data_);
+
+  for (auto &signatory : signatories_)
+  {
+    signatory.identity.SetIdentifier(rebase(signatory.identity.identifier()));
+    signatory.signature = rebase(signatory.signature);
+  }
+
+  encoding_ = encoding;
+}
+
 /**
  * Check to see if this transaction is verified
  *
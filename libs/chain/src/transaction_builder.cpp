@@ -135,7 +135,10 @@ TransactionBuilder::TransactionPtr TransactionBuilder::Sealer::Build()
   if (valid)
   {
     // generate the final transaction
-    partial_transaction_->digest_ = hash_function.Final();
+    partial_transaction_->digest_       = hash_function.Final();
+    partial_transaction_->payload_size_ = serialized_payload_.size();
+    partial_transaction_->encoding_ =
+        TransactionSerializer::AppendSignatures(serialized_payload_, *partial_transaction_);
 
     tx = std::move(partial_transaction_);
   }
@@ -18,6 +18,7 @@
 
 #include "chain/transaction.hpp"
 #include "chain/transaction_layout.hpp"
+#include "chain/transaction_view.hpp"
 #include "logging/logging.hpp"
 #include "storage/resource_mapper.hpp"
 
@@ -44,22 +45,21 @@ void UpdateMaskWithTokenAddress(BitVector &shards, Address const &address, uint3
   shards.set(resource_address.lane(log2_num_lanes), 1);
 }
 
-}  // namespace
-
 /**
- * Construct a transaction layout from the specified transaction
+ * Build the lane mask for a transaction, this accepts either a Transaction or a TransactionView
  *
- * @param tx The input transaction to be summarized
+ * @param tx The input transaction
+ * @param mask The output mask, already sized for the current number of lanes
+ * @param log2_num_lanes The log2 of the current number of lanes
  */
-TransactionLayout::TransactionLayout(Transaction const &tx, uint32_t log2_num_lanes)
-  : TransactionLayout(tx.digest(), BitVector{1u << log2_num_lanes}, tx.charge_rate(),
-                      tx.valid_from(), tx.valid_until())
+template <typename T>
+void UpdateMask(T const &tx, BitVector &mask, uint32_t log2_num_lanes)
 {
   // in the case where the transaction contains a contract call, ensure that the shard
   // mask is correctly mapped to the current number of lanes
   if (Transaction::ContractMode::NOT_PRESENT != tx.contract_mode())
   {
-    if (!tx.shard_mask().RemapTo(mask_))
+    if (!tx.shard_mask().RemapTo(mask))
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Unable to remap shard mask");
       return;
@@ -67,16 +67,43 @@ TransactionLayout::TransactionLayout(Transaction const &tx, uint32_t log2_num_la
   }
 
   // Every shard mask needs to be updated with the from address so that fees can be removed
-  UpdateMaskWithTokenAddress(mask_, tx.from(), log2_num_lanes);
+  UpdateMaskWithTokenAddress(mask, tx.from(), log2_num_lanes);
 
   // since the initial shard mask DOES NOT contain the shard information for the transfers these
   // must now be added.
   for (auto const &transfer : tx.transfers())
   {
-    UpdateMaskWithTokenAddress(mask_, transfer.to, log2_num_lanes);
+    UpdateMaskWithTokenAddress(mask, transfer.to, log2_num_lanes);
   }
 }
 
+}  // namespace
+
+/**
+ * Construct a transaction layout from the specified transaction
+ *
+ * @param tx The input transaction to be summarized
+ */
+TransactionLayout::TransactionLayout(Transaction const &tx, uint32_t log2_num_lanes)
+  : TransactionLayout(tx.digest(), BitVector{1u << log2_num_lanes}, tx.charge_rate(),
+                      tx.valid_from(), tx.valid_until())
+{
+  UpdateMask(tx, mask_, log2_num_lanes);
+}
+
+/**
+ * Construct a transaction layout directly from an encoded transaction, without decoding the
+ * signatures or payload data
+ *
+ * @param tx The view of the (valid) encoded transaction to be summarized
+ */
+TransactionLayout::TransactionLayout(TransactionView const &tx, uint32_t log2_num_lanes)
+  : TransactionLayout(tx.digest(), BitVector{1u << log2_num_lanes}, tx.charge_rate(),
+                      tx.valid_from(), tx.valid_until())
+{
+  UpdateMask(tx, mask_, log2_num_lanes);
+}
+
 /**
  * Construct a transaction layout from its constituent parts
  *
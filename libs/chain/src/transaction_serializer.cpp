@@ -47,17 +47,11 @@ using serializers::MsgPackSerializer;
 using TokenAmount  = Transaction::TokenAmount;
 using ContractMode = Transaction::ContractMode;
 
-const uint8_t MAGIC              = 0xA1;
-const uint8_t VERSION            = 3u;
-const int8_t  UNIT_MEGA          = -2;
-const int8_t  UNIT_KILO          = -1;
-const int8_t  UNIT_DEFAULT       = 0;
-const int8_t  UNIT_MILLI         = 1;
-const int8_t  UNIT_MICRO         = 2;
-const int8_t  UNIT_NANO          = 3;
-const int8_t  CONTRACT_PRESENT   = 1;
-const int8_t  CHAIN_CODE_PRESENT = 2;
-const int8_t  SYNERGETIC_PRESENT = 3;
+using detail::MAGIC;
+using detail::VERSION;
+using detail::CONTRACT_PRESENT;
+using detail::CHAIN_CODE_PRESENT;
+using detail::SYNERGETIC_PRESENT;
 
 uint8_t Map(ContractMode mode)
 {
@@ -371,18 +365,27 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
   return buffer;
 }
 
-bool TransactionSerializer::Serialize(Transaction const &tx)
+ByteArray TransactionSerializer::AppendSignatures(ByteArray payload, Transaction const &tx)
 {
-  // serialize the actual buffer
-  auto buffer = SerializePayload(tx);
-
   for (auto const &signatory : tx.signatories())
   {
-    buffer.Append(Encode(signatory.signature));
+    payload.Append(Encode(signatory.signature));
+  }
+
+  return payload;
+}
+
+bool TransactionSerializer::Serialize(Transaction const &tx)
+{
+  // transactions which have been received or built already carry their encoding
+  if (!tx.encoding_.empty())
+  {
+    serial_data_ = tx.encoding_;
+    return true;
   }
 
   // update the serial data
-  serial_data_ = std::move(buffer);
+  serial_data_ = AppendSignatures(SerializePayload(tx), tx);
 
   return true;
 }
@@ -393,6 +396,9 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
 
   std::size_t const payload_start = buffer.tell();
 
+  // the previous encoding no longer applies once decoding has started
+  tx.encoding_ = ConstByteArray{};
+
   // magic byte
   uint8_t const magic = ReadSingleByte(buffer);
   if (magic != MAGIC)
@@ -458,29 +464,7 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
     int8_t charge_unit{0};
     Decode(buffer, charge_unit);
 
-    switch (charge_unit)
-    {
-    case UNIT_MEGA:
-      tx.charge_rate_ *= 10000000000000000ull;
-      break;
-    case UNIT_KILO:
-      tx.charge_rate_ *= 10000000000000ull;
-      break;
-    case UNIT_DEFAULT:
-      tx.charge_rate_ *= 10000000000ull;
-      break;
-    case UNIT_MILLI:
-      tx.charge_rate_ *= 10000000ull;
-      break;
-    case UNIT_MICRO:
-      tx.charge_rate_ *= 10000ull;
-      break;
-    case UNIT_NANO:
-      tx.charge_rate_ *= 10ull;
-      break;
-    default:
-      break;
-    }
+    tx.charge_rate_ = detail::ApplyChargeUnit(tx.charge_rate_, charge_unit);
   }
 
   Decode(buffer, tx.charge_limit_);
@@ -599,6 +583,10 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
   // compute the hash function
   tx.digest_ = hash_function.Final();
 
+  // retain the encoding as a view over the received bytes so that it can be relayed as is
+  tx.encoding_     = serial_data_.SubArray(payload_start, buffer.tell() - payload_start);
+  tx.payload_size_ = payload_size;
+
   return true;
 }
 
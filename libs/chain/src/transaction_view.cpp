@@ -0,0 +1,606 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_encoding.hpp"
+#include "chain/transaction_serializer.hpp"
+#include "chain/transaction_view.hpp"
+#include "crypto/identity.hpp"
+#include "crypto/sha256.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace fetch {
+namespace chain {
+namespace {
+
+using byte_array::ConstByteArray;
+
+constexpr std::size_t IDENTITY_LENGTH = 64u;
+constexpr std::size_t COUNTER_LENGTH  = 8u;
+
+/**
+ * Minimal bounds checked reader over the encoded transaction. Unlike the MsgPackSerializer this
+ * never copies the underlying buffer, byte arrays are returned as sub arrays of the input.
+ */
+class Reader
+{
+public:
+  Reader(ConstByteArray const &encoded, std::size_t offset)
+    : encoded_{encoded}
+    , position_{offset}
+  {}
+
+  std::size_t tell() const
+  {
+    return position_;
+  }
+
+  uint8_t ReadByte()
+  {
+    Require(1u);
+    return encoded_[position_++];
+  }
+
+  void ReadBytes(uint8_t *data, std::size_t length)
+  {
+    Require(length);
+    encoded_.ReadBytes(data, length, position_);
+    position_ += length;
+  }
+
+  ConstByteArray ReadByteArray(std::size_t length)
+  {
+    Require(length);
+    auto value = encoded_.SubArray(position_, length);
+    position_ += length;
+    return value;
+  }
+
+  void Skip(std::size_t length)
+  {
+    Require(length);
+    position_ += length;
+  }
+
+private:
+  void Require(std::size_t length) const
+  {
+    if ((length > encoded_.size()) || (position_ > (encoded_.size() - length)))
+    {
+      throw std::runtime_error("Attempted read exceeds transaction size");
+    }
+  }
+
+  ConstByteArray const &encoded_;
+  std::size_t           position_;
+};
+
+template <typename T>
+T DecodeIntegerAt(ConstByteArray const &encoded, std::size_t offset)
+{
+  Reader reader{encoded, offset};
+  return detail::DecodeInteger<T>(reader);
+}
+
+ConstByteArray DecodeByteArray(Reader &reader)
+{
+  return reader.ReadByteArray(detail::DecodeInteger<std::size_t>(reader));
+}
+
+Address DecodeAddress(Reader &reader)
+{
+  Address::RawAddress raw_address;
+  reader.ReadBytes(raw_address.data(), raw_address.size());
+
+  return Address{raw_address};
+}
+
+void SkipInteger(Reader &reader)
+{
+  uint8_t const initial_byte = reader.ReadByte();
+
+  // single byte encodings: small positive values and small negative values
+  if (((initial_byte & 0x80u) == 0) || (((initial_byte >> 5u) & 0x3u) == 3u))
+  {
+    return;
+  }
+
+  uint8_t const log2_value_length = initial_byte & 0xfu;
+  if (log2_value_length > 3u)
+  {
+    throw std::runtime_error("Invalid integer encoding");
+  }
+
+  reader.Skip(std::size_t{1} << log2_value_length);
+}
+
+void SkipByteArray(Reader &reader)
+{
+  reader.Skip(detail::DecodeInteger<std::size_t>(reader));
+}
+
+}  // namespace
+
+/**
+ * Construct a view over an encoded transaction
+ *
+ * @param encoded The transaction in the TransactionSerializer wire format
+ */
+TransactionView::TransactionView(ConstByteArray encoded)
+  : encoded_{std::move(encoded)}
+{
+  try
+  {
+    valid_ = Parse();
+  }
+  catch (std::exception const &)
+  {
+    valid_ = false;
+  }
+}
+
+/**
+ * Determine if the encoded bytes contain a well formed transaction. The other accessors must only
+ * be used when this is the case.
+ *
+ * @return true if the view is valid, otherwise false
+ */
+bool TransactionView::IsValid() const
+{
+  return valid_;
+}
+
+/**
+ * Get the complete encoded transaction (payload and signatures)
+ *
+ * @return The encoded transaction
+ */
+TransactionView::ConstByteArray const &TransactionView::encoded() const
+{
+  return encoded_;
+}
+
+/**
+ * Get the signed portion of the encoded transaction
+ *
+ * @return The transaction payload
+ */
+TransactionView::ConstByteArray TransactionView::payload() const
+{
+  assert(valid_);
+  return encoded_.SubArray(0, signatures_offset_);
+}
+
+/**
+ * Get the digest of the transaction, computing it on first access
+ *
+ * @return The transaction digest
+ */
+Digest const &TransactionView::digest() const
+{
+  assert(valid_);
+
+  if (digest_.empty())
+  {
+    crypto::SHA256 hash_function{};
+    hash_function.Update(payload());
+    digest_ = hash_function.Final();
+  }
+
+  return digest_;
+}
+
+TransactionView::Counter TransactionView::counter() const
+{
+  assert(valid_);
+
+  Counter value{0};
+  for (std::size_t i = 0; i < COUNTER_LENGTH; ++i)
+  {
+    value = (value << 8u) | encoded_[counter_offset_ + i];
+  }
+
+  return value;
+}
+
+Address TransactionView::from() const
+{
+  assert(valid_);
+
+  Reader reader{encoded_, from_offset_};
+  return DecodeAddress(reader);
+}
+
+std::size_t TransactionView::num_transfers() const
+{
+  return num_transfers_;
+}
+
+TransactionView::Transfers TransactionView::transfers() const
+{
+  assert(valid_);
+
+  Transfers transfers(num_transfers_);
+  if (num_transfers_ > 0)
+  {
+    Reader reader{encoded_, transfers_offset_};
+    for (auto &transfer : transfers)
+    {
+      transfer.to     = DecodeAddress(reader);
+      transfer.amount = detail::DecodeInteger<TokenAmount>(reader);
+    }
+  }
+
+  return transfers;
+}
+
+TransactionView::BlockIndex TransactionView::valid_from() const
+{
+  assert(valid_);
+
+  if (NOT_PRESENT == valid_from_offset_)
+  {
+    return 0;
+  }
+
+  return DecodeIntegerAt<BlockIndex>(encoded_, valid_from_offset_);
+}
+
+TransactionView::BlockIndex TransactionView::valid_until() const
+{
+  assert(valid_);
+  return DecodeIntegerAt<BlockIndex>(encoded_, valid_until_offset_);
+}
+
+TransactionView::TokenAmount TransactionView::charge_rate() const
+{
+  assert(valid_);
+
+  auto const charge_rate = DecodeIntegerAt<TokenAmount>(encoded_, charge_rate_offset_);
+  if (NOT_PRESENT == charge_unit_offset_)
+  {
+    return charge_rate;
+  }
+
+  return detail::ApplyChargeUnit(charge_rate, DecodeIntegerAt<int8_t>(encoded_, charge_unit_offset_));
+}
+
+TransactionView::TokenAmount TransactionView::charge_limit() const
+{
+  assert(valid_);
+  return DecodeIntegerAt<TokenAmount>(encoded_, charge_limit_offset_);
+}
+
+TransactionView::ContractMode TransactionView::contract_mode() const
+{
+  return contract_mode_;
+}
+
+Address TransactionView::contract_address() const
+{
+  assert(valid_);
+
+  if ((ContractMode::PRESENT != contract_mode_) && (ContractMode::SYNERGETIC != contract_mode_))
+  {
+    return {};
+  }
+
+  Reader reader{encoded_, contract_offset_};
+  return DecodeAddress(reader);
+}
+
+TransactionView::ConstByteArray TransactionView::chain_code() const
+{
+  assert(valid_);
+
+  if (ContractMode::CHAIN_CODE != contract_mode_)
+  {
+    return {};
+  }
+
+  Reader reader{encoded_, contract_offset_};
+  return DecodeByteArray(reader);
+}
+
+TransactionView::ConstByteArray TransactionView::action() const
+{
+  assert(valid_);
+
+  if (NOT_PRESENT == action_offset_)
+  {
+    return {};
+  }
+
+  Reader reader{encoded_, action_offset_};
+  return DecodeByteArray(reader);
+}
+
+/**
+ * Decode the shard mask from the contract header
+ *
+ * @return The shard mask signalled in the transaction (empty for a wildcard or no contract)
+ */
+BitVector TransactionView::shard_mask() const
+{
+  assert(valid_);
+
+  BitVector mask{};
+  if (NOT_PRESENT == contract_header_offset_)
+  {
+    return mask;
+  }
+
+  uint8_t const contract_header = encoded_[contract_header_offset_];
+
+  bool const wildcard_flag = (contract_header & 0x80u) != 0u;
+  if (wildcard_flag)
+  {
+    return mask;
+  }
+
+  bool const extended_shard_mask_flag = (contract_header & 0x40u) != 0u;
+  if (!extended_shard_mask_flag)
+  {
+    bool const shard_is_4bits = (contract_header & 0x10u) != 0u;
+
+    mask.Resize(shard_is_4bits ? 4u : 2u);
+    for (std::size_t i = 0, num_bits = mask.size(); i < num_bits; ++i)
+    {
+      mask.set(i, static_cast<uint64_t>((contract_header & (1u << i)) > 0));
+    }
+  }
+  else
+  {
+    std::size_t const shard_mask_length_bits =
+        1u << (static_cast<std::size_t>(contract_header & 0x3fu) + 3u);
+
+    mask.Resize(shard_mask_length_bits);
+
+    // the mask bytes are stored most significant first, mirroring the serializer
+    auto *            raw_data   = reinterpret_cast<uint8_t *>(mask.data().pointer());
+    std::size_t const raw_length = mask.data().size() * sizeof(BitVector::Block);
+    std::size_t const size_bytes = mask.size() >> 3u;
+    std::size_t const offset     = (raw_length - size_bytes) + 1;
+    std::size_t const start      = contract_header_offset_ + 1u;
+
+    for (std::size_t i = 0, j = raw_length - offset; i < size_bytes; ++i, --j)
+    {
+      raw_data[j] = encoded_[start + i];
+    }
+  }
+
+  return mask;
+}
+
+TransactionView::ConstByteArray TransactionView::data() const
+{
+  assert(valid_);
+
+  if (NOT_PRESENT == data_offset_)
+  {
+    return {};
+  }
+
+  Reader reader{encoded_, data_offset_};
+  return DecodeByteArray(reader);
+}
+
+std::size_t TransactionView::num_signatories() const
+{
+  return num_signatories_;
+}
+
+TransactionView::Signatories TransactionView::signatories() const
+{
+  assert(valid_);
+
+  Signatories signatories(num_signatories_);
+
+  Reader identities{encoded_, signatories_offset_};
+  Reader signatures{encoded_, signatures_offset_};
+  for (auto &signatory : signatories)
+  {
+    // skip the signature scheme identifier, this has already been validated
+    identities.Skip(1u);
+
+    signatory.identity  = crypto::Identity{identities.ReadByteArray(IDENTITY_LENGTH)};
+    signatory.address   = Address{signatory.identity};
+    signatory.signature = DecodeByteArray(signatures);
+  }
+
+  return signatories;
+}
+
+/**
+ * Fully decode the viewed transaction
+ *
+ * @param tx The output transaction
+ * @return true if successful, otherwise false
+ */
+bool TransactionView::ToTransaction(Transaction &tx) const
+{
+  if (!valid_)
+  {
+    return false;
+  }
+
+  TransactionSerializer serializer{encoded_};
+  return serializer.Deserialize(tx);
+}
+
+/**
+ * Walk the encoded transaction recording the offset of each of the fields. This follows the same
+ * layout as TransactionSerializer::Deserialize without decoding any of the field values.
+ *
+ * @return true if the encoded transaction is well formed, otherwise false
+ */
+bool TransactionView::Parse()
+{
+  Reader reader{encoded_, 0};
+
+  if (reader.ReadByte() != detail::MAGIC)
+  {
+    return false;
+  }
+
+  // header byte 1
+  uint8_t const header1                 = reader.ReadByte();
+  uint8_t const version                 = (header1 >> 5u) & 0x7u;
+  uint8_t const charge_unit_flag        = (header1 >> 3u) & 0x1u;
+  uint8_t const transfer_flag           = (header1 >> 2u) & 0x1u;
+  uint8_t const multiple_transfers_flag = (header1 >> 1u) & 0x1u;
+  uint8_t const valid_from_flag         = header1 & 0x1u;
+
+  if (version != detail::VERSION)
+  {
+    return false;
+  }
+
+  // header byte 2
+  uint8_t const header2                = reader.ReadByte();
+  uint8_t const contract_type          = (header2 >> 6u) & 0x3u;
+  uint8_t const signature_count_minus1 = header2 & 0x3fu;
+
+  // header byte 3 (reserved)
+  reader.Skip(1u);
+
+  from_offset_ = reader.tell();
+  reader.Skip(Address::RAW_LENGTH);
+
+  if (transfer_flag != 0u)
+  {
+    num_transfers_ = 1;
+    if (multiple_transfers_flag != 0u)
+    {
+      num_transfers_ = detail::DecodeInteger<std::size_t>(reader) + 2u;
+    }
+
+    transfers_offset_ = reader.tell();
+    for (std::size_t i = 0; i < num_transfers_; ++i)
+    {
+      reader.Skip(Address::RAW_LENGTH);
+      SkipInteger(reader);
+    }
+  }
+
+  if (valid_from_flag != 0u)
+  {
+    valid_from_offset_ = reader.tell();
+    SkipInteger(reader);
+  }
+
+  valid_until_offset_ = reader.tell();
+  SkipInteger(reader);
+
+  charge_rate_offset_ = reader.tell();
+  SkipInteger(reader);
+
+  if (charge_unit_flag != 0u)
+  {
+    charge_unit_offset_ = reader.tell();
+    SkipInteger(reader);
+  }
+
+  charge_limit_offset_ = reader.tell();
+  SkipInteger(reader);
+
+  if (contract_type != 0)
+  {
+    contract_header_offset_       = reader.tell();
+    uint8_t const contract_header = reader.ReadByte();
+
+    bool const wildcard_flag            = (contract_header & 0x80u) != 0u;
+    bool const extended_shard_mask_flag = (contract_header & 0x40u) != 0u;
+
+    if (!wildcard_flag && extended_shard_mask_flag)
+    {
+      std::size_t const log2_shard_mask_bytes = static_cast<std::size_t>(contract_header & 0x3fu);
+
+      // the serializer limits the number of signalled lanes to 512
+      if (log2_shard_mask_bytes > 6u)
+      {
+        return false;
+      }
+
+      reader.Skip(std::size_t{1} << log2_shard_mask_bytes);
+    }
+
+    contract_offset_ = reader.tell();
+
+    switch (contract_type)
+    {
+    case detail::CONTRACT_PRESENT:
+      contract_mode_ = ContractMode::PRESENT;
+      reader.Skip(Address::RAW_LENGTH);
+      break;
+    case detail::CHAIN_CODE_PRESENT:
+      contract_mode_ = ContractMode::CHAIN_CODE;
+      SkipByteArray(reader);
+      break;
+    case detail::SYNERGETIC_PRESENT:
+      contract_mode_ = ContractMode::SYNERGETIC;
+      reader.Skip(Address::RAW_LENGTH);
+      break;
+    default:
+      return false;
+    }
+
+    action_offset_ = reader.tell();
+    SkipByteArray(reader);
+
+    data_offset_ = reader.tell();
+    SkipByteArray(reader);
+  }
+
+  counter_offset_ = reader.tell();
+  reader.Skip(COUNTER_LENGTH);
+
+  num_signatories_ = signature_count_minus1 + 1u;
+  if (signature_count_minus1 == 0x3fu)
+  {
+    num_signatories_ += detail::DecodeInteger<std::size_t>(reader);
+  }
+
+  signatories_offset_ = reader.tell();
+  for (std::size_t i = 0; i < num_signatories_; ++i)
+  {
+    // only the uncompressed ECDSA public key format is supported
+    if (reader.ReadByte() != 0x04)
+    {
+      return false;
+    }
+
+    reader.Skip(IDENTITY_LENGTH);
+  }
+
+  signatures_offset_ = reader.tell();
+  for (std::size_t i = 0; i < num_signatories_; ++i)
+  {
+    SkipByteArray(reader);
+  }
+
+  return true;
+}
+
+}  // namespace chain
+}  // namespace fetch
@@ -19,6 +19,7 @@
 #include "chain/address.hpp"
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
+#include "chain/transaction_encoding.hpp"
 #include "chain/transaction_serializer.hpp"
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
@@ -1058,4 +1059,171 @@ TEST_F(TransactionSerializerTests, ContractWithLargeShardMask)
   EnsureAreSame(output, *tx);
 }
 
+TEST_F(TransactionSerializerTests, BuiltTransactionCarriesItsEncoding)
+{
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Signer(signers_[0]->identity())
+                .Signer(signers_[1]->identity())
+                .ChargeRate(1000)
+                .ChargeLimit(1000000)
+                .TargetChainCode("foo.bar.baz", BitVector{})
+                .Action("launch")
+                .Data("go")
+                .Seal()
+                .Sign(*signers_[0])
+                .Sign(*signers_[1])
+                .Build();
+  ASSERT_TRUE(static_cast<bool>(tx));
+
+  // the retained encoding must be exactly what a fresh encode would produce
+  auto const expected = TransactionSerializer::AppendSignatures(
+      TransactionSerializer::SerializePayload(*tx), *tx);
+  EXPECT_EQ(ConstByteArray{expected}, tx->encoding());
+
+  TransactionSerializer serializer;
+  serializer << *tx;
+  EXPECT_EQ(tx->encoding(), serializer.data());
+}
+
+TEST_F(TransactionSerializerTests, DecodedTransactionReusesWireBytes)
+{
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Signer(signers_[0]->identity())
+                .ChargeRate(1000)
+                .ChargeLimit(1000000)
+                .TargetSmartContract(addresses_[4], BitVector{})
+                .Action("launch")
+                .Data("go")
+                .Seal()
+                .Sign(*signers_[0])
+                .Build();
+  ASSERT_TRUE(static_cast<bool>(tx));
+
+  TransactionSerializer serializer;
+  serializer << *tx;
+  ConstByteArray const wire = serializer.data();
+
+  Transaction output;
+  TransactionSerializer{wire} >> output;
+
+  // the decoded transaction must refer to the received buffer rather than a copy of it
+  ASSERT_EQ(wire, output.encoding());
+  EXPECT_EQ(wire.pointer(), output.encoding().pointer());
+
+  // re-encoding hands back the same bytes
+  TransactionSerializer relay;
+  relay << output;
+  EXPECT_EQ(wire, relay.data());
+  EXPECT_EQ(wire.pointer(), relay.data().pointer());
+
+  // a canonical encoding is kept after verification
+  EXPECT_TRUE(output.Verify());
+  EXPECT_EQ(wire.pointer(), output.encoding().pointer());
+  EXPECT_EQ(tx->digest(), output.digest());
+  EnsureAreSame(output, *tx);
+}
+
+TEST_F(TransactionSerializerTests, DetachedTransactionReleasesTheReceivedBuffer)
+{
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Signer(signers_[0]->identity())
+                .Signer(signers_[1]->identity())
+                .ChargeRate(1000)
+                .ChargeLimit(1000000)
+                .TargetChainCode("foo.bar.baz", BitVector{})
+                .Action("launch")
+                .Data("go")
+                .Seal()
+                .Sign(*signers_[0])
+                .Sign(*signers_[1])
+                .Build();
+  ASSERT_TRUE(static_cast<bool>(tx));
+
+  TransactionSerializer serializer;
+  serializer << *tx;
+  ConstByteArray const wire = serializer.data().Copy();
+
+  // the transaction is received as part of a larger message
+  fetch::byte_array::ByteArray message;
+  message.Append(ConstByteArray{"header"}, wire, ConstByteArray{"other transactions"});
+  ConstByteArray const received = message;
+  message                       = fetch::byte_array::ByteArray{};
+
+  Transaction output;
+  TransactionSerializer{received.SubArray(6, wire.size())} >> output;
+  EXPECT_GT(received.UseCount(), 1u);
+
+  output.DetachFromBuffer();
+
+  // none of the fields refer to the received buffer any more
+  EXPECT_EQ(1u, received.UseCount());
+  EXPECT_EQ(wire, output.encoding());
+  EXPECT_EQ(output.encoding().size(), output.encoding().capacity());
+
+  EXPECT_TRUE(output.Verify());
+  EXPECT_EQ(tx->digest(), output.digest());
+  EnsureAreSame(output, *tx);
+
+  // a transaction with a buffer of its own is left unchanged
+  auto const pointer = output.encoding().pointer();
+  output.DetachFromBuffer();
+  EXPECT_EQ(pointer, output.encoding().pointer());
+}
+
+TEST_F(TransactionSerializerTests, NonCanonicalPayloadIsNotAccepted)
+{
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Signer(signers_[0]->identity())
+                .ChargeRate(1000)
+                .ChargeLimit(1000000)
+                .TargetChainCode("foo.bar.baz", BitVector{})
+                .Action("launch")
+                .Seal()
+                .Sign(*signers_[0])
+                .Build();
+  ASSERT_TRUE(static_cast<bool>(tx));
+
+  TransactionSerializer serializer;
+  serializer << *tx;
+  ConstByteArray const wire = serializer.data();
+
+  // the reserved header byte is ignored when decoding, so setting it gives a different encoding of
+  // the same transaction
+  fetch::byte_array::ByteArray payload = TransactionSerializer::SerializePayload(*tx).Copy();
+  std::size_t const            payload_size = payload.size();
+  payload[3]                                = 0x01;
+
+  auto const signature_of = [](ConstByteArray const &signature) {
+    return fetch::chain::detail::EncodeInteger(signature.size()) + signature;
+  };
+
+  // signed as received, the signature does not match the canonical payload
+  {
+    ConstByteArray const received = payload + signature_of(signers_[0]->Sign(payload));
+
+    Transaction output;
+    TransactionSerializer{received} >> output;
+
+    EXPECT_FALSE(output.Verify());
+  }
+
+  // signed in its canonical form, the transaction is valid but is relayed in the canonical form
+  {
+    ConstByteArray const received = payload + wire.SubArray(payload_size);
+
+    Transaction output;
+    TransactionSerializer{received} >> output;
+
+    EXPECT_TRUE(output.Verify());
+
+    TransactionSerializer relay;
+    relay << output;
+    EXPECT_EQ(wire, relay.data());
+  }
+}
+
 }  // namespace
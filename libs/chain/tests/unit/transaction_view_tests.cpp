@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "chain/transaction_layout.hpp"
+#include "chain/transaction_serializer.hpp"
+#include "chain/transaction_view.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::chain::TransactionLayout;
+using fetch::chain::TransactionSerializer;
+using fetch::chain::TransactionView;
+using fetch::BitVector;
+
+using SignerPtr = std::unique_ptr<ECDSASigner>;
+using Signers   = std::vector<SignerPtr>;
+using Addresses = std::vector<Address>;
+
+class TransactionViewTests : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t NUM_SIGNERS = 4;
+
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < NUM_SIGNERS; ++i)
+    {
+      signers_.emplace_back(std::make_unique<ECDSASigner>());
+      addresses_.emplace_back(signers_.back()->identity());
+    }
+  }
+
+  ConstByteArray Encode(Transaction const &tx)
+  {
+    TransactionSerializer serializer{};
+    serializer << tx;
+    return serializer.data();
+  }
+
+  void EnsureMatches(TransactionView const &view, Transaction const &tx)
+  {
+    ASSERT_TRUE(view.IsValid());
+
+    EXPECT_EQ(view.digest(), tx.digest());
+    EXPECT_EQ(view.counter(), tx.counter());
+    EXPECT_EQ(view.from(), tx.from());
+
+    auto const transfers = view.transfers();
+    ASSERT_EQ(view.num_transfers(), tx.transfers().size());
+    ASSERT_EQ(transfers.size(), tx.transfers().size());
+    for (std::size_t i = 0; i < transfers.size(); ++i)
+    {
+      EXPECT_EQ(transfers[i].to, tx.transfers()[i].to);
+      EXPECT_EQ(transfers[i].amount, tx.transfers()[i].amount);
+    }
+
+    EXPECT_EQ(view.valid_from(), tx.valid_from());
+    EXPECT_EQ(view.valid_until(), tx.valid_until());
+    EXPECT_EQ(view.charge_rate(), tx.charge_rate());
+    EXPECT_EQ(view.charge_limit(), tx.charge_limit());
+    EXPECT_EQ(view.contract_mode(), tx.contract_mode());
+    EXPECT_EQ(view.contract_address(), tx.contract_address());
+    EXPECT_EQ(view.chain_code(), tx.chain_code());
+    EXPECT_EQ(view.action(), tx.action());
+    EXPECT_EQ(view.shard_mask(), tx.shard_mask());
+    EXPECT_EQ(view.data(), tx.data());
+
+    auto const signatories = view.signatories();
+    ASSERT_EQ(view.num_signatories(), tx.signatories().size());
+    ASSERT_EQ(signatories.size(), tx.signatories().size());
+    for (std::size_t i = 0; i < signatories.size(); ++i)
+    {
+      EXPECT_EQ(signatories[i].identity, tx.signatories()[i].identity);
+      EXPECT_EQ(signatories[i].address, tx.signatories()[i].address);
+      EXPECT_EQ(signatories[i].signature, tx.signatories()[i].signature);
+    }
+  }
+
+  void CheckRoundTrip(Transaction const &original)
+  {
+    auto const encoded = Encode(original);
+
+    // decode the transaction using the existing serializer as the reference
+    Transaction reference;
+    TransactionSerializer serializer{encoded};
+    ASSERT_TRUE(serializer.Deserialize(reference));
+
+    TransactionView const view{encoded};
+    EnsureMatches(view, reference);
+
+    // the payload view must be the signed portion of the transaction
+    EXPECT_EQ(view.payload(), TransactionSerializer::SerializePayload(reference));
+
+    // the layouts generated from both sources must agree
+    for (uint32_t log2_num_lanes = 0; log2_num_lanes <= 4; ++log2_num_lanes)
+    {
+      TransactionLayout const expected{reference, log2_num_lanes};
+      TransactionLayout const actual{view, log2_num_lanes};
+
+      EXPECT_EQ(actual.digest(), expected.digest());
+      EXPECT_EQ(actual.mask(), expected.mask());
+      EXPECT_EQ(actual.charge_rate(), expected.charge_rate());
+      EXPECT_EQ(actual.valid_from(), expected.valid_from());
+      EXPECT_EQ(actual.valid_until(), expected.valid_until());
+    }
+
+    // full decode from the view
+    Transaction decoded;
+    ASSERT_TRUE(view.ToTransaction(decoded));
+    EXPECT_EQ(decoded.digest(), reference.digest());
+  }
+
+  Signers   signers_;
+  Addresses addresses_;
+};
+
+TEST_F(TransactionViewTests, SimpleTransfer)
+{
+  auto const tx = TransactionBuilder()
+                      .From(addresses_[0])
+                      .Transfer(addresses_[1], 256u)
+                      .Signer(signers_[0]->identity())
+                      .Seal()
+                      .Sign(*signers_[0])
+                      .Build();
+
+  CheckRoundTrip(*tx);
+}
+
+TEST_F(TransactionViewTests, MultipleTransfersAndValidity)
+{
+  auto const tx = TransactionBuilder()
+                      .From(addresses_[0])
+                      .Transfer(addresses_[1], 256u)
+                      .Transfer(addresses_[2], 512u)
+                      .Transfer(addresses_[3], 0xFFFFFFFFFFFFull)
+                      .ValidFrom(100)
+                      .ValidUntil(200000)
+                      .ChargeRate(1000)
+                      .ChargeLimit(1000000)
+                      .Counter(0x0102030405060708ull)
+                      .Signer(signers_[0]->identity())
+                      .Seal()
+                      .Sign(*signers_[0])
+                      .Build();
+
+  CheckRoundTrip(*tx);
+}
+
+TEST_F(TransactionViewTests, ChainCodeWithSmallShardMask)
+{
+  BitVector shard_mask{4};
+  shard_mask.set(3, 1);
+  shard_mask.set(2, 1);
+
+  auto const tx = TransactionBuilder()
+                      .From(addresses_[0])
+                      .TargetChainCode("foo.bar.baz", shard_mask)
+                      .Action("launch")
+                      .Data("go")
+                      .Signer(signers_[0]->identity())
+                      .Seal()
+                      .Sign(*signers_[0])
+                      .Build();
+
+  CheckRoundTrip(*tx);
+}
+
+TEST_F(TransactionViewTests, SmartContractWithLargeShardMask)
+{
+  BitVector shard_mask{64};
+  for (std::size_t i = 0; i < shard_mask.size(); i += 3)
+  {
+    shard_mask.set(i, 1);
+  }
+
+  auto const tx = TransactionBuilder()
+                      .From(addresses_[0])
+                      .Transfer(addresses_[1], 1u)
+                      .TargetSmartContract(addresses_[2], shard_mask)
+                      .Action("transfer")
+                      .Data(std::string(1024, 'x'))
+                      .Signer(signers_[0]->identity())
+                      .Signer(signers_[1]->identity())
+                      .Seal()
+                      .Sign(*signers_[0])
+                      .Sign(*signers_[1])
+                      .Build();
+
+  CheckRoundTrip(*tx);
+}
+
+TEST_F(TransactionViewTests, WildcardContract)
+{
+  auto const tx = TransactionBuilder()
+                      .From(addresses_[0])
+                      .TargetChainCode("fetch.token", BitVector{})
+                      .Action("wealth")
+                      .Signer(signers_[0]->identity())
+                      .Seal()
+                      .Sign(*signers_[0])
+                      .Build();
+
+  CheckRoundTrip(*tx);
+}
+
+TEST_F(TransactionViewTests, ManySignatories)
+{
+  // enough signatories to require the extended signature count
+  Signers            extra_signers;
+  TransactionBuilder builder;
+  builder.From(addresses_[0]).Transfer(addresses_[1], 10u);
+  for (std::size_t i = 0; i < 70; ++i)
+  {
+    extra_signers.emplace_back(std::make_unique<ECDSASigner>());
+    builder.Signer(extra_signers.back()->identity());
+  }
+
+  auto sealed = builder.Seal();
+  for (auto const &signer : extra_signers)
+  {
+    sealed.Sign(*signer);
+  }
+
+  CheckRoundTrip(*sealed.Build());
+}
+
+TEST_F(TransactionViewTests, RejectsMalformedInput)
+{
+  EXPECT_FALSE(TransactionView{}.IsValid());
+  EXPECT_FALSE(TransactionView{ConstByteArray{}}.IsValid());
+  EXPECT_FALSE(TransactionView{ConstByteArray{"not a transaction"}}.IsValid());
+
+  auto const tx = TransactionBuilder()
+                      .From(addresses_[0])
+                      .Transfer(addresses_[1], 256u)
+                      .TargetChainCode("foo.bar.baz", BitVector{})
+                      .Action("launch")
+                      .Data("go")
+                      .Signer(signers_[0]->identity())
+                      .Seal()
+                      .Sign(*signers_[0])
+                      .Build();
+
+  auto const encoded = Encode(*tx);
+  ASSERT_TRUE(TransactionView{encoded}.IsValid());
+
+  // every truncation of the transaction must be rejected
+  for (std::size_t length = 0; length < encoded.size(); ++length)
+  {
+    EXPECT_FALSE(TransactionView{encoded.SubArray(0, length)}.IsValid()) << "length: " << length;
+  }
+}
+
+}  // namespace
@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/queue.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::core::LockFreeQueue;
+using fetch::core::Queue;
+
+constexpr std::size_t QUEUE_SIZE         = 1u << 16u;  // same as the transaction verifier
+constexpr std::size_t ELEMENTS_PER_ROUND = 1u << 18u;
+constexpr std::size_t BATCH_SIZE         = 64;
+
+using Element    = std::shared_ptr<uint64_t>;
+using MutexQueue = Queue<Element, QUEUE_SIZE>;  // the previous mutex protected MPMC queue
+using RingQueue  = LockFreeQueue<Element, QUEUE_SIZE>;
+
+/**
+ * Moves ELEMENTS_PER_ROUND elements from the producer threads to the consumer threads
+ *
+ * Once all the producers have finished, one empty element per consumer is pushed to signal the
+ * end of the round.
+ */
+template <typename QueueType>
+void RunSingle(QueueType &queue, std::size_t producers, std::size_t consumers)
+{
+  std::vector<std::thread> producer_threads;
+  std::vector<std::thread> consumer_threads;
+
+  auto const element = std::make_shared<uint64_t>(42);
+
+  for (std::size_t c = 0; c < consumers; ++c)
+  {
+    consumer_threads.emplace_back([&queue]() {
+      while (queue.Pop())
+      {
+      }
+    });
+  }
+
+  for (std::size_t p = 0; p < producers; ++p)
+  {
+    std::size_t const count =
+        (ELEMENTS_PER_ROUND / producers) + ((p < ELEMENTS_PER_ROUND % producers) ? 1 : 0);
+
+    producer_threads.emplace_back([&queue, &element, count]() {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        queue.Push(Element{element});
+      }
+    });
+  }
+
+  for (auto &thread : producer_threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t c = 0; c < consumers; ++c)
+  {
+    queue.Push(Element{});
+  }
+
+  for (auto &thread : consumer_threads)
+  {
+    thread.join();
+  }
+}
+
+/**
+ * Same as RunSingle but using the batch push / pop operations of the lock-free queue
+ */
+void RunBatch(RingQueue &queue, std::size_t producers, std::size_t consumers)
+{
+  std::vector<std::thread> producer_threads;
+  std::vector<std::thread> consumer_threads;
+
+  auto const element = std::make_shared<uint64_t>(42);
+
+  for (std::size_t c = 0; c < consumers; ++c)
+  {
+    consumer_threads.emplace_back([&queue]() {
+      std::vector<Element> batch(BATCH_SIZE);
+
+      for (;;)
+      {
+        std::size_t const count = queue.PopBatch(batch.begin(), BATCH_SIZE, std::chrono::hours{1});
+
+        auto const stops = static_cast<std::size_t>(
+            std::count(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(count), nullptr));
+        if (stops != 0)
+        {
+          // hand back the end markers that belong to the other consumers
+          for (std::size_t i = 1; i < stops; ++i)
+          {
+            queue.Push(Element{});
+          }
+          break;
+        }
+      }
+    });
+  }
+
+  for (std::size_t p = 0; p < producers; ++p)
+  {
+    std::size_t const count =
+        (ELEMENTS_PER_ROUND / producers) + ((p < ELEMENTS_PER_ROUND % producers) ? 1 : 0);
+
+    producer_threads.emplace_back([&queue, &element, count]() {
+      std::vector<Element> batch(BATCH_SIZE, element);
+
+      for (std::size_t sent = 0; sent < count; sent += BATCH_SIZE)
+      {
+        auto const size = static_cast<std::ptrdiff_t>(std::min(BATCH_SIZE, count - sent));
+        queue.PushBatch(batch.begin(), batch.begin() + size);
+      }
+    });
+  }
+
+  for (auto &thread : producer_threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t c = 0; c < consumers; ++c)
+  {
+    queue.Push(Element{});
+  }
+
+  for (auto &thread : consumer_threads)
+  {
+    thread.join();
+  }
+}
+
+void QueueArguments(benchmark::internal::Benchmark *b)
+{
+  for (int threads : {1, 2, 4, 8, 16, 32})
+  {
+    b->Args({threads, threads});
+  }
+
+  // asymmetric shapes: the verifier is fed by many network threads and drained by a few
+  b->Args({32, 1});
+  b->Args({32, 4});
+  b->Args({1, 32});
+  b->Args({4, 32});
+}
+
+template <typename QueueType>
+void BM_QueueThroughput(benchmark::State &state)
+{
+  auto const producers = static_cast<std::size_t>(state.range(0));
+  auto const consumers = static_cast<std::size_t>(state.range(1));
+
+  auto queue = std::make_unique<QueueType>();
+
+  for (auto _ : state)
+  {
+    RunSingle(*queue, producers, consumers);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ELEMENTS_PER_ROUND));
+}
+
+void BM_LockFreeQueueBatchThroughput(benchmark::State &state)
+{
+  auto const producers = static_cast<std::size_t>(state.range(0));
+  auto const consumers = static_cast<std::size_t>(state.range(1));
+
+  auto queue = std::make_unique<RingQueue>();
+
+  for (auto _ : state)
+  {
+    RunBatch(*queue, producers, consumers);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ELEMENTS_PER_ROUND));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_QueueThroughput, MutexQueue)
+    ->Apply(QueueArguments)
+    ->ArgNames({"producers", "consumers"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_QueueThroughput, RingQueue)
+    ->Apply(QueueArguments)
+    ->ArgNames({"producers", "consumers"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_LockFreeQueueBatchThroughput)
+    ->Apply(QueueArguments)
+    ->ArgNames({"producers", "consumers"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
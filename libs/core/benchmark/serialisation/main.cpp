@@ -16,16 +16,25 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "chain/transaction_layout.hpp"
+#include "chain/transaction_serializer.hpp"
+#include "chain/transaction_view.hpp"
+#include "core/bitvector.hpp"
 #include "core/random/lfg.hpp"
 #include "core/serializers/base_types.hpp"
 #include "core/serializers/counter.hpp"
 #include "core/serializers/main_serializer.hpp"
+#include "crypto/ecdsa.hpp"
 
 #include <chrono>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -33,6 +42,15 @@ using namespace fetch::serializers;
 using namespace fetch::byte_array;
 using namespace std::chrono;
 
+using fetch::BitVector;
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::chain::TransactionLayout;
+using fetch::chain::TransactionSerializer;
+using fetch::chain::TransactionView;
+using fetch::crypto::ECDSASigner;
+
 fetch::random::LaggedFibonacciGenerator<> lfg;
 
 template <typename T, std::size_t N = 256>
@@ -152,6 +170,154 @@ Result BenchmarkSingle(Args... args)
   std::cout << std::setw(width) << result.serialization;        \
   std::cout << std::setw(width) << result.deserialization << std::endl
 
+using TransactionPtr  = TransactionBuilder::TransactionPtr;
+using Transactions    = std::vector<TransactionPtr>;
+using EncodedPayloads = std::vector<ConstByteArray>;
+
+constexpr std::size_t TX_COUNT       = 1000;
+constexpr std::size_t TX_REPEATS     = 20;
+constexpr uint32_t    LOG2_NUM_LANES = 4;
+
+Transactions GenerateTransactions(std::size_t count)
+{
+  ECDSASigner signer;
+  Address     from{signer.identity()};
+
+  BitVector shard_mask{4};
+  shard_mask.set(1, 1);
+
+  Transactions txs;
+  txs.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ConstByteArray data;
+    MakeString(data);
+
+    txs.emplace_back(TransactionBuilder()
+                         .From(from)
+                         .Transfer(from, i + 1)
+                         .TargetChainCode("fetch.token", shard_mask)
+                         .Action("transfer")
+                         .Data(data)
+                         .ValidUntil(1000 + i)
+                         .ChargeRate(1)
+                         .ChargeLimit(1000)
+                         .Counter(i)
+                         .Signer(signer.identity())
+                         .Seal()
+                         .Sign(signer)
+                         .Build());
+  }
+
+  return txs;
+}
+
+template <typename Function>
+double TimeRepeated(Function &&function)
+{
+  high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+  for (std::size_t i = 0; i < TX_REPEATS; ++i)
+  {
+    function();
+  }
+
+  high_resolution_clock::time_point t2 = high_resolution_clock::now();
+  return duration_cast<duration<double>>(t2 - t1).count();
+}
+
+void PrintTransactionResult(char const *name, double seconds, std::size_t bytes)
+{
+  int type_width = 35;
+  int width      = 12;
+
+  auto const operations = static_cast<double>(TX_COUNT * TX_REPEATS);
+  auto const megabytes  = static_cast<double>(bytes * TX_REPEATS) * 1e-6;
+
+  std::cout << std::setw(type_width) << name;
+  std::cout << std::setw(width) << megabytes;
+  std::cout << std::setw(width) << seconds;
+  std::cout << std::setw(width) << operations / seconds;
+  std::cout << std::setw(width) << megabytes / seconds << std::endl;
+}
+
+void BenchmarkTransactions()
+{
+  int type_width = 35;
+  int width      = 12;
+
+  auto const txs = GenerateTransactions(TX_COUNT);
+
+  EncodedPayloads encoded;
+  std::size_t     bytes{0};
+  for (auto const &tx : txs)
+  {
+    TransactionSerializer serializer{};
+    serializer << *tx;
+    encoded.push_back(serializer.data());
+    bytes += encoded.back().size();
+  }
+
+  std::cout << std::setw(type_width) << "Transaction";
+  std::cout << std::setw(width) << "MBs";
+  std::cout << std::setw(width) << "Time";
+  std::cout << std::setw(width) << "Tx/s";
+  std::cout << std::setw(width) << "MBs/s" << std::endl;
+
+  PrintTransactionResult("Encode", TimeRepeated([&txs]() {
+                           for (auto const &tx : txs)
+                           {
+                             TransactionSerializer serializer{};
+                             serializer << *tx;
+                           }
+                         }),
+                         bytes);
+
+  PrintTransactionResult("Decode", TimeRepeated([&encoded]() {
+                           for (auto const &data : encoded)
+                           {
+                             Transaction           tx;
+                             TransactionSerializer serializer{data};
+                             serializer >> tx;
+                           }
+                         }),
+                         bytes);
+
+  PrintTransactionResult("View (digest, validity)", TimeRepeated([&encoded]() {
+                           for (auto const &data : encoded)
+                           {
+                             TransactionView const view{data};
+                             if (!view.IsValid() || view.digest().empty() ||
+                                 (view.valid_until() == 0))
+                             {
+                               throw std::runtime_error("Invalid transaction view");
+                             }
+                           }
+                         }),
+                         bytes);
+
+  PrintTransactionResult("Layout from decode", TimeRepeated([&encoded]() {
+                           for (auto const &data : encoded)
+                           {
+                             Transaction           tx;
+                             TransactionSerializer serializer{data};
+                             serializer >> tx;
+
+                             TransactionLayout const layout{tx, LOG2_NUM_LANES};
+                           }
+                         }),
+                         bytes);
+
+  PrintTransactionResult("Layout from view", TimeRepeated([&encoded]() {
+                           for (auto const &data : encoded)
+                           {
+                             TransactionLayout const layout{TransactionView{data},
+                                                            LOG2_NUM_LANES};
+                           }
+                         }),
+                         bytes);
+}
+
 int main()
 {
   int type_width = 35;
@@ -187,5 +353,9 @@ int main()
   SINGLE_BENCHMARK(MsgPackSerializer, std::vector<ConstByteArray>);
   SINGLE_BENCHMARK(MsgPackSerializer, std::vector<std::string>);
 
+  std::cout << std::endl;
+
+  BenchmarkTransactions();
+
   return 0;
 }
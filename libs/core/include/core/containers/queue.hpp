@@ -18,12 +18,20 @@
 //------------------------------------------------------------------------------
 
 #include "core/mutex.hpp"
+#include "core/sync/event_count.hpp"
 #include "core/sync/tickets.hpp"
 #include "meta/log2.hpp"
 #include "meta/type_traits.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <deque>
+#include <iterator>
+#include <thread>
+#include <type_traits>
 
 namespace fetch {
 namespace core {
@@ -313,6 +321,604 @@ meta::EnableIfSame<T, meta::Decay<U>, bool> Queue<T, N, P, C>::Push(
   return true;
 }
 
+/**
+ * Bounded lock-free multiple producer, multiple consumer fixed-length queue
+ *
+ * Implementation of Dmitry Vyukov's bounded MPMC ring. Every cell carries a sequence counter that
+ * tells producers and consumers whether the cell is free for the current lap of the ring, so a
+ * push or pop is a single CAS on the shared write / read index. Blocked callers spin for a short
+ * while before parking on an EventCount, which keeps the uncontended path free of system calls.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam SIZE The max size of the queue
+ */
+template <typename T, std::size_t SIZE>
+class LockFreeQueue
+{
+public:
+  static constexpr std::size_t QUEUE_LENGTH = SIZE;
+
+  using Element = T;
+
+  static_assert(std::is_move_assignable<T>::value, "T must be move assignable");
+  static_assert(std::is_default_constructible<T>::value, "T must be default constructable");
+
+  // Construction / Destruction
+  LockFreeQueue();
+  LockFreeQueue(LockFreeQueue const &) = delete;
+  LockFreeQueue(LockFreeQueue &&)      = delete;
+  ~LockFreeQueue()                     = default;
+
+  /// @name Queue Interaction
+  /// @{
+  T Pop();
+  template <typename R, typename P>
+  bool Pop(T &value, std::chrono::duration<R, P> const &duration);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>> Push(U &&element);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>> Push(U &&element, std::size_t &count);
+  template <typename U, typename R, typename P>
+  meta::EnableIfSame<T, meta::Decay<U>, bool> Push(U &&element, std::size_t &count,
+                                                   std::chrono::duration<R, P> const &duration);
+  /// @}
+
+  /// @name Non-blocking Interaction
+  /// @{
+  bool TryPop(T &value);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>, bool> TryPush(U &&element);
+  /// @}
+
+  /// @name Batch Interaction
+  /// @{
+  template <typename Iterator>
+  void PushBatch(Iterator begin, Iterator end);
+  template <typename Iterator>
+  std::size_t TryPushBatch(Iterator begin, Iterator end);
+  template <typename OutputIterator, typename R, typename P>
+  std::size_t PopBatch(OutputIterator output, std::size_t max_count,
+                       std::chrono::duration<R, P> const &duration);
+  template <typename OutputIterator>
+  std::size_t TryPopBatch(OutputIterator output, std::size_t max_count);
+  /// @}
+
+  // Operators
+  LockFreeQueue &operator=(LockFreeQueue const &) = delete;
+  LockFreeQueue &operator=(LockFreeQueue &&) = delete;
+
+private:
+  using Index     = std::atomic<std::size_t>;
+  using Clock     = EventCount::Clock;
+  using Timepoint = EventCount::Timepoint;
+
+  struct Cell
+  {
+    Index sequence{0};  ///< The position (lap) for which this cell is next writable / readable
+    T     value{};
+  };
+
+  using Array = std::array<Cell, SIZE>;
+
+  static constexpr std::size_t MASK          = SIZE - 1;
+  static constexpr std::size_t CACHE_LINE    = 64;
+  static constexpr std::size_t SPIN_ATTEMPTS = 64;
+  static constexpr std::size_t YIELD_AFTER   = 32;
+
+  static std::ptrdiff_t Distance(std::size_t a, std::size_t b);
+  template <typename Function>
+  static bool WaitFor(EventCount &event, Timepoint const &deadline, Function &&attempt);
+  template <typename R, typename P>
+  static Timepoint CalculateDeadline(std::chrono::duration<R, P> const &duration);
+
+  std::size_t Occupancy() const;
+
+  // The indices are kept on separate cache lines from each other and from the cells so that
+  // producers and consumers do not invalidate each others lines. Explicit padding is used rather
+  // than alignas so that the queue can still be allocated by operator new prior to C++17.
+  Index      write_index_{0};  ///< The next position to be claimed by a producer
+  char       write_padding_[CACHE_LINE - sizeof(Index)]{};
+  Index      read_index_{0};  ///< The next position to be claimed by a consumer
+  char       read_padding_[CACHE_LINE - sizeof(Index)]{};
+  EventCount not_empty_;  ///< Signalled when elements are published
+  EventCount not_full_;   ///< Signalled when cells are released
+  Array      cells_{};    ///< The main element container
+
+  // static asserts
+  static_assert(meta::IsLog2(SIZE), "Queue size must be a valid power of 2");
+  static_assert(SIZE >= 2, "Queue size must be at least 2");
+};
+
+template <typename T, std::size_t N>
+LockFreeQueue<T, N>::LockFreeQueue()
+{
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Pop an element from the queue
+ *
+ * If no element is available then the function will block until an element
+ * is available.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @return The element retrieved from the queue
+ */
+template <typename T, std::size_t N>
+T LockFreeQueue<T, N>::Pop()
+{
+  T value;
+  WaitFor(not_empty_, Timepoint::max(), [this, &value]() { return TryPop(value); });
+
+  return value;
+}
+
+/**
+ * Pop an element from the queue with a specified maximum wait duration
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam Rep The tick representation for the duration
+ * @tparam Per The tick period for the duration
+ * @param value The reference to the value to be populated
+ * @param duration The maximum amount of time to wait for an element
+ * @return true if an element was extracted, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename Rep, typename Per>
+bool LockFreeQueue<T, N>::Pop(T &value, std::chrono::duration<Rep, Per> const &duration)
+{
+  return WaitFor(not_empty_, CalculateDeadline(duration),
+                 [this, &value]() { return TryPop(value); });
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam U Has the same meaning as @refitem(T), but is inferred from method
+ * call, rather than provided at object construction time to leverage universal
+ * reference feature, and so eliminate necessity to implement multiple method overloads.
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>> LockFreeQueue<T, N>::Push(U &&element)
+{
+  // TryPush only consumes the element once it has claimed a cell, so it is safe to retry
+  WaitFor(not_full_, Timepoint::max(),
+          [this, &element]() { return TryPush(std::forward<U>(element)); });
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam U Has the same meaning as @refitem(T), but is inferred from method
+ * call, rather than provided at object construction time to leverage universal
+ * reference feature, and so eliminate necessity to implement multiple method overloads.
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ * @param count Number of enqueued elements still waiting in the queue to be processed.
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>> LockFreeQueue<T, N>::Push(U &&element, std::size_t &count)
+{
+  Push(std::forward<U>(element));
+  count = Occupancy();
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam U Has the same meaning as @refitem(T), but is inferred from method
+ * call, rather than provided at object construction time to leverage universal
+ * reference feature, and so eliminate necessity to implement multiple method overloads.
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ * @param count Number of enqueued elements still waiting in the queue to be processed.
+ * @param duration The maximum amount of time to wait for being able to insert the element
+ * @return true if an element was inserted in given timeout, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename U, typename Rep, typename Per>
+meta::EnableIfSame<T, meta::Decay<U>, bool> LockFreeQueue<T, N>::Push(
+    U &&element, std::size_t &count, std::chrono::duration<Rep, Per> const &duration)
+{
+  if (!WaitFor(not_full_, CalculateDeadline(duration),
+               [this, &element]() { return TryPush(std::forward<U>(element)); }))
+  {
+    return false;
+  }
+
+  count = Occupancy();
+  return true;
+}
+
+/**
+ * Attempt to pop an element from the queue without blocking
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @param value The reference to the value to be populated
+ * @return true if an element was extracted, otherwise false
+ */
+template <typename T, std::size_t N>
+bool LockFreeQueue<T, N>::TryPop(T &value)
+{
+  Cell *      cell{nullptr};
+  std::size_t position = read_index_.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    cell = &cells_[position & MASK];
+
+    std::ptrdiff_t const diff =
+        Distance(cell->sequence.load(std::memory_order_acquire), position + 1);
+
+    if (diff == 0)
+    {
+      if (read_index_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      return false;  // empty (or the producer of this cell has not finished yet)
+    }
+    else
+    {
+      position = read_index_.load(std::memory_order_relaxed);
+    }
+  }
+
+  value = std::move(cell->value);
+  cell->sequence.store(position + N, std::memory_order_release);
+
+  not_full_.NotifyOne();
+
+  return true;
+}
+
+/**
+ * Attempt to push an element onto the queue without blocking
+ *
+ * The element is only forwarded (and therefore possibly moved from) when the push succeeds.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @param element The universal reference to the element
+ * @return true if the element was added, false if the queue was full
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>, bool> LockFreeQueue<T, N>::TryPush(U &&element)
+{
+  Cell *      cell{nullptr};
+  std::size_t position = write_index_.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    cell = &cells_[position & MASK];
+
+    std::ptrdiff_t const diff = Distance(cell->sequence.load(std::memory_order_acquire), position);
+
+    if (diff == 0)
+    {
+      if (write_index_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      return false;  // full (or the consumer of this cell has not finished yet)
+    }
+    else
+    {
+      position = write_index_.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->value = std::forward<U>(element);
+  cell->sequence.store(position + 1, std::memory_order_release);
+
+  not_empty_.NotifyOne();
+
+  return true;
+}
+
+/**
+ * Push a range of elements onto the queue
+ *
+ * If the queue does not have space for all the elements this function will block until they have
+ * all been added. Elements are assigned from the dereferenced iterator, pass move iterators to
+ * move them into the queue.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam Iterator The forward iterator type
+ * @param begin The start of the range to be added
+ * @param end The end of the range to be added
+ */
+template <typename T, std::size_t N>
+template <typename Iterator>
+void LockFreeQueue<T, N>::PushBatch(Iterator begin, Iterator end)
+{
+  while (begin != end)
+  {
+    WaitFor(not_full_, Timepoint::max(), [this, &begin, &end]() {
+      std::size_t const pushed = TryPushBatch(begin, end);
+      std::advance(begin, static_cast<std::ptrdiff_t>(pushed));
+
+      return pushed != 0;
+    });
+  }
+}
+
+/**
+ * Push as many elements as currently fit from a range onto the queue without blocking
+ *
+ * All the cells are claimed with a single update of the write index.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam Iterator The forward iterator type
+ * @param begin The start of the range to be added
+ * @param end The end of the range to be added
+ * @return The number of elements (from the start of the range) that were added
+ */
+template <typename T, std::size_t N>
+template <typename Iterator>
+std::size_t LockFreeQueue<T, N>::TryPushBatch(Iterator begin, Iterator end)
+{
+  auto const requested = static_cast<std::size_t>(std::distance(begin, end));
+  if (requested == 0)
+  {
+    return 0;
+  }
+
+  std::size_t position = write_index_.load(std::memory_order_relaxed);
+  std::size_t count{0};
+
+  for (;;)
+  {
+    std::ptrdiff_t const used = Distance(position, read_index_.load(std::memory_order_acquire));
+    if (used < 0)
+    {
+      // our view of the write index is stale
+      position = write_index_.load(std::memory_order_relaxed);
+      continue;
+    }
+
+    count = std::min(requested, N - static_cast<std::size_t>(used));
+    if (count == 0)
+    {
+      return 0;
+    }
+
+    if (write_index_.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+    {
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i, ++begin)
+  {
+    Cell &cell = cells_[(position + i) & MASK];
+
+    // every claimed cell has already been claimed by its consumer, which might however still be
+    // moving the previous value out
+    while (cell.sequence.load(std::memory_order_acquire) != position + i)
+    {
+      std::this_thread::yield();
+    }
+
+    cell.value = *begin;
+    cell.sequence.store(position + i + 1, std::memory_order_release);
+  }
+
+  not_empty_.Notify(count);
+
+  return count;
+}
+
+/**
+ * Pop up to the specified number of elements from the queue
+ *
+ * Waits a maximum of the specified duration for at least one element to be available and then
+ * takes all the elements that are available, up to the maximum count.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam OutputIterator The output iterator type
+ * @tparam Rep The tick representation for the duration
+ * @tparam Per The tick period for the duration
+ * @param output The output iterator to which the elements are written
+ * @param max_count The maximum number of elements to be extracted
+ * @param duration The maximum amount of time to wait for an element
+ * @return The number of elements extracted
+ */
+template <typename T, std::size_t N>
+template <typename OutputIterator, typename Rep, typename Per>
+std::size_t LockFreeQueue<T, N>::PopBatch(OutputIterator output, std::size_t max_count,
+                                          std::chrono::duration<Rep, Per> const &duration)
+{
+  std::size_t count{0};
+  WaitFor(not_empty_, CalculateDeadline(duration), [this, &output, &count, max_count]() {
+    count = TryPopBatch(output, max_count);
+    return count != 0;
+  });
+
+  return count;
+}
+
+/**
+ * Pop all the available elements from the queue, up to the specified count, without blocking
+ *
+ * All the cells are claimed with a single update of the read index.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam OutputIterator The output iterator type
+ * @param output The output iterator to which the elements are written
+ * @param max_count The maximum number of elements to be extracted
+ * @return The number of elements extracted
+ */
+template <typename T, std::size_t N>
+template <typename OutputIterator>
+std::size_t LockFreeQueue<T, N>::TryPopBatch(OutputIterator output, std::size_t max_count)
+{
+  if (max_count == 0)
+  {
+    return 0;
+  }
+
+  std::size_t position = read_index_.load(std::memory_order_relaxed);
+  std::size_t count{0};
+
+  for (;;)
+  {
+    std::ptrdiff_t const available =
+        Distance(write_index_.load(std::memory_order_acquire), position);
+    if (available <= 0)
+    {
+      return 0;
+    }
+
+    count = std::min(max_count, static_cast<std::size_t>(available));
+
+    if (read_index_.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+    {
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Cell &cell = cells_[(position + i) & MASK];
+
+    // every claimed cell has already been claimed by its producer, which might however still be
+    // writing the value
+    while (cell.sequence.load(std::memory_order_acquire) != position + i + 1)
+    {
+      std::this_thread::yield();
+    }
+
+    *output = std::move(cell.value);
+    ++output;
+    cell.sequence.store(position + i + N, std::memory_order_release);
+  }
+
+  not_full_.Notify(count);
+
+  return count;
+}
+
+/**
+ * Internal: Calculate the signed distance between two positions in the ring
+ */
+template <typename T, std::size_t N>
+std::ptrdiff_t LockFreeQueue<T, N>::Distance(std::size_t a, std::size_t b)
+{
+  return static_cast<std::ptrdiff_t>(a - b);
+}
+
+/**
+ * Internal: Repeat an operation until it succeeds or the deadline passes
+ *
+ * The operation is first retried in a short spin (yielding towards the end of it) and only after
+ * that does the caller park on the event.
+ *
+ * @param event The event which is signalled when the operation might succeed
+ * @param deadline The deadline for the operation
+ * @param attempt The operation, returning true on success
+ * @return true if the operation succeeded, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename Function>
+bool LockFreeQueue<T, N>::WaitFor(EventCount &event, Timepoint const &deadline,
+                                  Function &&attempt)
+{
+  for (std::size_t spin = 0; spin < SPIN_ATTEMPTS; ++spin)
+  {
+    if (attempt())
+    {
+      return true;
+    }
+
+    if (spin >= YIELD_AFTER)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  for (;;)
+  {
+    EventCount::Key const key = event.PrepareWait();
+
+    if (attempt())
+    {
+      event.CancelWait();
+      return true;
+    }
+
+    if (!event.Wait(key, deadline))
+    {
+      return attempt();
+    }
+
+    if (attempt())
+    {
+      return true;
+    }
+  }
+}
+
+/**
+ * Internal: Convert a relative timeout into a deadline
+ */
+template <typename T, std::size_t N>
+template <typename Rep, typename Per>
+typename LockFreeQueue<T, N>::Timepoint LockFreeQueue<T, N>::CalculateDeadline(
+    std::chrono::duration<Rep, Per> const &duration)
+{
+  auto const now = Clock::now();
+
+  if (duration >= Timepoint::max() - now)
+  {
+    return Timepoint::max();
+  }
+
+  return now + std::chrono::duration_cast<Clock::duration>(duration);
+}
+
+/**
+ * Internal: Approximate number of elements in the queue
+ */
+template <typename T, std::size_t N>
+std::size_t LockFreeQueue<T, N>::Occupancy() const
+{
+  std::ptrdiff_t const used = Distance(write_index_.load(std::memory_order_relaxed),
+                                       read_index_.load(std::memory_order_relaxed));
+
+  return (used > 0) ? std::min(static_cast<std::size_t>(used), N) : 0;
+}
+
 // Helpful Typedefs
 template <typename T, std::size_t N>
 using SPSCQueue = Queue<T, N, SingleThreadedIndex<N>, SingleThreadedIndex<N>>;
@@ -321,10 +927,10 @@ template <typename T, std::size_t N>
 using SPMCQueue = Queue<T, N, SingleThreadedIndex<N>, MultiThreadedIndex<N>>;
 
 template <typename T, std::size_t N>
-using MPSCQueue = Queue<T, N, MultiThreadedIndex<N>, SingleThreadedIndex<N>>;
+using MPSCQueue = LockFreeQueue<T, N>;
 
 template <typename T, std::size_t N>
-using MPMCQueue = Queue<T, N, MultiThreadedIndex<N>, MultiThreadedIndex<N>>;
+using MPMCQueue = LockFreeQueue<T, N>;
 
 }  // namespace core
 }  // namespace fetch
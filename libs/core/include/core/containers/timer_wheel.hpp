@@ -0,0 +1,373 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/platform.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Hierarchical timer wheel
+ *
+ * Timers are stored in a number of levels each of which contains 64 slots. The first level has a
+ * resolution of one tick, the next level one of 64 ticks and so on. A timer is placed on the
+ * lowest level that can represent the distance to its due tick, and is cascaded down towards the
+ * first level as the wheel advances. Timers further away than the horizon of the wheel are held in
+ * an overflow list which is re-examined each time the top level wraps.
+ *
+ * Adding a timer is O(1) and advancing the wheel only visits ticks at which timers expire or need
+ * to be cascaded, so a quiet wheel can be advanced over long periods at negligible cost.
+ *
+ * The wheel is not thread safe and does not support cancellation, owners are expected to ignore
+ * expired timers that are no longer relevant.
+ *
+ * @tparam T The type of item associated with each timer
+ */
+template <typename T>
+class TimerWheel
+{
+public:
+  using Tick = uint64_t;
+
+  static constexpr Tick NEVER = std::numeric_limits<Tick>::max();
+
+  // Construction / Destruction
+  explicit TimerWheel(Tick start = 0);
+  TimerWheel(TimerWheel const &) = delete;
+  TimerWheel(TimerWheel &&)      = delete;
+  ~TimerWheel()                  = default;
+
+  void Add(Tick due, T item);
+
+  template <typename Handler>
+  std::size_t Advance(Tick now, Handler &&handler);
+
+  Tick NextEvent() const;
+
+  Tick        current() const;
+  std::size_t size() const;
+  bool        empty() const;
+
+  // Operators
+  TimerWheel &operator=(TimerWheel const &) = delete;
+  TimerWheel &operator=(TimerWheel &&) = delete;
+
+private:
+  static constexpr std::size_t SLOT_BITS    = 6;
+  static constexpr std::size_t SLOTS        = 1u << SLOT_BITS;
+  static constexpr std::size_t LEVELS       = 4;
+  static constexpr std::size_t HORIZON_BITS = SLOT_BITS * LEVELS;
+  static constexpr Tick        HORIZON_MASK = (Tick{1} << HORIZON_BITS) - 1u;
+
+  struct Timer
+  {
+    Tick due;
+    T    item;
+  };
+
+  using Timers    = std::vector<Timer>;
+  using Level     = std::array<Timers, SLOTS>;
+  using Levels    = std::array<Level, LEVELS>;
+  using Occupancy = std::array<uint64_t, LEVELS>;
+
+  static constexpr std::size_t Shift(std::size_t level);
+
+  void Place(Timer &&timer);
+  void Cascade(Timers &timers);
+  void Process(Tick tick);
+  Tick NextScheduled() const;
+
+  Tick        current_;
+  Levels      levels_{};
+  Occupancy   occupied_{};
+  Timers      overflow_{};
+  Timers      due_{};
+  std::size_t size_{0};
+};
+
+template <typename T>
+constexpr typename TimerWheel<T>::Tick TimerWheel<T>::NEVER;
+
+/**
+ * Construct a timer wheel
+ *
+ * @tparam T The type of item associated with each timer
+ * @param start The initial tick of the wheel
+ */
+template <typename T>
+TimerWheel<T>::TimerWheel(Tick start)
+  : current_{start}
+{}
+
+/**
+ * Add a timer to the wheel
+ *
+ * Timers which are due at or before the current tick will be reported by the next call to Advance
+ *
+ * @tparam T The type of item associated with each timer
+ * @param due The tick at which the timer expires
+ * @param item The item to be reported on expiry
+ */
+template <typename T>
+void TimerWheel<T>::Add(Tick due, T item)
+{
+  Place(Timer{due, std::move(item)});
+  ++size_;
+}
+
+/**
+ * Advance the wheel to the specified tick, reporting all the timers that have expired
+ *
+ * @tparam T The type of item associated with each timer
+ * @tparam Handler The type of the handler
+ * @param now The tick to advance the wheel to
+ * @param handler The handler to be called with the item of each expired timer
+ * @return The number of expired timers
+ */
+template <typename T>
+template <typename Handler>
+std::size_t TimerWheel<T>::Advance(Tick now, Handler &&handler)
+{
+  std::size_t expired{0};
+
+  for (;;)
+  {
+    // report all the timers which are due at the current tick, the handler is free to add new
+    // timers to the wheel
+    Timers due{};
+    std::swap(due, due_);
+
+    expired += due.size();
+    size_ -= due.size();
+
+    for (auto &timer : due)
+    {
+      handler(std::move(timer.item));
+    }
+
+    // jump directly to the next tick at which something happens
+    Tick const next = NextScheduled();
+    if ((next == NEVER) || (next > now))
+    {
+      break;
+    }
+
+    current_ = next;
+    Process(next);
+  }
+
+  if (now > current_)
+  {
+    current_ = now;
+  }
+
+  return expired;
+}
+
+/**
+ * Determine the next tick at which the wheel needs to be advanced
+ *
+ * This is a lower bound for the expiry of the next timer. When the next event is a cascade of one
+ * of the upper levels no timers will be reported, the caller is simply expected to advance the
+ * wheel and query again.
+ *
+ * @tparam T The type of item associated with each timer
+ * @return The tick of the next event, NEVER if the wheel is empty
+ */
+template <typename T>
+typename TimerWheel<T>::Tick TimerWheel<T>::NextEvent() const
+{
+  return due_.empty() ? NextScheduled() : current_;
+}
+
+template <typename T>
+typename TimerWheel<T>::Tick TimerWheel<T>::current() const
+{
+  return current_;
+}
+
+template <typename T>
+std::size_t TimerWheel<T>::size() const
+{
+  return size_;
+}
+
+template <typename T>
+bool TimerWheel<T>::empty() const
+{
+  return size_ == 0;
+}
+
+template <typename T>
+constexpr std::size_t TimerWheel<T>::Shift(std::size_t level)
+{
+  return level * SLOT_BITS;
+}
+
+/**
+ * Place the timer on the appropriate level of the wheel
+ *
+ * The level is selected by the most significant bit in which the due tick differs from the
+ * current tick. This ensures that the timer will be cascaded exactly at the start of its slot.
+ *
+ * @tparam T The type of item associated with each timer
+ * @param timer The timer to be placed
+ */
+template <typename T>
+void TimerWheel<T>::Place(Timer &&timer)
+{
+  if (timer.due <= current_)
+  {
+    due_.emplace_back(std::move(timer));
+    return;
+  }
+
+  auto const highest_bit =
+      63u - static_cast<std::size_t>(platform::CountLeadingZeroes64(timer.due ^ current_));
+  auto const level = highest_bit / SLOT_BITS;
+
+  if (level >= LEVELS)
+  {
+    overflow_.emplace_back(std::move(timer));
+    return;
+  }
+
+  auto const slot = static_cast<std::size_t>(timer.due >> Shift(level)) & (SLOTS - 1u);
+
+  levels_[level][slot].emplace_back(std::move(timer));
+  occupied_[level] |= uint64_t{1} << slot;
+}
+
+template <typename T>
+void TimerWheel<T>::Cascade(Timers &timers)
+{
+  Timers cascaded{};
+  std::swap(cascaded, timers);
+
+  for (auto &timer : cascaded)
+  {
+    Place(std::move(timer));
+  }
+}
+
+/**
+ * Process the cascades and expiries for the specified (current) tick
+ *
+ * @tparam T The type of item associated with each timer
+ * @param tick The tick being processed
+ */
+template <typename T>
+void TimerWheel<T>::Process(Tick tick)
+{
+  // the overflow list is re-examined every time the top level wraps
+  if (((tick & HORIZON_MASK) == 0) && !overflow_.empty())
+  {
+    Cascade(overflow_);
+  }
+
+  // cascade the slots from the upper levels which start at this tick
+  for (std::size_t level = LEVELS - 1u; level > 0; --level)
+  {
+    Tick const mask = (Tick{1} << Shift(level)) - 1u;
+    if ((tick & mask) != 0)
+    {
+      continue;
+    }
+
+    auto const slot = static_cast<std::size_t>(tick >> Shift(level)) & (SLOTS - 1u);
+    auto const bit  = uint64_t{1} << slot;
+
+    if ((occupied_[level] & bit) != 0)
+    {
+      occupied_[level] &= ~bit;
+      Cascade(levels_[level][slot]);
+    }
+  }
+
+  // finally all the timers in the first level slot have expired
+  auto const slot = static_cast<std::size_t>(tick) & (SLOTS - 1u);
+  auto const bit  = uint64_t{1} << slot;
+
+  if ((occupied_[0] & bit) != 0)
+  {
+    occupied_[0] &= ~bit;
+
+    auto &timers = levels_[0][slot];
+    for (auto &timer : timers)
+    {
+      due_.emplace_back(std::move(timer));
+    }
+    timers.clear();
+  }
+}
+
+/**
+ * Determine the next tick at which a slot expires or is cascaded
+ *
+ * @tparam T The type of item associated with each timer
+ * @return The next tick, NEVER if there are no timers on the wheel
+ */
+template <typename T>
+typename TimerWheel<T>::Tick TimerWheel<T>::NextScheduled() const
+{
+  Tick next{NEVER};
+
+  for (std::size_t level = 0; level < LEVELS; ++level)
+  {
+    auto const digit = static_cast<std::size_t>(current_ >> Shift(level)) & (SLOTS - 1u);
+
+    // only the slots after the current position on this level can be occupied
+    uint64_t const pending =
+        (digit + 1u < SLOTS) ? (occupied_[level] & (~uint64_t{0} << (digit + 1u))) : 0u;
+
+    if (pending != 0)
+    {
+      Tick const slot  = platform::CountTrailingZeroes64(pending);
+      Tick const base  = (current_ >> Shift(level + 1u)) << Shift(level + 1u);
+      Tick const event = base | (slot << Shift(level));
+
+      if (event < next)
+      {
+        next = event;
+      }
+    }
+  }
+
+  if (!overflow_.empty())
+  {
+    Tick const wrap = ((current_ >> HORIZON_BITS) + 1u) << HORIZON_BITS;
+
+    if (wrap < next)
+    {
+      next = wrap;
+    }
+  }
+
+  return next;
+}
+
+}  // namespace core
+}  // namespace fetch
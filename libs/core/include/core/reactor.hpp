@@ -22,20 +22,38 @@
 #include "telemetry/telemetry.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <map>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace core {
 
+/**
+ * The reactor executes runnables on a pool of worker threads
+ *
+ * Runnables which signal their readiness are queued for execution when they are signalled, either
+ * immediately or via a timer wheel for delayed signals. Legacy runnables are polled, being
+ * re-evaluated after every execution and at a regular interval while they are not ready.
+ *
+ * Each runnable is only ever executed by one worker at a time, independent runnables are executed
+ * concurrently when the reactor is configured with more than one thread.
+ */
 class Reactor
 {
 public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+  using Duration  = Clock::duration;
+
   // Construction / Destruction
   explicit Reactor(std::string name);
+  Reactor(std::string name, std::size_t num_threads);
   Reactor(Reactor const &) = delete;
   Reactor(Reactor &&)      = delete;
   ~Reactor();
@@ -51,20 +69,28 @@ public:
   Reactor &operator=(Reactor const &) = delete;
   Reactor &operator=(Reactor &&) = delete;
 
+  std::size_t num_threads() const;
+
   uint64_t &ExecutionTooLongMs();
   uint64_t &ThreadWatcherCheckMs();
   uint32_t  ExecutionsTooLongCounter() const;
   uint32_t  ExecutionsWayTooLongCounter() const;
 
 private:
-  using RunnableMap     = Protected<std::map<Runnable const *, WeakRunnable>>;
+  class Scheduler;
+  struct Worker;
+
   using Flag            = std::atomic<bool>;
+  using SchedulerPtr    = std::shared_ptr<Scheduler>;
+  using WorkerPtr       = std::unique_ptr<Worker>;
+  using Workers         = std::vector<WorkerPtr>;
   using ProtectedThread = Protected<std::thread>;
   using ThreadPtr       = std::unique_ptr<ProtectedThread>;
 
   void StartWorkerAndWatcher();
   void StopWorkerAndWatcher();
-  void Monitor();
+  void Monitor(Worker &worker);
+  bool Dispatch(Worker &worker, RunnablePtr const &runnable_ptr);
   void ReactorWatch();
 
   telemetry::HistogramPtr       CreateHistogram(char const *name, char const *description) const;
@@ -72,17 +98,12 @@ private:
   telemetry::GaugePtr<uint64_t> CreateGauge(char const *name, char const *description) const;
 
   std::string const name_;
+  std::size_t const num_threads_;
   Flag              running_{false};
-  Flag              not_destructing_{true};
-
-  RunnableMap work_map_{};
-  ThreadPtr   worker_{};
-  ThreadPtr   watcher_{};
 
-  // Keeping track of the last item executed
-  std::atomic<uint32_t> execution_counter_{0};
-  WeakRunnable          last_executed_runnable_;
-  Flag                  currently_executing_{false};
+  SchedulerPtr scheduler_;
+  Workers      workers_{};
+  ThreadPtr    watcher_{};
 
   uint64_t execution_too_long_ms_{200};
   uint64_t thread_watcher_check_ms_{1000};
@@ -17,21 +17,50 @@
 //
 //------------------------------------------------------------------------------
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace fetch {
 namespace core {
 
+class Runnable;
+
+/**
+ * Interface for the receiver of readiness signals from runnables (i.e. the reactor)
+ */
+class RunnableSignalSink
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+
+  virtual ~RunnableSignalSink() = default;
+
+  virtual void OnSignal(Runnable const &runnable, Timepoint const &when) = 0;
+};
+
 /**
- * Interface class to represent
+ * Interface class to represent a unit of work to be executed by the reactor
+ *
+ * By default runnables are polled, the reactor periodically evaluates IsReadyToExecute and calls
+ * Execute when it returns true. Runnables that enable signalling instead inform the reactor
+ * explicitly (via Signal / SignalAt) when they need to be executed and are never polled. Such
+ * runnables must always have a signal outstanding for the point at which they next become ready.
  */
 class Runnable
 {
 public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+  using Duration  = Clock::duration;
+
   // Construction / Destruction
-  Runnable()          = default;
+  Runnable() = default;
+  Runnable(Runnable const &other);
   virtual ~Runnable() = default;
 
   /// @name Runnable Interface
@@ -50,13 +79,54 @@ public:
   };
   /// @}
 
+  /// @name Readiness Signalling
+  /// @{
+  bool IsSignalling() const;
+  void Signal();
+  void SignalAt(Timepoint const &when);
+  template <typename R, typename P>
+  void SignalAfter(std::chrono::duration<R, P> const &delay);
+  /// @}
+
   // Helper operators
   void operator()()
   {
     Execute();
   }
+
+  Runnable &operator=(Runnable const &other);
+
+protected:
+  void EnableSignalling();
+
+private:
+  using SignalSinkPtr  = std::shared_ptr<RunnableSignalSink>;
+  using WeakSignalSink = std::weak_ptr<RunnableSignalSink>;
+
+  void      AttachSignalSink(WeakSignalSink sink);
+  Timepoint PendingSignal() const;
+
+  std::atomic<bool>  signalling_{false};
+  mutable std::mutex signal_lock_;
+  WeakSignalSink     signal_sink_{};
+  Timepoint          pending_signal_{};
+
+  friend class Reactor;
 };
 
+/**
+ * Signal that the runnable should be executed after the specified delay
+ *
+ * @tparam R The type of the representation
+ * @tparam P The type of the period
+ * @param delay The delay until the runnable should be executed
+ */
+template <typename R, typename P>
+void Runnable::SignalAfter(std::chrono::duration<R, P> const &delay)
+{
+  SignalAt(Clock::now() + std::chrono::duration_cast<Duration>(delay));
+}
+
 using WeakRunnables = std::vector<std::weak_ptr<Runnable>>;
 using WeakRunnable  = std::weak_ptr<Runnable>;
 using RunnablePtr   = std::shared_ptr<Runnable>;
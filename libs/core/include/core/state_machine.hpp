@@ -109,9 +109,6 @@ public:
   StateMachine &operator=(StateMachine &&) = delete;
 
 private:
-  using Clock                = std::chrono::steady_clock;
-  using Timepoint            = Clock::time_point;
-  using Duration             = Clock::duration;
   using CallbackMap          = std::unordered_map<State, Callback>;
   using ProtectedCallbackMap = Protected<CallbackMap>;
 
@@ -123,6 +120,7 @@ private:
   }
 
   void Reset();
+  void SignalWhenReady();
 
   std::string const             name_;
   StateMapper                   mapper_;
@@ -149,7 +147,10 @@ StateMachine<S>::StateMachine(std::string name, S initial, StateMapper mapper)
   , current_state_{initial}
   , state_gauge_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         ToLowerCase(name_) + "_state_gauge", "Generic state machine state as integer")}
-{}
+{
+  // the state machine informs the reactor when it is next ready to execute
+  EnableSignalling();
+}
 
 /**
  * Destruct and tear down the state handlers for this object
@@ -352,38 +353,65 @@ bool StateMachine<S>::IsReadyToExecute() const
 template <typename S>
 void StateMachine<S>::Execute()
 {
-  callbacks_.ApplyVoid([this](auto &callbacks) {
-    // iterate over the current state event callback map
-    auto it = callbacks.find(current_state_);
-    if (it != callbacks.end())
-    {
-      // execute the state handler
-      S const next_state = it->second(current_state_, previous_state_);
-
-      // perform the state updates
-      previous_state_ = current_state_.load();
-      state_gauge_->set(static_cast<uint64_t>(next_state));
-      current_state_ = next_state;
-
-      // detect a state change
-      if (current_state_ != previous_state_)
+  try
+  {
+    callbacks_.ApplyVoid([this](auto &callbacks) {
+      // iterate over the current state event callback map
+      auto it = callbacks.find(current_state_);
+      if (it != callbacks.end())
       {
-        // trigger the state change callback if configured
-        state_change_callback_.ApplyVoid([this](auto &state_change_callback) {
-          if (state_change_callback)
-          {
-            state_change_callback(current_state_, previous_state_);
-          }
-        });
+        // execute the state handler
+        S const next_state = it->second(current_state_, previous_state_);
+
+        // perform the state updates
+        previous_state_ = current_state_.load();
+        state_gauge_->set(static_cast<uint64_t>(next_state));
+        current_state_ = next_state;
+
+        // detect a state change
+        if (current_state_ != previous_state_)
+        {
+          // trigger the state change callback if configured
+          state_change_callback_.ApplyVoid([this](auto &state_change_callback) {
+            if (state_change_callback)
+            {
+              state_change_callback(current_state_, previous_state_);
+            }
+          });
+        }
       }
-    }
-  });
+    });
+  }
+  catch (...)
+  {
+    // a failing handler is retried, otherwise the reactor would never execute it again
+    SignalWhenReady();
+    throw;
+  }
+
+  SignalWhenReady();
+}
+
+/**
+ * Signal the reactor to execute the state machine again, straight away unless the handler has
+ * delayed the state machine (in which case the delay has already signalled the reactor)
+ *
+ * @tparam S The state enum type
+ */
+template <typename S>
+void StateMachine<S>::SignalWhenReady()
+{
+  if (IsReadyToExecute())
+  {
+    Signal();
+  }
 }
 
 /**
  * Configure the next execution of the state machine for a future point
  *
- * Note: Function to be called from within the state machine call context
+ * Note: Function to be called from within the state machine call context. The reactor is signalled
+ * to execute the state machine again once the delay has elapsed.
  *
  * @tparam S The type of the state
  * @tparam R The type of the representation
@@ -395,6 +423,7 @@ template <typename R, typename P>
 void StateMachine<S>::Delay(std::chrono::duration<R, P> const &delay)
 {
   next_execution_ = Clock::now() + delay;
+  SignalAt(next_execution_);
 }
 
 }  // namespace core
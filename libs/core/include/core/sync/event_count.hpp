@@ -0,0 +1,139 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Lightweight wait / notify primitive for lock-free data structures
+ *
+ * Waiters announce their intention to block with PrepareWait(), re-check their condition and
+ * then either CancelWait() or Wait() on the returned key. Notifiers only pay for a fence and a
+ * relaxed load unless somebody is actually waiting, in which case the epoch is advanced and the
+ * sleepers are woken. On Linux the sleeping is done with a futex, elsewhere a condition variable
+ * is used.
+ */
+class EventCount
+{
+public:
+  using Key       = uint32_t;
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+
+  // Construction / Destruction
+  EventCount()                   = default;
+  EventCount(EventCount const &) = delete;
+  EventCount(EventCount &&)      = delete;
+  ~EventCount()                  = default;
+
+  /// @name Waiting
+  /// @{
+  Key  PrepareWait();
+  void CancelWait();
+  bool Wait(Key key, Timepoint const &deadline = Timepoint::max());
+  /// @}
+
+  /// @name Notification
+  /// @{
+  void NotifyOne();
+  void Notify(std::size_t count);
+  void NotifyAll();
+  /// @}
+
+  // Operators
+  EventCount &operator=(EventCount const &) = delete;
+  EventCount &operator=(EventCount &&) = delete;
+
+private:
+  void Wake(std::size_t count);
+
+  std::atomic<Key>      epoch_{0};    ///< Advanced every time sleepers are woken
+  std::atomic<uint32_t> waiters_{0};  ///< The number of threads between PrepareWait and wake up
+
+#if !defined(FETCH_PLATFORM_LINUX)
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+#endif
+};
+
+/**
+ * Register the calling thread as a waiter
+ *
+ * The caller must re-check its wait condition after this call and then call either CancelWait()
+ * or Wait() with the returned key.
+ *
+ * @return The key to be passed to Wait()
+ */
+inline EventCount::Key EventCount::PrepareWait()
+{
+  waiters_.fetch_add(1, std::memory_order_seq_cst);
+  Key const key = epoch_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  return key;
+}
+
+/**
+ * Deregister the calling thread after its wait condition was satisfied without blocking
+ */
+inline void EventCount::CancelWait()
+{
+  waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * Wake up a single waiter (if there is one)
+ */
+inline void EventCount::NotifyOne()
+{
+  Notify(1);
+}
+
+/**
+ * Wake up to the specified number of waiters
+ *
+ * @param count The maximum number of waiters to wake
+ */
+inline void EventCount::Notify(std::size_t count)
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiters_.load(std::memory_order_relaxed) != 0)
+  {
+    Wake(count);
+  }
+}
+
+/**
+ * Wake up all the waiters
+ */
+inline void EventCount::NotifyAll()
+{
+  Notify(std::numeric_limits<std::size_t>::max());
+}
+
+}  // namespace core
+}  // namespace fetch
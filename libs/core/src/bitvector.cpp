@@ -71,7 +71,8 @@ bool BitVector::RemapTo(BitVector &dst) const
 {
   if (dst.size() == size())
   {
-    dst = *this;
+    // take a deep copy so that later updates to dst are not reflected in this vector
+    dst = BitVector{*this};
     return true;
   }
   if (dst.size() > size())
@@ -38,7 +38,11 @@ PeriodicRunnable::PeriodicRunnable(std::string const &name, Duration const &peri
   , state_gauge_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         ToLowerCase(name) + "_periodic_runnable_gauge",
         "Generic periodic runnable state as integer")}
-{}
+{
+  // the runnable informs the reactor when the next period elapses
+  EnableSignalling();
+  SignalAt(last_executed_ + interval_);
+}
 
 bool PeriodicRunnable::IsReadyToExecute() const
 {
@@ -47,12 +51,24 @@ bool PeriodicRunnable::IsReadyToExecute() const
 
 void PeriodicRunnable::Execute()
 {
-  // call the periodic function
-  state_gauge_->set(static_cast<uint64_t>(1));
-  Periodically();
-  state_gauge_->set(static_cast<uint64_t>(0));
+  try
+  {
+    // call the periodic function
+    state_gauge_->set(static_cast<uint64_t>(1));
+    Periodically();
+    state_gauge_->set(static_cast<uint64_t>(0));
+  }
+  catch (...)
+  {
+    // retry on the next period, otherwise the reactor would never execute the runnable again
+    state_gauge_->set(static_cast<uint64_t>(0));
+    last_executed_ = Clock::now();
+    SignalAt(last_executed_ + interval_);
+    throw;
+  }
 
   last_executed_ = Clock::now();
+  SignalAt(last_executed_ + interval_);
 }
 
 std::string PeriodicRunnable::GetId() const
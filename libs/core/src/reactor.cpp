@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "core/containers/timer_wheel.hpp"
 #include "core/reactor.hpp"
 #include "core/runnable.hpp"
 #include "core/set_thread_name.hpp"
@@ -28,25 +29,403 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <deque>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 static const std::chrono::milliseconds POLL_INTERVAL{15};
 static constexpr char const *          LOGGING_NAME = "Reactor";
 
-using WorkQueue = std::deque<fetch::core::WeakRunnable>;
-
 namespace fetch {
 namespace core {
 
+/**
+ * The scheduling state of the reactor, tracks which runnables are ready to be executed.
+ *
+ * The scheduler is shared with the attached runnables (as their signal sink) so that signals
+ * raised during or after the destruction of the reactor are safely discarded.
+ */
+class Reactor::Scheduler : public RunnableSignalSink,
+                           public std::enable_shared_from_this<Reactor::Scheduler>
+{
+public:
+  enum class State
+  {
+    IDLE,
+    QUEUED,
+    RUNNING
+  };
+
+  struct Entry
+  {
+    Runnable const *key;
+    WeakRunnable    runnable;
+    bool            signalling;
+    bool            attached{true};
+    bool            signalled{false};
+    State           state{State::IDLE};
+  };
+
+  using EntryPtr = std::shared_ptr<Entry>;
+
+  struct Work
+  {
+    EntryPtr    entry;
+    RunnablePtr runnable;
+  };
+
+  // Construction / Destruction
+  Scheduler(telemetry::CounterPtr expired_total, telemetry::CounterPtr sleep_total,
+            telemetry::GaugePtr<uint64_t> queue_length,
+            telemetry::GaugePtr<uint64_t> queue_max_length);
+  Scheduler(Scheduler const &) = delete;
+  Scheduler(Scheduler &&)      = delete;
+  ~Scheduler() override        = default;
+
+  bool Attach(RunnablePtr const &runnable, WeakRunnable weak_runnable);
+  bool Detach(Runnable const &runnable);
+
+  Work Next(Flag const &running);
+  void Complete(EntryPtr const &entry, bool executed);
+  void Interrupt();
+
+  /// @name Runnable Signal Sink
+  /// @{
+  void OnSignal(Runnable const &runnable, Timepoint const &when) override;
+  /// @}
+
+  // Operators
+  Scheduler &operator=(Scheduler const &) = delete;
+  Scheduler &operator=(Scheduler &&) = delete;
+
+private:
+  using WeakEntry  = std::weak_ptr<Entry>;
+  using EntryMap   = std::unordered_map<Runnable const *, EntryPtr>;
+  using ReadyQueue = std::deque<EntryPtr>;
+  using Timers     = TimerWheel<WeakEntry>;
+  using Tick       = Timers::Tick;
+
+  Tick      ToTick(Timepoint const &timepoint) const;
+  Timepoint FromTick(Tick tick) const;
+  void      Wake(EntryPtr const &entry);
+  void      Schedule(EntryPtr const &entry, Timepoint const &when);
+
+  Timepoint const         origin_{Clock::now()};
+  std::mutex              lock_;
+  std::condition_variable cv_;
+  EntryMap                entries_{};
+  ReadyQueue              ready_{};
+  Timers                  timers_{};
+
+  telemetry::CounterPtr         expired_total_;
+  telemetry::CounterPtr         sleep_total_;
+  telemetry::GaugePtr<uint64_t> queue_length_;
+  telemetry::GaugePtr<uint64_t> queue_max_length_;
+};
+
+Reactor::Scheduler::Scheduler(telemetry::CounterPtr expired_total,
+                              telemetry::CounterPtr sleep_total,
+                              telemetry::GaugePtr<uint64_t> queue_length,
+                              telemetry::GaugePtr<uint64_t> queue_max_length)
+  : expired_total_{std::move(expired_total)}
+  , sleep_total_{std::move(sleep_total)}
+  , queue_length_{std::move(queue_length)}
+  , queue_max_length_{std::move(queue_max_length)}
+{}
+
+bool Reactor::Scheduler::Attach(RunnablePtr const &runnable, WeakRunnable weak_runnable)
+{
+  auto entry = std::make_shared<Entry>(
+      Entry{runnable.get(), std::move(weak_runnable), runnable->IsSignalling()});
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+
+    // attempt to insert the element into the map
+    auto const result = entries_.emplace(runnable.get(), entry);
+    if (!result.second)
+    {
+      auto &existing = result.first->second;
+
+      // a new runnable may have been allocated in place of one which has expired
+      if (!existing->runnable.expired())
+      {
+        return false;
+      }
+
+      existing->attached = false;
+      existing           = entry;
+    }
+  }
+
+  runnable->AttachSignalSink(shared_from_this());
+
+  // signalling runnables are also evaluated once on attachment, and any signal raised before
+  // attachment is honoured
+  auto const pending = runnable->PendingSignal();
+
+  std::lock_guard<std::mutex> lock(lock_);
+  Wake(entry);
+
+  if (entry->signalling && (pending > Clock::now()))
+  {
+    Schedule(entry, pending);
+  }
+
+  return true;
+}
+
+bool Reactor::Scheduler::Detach(Runnable const &runnable)
+{
+  std::lock_guard<std::mutex> lock(lock_);
+
+  auto it = entries_.find(&runnable);
+  if (it == entries_.end())
+  {
+    return false;
+  }
+
+  // any queued or in flight execution is discarded on completion
+  it->second->attached = false;
+  entries_.erase(it);
+
+  return true;
+}
+
+/**
+ * Wait for the next runnable to be ready for execution
+ *
+ * @param running The flag which signals that the reactor is still running
+ * @return The work to be executed, empty if the reactor has been stopped
+ */
+Reactor::Scheduler::Work Reactor::Scheduler::Next(Flag const &running)
+{
+  std::unique_lock<std::mutex> lock(lock_);
+
+  while (running)
+  {
+    // move all the expired timers to the ready queue
+    timers_.Advance(ToTick(Clock::now()), [this](WeakEntry const &weak_entry) {
+      auto entry = weak_entry.lock();
+      if (entry && entry->attached)
+      {
+        Wake(entry);
+      }
+    });
+
+    queue_max_length_->max(ready_.size());
+
+    while (!ready_.empty())
+    {
+      auto entry = std::move(ready_.front());
+      ready_.pop_front();
+
+      queue_length_->set(ready_.size());
+
+      if (!entry->attached)
+      {
+        entry->state = State::IDLE;
+        continue;
+      }
+
+      auto runnable = entry->runnable.lock();
+      if (!runnable)
+      {
+        // the lifetime of the runnable has expired, remove
+        auto it = entries_.find(entry->key);
+        if ((it != entries_.end()) && (it->second == entry))
+        {
+          entries_.erase(it);
+        }
+
+        entry->attached = false;
+        entry->state    = State::IDLE;
+
+        expired_total_->increment();
+        continue;
+      }
+
+      entry->state     = State::RUNNING;
+      entry->signalled = false;
+
+      return {std::move(entry), std::move(runnable)};
+    }
+
+    // there is no work to do. Sleep the worker until signalled or the next timer is due
+    sleep_total_->increment();
+
+    auto const next = timers_.NextEvent();
+    if (next == Timers::NEVER)
+    {
+      cv_.wait(lock);
+    }
+    else
+    {
+      cv_.wait_until(lock, FromTick(next));
+    }
+  }
+
+  return {};
+}
+
+/**
+ * Complete the execution of a runnable, rescheduling it as required
+ *
+ * @param entry The entry for the runnable
+ * @param executed Flag to signal if the runnable was ready and executed
+ */
+void Reactor::Scheduler::Complete(EntryPtr const &entry, bool executed)
+{
+  std::lock_guard<std::mutex> lock(lock_);
+
+  entry->state = State::IDLE;
+
+  if (!entry->attached)
+  {
+    return;
+  }
+
+  if (entry->signalling)
+  {
+    // signalling runnables are only executed again when signalled
+    if (entry->signalled)
+    {
+      Wake(entry);
+    }
+  }
+  else if (executed || entry->signalled)
+  {
+    // polled runnables are re-evaluated straight away after they have been executed
+    Wake(entry);
+  }
+  else
+  {
+    Schedule(entry, Clock::now() + POLL_INTERVAL);
+  }
+}
+
+void Reactor::Scheduler::Interrupt()
+{
+  std::lock_guard<std::mutex> lock(lock_);
+  cv_.notify_all();
+}
+
+void Reactor::Scheduler::OnSignal(Runnable const &runnable, Timepoint const &when)
+{
+  std::lock_guard<std::mutex> lock(lock_);
+
+  auto it = entries_.find(&runnable);
+  if (it == entries_.end())
+  {
+    return;
+  }
+
+  if (when <= Clock::now())
+  {
+    Wake(it->second);
+  }
+  else
+  {
+    Schedule(it->second, when);
+  }
+}
+
+/**
+ * Convert a point in time to a tick of the timer wheel, rounding up so timers never fire early
+ */
+Reactor::Scheduler::Tick Reactor::Scheduler::ToTick(Timepoint const &timepoint) const
+{
+  if (timepoint <= origin_)
+  {
+    return 0;
+  }
+
+  auto const elapsed = timepoint - origin_;
+  auto       ticks   = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+
+  if (ticks < elapsed)
+  {
+    ++ticks;
+  }
+
+  return static_cast<Tick>(ticks.count());
+}
+
+Reactor::Timepoint Reactor::Scheduler::FromTick(Tick tick) const
+{
+  return origin_ + std::chrono::milliseconds{tick};
+}
+
+/**
+ * Queue the runnable for execution (lock must be held)
+ */
+void Reactor::Scheduler::Wake(EntryPtr const &entry)
+{
+  switch (entry->state)
+  {
+  case State::IDLE:
+    entry->state = State::QUEUED;
+    ready_.emplace_back(entry);
+    queue_length_->set(ready_.size());
+    cv_.notify_one();
+    break;
+  case State::QUEUED:
+    break;
+  case State::RUNNING:
+    // the runnable is requeued when the current execution completes
+    entry->signalled = true;
+    break;
+  }
+}
+
+/**
+ * Schedule the runnable to be queued at a future point in time (lock must be held)
+ */
+void Reactor::Scheduler::Schedule(EntryPtr const &entry, Timepoint const &when)
+{
+  auto const tick       = ToTick(when);
+  bool const reschedule = tick < timers_.NextEvent();
+
+  timers_.Add(tick, entry);
+
+  // wake a sleeping worker so that it can adjust its deadline
+  if (reschedule)
+  {
+    cv_.notify_one();
+  }
+}
+
+/**
+ * The per thread state of the reactor, tracks the last item executed for stall detection
+ */
+struct Reactor::Worker
+{
+  explicit Worker(std::string const &name)
+    : execution_too_long_timer{name.c_str()}
+  {}
+
+  ThreadPtr               thread{};
+  moment::DeadlineTimer   execution_too_long_timer;
+  std::atomic<uint32_t>   execution_counter{0};
+  Flag                    currently_executing{false};
+  Protected<WeakRunnable> last_executed_runnable{};
+  uint32_t                last_seen_executed{0};
+};
+
 Reactor::Reactor(std::string name)
+  : Reactor(std::move(name), 1)
+{}
+
+Reactor::Reactor(std::string name, std::size_t num_threads)
   : name_{std::move(name)}
+  , num_threads_{std::max<std::size_t>(num_threads, 1)}
   , runnables_time_{CreateHistogram("ledger_reactor_runnable_time",
                                     "The histogram of runnables execution time")}
   , attach_total_{CreateCounter("ledger_reactor_attach_total",
@@ -74,7 +453,10 @@ Reactor::Reactor(std::string name)
                                    "The current size of the work queue")}
   , work_queue_max_length_{
         CreateGauge("ledger_reactor_max_work_queue_length", "The max size of the work queue")}
-{}
+{
+  scheduler_ = std::make_shared<Scheduler>(expired_total_, sleep_total_, work_queue_length_,
+                                           work_queue_max_length_);
+}
 
 bool Reactor::Attach(WeakRunnable runnable)
 {
@@ -84,13 +466,7 @@ bool Reactor::Attach(WeakRunnable runnable)
   auto concrete_runnable = runnable.lock();
   if (concrete_runnable)
   {
-    success = work_map_.Apply([&concrete_runnable, &runnable](auto &work_map) -> bool {
-      // attempt to insert the element into the map
-      auto const result = work_map.insert(std::make_pair(concrete_runnable.get(), runnable));
-
-      // signal success if the insertion was successful
-      return result.second;
-    });
+    success = scheduler_->Attach(concrete_runnable, std::move(runnable));
   }
 
   attach_total_->increment();
@@ -117,8 +493,7 @@ bool Reactor::Attach(std::vector<WeakRunnable> runnables)
 bool Reactor::Detach(Runnable const &runnable)
 {
   detach_total_->increment();
-  return work_map_.Apply(
-      [&runnable](auto &work_map) -> bool { return work_map.erase(&runnable) > 0; });
+  return scheduler_->Detach(runnable);
 }
 
 void Reactor::Start()
@@ -136,14 +511,23 @@ void Reactor::Stop()
 
 void Reactor::StartWorkerAndWatcher()
 {
-  detailed_assert(!worker_);
+  detailed_assert(workers_.empty());
   detailed_assert(!watcher_);
 
   // signal the reactor is running
   running_ = true;
 
-  // create the worker routine
-  worker_ = std::make_unique<ProtectedThread>(&Reactor::Monitor, this);
+  // create the worker routines
+  std::string const timer_name = "reactor:" + name_;
+  for (std::size_t i = 0; i < num_threads_; ++i)
+  {
+    workers_.emplace_back(std::make_unique<Worker>(timer_name));
+  }
+
+  for (auto &worker : workers_)
+  {
+    worker->thread = std::make_unique<ProtectedThread>(&Reactor::Monitor, this, std::ref(*worker));
+  }
 
   // The reactor watcher determines whether executions are taking
   // too long or are stalled.
@@ -166,148 +550,122 @@ void Reactor::StopWorkerAndWatcher()
     watcher_.reset();
   }
 
-  if (worker_)
+  // Force the workers awake
+  scheduler_->Interrupt();
+
+  for (auto &worker : workers_)
   {
-    worker_->ApplyVoid([](auto &worker) { worker.join(); });
-    worker_.reset();
+    worker->thread->ApplyVoid([](auto &thread) { thread.join(); });
   }
+
+  workers_.clear();
 }
 
 void Reactor::ReactorWatch()
 {
-  uint32_t last_seen_executed = 0;
-
   while (running_)
   {
-    std::unique_lock<std::mutex> lock(cv_m_);
-    cv_.wait_for(lock, std::chrono::milliseconds(thread_watcher_check_ms_));
-
-    auto        runnable_concrete = last_executed_runnable_.lock();
-    std::string runnable_name     = runnable_concrete ? runnable_concrete->GetId() : "nullptr fail";
-    std::string runnable_debug = runnable_concrete ? runnable_concrete->GetDebug() : "nullptr fail";
-
-    if ((last_seen_executed == execution_counter_) && currently_executing_)
     {
-      FETCH_LOG_WARN(LOGGING_NAME,
-                     "Very long execution noticed at execution counter: ", last_seen_executed,
-                     ". from runnable: ", runnable_name, " debug: ", runnable_debug);
-      executions_way_too_long_++;
-      way_too_long_total_->increment();
+      std::unique_lock<std::mutex> lock(cv_m_);
+      cv_.wait_for(lock, std::chrono::milliseconds(thread_watcher_check_ms_));
     }
 
-    last_seen_executed = execution_counter_;
+    for (auto &worker : workers_)
+    {
+      auto runnable_concrete = worker->last_executed_runnable.Apply(
+          [](auto const &last_executed) { return last_executed.lock(); });
+      std::string runnable_name = runnable_concrete ? runnable_concrete->GetId() : "nullptr fail";
+      std::string runnable_debug =
+          runnable_concrete ? runnable_concrete->GetDebug() : "nullptr fail";
+
+      uint32_t const execution_counter = worker->execution_counter;
+
+      if ((worker->last_seen_executed == execution_counter) && worker->currently_executing)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME,
+                       "Very long execution noticed at execution counter: ", execution_counter,
+                       ". from runnable: ", runnable_name, " debug: ", runnable_debug);
+        executions_way_too_long_++;
+        way_too_long_total_->increment();
+      }
+
+      worker->last_seen_executed = execution_counter;
+    }
   }
 }
 
-void Reactor::Monitor()
+void Reactor::Monitor(Worker &worker)
 {
   // set the thread name
   SetThreadName(name_);
 
-  std::string const     timer_name = "reactor:" + name_;
-  moment::DeadlineTimer execution_too_long_timer{timer_name.c_str()};
-
-  WorkQueue work_queue;
-
   while (running_)
   {
-    // Step 1. If we have run out of work to execute then gather all the runnables that are ready
-    if (work_queue.empty())
-    {
-      work_map_.ApplyVoid([&work_queue, this](auto &work_map) {
-        // loop through and evaluate the map
-        auto it = work_map.begin();
-        while (it != work_map.end())
-        {
-          // attempt to lock the runnable
-          auto concrete_runnable = it->second.lock();
-
-          if (concrete_runnable)
-          {
-            // evaluate if the runnable is ready to execute, if it is then add it to the work queue
-            if (concrete_runnable->IsReadyToExecute())
-            {
-              work_queue.emplace_back(it->second);
-            }
-
-            // advance to the next element in the map
-            ++it;
-          }
-          else
-          {
-            // the lifetime of the runnable has expired, remove
-            // and advance to next element in the map
-            it = work_map.erase(it);
-
-            expired_total_->increment();
-          }
-        }
-      });
-
-      work_queue_max_length_->max(work_queue.size());
-    }
+    auto work = scheduler_->Next(running_);
 
-    work_queue_length_->set(work_queue.size());
-
-    // If the work queue is still empty then there is no work to do. Sleep the worker and try again
-    if (work_queue.empty())
+    if (work.runnable)
     {
-      sleep_total_->increment();
-      std::this_thread::sleep_for(POLL_INTERVAL);
+      bool const executed = Dispatch(worker, work.runnable);
 
-      continue;
+      work.runnable.reset();
+      scheduler_->Complete(work.entry, executed);
     }
+  }
+}
 
-    // extract the element from the front of the queue, keep note of it for block detection
-    execution_counter_++;
-    last_executed_runnable_ = work_queue.front();
+bool Reactor::Dispatch(Worker &worker, RunnablePtr const &runnable_ptr)
+{
+  auto &runnable = *runnable_ptr;
 
-    auto runnable = last_executed_runnable_.lock();
-    work_queue.pop_front();
+  // execute the item if it can be executed
+  if (!runnable.IsReadyToExecute())
+  {
+    return false;
+  }
 
-    // execute the item if it can be executed
-    if (runnable)
-    {
-      telemetry::FunctionTimer timer{*runnables_time_};
-      runnable_total_->increment();
+  // keep note of the item being executed for block detection
+  worker.execution_counter++;
+  worker.last_executed_runnable.ApplyVoid(
+      [&runnable_ptr](auto &last_executed) { last_executed = runnable_ptr; });
 
-      try
-      {
-        currently_executing_ = true;
-        execution_too_long_timer.Restart(execution_too_long_ms_);
+  telemetry::FunctionTimer timer{*runnables_time_};
+  runnable_total_->increment();
 
-        runnable->Execute();
+  try
+  {
+    worker.currently_executing = true;
+    worker.execution_too_long_timer.Restart(execution_too_long_ms_);
 
-        success_total_->increment();
+    runnable.Execute();
 
-        if (execution_too_long_timer.HasExpired())
-        {
-          FETCH_LOG_WARN(LOGGING_NAME,
-                         "Execution took longer than was polite! From: ", runnable->GetId(),
-                         " Debug: ", runnable->GetDebug());
-          executions_too_long_++;
-          too_long_total_->increment();
-        }
-      }
-      catch (std::exception const &ex)
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "The reactor ", name_, " caught an exception in ",
-                       runnable->GetId(), "! ", " error: ", ex.what(),
-                       " Debug: ", runnable->GetDebug());
+    success_total_->increment();
 
-        failure_total_->increment();
-      }
-      catch (...)
-      {
-        FETCH_LOG_INFO(LOGGING_NAME, "Unknown error generated in reactor: ", name_,
-                       " From: ", runnable->GetId(), " Debug: ", runnable->GetDebug());
+    if (worker.execution_too_long_timer.HasExpired())
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Execution took longer than was polite! From: ",
+                     runnable.GetId(), " Debug: ", runnable.GetDebug());
+      executions_too_long_++;
+      too_long_total_->increment();
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "The reactor ", name_, " caught an exception in ",
+                   runnable.GetId(), "! ", " error: ", ex.what(), " Debug: ", runnable.GetDebug());
 
-        failure_total_->increment();
-      }
+    failure_total_->increment();
+  }
+  catch (...)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Unknown error generated in reactor: ", name_,
+                   " From: ", runnable.GetId(), " Debug: ", runnable.GetDebug());
 
-      currently_executing_ = false;
-    }
+    failure_total_->increment();
   }
+
+  worker.currently_executing = false;
+
+  return true;
 }
 
 telemetry::HistogramPtr Reactor::CreateHistogram(char const *name, char const *description) const
@@ -328,6 +686,11 @@ telemetry::GaugePtr<uint64_t> Reactor::CreateGauge(char const *name, char const
                                                                {{"reactor", name_}});
 }
 
+std::size_t Reactor::num_threads() const
+{
+  return num_threads_;
+}
+
 uint64_t &Reactor::ExecutionTooLongMs()
 {
   return execution_too_long_ms_;
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/runnable.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Copy the runnable, the copy is not attached to any reactor
+ *
+ * @param other The runnable to copy
+ */
+Runnable::Runnable(Runnable const &other)
+  : signalling_{other.signalling_.load()}
+{}
+
+Runnable &Runnable::operator=(Runnable const &other)
+{
+  signalling_ = other.signalling_.load();
+  return *this;
+}
+
+/**
+ * Determine if the runnable signals its own readiness to the reactor
+ *
+ * @return true if the runnable signals, false if it needs to be polled
+ */
+bool Runnable::IsSignalling() const
+{
+  return signalling_;
+}
+
+/**
+ * Signal that the runnable is ready to be executed
+ */
+void Runnable::Signal()
+{
+  SignalAt(Clock::now());
+}
+
+/**
+ * Signal that the runnable should be executed at the specified point in time
+ *
+ * Signals that are raised before the runnable is attached to a reactor are remembered and
+ * delivered when it is attached.
+ *
+ * @param when The point in time when the runnable should be executed
+ */
+void Runnable::SignalAt(Timepoint const &when)
+{
+  SignalSinkPtr sink{};
+
+  {
+    std::lock_guard<std::mutex> lock(signal_lock_);
+    pending_signal_ = when;
+    sink            = signal_sink_.lock();
+  }
+
+  if (sink)
+  {
+    sink->OnSignal(*this, when);
+  }
+}
+
+/**
+ * Mark this runnable as signalling its own readiness. Should be called during construction
+ */
+void Runnable::EnableSignalling()
+{
+  signalling_ = true;
+}
+
+void Runnable::AttachSignalSink(WeakSignalSink sink)
+{
+  std::lock_guard<std::mutex> lock(signal_lock_);
+  signal_sink_ = std::move(sink);
+}
+
+Runnable::Timepoint Runnable::PendingSignal() const
+{
+  std::lock_guard<std::mutex> lock(signal_lock_);
+  return pending_signal_;
+}
+
+}  // namespace core
+}  // namespace fetch
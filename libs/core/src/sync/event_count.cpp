@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "core/sync/event_count.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#if defined(FETCH_PLATFORM_LINUX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fetch {
+namespace core {
+namespace {
+
+#if defined(FETCH_PLATFORM_LINUX)
+
+static_assert(sizeof(std::atomic<EventCount::Key>) == sizeof(EventCount::Key),
+              "Futex word must be a plain 32-bit integer");
+
+long Futex(std::atomic<EventCount::Key> *address, int operation, EventCount::Key value,
+           timespec const *timeout)
+{
+  return syscall(SYS_futex, reinterpret_cast<EventCount::Key *>(address), operation, value,
+                 timeout, nullptr, 0);
+}
+
+#endif
+
+}  // namespace
+
+/**
+ * Block until the event has been notified since the key was obtained, or the deadline passes
+ *
+ * @param key The key returned from the matching PrepareWait() call
+ * @param deadline The point in time after which the wait is abandoned
+ * @return true if the event was notified, false if the wait timed out
+ */
+bool EventCount::Wait(Key key, Timepoint const &deadline)
+{
+  bool notified{true};
+
+#if defined(FETCH_PLATFORM_LINUX)
+  while (epoch_.load(std::memory_order_acquire) == key)
+  {
+    if (deadline == Timepoint::max())
+    {
+      Futex(&epoch_, FUTEX_WAIT_PRIVATE, key, nullptr);
+      continue;
+    }
+
+    auto const now = Clock::now();
+    if (now >= deadline)
+    {
+      notified = false;
+      break;
+    }
+
+    auto const remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+    timespec   timeout{};
+    timeout.tv_sec  = static_cast<time_t>(remaining.count() / 1000000000);
+    timeout.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+
+    Futex(&epoch_, FUTEX_WAIT_PRIVATE, key, &timeout);
+  }
+#else
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto const changed = [this, key]() { return epoch_.load(std::memory_order_acquire) != key; };
+
+    if (deadline == Timepoint::max())
+    {
+      cv_.wait(lock, changed);
+    }
+    else
+    {
+      notified = cv_.wait_until(lock, deadline, changed);
+    }
+  }
+#endif
+
+  waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+  return notified;
+}
+
+/**
+ * Internal: Advance the epoch and wake the sleeping waiters
+ *
+ * @param count The maximum number of sleeping waiters to wake
+ */
+void EventCount::Wake(std::size_t count)
+{
+#if defined(FETCH_PLATFORM_LINUX)
+  epoch_.fetch_add(1, std::memory_order_acq_rel);
+  Futex(&epoch_, FUTEX_WAKE_PRIVATE,
+        static_cast<Key>(std::min<std::size_t>(count, static_cast<std::size_t>(INT_MAX))),
+        nullptr);
+#else
+  {
+    FETCH_LOCK(mutex_);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  if (count == 1)
+  {
+    cv_.notify_one();
+  }
+  else
+  {
+    cv_.notify_all();
+  }
+#endif
+}
+
+}  // namespace core
+}  // namespace fetch
@@ -20,11 +20,15 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <iterator>
 #include <mutex>
+#include <numeric>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -211,4 +215,151 @@ TEST_F(QueueTests, ProducerConsumer_1p_50c_MPMCQueue)
   ProducerConsumerTest<1, 50>(queue);
 }
 
+TEST_F(QueueTests, ProducerConsumer_50p_50c_LegacyMPMCQueue)
+{
+  fetch::core::Queue<Element, QUEUE_SIZE> queue;
+  ProducerConsumerTest<50, 50>(queue);
+}
+
+TEST(LockFreeQueueTests, TryPushFailsWhenFullAndTryPopFailsWhenEmpty)
+{
+  fetch::core::MPMCQueue<uint32_t, 4> queue;
+
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(queue.TryPush(uint32_t{i}));
+  }
+  EXPECT_FALSE(queue.TryPush(uint32_t{4}));
+
+  uint32_t value{0};
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(LockFreeQueueTests, FailedTryPushDoesNotConsumeElement)
+{
+  fetch::core::MPMCQueue<std::unique_ptr<int>, 2> queue;
+
+  queue.Push(std::make_unique<int>(1));
+  queue.Push(std::make_unique<int>(2));
+
+  auto element = std::make_unique<int>(3);
+  EXPECT_FALSE(queue.TryPush(std::move(element)));
+  ASSERT_TRUE(element);
+  EXPECT_EQ(*element, 3);
+}
+
+TEST(LockFreeQueueTests, TimedOperationsTimeOut)
+{
+  fetch::core::MPMCQueue<uint32_t, 2> queue;
+
+  uint32_t value{0};
+  EXPECT_FALSE(queue.Pop(value, std::chrono::milliseconds{10}));
+
+  std::size_t count{0};
+  EXPECT_TRUE(queue.Push(uint32_t{1}, count, std::chrono::milliseconds{10}));
+  EXPECT_EQ(count, 1);
+  EXPECT_TRUE(queue.Push(uint32_t{2}, count, std::chrono::milliseconds{10}));
+  EXPECT_EQ(count, 2);
+  EXPECT_FALSE(queue.Push(uint32_t{3}, count, std::chrono::milliseconds{10}));
+}
+
+TEST(LockFreeQueueTests, BatchOperationsPreserveOrder)
+{
+  fetch::core::MPMCQueue<uint32_t, 8> queue;
+
+  std::vector<uint32_t> input(12);
+  std::iota(input.begin(), input.end(), 0u);
+
+  // only the first 8 elements fit
+  EXPECT_EQ(queue.TryPushBatch(input.begin(), input.end()), 8);
+
+  std::vector<uint32_t> output;
+  EXPECT_EQ(queue.TryPopBatch(std::back_inserter(output), 5), 5);
+  EXPECT_EQ(queue.PopBatch(std::back_inserter(output), 100, std::chrono::milliseconds{10}), 3);
+  EXPECT_EQ(queue.PopBatch(std::back_inserter(output), 100, std::chrono::milliseconds{10}), 0);
+
+  ASSERT_EQ(output.size(), 8);
+  EXPECT_TRUE(std::equal(output.begin(), output.end(), input.begin()));
+}
+
+TEST(LockFreeQueueTests, BatchProducersAndConsumersDeliverEveryElementOnce)
+{
+  static constexpr std::size_t NUM_PRODUCERS         = 8;
+  static constexpr std::size_t NUM_CONSUMERS         = 8;
+  static constexpr std::size_t ELEMENTS_PER_PRODUCER = 20000;
+  static constexpr std::size_t BATCH_SIZE            = 37;
+  static constexpr std::size_t TOTAL_ELEMENTS        = NUM_PRODUCERS * ELEMENTS_PER_PRODUCER;
+
+  fetch::core::MPMCQueue<uint64_t, 256> queue;
+
+  std::vector<std::atomic<uint32_t>> seen(TOTAL_ELEMENTS);
+  for (auto &entry : seen)
+  {
+    entry = 0;
+  }
+  std::atomic<std::size_t> received{0};
+
+  std::vector<std::thread> threads;
+  for (std::size_t p = 0; p < NUM_PRODUCERS; ++p)
+  {
+    threads.emplace_back([&queue, p]() {
+      std::vector<uint64_t> batch;
+      for (std::size_t i = 0; i < ELEMENTS_PER_PRODUCER; ++i)
+      {
+        batch.push_back(p * ELEMENTS_PER_PRODUCER + i);
+        if (batch.size() == BATCH_SIZE)
+        {
+          queue.PushBatch(batch.begin(), batch.end());
+          batch.clear();
+        }
+      }
+      queue.PushBatch(batch.begin(), batch.end());
+    });
+  }
+
+  for (std::size_t c = 0; c < NUM_CONSUMERS; ++c)
+  {
+    threads.emplace_back([&queue, &seen, &received, c]() {
+      std::vector<uint64_t> batch;
+      while (received < TOTAL_ELEMENTS)
+      {
+        batch.clear();
+
+        // mix single and batch pops so that both claim paths interleave
+        if ((c & 1u) == 0)
+        {
+          queue.PopBatch(std::back_inserter(batch), BATCH_SIZE, std::chrono::milliseconds{1});
+        }
+        else
+        {
+          uint64_t value{0};
+          if (queue.Pop(value, std::chrono::milliseconds{1}))
+          {
+            batch.push_back(value);
+          }
+        }
+
+        for (auto const value : batch)
+        {
+          seen[value]++;
+        }
+        received += batch.size();
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(received, TOTAL_ELEMENTS);
+  EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](auto const &entry) { return entry == 1; }));
+}
+
 }  // namespace
@@ -0,0 +1,380 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/periodic_runnable.hpp"
+#include "core/reactor.hpp"
+#include "core/runnable.hpp"
+#include "core/state_machine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using fetch::core::Reactor;
+using fetch::core::Runnable;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Predicate>
+bool WaitFor(Predicate &&predicate, std::chrono::milliseconds const &timeout = 5000ms)
+{
+  auto const deadline = Clock::now() + timeout;
+  while (!predicate())
+  {
+    if (Clock::now() >= deadline)
+    {
+      return false;
+    }
+
+    std::this_thread::sleep_for(1ms);
+  }
+
+  return true;
+}
+
+class CountingRunnable : public Runnable
+{
+public:
+  explicit CountingRunnable(bool signalling, std::chrono::milliseconds duration = 0ms)
+    : duration_{duration}
+  {
+    if (signalling)
+    {
+      EnableSignalling();
+    }
+  }
+
+  bool IsReadyToExecute() const override
+  {
+    return ready;
+  }
+
+  void Execute() override
+  {
+    auto const active = ++active_;
+    max_active = std::max(max_active.load(), active);
+
+    std::this_thread::sleep_for(duration_);
+
+    last_executed = Clock::now();
+    ++executions;
+    --active_;
+  }
+
+  std::string GetId() const override
+  {
+    return "CountingRunnable";
+  }
+
+  std::atomic<bool>              ready{true};
+  std::atomic<std::size_t>       executions{0};
+  std::atomic<std::size_t>       max_active{0};
+  std::atomic<Clock::time_point> last_executed{};
+
+private:
+  std::chrono::milliseconds duration_;
+  std::atomic<std::size_t>  active_{0};
+};
+
+class RendezvousRunnable : public Runnable
+{
+public:
+  explicit RendezvousRunnable(std::atomic<std::size_t> &arrived)
+    : arrived_{arrived}
+  {
+    EnableSignalling();
+  }
+
+  void Execute() override
+  {
+    ++arrived_;
+
+    // only completes when the other runnable is executing at the same time
+    met = WaitFor([this]() { return arrived_ >= 2; }, 2000ms);
+  }
+
+  std::string GetId() const override
+  {
+    return "RendezvousRunnable";
+  }
+
+  std::atomic<bool> met{false};
+
+private:
+  std::atomic<std::size_t> &arrived_;
+};
+
+TEST(ReactorSchedulingTests, SignallingRunnablesOnlyExecuteWhenSignalled)
+{
+  auto runnable = std::make_shared<CountingRunnable>(true);
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(runnable);
+  reactor.Start();
+
+  // runnables are always evaluated once on attachment
+  ASSERT_TRUE(WaitFor([&runnable]() { return runnable->executions == 1; }));
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(runnable->executions, 1);
+
+  runnable->Signal();
+  ASSERT_TRUE(WaitFor([&runnable]() { return runnable->executions == 2; }));
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(runnable->executions, 2);
+}
+
+TEST(ReactorSchedulingTests, DelayedSignalsAreNotExecutedEarly)
+{
+  auto runnable = std::make_shared<CountingRunnable>(true);
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(runnable);
+  reactor.Start();
+
+  ASSERT_TRUE(WaitFor([&runnable]() { return runnable->executions == 1; }));
+
+  auto const signalled = Clock::now();
+  runnable->SignalAfter(100ms);
+
+  ASSERT_TRUE(WaitFor([&runnable]() { return runnable->executions == 2; }));
+  EXPECT_GE(runnable->last_executed.load() - signalled, 100ms);
+}
+
+TEST(ReactorSchedulingTests, SignalsBeforeAttachmentAreHonoured)
+{
+  auto runnable   = std::make_shared<CountingRunnable>(true);
+  runnable->ready = false;
+
+  auto const signalled = Clock::now();
+  runnable->SignalAfter(100ms);
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(runnable);
+  reactor.Start();
+
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(runnable->executions, 0);
+
+  runnable->ready = true;
+
+  ASSERT_TRUE(WaitFor([&runnable]() { return runnable->executions == 1; }));
+  EXPECT_GE(runnable->last_executed.load() - signalled, 100ms);
+}
+
+TEST(ReactorSchedulingTests, PolledRunnablesAreExecutedWhenReady)
+{
+  auto runnable   = std::make_shared<CountingRunnable>(false);
+  runnable->ready = false;
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(runnable);
+  reactor.Start();
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(runnable->executions, 0);
+
+  runnable->ready = true;
+  ASSERT_TRUE(WaitFor([&runnable]() { return runnable->executions > 10; }));
+}
+
+TEST(ReactorSchedulingTests, DetachedRunnablesAreNotExecuted)
+{
+  auto runnable = std::make_shared<CountingRunnable>(true);
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(runnable);
+  reactor.Start();
+
+  ASSERT_TRUE(WaitFor([&runnable]() { return runnable->executions == 1; }));
+  EXPECT_TRUE(reactor.Detach(*runnable));
+
+  runnable->Signal();
+  std::this_thread::sleep_for(50ms);
+
+  EXPECT_EQ(runnable->executions, 1);
+}
+
+TEST(ReactorSchedulingTests, IndependentRunnablesExecuteConcurrently)
+{
+  std::atomic<std::size_t> arrived{0};
+
+  auto first  = std::make_shared<RendezvousRunnable>(arrived);
+  auto second = std::make_shared<RendezvousRunnable>(arrived);
+
+  Reactor reactor{"Reactor", 2};
+  reactor.Attach(first);
+  reactor.Attach(second);
+  reactor.Start();
+
+  ASSERT_TRUE(WaitFor([&arrived]() { return arrived == 2; }));
+  EXPECT_TRUE(WaitFor([&first, &second]() { return first->met && second->met; }));
+}
+
+TEST(ReactorSchedulingTests, RunnablesAreNeverExecutedConcurrently)
+{
+  auto runnable = std::make_shared<CountingRunnable>(true, 1ms);
+
+  Reactor reactor{"Reactor", 4};
+  reactor.Attach(runnable);
+  reactor.Start();
+
+  std::vector<std::thread> signallers;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    signallers.emplace_back([&runnable]() {
+      for (std::size_t j = 0; j < 100; ++j)
+      {
+        runnable->Signal();
+        std::this_thread::sleep_for(100us);
+      }
+    });
+  }
+
+  for (auto &signaller : signallers)
+  {
+    signaller.join();
+  }
+
+  // signals raised during an execution are collapsed into a single further execution, so at
+  // most the current and one pending execution can remain
+  auto const executions = runnable->executions.load();
+  std::this_thread::sleep_for(50ms);
+  EXPECT_LE(runnable->executions, executions + 2);
+
+  EXPECT_GT(runnable->executions, 1);
+  EXPECT_EQ(runnable->max_active, 1);
+}
+
+TEST(ReactorSchedulingTests, DelayedStateMachinesDoNotSpin)
+{
+  enum class State
+  {
+    WAITING
+  };
+
+  using StateMachine = fetch::core::StateMachine<State>;
+
+  struct Handler
+  {
+    State OnWaiting()
+    {
+      ++executions;
+      state_machine->Delay(50ms);
+      return State::WAITING;
+    }
+
+    std::shared_ptr<StateMachine> state_machine;
+    std::atomic<std::size_t>      executions{0};
+  };
+
+  Handler handler;
+  handler.state_machine = std::make_shared<StateMachine>("Delayed", State::WAITING);
+  handler.state_machine->RegisterHandler(State::WAITING, &handler, &Handler::OnWaiting);
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(handler.state_machine);
+  reactor.Start();
+
+  std::this_thread::sleep_for(275ms);
+  reactor.Stop();
+
+  EXPECT_GE(handler.executions, 3);
+  EXPECT_LE(handler.executions, 6);
+}
+
+TEST(ReactorSchedulingTests, FailingStateMachinesAreExecutedAgain)
+{
+  enum class State
+  {
+    FAILING
+  };
+
+  using StateMachine = fetch::core::StateMachine<State>;
+
+  struct Handler
+  {
+    State OnFailing()
+    {
+      if (++executions <= 3)
+      {
+        throw std::runtime_error("handler failure");
+      }
+
+      return State::FAILING;
+    }
+
+    std::atomic<std::size_t> executions{0};
+  };
+
+  Handler handler;
+  auto    state_machine = std::make_shared<StateMachine>("Failing", State::FAILING);
+  state_machine->RegisterHandler(State::FAILING, &handler, &Handler::OnFailing);
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(state_machine);
+  reactor.Start();
+
+  EXPECT_TRUE(WaitFor([&handler]() { return handler.executions > 4; }));
+
+  reactor.Stop();
+}
+
+TEST(ReactorSchedulingTests, FailingPeriodicRunnablesAreExecutedAgain)
+{
+  class FailingRunnable : public fetch::core::PeriodicRunnable
+  {
+  public:
+    FailingRunnable()
+      : PeriodicRunnable("Failing", 10ms)
+    {}
+
+    void Periodically() override
+    {
+      ++executions;
+      throw std::runtime_error("periodic failure");
+    }
+
+    std::atomic<std::size_t> executions{0};
+  };
+
+  auto runnable = std::make_shared<FailingRunnable>();
+
+  Reactor reactor{"Reactor"};
+  reactor.Attach(runnable);
+  reactor.Start();
+
+  EXPECT_TRUE(WaitFor([&runnable]() { return runnable->executions > 2; }));
+
+  reactor.Stop();
+}
+
+}  // namespace
@@ -285,6 +285,22 @@ TEST(BitVectorTests, ExpandTo64)
   EXPECT_EQ(other.bit(63), 1);
 }
 
+TEST(BitVectorTests, RemapToSameSizeIsIndependentCopy)
+{
+  BitVector mask{8};
+  mask.set(2, 1);
+
+  BitVector other{8};
+  ASSERT_TRUE(mask.RemapTo(other));
+  EXPECT_EQ(other, mask);
+
+  // updating the remapped vector must not alter the source
+  other.set(5, 1);
+
+  EXPECT_EQ(mask.bit(5), 0);
+  EXPECT_EQ(other.bit(5), 1);
+}
+
 TEST(BitVectorTests, ContractFrom8)
 {
   // set and initial mask
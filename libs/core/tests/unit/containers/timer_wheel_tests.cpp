@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/timer_wheel.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+using fetch::core::TimerWheel;
+
+using Wheel = TimerWheel<uint64_t>;
+using Tick  = Wheel::Tick;
+using Ticks = std::vector<Tick>;
+
+Ticks GenerateDueTicks(std::size_t count, Tick start, Tick range)
+{
+  std::mt19937_64                         rng{42};
+  std::uniform_int_distribution<uint64_t> dist{0, range};
+
+  Ticks ticks;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ticks.push_back(start + dist(rng));
+  }
+
+  return ticks;
+}
+
+TEST(TimerWheelTests, EmptyWheelHasNoEvents)
+{
+  Wheel wheel{};
+
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.NextEvent(), Wheel::NEVER);
+  EXPECT_EQ(wheel.Advance(1000, [](uint64_t) { FAIL(); }), 0);
+  EXPECT_EQ(wheel.current(), 1000);
+}
+
+TEST(TimerWheelTests, TimersInThePastExpireImmediately)
+{
+  Wheel wheel{100};
+
+  wheel.Add(50, 1);
+  wheel.Add(100, 2);
+
+  EXPECT_EQ(wheel.size(), 2);
+  EXPECT_EQ(wheel.NextEvent(), 100);
+
+  std::vector<uint64_t> expired;
+  EXPECT_EQ(wheel.Advance(100, [&expired](uint64_t item) { expired.push_back(item); }), 2);
+  EXPECT_EQ(expired, (std::vector<uint64_t>{1, 2}));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTests, TimersExpireOnTheirDueTick)
+{
+  Tick const start = 12345;
+  auto const due   = GenerateDueTicks(2000, start, 300000);
+
+  Wheel               wheel{start};
+  std::multiset<Tick> pending{};
+  for (std::size_t i = 0; i < due.size(); ++i)
+  {
+    wheel.Add(due[i], i);
+    pending.insert(due[i]);
+  }
+
+  for (Tick tick = start; !wheel.empty(); ++tick)
+  {
+    // the next event must never be after the earliest pending timer
+    EXPECT_LE(wheel.NextEvent(), *pending.begin());
+
+    wheel.Advance(tick, [&due, &pending, tick](uint64_t item) {
+      EXPECT_EQ(due[item], tick);
+      pending.erase(pending.find(due[item]));
+    });
+  }
+
+  EXPECT_TRUE(pending.empty());
+}
+
+TEST(TimerWheelTests, LargeAdvancesReportAllExpiredTimers)
+{
+  Tick const start = 7;
+  auto const due   = GenerateDueTicks(5000, start, 1u << 22u);
+
+  Wheel wheel{start};
+  for (std::size_t i = 0; i < due.size(); ++i)
+  {
+    wheel.Add(due[i], i);
+  }
+
+  std::vector<bool> seen(due.size(), false);
+  for (Tick now = start; !wheel.empty(); now += 9973)
+  {
+    wheel.Advance(now, [&due, &seen, now](uint64_t item) {
+      EXPECT_LE(due[item], now);
+      EXPECT_GT(due[item] + 9973, now);
+      EXPECT_FALSE(seen[item]);
+      seen[item] = true;
+    });
+
+    // all timers remaining on the wheel must be in the future
+    EXPECT_TRUE(wheel.empty() || (wheel.NextEvent() > now));
+  }
+
+  for (auto const &value : seen)
+  {
+    EXPECT_TRUE(value);
+  }
+}
+
+TEST(TimerWheelTests, TimersBeyondTheHorizonAreHeld)
+{
+  Tick const start = 3;
+  Tick const far   = start + (Tick{1} << 30u) + 17;
+
+  Wheel wheel{start};
+  wheel.Add(far, 1);
+  wheel.Add(start + 10, 2);
+
+  std::map<uint64_t, Tick> expired;
+  auto handler = [&expired, &wheel](uint64_t item) { expired[item] = wheel.current(); };
+
+  wheel.Advance(far - 1, handler);
+  ASSERT_EQ(expired.size(), 1);
+  EXPECT_EQ(expired[2], start + 10);
+
+  wheel.Advance(far, handler);
+  ASSERT_EQ(expired.size(), 2);
+  EXPECT_EQ(expired[1], far);
+}
+
+TEST(TimerWheelTests, TimersCanBeAddedWhileAdvancing)
+{
+  Wheel wheel{0};
+  wheel.Add(10, 0);
+
+  std::vector<Tick> expired;
+  for (Tick tick = 0; tick <= 100; ++tick)
+  {
+    wheel.Advance(tick, [&wheel, &expired](uint64_t item) {
+      expired.push_back(wheel.current());
+
+      // re-arm the timer for another 10 ticks
+      if (item < 5)
+      {
+        wheel.Add(wheel.current() + 10, item + 1);
+      }
+    });
+  }
+
+  EXPECT_EQ(expired, (std::vector<Tick>{10, 20, 30, 40, 50, 60}));
+  EXPECT_TRUE(wheel.empty());
+}
+
+}  // namespace
@@ -103,6 +103,118 @@ void VerifyBLSSignature(benchmark::State &state)
   }
 }
 
+void VerifyBLSSignatureSharesIndividually(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  // Create keys
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  // Every cabinet member signs the same message, as for notarisations and beacon shares
+  ConstByteArray                          msg = GenerateRandomData(256);
+  fetch::crypto::mcl::SignedMessageShares shares;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    shares.emplace_back(outputs[i].public_key_shares[i], msg,
+                        fetch::crypto::mcl::SignShare(msg, outputs[i].private_key_share));
+  }
+
+  for (auto _ : state)
+  {
+    for (auto const &share : shares)
+    {
+      benchmark::DoNotOptimize(fetch::crypto::mcl::VerifySign(share.public_key, share.message,
+                                                              share.signature, generator));
+    }
+  }
+}
+
+void VerifyBLSSignatureSharesBatch(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  // Create keys
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  // Every cabinet member signs the same message, as for notarisations and beacon shares
+  ConstByteArray                          msg = GenerateRandomData(256);
+  fetch::crypto::mcl::SignedMessageShares shares;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    shares.emplace_back(outputs[i].public_key_shares[i], msg,
+                        fetch::crypto::mcl::SignShare(msg, outputs[i].private_key_share));
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(fetch::crypto::mcl::VerifySignBatch(shares, generator));
+  }
+}
+
+void VerifyBLSSignatureSharesBatchDistinctMessages(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  // Create keys
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  // Worst case for batching: every member signs a different message
+  fetch::crypto::mcl::SignedMessageShares shares;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    ConstByteArray msg = GenerateRandomData(256);
+    shares.emplace_back(outputs[i].public_key_shares[i], msg,
+                        fetch::crypto::mcl::SignShare(msg, outputs[i].private_key_share));
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(fetch::crypto::mcl::VerifySignBatch(shares, generator));
+  }
+}
+
+void FindInvalidBLSSignatureShares(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  // Create keys
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  ConstByteArray                          msg = GenerateRandomData(256);
+  fetch::crypto::mcl::SignedMessageShares shares;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    shares.emplace_back(outputs[i].public_key_shares[i], msg,
+                        fetch::crypto::mcl::SignShare(msg, outputs[i].private_key_share));
+  }
+
+  // Corrupt a single randomly selected share
+  auto bad_index = static_cast<uint32_t>(rng() % cabinet_size);
+  shares[bad_index].signature =
+      fetch::crypto::mcl::SignShare(GenerateRandomData(256), outputs[bad_index].private_key_share);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(fetch::crypto::mcl::FindInvalidSignatures(shares, generator));
+  }
+}
+
 void ComputeGroupSignature(benchmark::State &state)
 {
   // Create keys
@@ -134,4 +246,8 @@ void ComputeGroupSignature(benchmark::State &state)
 
 BENCHMARK(SignBLSSignature)->RangeMultiplier(2)->Range(50, 500);
 BENCHMARK(VerifyBLSSignature)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(VerifyBLSSignatureSharesIndividually)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(VerifyBLSSignatureSharesBatch)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(VerifyBLSSignatureSharesBatchDistinctMessages)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(FindInvalidBLSSignatureShares)->RangeMultiplier(2)->Range(50, 500);
 BENCHMARK(ComputeGroupSignature)->RangeMultiplier(2)->Range(50, 500);
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "crypto/sha256.hpp"
+#include "vectorise/platform.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::Hash;
+using fetch::crypto::MerkleTree;
+using fetch::crypto::SHA256;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+using RNG = LinearCongruentialGenerator;
+
+RNG rng;
+
+ConstByteArray GenerateDigest()
+{
+  static constexpr std::size_t NUM_WORDS = MerkleTree::DIGEST_SIZE / sizeof(RNG::RandomType);
+
+  ByteArray buffer;
+  buffer.Resize(MerkleTree::DIGEST_SIZE);
+
+  auto *words = reinterpret_cast<RNG::RandomType *>(buffer.pointer());
+  for (std::size_t i = 0; i < NUM_WORDS; ++i)
+  {
+    *words++ = rng();
+  }
+
+  return ConstByteArray{buffer};
+}
+
+void PopulateTree(MerkleTree &tree)
+{
+  for (auto &leaf : tree)
+  {
+    leaf = GenerateDigest();
+  }
+}
+
+// the original implementation, condensing a padded copy of the leaves one level at a time
+ConstByteArray CalculateReferenceRoot(MerkleTree::Container const &leaves)
+{
+  auto hashes = leaves;
+
+  while (!fetch::platform::IsLog2(uint64_t(hashes.size())))
+  {
+    hashes.emplace_back();
+  }
+
+  while (hashes.size() > 1)
+  {
+    for (std::size_t i = 0, j = 0; i < hashes.size(); i += 2, ++j)
+    {
+      hashes[j] = Hash<SHA256>(hashes[i] + hashes[i + 1]);
+    }
+
+    hashes.resize(hashes.size() / 2);
+  }
+
+  return hashes[0];
+}
+
+void MerkleTree_CalculateRootReference(benchmark::State &state)
+{
+  MerkleTree tree{static_cast<std::size_t>(state.range(0))};
+  PopulateTree(tree);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(CalculateReferenceRoot(tree.leaf_nodes()));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// range(1) is the number of threads, zero selecting the hardware concurrency
+void MerkleTree_CalculateRoot(benchmark::State &state)
+{
+  auto const num_threads = static_cast<std::size_t>(state.range(1));
+
+  MerkleTree tree{static_cast<std::size_t>(state.range(0))};
+  PopulateTree(tree);
+
+  for (auto _ : state)
+  {
+    if (num_threads == 0)
+    {
+      tree.CalculateRoot();
+    }
+    else
+    {
+      tree.CalculateRoot(num_threads);
+    }
+
+    benchmark::DoNotOptimize(tree.root());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void MerkleTree_UpdateLeaf(benchmark::State &state)
+{
+  auto const size = static_cast<std::size_t>(state.range(0));
+
+  MerkleTree tree{size};
+  PopulateTree(tree);
+  tree.CalculateRoot();
+
+  std::vector<ConstByteArray> updates(64);
+  for (auto &update : updates)
+  {
+    update = GenerateDigest();
+  }
+
+  std::size_t counter{0};
+  for (auto _ : state)
+  {
+    tree.Update((counter * 7919u) % size, updates[counter % updates.size()]);
+    ++counter;
+
+    benchmark::DoNotOptimize(tree.root());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(MerkleTree_CalculateRootReference)->Range(1 << 10, 1 << 20)->RangeMultiplier(32);
+BENCHMARK(MerkleTree_CalculateRoot)
+    ->RangeMultiplier(32)
+    ->Ranges({{1 << 10, 1 << 20}, {0, 1}})
+    ->UseRealTime();
+BENCHMARK(MerkleTree_UpdateLeaf)->Range(1 << 10, 1 << 20)->RangeMultiplier(32);
@@ -20,6 +20,7 @@
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/random/lcg.hpp"
 #include "crypto/ecdsa.hpp"
+#include "crypto/secp256k1.hpp"
 
 #include "benchmark/benchmark.h"
 
@@ -27,6 +28,8 @@
 
 using fetch::crypto::ECDSASigner;
 using fetch::crypto::ECDSAVerifier;
+using fetch::crypto::Secp256k1Verifier;
+using fetch::crypto::Verifier;
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ByteArray;
 using fetch::random::LinearCongruentialGenerator;
@@ -57,14 +60,15 @@ ConstByteArray GenerateRandomData()
   return ConstByteArray{buffer};
 }
 
+template <typename VerifierType>
 void VerifySignature(benchmark::State &state)
 {
   // generate a random message
   ConstByteArray msg = GenerateRandomData<2048>();
 
   // create the signer and verifier
-  ECDSASigner   signer;
-  ECDSAVerifier verifier(signer.identity());
+  ECDSASigner  signer;
+  VerifierType verifier(signer.identity());
 
   // create the signed data
   auto const signature = signer.Sign(msg);
@@ -76,10 +80,48 @@ void VerifySignature(benchmark::State &state)
   for (auto _ : state)
   {
     // run the verification
-    verifier.Verify(msg, signature);
+    benchmark::DoNotOptimize(verifier.Verify(msg, signature));
+  }
+}
+
+void VerifySignatureFromIdentity(benchmark::State &state)
+{
+  // generate a random message
+  ConstByteArray msg = GenerateRandomData<2048>();
+
+  ECDSASigner signer;
+  auto const  identity = signer.identity();
+
+  // create the signed data
+  auto const signature = signer.Sign(msg);
+  if (signature.empty())
+  {
+    throw std::runtime_error("Unable to sign the message");
+  }
+
+  for (auto _ : state)
+  {
+    // build the verifier on every call, as is done for transactions and packets
+    benchmark::DoNotOptimize(Verifier::Verify(identity, msg, signature));
+  }
+}
+
+void SignMessage(benchmark::State &state)
+{
+  // generate a random message
+  ConstByteArray msg = GenerateRandomData<2048>();
+
+  ECDSASigner signer;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(signer.Sign(msg));
   }
 }
 
 }  // namespace
 
-BENCHMARK(VerifySignature);
+BENCHMARK_TEMPLATE(VerifySignature, ECDSAVerifier);
+BENCHMARK_TEMPLATE(VerifySignature, Secp256k1Verifier);
+BENCHMARK(VerifySignatureFromIdentity);
+BENCHMARK(SignMessage);
@@ -98,7 +98,8 @@ public:
 
   ConstByteArray Sign(ConstByteArray const &text) const final
   {
-    // sign the message in a thread safe way
+    // sign the message in a thread safe way. Signing always goes through OpenSSL, the native
+    // secp256k1 code (Secp256k1Verifier) is verify-only and never handles private keys
     return private_key_.Apply(
         [&text](PrivateKey const &key) { return Signature::Sign(key, text).signature(); });
   }
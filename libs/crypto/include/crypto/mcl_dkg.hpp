@@ -28,6 +28,7 @@
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
 namespace bn = mcl::bn256;
 
@@ -110,6 +111,21 @@ using CabinetIndex       = uint32_t;
 using SignerRecord       = std::vector<uint8_t>;
 using AggregateSignature = std::pair<Signature, SignerRecord>;
 
+/**
+ * A single (public key, message, signature) triple to be checked as part of a batch
+ */
+struct SignedMessageShare
+{
+  SignedMessageShare() = default;
+  SignedMessageShare(PublicKey public_key1, MessagePayload message1, Signature signature1);
+
+  PublicKey      public_key;
+  MessagePayload message;
+  Signature      signature;
+};
+
+using SignedMessageShares = std::vector<SignedMessageShare>;
+
 /**
  * Vector initialisation for mcl data structures
  *
@@ -173,6 +189,9 @@ std::vector<PrivateKey> InterpolatePolynom(std::vector<PrivateKey> const &a,
 Signature SignShare(MessagePayload const &message, PrivateKey const &x_i);
 bool      VerifySign(PublicKey const &y, MessagePayload const &message, Signature const &sign,
                      Generator const &G);
+bool      VerifySignBatch(SignedMessageShares const &shares, Generator const &G);
+std::vector<std::size_t> FindInvalidSignatures(SignedMessageShares const &shares,
+                                               Generator const &          G);
 Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> const &shares);
 std::vector<DkgKeyInformation> TrustedDealerGenerateKeys(uint32_t cabinet_size, uint32_t threshold);
 std::pair<PrivateKey, PublicKey> GenerateKeyPair(Generator const &generator);
@@ -21,11 +21,29 @@
 #include "core/serializers/group_definitions.hpp"
 #include "core/serializers/main_serializer.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace fetch {
 namespace crypto {
 
+class SHA256;
+
+/**
+ * Binary Merkle tree over a set of leaves, padded with empty leaves up to a power of two.
+ *
+ * The interior nodes are kept as fixed size digests in a single flat buffer so that computing the
+ * root does not allocate per node. Large trees are hashed in parallel, each thread building a
+ * disjoint set of subtrees, and once the root has been calculated single leaves can be changed with
+ * Update at a cost of O(log n) hashes. Callers with their own threads can build the subtrees
+ * themselves with PrepareSubtrees, CalculateSubtree and CompleteRoot.
+ *
+ * Writing to leaves through operator[] or the non-const iterators invalidates the cached interior
+ * nodes, so that the next Update rebuilds the whole tree. Writes through references obtained
+ * before the last CalculateRoot or Update are not tracked and must be followed by CalculateRoot.
+ */
 class MerkleTree
 {
 public:
@@ -34,6 +52,11 @@ public:
   using Iterator      = Container::iterator;
   using ConstIterator = Container::const_iterator;
 
+  static constexpr std::size_t DIGEST_SIZE = 32;
+
+  /// The minimum number of leaves for each thread when calculating the root in parallel
+  static constexpr std::size_t MIN_LEAVES_PER_THREAD = 1024;
+
   explicit MerkleTree(std::size_t count);
   MerkleTree(MerkleTree const &rhs) = delete;
   MerkleTree(MerkleTree &&rhs)      = default;
@@ -56,13 +79,42 @@ public:
   std::size_t      size() const;
 
   void CalculateRoot() const;
+  void CalculateRoot(std::size_t num_threads) const;
+  void Update(std::size_t n, Digest leaf);
+
+  /// @name Distributed Root Calculation
+  /// @{
+  std::size_t PrepareSubtrees(std::size_t max_subtrees,
+                              std::size_t min_leaves = MIN_LEAVES_PER_THREAD) const;
+  void        CalculateSubtree(std::size_t subtree) const;
+  void        CompleteRoot() const;
+  /// @}
 
   Digest &operator[](std::size_t n);
 
 private:
+  using Node  = std::array<uint8_t, DIGEST_SIZE>;
+  using Nodes = std::vector<Node>;
+
+  void        AllocateLevels() const;
+  std::size_t LevelSize(std::size_t level) const;
+  void        HashNode(SHA256 &hasher, std::size_t level, std::size_t index) const;
+  void        HashLevels(SHA256 &hasher, std::size_t first_level, std::size_t last_level,
+                         std::size_t leaf_begin, std::size_t leaf_end) const;
+  void        UpdateRootFromCache() const;
+
   Container      leaf_nodes_;
   mutable Digest root_;
 
+  /// @name Interior node cache
+  /// @{
+  mutable Nodes                    nodes_;          ///< Levels 1 (above the leaves) to the root
+  mutable std::vector<std::size_t> level_offsets_;  ///< Offset of each level into nodes_
+  mutable Nodes                    padding_;        ///< Digest of an empty subtree per level
+  mutable bool                     cache_valid_{false};
+  mutable std::size_t              subtree_levels_{0};  ///< Levels built by CalculateSubtree
+  /// @}
+
   template <typename T, typename D>
   friend struct serializers::MapSerializer;
 };
@@ -94,6 +146,8 @@ public:
   {
     map.ExpectKeyGetValue(LEAF_NODES, data.leaf_nodes_);
     map.ExpectKeyGetValue(ROOT, data.root_);
+
+    data.cache_valid_ = false;
   }
 };
 
@@ -0,0 +1,82 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/identity.hpp"
+#include "crypto/verifier.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace crypto {
+namespace secp256k1 {
+
+/**
+ * 256-bit integer stored as four little endian 64-bit limbs
+ */
+using Limbs = std::array<uint64_t, 4>;
+
+constexpr std::size_t PUBLIC_KEY_SIZE = 64;
+constexpr std::size_t SIGNATURE_SIZE  = 64;
+
+/**
+ * Affine coordinates of a public key which has been checked to lie on the curve
+ */
+struct PublicKey
+{
+  Limbs x{};
+  Limbs y{};
+};
+
+bool ParsePublicKey(byte_array::ConstByteArray const &key, PublicKey &public_key);
+bool VerifyHash(PublicKey const &public_key, byte_array::ConstByteArray const &hash,
+                byte_array::ConstByteArray const &signature);
+
+}  // namespace secp256k1
+
+/**
+ * Native verifier for canonical (r || s) ECDSA signatures over secp256k1.
+ *
+ * The scalar multiplications use the curve endomorphism to halve the length of the doubling chain
+ * and precomputed tables of multiples of the generator. Signatures in any other encoding are
+ * passed on to the OpenSSL based ECDSAVerifier. There is no native signer, signatures are still
+ * created by the OpenSSL based ECDSASigner.
+ */
+class Secp256k1Verifier : public Verifier
+{
+public:
+  explicit Secp256k1Verifier(Identity identity);
+
+  bool Verify(ConstByteArray const &data, ConstByteArray const &signature) override;
+  bool VerifyHash(ConstByteArray const &hash, ConstByteArray const &signature) const;
+
+  Identity identity() const override;
+
+  explicit operator bool() const;
+
+private:
+  Identity             identity_;
+  secp256k1::PublicKey public_key_{};
+  bool                 valid_{false};
+};
+
+}  // namespace crypto
+}  // namespace fetch
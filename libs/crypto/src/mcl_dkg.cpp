@@ -22,8 +22,11 @@
 
 #include <cassert>
 #include <cstddef>
+#include <map>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace bn = mcl::bn256;
 
@@ -71,6 +74,13 @@ AggregatePublicKey::AggregatePublicKey(PublicKey const &public_key, PrivateKey c
   bn::G2::mul(aggregate_public_key, public_key, coefficient);
 }
 
+SignedMessageShare::SignedMessageShare(PublicKey public_key1, MessagePayload message1,
+                                       Signature signature1)  // NOLINT
+  : public_key{std::move(public_key1)}
+  , message{std::move(message1)}
+  , signature{std::move(signature1)}
+{}
+
 DkgKeyInformation::DkgKeyInformation(PublicKey              group_public_key1,
                                      std::vector<PublicKey> public_key_shares1,
                                      PrivateKey             secret_key_shares1)  // NOLINT
@@ -278,6 +288,172 @@ bool VerifySign(PublicKey const &y, MessagePayload const &message, Signature con
   return e1 == e2;
 }
 
+namespace {
+
+/**
+ * Batch verification below this size falls back to checking each share individually when
+ * searching for invalid shares, since bisection no longer saves any pairings
+ */
+constexpr std::size_t MIN_BISECTION_SIZE = 4;
+
+/**
+ * Checks a subset of the signature shares using a random linear combination. With random
+ * coefficients r_i the individual equations e(sig_i, G) == e(H(m_i), y_i) hold for all i (with
+ * overwhelming probability) if and only if
+ *
+ *   e(-sum_i r_i sig_i, G) * prod_m e(H(m), sum_{i : m_i = m} r_i y_i) == 1
+ *
+ * Shares which sign the same message share a single Miller loop and all loops share one final
+ * exponentiation.
+ *
+ * @param shares All signature shares
+ * @param indices The indices of the shares to be checked together
+ * @param G Generator used in DKG
+ * @return true if all shares in the subset are valid, otherwise false
+ */
+bool VerifySignSubset(SignedMessageShares const &shares, std::vector<std::size_t> const &indices,
+                      Generator const &G)
+{
+  if (indices.empty())
+  {
+    return true;
+  }
+
+  if (indices.size() == 1)
+  {
+    auto const &share = shares[indices.front()];
+    return VerifySign(share.public_key, share.message, share.signature, G);
+  }
+
+  // Combined public keys for each distinct message
+  std::map<MessagePayload, PublicKey> message_keys;
+
+  Signature  combined_signature;
+  Signature  tmp_signature;
+  PublicKey  tmp_key;
+  PrivateKey coefficient;
+
+  for (auto const index : indices)
+  {
+    auto const &share = shares[index];
+    coefficient.setRand();
+
+    bn::G1::mul(tmp_signature, share.signature, coefficient);
+    bn::G1::add(combined_signature, combined_signature, tmp_signature);
+
+    auto &message_key = message_keys[share.message];
+    bn::G2::mul(tmp_key, share.public_key, coefficient);
+    bn::G2::add(message_key, message_key, tmp_key);
+  }
+
+  bn::Fp12 accumulated;
+  bn::Fp12 loop;
+
+  bn::G1::neg(combined_signature, combined_signature);
+  bn::millerLoop(accumulated, combined_signature, G);
+
+  Signature PH;
+  bn::Fp    Hm;
+  for (auto const &message_key : message_keys)
+  {
+    Hm.setHashOf(message_key.first.pointer(), message_key.first.size());
+    bn::mapToG1(PH, Hm);
+
+    bn::millerLoop(loop, PH, message_key.second);
+    bn::Fp12::mul(accumulated, accumulated, loop);
+  }
+
+  bn::finalExp(accumulated, accumulated);
+
+  return accumulated.isOne();
+}
+
+/**
+ * Recursively bisects a failing batch in order to locate the invalid shares
+ *
+ * @param shares All signature shares
+ * @param indices The indices of the shares known to contain at least one invalid share
+ * @param G Generator used in DKG
+ * @param invalid Output list of invalid share indices
+ */
+void BisectInvalidSignatures(SignedMessageShares const &shares, std::vector<std::size_t> indices,
+                             Generator const &G, std::vector<std::size_t> &invalid)
+{
+  if (indices.size() <= MIN_BISECTION_SIZE)
+  {
+    for (auto const index : indices)
+    {
+      auto const &share = shares[index];
+      if (!VerifySign(share.public_key, share.message, share.signature, G))
+      {
+        invalid.push_back(index);
+      }
+    }
+    return;
+  }
+
+  auto const               middle = static_cast<std::ptrdiff_t>(indices.size() / 2);
+  std::vector<std::size_t> lower(indices.begin(), indices.begin() + middle);
+  std::vector<std::size_t> upper(indices.begin() + middle, indices.end());
+
+  if (!VerifySignSubset(shares, lower, G))
+  {
+    BisectInvalidSignatures(shares, std::move(lower), G, invalid);
+  }
+
+  if (!VerifySignSubset(shares, upper, G))
+  {
+    BisectInvalidSignatures(shares, std::move(upper), G, invalid);
+  }
+}
+
+std::vector<std::size_t> AllIndices(SignedMessageShares const &shares)
+{
+  std::vector<std::size_t> indices(shares.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+  {
+    indices[i] = i;
+  }
+  return indices;
+}
+
+}  // namespace
+
+/**
+ * Verifies a batch of signatures at once. This is considerably cheaper than calling VerifySign
+ * for each share, particularly when many shares sign the same message.
+ *
+ * @param shares The public key, message and signature triples to be verified
+ * @param G Generator used in DKG
+ * @return true if every signature in the batch is valid, otherwise false
+ */
+bool VerifySignBatch(SignedMessageShares const &shares, Generator const &G)
+{
+  return VerifySignSubset(shares, AllIndices(shares), G);
+}
+
+/**
+ * Verifies a batch of signatures and identifies the invalid ones. When every share is valid this
+ * costs the same as VerifySignBatch.
+ *
+ * @param shares The public key, message and signature triples to be verified
+ * @param G Generator used in DKG
+ * @return The indices (in ascending order) of the shares with invalid signatures
+ */
+std::vector<std::size_t> FindInvalidSignatures(SignedMessageShares const &shares,
+                                               Generator const &          G)
+{
+  std::vector<std::size_t> invalid;
+  auto                     indices = AllIndices(shares);
+
+  if (!VerifySignSubset(shares, indices, G))
+  {
+    BisectInvalidSignatures(shares, std::move(indices), G, invalid);
+  }
+
+  return invalid;
+}
+
 /**
  * Computes the group signature using the indices and signature shares of threshold_ + 1
  * parties
@@ -21,9 +21,12 @@
 #include "crypto/sha256.hpp"
 #include "vectorise/platform.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <thread>
+#include <utility>
 
 namespace fetch {
 namespace crypto {
@@ -37,10 +40,113 @@ MerkleTree::MerkleTree(std::size_t count)
 
 HashArray &MerkleTree::operator[](std::size_t n)
 {
+  // the leaf can be changed through the returned reference
+  cache_valid_ = false;
+
   return leaf_nodes_.at(n);
 }
 
 void MerkleTree::CalculateRoot() const
+{
+  CalculateRoot(std::max(std::size_t{1}, std::size_t{std::thread::hardware_concurrency()}));
+}
+
+/**
+ * Calculate the root of the tree, rebuilding all of the cached interior nodes
+ *
+ * The leaves are split into equally sized (power of two) aligned ranges, each of which is hashed
+ * up to its own subtree root by a separate thread. The remaining top levels are then completed on
+ * the calling thread.
+ *
+ * @param num_threads The maximum number of threads to use
+ */
+void MerkleTree::CalculateRoot(std::size_t num_threads) const
+{
+  std::size_t const num_subtrees = PrepareSubtrees(num_threads);
+
+  std::vector<std::thread> workers{};
+  workers.reserve(num_subtrees);
+
+  for (std::size_t subtree = 1; subtree < num_subtrees; ++subtree)
+  {
+    workers.emplace_back([this, subtree]() { CalculateSubtree(subtree); });
+  }
+
+  if (num_subtrees > 0)
+  {
+    CalculateSubtree(0);
+  }
+
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+
+  CompleteRoot();
+}
+
+/**
+ * Prepare the tree for its root to be calculated by building its subtrees separately
+ *
+ * The leaves are split into equally sized (power of two) aligned ranges. Each returned subtree must
+ * be built with CalculateSubtree, which may be called concurrently for different subtrees, before
+ * CompleteRoot calculates the root from them. Trees with fewer than two leaves have no subtrees.
+ *
+ * @param max_subtrees The maximum number of subtrees to split the leaves into
+ * @param min_leaves The minimum number of leaves in each subtree, unless there is only one
+ * @return The number of subtrees which must be built
+ */
+std::size_t MerkleTree::PrepareSubtrees(std::size_t max_subtrees, std::size_t min_leaves) const
+{
+  subtree_levels_ = 0;
+
+  if (leaf_nodes_.size() <= 1)
+  {
+    return 0;
+  }
+
+  AllocateLevels();
+
+  std::size_t const num_levels = level_offsets_.size() - 1;
+  std::size_t const padded     = std::size_t{1} << num_levels;
+
+  // determine the number of subtrees to be built separately, each of at least one pair of leaves
+  min_leaves = std::max(min_leaves, std::size_t{2});
+
+  std::size_t num_chunks = 1;
+  while ((num_chunks * 2 <= max_subtrees) && (padded / (num_chunks * 2) >= min_leaves) &&
+         (padded / (num_chunks * 2) < leaf_nodes_.size()))
+  {
+    num_chunks *= 2;
+  }
+
+  subtree_levels_ = num_levels - platform::ToLog2(uint64_t(num_chunks));
+
+  // only the subtrees which contain leaves need to be built
+  std::size_t const chunk_size = std::size_t{1} << subtree_levels_;
+
+  return (leaf_nodes_.size() + chunk_size - 1) / chunk_size;
+}
+
+/**
+ * Build one of the subtrees determined by PrepareSubtrees
+ *
+ * @param subtree The index of the subtree
+ */
+void MerkleTree::CalculateSubtree(std::size_t subtree) const
+{
+  assert(subtree_levels_ > 0);
+
+  std::size_t const chunk_size = std::size_t{1} << subtree_levels_;
+
+  SHA256 hasher{};
+  HashLevels(hasher, 1, subtree_levels_, subtree * chunk_size, (subtree + 1) * chunk_size);
+}
+
+/**
+ * Calculate the root once all of the subtrees determined by PrepareSubtrees have been built
+ */
+void MerkleTree::CompleteRoot() const
 {
   if (leaf_nodes_.empty())
   {
@@ -50,34 +156,180 @@ void MerkleTree::CalculateRoot() const
   if (leaf_nodes_.size() == 1)
   {
     // special case if there is only one node in the tree it is its own merkle root
+    root_        = leaf_nodes_[0];
+    cache_valid_ = true;
+    return;
+  }
+
+  // complete the levels above the subtrees
+  std::size_t const num_levels = level_offsets_.size() - 1;
+
+  SHA256 hasher{};
+  HashLevels(hasher, subtree_levels_ + 1, num_levels, 0, std::size_t{1} << num_levels);
+
+  UpdateRootFromCache();
+  cache_valid_ = true;
+}
+
+/**
+ * Replace a single leaf of the tree and update the root
+ *
+ * If the root has previously been calculated only the O(log n) nodes on the path from the leaf to
+ * the root are recomputed, otherwise the whole tree is built.
+ *
+ * @param n The index of the leaf
+ * @param leaf The new value of the leaf
+ */
+void MerkleTree::Update(std::size_t n, Digest leaf)
+{
+  leaf_nodes_.at(n) = std::move(leaf);
+
+  if (!cache_valid_)
+  {
+    CalculateRoot();
+    return;
+  }
+
+  if (leaf_nodes_.size() == 1)
+  {
     root_ = leaf_nodes_[0];
     return;
   }
 
-  // make a copy of the leaf nodes which are then condensed
-  std::vector<Digest> hashes = leaf_nodes_;
+  SHA256 hasher{};
 
-  // If necessary bump the 'leaves' up to a power of 2
-  while (!platform::IsLog2(uint64_t(hashes.size())))
+  std::size_t const num_levels = level_offsets_.size() - 1;
+  for (std::size_t level = 1; level <= num_levels; ++level)
   {
-    hashes.emplace_back();
+    HashNode(hasher, level, n >> level);
   }
 
-  // Now, repeatedly condense the vector by calculating the parents of each of the roots
-  while (hashes.size() > 1)
+  UpdateRootFromCache();
+}
+
+/**
+ * Size the interior node cache for the current number of leaves and compute the digests of the
+ * empty subtrees used as padding on each level
+ */
+void MerkleTree::AllocateLevels() const
+{
+  level_offsets_.clear();
+  level_offsets_.push_back(0);
+
+  // level 0 (the leaves) are not stored in the cache
+  std::size_t level_size = leaf_nodes_.size();
+  while (level_size > 1)
   {
-    for (std::size_t i = 0, j = 0; i < hashes.size(); i += 2, ++j)
+    level_size = (level_size + 1) / 2;
+    level_offsets_.push_back(level_offsets_.back() + level_size);
+  }
+
+  nodes_.resize(level_offsets_.back());
+
+  // padding_[level] is the root of an entirely empty subtree of the given height
+  std::size_t const num_levels = level_offsets_.size() - 1;
+  if (padding_.size() < num_levels)
+  {
+    SHA256 hasher{};
+
+    padding_.resize(num_levels);
+
+    for (std::size_t level = 1; level < num_levels; ++level)
     {
-      Digest concantenated_hash = hashes[i] + hashes[i + 1];
-      concantenated_hash        = Hash<crypto::SHA256>(concantenated_hash);
-      hashes[j]                 = concantenated_hash;
+      hasher.Reset();
+
+      // an empty pair of leaves hashes nothing at all
+      if (level > 1)
+      {
+        hasher.Update(padding_[level - 1].data(), DIGEST_SIZE);
+        hasher.Update(padding_[level - 1].data(), DIGEST_SIZE);
+      }
+
+      hasher.Final(padding_[level].data());
     }
+  }
+}
+
+std::size_t MerkleTree::LevelSize(std::size_t level) const
+{
+  assert((level > 0) && (level < level_offsets_.size()));
+  return level_offsets_[level] - level_offsets_[level - 1];
+}
+
+/**
+ * Compute a single interior node from its two children
+ *
+ * Children which lie beyond the end of the level below are part of the padding. For the leaves this
+ * is the empty digest, which adds nothing to the hashed data.
+ *
+ * @param hasher The hasher to be used
+ * @param level The level of the node, level 1 being the parents of the leaves
+ * @param index The index of the node in the level
+ */
+void MerkleTree::HashNode(SHA256 &hasher, std::size_t level, std::size_t index) const
+{
+  std::size_t const left  = index * 2;
+  std::size_t const right = left + 1;
+
+  hasher.Reset();
+
+  if (level == 1)
+  {
+    hasher.Update(leaf_nodes_[left]);
 
-    hashes.resize(hashes.size() / 2);
+    if (right < leaf_nodes_.size())
+    {
+      hasher.Update(leaf_nodes_[right]);
+    }
+  }
+  else
+  {
+    Node const *children = &nodes_[level_offsets_[level - 2]];
+
+    hasher.Update(children[left].data(), DIGEST_SIZE);
+
+    if (right < LevelSize(level - 1))
+    {
+      hasher.Update(children[right].data(), DIGEST_SIZE);
+    }
+    else
+    {
+      hasher.Update(padding_[level - 1].data(), DIGEST_SIZE);
+    }
+  }
+
+  hasher.Final(nodes_[level_offsets_[level - 1] + index].data());
+}
+
+/**
+ * Compute all the interior nodes of the given levels which cover the given range of leaves
+ *
+ * @param hasher The hasher to be used
+ * @param first_level The first level to compute
+ * @param last_level The last level to compute (inclusive)
+ * @param leaf_begin The first leaf of the range
+ * @param leaf_end One past the last leaf of the range, may be beyond the number of leaves
+ */
+void MerkleTree::HashLevels(SHA256 &hasher, std::size_t first_level, std::size_t last_level,
+                            std::size_t leaf_begin, std::size_t leaf_end) const
+{
+  leaf_end = std::min(leaf_end, leaf_nodes_.size());
+
+  for (std::size_t level = first_level; level <= last_level; ++level)
+  {
+    std::size_t const begin = leaf_begin >> level;
+    std::size_t const end   = ((leaf_end - 1) >> level) + 1;
+
+    for (std::size_t index = begin; index < end; ++index)
+    {
+      HashNode(hasher, level, index);
+    }
   }
+}
 
-  assert(hashes.size() == 1);
-  root_ = hashes[0];
+void MerkleTree::UpdateRootFromCache() const
+{
+  root_ = Digest{nodes_.back().data(), DIGEST_SIZE};
 }
 
 MerkleTree::Digest const &MerkleTree::root() const
@@ -97,6 +349,8 @@ std::size_t MerkleTree::size() const
 
 MerkleTree::Iterator MerkleTree::begin()
 {
+  cache_valid_ = false;
+
   return leaf_nodes_.begin();
 }
 
@@ -112,6 +366,8 @@ MerkleTree::ConstIterator MerkleTree::cbegin()
 
 MerkleTree::Iterator MerkleTree::end()
 {
+  cache_valid_ = false;
+
   return leaf_nodes_.end();
 }
 
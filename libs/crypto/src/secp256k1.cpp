@@ -0,0 +1,1017 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/secp256k1.hpp"
+#include "crypto/sha256.hpp"
+#include "crypto/signature_register.hpp"
+#include "vectorise/platform.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// This file only verifies signatures. Signing stays on the OpenSSL path in ECDSASigner::Sign, so
+// none of the arithmetic below has to be constant time or ever sees a private key.
+
+namespace fetch {
+namespace crypto {
+namespace secp256k1 {
+namespace {
+
+using Wide = std::array<uint64_t, 8>;
+
+constexpr std::size_t ELEMENT_SIZE = 32;
+
+// Field prime p = 2^256 - 2^32 - 977 and the value 2^256 - p used for reduction
+constexpr Limbs P{
+    {0xFFFFFFFEFFFFFC2F, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF}};
+constexpr uint64_t P_COMPLEMENT = 0x1000003D1;
+
+// Group order n, 2^256 - n, n / 2 and p - n
+constexpr Limbs N{{0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF}};
+constexpr Limbs N_COMPLEMENT{{0x402DA1732FC9BEBF, 0x4551231950B75FC4, 0x1, 0x0}};
+constexpr Limbs N_HALF{
+    {0xDFE92F46681B20A0, 0x5D576E7357A4501D, 0xFFFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF}};
+constexpr Limbs P_MINUS_N{{0x402DA1722FC9BAEE, 0x4551231950B75FC4, 0x1, 0x0}};
+
+// Generator point
+constexpr Limbs G_X{
+    {0x59F2815B16F81798, 0x029BFCDB2DCE28D9, 0x55A06295CE870B07, 0x79BE667EF9DCBBAC}};
+constexpr Limbs G_Y{
+    {0x9C47D08FFB10D4B8, 0xFD17B448A6855419, 0x5DA4FBFC0E1108A8, 0x483ADA7726A3C465}};
+
+// Endomorphism (x, y) -> (beta * x, y) which is equivalent to multiplication by lambda, together
+// with the constants used to split a scalar k into k1 + k2 * lambda where k1 and k2 are 128 bits
+constexpr Limbs BETA{
+    {0xC1396C28719501EE, 0x9CF0497512F58995, 0x6E64479EAC3434E9, 0x7AE96A2B657C0710}};
+constexpr Limbs MINUS_LAMBDA{
+    {0xE0CFC810B51283CF, 0xA880B9FC8EC739C2, 0x5AD9E3FD77ED9BA4, 0xAC9C52B33FA3CF1F}};
+constexpr Limbs MINUS_B1{{0x6F547FA90ABFE4C3, 0xE4437ED6010E8828, 0x0, 0x0}};
+constexpr Limbs MINUS_B2{
+    {0xD765CDA83DB1562C, 0x8A280AC50774346D, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF}};
+constexpr Limbs G1{
+    {0xE893209A45DBB031, 0x3DAA8A1471E8CA7F, 0xE86C90E49284EB15, 0x3086D221A7D46BCD}};
+constexpr Limbs G2{
+    {0x1571B4AE8AC47F71, 0x221208AC9DF506C6, 0x6F547FA90ABFE4C4, 0xE4437ED6010E8828}};
+
+// Window sizes of the wNAF representations. The generator tables are computed once, the tables for
+// the public key are computed on every verification and so are kept small.
+constexpr unsigned    WINDOW_G     = 10;
+constexpr unsigned    WINDOW_Q     = 5;
+constexpr std::size_t TABLE_SIZE_G = std::size_t{1} << (WINDOW_G - 2);
+constexpr std::size_t TABLE_SIZE_Q = std::size_t{1} << (WINDOW_Q - 2);
+constexpr std::size_t WNAF_BITS    = 129;
+
+/// @name 256-bit integer helpers
+/// @{
+bool IsZero(Limbs const &a)
+{
+  return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+int Compare(Limbs const &a, Limbs const &b)
+{
+  for (std::size_t i = 4; i > 0; --i)
+  {
+    if (a[i - 1] != b[i - 1])
+    {
+      return (a[i - 1] < b[i - 1]) ? -1 : 1;
+    }
+  }
+
+  return 0;
+}
+
+uint64_t Add(Limbs &r, Limbs const &a, Limbs const &b)
+{
+  uint128_t carry = 0;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    carry += static_cast<uint128_t>(a[i]) + b[i];
+    r[i] = static_cast<uint64_t>(carry);
+    carry >>= 64u;
+  }
+
+  return static_cast<uint64_t>(carry);
+}
+
+uint64_t Sub(Limbs &r, Limbs const &a, Limbs const &b)
+{
+  uint64_t borrow = 0;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    uint128_t const diff = static_cast<uint128_t>(a[i]) - b[i] - borrow;
+    r[i]                 = static_cast<uint64_t>(diff);
+    borrow               = static_cast<uint64_t>(diff >> 64u) & 1u;
+  }
+
+  return borrow;
+}
+
+/**
+ * Three limb accumulator for column wise (product scanning) multiplication
+ */
+class Accumulator
+{
+public:
+  void Add(uint128_t value)
+  {
+    auto const low  = static_cast<uint64_t>(value);
+    auto       high = static_cast<uint64_t>(value >> 64u);
+
+    c0_ += low;
+    high += (c0_ < low) ? 1u : 0u;  // high < 2^64 - 1 for any product of two limbs
+    c1_ += high;
+    c2_ += (c1_ < high) ? 1u : 0u;
+  }
+
+  void MulAdd(uint64_t a, uint64_t b)
+  {
+    Add(static_cast<uint128_t>(a) * b);
+  }
+
+  void MulAdd2(uint64_t a, uint64_t b)
+  {
+    uint128_t const product = static_cast<uint128_t>(a) * b;
+    Add(product);
+    Add(product);
+  }
+
+  uint64_t Extract()
+  {
+    uint64_t const value = c0_;
+    c0_                  = c1_;
+    c1_                  = c2_;
+    c2_                  = 0;
+
+    return value;
+  }
+
+private:
+  uint64_t c0_{0};
+  uint64_t c1_{0};
+  uint64_t c2_{0};
+};
+
+Wide Multiply(Limbs const &a, Limbs const &b)
+{
+  Accumulator acc;
+  Wide        r{};
+
+  acc.MulAdd(a[0], b[0]);
+  r[0] = acc.Extract();
+  acc.MulAdd(a[0], b[1]);
+  acc.MulAdd(a[1], b[0]);
+  r[1] = acc.Extract();
+  acc.MulAdd(a[0], b[2]);
+  acc.MulAdd(a[1], b[1]);
+  acc.MulAdd(a[2], b[0]);
+  r[2] = acc.Extract();
+  acc.MulAdd(a[0], b[3]);
+  acc.MulAdd(a[1], b[2]);
+  acc.MulAdd(a[2], b[1]);
+  acc.MulAdd(a[3], b[0]);
+  r[3] = acc.Extract();
+  acc.MulAdd(a[1], b[3]);
+  acc.MulAdd(a[2], b[2]);
+  acc.MulAdd(a[3], b[1]);
+  r[4] = acc.Extract();
+  acc.MulAdd(a[2], b[3]);
+  acc.MulAdd(a[3], b[2]);
+  r[5] = acc.Extract();
+  acc.MulAdd(a[3], b[3]);
+  r[6] = acc.Extract();
+  r[7] = acc.Extract();
+
+  return r;
+}
+
+Wide Square(Limbs const &a)
+{
+  Accumulator acc;
+  Wide        r{};
+
+  acc.MulAdd(a[0], a[0]);
+  r[0] = acc.Extract();
+  acc.MulAdd2(a[0], a[1]);
+  r[1] = acc.Extract();
+  acc.MulAdd2(a[0], a[2]);
+  acc.MulAdd(a[1], a[1]);
+  r[2] = acc.Extract();
+  acc.MulAdd2(a[0], a[3]);
+  acc.MulAdd2(a[1], a[2]);
+  r[3] = acc.Extract();
+  acc.MulAdd2(a[1], a[3]);
+  acc.MulAdd(a[2], a[2]);
+  r[4] = acc.Extract();
+  acc.MulAdd2(a[2], a[3]);
+  r[5] = acc.Extract();
+  acc.MulAdd(a[3], a[3]);
+  r[6] = acc.Extract();
+  r[7] = acc.Extract();
+
+  return r;
+}
+
+Limbs FromBigEndian(uint8_t const *data)
+{
+  Limbs r{};
+  for (std::size_t i = 0; i < ELEMENT_SIZE; ++i)
+  {
+    std::size_t const limb = (ELEMENT_SIZE - 1 - i) / 8;
+    r[limb]                = (r[limb] << 8u) | data[i];
+  }
+
+  return r;
+}
+
+uint32_t GetBits(Limbs const &a, std::size_t offset, std::size_t count)
+{
+  std::size_t const limb  = offset / 64;
+  std::size_t const shift = offset % 64;
+
+  if (limb >= a.size())
+  {
+    return 0;
+  }
+
+  uint64_t value = a[limb] >> shift;
+  if ((shift + count > 64) && (limb + 1 < a.size()))
+  {
+    value |= a[limb + 1] << (64 - shift);
+  }
+
+  return static_cast<uint32_t>(value & ((uint64_t{1} << count) - 1));
+}
+/// @}
+
+/// @name Field arithmetic modulo p. Elements are always kept fully reduced.
+/// @{
+Limbs FieldReduce(Wide const &t)
+{
+  Limbs     r{};
+  uint128_t carry = 0;
+
+  // fold the upper half using 2^256 = P_COMPLEMENT (mod p)
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    carry += static_cast<uint128_t>(t[i]) + static_cast<uint128_t>(t[i + 4]) * P_COMPLEMENT;
+    r[i] = static_cast<uint64_t>(carry);
+    carry >>= 64u;
+  }
+
+  // fold the remaining (at most 34 bits) overflow
+  carry = static_cast<uint128_t>(r[0]) + static_cast<uint128_t>(carry) * P_COMPLEMENT;
+  r[0]  = static_cast<uint64_t>(carry);
+  carry >>= 64u;
+  for (std::size_t i = 1; i < 4; ++i)
+  {
+    carry += r[i];
+    r[i] = static_cast<uint64_t>(carry);
+    carry >>= 64u;
+  }
+
+  // in the rare case of a final overflow the remaining value is small
+  if (carry != 0)
+  {
+    Add(r, r, Limbs{{P_COMPLEMENT, 0, 0, 0}});
+  }
+
+  if (Compare(r, P) >= 0)
+  {
+    Sub(r, r, P);
+  }
+
+  return r;
+}
+
+Limbs FieldMul(Limbs const &a, Limbs const &b)
+{
+  return FieldReduce(Multiply(a, b));
+}
+
+Limbs FieldSqr(Limbs const &a)
+{
+  return FieldReduce(Square(a));
+}
+
+Limbs FieldAdd(Limbs const &a, Limbs const &b)
+{
+  Limbs r{};
+  if ((Add(r, a, b) != 0) || (Compare(r, P) >= 0))
+  {
+    Sub(r, r, P);
+  }
+
+  return r;
+}
+
+Limbs FieldSub(Limbs const &a, Limbs const &b)
+{
+  Limbs r{};
+  if (Sub(r, a, b) != 0)
+  {
+    Add(r, r, P);
+  }
+
+  return r;
+}
+
+Limbs FieldNeg(Limbs const &a)
+{
+  return FieldSub(Limbs{}, a);
+}
+
+Limbs FieldInv(Limbs const &a)
+{
+  // Fermat's little theorem: a^(p - 2)
+  Limbs exponent{};
+  Sub(exponent, P, Limbs{{2, 0, 0, 0}});
+
+  Limbs r{{1, 0, 0, 0}};
+  for (std::size_t bit = 256; bit > 0; --bit)
+  {
+    r = FieldSqr(r);
+    if (GetBits(exponent, bit - 1, 1) != 0)
+    {
+      r = FieldMul(r, a);
+    }
+  }
+
+  return r;
+}
+/// @}
+
+/// @name Scalar arithmetic modulo n
+/// @{
+Limbs ScalarReduce(Wide const &t)
+{
+  // fold the limbs above 2^256 using 2^256 = N_COMPLEMENT (mod n), where the top limb of
+  // N_COMPLEMENT is one. The first fold leaves at most 385 bits, the second at most 258 bits.
+  Accumulator acc;
+
+  acc.Add(t[0]);
+  acc.MulAdd(t[4], N_COMPLEMENT[0]);
+  uint64_t const m0 = acc.Extract();
+  acc.Add(t[1]);
+  acc.MulAdd(t[5], N_COMPLEMENT[0]);
+  acc.MulAdd(t[4], N_COMPLEMENT[1]);
+  uint64_t const m1 = acc.Extract();
+  acc.Add(t[2]);
+  acc.MulAdd(t[6], N_COMPLEMENT[0]);
+  acc.MulAdd(t[5], N_COMPLEMENT[1]);
+  acc.Add(t[4]);
+  uint64_t const m2 = acc.Extract();
+  acc.Add(t[3]);
+  acc.MulAdd(t[7], N_COMPLEMENT[0]);
+  acc.MulAdd(t[6], N_COMPLEMENT[1]);
+  acc.Add(t[5]);
+  uint64_t const m3 = acc.Extract();
+  acc.MulAdd(t[7], N_COMPLEMENT[1]);
+  acc.Add(t[6]);
+  uint64_t const m4 = acc.Extract();
+  acc.Add(t[7]);
+  uint64_t const m5 = acc.Extract();
+  uint64_t const m6 = acc.Extract();
+
+  acc.Add(m0);
+  acc.MulAdd(m4, N_COMPLEMENT[0]);
+  uint64_t const p0 = acc.Extract();
+  acc.Add(m1);
+  acc.MulAdd(m5, N_COMPLEMENT[0]);
+  acc.MulAdd(m4, N_COMPLEMENT[1]);
+  uint64_t const p1 = acc.Extract();
+  acc.Add(m2);
+  acc.MulAdd(m6, N_COMPLEMENT[0]);
+  acc.MulAdd(m5, N_COMPLEMENT[1]);
+  acc.Add(m4);
+  uint64_t const p2 = acc.Extract();
+  acc.Add(m3);
+  acc.MulAdd(m6, N_COMPLEMENT[1]);
+  acc.Add(m5);
+  uint64_t const p3 = acc.Extract();
+  acc.Add(m6);
+  uint64_t const p4 = acc.Extract();
+
+  // final fold of the few remaining bits
+  Limbs     r{};
+  uint128_t carry = static_cast<uint128_t>(p0) + static_cast<uint128_t>(p4) * N_COMPLEMENT[0];
+  r[0]            = static_cast<uint64_t>(carry);
+  carry >>= 64u;
+  carry += static_cast<uint128_t>(p1) + static_cast<uint128_t>(p4) * N_COMPLEMENT[1];
+  r[1] = static_cast<uint64_t>(carry);
+  carry >>= 64u;
+  carry += static_cast<uint128_t>(p2) + p4;
+  r[2] = static_cast<uint64_t>(carry);
+  carry >>= 64u;
+  carry += p3;
+  r[3] = static_cast<uint64_t>(carry);
+  carry >>= 64u;
+
+  // an overflow past 2^256 is corrected by wrapping around with the subtraction
+  if (carry != 0)
+  {
+    Sub(r, r, N);
+  }
+
+  if (Compare(r, N) >= 0)
+  {
+    Sub(r, r, N);
+  }
+
+  return r;
+}
+
+Limbs ScalarMul(Limbs const &a, Limbs const &b)
+{
+  return ScalarReduce(Multiply(a, b));
+}
+
+Limbs ScalarAdd(Limbs const &a, Limbs const &b)
+{
+  Limbs r{};
+  if ((Add(r, a, b) != 0) || (Compare(r, N) >= 0))
+  {
+    Sub(r, r, N);
+  }
+
+  return r;
+}
+
+Limbs ScalarNeg(Limbs const &a)
+{
+  if (IsZero(a))
+  {
+    return a;
+  }
+
+  Limbs r{};
+  Sub(r, N, a);
+
+  return r;
+}
+
+Limbs ScalarInv(Limbs const &a)
+{
+  // Fermat's little theorem: a^(n - 2) using fixed 4-bit windows
+  Limbs exponent{};
+  Sub(exponent, N, Limbs{{2, 0, 0, 0}});
+
+  std::array<Limbs, 16> powers{};
+  powers[0] = Limbs{{1, 0, 0, 0}};
+  for (std::size_t i = 1; i < powers.size(); ++i)
+  {
+    powers[i] = ScalarMul(powers[i - 1], a);
+  }
+
+  Limbs r = powers[0];
+  for (std::size_t window = 64; window > 0; --window)
+  {
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      r = ScalarReduce(Square(r));
+    }
+
+    uint32_t const bits = GetBits(exponent, (window - 1) * 4, 4);
+    if (bits != 0)
+    {
+      r = ScalarMul(r, powers[bits]);
+    }
+  }
+
+  return r;
+}
+
+/**
+ * Compute round(a * b / 2^384)
+ */
+Limbs MulShift384(Limbs const &a, Limbs const &b)
+{
+  Wide const  product = Multiply(a, b);
+  Limbs       r{{product[6], product[7], 0, 0}};
+  Limbs const round{{product[5] >> 63u, 0, 0, 0}};
+
+  Add(r, r, round);
+
+  return r;
+}
+
+/**
+ * Split k into k1 + k2 * lambda (mod n) where |k1| and |k2| are less than 2^128
+ */
+void SplitLambda(Limbs const &k, Limbs &k1, bool &k1_negative, Limbs &k2, bool &k2_negative)
+{
+  Limbs const c1 = ScalarMul(MulShift384(k, G1), MINUS_B1);
+  Limbs const c2 = ScalarMul(MulShift384(k, G2), MINUS_B2);
+
+  k2 = ScalarAdd(c1, c2);
+  k1 = ScalarAdd(ScalarMul(k2, MINUS_LAMBDA), k);
+
+  k1_negative = Compare(k1, N_HALF) > 0;
+  if (k1_negative)
+  {
+    k1 = ScalarNeg(k1);
+  }
+
+  k2_negative = Compare(k2, N_HALF) > 0;
+  if (k2_negative)
+  {
+    k2 = ScalarNeg(k2);
+  }
+}
+/// @}
+
+/// @name Group arithmetic
+/// @{
+struct AffinePoint
+{
+  Limbs x{};
+  Limbs y{};
+};
+
+struct JacobianPoint
+{
+  Limbs x{};
+  Limbs y{};
+  Limbs z{};
+  bool  infinity{true};
+};
+
+JacobianPoint ToJacobian(AffinePoint const &a)
+{
+  return {a.x, a.y, Limbs{{1, 0, 0, 0}}, false};
+}
+
+JacobianPoint Double(JacobianPoint const &a)
+{
+  if (a.infinity || IsZero(a.y))
+  {
+    return {};
+  }
+
+  // dbl-2009-l for curves with a = 0
+  Limbs const xx   = FieldSqr(a.x);
+  Limbs const yy   = FieldSqr(a.y);
+  Limbs const yyyy = FieldSqr(yy);
+  Limbs       d    = FieldSub(FieldSub(FieldSqr(FieldAdd(a.x, yy)), xx), yyyy);
+  d                = FieldAdd(d, d);
+  Limbs const e    = FieldAdd(FieldAdd(xx, xx), xx);
+  Limbs const f    = FieldSqr(e);
+
+  Limbs yyyy8 = FieldAdd(yyyy, yyyy);
+  yyyy8       = FieldAdd(yyyy8, yyyy8);
+  yyyy8       = FieldAdd(yyyy8, yyyy8);
+
+  JacobianPoint r;
+  r.x        = FieldSub(f, FieldAdd(d, d));
+  r.y        = FieldSub(FieldMul(e, FieldSub(d, r.x)), yyyy8);
+  r.z        = FieldMul(FieldAdd(a.y, a.y), a.z);
+  r.infinity = false;
+
+  return r;
+}
+
+/**
+ * Complete the addition of a and b given both points scaled to a common denominator, (u1, s1) for
+ * a and (u2, s2) for b, along with the z coordinate of the result before scaling by h
+ */
+JacobianPoint AddScaled(JacobianPoint const &a, Limbs const &u1, Limbs const &s1, Limbs const &u2,
+                        Limbs const &s2, Limbs const &z)
+{
+  Limbs const h = FieldSub(u2, u1);
+  Limbs const r = FieldSub(s2, s1);
+
+  if (IsZero(h))
+  {
+    // the points are either equal or inverses of each other
+    return IsZero(r) ? Double(a) : JacobianPoint{};
+  }
+
+  Limbs const hh   = FieldSqr(h);
+  Limbs const hhh  = FieldMul(h, hh);
+  Limbs const u1hh = FieldMul(u1, hh);
+
+  JacobianPoint result;
+  result.x        = FieldSub(FieldSub(FieldSqr(r), hhh), FieldAdd(u1hh, u1hh));
+  result.y        = FieldSub(FieldMul(r, FieldSub(u1hh, result.x)), FieldMul(s1, hhh));
+  result.z        = FieldMul(z, h);
+  result.infinity = false;
+
+  return result;
+}
+
+JacobianPoint Add(JacobianPoint const &a, JacobianPoint const &b)
+{
+  if (a.infinity)
+  {
+    return b;
+  }
+
+  if (b.infinity)
+  {
+    return a;
+  }
+
+  Limbs const z1z1 = FieldSqr(a.z);
+  Limbs const z2z2 = FieldSqr(b.z);
+  Limbs const u1   = FieldMul(a.x, z2z2);
+  Limbs const u2   = FieldMul(b.x, z1z1);
+  Limbs const s1   = FieldMul(FieldMul(a.y, b.z), z2z2);
+  Limbs const s2   = FieldMul(FieldMul(b.y, a.z), z1z1);
+
+  return AddScaled(a, u1, s1, u2, s2, FieldMul(a.z, b.z));
+}
+
+JacobianPoint Add(JacobianPoint const &a, AffinePoint const &b)
+{
+  if (a.infinity)
+  {
+    return ToJacobian(b);
+  }
+
+  Limbs const z1z1 = FieldSqr(a.z);
+  Limbs const u2   = FieldMul(b.x, z1z1);
+  Limbs const s2   = FieldMul(FieldMul(b.y, a.z), z1z1);
+
+  return AddScaled(a, a.x, a.y, u2, s2, a.z);
+}
+
+template <typename Point>
+Point Negate(Point p)
+{
+  p.y = FieldNeg(p.y);
+  return p;
+}
+
+template <typename Point>
+Point ApplyEndomorphism(Point p)
+{
+  p.x = FieldMul(p.x, BETA);
+  return p;
+}
+
+bool IsOnCurve(AffinePoint const &a)
+{
+  // y^2 = x^3 + 7
+  Limbs const lhs = FieldSqr(a.y);
+  Limbs const rhs = FieldAdd(FieldMul(FieldSqr(a.x), a.x), Limbs{{7, 0, 0, 0}});
+
+  return Compare(lhs, rhs) == 0;
+}
+/// @}
+
+/// @name Multi-scalar multiplication
+/// @{
+using Wnaf = std::array<int32_t, WNAF_BITS + 1>;
+
+/**
+ * Compute the width-w non-adjacent form of a scalar of at most WNAF_BITS - 1 bits
+ *
+ * @return The number of digits in the representation
+ */
+std::size_t BuildWnaf(Wnaf &wnaf, Limbs const &scalar, unsigned window, bool negative)
+{
+  wnaf.fill(0);
+
+  int32_t const sign     = negative ? -1 : 1;
+  uint32_t      carry    = 0;
+  std::size_t   bit      = 0;
+  std::size_t   last_set = 0;
+
+  while (bit < wnaf.size())
+  {
+    if (GetBits(scalar, bit, 1) == carry)
+    {
+      ++bit;
+      continue;
+    }
+
+    std::size_t const now  = std::min<std::size_t>(window, wnaf.size() - bit);
+    auto              word = static_cast<int32_t>(GetBits(scalar, bit, now) + carry);
+
+    carry = static_cast<uint32_t>(word >> (window - 1)) & 1u;
+    word -= static_cast<int32_t>(carry << window);
+
+    wnaf[bit] = sign * word;
+    last_set  = bit + 1;
+    bit += now;
+  }
+
+  assert(carry == 0);
+
+  return last_set;
+}
+
+struct GeneratorTables
+{
+  std::array<AffinePoint, TABLE_SIZE_G> g;
+  std::array<AffinePoint, TABLE_SIZE_G> g_lambda;
+};
+
+/**
+ * Compute the odd multiples G, 3G, 5G, ... of the generator and their endomorphism images. The
+ * multiples are converted to affine coordinates with a single (batched) inversion.
+ */
+GeneratorTables BuildGeneratorTables()
+{
+  std::vector<JacobianPoint> multiples(TABLE_SIZE_G);
+
+  JacobianPoint const g = ToJacobian(AffinePoint{G_X, G_Y});
+  JacobianPoint const d = Double(g);
+
+  multiples[0] = g;
+  for (std::size_t i = 1; i < multiples.size(); ++i)
+  {
+    multiples[i] = Add(multiples[i - 1], d);
+  }
+
+  std::vector<Limbs> prefix(multiples.size());
+  prefix[0] = multiples[0].z;
+  for (std::size_t i = 1; i < multiples.size(); ++i)
+  {
+    prefix[i] = FieldMul(prefix[i - 1], multiples[i].z);
+  }
+
+  GeneratorTables tables{};
+  Limbs           inverse = FieldInv(prefix.back());
+
+  for (std::size_t i = multiples.size(); i > 0; --i)
+  {
+    std::size_t const index = i - 1;
+
+    Limbs z_inverse = inverse;
+    if (index > 0)
+    {
+      z_inverse = FieldMul(inverse, prefix[index - 1]);
+      inverse   = FieldMul(inverse, multiples[index].z);
+    }
+
+    Limbs const z_inverse2 = FieldSqr(z_inverse);
+
+    AffinePoint &point = tables.g[index];
+    point.x            = FieldMul(multiples[index].x, z_inverse2);
+    point.y            = FieldMul(multiples[index].y, FieldMul(z_inverse2, z_inverse));
+
+    tables.g_lambda[index] = ApplyEndomorphism(point);
+  }
+
+  return tables;
+}
+
+GeneratorTables const &GetGeneratorTables()
+{
+  static GeneratorTables const tables = BuildGeneratorTables();
+  return tables;
+}
+
+template <typename Point>
+Point Lookup(Point const *table, int32_t digit)
+{
+  if (digit > 0)
+  {
+    return table[(digit - 1) / 2];
+  }
+
+  return Negate(table[(-digit - 1) / 2]);
+}
+
+/**
+ * Compute u1 * G + u2 * Q using a single doubling chain over the four half length scalars produced
+ * by the endomorphism split
+ */
+JacobianPoint MultiplyAdd(Limbs const &u1, AffinePoint const &q, Limbs const &u2)
+{
+  GeneratorTables const &tables = GetGeneratorTables();
+
+  // per key tables of the odd multiples Q, 3Q, 5Q, ... and their endomorphism images
+  std::array<JacobianPoint, TABLE_SIZE_Q> q_table{};
+  std::array<JacobianPoint, TABLE_SIZE_Q> q_lambda_table{};
+
+  q_table[0]              = ToJacobian(q);
+  JacobianPoint const q_2 = Double(q_table[0]);
+  for (std::size_t i = 1; i < q_table.size(); ++i)
+  {
+    q_table[i] = Add(q_table[i - 1], q_2);
+  }
+
+  for (std::size_t i = 0; i < q_table.size(); ++i)
+  {
+    q_lambda_table[i] = ApplyEndomorphism(q_table[i]);
+  }
+
+  Limbs a1{};
+  Limbs a2{};
+  Limbs b1{};
+  Limbs b2{};
+  bool  a1_negative{false};
+  bool  a2_negative{false};
+  bool  b1_negative{false};
+  bool  b2_negative{false};
+
+  SplitLambda(u1, a1, a1_negative, a2, a2_negative);
+  SplitLambda(u2, b1, b1_negative, b2, b2_negative);
+
+  Wnaf wnaf_a1{};
+  Wnaf wnaf_a2{};
+  Wnaf wnaf_b1{};
+  Wnaf wnaf_b2{};
+
+  std::size_t const length = std::max(std::max(BuildWnaf(wnaf_a1, a1, WINDOW_G, a1_negative),
+                                               BuildWnaf(wnaf_a2, a2, WINDOW_G, a2_negative)),
+                                      std::max(BuildWnaf(wnaf_b1, b1, WINDOW_Q, b1_negative),
+                                               BuildWnaf(wnaf_b2, b2, WINDOW_Q, b2_negative)));
+
+  JacobianPoint r{};
+  for (std::size_t i = length; i > 0; --i)
+  {
+    std::size_t const bit = i - 1;
+
+    r = Double(r);
+
+    if (wnaf_b1[bit] != 0)
+    {
+      r = Add(r, Lookup(q_table.data(), wnaf_b1[bit]));
+    }
+
+    if (wnaf_b2[bit] != 0)
+    {
+      r = Add(r, Lookup(q_lambda_table.data(), wnaf_b2[bit]));
+    }
+
+    if (wnaf_a1[bit] != 0)
+    {
+      r = Add(r, Lookup(tables.g.data(), wnaf_a1[bit]));
+    }
+
+    if (wnaf_a2[bit] != 0)
+    {
+      r = Add(r, Lookup(tables.g_lambda.data(), wnaf_a2[bit]));
+    }
+  }
+
+  return r;
+}
+/// @}
+
+}  // namespace
+
+/**
+ * Parse a public key given as the 64 byte concatenation of its big endian affine coordinates
+ *
+ * @param key The encoded public key
+ * @param public_key The output public key
+ * @return true if the key is well formed and lies on the curve, otherwise false
+ */
+bool ParsePublicKey(byte_array::ConstByteArray const &key, PublicKey &public_key)
+{
+  if (key.size() != PUBLIC_KEY_SIZE)
+  {
+    return false;
+  }
+
+  AffinePoint const point{FromBigEndian(key.pointer()),
+                          FromBigEndian(key.pointer() + ELEMENT_SIZE)};
+
+  if ((Compare(point.x, P) >= 0) || (Compare(point.y, P) >= 0) || !IsOnCurve(point))
+  {
+    return false;
+  }
+
+  public_key.x = point.x;
+  public_key.y = point.y;
+
+  return true;
+}
+
+/**
+ * Verify a canonical (r || s) signature of a message hash
+ *
+ * @param public_key The public key of the signer
+ * @param hash The hash of the message
+ * @param signature The 64 byte canonical signature
+ * @return true if the signature is valid, otherwise false
+ */
+bool VerifyHash(PublicKey const &public_key, byte_array::ConstByteArray const &hash,
+                byte_array::ConstByteArray const &signature)
+{
+  if (signature.size() != SIGNATURE_SIZE)
+  {
+    return false;
+  }
+
+  Limbs const r = FromBigEndian(signature.pointer());
+  Limbs const s = FromBigEndian(signature.pointer() + ELEMENT_SIZE);
+
+  if (IsZero(r) || IsZero(s) || (Compare(r, N) >= 0) || (Compare(s, N) >= 0))
+  {
+    return false;
+  }
+
+  // as with OpenSSL, only the leftmost 256 bits of the hash are used and shorter hashes are
+  // treated as big endian integers
+  std::array<uint8_t, ELEMENT_SIZE> digest{};
+  std::size_t const                 digest_size = std::min(hash.size(), ELEMENT_SIZE);
+  for (std::size_t i = 0; i < digest_size; ++i)
+  {
+    digest[ELEMENT_SIZE - digest_size + i] = hash[i];
+  }
+
+  Limbs e = FromBigEndian(digest.data());
+  if (Compare(e, N) >= 0)
+  {
+    Sub(e, e, N);
+  }
+
+  Limbs const w  = ScalarInv(s);
+  Limbs const u1 = ScalarMul(e, w);
+  Limbs const u2 = ScalarMul(r, w);
+
+  JacobianPoint const point = MultiplyAdd(u1, AffinePoint{public_key.x, public_key.y}, u2);
+  if (point.infinity)
+  {
+    return false;
+  }
+
+  // compare x / z^2 (mod n) against r without inverting z. Since p < 2n the affine x coordinate
+  // can only be r or r + n.
+  Limbs const zz = FieldSqr(point.z);
+  if (Compare(FieldMul(r, zz), point.x) == 0)
+  {
+    return true;
+  }
+
+  if (Compare(r, P_MINUS_N) < 0)
+  {
+    Limbs r_plus_n{};
+    Add(r_plus_n, r, N);
+
+    return Compare(FieldMul(r_plus_n, zz), point.x) == 0;
+  }
+
+  return false;
+}
+
+}  // namespace secp256k1
+
+Secp256k1Verifier::Secp256k1Verifier(Identity identity)
+  : identity_{std::move(identity)}
+  , valid_{(identity_.parameters() == SECP256K1_UNCOMPRESSED) &&
+           secp256k1::ParsePublicKey(identity_.identifier(), public_key_)}
+{}
+
+bool Secp256k1Verifier::Verify(ConstByteArray const &data, ConstByteArray const &signature)
+{
+  if (!valid_ || signature.empty())
+  {
+    return false;
+  }
+
+  if (signature.size() != secp256k1::SIGNATURE_SIZE)
+  {
+    // not a canonical signature, defer to OpenSSL
+    return ECDSAVerifier{identity_}.Verify(data, signature);
+  }
+
+  return VerifyHash(Hash<SHA256>(data), signature);
+}
+
+bool Secp256k1Verifier::VerifyHash(ConstByteArray const &hash,
+                                   ConstByteArray const &signature) const
+{
+  return valid_ && secp256k1::VerifyHash(public_key_, hash, signature);
+}
+
+Identity Secp256k1Verifier::identity() const
+{
+  return identity_;
+}
+
+Secp256k1Verifier::operator bool() const
+{
+  return valid_;
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "crypto/ecdsa.hpp"
+#include "crypto/secp256k1.hpp"
 #include "crypto/verifier.hpp"
 
 namespace fetch {
@@ -30,12 +31,14 @@ namespace crypto {
  */
 std::unique_ptr<Verifier> Verifier::Build(Identity const &identity)
 {
-  std::unique_ptr<Verifier> verifier;
+  // only supported signature scheme currently, preferring the native engine for uncompressed keys
+  auto native = std::make_unique<Secp256k1Verifier>(identity);
+  if (*native)
+  {
+    return native;
+  }
 
-  // only supported signature scheme currently
-  verifier = std::make_unique<ECDSAVerifier>(identity);
-
-  return verifier;
+  return std::make_unique<ECDSAVerifier>(identity);
 }
 
 /**
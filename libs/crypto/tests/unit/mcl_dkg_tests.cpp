@@ -294,3 +294,36 @@ TEST(MclNotarisationTests, AggregateSigningVerification)
       ComputeAggregatePublicKey(aggregate_signature.second, aggregate_public_keys);
   EXPECT_TRUE(VerifySign(aggregate_public_key, message, aggregate_signature.first, generator));
 }
+
+TEST(MclDkgTests, BatchVerification)
+{
+  details::MCLInitialiser();
+
+  Generator generator;
+  SetGenerator(generator);
+
+  uint32_t cabinet_size = 10;
+  uint32_t threshold    = 4;
+  auto     outputs      = TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  // Shares of a common message together with some shares of distinct messages
+  SignedMessageShares shares;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    MessagePayload message = (i % 3 == 0) ? MessagePayload{"Other " + std::to_string(i)}
+                                          : MessagePayload{"Hello"};
+    shares.emplace_back(outputs[i].public_key_shares[i], message,
+                        SignShare(message, outputs[i].private_key_share));
+  }
+
+  EXPECT_TRUE(VerifySignBatch(shares, generator));
+  EXPECT_TRUE(FindInvalidSignatures(shares, generator).empty());
+  EXPECT_TRUE(VerifySignBatch({}, generator));
+
+  // Corrupt a couple of the shares
+  shares[2].signature = SignShare("Hello", outputs[3].private_key_share);
+  shares[7].message   = "Goodbye";
+
+  EXPECT_FALSE(VerifySignBatch(shares, generator));
+  EXPECT_EQ(FindInvalidSignatures(shares, generator), (std::vector<std::size_t>{2, 7}));
+}
@@ -22,9 +22,15 @@
 #include "crypto/hash.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
+#include "vectorise/platform.hpp"
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 using namespace fetch;
 using namespace fetch::crypto;
 
@@ -39,6 +45,42 @@ static ConstByteArray CalculateHash(ConstByteArray const &a, ConstByteArray cons
   return sha256.Final();
 }
 
+// straightforward calculation of the root by repeatedly condensing a padded copy of the leaves
+static ConstByteArray CalculateReferenceRoot(MerkleTree const &tree)
+{
+  if (tree.size() == 0)
+  {
+    return Hash<crypto::SHA256>(ConstByteArray{});
+  }
+
+  std::vector<ConstByteArray> hashes = tree.leaf_nodes();
+
+  while (!platform::IsLog2(uint64_t(hashes.size())))
+  {
+    hashes.emplace_back();
+  }
+
+  while (hashes.size() > 1)
+  {
+    for (std::size_t i = 0, j = 0; i < hashes.size(); i += 2, ++j)
+    {
+      hashes[j] = CalculateHash(hashes[i], hashes[i + 1]);
+    }
+
+    hashes.resize(hashes.size() / 2);
+  }
+
+  return hashes[0];
+}
+
+static void PopulateTree(MerkleTree &tree, std::string const &prefix = "")
+{
+  for (std::size_t i = 0; i < tree.size(); ++i)
+  {
+    tree[i] = ConstByteArray{prefix + std::to_string(i)};
+  }
+}
+
 TEST(crypto_merkle_tree, empty_tree)
 {
   MerkleTree tree{0};
@@ -198,3 +240,116 @@ TEST(crypto_merkle_tree, same_result_after_move)
   EXPECT_EQ(tree.root().size(), 256 / 8);
   EXPECT_EQ(tree.root(), root_before);
 }
+
+TEST(crypto_merkle_tree, matches_reference_for_all_small_sizes)
+{
+  for (std::size_t count = 0; count <= 70; ++count)
+  {
+    MerkleTree tree{count};
+    PopulateTree(tree);
+
+    tree.CalculateRoot();
+
+    EXPECT_EQ(tree.root(), CalculateReferenceRoot(tree)) << "count: " << count;
+  }
+}
+
+TEST(crypto_merkle_tree, parallel_calculation_matches_serial)
+{
+  for (std::size_t count : {MerkleTree::MIN_LEAVES_PER_THREAD * 2,
+                            MerkleTree::MIN_LEAVES_PER_THREAD * 2 + 1,
+                            MerkleTree::MIN_LEAVES_PER_THREAD * 5 + 3,
+                            MerkleTree::MIN_LEAVES_PER_THREAD * 8})
+  {
+    MerkleTree tree{count};
+    PopulateTree(tree);
+
+    tree.CalculateRoot(1);
+    auto const expected = CalculateReferenceRoot(tree);
+    EXPECT_EQ(tree.root(), expected) << "count: " << count;
+
+    for (std::size_t num_threads : {2u, 3u, 4u, 8u, 64u})
+    {
+      tree.CalculateRoot(num_threads);
+      EXPECT_EQ(tree.root(), expected) << "count: " << count << " threads: " << num_threads;
+    }
+  }
+}
+
+TEST(crypto_merkle_tree, subtrees_built_out_of_order_match_reference)
+{
+  for (std::size_t count : {0u, 1u, 2u, 3u, 7u, 64u, 100u, 257u})
+  {
+    for (std::size_t min_leaves : {1u, 4u, 16u})
+    {
+      MerkleTree tree{count};
+      PopulateTree(tree);
+
+      std::size_t const num_subtrees = tree.PrepareSubtrees(64, min_leaves);
+      for (std::size_t subtree = num_subtrees; subtree > 0; --subtree)
+      {
+        tree.CalculateSubtree(subtree - 1);
+      }
+
+      tree.CompleteRoot();
+
+      EXPECT_EQ(tree.root(), CalculateReferenceRoot(tree))
+          << "count: " << count << " min leaves: " << min_leaves;
+    }
+  }
+}
+
+TEST(crypto_merkle_tree, update_matches_full_calculation)
+{
+  for (std::size_t count : {1u, 2u, 3u, 5u, 16u, 100u, 257u})
+  {
+    MerkleTree tree{count};
+    PopulateTree(tree);
+    tree.CalculateRoot();
+
+    for (std::size_t i = 0; i < count; i += 3)
+    {
+      tree.Update(i, ConstByteArray{"updated" + std::to_string(i)});
+
+      EXPECT_EQ(tree.root(), CalculateReferenceRoot(tree)) << "count: " << count << " leaf: " << i;
+    }
+
+    // the last leaf borders the padding
+    tree.Update(count - 1, ConstByteArray{"last"});
+    EXPECT_EQ(tree.root(), CalculateReferenceRoot(tree)) << "count: " << count;
+  }
+}
+
+TEST(crypto_merkle_tree, update_after_direct_leaf_modification)
+{
+  MerkleTree tree{100};
+  PopulateTree(tree);
+  tree.CalculateRoot();
+
+  // modifying a leaf directly invalidates the cached nodes
+  tree[10] = ConstByteArray{"direct"};
+  tree.Update(20, ConstByteArray{"update"});
+
+  EXPECT_EQ(tree.root(), CalculateReferenceRoot(tree));
+}
+
+TEST(crypto_merkle_tree, update_after_deserialization)
+{
+  MerkleTree tree{100};
+  MerkleTree tree_deser{100};
+  PopulateTree(tree);
+  PopulateTree(tree_deser, "other");
+  tree.CalculateRoot();
+  tree_deser.CalculateRoot();
+
+  {
+    fetch::serializers::MsgPackSerializer arr;
+    arr << tree;
+    arr.seek(0);
+    arr >> tree_deser;
+  }
+
+  tree_deser.Update(50, ConstByteArray{"update"});
+
+  EXPECT_EQ(tree_deser.root(), CalculateReferenceRoot(tree_deser));
+}
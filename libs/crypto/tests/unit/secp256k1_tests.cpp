@@ -0,0 +1,377 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/byte_array/decoders.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/secp256k1.hpp"
+#include "crypto/sha256.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+
+namespace fetch {
+namespace crypto {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+using byte_array::FromHex;
+
+// Big endian encoding of the group order
+ConstByteArray const ORDER{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                           0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48,
+                           0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41};
+
+ConstByteArray GenerateMessage(random::LinearCongruentialGenerator &rng, std::size_t length)
+{
+  ByteArray message;
+  message.Resize(length);
+
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    message[i] = static_cast<uint8_t>(rng());
+  }
+
+  return {message};
+}
+
+/**
+ * Replace the s component of a canonical signature with n - s, which is an equally valid signature
+ */
+ConstByteArray NegateS(ConstByteArray const &signature)
+{
+  ByteArray negated = signature.Copy();
+
+  int borrow = 0;
+  for (std::size_t i = 32; i > 0; --i)
+  {
+    int const diff      = static_cast<int>(ORDER[i - 1]) - signature[32 + i - 1] - borrow;
+    negated[32 + i - 1] = static_cast<uint8_t>(diff & 0xFF);
+    borrow              = (diff < 0) ? 1 : 0;
+  }
+
+  return {negated};
+}
+
+ConstByteArray ReplaceHalf(ConstByteArray const &signature, std::size_t offset,
+                           ConstByteArray const &value)
+{
+  ByteArray modified = signature.Copy();
+  for (std::size_t i = 0; i < 32; ++i)
+  {
+    modified[offset + i] = value[i];
+  }
+
+  return {modified};
+}
+
+// Known answer vectors, generated independently of this implementation. The keys for the
+// "x coordinate above n" and "point at infinity" vectors are derived from the signature so that
+// R = u1 * G + u2 * Q has an x coordinate in [n, p) or is the point at infinity respectively.
+char const *const HIGH_S_KEY =
+    "c83ceb8f4bdb50f09a18cf668e2103909dd6f67e910f346ab13d84418a9ddac7"
+    "a4a214da8a1ee21885a8fa218dec31b5be55956e3ac480c0872bec00d3b731c0";
+char const *const R_PLUS_N_KEY =
+    "f8231e513e53a07645855ab4c691451be66d4f99479d58ba741f653268a7dd67"
+    "44ce47e0affb3d1c1cd2366f7866d94c1cf5a55d61b0c3f190d70663aabcccf1";
+char const *const INFINITY_KEY =
+    "cbe2584976cba0d03a3b7ba5f58bc7686f0dc9bc033c215c38d972d666f1d67c"
+    "3db3732aa803fc9b2c7e68e32be2f1b12757432d7827221e6d3c92c31d2a503e";
+
+struct KnownAnswer
+{
+  char const *name;
+  char const *public_key;
+  char const *message;
+  char const *signature;
+  bool        valid;
+};
+
+KnownAnswer const KNOWN_ANSWERS[] = {
+    {"high S", HIGH_S_KEY, "high-s signature",
+     "3e29e3480c0d52f65d923b38f11688d4d88936a4f612069a8582735e8a9b3dbf"
+     "97679ebf8cb8e9c4c7e3ec1f4f1de6bb4c138791c113c9c3c2e663f05f0e635b",
+     true},
+    {"low S counterpart", HIGH_S_KEY, "high-s signature",
+     "3e29e3480c0d52f65d923b38f11688d4d88936a4f612069a8582735e8a9b3dbf"
+     "689861407347163b381c13e0b0e219436e9b5554ee34d677fcebfa9c7127dde6",
+     true},
+    {"r is zero", HIGH_S_KEY, "high-s signature",
+     "0000000000000000000000000000000000000000000000000000000000000000"
+     "97679ebf8cb8e9c4c7e3ec1f4f1de6bb4c138791c113c9c3c2e663f05f0e635b",
+     false},
+    {"s is zero", HIGH_S_KEY, "high-s signature",
+     "3e29e3480c0d52f65d923b38f11688d4d88936a4f612069a8582735e8a9b3dbf"
+     "0000000000000000000000000000000000000000000000000000000000000000",
+     false},
+    {"r equals n", HIGH_S_KEY, "high-s signature",
+     "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141"
+     "97679ebf8cb8e9c4c7e3ec1f4f1de6bb4c138791c113c9c3c2e663f05f0e635b",
+     false},
+    {"s equals n", HIGH_S_KEY, "high-s signature",
+     "3e29e3480c0d52f65d923b38f11688d4d88936a4f612069a8582735e8a9b3dbf"
+     "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141",
+     false},
+    {"r above n", HIGH_S_KEY, "high-s signature",
+     "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364142"
+     "97679ebf8cb8e9c4c7e3ec1f4f1de6bb4c138791c113c9c3c2e663f05f0e635b",
+     false},
+    {"s above n", HIGH_S_KEY, "high-s signature",
+     "3e29e3480c0d52f65d923b38f11688d4d88936a4f612069a8582735e8a9b3dbf"
+     "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     false},
+    {"x coordinate above n", R_PLUS_N_KEY, "r plus n",
+     "0000000000000000000000000000000000000000000000000000000000000002"
+     "1f2e3d4c5b6a798897a6b5c4d3e2f1000f1e2d3c4b5a69788796a5b4c3d2e1f0",
+     true},
+    {"x coordinate above n, other message", R_PLUS_N_KEY, "r plus n?",
+     "0000000000000000000000000000000000000000000000000000000000000002"
+     "1f2e3d4c5b6a798897a6b5c4d3e2f1000f1e2d3c4b5a69788796a5b4c3d2e1f0",
+     false},
+    {"unreduced x coordinate", R_PLUS_N_KEY, "r plus n",
+     "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364143"
+     "1f2e3d4c5b6a798897a6b5c4d3e2f1000f1e2d3c4b5a69788796a5b4c3d2e1f0",
+     false},
+    {"sum is the point at infinity", INFINITY_KEY, "point at infinity",
+     "5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a"
+     "3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c3c",
+     false},
+};
+
+// The point (1, y) encoded with x + p, which must be rejected although it reduces onto the curve
+char const *const UNREDUCED_KEY =
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc30"
+    "4218f20ae6c646b363db68605822fb14264ca8d2587fdd6fbc750d587e76a7ee";
+
+/**
+ * Verify with OpenSSL, which reports some malformed signatures as errors rather than as failed
+ * verifications
+ */
+bool VerifyWithOpenSsl(ECDSAVerifier &verifier, ConstByteArray const &message,
+                       ConstByteArray const &signature)
+{
+  try
+  {
+    return verifier.Verify(message, signature);
+  }
+  catch (std::exception const &)
+  {
+    return false;
+  }
+}
+
+class Secp256k1VerifierTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    signer_.GenerateKeys();
+    message_   = GenerateMessage(rng_, 128);
+    signature_ = signer_.Sign(message_);
+  }
+
+  random::LinearCongruentialGenerator rng_;
+  ECDSASigner                         signer_;
+  ConstByteArray                      message_;
+  ConstByteArray                      signature_;
+};
+
+TEST_F(Secp256k1VerifierTests, ValidSignatureIsAccepted)
+{
+  Secp256k1Verifier verifier{signer_.identity()};
+
+  ASSERT_TRUE(static_cast<bool>(verifier));
+  EXPECT_TRUE(verifier.Verify(message_, signature_));
+}
+
+TEST_F(Secp256k1VerifierTests, MatchesOpenSslForRandomKeysAndMessages)
+{
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    ECDSASigner signer;
+    signer.GenerateKeys();
+
+    auto const message   = GenerateMessage(rng_, 1 + (i * 7));
+    auto const signature = signer.Sign(message);
+
+    Secp256k1Verifier native{signer.identity()};
+    ECDSAVerifier     openssl{signer.identity()};
+
+    ByteArray altered_message = message.Copy();
+    altered_message[i % altered_message.size()] ^= 0x01;
+
+    ByteArray altered_signature = signature.Copy();
+    altered_signature[i % altered_signature.size()] ^= 0x80;
+
+    EXPECT_TRUE(native.Verify(message, signature));
+    EXPECT_EQ(openssl.Verify(altered_message, signature),
+              native.Verify(altered_message, signature));
+    EXPECT_EQ(openssl.Verify(message, altered_signature),
+              native.Verify(message, altered_signature));
+  }
+}
+
+TEST_F(Secp256k1VerifierTests, NegatedSIsAccepted)
+{
+  Secp256k1Verifier native{signer_.identity()};
+  ECDSAVerifier     openssl{signer_.identity()};
+
+  auto const negated = NegateS(signature_);
+
+  EXPECT_TRUE(openssl.Verify(message_, negated));
+  EXPECT_TRUE(native.Verify(message_, negated));
+}
+
+TEST_F(Secp256k1VerifierTests, OutOfRangeComponentsAreRejected)
+{
+  Secp256k1Verifier native{signer_.identity()};
+
+  ByteArray zero_bytes;
+  zero_bytes.Resize(32);
+  for (std::size_t i = 0; i < zero_bytes.size(); ++i)
+  {
+    zero_bytes[i] = 0;
+  }
+
+  EXPECT_FALSE(native.Verify(message_, ReplaceHalf(signature_, 0, zero_bytes)));
+  EXPECT_FALSE(native.Verify(message_, ReplaceHalf(signature_, 32, zero_bytes)));
+  EXPECT_FALSE(native.Verify(message_, ReplaceHalf(signature_, 0, ORDER)));
+  EXPECT_FALSE(native.Verify(message_, ReplaceHalf(signature_, 32, ORDER)));
+}
+
+TEST_F(Secp256k1VerifierTests, SwappedComponentsAreRejected)
+{
+  Secp256k1Verifier native{signer_.identity()};
+
+  ByteArray swapped;
+  swapped.Append(signature_.SubArray(32, 32), signature_.SubArray(0, 32));
+
+  EXPECT_FALSE(native.Verify(message_, swapped));
+}
+
+TEST_F(Secp256k1VerifierTests, VerifiesPrecomputedHash)
+{
+  Secp256k1Verifier native{signer_.identity()};
+
+  EXPECT_TRUE(native.VerifyHash(Hash<SHA256>(message_), signature_));
+  EXPECT_FALSE(native.VerifyHash(Hash<SHA256>(message_ + "x"), signature_));
+}
+
+TEST_F(Secp256k1VerifierTests, WrongKeyIsRejected)
+{
+  ECDSASigner other;
+  other.GenerateKeys();
+
+  Secp256k1Verifier native{other.identity()};
+
+  EXPECT_FALSE(native.Verify(message_, signature_));
+}
+
+TEST_F(Secp256k1VerifierTests, InvalidPublicKeysAreRejected)
+{
+  secp256k1::PublicKey public_key;
+
+  // wrong length
+  EXPECT_FALSE(secp256k1::ParsePublicKey(signer_.public_key().SubArray(0, 32), public_key));
+
+  // not on the curve
+  ByteArray off_curve = signer_.public_key().Copy();
+  off_curve[63] ^= 0x01;
+  EXPECT_FALSE(secp256k1::ParsePublicKey(off_curve, public_key));
+
+  Secp256k1Verifier native{Identity{SECP256K1_UNCOMPRESSED, off_curve}};
+  EXPECT_FALSE(static_cast<bool>(native));
+  EXPECT_FALSE(native.Verify(message_, signature_));
+
+  EXPECT_TRUE(secp256k1::ParsePublicKey(signer_.public_key(), public_key));
+}
+
+TEST_F(Secp256k1VerifierTests, NonCanonicalSignaturesAreVerifiedByOpenSsl)
+{
+  Secp256k1Verifier native{signer_.identity()};
+  ECDSAVerifier     openssl{signer_.identity()};
+
+  auto const extended = signature_ + "x";
+
+  EXPECT_EQ(openssl.Verify(message_, extended), native.Verify(message_, extended));
+}
+
+TEST_F(Secp256k1VerifierTests, BuildPrefersNativeVerifier)
+{
+  auto verifier = Verifier::Build(signer_.identity());
+
+  ASSERT_TRUE(verifier);
+  EXPECT_NE(nullptr, dynamic_cast<Secp256k1Verifier *>(verifier.get()));
+  EXPECT_TRUE(verifier->Verify(message_, signature_));
+}
+
+TEST(Secp256k1KnownAnswerTests, EdgeCasesMatchKnownAnswers)
+{
+  for (auto const &vector : KNOWN_ANSWERS)
+  {
+    Identity const       identity{SECP256K1_UNCOMPRESSED, FromHex(vector.public_key)};
+    ConstByteArray const message{vector.message};
+    ConstByteArray const signature = FromHex(vector.signature);
+
+    Secp256k1Verifier native{identity};
+    ECDSAVerifier     openssl{identity};
+
+    ASSERT_TRUE(static_cast<bool>(native)) << vector.name;
+    EXPECT_EQ(vector.valid, native.Verify(message, signature)) << vector.name;
+    EXPECT_EQ(vector.valid, native.VerifyHash(Hash<SHA256>(message), signature)) << vector.name;
+    EXPECT_EQ(vector.valid, VerifyWithOpenSsl(openssl, message, signature)) << vector.name;
+  }
+}
+
+TEST(Secp256k1KnownAnswerTests, InvalidPublicKeyEncodingsAreRejected)
+{
+  // the point at infinity has no affine encoding, all zeros is the closest to one
+  ByteArray infinity;
+  infinity.Resize(secp256k1::PUBLIC_KEY_SIZE);
+  for (std::size_t i = 0; i < infinity.size(); ++i)
+  {
+    infinity[i] = 0;
+  }
+
+  ByteArray off_curve = infinity.Copy();
+  off_curve[31]       = 1;
+  off_curve[63]       = 1;
+
+  for (ConstByteArray const &key : {ConstByteArray{infinity}, ConstByteArray{off_curve},
+                                    FromHex(UNREDUCED_KEY)})
+  {
+    secp256k1::PublicKey public_key;
+    EXPECT_FALSE(secp256k1::ParsePublicKey(key, public_key));
+
+    Secp256k1Verifier native{Identity{SECP256K1_UNCOMPRESSED, key}};
+    EXPECT_FALSE(static_cast<bool>(native));
+    EXPECT_FALSE(native.Verify("message", FromHex(KNOWN_ANSWERS[0].signature)));
+  }
+}
+
+}  // namespace
+}  // namespace crypto
+}  // namespace fetch
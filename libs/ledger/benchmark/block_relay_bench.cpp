@@ -0,0 +1,284 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/counter.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "core/service_ids.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/testing/block_generator.hpp"
+#include "muddle/muddle_endpoint.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "muddle/subscription.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/uri.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using fetch::BitVector;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Hash;
+using fetch::ledger::Block;
+using fetch::ledger::testing::BlockGenerator;
+using fetch::muddle::Address;
+using fetch::muddle::MuddlePtr;
+using fetch::network::NetworkManager;
+using fetch::network::Uri;
+using fetch::serializers::MsgPackSerializer;
+using fetch::serializers::SizeCounter;
+
+namespace {
+
+using Payloads        = std::vector<ConstByteArray>;
+using SubscriptionPtr = fetch::muddle::MuddleEndpoint::SubscriptionPtr;
+using Clock           = std::chrono::steady_clock;
+using Milliseconds    = std::chrono::milliseconds;
+
+constexpr uint16_t    SOURCE_PORT = 8611;
+constexpr uint16_t    RELAY_PORT  = 8612;
+constexpr std::size_t NUM_LANES   = 1;
+constexpr std::size_t NUM_SLICES  = 4;
+constexpr std::size_t NUM_BLOCKS  = 32;
+
+enum class Mode
+{
+  RETAINED_ENCODING = 0,
+  REENCODE          = 1,
+};
+
+// signed blocks in their serialised form, as they would be gossiped by the miner
+Payloads GeneratePayloads(std::size_t num_transactions)
+{
+  BlockGenerator generator{NUM_LANES, NUM_SLICES};
+  ECDSASigner    signer{};
+
+  Payloads payloads{};
+  auto     previous = generator.Generate();
+  for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    auto block = generator.Generate(previous);
+
+    for (std::size_t j = 0; j < num_transactions; ++j)
+    {
+      auto const key    = std::to_string(i) + ':' + std::to_string(j);
+      auto const digest = Hash<fetch::crypto::SHA256>(key);
+      block->slices[j % NUM_SLICES].emplace_back(digest, BitVector{NUM_LANES}, 1, 0, 100);
+    }
+
+    block->miner_id = signer.identity();
+    block->UpdateDigest();
+    block->miner_signature = signer.Sign(block->hash);
+
+    MsgPackSerializer serializer;
+    serializer << *block;
+    payloads.emplace_back(serializer.data());
+
+    previous = block;
+  }
+
+  return payloads;
+}
+
+/**
+ * Three muddles connected in a line over TCP loopback. The relay decodes each block it receives
+ * (as the main chain service does) and then passes it on to the sink, which decodes it again.
+ */
+class BlockRelay
+{
+public:
+  static BlockRelay &Instance()
+  {
+    static BlockRelay instance;
+    return instance;
+  }
+
+  void Relay(Payloads const &payloads, Mode mode)
+  {
+    mode_     = mode;
+    received_ = 0;
+
+    for (auto const &payload : payloads)
+    {
+      source_muddle_->GetEndpoint().Send(relay_address_, fetch::SERVICE_MAIN_CHAIN,
+                                         fetch::CHANNEL_BLOCKS, payload);
+    }
+
+    // wait for all the blocks to have made it through the relay
+    auto const deadline = Clock::now() + std::chrono::seconds{60};
+    while ((received_ < payloads.size()) && (Clock::now() < deadline))
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+  }
+
+private:
+  BlockRelay()
+    : source_manager_{"SourceNetMgr", 1}
+    , relay_manager_{"RelayNetMgr", 1}
+    , sink_manager_{"SinkNetMgr", 1}
+  {
+    source_manager_.Start();
+    relay_manager_.Start();
+    sink_manager_.Start();
+
+    auto relay_identity = std::make_shared<ECDSASigner>();
+    auto sink_identity  = std::make_shared<ECDSASigner>();
+    relay_address_      = relay_identity->identity().identifier();
+    sink_address_       = sink_identity->identity().identifier();
+
+    source_muddle_ = fetch::muddle::CreateMuddle("BRLY", std::make_shared<ECDSASigner>(),
+                                                 source_manager_, "127.0.0.1", false);
+    relay_muddle_ =
+        fetch::muddle::CreateMuddle("BRLY", relay_identity, relay_manager_, "127.0.0.1", false);
+    sink_muddle_ =
+        fetch::muddle::CreateMuddle("BRLY", sink_identity, sink_manager_, "127.0.0.1", false);
+
+    relay_subscription_ =
+        relay_muddle_->GetEndpoint().Subscribe(fetch::SERVICE_MAIN_CHAIN, fetch::CHANNEL_BLOCKS);
+    relay_subscription_->SetMessageHandler([this](Address const &, ConstByteArray const &payload) {
+      MsgPackSerializer serializer{payload};
+
+      Block block;
+      serializer >> block;
+
+      if (mode_ == Mode::REENCODE)
+      {
+        block.encoding = ConstByteArray{};
+      }
+
+      // forward the block in the same way as it is broadcast by the main chain service
+      SizeCounter counter;
+      counter << block;
+
+      MsgPackSerializer forward;
+      forward.Reserve(counter.size());
+      forward << block;
+
+      relay_muddle_->GetEndpoint().Send(sink_address_, fetch::SERVICE_MAIN_CHAIN,
+                                        fetch::CHANNEL_BLOCKS, forward.data());
+    });
+
+    sink_subscription_ =
+        sink_muddle_->GetEndpoint().Subscribe(fetch::SERVICE_MAIN_CHAIN, fetch::CHANNEL_BLOCKS);
+    sink_subscription_->SetMessageHandler([this](Address const &, ConstByteArray const &payload) {
+      MsgPackSerializer serializer{payload};
+
+      Block block;
+      serializer >> block;
+
+      ++received_;
+    });
+
+    source_muddle_->Start({SOURCE_PORT});
+    relay_muddle_->Start({Uri{"tcp://127.0.0.1:" + std::to_string(SOURCE_PORT)}},
+                         fetch::muddle::MuddleInterface::Ports{RELAY_PORT});
+    sink_muddle_->Start({Uri{"tcp://127.0.0.1:" + std::to_string(RELAY_PORT)}},
+                        fetch::muddle::MuddleInterface::Ports{});
+
+    // wait for both of the connections to be established
+    auto const deadline = Clock::now() + std::chrono::seconds{10};
+    while (((relay_muddle_->GetNumDirectlyConnectedPeers() < 2) ||
+            (sink_muddle_->GetNumDirectlyConnectedPeers() == 0)) &&
+           (Clock::now() < deadline))
+    {
+      std::this_thread::sleep_for(Milliseconds{50});
+    }
+  }
+
+  ~BlockRelay()
+  {
+    sink_muddle_->Stop();
+    relay_muddle_->Stop();
+    source_muddle_->Stop();
+    sink_manager_.Stop();
+    relay_manager_.Stop();
+    source_manager_.Stop();
+  }
+
+  NetworkManager           source_manager_;
+  NetworkManager           relay_manager_;
+  NetworkManager           sink_manager_;
+  Address                  relay_address_;
+  Address                  sink_address_;
+  MuddlePtr                source_muddle_;
+  MuddlePtr                relay_muddle_;
+  MuddlePtr                sink_muddle_;
+  SubscriptionPtr          relay_subscription_;
+  SubscriptionPtr          sink_subscription_;
+  std::atomic<Mode>        mode_{Mode::RETAINED_ENCODING};
+  std::atomic<std::size_t> received_{0};
+};
+
+// range(0) selects the relay mode, range(1) the number of transactions per block
+void BlockRelay_CpuPerBlock(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::chain::InitialiseTestConstants();
+
+  auto const mode     = static_cast<Mode>(state.range(0));
+  auto const payloads = GeneratePayloads(static_cast<std::size_t>(state.range(1)));
+  auto &     relay    = BlockRelay::Instance();
+
+  // process CPU time covers the network, relay and sink threads alike
+  std::clock_t cpu_ticks{0};
+  for (auto _ : state)
+  {
+    auto const start = std::clock();
+    relay.Relay(payloads, mode);
+    cpu_ticks += std::clock() - start;
+  }
+
+  auto const blocks = static_cast<double>(state.iterations() * NUM_BLOCKS);
+  state.counters["cpu_us_per_block"] =
+      1e6 * static_cast<double>(cpu_ticks) / static_cast<double>(CLOCKS_PER_SEC) / blocks;
+  state.counters["block_bytes"] = static_cast<double>(payloads.front().size());
+}
+
+void CreateRanges(benchmark::internal::Benchmark *b)
+{
+  for (int num_transactions : {0, 256, 4096})
+  {
+    b->Args({static_cast<int>(Mode::RETAINED_ENCODING), num_transactions});
+    b->Args({static_cast<int>(Mode::REENCODE), num_transactions});
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BlockRelay_CpuPerBlock)
+    ->Apply(CreateRanges)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
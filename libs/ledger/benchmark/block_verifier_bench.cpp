@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_verifier.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/testing/block_generator.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+
+using fetch::BitVector;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::BlockVerifier;
+using fetch::ledger::Blocks;
+using fetch::ledger::MainChain;
+using fetch::ledger::testing::BlockGenerator;
+
+namespace {
+
+constexpr std::size_t NUM_LANES  = 1;
+constexpr std::size_t NUM_SLICES = 4;
+constexpr std::size_t NUM_BLOCKS = 64;
+
+// a chain of signed blocks following genesis (first), as received while synchronising
+Blocks GenerateBlocks(std::size_t num_transactions)
+{
+  BlockGenerator generator{NUM_LANES, NUM_SLICES};
+  ECDSASigner    signer{};
+
+  Blocks blocks{generator.Generate()};
+  for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    auto block = generator.Generate(blocks.back());
+
+    for (std::size_t j = 0; j < num_transactions; ++j)
+    {
+      auto const digest = Hash<SHA256>(std::to_string(i) + ':' + std::to_string(j));
+      block->slices[j % NUM_SLICES].emplace_back(digest, BitVector{NUM_LANES}, 1, 0, 100);
+    }
+
+    block->miner_id = signer.identity();
+    block->UpdateDigest();
+    block->miner_signature = signer.Sign(block->hash);
+
+    blocks.push_back(block);
+  }
+
+  return blocks;
+}
+
+// range(0) is the number of verifying threads, range(1) the number of transactions per block
+void BlockVerifier_SyncReplay(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::chain::InitialiseTestConstants();
+
+  auto const all_blocks = GenerateBlocks(static_cast<std::size_t>(state.range(1)));
+  Blocks     blocks(all_blocks.begin() + 1, all_blocks.end());
+
+  BlockVerifier verifier{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto chain = std::make_unique<MainChain>(MainChain::Mode::IN_MEMORY_DB);
+    state.ResumeTiming();
+
+    auto const statuses = verifier.Verify(blocks);
+
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+      if (statuses[i] == BlockVerifier::Status::VALID)
+      {
+        chain->AddBlock(blocks[i]);
+      }
+    }
+  }
+
+  state.counters["blocks_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations() * NUM_BLOCKS),
+                         benchmark::Counter::kIsRate);
+}
+
+void CreateRanges(benchmark::internal::Benchmark *b)
+{
+  auto const max_threads = static_cast<int>(std::thread::hardware_concurrency());
+
+  for (int num_transactions : {0, 256, 4096})
+  {
+    b->Args({1, num_transactions});
+
+    if (max_threads > 1)
+    {
+      b->Args({max_threads, num_transactions});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BlockVerifier_SyncReplay)->Apply(CreateRanges)->UseRealTime();
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_store.hpp"
+#include "ledger/chain/main_chain.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::Block;
+using fetch::ledger::BlockStore;
+using fetch::ledger::MainChain;
+
+using MainChainPtr = std::unique_ptr<MainChain>;
+
+// Write a persistent chain of the given length, as it would have been left by a node
+void CreateStoredChain(uint64_t num_blocks)
+{
+  // create the empty chain files (including the Bloom filter)
+  {
+    MainChain chain{MainChain::Mode::CREATE_PERSISTENT_DB};
+  }
+
+  BlockStore store{};
+  store.Load("chain");
+
+  auto genesis = MainChain::CreateGenesisBlock();
+  store.Add(*genesis);
+
+  Block previous = *genesis;
+  for (uint64_t block_number = 1; block_number < num_blocks; ++block_number)
+  {
+    Block block{};
+    block.block_number  = block_number;
+    block.previous_hash = previous.hash;
+    block.hash          = Hash<SHA256>(std::to_string(block_number));
+    block.timestamp     = block_number;
+    block.slices.resize(2);
+
+    store.SetNextHash(previous.hash, block.hash);
+    store.Add(block);
+
+    previous = block;
+  }
+
+  // the Bloom filter written above is trivially up to date with these (empty) blocks
+  store.SetFilterHeight(previous.block_number);
+  store.Flush();
+
+  auto const &tip = previous.hash;
+
+  std::ofstream head{"chain.head.db", std::ios::binary | std::ios::out | std::ios::trunc};
+  head.write(tip.char_pointer(), static_cast<std::streamsize>(tip.size()));
+}
+
+// range(0) is the number of stored blocks
+void MainChain_ColdStart(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::chain::InitialiseTestConstants();
+
+  auto const num_blocks = static_cast<uint64_t>(state.range(0));
+  CreateStoredChain(num_blocks);
+
+  for (auto _ : state)
+  {
+    auto chain = std::make_unique<MainChain>(MainChain::Mode::LOAD_PERSISTENT_DB);
+
+    if (chain->GetHeaviestBlock()->block_number + 1 != num_blocks)
+    {
+      state.SkipWithError("Failed to recover the stored chain");
+    }
+
+    state.PauseTiming();
+    chain.reset();
+    state.ResumeTiming();
+  }
+
+  state.counters["stored_blocks"] = static_cast<double>(num_blocks);
+}
+
+}  // namespace
+
+BENCHMARK(MainChain_ColdStart)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMillisecond);
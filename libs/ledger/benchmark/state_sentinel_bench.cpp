@@ -51,6 +51,93 @@ void StateSentinelAdapter_BasicBenchmark(benchmark::State &state)
   }
 }
 
+/**
+ * Storage unit which counts the number of lookups that would be sent to the lanes
+ */
+class CountingStorageUnit : public InMemoryStorageUnit
+{
+public:
+  Document Get(ResourceAddress const &key) const override
+  {
+    ++lookups;
+    return InMemoryStorageUnit::Get(key);
+  }
+
+  mutable uint64_t lookups{0};
+};
+
+using StatusCode = StateSentinelAdapter::Status;
+using ReadFunc   = bool (*)(StateSentinelAdapter &, std::string const &);
+
+/**
+ * The access pattern used by the VM before the Get interface was available: an existence check
+ * followed by a fixed size read, which is repeated when the value does not fit the buffer.
+ */
+bool ExistsThenRead(StateSentinelAdapter &adapter, std::string const &key)
+{
+  if (StatusCode::OK != adapter.Exists(key))
+  {
+    return false;
+  }
+
+  std::vector<uint8_t> buffer(256);
+  uint64_t             size   = buffer.size();
+  auto                 status = adapter.Read(key, buffer.data(), size);
+
+  if (StatusCode::BUFFER_TOO_SMALL == status)
+  {
+    buffer.resize(size);
+    status = adapter.Read(key, buffer.data(), size);
+  }
+
+  return StatusCode::OK == status;
+}
+
+bool SingleGet(StateSentinelAdapter &adapter, std::string const &key)
+{
+  fetch::byte_array::ConstByteArray value;
+  return StatusCode::OK == adapter.Get(key, value);
+}
+
+void RunStateReadBenchmark(benchmark::State &state, ReadFunc read)
+{
+  CountingStorageUnit storage{};
+
+  BitVector shards{1};
+  shards.SetAllOne();
+
+  StateSentinelAdapter adapter{storage, "foo.bar", shards};
+
+  std::string const          key{"baz"};
+  std::vector<uint8_t> const value(static_cast<std::size_t>(state.range(0)), 0x42);
+  adapter.Write(key, value.data(), value.size());
+
+  storage.lookups = 0;
+
+  uint64_t reads{0};
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(read(adapter, key));
+    ++reads;
+  }
+
+  state.counters["lane_rpcs_per_read"] =
+      static_cast<double>(storage.lookups) / static_cast<double>(reads);
+  state.SetBytesProcessed(static_cast<int64_t>(reads) * state.range(0));
+}
+
+void StateSentinelAdapter_ExistsThenRead(benchmark::State &state)
+{
+  RunStateReadBenchmark(state, ExistsThenRead);
+}
+
+void StateSentinelAdapter_Get(benchmark::State &state)
+{
+  RunStateReadBenchmark(state, SingleGet);
+}
+
 }  // namespace
 
 BENCHMARK(StateSentinelAdapter_BasicBenchmark);
+BENCHMARK(StateSentinelAdapter_ExistsThenRead)->Arg(32)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK(StateSentinelAdapter_Get)->Arg(32)->Arg(256)->Arg(4096)->Arg(65536);
@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/service_ids.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/muddle_endpoint.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "muddle/rpc/client.hpp"
+#include "muddle/rpc/server.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/uri.hpp"
+#include "storage/document_store_protocol.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::muddle::Address;
+using fetch::muddle::MuddlePtr;
+using fetch::network::NetworkManager;
+using fetch::network::Uri;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceAddress;
+using fetch::storage::ResourceID;
+using fetch::storage::RevertibleDocumentStoreProtocol;
+
+namespace {
+
+using Client       = fetch::muddle::rpc::Client;
+using Server       = fetch::muddle::rpc::Server;
+using Document     = fetch::storage::Document;
+using ClientPtr    = std::unique_ptr<Client>;
+using ServerPtr    = std::unique_ptr<Server>;
+using StorePtr     = std::unique_ptr<NewRevertibleDocumentStore>;
+using ProtoPtr     = std::unique_ptr<RevertibleDocumentStoreProtocol>;
+using Resources    = std::vector<ResourceID>;
+using Clock        = std::chrono::steady_clock;
+using Milliseconds = std::chrono::milliseconds;
+
+constexpr uint16_t    SERVER_PORT   = 8610;
+constexpr std::size_t NUM_RESOURCES = 1024;
+
+enum class Path
+{
+  MUDDLE = 0,
+  LOCAL  = 1,
+};
+
+/**
+ * A lane state database served over the internal muddle, in the same way as the lane service
+ * does, together with a storage client on a second muddle which is connected over TCP loopback
+ */
+class StateTransport
+{
+public:
+  static StateTransport &Instance()
+  {
+    static StateTransport instance;
+    return instance;
+  }
+
+  Document Get(Path path, ResourceID const &rid)
+  {
+    if (path == Path::LOCAL)
+    {
+      return client_
+          ->CallLocal<RevertibleDocumentStoreProtocol::GetSignature>(
+              server_address_, fetch::RPC_STATE, RevertibleDocumentStoreProtocol::GET, rid)
+          .value;
+    }
+
+    Document doc;
+    client_
+        ->CallSpecificAddress(server_address_, fetch::RPC_STATE,
+                              RevertibleDocumentStoreProtocol::GET, rid)
+        ->GetResult(doc);
+
+    return doc;
+  }
+
+  void Set(Path path, ResourceID const &rid, ConstByteArray const &value)
+  {
+    if (path == Path::LOCAL)
+    {
+      client_->CallLocal<RevertibleDocumentStoreProtocol::SetSignature>(
+          server_address_, fetch::RPC_STATE, RevertibleDocumentStoreProtocol::SET, rid, value);
+      return;
+    }
+
+    client_
+        ->CallSpecificAddress(server_address_, fetch::RPC_STATE,
+                              RevertibleDocumentStoreProtocol::SET, rid, value)
+        ->Wait();
+  }
+
+  Resources const &resources() const
+  {
+    return resources_;
+  }
+
+private:
+  StateTransport()
+    : server_manager_{"ServerNetMgr", 1}
+    , client_manager_{"ClientNetMgr", 1}
+  {
+    server_manager_.Start();
+    client_manager_.Start();
+
+    auto server_identity = std::make_shared<ECDSASigner>();
+    server_address_      = server_identity->identity().identifier();
+
+    server_muddle_ = fetch::muddle::CreateMuddle("ISRD", server_identity, server_manager_,
+                                                 "127.0.0.1", false);
+    client_muddle_ = fetch::muddle::CreateMuddle("ISRD", std::make_shared<ECDSASigner>(),
+                                                 client_manager_, "127.0.0.1", false);
+
+    // state database and its protocol, as set up by the lane service
+    store_ = std::make_unique<NewRevertibleDocumentStore>();
+    store_->New("storage_transport_state.db", "storage_transport_state_deltas.db",
+                "storage_transport_index.db", "storage_transport_index_deltas.db", false);
+    protocol_ = std::make_unique<RevertibleDocumentStoreProtocol>(store_.get(), 0, 1);
+
+    server_ = std::make_unique<Server>(server_muddle_->GetEndpoint(), fetch::SERVICE_LANE_CTRL,
+                                       fetch::CHANNEL_RPC);
+    server_->Add(fetch::RPC_STATE, protocol_.get());
+    server_->EnableLocalCalls();
+
+    client_ = std::make_unique<Client>("Bench", client_muddle_->GetEndpoint(),
+                                       fetch::SERVICE_LANE_CTRL, fetch::CHANNEL_RPC);
+
+    server_muddle_->Start({SERVER_PORT});
+    client_muddle_->Start({Uri{"tcp://127.0.0.1:" + std::to_string(SERVER_PORT)}},
+                         fetch::muddle::MuddleInterface::Ports{});
+
+    // wait for the connection to be established
+    auto const deadline = Clock::now() + std::chrono::seconds{10};
+    while ((client_muddle_->GetNumDirectlyConnectedPeers() == 0) && (Clock::now() < deadline))
+    {
+      std::this_thread::sleep_for(Milliseconds{50});
+    }
+
+    // populate the state
+    for (std::size_t i = 0; i < NUM_RESOURCES; ++i)
+    {
+      resources_.emplace_back(ResourceAddress{"resource." + std::to_string(i)});
+      store_->Set(resources_.back(), ConstByteArray{"initial value " + std::to_string(i)});
+    }
+  }
+
+  ~StateTransport()
+  {
+    client_muddle_->Stop();
+    server_muddle_->Stop();
+    server_->DisableLocalCalls();
+    client_manager_.Stop();
+    server_manager_.Stop();
+  }
+
+  NetworkManager server_manager_;
+  NetworkManager client_manager_;
+  Address        server_address_;
+  MuddlePtr      server_muddle_;
+  MuddlePtr      client_muddle_;
+  StorePtr       store_;
+  ProtoPtr       protocol_;
+  ServerPtr      server_;
+  ClientPtr      client_;
+  Resources      resources_;
+};
+
+void BM_StateGet(benchmark::State &state)
+{
+  auto const  path      = static_cast<Path>(state.range(0));
+  auto &      transport = StateTransport::Instance();
+  auto const &resources = transport.resources();
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    auto const doc = transport.Get(path, resources[index++ % resources.size()]);
+    benchmark::DoNotOptimize(doc);
+  }
+
+  state.SetLabel((path == Path::LOCAL) ? "in-process" : "muddle");
+}
+
+void BM_StateSet(benchmark::State &state)
+{
+  auto const  path      = static_cast<Path>(state.range(0));
+  auto &      transport = StateTransport::Instance();
+  auto const &resources = transport.resources();
+
+  ConstByteArray const value{"updated document value"};
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    transport.Set(path, resources[index++ % resources.size()], value);
+  }
+
+  state.SetLabel((path == Path::LOCAL) ? "in-process" : "muddle");
+}
+
+}  // namespace
+
+BENCHMARK(BM_StateGet)
+    ->Arg(static_cast<int>(Path::MUDDLE))
+    ->Arg(static_cast<int>(Path::LOCAL))
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StateSet)
+    ->Arg(static_cast<int>(Path::MUDDLE))
+    ->Arg(static_cast<int>(Path::LOCAL))
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,265 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "core/bitvector.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/prover.hpp"
+#include "ledger/storage_unit/transaction_archiver.hpp"
+#include "ledger/storage_unit/transaction_memory_pool.hpp"
+#include "ledger/storage_unit/transaction_segment_store.hpp"
+#include "ledger/storage_unit/transaction_store.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Identity;
+using fetch::crypto::Prover;
+using fetch::ledger::TransactionArchiver;
+using fetch::ledger::TransactionMemoryPool;
+using fetch::ledger::TransactionSegmentStore;
+using fetch::ledger::TransactionStore;
+using fetch::random::LinearCongruentialGenerator;
+
+using TransactionList = std::vector<TransactionBuilder::TransactionPtr>;
+using Digests         = std::vector<ConstByteArray>;
+
+constexpr uint32_t    LANE_ID             = 0;
+constexpr std::size_t FLUSH_BATCH_SIZE    = 10000;
+constexpr std::size_t GENERATION_BATCH    = 10000;
+constexpr std::size_t MAX_SAMPLED_DIGESTS = 1u << 16u;
+
+/**
+ * The archive never verifies signatures, so populating it with millions of transactions does not
+ * need to pay for millions of ECDSA signatures.
+ */
+class PlaceholderProver : public Prover
+{
+public:
+  Identity identity() const override
+  {
+    return signer_.identity();
+  }
+
+  void Load(ConstByteArray const & /*private_key*/) override
+  {}
+
+  ConstByteArray Sign(ConstByteArray const & /*message*/) const override
+  {
+    return signature_;
+  }
+
+private:
+  ECDSASigner    signer_{};
+  ConstByteArray signature_{ByteArray(64)};
+};
+
+TransactionList GenerateTransactions(std::size_t count, Prover const &prover,
+                                     LinearCongruentialGenerator &rng)
+{
+  TransactionList list;
+  list.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray data(4 * sizeof(uint64_t));
+    for (std::size_t word = 0; word < 4; ++word)
+    {
+      auto const value = rng();
+      std::memcpy(data.pointer() + (word * sizeof(value)), &value, sizeof(value));
+    }
+
+    list.emplace_back(TransactionBuilder()
+                          .From(Address{prover.identity()})
+                          .TargetChainCode("fetch.token", BitVector{})
+                          .Action("transfer")
+                          .Data(data)
+                          .Signer(prover.identity())
+                          .Seal()
+                          .Sign(prover)
+                          .Build());
+  }
+
+  return list;
+}
+
+template <typename Store>
+std::unique_ptr<Store> CreateStore(std::string const &name);
+
+template <>
+std::unique_ptr<TransactionStore> CreateStore<TransactionStore>(std::string const &name)
+{
+  auto store = std::make_unique<TransactionStore>();
+  store->New(name + ".db", name + ".index.db", true);
+  return store;
+}
+
+template <>
+std::unique_ptr<TransactionSegmentStore> CreateStore<TransactionSegmentStore>(
+    std::string const &name)
+{
+  auto store = std::make_unique<TransactionSegmentStore>();
+  store->New(name + ".db", name + ".index.db", true);
+  return store;
+}
+
+template <typename Store>
+void Flush(Store & /*store*/)
+{}
+
+template <>
+void Flush<TransactionSegmentStore>(TransactionSegmentStore &store)
+{
+  store.Flush();
+}
+
+template <typename Store>
+struct Population
+{
+  std::unique_ptr<Store> store;
+  Digests                sample;
+};
+
+/**
+ * Build (once per process) an archive with the specified number of transactions, along with a
+ * sample of the digests it contains
+ */
+template <typename Store>
+Population<Store> &GetPopulation(std::size_t count)
+{
+  static std::map<std::size_t, Population<Store>> populations;
+
+  auto it = populations.find(count);
+  if (it == populations.end())
+  {
+    PlaceholderProver           prover;
+    LinearCongruentialGenerator rng;
+
+    Population<Store> population;
+    population.store = CreateStore<Store>("transaction_archive_get_" + std::to_string(count));
+
+    std::size_t const sample_every = std::max<std::size_t>(1, count / MAX_SAMPLED_DIGESTS);
+
+    for (std::size_t generated = 0; generated < count;)
+    {
+      auto const batch_size = std::min(GENERATION_BATCH, count - generated);
+
+      for (auto const &tx : GenerateTransactions(batch_size, prover, rng))
+      {
+        population.store->Add(*tx);
+
+        if ((generated++ % sample_every) == 0)
+        {
+          population.sample.push_back(tx->digest());
+        }
+      }
+    }
+
+    Flush(*population.store);
+
+    it = populations.emplace(count, std::move(population)).first;
+  }
+
+  return it->second;
+}
+
+template <typename Store>
+void TransactionArchive_Flush(benchmark::State &state)
+{
+  PlaceholderProver           prover;
+  LinearCongruentialGenerator rng;
+
+  auto                  archive = CreateStore<Store>("transaction_archive_flush");
+  TransactionMemoryPool pool;
+  TransactionArchiver   archiver{LANE_ID, pool, *archive};
+
+  auto const &state_machine = archiver.GetStateMachine();
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    for (auto const &tx : GenerateTransactions(FLUSH_BATCH_SIZE, prover, rng))
+    {
+      pool.Add(*tx);
+      archiver.Confirm(tx->digest());
+    }
+    state.ResumeTiming();
+
+    // drive the archiver until every confirmed transaction has been moved into the archive
+    while (pool.GetCount() > 0)
+    {
+      state_machine->Execute();
+    }
+
+    Flush(*archive);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FLUSH_BATCH_SIZE));
+}
+
+template <typename Store>
+void TransactionArchive_RandomGet(benchmark::State &state)
+{
+  auto &population = GetPopulation<Store>(static_cast<std::size_t>(state.range(0)));
+
+  LinearCongruentialGenerator rng;
+  Transaction                 tx;
+
+  for (auto _ : state)
+  {
+    auto const &digest = population.sample[rng() % population.sample.size()];
+    benchmark::DoNotOptimize(population.store->Get(digest, tx));
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(TransactionArchive_Flush, TransactionStore)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(TransactionArchive_Flush, TransactionSegmentStore)
+    ->Unit(benchmark::kMillisecond);
+
+// the object store based archive is too slow to populate at the largest size
+BENCHMARK_TEMPLATE(TransactionArchive_RandomGet, TransactionStore)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(TransactionArchive_RandomGet, TransactionSegmentStore)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMicrosecond);
@@ -81,17 +81,51 @@ public:
   bool     is_loose     = false;
   uint64_t chain_label{0};  ///< The label of a heaviest chain this block once belonged to
                             ///< A more detailed explanation in MainChain::HeaviestTip.
+  byte_array::ConstByteArray encoding;  ///< The serialised form this block was received in, which
+                                        ///< is relayed verbatim while it is current
   /// @}
 
   // Helper functions
   std::size_t GetTransactionCount() const;
   void        UpdateDigest();
+  void        UpdateDigest(Digest const &transaction_root);
   void        UpdateTimestamp();
   bool        IsGenesis() const;
   bool        IsValid() const;
 
+  /// @name Miner Signature Checks
+  /// @{
+  void SetMinerSignatureVerified();
+  bool IsMinerSignatureVerified() const;
+  /// @}
+
+  /// @name Retained Encoding
+  /// @{
+  void SetEncoding(byte_array::ConstByteArray const &encoded);
+  bool HasCurrentEncoding() const;
+  void DetachFromBuffer();
+  /// @}
+
 private:
-  SystemClock clock_ = moment::GetClock("block:body", moment::ClockType::SYSTEM);
+  /// The hash, miner and signature of the last successful miner signature check (not serialised)
+  struct VerifiedSignature
+  {
+    Digest                     hash;
+    byte_array::ConstByteArray miner;
+    Digest                     signature;
+  };
+
+  /// The fields of the retained encoding which can change after the block has been received
+  struct EncodedFields
+  {
+    Digest hash;
+    Weight total_weight{0};
+    Digest miner_signature;
+  };
+
+  SystemClock       clock_ = moment::GetClock("block:body", moment::ClockType::SYSTEM);
+  VerifiedSignature verified_signature_;
+  EncodedFields     encoded_fields_;
 };
 
 using BlockHash = Block::Hash;
@@ -103,7 +137,7 @@ using Blocks    = std::vector<BlockPtr>;
 namespace serializers {
 
 template <typename D>
-struct MapSerializer<ledger::Block, D>
+struct ForwardSerializer<ledger::Block, D>
 {
 public:
   using Type       = ledger::Block;
@@ -123,9 +157,19 @@ public:
   static uint8_t const TIMESTAMP       = 12;
   static uint8_t const ENTROPY         = 13;
 
-  template <typename Constructor>
-  static void Serialize(Constructor &map_constructor, Type const &block)
+  template <typename Serializer>
+  static void Serialize(Serializer &serializer, Type const &block)
   {
+    // blocks which have been received are passed on in exactly the form they arrived in
+    if (block.HasCurrentEncoding())
+    {
+      serializer.Allocate(block.encoding.size());
+      serializer.WriteBytes(block.encoding.pointer(), block.encoding.size());
+      return;
+    }
+
+    typename Serializer::MapConstructor map_constructor(serializer);
+
     auto map = map_constructor(13);
     map.Append(WEIGHT, block.weight);
     map.Append(TOTAL_WEIGHT, block.total_weight);
@@ -142,22 +186,31 @@ public:
     map.Append(ENTROPY, block.block_entropy);
   }
 
-  template <typename MapDeserializer>
-  static void Deserialize(MapDeserializer &map, Type &block)
+  template <typename Serializer>
+  static void Deserialize(Serializer &serializer, Type &block)
   {
-    map.ExpectKeyGetValue(WEIGHT, block.weight);
-    map.ExpectKeyGetValue(TOTAL_WEIGHT, block.total_weight);
-    map.ExpectKeyGetValue(MINER_SIGNATURE, block.miner_signature);
-    map.ExpectKeyGetValue(HASH, block.hash);
-    map.ExpectKeyGetValue(PREVIOUS_HASH, block.previous_hash);
-    map.ExpectKeyGetValue(MERKLE_HASH, block.merkle_hash);
-    map.ExpectKeyGetValue(BLOCK_NUMBER, block.block_number);
-    map.ExpectKeyGetValue(MINER_ID, block.miner_id);
-    map.ExpectKeyGetValue(LOG2_NUM_LANES, block.log2_num_lanes);
-    map.ExpectKeyGetValue(SLICES, block.slices);
-    map.ExpectKeyGetValue(DAG_EPOCH, block.dag_epoch);
-    map.ExpectKeyGetValue(TIMESTAMP, block.timestamp);
-    map.ExpectKeyGetValue(ENTROPY, block.block_entropy);
+    auto const start = serializer.tell();
+
+    {
+      typename Serializer::MapDeserializer map(serializer);
+
+      map.ExpectKeyGetValue(WEIGHT, block.weight);
+      map.ExpectKeyGetValue(TOTAL_WEIGHT, block.total_weight);
+      map.ExpectKeyGetValue(MINER_SIGNATURE, block.miner_signature);
+      map.ExpectKeyGetValue(HASH, block.hash);
+      map.ExpectKeyGetValue(PREVIOUS_HASH, block.previous_hash);
+      map.ExpectKeyGetValue(MERKLE_HASH, block.merkle_hash);
+      map.ExpectKeyGetValue(BLOCK_NUMBER, block.block_number);
+      map.ExpectKeyGetValue(MINER_ID, block.miner_id);
+      map.ExpectKeyGetValue(LOG2_NUM_LANES, block.log2_num_lanes);
+      map.ExpectKeyGetValue(SLICES, block.slices);
+      map.ExpectKeyGetValue(DAG_EPOCH, block.dag_epoch);
+      map.ExpectKeyGetValue(TIMESTAMP, block.timestamp);
+      map.ExpectKeyGetValue(ENTROPY, block.block_entropy);
+    }
+
+    // keep a view of the received bytes so that the block can be relayed without re-encoding it
+    block.SetEncoding(serializer.data().SubArray(start, serializer.tell() - start));
   }
 };
 
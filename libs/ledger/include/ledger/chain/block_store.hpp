@@ -0,0 +1,141 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_db_record.hpp"
+#include "storage/fetch_mmap.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * The persistent store for the blocks of the main chain.
+ *
+ * Blocks are split into a header (every field apart from the slices) and a body (the slices),
+ * which are appended to separate data files. Every block has a fixed size record which locates its
+ * header and body and holds its hash and forward reference. The records are found through a hash
+ * index (an open addressing table keyed on the hash prefix) and a height index (the record of the
+ * last block written at each height). All the files are memory mapped.
+ *
+ *   records:  │ header │ record │ record │ ... │
+ *                           │
+ *              ┌────────────┴─────────────┐
+ *              ▼                          ▼
+ *   headers:  │ header │ header │ ...    bodies:  │ body │ body │ ...
+ *
+ *   hashes:   │ slot │ slot │ ... │     (hash prefix -> record)
+ *   heights:  │ record │ record │ ... │ (block number -> record)
+ *
+ * Since the indices are persisted, opening a store is independent of the length of the chain, and
+ * since the header and body are stored apart, reading a header does not deserialise the slices.
+ *
+ * The data and record files are written before the indices are updated and all mappings are synced
+ * to disk by Flush. A hash index which does not match the records, for example after a crash while
+ * it was being grown, is rebuilt from the records when the store is loaded.
+ *
+ * The chain of a store in the previous (ObjectStore) format can be imported once with Import.
+ */
+class BlockStore
+{
+public:
+  using Hash = Block::Hash;
+
+  // Construction / Destruction
+  BlockStore() = default;
+  BlockStore(BlockStore const &) = delete;
+  BlockStore(BlockStore &&)      = delete;
+  ~BlockStore();
+
+  /// @name Database Control
+  /// @{
+  void New(std::string const &prefix);
+  void Load(std::string const &prefix, bool create = true);
+  void Flush();
+  /// @}
+
+  /// @name Block Storage
+  /// @{
+  void     Add(Block const &block, Hash const &next_hash = {});
+  bool     Has(Hash const &hash) const;
+  bool     Get(Hash const &hash, BlockDbRecord &record) const;
+  bool     GetHeader(Hash const &hash, BlockDbRecord &record) const;
+  bool     GetByIndex(uint64_t index, BlockDbRecord &record) const;
+  bool     SetNextHash(Hash const &hash, Hash const &next_hash);
+  Hash     GetHashAtHeight(uint64_t block_number) const;
+  uint64_t size() const;
+  /// @}
+
+  /// @name Filter Checkpoint
+  /// @{
+  uint64_t filter_height() const;
+  void     SetFilterHeight(uint64_t block_number);
+  /// @}
+
+  /// @name Migration
+  /// @{
+  uint64_t Import(std::string const &doc_file, std::string const &index_file, Hash const &head);
+  /// @}
+
+  // Operators
+  BlockStore &operator=(BlockStore const &) = delete;
+  BlockStore &operator=(BlockStore &&) = delete;
+
+private:
+  struct StoreHeader;
+  struct Record;
+  struct HashSlot;
+
+  using MappedFile = mio::mmap_sink;
+
+  // Files
+  void Create();
+  void Close();
+  void Reserve(MappedFile &file, std::string const &suffix, uint64_t size);
+
+  // Records
+  StoreHeader &      header();
+  StoreHeader const &header() const;
+  Record *           records();
+  Record const *     records() const;
+  bool               Find(Hash const &hash, uint64_t &index) const;
+  bool               Read(uint64_t index, BlockDbRecord &record, bool with_body) const;
+  uint64_t           Append(MappedFile &file, std::string const &suffix, uint64_t &used,
+                            byte_array::ConstByteArray const &data);
+
+  // Indices
+  HashSlot *hash_slots();
+  void      InsertHash(uint64_t index);
+  void      RebuildHashIndex(uint64_t capacity_log2);
+  void      SetHeight(uint64_t block_number, uint64_t index);
+
+  mutable Mutex mutex_;
+  std::string   prefix_;
+  MappedFile    records_;
+  MappedFile    hashes_;
+  MappedFile    heights_;
+  MappedFile    headers_;
+  MappedFile    bodies_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
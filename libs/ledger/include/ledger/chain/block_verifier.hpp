@@ -0,0 +1,145 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "ledger/chain/block.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Verifies the contents of blocks received from the network before they are added to the chain.
+ *
+ * For each block the transaction merkle root and the block digest are recalculated, the
+ * transactions are checked for duplicates and the miner signature is checked against the new
+ * digest. None of these checks depend on the state of the chain, so the work of a batch (as
+ * received while synchronising) is spread over a pool of worker threads. The transactions of each
+ * block are split into ranges, for each of which one task hashes the merkle subtree and sorts the
+ * digests for the duplicate check, so that a single large block also uses the whole pool. The
+ * status of each block is reported at its index in the batch, which keeps the result, and so the
+ * first invalid block, independent of the order in which the workers complete.
+ *
+ * The number of transactions being verified at any one time is limited by a budget, bounding the
+ * transient memory used while verifying large blocks. A single block larger than the budget is
+ * verified on its own.
+ */
+class BlockVerifier
+{
+public:
+  enum class Status
+  {
+    VALID,
+    DUPLICATE_TRANSACTION,
+  };
+
+  using Statuses = std::vector<Status>;
+
+  static constexpr std::size_t DEFAULT_MAX_PENDING_TRANSACTIONS = 1u << 18u;  // 256K
+  static constexpr std::size_t DEFAULT_TRANSACTIONS_PER_TASK =
+      crypto::MerkleTree::MIN_LEAVES_PER_THREAD;
+
+  // Construction / Destruction
+  explicit BlockVerifier(std::size_t verifying_threads,
+                         std::size_t max_pending_transactions = DEFAULT_MAX_PENDING_TRANSACTIONS,
+                         std::size_t transactions_per_task    = DEFAULT_TRANSACTIONS_PER_TASK);
+  BlockVerifier(BlockVerifier const &) = delete;
+  BlockVerifier(BlockVerifier &&)      = delete;
+  ~BlockVerifier();
+
+  /// @name Verification
+  /// @{
+  static Status Verify(Block &block);
+  Statuses      Verify(Blocks const &blocks);
+  /// @}
+
+  // Operators
+  BlockVerifier &operator=(BlockVerifier const &) = delete;
+  BlockVerifier &operator=(BlockVerifier &&) = delete;
+
+private:
+  using Threads = std::vector<std::thread>;
+  using Lock    = std::unique_lock<std::mutex>;
+  using Digests = std::vector<Digest>;
+
+  static constexpr std::size_t PREPARE = std::numeric_limits<std::size_t>::max();
+
+  /// The verification of a single block of the current batch
+  struct Job
+  {
+    Block *            block{nullptr};
+    crypto::MerkleTree transactions{0};
+    Digests            digests{};  ///< Sorted in one run per subtree for the duplicate check
+    std::size_t        num_subtrees{0};
+    std::size_t        remaining{0};  ///< The subtrees still to be built (guarded by lock_)
+    std::size_t        cost{0};
+  };
+
+  /// Either the preparation of a block or the building of one of its subtrees
+  struct Task
+  {
+    std::size_t job;
+    std::size_t subtree;
+  };
+
+  using Jobs  = std::vector<Job>;
+  using Tasks = std::deque<Task>;
+
+  void Worker();
+  bool CanRunNext() const;
+  void RunNext(Lock &lock);
+
+  void   Prepare(Job &job) const;
+  void   BuildSubtree(Job &job, std::size_t subtree) const;
+  Status Complete(Job &job) const;
+
+  static void VerifyMinerSignature(Block &block);
+
+  std::size_t const max_pending_transactions_;
+  std::size_t const transactions_per_task_;
+  Threads           workers_;
+
+  std::mutex batch_lock_;  ///< Serialises the batches from concurrent callers
+
+  std::mutex              lock_;
+  std::condition_variable condition_;
+  bool                    stop_{false};
+
+  /// @name Current Batch (guarded by lock_)
+  /// @{
+  Jobs        jobs_{};
+  Tasks       tasks_{};  ///< The tasks of prepared blocks are always ahead of any preparation
+  Statuses *  statuses_{nullptr};
+  std::size_t remaining_{0};
+  std::size_t pending_transactions_{0};
+  /// @}
+};
+
+char const *ToString(BlockVerifier::Status status);
+
+}  // namespace ledger
+}  // namespace fetch
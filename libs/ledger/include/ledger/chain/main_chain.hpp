@@ -26,10 +26,10 @@
 #include "core/mutex.hpp"
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/block_db_record.hpp"
+#include "ledger/chain/block_store.hpp"
 #include "meta/type_util.hpp"
 #include "network/generics/milli_timer.hpp"
-#include "storage/object_store.hpp"
-#include "storage/resource_mapper.hpp"
 #include "telemetry/telemetry.hpp"
 
 #include <cstdint>
@@ -120,8 +120,6 @@ constexpr char const *ToString(BlockStatus status)
   return "Unknown";
 }
 
-struct BlockDbRecord;
-
 struct TimeTravelogue;
 
 class MainChain
@@ -213,7 +211,6 @@ private:
   using TipsMap       = std::unordered_map<BlockHash, Tip>;
   using BlockHashList = std::list<BlockHash>;
   using LooseBlockMap = std::unordered_map<BlockHash, BlockHashList>;
-  using BlockStore    = fetch::storage::ObjectStore<DbRecord>;
   using BlockStorePtr = std::unique_ptr<BlockStore>;
   using RMutex        = std::recursive_mutex;
   using RLock         = std::unique_lock<RMutex>;
@@ -286,6 +283,7 @@ private:
   BlockMap::size_type UncacheBlock(BlockHash const &hash) const;
   void                KeepBlock(BlockPtr const &block) const;
   bool LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_hash = nullptr) const;
+  bool LoadBlockHeader(BlockHash const &hash, Block &block) const;
   /// @}
 
   /// @name Tip Management
@@ -21,6 +21,7 @@
 #include "core/mutex.hpp"
 #include "core/random/lcg.hpp"
 #include "core/state_machine.hpp"
+#include "ledger/chain/block_verifier.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/consensus/consensus_interface.hpp"
 #include "ledger/protocols/main_chain_rpc_protocol.hpp"
@@ -201,7 +202,8 @@ private:
 
   /// @name Block Validation
   /// @{
-  ConsensusPtr consensus_;
+  ConsensusPtr  consensus_;
+  BlockVerifier block_verifier_;
   /// @}
 
   /// @name RPC Server
@@ -42,7 +42,8 @@ public:
 
   // Resource Mapping
   static storage::ResourceAddress CreateAddress(ConstByteArray const &            scope,
-                                                byte_array::ConstByteArray const &key);
+                                                byte_array::ConstByteArray const &key,
+                                                bool paged_state = false);
 
   enum class Mode
   {
@@ -57,6 +58,7 @@ public:
   /// @name Io Observer Interface
   /// @{
   Status Read(std::string const &key, void *data, uint64_t &size) override;
+  Status Get(std::string const &key, ConstByteArray &value) override;
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
   /// @}
@@ -64,6 +66,8 @@ public:
   void PushContext(ConstByteArray const &scope);
   void PopContext();
 
+  void EnablePagedState(bool enabled);
+
 protected:
   ConstByteArray CurrentScope() const;
 
@@ -73,6 +77,7 @@ protected:
   StorageInterface &          storage_;
   std::vector<ConstByteArray> scope_;
   Mode const                  mode_;
+  bool                        paged_state_{false};
 };
 
 }  // namespace ledger
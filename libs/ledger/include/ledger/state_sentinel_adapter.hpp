@@ -43,6 +43,7 @@ public:
   /// @name IO Observer Interface
   /// @{
   Status Read(std::string const &key, void *data, uint64_t &size) override;
+  Status Get(std::string const &key, ConstByteArray &value) override;
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
   /// @}
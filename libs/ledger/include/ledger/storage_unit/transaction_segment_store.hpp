@@ -0,0 +1,150 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/mutex.hpp"
+#include "ledger/storage_unit/transaction_store_interface.hpp"
+#include "storage/fetch_mmap.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * An append only transaction archive. Transactions are written sequentially into fixed size,
+ * memory mapped segment files and located through an open addressing hash index (digest prefix
+ * to segment and offset), which is also memory mapped.
+ *
+ *   index file:   │ header │ entry │ entry │ ... │ entry │
+ *                               │
+ *                               ▼
+ *   segment N:    │ record │ record │ record │ ... │ (unused) │
+ *
+ *   record:       │ length │ checksum │ digest │ serialised transaction │ padding │
+ *
+ * Unlike the generic object store there is no Merkle trie over the contents and no block
+ * linked lists, since the archive never needs to be hashed, reverted or have elements removed.
+ *
+ * Writes are group committed: the segment and index mappings are synced to disk every
+ * GROUP_COMMIT_SIZE transactions, or when Flush is called. Transactions written after the last
+ * commit are recovered from the segment files when the archive is next loaded, up to the first
+ * record whose checksum does not match its contents.
+ *
+ * The index slot for a digest is derived from the bit reversed digest prefix, so all of the
+ * transactions belonging to a digest subtree (see PullSubtree) occupy a contiguous range of the
+ * index.
+ */
+class TransactionSegmentStore : public TransactionStoreInterface
+{
+public:
+  using TxArray = std::vector<chain::Transaction>;
+
+  static constexpr uint64_t DEFAULT_SEGMENT_SIZE        = 64ull << 20u;
+  static constexpr uint64_t DEFAULT_INDEX_CAPACITY_LOG2 = 16;
+  static constexpr uint64_t GROUP_COMMIT_SIZE           = 256;
+
+  // Construction / Destruction
+  explicit TransactionSegmentStore(uint64_t segment_size        = DEFAULT_SEGMENT_SIZE,
+                                   uint64_t index_capacity_log2 = DEFAULT_INDEX_CAPACITY_LOG2);
+  TransactionSegmentStore(TransactionSegmentStore const &) = delete;
+  TransactionSegmentStore(TransactionSegmentStore &&)      = delete;
+  ~TransactionSegmentStore() override;
+
+  // Database control
+  void New(std::string const &doc_file, std::string const &index_file, bool create = true);
+  void Load(std::string const &doc_file, std::string const &index_file, bool create = true);
+  void Flush();
+
+  /// @name Transaction Storage Interface
+  /// @{
+  void     Add(chain::Transaction const &tx) override;
+  bool     Has(Digest const &tx_digest) const override;
+  bool     Get(Digest const &tx_digest, chain::Transaction &tx) const override;
+  uint64_t GetCount() const override;
+  /// @}
+
+  /// @name Low Level Subtree Access
+  /// @{
+  TxArray PullSubtree(Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit);
+  /// @}
+
+  // Operators
+  TransactionSegmentStore &operator=(TransactionSegmentStore const &) = delete;
+  TransactionSegmentStore &operator=(TransactionSegmentStore &&) = delete;
+
+private:
+  struct IndexHeader
+  {
+    uint64_t magic;
+    uint64_t capacity_log2;
+    uint64_t count;
+    uint64_t segment_size;
+    uint64_t tail_segment;  ///< The active segment at the last commit
+    uint64_t tail_offset;   ///< The write offset into the active segment at the last commit
+  };
+
+  struct IndexEntry
+  {
+    uint64_t key;       ///< The first 8 bytes of the digest
+    uint64_t location;  ///< The encoded segment and offset of the record, zero when unused
+  };
+
+  using MappedFile  = mio::mmap_sink;
+  using Segments    = std::vector<MappedFile>;
+  using DigestBytes = uint8_t const *;
+
+  // Index
+  MappedFile         CreateIndex(std::string const &path, uint64_t capacity_log2) const;
+  IndexHeader &      header();
+  IndexHeader const &header() const;
+  IndexEntry *       entries();
+  IndexEntry const * entries() const;
+  bool               Find(DigestBytes digest, uint64_t &location) const;
+  void               Insert(uint64_t key, uint64_t location);
+  void               GrowIndex();
+
+  // Segments
+  std::string     SegmentPath(uint64_t segment) const;
+  void            MapSegment(uint64_t segment, bool create);
+  uint8_t const * Record(uint64_t location) const;
+  bool            ReadRecord(uint64_t location, chain::Transaction &tx) const;
+  void            Append(DigestBytes digest, byte_array::ConstByteArray const &payload);
+  void            Recover();
+
+  // Lifecycle
+  void Create();
+  void Commit();
+  void Close();
+
+  mutable Mutex mutex_;
+  uint64_t      segment_size_;
+  uint64_t      index_capacity_log2_;
+  std::string   segment_prefix_;
+  std::string   index_path_;
+  MappedFile    index_;
+  Segments      segments_;
+  uint64_t      write_offset_{0};
+  uint64_t      pending_{0};
+};
+
+}  // namespace ledger
+}  // namespace fetch
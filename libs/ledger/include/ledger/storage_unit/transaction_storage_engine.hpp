@@ -21,6 +21,7 @@
 #include "ledger/storage_unit/recent_transaction_cache.hpp"
 #include "ledger/storage_unit/transaction_archiver.hpp"
 #include "ledger/storage_unit/transaction_memory_pool.hpp"
+#include "ledger/storage_unit/transaction_segment_store.hpp"
 #include "ledger/storage_unit/transaction_storage_engine_interface.hpp"
 #include "ledger/storage_unit/transaction_store.hpp"
 #include "ledger/storage_unit/transaction_store_aggregator.hpp"
@@ -73,7 +74,7 @@ private:
 
   uint32_t const             lane_;
   TransactionMemoryPool      mem_pool_;
-  TransactionStore           archive_;
+  TransactionSegmentStore    archive_;
   TransactionStoreAggregator store_{mem_pool_, archive_};
   TransactionArchiver        archiver_{lane_, mem_pool_, archive_};
   RecentTransactionsCache    recent_tx_;
@@ -50,7 +50,7 @@ public:
   uint64_t GetCount() const override;
   /// @}
 
-  /// @mame Low Level Subtree Access
+  /// @name Low Level Subtree Access
   /// @{
   TxArray PullSubtree(Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit);
   /// @}
@@ -18,6 +18,7 @@
 
 #include "chain/constants.hpp"
 #include "core/containers/is_in.hpp"
+#include "core/serializers/counter.hpp"
 #include "core/serializers/main_serializer.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
@@ -26,6 +27,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
@@ -85,13 +87,30 @@ void Block::UpdateDigest()
   // Calculate the root
   tx_merkle_tree.CalculateRoot();
 
+  UpdateDigest(tx_merkle_tree.root());
+}
+
+/**
+ * Populate the block hash field from a previously calculated root of the merkle tree of the block
+ * transactions
+ *
+ * @param transaction_root The root of the transaction merkle tree
+ */
+void Block::UpdateDigest(Digest const &transaction_root)
+{
+  if (IsGenesis())
+  {
+    assert(hash == chain::GetGenesisDigest());
+    return;
+  }
+
   // Generate hash stream
   serializers::MsgPackSerializer buf;
 
   // clang-format off
   buf << previous_hash;
   buf << merkle_hash;
-  buf << tx_merkle_tree.root();
+  buf << transaction_root;
   buf << block_number;
   buf << miner_id;
   buf << log2_num_lanes;
@@ -105,7 +124,15 @@ void Block::UpdateDigest()
   crypto::SHA256 hash_builder;
   hash_builder.Reset();
   hash_builder.Update(buf.data());
-  hash = hash_builder.Final();
+  Digest const updated_hash = hash_builder.Final();
+
+  // a retained encoding only describes the block while its contents are unchanged
+  if (updated_hash != hash)
+  {
+    encoding = byte_array::ConstByteArray{};
+  }
+
+  hash = updated_hash;
 }
 
 void Block::UpdateTimestamp()
@@ -121,6 +148,91 @@ bool Block::IsGenesis() const
   return previous_hash == chain::ZERO_HASH;
 }
 
+/**
+ * Record that the miner signature has been verified for the current hash and miner
+ */
+void Block::SetMinerSignatureVerified()
+{
+  verified_signature_ = VerifiedSignature{hash, miner_id.identifier(), miner_signature};
+}
+
+/**
+ * Determine if the miner signature has been verified, the check only applies while the hash, miner
+ * and signature all remain the same as when it was made
+ *
+ * @return true if the current miner signature has been verified, otherwise false
+ */
+bool Block::IsMinerSignatureVerified() const
+{
+  return !verified_signature_.signature.empty() && (verified_signature_.hash == hash) &&
+         (verified_signature_.miner == miner_id.identifier()) &&
+         (verified_signature_.signature == miner_signature);
+}
+
+/**
+ * Retain the serialised form of the block, recording the fields it was encoded with which can
+ * change after the block has been received
+ *
+ * @param encoded The serialised block
+ */
+void Block::SetEncoding(byte_array::ConstByteArray const &encoded)
+{
+  encoding        = encoded;
+  encoded_fields_ = EncodedFields{hash, total_weight, miner_signature};
+}
+
+/**
+ * Determine if the retained encoding still describes the block. The total weight is recalculated
+ * when the block is added to the chain and a new block is signed after its digest is calculated,
+ * either of which makes the encoding stale
+ *
+ * @return true if the retained encoding can be used in place of serialising the block
+ */
+bool Block::HasCurrentEncoding() const
+{
+  return !encoding.empty() && (encoded_fields_.hash == hash) &&
+         (encoded_fields_.total_weight == total_weight) &&
+         (encoded_fields_.miner_signature == miner_signature);
+}
+
+/**
+ * Release the buffer the block was decoded from, for blocks which are retained long term. The
+ * fields of a decoded block are views over the received buffer, which may hold many other blocks,
+ * so the block is encoded into a buffer of its own and decoded from it again.
+ */
+void Block::DetachFromBuffer()
+{
+  // blocks which have been built locally, or decoded from a buffer of their own, hold no views
+  // over other data
+  if (encoding.empty() || (encoding.capacity() == encoding.size()))
+  {
+    return;
+  }
+
+  serializers::SizeCounter counter;
+  counter << *this;
+
+  serializers::MsgPackSerializer buffer;
+  buffer.Reserve(counter.size());
+  buffer << *this;
+  buffer.seek(0);
+
+  Block detached{};
+  buffer >> detached;
+
+  // the metadata which is not serialised
+  detached.is_loose    = is_loose;
+  detached.chain_label = chain_label;
+  detached.clock_      = clock_;
+
+  if (IsMinerSignatureVerified())
+  {
+    detached.SetMinerSignatureVerified();
+  }
+
+  *this = std::move(detached);
+}
+
 bool Block::IsValid() const
 {
   DigestSet txs{};
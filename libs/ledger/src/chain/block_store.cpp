@@ -0,0 +1,860 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/chain/block_store.hpp"
+#include "logging/logging.hpp"
+#include "storage/object_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/storage_exception.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using byte_array::ConstByteArray;
+using storage::StorageException;
+
+constexpr char const *LOGGING_NAME = "BlockStore";
+
+constexpr uint64_t STORE_MAGIC   = 0x5845444E494B4C42;  // "BLKINDEX"
+constexpr uint64_t STORE_VERSION = 1;
+constexpr uint64_t HASH_SIZE     = 32;
+
+constexpr char const *RECORDS_SUFFIX = ".records.db";
+constexpr char const *HASHES_SUFFIX  = ".hashes.db";
+constexpr char const *HEIGHTS_SUFFIX = ".heights.db";
+constexpr char const *HEADERS_SUFFIX = ".headers.db";
+constexpr char const *BODIES_SUFFIX  = ".bodies.db";
+
+constexpr uint64_t INITIAL_RECORDS         = 1024;
+constexpr uint64_t INITIAL_HASH_CAPACITY   = 12;  // log2
+constexpr uint64_t INITIAL_DATA_SIZE       = uint64_t{1} << 20u;
+constexpr uint64_t MAX_SERIALISED_DATA_LEN = std::numeric_limits<uint32_t>::max();
+
+bool FileExists(std::string const &path)
+{
+  std::ifstream file(path);
+  return file.good();
+}
+
+void CreateFile(std::string const &path, uint64_t size)
+{
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  file.seekp(static_cast<std::streamoff>(size - 1));
+  file.put('\0');
+
+  if (!file)
+  {
+    throw StorageException("Unable to create block store file");
+  }
+}
+
+void ExtendFile(std::string const &path, uint64_t size)
+{
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekp(static_cast<std::streamoff>(size - 1));
+  file.put('\0');
+
+  if (!file)
+  {
+    throw StorageException("Unable to extend block store file");
+  }
+}
+
+mio::mmap_sink MapFile(std::string const &path)
+{
+  std::error_code error;
+  auto            mapping = mio::make_mmap_sink(path, 0, mio::map_entire_file, error);
+
+  if (error)
+  {
+    throw StorageException("Unable to map block store file");
+  }
+
+  return mapping;
+}
+
+void Sync(mio::mmap_sink &mapping)
+{
+  if (!mapping.is_mapped())
+  {
+    return;
+  }
+
+  std::error_code error;
+  mapping.sync(error);
+
+  if (error)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to sync block store: ", error.message());
+  }
+}
+
+uint64_t HashKey(uint8_t const *hash)
+{
+  uint64_t key{0};
+  std::memcpy(&key, hash, sizeof(key));
+  return key;
+}
+
+bool IsZero(uint8_t const *hash)
+{
+  return std::all_of(hash, hash + HASH_SIZE, [](uint8_t value) { return value == 0; });
+}
+
+ConstByteArray SerialiseHeader(Block const &block)
+{
+  serializers::MsgPackSerializer buffer;
+
+  // clang-format off
+  buffer << block.weight;
+  buffer << block.total_weight;
+  buffer << block.miner_signature;
+  buffer << block.hash;
+  buffer << block.previous_hash;
+  buffer << block.merkle_hash;
+  buffer << block.block_number;
+  buffer << block.miner_id;
+  buffer << block.log2_num_lanes;
+  buffer << block.dag_epoch;
+  buffer << block.timestamp;
+  buffer << block.block_entropy;
+  // clang-format on
+
+  return buffer.data();
+}
+
+void DeserialiseHeader(ConstByteArray const &data, Block &block)
+{
+  serializers::MsgPackSerializer buffer{data};
+
+  // clang-format off
+  buffer >> block.weight;
+  buffer >> block.total_weight;
+  buffer >> block.miner_signature;
+  buffer >> block.hash;
+  buffer >> block.previous_hash;
+  buffer >> block.merkle_hash;
+  buffer >> block.block_number;
+  buffer >> block.miner_id;
+  buffer >> block.log2_num_lanes;
+  buffer >> block.dag_epoch;
+  buffer >> block.timestamp;
+  buffer >> block.block_entropy;
+  // clang-format on
+}
+
+ConstByteArray SerialiseBody(Block const &block)
+{
+  serializers::MsgPackSerializer buffer;
+  buffer << block.slices;
+
+  return buffer.data();
+}
+
+void DeserialiseBody(ConstByteArray const &data, Block &block)
+{
+  serializers::MsgPackSerializer buffer{data};
+  buffer >> block.slices;
+}
+
+}  // namespace
+
+struct BlockStore::StoreHeader
+{
+  uint64_t magic;
+  uint64_t version;
+  uint64_t count;               ///< The number of block records
+  uint64_t hash_capacity_log2;  ///< The log2 of the number of slots in the hash index
+  uint64_t hash_count;          ///< The number of records present in the hash index
+  uint64_t height_count;        ///< The number of entries in the height index
+  uint64_t header_bytes;        ///< The used size of the headers file
+  uint64_t body_bytes;          ///< The used size of the bodies file
+  uint64_t filter_height;       ///< See SetFilterHeight
+};
+
+struct BlockStore::Record
+{
+  uint8_t  hash[HASH_SIZE];
+  uint8_t  next_hash[HASH_SIZE];  ///< All zeros when there is no forward reference
+  uint64_t block_number;
+  uint64_t header_offset;
+  uint64_t body_offset;
+  uint32_t header_length;
+  uint32_t body_length;
+};
+
+struct BlockStore::HashSlot
+{
+  uint64_t key;    ///< The first 8 bytes of the hash
+  uint64_t index;  ///< The index of the record plus one, zero when unused
+};
+
+BlockStore::~BlockStore()
+{
+  FETCH_LOCK(mutex_);
+  Close();
+}
+
+/**
+ * Create a new (empty) store, removing any previous one
+ *
+ * @param prefix The path prefix for the store files
+ */
+void BlockStore::New(std::string const &prefix)
+{
+  FETCH_LOCK(mutex_);
+
+  Close();
+
+  prefix_ = prefix;
+  Create();
+}
+
+/**
+ * Load an existing store, mapping its indices
+ *
+ * @param prefix The path prefix for the store files
+ * @param create Flag to signal if the store should be created if it doesn't exist
+ */
+void BlockStore::Load(std::string const &prefix, bool create)
+{
+  FETCH_LOCK(mutex_);
+
+  Close();
+
+  prefix_ = prefix;
+
+  if (!FileExists(prefix_ + RECORDS_SUFFIX))
+  {
+    if (!create)
+    {
+      throw StorageException("Block store does not exist");
+    }
+
+    Create();
+    return;
+  }
+
+  records_ = MapFile(prefix_ + RECORDS_SUFFIX);
+
+  if ((records_.size() < sizeof(StoreHeader)) || (header().magic != STORE_MAGIC) ||
+      (header().version != STORE_VERSION) ||
+      (records_.size() < sizeof(StoreHeader) + (header().count * sizeof(Record))))
+  {
+    records_.unmap();
+    throw StorageException("Block store records are corrupt");
+  }
+
+  headers_ = MapFile(prefix_ + HEADERS_SUFFIX);
+  bodies_  = MapFile(prefix_ + BODIES_SUFFIX);
+  heights_ = MapFile(prefix_ + HEIGHTS_SUFFIX);
+
+  if ((headers_.size() < header().header_bytes) || (bodies_.size() < header().body_bytes) ||
+      (heights_.size() < header().height_count * sizeof(uint64_t)))
+  {
+    Close();
+    throw StorageException("Block store data files are corrupt");
+  }
+
+  // the hash index can always be recovered from the records
+  uint64_t const capacity_log2 = header().hash_capacity_log2;
+  uint64_t const expected_size = sizeof(HashSlot) << capacity_log2;
+
+  if (FileExists(prefix_ + HASHES_SUFFIX))
+  {
+    hashes_ = MapFile(prefix_ + HASHES_SUFFIX);
+  }
+
+  if ((hashes_.size() != expected_size) || (header().hash_count != header().count))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Rebuilding block store hash index");
+    RebuildHashIndex(capacity_log2);
+  }
+}
+
+/**
+ * Force the pending writes of the store to disk
+ */
+void BlockStore::Flush()
+{
+  FETCH_LOCK(mutex_);
+
+  // the records (holding the store header) are synced last
+  Sync(headers_);
+  Sync(bodies_);
+  Sync(hashes_);
+  Sync(heights_);
+  Sync(records_);
+}
+
+/**
+ * Add a block to the store
+ *
+ * If the block is already present only its forward reference is updated. In both cases the block
+ * becomes the one recorded at its height.
+ *
+ * @param block The block to be stored
+ * @param next_hash The hash of the next block on the chain, if known
+ */
+void BlockStore::Add(Block const &block, Hash const &next_hash)
+{
+  FETCH_LOCK(mutex_);
+
+  if (!records_.is_mapped())
+  {
+    throw StorageException("Block store is not open");
+  }
+
+  if ((block.hash.size() != HASH_SIZE) || (!next_hash.empty() && (next_hash.size() != HASH_SIZE)))
+  {
+    throw StorageException("Invalid block hash size");
+  }
+
+  uint64_t index{0};
+  if (!Find(block.hash, index))
+  {
+    auto const header_data = SerialiseHeader(block);
+    auto const body_data   = SerialiseBody(block);
+
+    if ((header_data.size() > MAX_SERIALISED_DATA_LEN) ||
+        (body_data.size() > MAX_SERIALISED_DATA_LEN))
+    {
+      throw StorageException("Block is too large for the block store");
+    }
+
+    uint64_t const header_offset = Append(headers_, HEADERS_SUFFIX, header().header_bytes,
+                                          header_data);
+    uint64_t const body_offset = Append(bodies_, BODIES_SUFFIX, header().body_bytes, body_data);
+
+    index = header().count;
+    Reserve(records_, RECORDS_SUFFIX, sizeof(StoreHeader) + ((index + 1) * sizeof(Record)));
+
+    auto &record = records()[index];
+    std::memcpy(record.hash, block.hash.pointer(), HASH_SIZE);
+    std::memset(record.next_hash, 0, HASH_SIZE);
+    record.block_number  = block.block_number;
+    record.header_offset = header_offset;
+    record.body_offset   = body_offset;
+    record.header_length = static_cast<uint32_t>(header_data.size());
+    record.body_length   = static_cast<uint32_t>(body_data.size());
+
+    ++header().count;
+    InsertHash(index);
+  }
+
+  auto &record = records()[index];
+  if (next_hash.empty())
+  {
+    std::memset(record.next_hash, 0, HASH_SIZE);
+  }
+  else
+  {
+    std::memcpy(record.next_hash, next_hash.pointer(), HASH_SIZE);
+  }
+
+  SetHeight(block.block_number, index);
+}
+
+/**
+ * Check to see if a block is present in the store
+ *
+ * @param hash The hash of the block
+ * @return true if present, otherwise false
+ */
+bool BlockStore::Has(Hash const &hash) const
+{
+  FETCH_LOCK(mutex_);
+
+  uint64_t index{0};
+  return Find(hash, index);
+}
+
+/**
+ * Read a complete block from the store
+ *
+ * @param hash The hash of the block
+ * @param record The output block and forward reference
+ * @return true if successful, otherwise false
+ */
+bool BlockStore::Get(Hash const &hash, BlockDbRecord &record) const
+{
+  FETCH_LOCK(mutex_);
+
+  uint64_t index{0};
+  return Find(hash, index) && Read(index, record, true);
+}
+
+/**
+ * Read a block from the store without its slices
+ *
+ * @param hash The hash of the block
+ * @param record The output block (with no slices) and forward reference
+ * @return true if successful, otherwise false
+ */
+bool BlockStore::GetHeader(Hash const &hash, BlockDbRecord &record) const
+{
+  FETCH_LOCK(mutex_);
+
+  uint64_t index{0};
+  return Find(hash, index) && Read(index, record, false);
+}
+
+/**
+ * Read a complete block by its position in the store, in the order the blocks were added
+ *
+ * @param index The index of the block, less than size()
+ * @param record The output block and forward reference
+ * @return true if successful, otherwise false
+ */
+bool BlockStore::GetByIndex(uint64_t index, BlockDbRecord &record) const
+{
+  FETCH_LOCK(mutex_);
+
+  return records_.is_mapped() && (index < header().count) && Read(index, record, true);
+}
+
+/**
+ * Update the forward reference of a stored block
+ *
+ * @param hash The hash of the block
+ * @param next_hash The hash of the next block on the chain
+ * @return true if the block was found, otherwise false
+ */
+bool BlockStore::SetNextHash(Hash const &hash, Hash const &next_hash)
+{
+  FETCH_LOCK(mutex_);
+
+  uint64_t index{0};
+  if ((next_hash.size() != HASH_SIZE) || !Find(hash, index))
+  {
+    return false;
+  }
+
+  std::memcpy(records()[index].next_hash, next_hash.pointer(), HASH_SIZE);
+  return true;
+}
+
+/**
+ * Lookup the hash of the last block added at a given height
+ *
+ * @param block_number The height of the block
+ * @return The hash of the block if present, otherwise an empty hash
+ */
+BlockStore::Hash BlockStore::GetHashAtHeight(uint64_t block_number) const
+{
+  FETCH_LOCK(mutex_);
+
+  if (!records_.is_mapped() || (block_number >= header().height_count))
+  {
+    return {};
+  }
+
+  uint64_t entry{0};
+  std::memcpy(&entry, heights_.data() + (block_number * sizeof(uint64_t)), sizeof(entry));
+
+  if ((entry == 0) || (entry > header().count))
+  {
+    return {};
+  }
+
+  return Hash{records()[entry - 1].hash, HASH_SIZE};
+}
+
+/**
+ * Get the number of blocks in the store
+ *
+ * @return The number of stored blocks
+ */
+uint64_t BlockStore::size() const
+{
+  FETCH_LOCK(mutex_);
+  return records_.is_mapped() ? header().count : 0;
+}
+
+uint64_t BlockStore::filter_height() const
+{
+  FETCH_LOCK(mutex_);
+  return records_.is_mapped() ? header().filter_height : 0;
+}
+
+/**
+ * Record the height up to which the stored blocks have been included in an external filter which
+ * is persisted separately (the transaction bloom filter of the main chain). This allows only the
+ * more recent blocks to be added to the filter when the chain is loaded.
+ *
+ * @param block_number The height of the last block included
+ */
+void BlockStore::SetFilterHeight(uint64_t block_number)
+{
+  FETCH_LOCK(mutex_);
+
+  if (records_.is_mapped())
+  {
+    header().filter_height = block_number;
+  }
+}
+
+/**
+ * Import the chain leading to a head block from a store in the previous format, in which the block
+ * records were kept in an ObjectStore keyed on the block hash
+ *
+ * Only the blocks from genesis to the head are imported, blocks on other branches are synchronised
+ * again as required. Nothing is imported unless the complete chain is present in the previous
+ * store.
+ *
+ * @param doc_file The document file of the previous store
+ * @param index_file The index file of the previous store
+ * @param head The hash of the head block of the chain
+ * @return The number of blocks imported
+ */
+uint64_t BlockStore::Import(std::string const &doc_file, std::string const &index_file,
+                            Hash const &head)
+{
+  if (head.empty() || !FileExists(doc_file) || !FileExists(index_file))
+  {
+    return 0;
+  }
+
+  storage::ObjectStore<BlockDbRecord> legacy_store;
+  legacy_store.Load(doc_file, index_file, false);
+
+  // walk back from the head, collecting the hashes of the chain before anything is written
+  std::vector<Hash> chain{};
+  uint64_t          expected_block_number{0};
+  bool              complete{false};
+
+  BlockDbRecord record{};
+  Hash          hash = head;
+  while (legacy_store.Get(storage::ResourceID{hash}, record))
+  {
+    uint64_t const block_number = record.block.block_number;
+
+    if ((record.hash() != hash) || (!chain.empty() && (block_number != expected_block_number)))
+    {
+      break;
+    }
+
+    chain.push_back(hash);
+
+    if (block_number == 0)
+    {
+      complete = true;
+      break;
+    }
+
+    expected_block_number = block_number - 1;
+    hash                  = record.block.previous_hash;
+  }
+
+  if (!complete)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Previous block store does not hold the complete chain to the ",
+                   "head block, only found ", chain.size(), " blocks. Not importing it.");
+    return 0;
+  }
+
+  // add the blocks from genesis, each referencing the next block on the chain
+  for (std::size_t i = chain.size(); i > 0; --i)
+  {
+    if (!legacy_store.Get(storage::ResourceID{chain[i - 1]}, record))
+    {
+      throw StorageException("Unable to read block from the previous block store");
+    }
+
+    Add(record.block, (i > 1) ? chain[i - 2] : Hash{});
+  }
+
+  Flush();
+
+  return chain.size();
+}
+
+void BlockStore::Create()
+{
+  CreateFile(prefix_ + RECORDS_SUFFIX, sizeof(StoreHeader) + (INITIAL_RECORDS * sizeof(Record)));
+  CreateFile(prefix_ + HEIGHTS_SUFFIX, INITIAL_RECORDS * sizeof(uint64_t));
+  CreateFile(prefix_ + HEADERS_SUFFIX, INITIAL_DATA_SIZE);
+  CreateFile(prefix_ + BODIES_SUFFIX, INITIAL_DATA_SIZE);
+
+  records_ = MapFile(prefix_ + RECORDS_SUFFIX);
+  heights_ = MapFile(prefix_ + HEIGHTS_SUFFIX);
+  headers_ = MapFile(prefix_ + HEADERS_SUFFIX);
+  bodies_  = MapFile(prefix_ + BODIES_SUFFIX);
+
+  auto &store_header = header();
+
+  store_header               = StoreHeader{};
+  store_header.magic         = STORE_MAGIC;
+  store_header.version       = STORE_VERSION;
+  store_header.filter_height = 0;
+
+  RebuildHashIndex(INITIAL_HASH_CAPACITY);
+}
+
+void BlockStore::Close()
+{
+  Sync(headers_);
+  Sync(bodies_);
+  Sync(hashes_);
+  Sync(heights_);
+  Sync(records_);
+
+  headers_.unmap();
+  bodies_.unmap();
+  hashes_.unmap();
+  heights_.unmap();
+  records_.unmap();
+}
+
+/**
+ * Ensure that a mapped file is at least the given size, doubling its size as required
+ *
+ * @param file The mapping of the file
+ * @param suffix The suffix of the file
+ * @param size The required size in bytes
+ */
+void BlockStore::Reserve(MappedFile &file, std::string const &suffix, uint64_t size)
+{
+  if (file.size() >= size)
+  {
+    return;
+  }
+
+  uint64_t capacity = std::max<uint64_t>(file.size(), 1);
+  while (capacity < size)
+  {
+    capacity *= 2;
+  }
+
+  file.unmap();
+  ExtendFile(prefix_ + suffix, capacity);
+  file = MapFile(prefix_ + suffix);
+}
+
+BlockStore::StoreHeader &BlockStore::header()
+{
+  return *reinterpret_cast<StoreHeader *>(records_.data());
+}
+
+BlockStore::StoreHeader const &BlockStore::header() const
+{
+  return *reinterpret_cast<StoreHeader const *>(records_.data());
+}
+
+BlockStore::Record *BlockStore::records()
+{
+  return reinterpret_cast<Record *>(records_.data() + sizeof(StoreHeader));
+}
+
+BlockStore::Record const *BlockStore::records() const
+{
+  return reinterpret_cast<Record const *>(records_.data() + sizeof(StoreHeader));
+}
+
+/**
+ * Lookup the record index of a block
+ *
+ * @param hash The hash of the block
+ * @param index The output record index
+ * @return true if found, otherwise false
+ */
+bool BlockStore::Find(Hash const &hash, uint64_t &index) const
+{
+  if (!records_.is_mapped() || (hash.size() != HASH_SIZE))
+  {
+    return false;
+  }
+
+  uint64_t const key   = HashKey(hash.pointer());
+  uint64_t const mask  = (uint64_t{1} << header().hash_capacity_log2) - 1;
+  auto const *   slots = reinterpret_cast<HashSlot const *>(hashes_.data());
+
+  for (uint64_t i = 0, slot = key & mask; i <= mask; ++i, slot = (slot + 1) & mask)
+  {
+    auto const &entry = slots[slot];
+
+    if (entry.index == 0)
+    {
+      break;
+    }
+
+    // the key is only a hash prefix, so confirm against the full hash of the record
+    if ((entry.key == key) &&
+        (std::memcmp(records()[entry.index - 1].hash, hash.pointer(), HASH_SIZE) == 0))
+    {
+      index = entry.index - 1;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool BlockStore::Read(uint64_t index, BlockDbRecord &record, bool with_body) const
+{
+  auto const &entry = records()[index];
+
+  if ((entry.header_offset + entry.header_length > header().header_bytes) ||
+      (entry.body_offset + entry.body_length > header().body_bytes))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Block record ", index, " is outside of the stored data");
+    return false;
+  }
+
+  try
+  {
+    record = BlockDbRecord{};
+
+    DeserialiseHeader(
+        ConstByteArray{reinterpret_cast<uint8_t const *>(headers_.data()) + entry.header_offset,
+                       entry.header_length},
+        record.block);
+
+    if (with_body)
+    {
+      DeserialiseBody(
+          ConstByteArray{reinterpret_cast<uint8_t const *>(bodies_.data()) + entry.body_offset,
+                         entry.body_length},
+          record.block);
+    }
+
+    if (!IsZero(entry.next_hash))
+    {
+      record.next_hash = Hash{entry.next_hash, HASH_SIZE};
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to read block record ", index, ": ", ex.what());
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Append serialised data to one of the data files
+ *
+ * @param file The mapping of the data file
+ * @param suffix The suffix of the data file
+ * @param used The used size of the data file, which is updated
+ * @param data The data to be written
+ * @return The offset of the data in the file
+ */
+uint64_t BlockStore::Append(MappedFile &file, std::string const &suffix, uint64_t &used,
+                            ConstByteArray const &data)
+{
+  uint64_t const offset = used;
+
+  Reserve(file, suffix, offset + data.size());
+  std::memcpy(file.data() + offset, data.pointer(), data.size());
+
+  used = offset + data.size();
+  return offset;
+}
+
+BlockStore::HashSlot *BlockStore::hash_slots()
+{
+  return reinterpret_cast<HashSlot *>(hashes_.data());
+}
+
+void BlockStore::InsertHash(uint64_t index)
+{
+  // keep the load factor below 3/4 so that probe sequences stay short, growing includes all records
+  if ((header().count * 4) > (uint64_t{3} << header().hash_capacity_log2))
+  {
+    RebuildHashIndex(header().hash_capacity_log2 + 1);
+    return;
+  }
+
+  uint64_t const key  = HashKey(records()[index].hash);
+  uint64_t const mask = (uint64_t{1} << header().hash_capacity_log2) - 1;
+  auto *         slots = hash_slots();
+
+  uint64_t slot = key & mask;
+  while (slots[slot].index != 0)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  slots[slot] = HashSlot{key, index + 1};
+  ++header().hash_count;
+}
+
+/**
+ * Build the hash index from the records with the given capacity
+ *
+ * @param capacity_log2 The log2 of the number of slots
+ */
+void BlockStore::RebuildHashIndex(uint64_t capacity_log2)
+{
+  // ensure the capacity keeps the load factor below 3/4
+  while ((header().count * 4) > (uint64_t{3} << capacity_log2))
+  {
+    ++capacity_log2;
+  }
+
+  // mark the index as incomplete until it has been rebuilt
+  header().hash_count = 0;
+
+  hashes_.unmap();
+  CreateFile(prefix_ + HASHES_SUFFIX, sizeof(HashSlot) << capacity_log2);
+  hashes_ = MapFile(prefix_ + HASHES_SUFFIX);
+
+  header().hash_capacity_log2 = capacity_log2;
+
+  uint64_t const mask  = (uint64_t{1} << capacity_log2) - 1;
+  auto *         slots = hash_slots();
+
+  for (uint64_t index = 0, count = header().count; index < count; ++index)
+  {
+    uint64_t const key  = HashKey(records()[index].hash);
+    uint64_t       slot = key & mask;
+
+    while (slots[slot].index != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+
+    slots[slot] = HashSlot{key, index + 1};
+  }
+
+  header().hash_count = header().count;
+}
+
+void BlockStore::SetHeight(uint64_t block_number, uint64_t index)
+{
+  Reserve(heights_, HEIGHTS_SUFFIX, (block_number + 1) * sizeof(uint64_t));
+
+  uint64_t const entry = index + 1;
+  std::memcpy(heights_.data() + (block_number * sizeof(uint64_t)), &entry, sizeof(entry));
+
+  header().height_count = std::max(header().height_count, block_number + 1);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,374 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/set_thread_name.hpp"
+#include "crypto/verifier.hpp"
+#include "ledger/chain/block_verifier.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct a block verifier
+ *
+ * @param verifying_threads The number of threads verifying a batch, including the calling thread
+ * @param max_pending_transactions The maximum number of transactions being verified at once
+ * @param transactions_per_task The minimum number of transactions of a block verified by one task
+ */
+BlockVerifier::BlockVerifier(std::size_t verifying_threads, std::size_t max_pending_transactions,
+                             std::size_t transactions_per_task)
+  : max_pending_transactions_{std::max(max_pending_transactions, std::size_t{1})}
+  , transactions_per_task_{transactions_per_task}
+{
+  // the calling thread also verifies blocks from the batch
+  std::size_t const num_workers = (verifying_threads > 1) ? verifying_threads - 1 : 0;
+
+  workers_.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; ++i)
+  {
+    workers_.emplace_back([this, i]() {
+      SetThreadName("BlockVerify:", i);
+      Worker();
+    });
+  }
+}
+
+BlockVerifier::~BlockVerifier()
+{
+  {
+    Lock lock{lock_};
+    stop_ = true;
+  }
+
+  condition_.notify_all();
+
+  for (auto &worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+/**
+ * Verify the contents of a single block, updating its digest
+ *
+ * The outcome of the miner signature check is recorded on the block for the consensus checks. An
+ * invalid signature is not reported here, since whether a signature is required at all is up to
+ * the consensus.
+ *
+ * @param block The block to be verified
+ * @return The status of the block
+ */
+BlockVerifier::Status BlockVerifier::Verify(Block &block)
+{
+  // the genesis block has a fixed digest and no contents to check
+  if (block.IsGenesis())
+  {
+    return Status::VALID;
+  }
+
+  block.UpdateDigest();
+
+  if (!block.IsValid())
+  {
+    return Status::DUPLICATE_TRANSACTION;
+  }
+
+  VerifyMinerSignature(block);
+
+  return Status::VALID;
+}
+
+/**
+ * Verify the contents of a batch of blocks, updating their digests
+ *
+ * @param blocks The blocks to be verified
+ * @return The status of each block, in the same order as the blocks
+ */
+BlockVerifier::Statuses BlockVerifier::Verify(Blocks const &blocks)
+{
+  Statuses statuses(blocks.size(), Status::VALID);
+
+  if (blocks.empty())
+  {
+    return statuses;
+  }
+
+  std::lock_guard<std::mutex> batch_guard{batch_lock_};
+  Lock                        lock{lock_};
+
+  jobs_.resize(blocks.size());
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    auto &job = jobs_[i];
+
+    job.block = blocks[i].get();
+    job.cost  = std::min(job.block->GetTransactionCount(), max_pending_transactions_);
+
+    tasks_.push_back({i, PREPARE});
+  }
+
+  statuses_  = &statuses;
+  remaining_ = blocks.size();
+
+  condition_.notify_all();
+
+  // work through the batch alongside the workers
+  while (remaining_ > 0)
+  {
+    condition_.wait(lock, [this]() { return (remaining_ == 0) || CanRunNext(); });
+
+    if (remaining_ > 0)
+    {
+      RunNext(lock);
+    }
+  }
+
+  jobs_.clear();
+  statuses_ = nullptr;
+
+  return statuses;
+}
+
+void BlockVerifier::Worker()
+{
+  Lock lock{lock_};
+
+  for (;;)
+  {
+    condition_.wait(lock, [this]() { return stop_ || CanRunNext(); });
+
+    if (stop_)
+    {
+      break;
+    }
+
+    RunNext(lock);
+  }
+}
+
+/**
+ * Internal: Determine if the next task of the current batch can be run
+ *
+ * A block is only prepared when its transactions fit in the budget, a block larger than the budget
+ * once nothing else is pending. The tasks of blocks which have been prepared can always be run.
+ *
+ * @return true if there is a task which can be run, otherwise false
+ */
+bool BlockVerifier::CanRunNext() const
+{
+  if (tasks_.empty())
+  {
+    return false;
+  }
+
+  auto const &task = tasks_.front();
+  return (task.subtree != PREPARE) ||
+         ((pending_transactions_ + jobs_[task.job].cost) <= max_pending_transactions_);
+}
+
+/**
+ * Internal: Claim and run the next task of the current batch
+ *
+ * @param lock The held lock on the batch state, released while the task is run
+ */
+void BlockVerifier::RunNext(Lock &lock)
+{
+  auto const task = tasks_.front();
+  tasks_.pop_front();
+
+  Job &job = jobs_[task.job];
+
+  if (task.subtree == PREPARE)
+  {
+    pending_transactions_ += job.cost;
+    lock.unlock();
+
+    Prepare(job);
+
+    lock.lock();
+
+    // the subtrees of the block are built ahead of any blocks which are still to be prepared
+    job.remaining = job.num_subtrees;
+    for (std::size_t subtree = job.num_subtrees; subtree > 0; --subtree)
+    {
+      tasks_.push_front({task.job, subtree - 1});
+    }
+
+    condition_.notify_all();
+  }
+  else
+  {
+    lock.unlock();
+
+    BuildSubtree(job, task.subtree);
+
+    lock.lock();
+    --job.remaining;
+  }
+
+  // the last task of a block completes its verification
+  if (job.remaining > 0)
+  {
+    return;
+  }
+
+  lock.unlock();
+
+  auto const status = Complete(job);
+
+  lock.lock();
+  pending_transactions_ -= job.cost;
+  (*statuses_)[task.job] = status;
+  --remaining_;
+
+  condition_.notify_all();
+}
+
+/**
+ * Internal: Populate the transaction merkle tree of a block and split it into subtrees
+ *
+ * @param job The verification of the block
+ */
+void BlockVerifier::Prepare(Job &job) const
+{
+  Block const &block = *job.block;
+
+  // the genesis block has a fixed digest and no contents to check
+  if (block.IsGenesis())
+  {
+    return;
+  }
+
+  std::size_t const count = block.GetTransactionCount();
+
+  job.transactions = crypto::MerkleTree{count};
+  job.digests.reserve(count);
+
+  std::size_t index{0};
+  for (auto const &slice : block.slices)
+  {
+    for (auto const &layout : slice)
+    {
+      job.transactions[index++] = layout.digest();
+      job.digests.push_back(layout.digest());
+    }
+  }
+
+  job.num_subtrees = job.transactions.PrepareSubtrees(workers_.size() + 1, transactions_per_task_);
+}
+
+/**
+ * Internal: Build one subtree of the transaction merkle tree of a block and sort the digests of
+ * a range of its transactions
+ *
+ * @param job The verification of the block
+ * @param subtree The index of the subtree
+ */
+void BlockVerifier::BuildSubtree(Job &job, std::size_t subtree) const
+{
+  job.transactions.CalculateSubtree(subtree);
+
+  std::size_t const count = job.digests.size();
+  auto const        begin = job.digests.begin();
+
+  std::sort(begin + static_cast<std::ptrdiff_t>((subtree * count) / job.num_subtrees),
+            begin + static_cast<std::ptrdiff_t>(((subtree + 1) * count) / job.num_subtrees));
+}
+
+/**
+ * Internal: Complete the verification of a block once all of its subtrees have been built
+ *
+ * @param job The verification of the block
+ * @return The status of the block
+ */
+BlockVerifier::Status BlockVerifier::Complete(Job &job) const
+{
+  Block &block = *job.block;
+
+  if (block.IsGenesis())
+  {
+    return Status::VALID;
+  }
+
+  job.transactions.CompleteRoot();
+  block.UpdateDigest(job.transactions.root());
+
+  // merge the sorted runs, after which duplicate transactions are adjacent
+  std::size_t const count = job.digests.size();
+  auto const        begin = job.digests.begin();
+
+  for (std::size_t run = 1; run < job.num_subtrees; ++run)
+  {
+    std::inplace_merge(begin, begin + static_cast<std::ptrdiff_t>((run * count) / job.num_subtrees),
+                       begin + static_cast<std::ptrdiff_t>(((run + 1) * count) / job.num_subtrees));
+  }
+
+  bool const duplicates = std::adjacent_find(begin, job.digests.end()) != job.digests.end();
+
+  // release the memory of the block as soon as it is verified
+  job.transactions = crypto::MerkleTree{0};
+  Digests{}.swap(job.digests);
+
+  if (duplicates)
+  {
+    return Status::DUPLICATE_TRANSACTION;
+  }
+
+  VerifyMinerSignature(block);
+
+  return Status::VALID;
+}
+
+/**
+ * Internal: Check the miner signature of a block against its current digest, recording the outcome
+ * on the block
+ *
+ * @param block The block to be checked
+ */
+void BlockVerifier::VerifyMinerSignature(Block &block)
+{
+  if (!block.miner_signature.empty() &&
+      crypto::Verifier::Verify(block.miner_id, block.hash, block.miner_signature))
+  {
+    block.SetMinerSignatureVerified();
+  }
+}
+
+char const *ToString(BlockVerifier::Status status)
+{
+  char const *text = "Unknown";
+
+  switch (status)
+  {
+  case BlockVerifier::Status::VALID:
+    text = "Valid";
+    break;
+  case BlockVerifier::Status::DUPLICATE_TRANSACTION:
+    text = "Duplicate Transaction";
+    break;
+  }
+
+  return text;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -47,7 +47,12 @@ namespace fetch {
 namespace ledger {
 
 namespace {
+constexpr char const *BLOCK_STORE        = "chain";
 constexpr char const *BLOOM_FILTER_STORE = "chain.bloom.db";
+
+// the files of the block store in the previous format, which are imported once
+constexpr char const *LEGACY_BLOCK_STORE       = "chain.db";
+constexpr char const *LEGACY_BLOCK_STORE_INDEX = "chain.index.db";
 constexpr uint64_t    OVERLAP            = 400000;
 }  // namespace
 
@@ -115,7 +120,7 @@ void MainChain::Reset()
 
   if (block_store_)
   {
-    block_store_->New("chain.db", "chain.index.db");
+    block_store_->New(BLOCK_STORE);
     head_store_.close();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
@@ -307,6 +312,9 @@ void MainChain::CacheBlock(BlockPtr const &block) const
 {
   ASSERT(static_cast<bool>(block));
 
+  // cached blocks are kept for a long time, they should not keep the buffers they were received in
+  block->DetachFromBuffer();
+
   auto const &hash = block->hash;
   auto        ret_val{block_chain_.emplace(hash, block)};
 
@@ -343,40 +351,28 @@ void MainChain::KeepBlock(BlockPtr const &block) const
 
   auto const &hash{block->hash};
 
-  DbRecord record;
-
-  if (!block->IsGenesis())
+  // notify stored parent, only its forward reference is updated
+  if (!block->IsGenesis() && block_store_->SetNextHash(block->previous_hash, hash))
   {
-    // notify stored parent
-    if (block_store_->Get(storage::ResourceID(block->previous_hash), record))
-    {
-      if (record.next_hash != hash)
-      {
-        record.next_hash = hash;
-        block_store_->Set(storage::ResourceID(record.hash()), record);
-      }
-      // before checking for this block's children in storage, reset next_hash to genesis
-      record.next_hash = Digest{};
-      CacheReference(block->previous_hash, hash, true);
-    }
+    CacheReference(block->previous_hash, hash, true);
   }
-  record.block = *block;
 
   // detect if any of this block's children has made it to the store already
-  auto forward_refs{forward_references_.equal_range(hash)};
+  BlockHash next_hash{};
+  auto      forward_refs{forward_references_.equal_range(hash)};
   for (auto ref_it{forward_refs.first}; ref_it != forward_refs.second; ++ref_it)
   {
     auto const &child{ref_it->second};
-    if (block_store_->Has(storage::ResourceID(child)))
+    if (block_store_->Has(child))
     {
-      record.next_hash = child;
+      next_hash = child;
       CacheReference(hash, child, true);
       break;
     }
   }
 
-  // now write the block itself; if next_hash is genesis, it will be rewritten later by a child
-  block_store_->Set(storage::ResourceID(hash), record);
+  // now write the block itself; if next_hash is empty, it will be rewritten later by a child
+  block_store_->Add(*block, next_hash);
 }
 
 /**
@@ -391,7 +387,7 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   assert(static_cast<bool>(block_store_));
 
   DbRecord record;
-  if (block_store_->Get(storage::ResourceID(hash), record))
+  if (block_store_->Get(hash, record))
   {
     block = record.block;
     AddBlockToBloomFilter(block);
@@ -415,6 +411,27 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   return false;
 }
 
+/**
+ * Internal: load a block from the permanent store without its slices
+ *
+ * @param[in]  hash The hash of the block to be loaded
+ * @param[out] block The location of block
+ * @return True iff the block is found in the storage
+ */
+bool MainChain::LoadBlockHeader(BlockHash const &hash, Block &block) const
+{
+  assert(static_cast<bool>(block_store_));
+
+  DbRecord record;
+  if (block_store_->GetHeader(hash, record))
+  {
+    block = record.block;
+    return true;
+  }
+
+  return false;
+}
+
 void MainChain::AddBlockToBloomFilter(Block const &block) const
 {
   for (auto const &slice : block.slices)
@@ -996,16 +1013,16 @@ MainChain::BlockHashSet MainChain::GetTips() const
  */
 void MainChain::RecoverFromFile(Mode mode)
 {
-  // TODO(private issue 667): Complete loading of chain on startup ill-advised
-
   assert(static_cast<bool>(block_store_));
 
   FETCH_LOCK(lock_);
 
+  bool bloom_filter_loaded{false};
+
   // load the database files
   if (Mode::CREATE_PERSISTENT_DB == mode)
   {
-    block_store_->New("chain.db", "chain.index.db");
+    block_store_->New(BLOCK_STORE);
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
 
@@ -1019,9 +1036,38 @@ void MainChain::RecoverFromFile(Mode mode)
   {
     using namespace fetch::serializers;
 
-    block_store_->Load("chain.db", "chain.index.db");
+    try
+    {
+      block_store_->Load(BLOCK_STORE);
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Failed to load block store! Reason: ", e.what());
+      block_store_->New(BLOCK_STORE);
+    }
+
     head_store_.open("chain.head.db", std::ios::binary | std::ios::in | std::ios::out);
 
+    // a node upgraded from the previous store format does not have to synchronise the chain again
+    if (block_store_->size() == 0)
+    {
+      try
+      {
+        auto const imported =
+            block_store_->Import(LEGACY_BLOCK_STORE, LEGACY_BLOCK_STORE_INDEX, GetHeadHash());
+
+        if (imported > 0)
+        {
+          FETCH_LOG_INFO(LOGGING_NAME, "Imported ", imported, " blocks from ", LEGACY_BLOCK_STORE,
+                         ", which can now be removed");
+        }
+      }
+      catch (std::exception const &e)
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Failed to import previous block store! Reason: ", e.what());
+      }
+    }
+
     std::ifstream in(BLOOM_FILTER_STORE, std::ios::binary | std::ios::in);
 
     if (in.is_open())
@@ -1033,6 +1079,7 @@ void MainChain::RecoverFromFile(Mode mode)
         LargeObjectSerializeHelper buffer{bloom_filter_data};
 
         buffer >> bloom_filter_;
+        bloom_filter_loaded = true;
       }
       catch (std::exception const &e)
       {
@@ -1052,32 +1099,29 @@ void MainChain::RecoverFromFile(Mode mode)
   bool recovery_complete{false};
   if (!head_block_hash.empty() && LoadBlock(head_block_hash, *head))
   {
-    auto block_index = head->block_number;
-
-    // Copy head block so as to walk down the chain
-    BlockPtr next = std::make_shared<Block>(*head);
-
-    while (LoadBlock(next->previous_hash, *next))
-    {
-      if (next->block_number != block_index - 1)
-      {
-        FETCH_LOG_WARN(LOGGING_NAME,
-                       "Discontinuity found when walking main chain during recovery. Current: ",
-                       block_index, " prev: ", next->block_number, " Resetting");
-        break;
-      }
-
-      block_index = next->block_number;
-    }
-
-    if (block_index != 0)
+    // the stored chain is only ever extended from the head to an already stored block, so the
+    // height index records the complete chain leading to the head without having to walk it
+    if ((block_store_->GetHashAtHeight(head->block_number) != head->hash) ||
+        (block_store_->GetHashAtHeight(0) != chain::GetGenesisDigest()))
     {
       FETCH_LOG_WARN(LOGGING_NAME,
-                     "Failed to walk main chain when recovering from disk. Got as far back as: ",
-                     block_index, ". Resetting.");
+                     "Stored main chain does not lead from genesis to the head block: ",
+                     head->block_number, ". Resetting.");
     }
     else
     {
+      // add the blocks stored since the Bloom filter was last written
+      uint64_t const first_block = bloom_filter_loaded ? block_store_->filter_height() + 1 : 0;
+
+      for (uint64_t block_number = first_block; block_number < head->block_number; ++block_number)
+      {
+        Block block{};
+        if (!LoadBlock(block_store_->GetHashAtHeight(block_number), block))
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, "Unable to load stored block: ", block_number);
+        }
+      }
+
       FETCH_LOG_INFO(LOGGING_NAME,
                      "Recovering main chain with heaviest block: ", head->block_number);
 
@@ -1115,7 +1159,7 @@ void MainChain::RecoverFromFile(Mode mode)
   // Recovering the chain has failed in some way, reset the storage.
   if (!recovery_complete)
   {
-    block_store_->New("chain.db", "chain.index.db");
+    block_store_->New(BLOCK_STORE);
 
     // reopen the file and clear the contents
     head_store_.close();
@@ -1178,7 +1222,7 @@ void MainChain::WriteToFile()
       BlockPtr current_file_head = std::make_shared<Block>();
       BlockPtr block_head        = block;
 
-      LoadBlock(GetHeadHash(), *current_file_head);
+      LoadBlockHeader(GetHeadHash(), *current_file_head);
 
       // Now keep adding the block and its prev to the file until we are certain the file contains
       // an unbroken chain. Assuming that the current_file_head is unbroken we can write until we
@@ -1190,7 +1234,7 @@ void MainChain::WriteToFile()
         // Keep the current_file_head one block behind
         while (current_file_head->block_number > block->block_number - 1)
         {
-          LoadBlock(current_file_head->previous_hash, *current_file_head);
+          LoadBlockHeader(current_file_head->previous_hash, *current_file_head);
         }
 
         // Successful case
@@ -1672,9 +1716,6 @@ bool MainChain::LookupBlockFromStorage(BlockHash const &hash, BlockPtr &block,
 
     if (success)
     {
-      // hash not serialised, needs to be recomputed
-      output_block->UpdateDigest();
-
       // update the returned shared pointer
       block = std::move(output_block);
     }
@@ -2055,11 +2096,6 @@ void MainChain::FlushToDisk(bool flush_bloom)
 {
   using namespace fetch::serializers;
 
-  if (block_store_)
-  {
-    block_store_->Flush(false);
-  }
-
   if (flush_bloom && (mode_ != Mode::IN_MEMORY_DB))
   {
     try
@@ -2069,12 +2105,24 @@ void MainChain::FlushToDisk(bool flush_bloom)
       buffer << bloom_filter_;
 
       out << buffer.data();
+
+      // every stored block up to the head is now included in the filter on disk
+      DbRecord head{};
+      if (block_store_ && out && block_store_->GetHeader(GetHeadHash(), head))
+      {
+        block_store_->SetFilterHeight(head.block.block_number);
+      }
     }
     catch (std::exception const &e)
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Failed to save Bloom filter to file, reason: ", e.what());
     }
   }
+
+  if (block_store_)
+  {
+    block_store_->Flush();
+  }
 }
 
 }  // namespace ledger
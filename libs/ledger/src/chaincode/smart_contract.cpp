@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/constants.hpp"
 #include "chain/transaction.hpp"
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
@@ -500,7 +501,10 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
 
   std::stringstream console;
   vm->AttachOutputDevice(vm::VM::STDOUT, console);
+  bool const paged_state = context().block_index >= chain::PAGED_STATE_ACTIVATION_HEIGHT;
+  state().EnablePagedState(paged_state);
   vm->SetIOObserver(state());
+  vm->EnablePagedState(paged_state);
 
   std::unordered_set<chain::Address> call_history{tx.contract_address()};
   vm::ContractInvocationHandler      contract_invocation_handler;
@@ -575,6 +579,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
     std::vector<std::string> errors{};
 
     vm2.SetIOObserver(vm->GetIOObserver());
+    vm2.EnablePagedState(vm->IsPagedStateEnabled());
     vm2.SetContractInvocationHandler(contract_invocation_handler);
     vm2.AttachOutputDevice(fetch::vm::VM::STDOUT, vm->GetOutputDevice(fetch::vm::VM::STDOUT));
 
@@ -684,7 +689,10 @@ Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
   // vm->SetChargeLimit(123);
   // vm->UpdateCharges({});
 
+  bool const paged_state = context().block_index >= chain::PAGED_STATE_ACTIVATION_HEIGHT;
+  state().EnablePagedState(paged_state);
   vm->SetIOObserver(state());
+  vm->EnablePagedState(paged_state);
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Running SC init function: ", init_fn_name_);
 
@@ -741,7 +749,11 @@ SmartContract::Status SmartContract::InvokeQuery(std::string const &name, Query
 {
   // get clean VM instance
   auto vm = std::make_unique<vm::VM>(module_.get());
+
+  // queries only read the latest state, in which values may already be stored in pages
+  state().EnablePagedState(true);
   vm->SetIOObserver(state());
+  vm->EnablePagedState(true);
 
   // look up the executable
   auto const target_function = executable_->FindFunction(name);
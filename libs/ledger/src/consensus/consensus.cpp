@@ -696,7 +696,9 @@ bool BlockSignedByQualMember(fetch::ledger::Block const &block)
     return false;
   }
 
-  return fetch::crypto::Verifier::Verify(block.miner_id, block.hash, block.miner_signature);
+  // the signature may already have been checked when the block contents were verified
+  return block.IsMinerSignatureVerified() ||
+         fetch::crypto::Verifier::Verify(block.miner_id, block.hash, block.miner_signature);
 }
 
 /**
@@ -38,9 +38,11 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <stdexcept>
+#include <thread>
 
 namespace fetch {
 namespace ledger {
@@ -67,6 +69,7 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
   , chain_(chain)
   , trust_(trust)
   , consensus_(std::move(consensus))
+  , block_verifier_(std::max(std::size_t{1}, std::size_t{std::thread::hardware_concurrency()}))
   , block_subscription_(endpoint.Subscribe(SERVICE_MAIN_CHAIN, CHANNEL_BLOCKS))
   , main_chain_protocol_(chain_)
   , rpc_client_(rpc_client)
@@ -151,8 +154,18 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
     Block block;
     serialiser >> block;
 
-    // recalculate the block hash
-    block.UpdateDigest();
+    // recalculate the block hash and check the contents of the block
+    auto const status = BlockVerifier::Verify(block);
+    if (status != BlockVerifier::Status::VALID)
+    {
+      recv_block_count_->increment();
+      recv_block_invalid_count_->increment();
+
+      FETCH_LOG_WARN(LOGGING_NAME, "Invalid block: #", block.block_number, " 0x",
+                     block.hash.ToHex(), " (from peer: ", ToBase64(from),
+                     " reason: ", ToString(status), ")");
+      return;
+    }
 
     // dispatch the event
     OnNewBlock(from, block, transmitter);
@@ -259,19 +272,31 @@ void MainChainRpcService::HandleChainResponse(Address const &address, Begin begi
 {
   std::map<BlockStatus, std::size_t> status_stats;
 
+  // collect the blocks to be added, skipping the genesis block
+  Blocks blocks{};
   for (auto it = begin; it != end; ++it)
   {
-    auto block = *it;
+    if (!(*it)->IsGenesis())
+    {
+      blocks.push_back(*it);
+    }
+  }
 
-    // skip the genesis block
-    if (block->IsGenesis())
+  // recompute the digests and verify the contents of all the blocks in parallel
+  auto const verify_statuses = block_verifier_.Verify(blocks);
+
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    auto const &block = blocks[i];
+
+    if (verify_statuses[i] != BlockVerifier::Status::VALID)
     {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Synced invalid block 0x", block->hash.ToHex(), " (",
+                      ToString(verify_statuses[i]), ") from muddle://", ToBase64(address));
+      ++status_stats[BlockStatus::INVALID];
       continue;
     }
 
-    // recompute the digest
-    block->UpdateDigest();
-
     // add the block
     if (!ValidBlock(*block))
     {
@@ -281,10 +306,10 @@ void MainChainRpcService::HandleChainResponse(Address const &address, Begin begi
       continue;
     }
 
-    auto const status = chain_.AddBlock(std::move(block));
+    auto const status = chain_.AddBlock(block);
 
     ++status_stats[status];
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Sync: ", ToString(status), " block 0x", (*it)->hash.ToHex(),
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Sync: ", ToString(status), " block 0x", block->hash.ToHex(),
                     " from muddle://", ToBase64(address));
   }
 
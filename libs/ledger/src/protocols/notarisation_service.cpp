@@ -20,6 +20,7 @@
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/protocols/notarisation_service.hpp"
 
+#include <map>
 #include <memory>
 
 namespace fetch {
@@ -202,37 +203,55 @@ NotarisationService::State NotarisationService::OnVerifyNotarisations()
         notarisation_unit = previous_notarisation_unit_;
       }
 
-      // Add signature shares for this particular block hash
-      for (auto const &address_sig_pairs : block_hash_sigs.second)
+      // Add signature shares for this particular block hash. Shares are verified in batches of
+      // the size still needed to reach the threshold
+      auto       share_it  = block_hash_sigs.second.begin();
+      auto const share_end = block_hash_sigs.second.end();
+      while (existing_notarisations.size() < notarisation_unit->threshold() &&
+             share_it != share_end)
       {
-        // Verify and add signature if we do not have an existing signature from this qual member
-        if (existing_notarisations.find(address_sig_pairs.first) == existing_notarisations.end())
+        std::map<MuddleAddress, Signature> batch;
+        for (; share_it != share_end &&
+               existing_notarisations.size() + batch.size() < notarisation_unit->threshold();
+             ++share_it)
         {
-          SignedNotarisation signed_not = address_sig_pairs.second;
+          // Verify and add signature if we do not have an existing signature from this qual member
+          if (existing_notarisations.find(share_it->first) != existing_notarisations.end())
+          {
+            continue;
+          }
+
+          SignedNotarisation const &signed_not = share_it->second;
           // Verify ecdsa signature
           if (crypto::Verify(
-                  address_sig_pairs.first,
+                  share_it->first,
                   (serializers::MsgPackSerializer() << block_hash << signed_not.notarisation_share)
                       .data(),
                   signed_not.ecdsa_signature))
           {
-            // Verify notarisation
-            if (notarisation_unit->Verify(block_hash, signed_not.notarisation_share,
-                                          address_sig_pairs.first))
-            {
-              FETCH_LOG_DEBUG(LOGGING_NAME, "Added notarisation from node ",
-                              notarisation_unit->Index(address_sig_pairs.first));
-              existing_notarisations[address_sig_pairs.first] = address_sig_pairs.second;
-            }
+            batch.emplace(share_it->first, signed_not.notarisation_share);
           }
         }
-        // If we have collected enough notarisations for this block hash then move onto next hash
-        if (existing_notarisations.size() == notarisation_unit->threshold())
+
+        // Verify notarisations
+        auto const invalid_members = notarisation_unit->FindInvalidShares(block_hash, batch);
+        for (auto const &member_share : batch)
         {
-          can_verify.insert(block_hash);
-          break;
+          if (invalid_members.find(member_share.first) == invalid_members.end())
+          {
+            FETCH_LOG_DEBUG(LOGGING_NAME, "Added notarisation from node ",
+                            notarisation_unit->Index(member_share.first));
+            existing_notarisations[member_share.first] =
+                block_hash_sigs.second.at(member_share.first);
+          }
         }
       }
+
+      // If we have collected enough notarisations for this block hash then move onto next hash
+      if (existing_notarisations.size() == notarisation_unit->threshold())
+      {
+        can_verify.insert(block_hash);
+      }
     }
   }  // Mutex unlocks here since verification can take some time
 
@@ -20,6 +20,7 @@
 #include "ledger/state_adapter.hpp"
 #include "logging/logging.hpp"
 #include "storage/resource_mapper.hpp"
+#include "vm/paged_state.hpp"
 
 using fetch::storage::ResourceAddress;
 using fetch::byte_array::ConstByteArray;
@@ -64,7 +65,7 @@ StateAdapter::Status StateAdapter::Read(std::string const &key, void *data, uint
   Status status{Status::ERROR};
 
   // make the request to the storage engine
-  auto const result = storage_.Get(CreateAddress(CurrentScope(), key));
+  auto const result = storage_.Get(CreateAddress(CurrentScope(), key, paged_state_));
 
   // ensure the check was not found
   if (!result.failed)
@@ -90,6 +91,29 @@ StateAdapter::Status StateAdapter::Read(std::string const &key, void *data, uint
   return status;
 }
 
+/**
+ * Read a value from the state store, returning the stored document without copying it
+ *
+ * @param key The key to be accessed
+ * @param value The output value
+ * @return OK if the read was successful, otherwise ERROR
+ */
+StateAdapter::Status StateAdapter::Get(std::string const &key, ConstByteArray &value)
+{
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Get: ", key);
+
+  auto const result = storage_.Get(CreateAddress(CurrentScope(), key, paged_state_));
+
+  if (result.failed)
+  {
+    return Status::ERROR;
+  }
+
+  value = result.document;
+
+  return Status::OK;
+}
+
 /**
  * Write a value to the state store
  *
@@ -112,7 +136,7 @@ StateAdapter::Status StateAdapter::Write(std::string const &key, void const *dat
   auto write_val = ConstByteArray{reinterpret_cast<uint8_t const *>(data), size};
 
   // set the value on the storage engine
-  storage_.Set(CreateAddress(CurrentScope(), key), write_val);
+  storage_.Set(CreateAddress(CurrentScope(), key, paged_state_), write_val);
 
   return Status::OK;
 }
@@ -127,7 +151,7 @@ StateAdapter::Status StateAdapter::Write(std::string const &key, void const *dat
 StateAdapter::Status StateAdapter::Exists(std::string const &key)
 {
   // request the result
-  auto const result = storage_.Get(CreateAddress(CurrentScope(), key));
+  auto const result = storage_.Get(CreateAddress(CurrentScope(), key, paged_state_));
 
   if (result.failed)
   {
@@ -142,12 +166,22 @@ StateAdapter::Status StateAdapter::Exists(std::string const &key)
  *
  * @param scope The contract context for the state variable
  * @param key The input key to be converted
+ * @param paged_state Whether the key may refer to a page of a paged state value
  * @return The generated resource address for this key
  */
-ResourceAddress StateAdapter::CreateAddress(ConstByteArray const &scope, ConstByteArray const &key)
+ResourceAddress StateAdapter::CreateAddress(ConstByteArray const &scope, ConstByteArray const &key,
+                                            bool paged_state)
 {
   FETCH_LOG_DEBUG("StateAdapter", "Creating address for key: ", key, " scope: ", scope);
 
+  // the pages of a paged state value are kept in the same lane as the value itself, so that they
+  // are covered by the same shard mask
+  std::string name;
+  if (paged_state && vm::StatePages::ParsePageKey(static_cast<std::string>(key), name))
+  {
+    return ResourceAddress{scope + ".state." + key, ResourceAddress{scope + ".state." + name}};
+  }
+
   return ResourceAddress{scope + ".state." + key};
 }
 
@@ -161,6 +195,18 @@ void StateAdapter::PopContext()
   scope_.pop_back();
 }
 
+/**
+ * Enable the grouping of page keys with the value they belong to. This must follow the paged
+ * state setting of the VM, since before paged state is enabled such keys are ordinary state
+ * names which are addressed as they always have been.
+ *
+ * @param enabled Whether paged state is enabled
+ */
+void StateAdapter::EnablePagedState(bool enabled)
+{
+  paged_state_ = enabled;
+}
+
 StateAdapter::ConstByteArray StateAdapter::CurrentScope() const
 {
   return scope_.back();
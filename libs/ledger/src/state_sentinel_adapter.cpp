@@ -93,6 +93,35 @@ StateSentinelAdapter::Status StateSentinelAdapter::Read(std::string const &key,
   return status;
 }
 
+/**
+ * Read a value from the state store, returning the stored document without copying it
+ *
+ * @param key The key to be accessed
+ * @param value The output value
+ * @return OK if the read was successful, PERMISSION_DENIED if the key is incorrect, otherwise ERROR
+ */
+StateSentinelAdapter::Status StateSentinelAdapter::Get(std::string const &key,
+                                                       ConstByteArray &   value)
+{
+  if (!IsAllowedResource(key))
+  {
+    return Status::PERMISSION_DENIED;
+  }
+
+  // proxy the call the the state adapter
+  auto const status = StateAdapter::Get(key, value);
+
+  // update the counters
+  if (Status::OK == status)
+  {
+    bytes_read_ += value.size();
+  }
+
+  ++lookups_;
+
+  return status;
+}
+
 /**
  * Write a value to the state store
  *
@@ -107,8 +136,8 @@ StateSentinelAdapter::Status StateSentinelAdapter::Write(std::string const &key,
 {
   if (!IsAllowedResource(key))
   {
-    FETCH_LOG_WARN(LOGGING_NAME,
-                   "Unable to write to resource: ", CreateAddress(CurrentScope(), key).address());
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to write to resource: ",
+                   CreateAddress(CurrentScope(), key, paged_state_).address());
     return Status::PERMISSION_DENIED;
   }
 
@@ -155,7 +184,7 @@ StateSentinelAdapter::Status StateSentinelAdapter::Exists(std::string const &key
 bool StateSentinelAdapter::IsAllowedResource(std::string const &key) const
 {
   // build the associated resources address
-  auto const address = CreateAddress(CurrentScope(), key);
+  auto const address = CreateAddress(CurrentScope(), key, paged_state_);
 
   // determine which shard this resource is mapped to
   auto const mapped_shard = address.lane(shards_.log2_size());
@@ -153,6 +153,9 @@ void LaneService::StartInternal()
   external_muddle_->Start({cfg_.external_port});
   internal_muddle_->Start({cfg_.internal_port});
 
+  // storage unit clients in this process can bypass the internal muddle
+  internal_rpc_server_->EnableLocalCalls();
+
   tx_sync_service_->Start();
 
   // TX Sync service - attach to reactor once #892 is merged
@@ -174,6 +177,9 @@ void LaneService::StartExternal()
   external_muddle_->Start({cfg_.external_port});
   internal_muddle_->Start({cfg_.internal_port});
 
+  // storage unit clients in this process can bypass the internal muddle
+  internal_rpc_server_->EnableLocalCalls();
+
   tx_sync_service_->Start();
 
   // TX Sync service - attach to reactor once #892 is merged
@@ -196,6 +202,7 @@ void LaneService::StopExternal()
 void LaneService::StopInternal()
 {
   reactor_.Stop();
+  internal_rpc_server_->DisableLocalCalls();
   internal_muddle_->Stop();
   state_db_protocol_.reset();
   state_db_.reset();
@@ -457,8 +457,30 @@ void StorageUnitClient::IssueCallForMissingTxs(DigestSet const &digest_set)
 
 StorageUnitClient::Document StorageUnitClient::GetOrCreate(ResourceAddress const &key)
 {
+  auto const &address = LookupAddress(key);
+
+  // lanes that live in this process are called directly
+  try
+  {
+    auto local = rpc_client_->CallLocal<RevertibleDocumentStoreProtocol::GetOrCreateSignature>(
+        address, RPC_STATE, RevertibleDocumentStoreProtocol::GET_OR_CREATE, key.as_resource_id());
+
+    if (local.handled)
+    {
+      return local.value;
+    }
+  }
+  catch (std::exception const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to get or create document, because: ", e.what());
+
+    Document doc;
+    doc.failed = true;
+    return doc;
+  }
+
   // make the request to the RPC client
-  auto promise = rpc_client_->CallSpecificAddress(LookupAddress(key), RPC_STATE,
+  auto promise = rpc_client_->CallSpecificAddress(address, RPC_STATE,
                                                   RevertibleDocumentStoreProtocol::GET_OR_CREATE,
                                                   key.as_resource_id());
 
@@ -475,9 +497,31 @@ StorageUnitClient::Document StorageUnitClient::GetOrCreate(ResourceAddress const
 
 StorageUnitClient::Document StorageUnitClient::Get(ResourceAddress const &key) const
 {
+  auto const &address = LookupAddress(key);
+
+  // lanes that live in this process are called directly
+  try
+  {
+    auto local = rpc_client_->CallLocal<RevertibleDocumentStoreProtocol::GetSignature>(
+        address, RPC_STATE, RevertibleDocumentStoreProtocol::GET, key.as_resource_id());
+
+    if (local.handled)
+    {
+      return local.value;
+    }
+  }
+  catch (std::exception const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to get document, because: ", e.what());
+
+    Document doc;
+    doc.failed = true;
+    return doc;
+  }
+
   // make the request to the RPC server
   auto promise = rpc_client_->CallSpecificAddress(
-      LookupAddress(key), RPC_STATE, fetch::storage::RevertibleDocumentStoreProtocol::GET,
+      address, RPC_STATE, fetch::storage::RevertibleDocumentStoreProtocol::GET,
       key.as_resource_id());
 
   // wait for the document response
@@ -497,9 +541,20 @@ void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
 {
   try
   {
+    auto const &address = LookupAddress(key);
+
+    // lanes that live in this process are called directly
+    auto const local = rpc_client_->CallLocal<RevertibleDocumentStoreProtocol::SetSignature>(
+        address, RPC_STATE, RevertibleDocumentStoreProtocol::SET, key.as_resource_id(), value);
+
+    if (local.handled)
+    {
+      return;
+    }
+
     // make the request to the RPC server
     auto promise = rpc_client_->CallSpecificAddress(
-        LookupAddress(key), RPC_STATE, fetch::storage::RevertibleDocumentStoreProtocol::SET,
+        address, RPC_STATE, fetch::storage::RevertibleDocumentStoreProtocol::SET,
         key.as_resource_id(), value);
 
     // wait for the response
@@ -517,8 +572,20 @@ bool StorageUnitClient::Lock(ShardIndex index)
 
   try
   {
+    auto const &address = LookupAddress(index);
+
+    // lanes that live in this process are called directly
+    auto const local =
+        rpc_client_->CallLocalWithClientContext<RevertibleDocumentStoreProtocol::LockSignature>(
+            address, RPC_STATE, RevertibleDocumentStoreProtocol::LOCK);
+
+    if (local.handled)
+    {
+      return local.value;
+    }
+
     // make the request to the RPC server
-    auto promise = rpc_client_->CallSpecificAddress(LookupAddress(index), RPC_STATE,
+    auto promise = rpc_client_->CallSpecificAddress(address, RPC_STATE,
                                                     RevertibleDocumentStoreProtocol::LOCK);
 
     // wait for the promise
@@ -538,8 +605,20 @@ bool StorageUnitClient::Unlock(ShardIndex index)
 
   try
   {
+    auto const &address = LookupAddress(index);
+
+    // lanes that live in this process are called directly
+    auto const local =
+        rpc_client_->CallLocalWithClientContext<RevertibleDocumentStoreProtocol::UnlockSignature>(
+            address, RPC_STATE, RevertibleDocumentStoreProtocol::UNLOCK);
+
+    if (local.handled)
+    {
+      return local.value;
+    }
+
     // make the request to the RPC server
-    auto promise = rpc_client_->CallSpecificAddress(LookupAddress(index), RPC_STATE,
+    auto promise = rpc_client_->CallSpecificAddress(address, RPC_STATE,
                                                     RevertibleDocumentStoreProtocol::UNLOCK);
 
     // wait for the result
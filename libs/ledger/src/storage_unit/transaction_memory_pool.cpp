@@ -30,7 +30,12 @@ namespace ledger {
 void TransactionMemoryPool::Add(chain::Transaction const &tx)
 {
   FETCH_LOCK(lock_);
-  transaction_store_[tx.digest()] = tx;
+
+  // pooled transactions are kept until they are archived, they should not keep the buffers they
+  // were received in
+  auto &stored = transaction_store_[tx.digest()];
+  stored       = tx;
+  stored.DetachFromBuffer();
 }
 
 /**
@@ -0,0 +1,792 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_rpc_serializers.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/fnv_detail.hpp"
+#include "ledger/storage_unit/transaction_segment_store.hpp"
+#include "logging/logging.hpp"
+#include "storage/storage_exception.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using storage::StorageException;
+
+constexpr char const *LOGGING_NAME = "TxSegmentStore";
+
+constexpr uint64_t INDEX_MAGIC           = 0x5844495447455346;  // "FSEGTIDX"
+constexpr uint64_t DIGEST_SIZE           = 32;
+constexpr uint64_t OFFSET_BITS           = 40;
+constexpr uint64_t OFFSET_MASK           = (uint64_t{1} << OFFSET_BITS) - 1;
+constexpr uint64_t RECORD_ALIGNMENT      = 8;
+constexpr uint64_t MAX_SEGMENT_SIZE      = uint64_t{1} << 32u;
+constexpr uint64_t MIN_SEGMENT_SIZE      = uint64_t{1} << 12u;
+
+struct RecordHeader
+{
+  uint32_t length;    ///< The length of the serialised transaction, zero marks the end of a segment
+  uint32_t checksum;  ///< The checksum over the length, digest and serialised transaction
+};
+
+constexpr uint64_t RECORD_OVERHEAD = sizeof(RecordHeader) + DIGEST_SIZE;
+
+uint64_t EncodeLocation(uint64_t segment, uint64_t offset)
+{
+  return ((segment + 1) << OFFSET_BITS) | offset;
+}
+
+uint64_t LocationSegment(uint64_t location)
+{
+  return (location >> OFFSET_BITS) - 1;
+}
+
+uint64_t LocationOffset(uint64_t location)
+{
+  return location & OFFSET_MASK;
+}
+
+uint64_t RecordSize(uint64_t payload_length)
+{
+  return (RECORD_OVERHEAD + payload_length + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+/**
+ * Dirty pages of a mapping can reach the disk in any order, so a non zero length alone does not
+ * show that the rest of the record was persisted. Recovery only accepts records whose checksum
+ * matches their contents.
+ */
+uint32_t RecordChecksum(uint32_t length, uint8_t const *digest, uint8_t const *payload)
+{
+  crypto::detail::FNV<crypto::detail::FNVConfig<uint32_t>> hasher;
+  hasher.update(reinterpret_cast<uint8_t const *>(&length), sizeof(length));
+  hasher.update(digest, DIGEST_SIZE);
+  hasher.update(payload, length);
+  return hasher.context();
+}
+
+uint64_t DigestKey(uint8_t const *digest)
+{
+  uint64_t key{0};
+  std::memcpy(&key, digest, sizeof(key));
+  return key;
+}
+
+uint64_t ReverseBits(uint64_t value)
+{
+  value = ((value >> 1u) & 0x5555555555555555ull) | ((value & 0x5555555555555555ull) << 1u);
+  value = ((value >> 2u) & 0x3333333333333333ull) | ((value & 0x3333333333333333ull) << 2u);
+  value = ((value >> 4u) & 0x0F0F0F0F0F0F0F0Full) | ((value & 0x0F0F0F0F0F0F0F0Full) << 4u);
+  value = ((value >> 8u) & 0x00FF00FF00FF00FFull) | ((value & 0x00FF00FF00FF00FFull) << 8u);
+  value = ((value >> 16u) & 0x0000FFFF0000FFFFull) | ((value & 0x0000FFFF0000FFFFull) << 16u);
+  return (value >> 32u) | (value << 32u);
+}
+
+/**
+ * Subtree prefixes are matched least significant bit first, in the same way as storage::Key.
+ * Bit reversing the key therefore maps each subtree onto a contiguous range of slots.
+ */
+uint64_t HomeSlot(uint64_t key, uint64_t capacity_log2)
+{
+  return ReverseBits(key) >> (64u - capacity_log2);
+}
+
+bool MatchesPrefix(uint8_t const *digest, uint8_t const *prefix, uint64_t bit_count)
+{
+  for (uint64_t offset = 0; bit_count > 0; offset += sizeof(uint64_t))
+  {
+    uint64_t const bits = std::min<uint64_t>(bit_count, 64);
+    uint64_t const mask = (bits == 64) ? ~uint64_t{0} : ((uint64_t{1} << bits) - 1);
+
+    if (((DigestKey(digest + offset) ^ DigestKey(prefix + offset)) & mask) != 0)
+    {
+      return false;
+    }
+
+    bit_count -= bits;
+  }
+
+  return true;
+}
+
+bool FileExists(std::string const &path)
+{
+  std::ifstream file(path);
+  return file.good();
+}
+
+void CreateFile(std::string const &path, uint64_t size)
+{
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  file.seekp(static_cast<std::streamoff>(size - 1));
+  file.put('\0');
+
+  if (!file)
+  {
+    throw StorageException("Unable to create transaction archive file");
+  }
+}
+
+mio::mmap_sink MapFile(std::string const &path)
+{
+  std::error_code error;
+  auto            mapping = mio::make_mmap_sink(path, 0, mio::map_entire_file, error);
+
+  if (error)
+  {
+    throw StorageException("Unable to map transaction archive file");
+  }
+
+  return mapping;
+}
+
+void Sync(mio::mmap_sink &mapping)
+{
+  std::error_code error;
+  mapping.sync(error);
+
+  if (error)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to sync transaction archive: ", error.message());
+  }
+}
+
+}  // namespace
+
+/**
+ * Construct the transaction archive
+ *
+ * @param segment_size The size in bytes of each segment file
+ * @param index_capacity_log2 The log2 of the number of slots in a newly created index
+ */
+TransactionSegmentStore::TransactionSegmentStore(uint64_t segment_size,
+                                                 uint64_t index_capacity_log2)
+  : segment_size_{segment_size}
+  , index_capacity_log2_{index_capacity_log2}
+{
+  if (segment_size_ < MIN_SEGMENT_SIZE || segment_size_ > MAX_SEGMENT_SIZE)
+  {
+    throw StorageException("Invalid transaction archive segment size");
+  }
+
+  if (index_capacity_log2_ < 1 || index_capacity_log2_ > 48)
+  {
+    throw StorageException("Invalid transaction archive index capacity");
+  }
+}
+
+TransactionSegmentStore::~TransactionSegmentStore()
+{
+  FETCH_LOCK(mutex_);
+  Close();
+}
+
+/**
+ * Create a new (empty) archive, removing any previous one
+ *
+ * @param doc_file The prefix for the segment files
+ * @param index_file The filename for the index file
+ */
+void TransactionSegmentStore::New(std::string const &doc_file, std::string const &index_file,
+                                  bool /*create*/)
+{
+  FETCH_LOCK(mutex_);
+
+  Close();
+
+  segment_prefix_ = doc_file;
+  index_path_     = index_file;
+
+  Create();
+}
+
+/**
+ * Load an existing archive
+ *
+ * @param doc_file The prefix for the segment files
+ * @param index_file The filename for the index file
+ * @param create Flag to signal if the archive should be created if it doesn't exist
+ */
+void TransactionSegmentStore::Load(std::string const &doc_file, std::string const &index_file,
+                                   bool create)
+{
+  FETCH_LOCK(mutex_);
+
+  Close();
+
+  segment_prefix_ = doc_file;
+  index_path_     = index_file;
+
+  if (!FileExists(index_path_))
+  {
+    if (!create)
+    {
+      throw StorageException("Transaction archive does not exist");
+    }
+
+    Create();
+    return;
+  }
+
+  index_ = MapFile(index_path_);
+
+  if (header().magic != INDEX_MAGIC)
+  {
+    index_.unmap();
+    throw StorageException("Transaction archive index is corrupt");
+  }
+
+  segment_size_ = header().segment_size;
+  write_offset_ = header().tail_offset;
+
+  for (uint64_t segment = 0; segment <= header().tail_segment; ++segment)
+  {
+    MapSegment(segment, false);
+  }
+
+  Recover();
+}
+
+/**
+ * Force the pending writes of the archive to disk
+ */
+void TransactionSegmentStore::Flush()
+{
+  FETCH_LOCK(mutex_);
+  Commit();
+}
+
+/**
+ * Add a transaction to the store
+ *
+ * @param tx The transaction to set added to storage
+ */
+void TransactionSegmentStore::Add(chain::Transaction const &tx)
+{
+  FETCH_LOCK(mutex_);
+
+  auto const &digest = tx.digest();
+
+  uint64_t location{0};
+  if (!index_.is_mapped() || (digest.size() != DIGEST_SIZE) || Find(digest.pointer(), location))
+  {
+    return;
+  }
+
+  try
+  {
+    serializers::MsgPackSerializer serializer;
+    serializer << tx;
+
+    Append(digest.pointer(), serializer.data());
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to add tx: 0x", digest.ToHex(), " to store: ", ex.what());
+  }
+}
+
+/**
+ * Check to see if requested transaction exists
+ *
+ * @param tx_digest The transaction digest to be searched for
+ * @return true if present, otherwise false
+ */
+bool TransactionSegmentStore::Has(Digest const &tx_digest) const
+{
+  FETCH_LOCK(mutex_);
+
+  uint64_t location{0};
+  return (tx_digest.size() == DIGEST_SIZE) && Find(tx_digest.pointer(), location);
+}
+
+/**
+ * Lookup a transaction from the store
+ *
+ * @param tx_digest The transaction digest to lookup
+ * @param tx The output transaction to be populated
+ * @return true if successful, otherwise false
+ */
+bool TransactionSegmentStore::Get(Digest const &tx_digest, chain::Transaction &tx) const
+{
+  FETCH_LOCK(mutex_);
+
+  uint64_t location{0};
+  if ((tx_digest.size() != DIGEST_SIZE) || !Find(tx_digest.pointer(), location))
+  {
+    return false;
+  }
+
+  try
+  {
+    return ReadRecord(location, tx);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to get tx: 0x", tx_digest.ToHex(),
+                   " from store: ", ex.what());
+  }
+
+  return false;
+}
+
+/**
+ * Get the total number of transactions in this store
+ *
+ * @return The number of transactions stored
+ */
+uint64_t TransactionSegmentStore::GetCount() const
+{
+  FETCH_LOCK(mutex_);
+  return index_.is_mapped() ? header().count : 0;
+}
+
+/**
+ * Pull a sub tree from the archive with the given starting prefix for the digest
+ *
+ * @param partial_digest The partial digest for the subtree
+ * @param bit_count The bit count of the partial digest for the subtree
+ * @param pull_limit The maximum number of transactions to be retrieved
+ * @return The extracted subtree of transactions from the store
+ */
+TransactionSegmentStore::TxArray TransactionSegmentStore::PullSubtree(
+    Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit)
+{
+  FETCH_LOCK(mutex_);
+
+  TxArray ret{};
+
+  if (!index_.is_mapped())
+  {
+    return ret;
+  }
+
+  // normalise the prefix to a full width digest
+  uint8_t prefix[DIGEST_SIZE] = {};
+  std::memcpy(prefix, partial_digest.pointer(),
+              std::min<std::size_t>(partial_digest.size(), DIGEST_SIZE));
+  bit_count = std::min<uint64_t>(bit_count, DIGEST_SIZE * 8);
+
+  // all the members of the subtree have a home slot in [first_slot, first_slot + span)
+  uint64_t const capacity_log2 = header().capacity_log2;
+  uint64_t const mask          = (uint64_t{1} << capacity_log2) - 1;
+  uint64_t const index_bits    = std::min(bit_count, capacity_log2);
+  uint64_t const first_slot    = HomeSlot(DigestKey(prefix), capacity_log2) & ~(mask >> index_bits);
+  uint64_t const span          = uint64_t{1} << (capacity_log2 - index_bits);
+
+  chain::Transaction tx;
+  for (uint64_t i = 0; (i <= mask) && (ret.size() < pull_limit); ++i)
+  {
+    auto const &entry = entries()[(first_slot + i) & mask];
+
+    // past the end of the range, members can only have been displaced into the current run
+    if (entry.location == 0)
+    {
+      if (i >= span)
+      {
+        break;
+      }
+
+      continue;
+    }
+
+    if (!MatchesPrefix(Record(entry.location) + sizeof(RecordHeader), prefix, bit_count))
+    {
+      continue;
+    }
+
+    try
+    {
+      if (ReadRecord(entry.location, tx))
+      {
+        ret.push_back(tx);
+      }
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to read archived tx: ", ex.what());
+    }
+  }
+
+  return ret;
+}
+
+TransactionSegmentStore::MappedFile TransactionSegmentStore::CreateIndex(
+    std::string const &path, uint64_t capacity_log2) const
+{
+  CreateFile(path, sizeof(IndexHeader) + (sizeof(IndexEntry) << capacity_log2));
+
+  auto  mapping = MapFile(path);
+  auto &header  = *reinterpret_cast<IndexHeader *>(mapping.data());
+
+  header.magic         = INDEX_MAGIC;
+  header.capacity_log2 = capacity_log2;
+  header.count         = 0;
+  header.segment_size  = segment_size_;
+  header.tail_segment  = 0;
+  header.tail_offset   = 0;
+
+  return mapping;
+}
+
+TransactionSegmentStore::IndexHeader &TransactionSegmentStore::header()
+{
+  return *reinterpret_cast<IndexHeader *>(index_.data());
+}
+
+TransactionSegmentStore::IndexHeader const &TransactionSegmentStore::header() const
+{
+  return *reinterpret_cast<IndexHeader const *>(index_.data());
+}
+
+TransactionSegmentStore::IndexEntry *TransactionSegmentStore::entries()
+{
+  return reinterpret_cast<IndexEntry *>(index_.data() + sizeof(IndexHeader));
+}
+
+TransactionSegmentStore::IndexEntry const *TransactionSegmentStore::entries() const
+{
+  return reinterpret_cast<IndexEntry const *>(index_.data() + sizeof(IndexHeader));
+}
+
+/**
+ * Lookup the record location for a digest
+ *
+ * @param digest The full digest to search for
+ * @param location The output location of the record
+ * @return true if found, otherwise false
+ */
+bool TransactionSegmentStore::Find(DigestBytes digest, uint64_t &location) const
+{
+  if (!index_.is_mapped())
+  {
+    return false;
+  }
+
+  uint64_t const key           = DigestKey(digest);
+  uint64_t const capacity_log2 = header().capacity_log2;
+  uint64_t const mask          = (uint64_t{1} << capacity_log2) - 1;
+  auto const *   table         = entries();
+
+  uint64_t slot = HomeSlot(key, capacity_log2);
+  for (uint64_t i = 0; i <= mask; ++i, slot = (slot + 1) & mask)
+  {
+    auto const &entry = table[slot];
+
+    if (entry.location == 0)
+    {
+      break;
+    }
+
+    // the key is only a digest prefix, so confirm against the digest held in the record
+    if ((entry.key == key) &&
+        (std::memcmp(Record(entry.location) + sizeof(RecordHeader), digest, DIGEST_SIZE) == 0))
+    {
+      location = entry.location;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void TransactionSegmentStore::Insert(uint64_t key, uint64_t location)
+{
+  // keep the load factor below 3/4 so that probe sequences stay short
+  if ((header().count + 1) * 4 > (uint64_t{3} << header().capacity_log2))
+  {
+    GrowIndex();
+  }
+
+  uint64_t const capacity_log2 = header().capacity_log2;
+  uint64_t const mask          = (uint64_t{1} << capacity_log2) - 1;
+  auto *         table         = entries();
+
+  uint64_t slot = HomeSlot(key, capacity_log2);
+  while (table[slot].location != 0)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  table[slot] = IndexEntry{key, location};
+  ++header().count;
+}
+
+/**
+ * Rebuild the index with twice the capacity. The new index is written alongside the old one and
+ * then renamed over it, so that a crash part way through leaves the old index intact.
+ */
+void TransactionSegmentStore::GrowIndex()
+{
+  std::string const temp_path     = index_path_ + ".tmp";
+  uint64_t const    capacity_log2 = header().capacity_log2 + 1;
+  uint64_t const    mask          = (uint64_t{1} << capacity_log2) - 1;
+
+  auto  grown         = CreateIndex(temp_path, capacity_log2);
+  auto &grown_header  = *reinterpret_cast<IndexHeader *>(grown.data());
+  auto *grown_entries = reinterpret_cast<IndexEntry *>(grown.data() + sizeof(IndexHeader));
+
+  auto const *table = entries();
+  for (uint64_t i = 0, end = uint64_t{1} << header().capacity_log2; i < end; ++i)
+  {
+    if (table[i].location == 0)
+    {
+      continue;
+    }
+
+    uint64_t slot = HomeSlot(table[i].key, capacity_log2);
+    while (grown_entries[slot].location != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+
+    grown_entries[slot] = table[i];
+  }
+
+  grown_header.count        = header().count;
+  grown_header.tail_segment = header().tail_segment;
+  grown_header.tail_offset  = header().tail_offset;
+
+  Sync(grown);
+  index_.unmap();
+
+  if (std::rename(temp_path.c_str(), index_path_.c_str()) != 0)
+  {
+    throw StorageException("Unable to replace transaction archive index");
+  }
+
+  index_ = std::move(grown);
+}
+
+std::string TransactionSegmentStore::SegmentPath(uint64_t segment) const
+{
+  std::ostringstream oss;
+  oss << segment_prefix_ << '.' << std::setw(6) << std::setfill('0') << segment;
+  return oss.str();
+}
+
+void TransactionSegmentStore::MapSegment(uint64_t segment, bool create)
+{
+  assert(segment == segments_.size());
+
+  auto const path = SegmentPath(segment);
+
+  if (create)
+  {
+    CreateFile(path, segment_size_);
+  }
+
+  segments_.emplace_back(MapFile(path));
+
+  if (segments_.back().size() != segment_size_)
+  {
+    throw StorageException("Transaction archive segment has an unexpected size");
+  }
+}
+
+uint8_t const *TransactionSegmentStore::Record(uint64_t location) const
+{
+  auto const &segment = segments_.at(LocationSegment(location));
+  return reinterpret_cast<uint8_t const *>(segment.data()) + LocationOffset(location);
+}
+
+bool TransactionSegmentStore::ReadRecord(uint64_t location, chain::Transaction &tx) const
+{
+  auto const *record = Record(location);
+
+  RecordHeader header{};
+  std::memcpy(&header, record, sizeof(header));
+
+  serializers::MsgPackSerializer serializer{
+      byte_array::ConstByteArray{record + RECORD_OVERHEAD, header.length}};
+  serializer >> tx;
+
+  return true;
+}
+
+/**
+ * Append a record to the active segment, moving to a new segment when it is full
+ *
+ * @param digest The digest of the transaction
+ * @param payload The serialised transaction
+ */
+void TransactionSegmentStore::Append(DigestBytes digest, byte_array::ConstByteArray const &payload)
+{
+  uint64_t const record_size = RecordSize(payload.size());
+
+  if (record_size > segment_size_)
+  {
+    throw StorageException("Transaction is too large for the archive segment size");
+  }
+
+  if (write_offset_ + record_size > segment_size_)
+  {
+    Sync(segments_.back());
+    MapSegment(segments_.size(), true);
+    write_offset_ = 0;
+  }
+
+  uint64_t const segment = segments_.size() - 1;
+  auto *         record  = reinterpret_cast<uint8_t *>(segments_.back().data()) + write_offset_;
+
+  std::memcpy(record + sizeof(RecordHeader), digest, DIGEST_SIZE);
+  std::memcpy(record + RECORD_OVERHEAD, payload.pointer(), payload.size());
+
+  // the header is written last, since a non zero length is what marks the record as present
+  auto const         length = static_cast<uint32_t>(payload.size());
+  RecordHeader const header{length, RecordChecksum(length, digest, payload.pointer())};
+  std::memcpy(record, &header, sizeof(header));
+
+  Insert(DigestKey(digest), EncodeLocation(segment, write_offset_));
+  write_offset_ += record_size;
+
+  if (++pending_ >= GROUP_COMMIT_SIZE)
+  {
+    Commit();
+  }
+}
+
+/**
+ * Scan the segments from the last committed position and index any records that were written
+ * after it, i.e. those that were not part of a completed group commit.
+ */
+void TransactionSegmentStore::Recover()
+{
+  uint64_t recovered{0};
+  bool     torn{false};
+
+  for (;;)
+  {
+    uint64_t const segment = segments_.size() - 1;
+    auto const *   data    = reinterpret_cast<uint8_t const *>(segments_.back().data());
+
+    while (write_offset_ + RECORD_OVERHEAD <= segment_size_)
+    {
+      RecordHeader header{};
+      std::memcpy(&header, data + write_offset_, sizeof(header));
+
+      if ((header.length == 0) || (write_offset_ + RecordSize(header.length) > segment_size_))
+      {
+        break;
+      }
+
+      auto const *digest = data + write_offset_ + sizeof(RecordHeader);
+
+      // a torn record ends the log, anything after it was never committed either
+      if (header.checksum != RecordChecksum(header.length, digest, digest + DIGEST_SIZE))
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Discarding torn transaction archive record in segment ",
+                       segment, " at offset ", write_offset_);
+
+        // clear the remainder of the log so that intact records after the torn one can not be
+        // recovered once new records have been appended over it
+        std::memset(segments_.back().data() + write_offset_, 0, segment_size_ - write_offset_);
+        for (uint64_t next = segment + 1; FileExists(SegmentPath(next)); ++next)
+        {
+          std::remove(SegmentPath(next).c_str());
+        }
+
+        torn = true;
+        break;
+      }
+
+      uint64_t location{0};
+      if (!Find(digest, location))
+      {
+        Insert(DigestKey(digest), EncodeLocation(segment, write_offset_));
+        ++recovered;
+      }
+
+      write_offset_ += RecordSize(header.length);
+    }
+
+    if (torn || !FileExists(SegmentPath(segments_.size())))
+    {
+      break;
+    }
+
+    MapSegment(segments_.size(), false);
+    write_offset_ = 0;
+  }
+
+  if (recovered > 0)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Recovered ", recovered, " uncommitted transactions");
+  }
+
+  Commit();
+}
+
+void TransactionSegmentStore::Create()
+{
+  // remove the segments of any previous archive
+  for (uint64_t segment = 0; FileExists(SegmentPath(segment)); ++segment)
+  {
+    std::remove(SegmentPath(segment).c_str());
+  }
+
+  index_        = CreateIndex(index_path_, index_capacity_log2_);
+  write_offset_ = 0;
+
+  MapSegment(0, true);
+  Commit();
+}
+
+/**
+ * Make all the appended transactions durable
+ */
+void TransactionSegmentStore::Commit()
+{
+  if (!index_.is_mapped())
+  {
+    return;
+  }
+
+  if (!segments_.empty())
+  {
+    Sync(segments_.back());
+  }
+
+  header().tail_segment = segments_.empty() ? 0 : segments_.size() - 1;
+  header().tail_offset  = write_offset_;
+  Sync(index_);
+
+  pending_ = 0;
+}
+
+void TransactionSegmentStore::Close()
+{
+  Commit();
+
+  segments_.clear();
+  index_.unmap();
+  write_offset_ = 0;
+  pending_      = 0;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -18,9 +18,66 @@
 
 #include "core/reactor.hpp"
 #include "ledger/storage_unit/transaction_storage_engine.hpp"
+#include "ledger/storage_unit/transaction_store.hpp"
+#include "logging/logging.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
 
 namespace fetch {
 namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "TxStorageEngine";
+
+std::string ArchivePath(std::string const &filename)
+{
+  return filename + ".seg";
+}
+
+bool FileExists(std::string const &path)
+{
+  std::ifstream file(path);
+  return file.good();
+}
+
+/**
+ * Copy the contents of a legacy (object store based) transaction archive into the segment archive
+ *
+ * @param doc_file The filename of the legacy document file
+ * @param index_file The filename of the legacy index file
+ * @param archive The archive to populate
+ */
+void ImportLegacyArchive(std::string const &doc_file, std::string const &index_file,
+                         TransactionSegmentStore &archive)
+{
+  TransactionStore legacy;
+  legacy.Load(doc_file, index_file, false);
+
+  // walk the legacy store one 8 bit subtree at a time to bound the memory usage
+  byte_array::ByteArray prefix;
+  prefix.Resize(sizeof(uint64_t));
+
+  for (uint64_t root = 0; root < 256; ++root)
+  {
+    std::memset(prefix.pointer(), 0, prefix.size());
+    prefix[0] = static_cast<uint8_t>(root);
+
+    for (auto const &tx : legacy.PullSubtree(prefix, 8, std::numeric_limits<uint64_t>::max()))
+    {
+      archive.Add(tx);
+    }
+  }
+
+  archive.Flush();
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Imported ", archive.GetCount(), " of ", legacy.GetCount(),
+                 " transactions from the legacy archive");
+}
+
+}  // namespace
 
 using TxArray   = TransactionStorageEngineInterface::TxArray;
 using TxLayouts = TransactionStorageEngineInterface::TxLayouts;
@@ -46,7 +103,7 @@ TransactionStorageEngine::TransactionStorageEngine(uint32_t log2_num_lanes, uint
 void TransactionStorageEngine::New(std::string const &doc_file, std::string const &index_file,
                                    bool const &create)
 {
-  archive_.New(doc_file, index_file, create);
+  archive_.New(ArchivePath(doc_file), ArchivePath(index_file), create);
 }
 
 /**
@@ -59,7 +116,13 @@ void TransactionStorageEngine::New(std::string const &doc_file, std::string cons
 void TransactionStorageEngine::Load(std::string const &doc_file, std::string const &index_file,
                                     bool const &create)
 {
-  archive_.Load(doc_file, index_file, create);
+  archive_.Load(ArchivePath(doc_file), ArchivePath(index_file), create);
+
+  // migrate archives written by previous versions
+  if ((archive_.GetCount() == 0) && FileExists(doc_file) && FileExists(index_file))
+  {
+    ImportLegacyArchive(doc_file, index_file, archive_);
+  }
 }
 
 /**
@@ -29,7 +29,10 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -40,6 +43,7 @@ using telemetry::Registry;
 
 constexpr char const *          LOGGING_NAME = "TxVerifier";
 const std::chrono::milliseconds POP_TIMEOUT{300};
+constexpr std::size_t           DISPATCH_BATCH_SIZE{256};
 
 std::string CreateMetricName(std::string const &prefix, std::string const &name)
 {
@@ -230,12 +234,18 @@ void TransactionVerifier::Dispatcher()
 {
   SetThreadName(name_ + "-D");
 
+  std::vector<TransactionPtr> batch;
+  batch.reserve(DISPATCH_BATCH_SIZE);
+
   while (active_)
   {
-    try
+    // drain all the verified transactions that are available in one go
+    batch.clear();
+    verified_queue_.PopBatch(std::back_inserter(batch), DISPATCH_BATCH_SIZE, POP_TIMEOUT);
+
+    for (auto &tx : batch)
     {
-      TransactionPtr tx;
-      if (verified_queue_.Pop(tx, POP_TIMEOUT))
+      try
       {
         FETCH_LOG_DEBUG(LOGGING_NAME, "TX Dispatch: 0x", tx->digest().ToHex());
 
@@ -244,10 +254,10 @@ void TransactionVerifier::Dispatcher()
         verified_queue_length_->decrement();
         dispatched_tx_total_->increment();
       }
-    }
-    catch (std::exception const &e)
-    {
-      FETCH_LOG_WARN(LOGGING_NAME, name_ + " Exception caught: ", e.what());
+      catch (std::exception const &e)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, name_ + " Exception caught: ", e.what());
+      }
     }
   }
 }
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/constants.hpp"
 #include "crypto/hash.hpp"
 #include "crypto/sha256.hpp"
 #include "json/document.hpp"
@@ -326,7 +327,10 @@ Status SynergeticContract::Complete(chain::Address const &address, BitVector con
   StateSentinelAdapter state_sentinel{storage_cache, address.display(), shards};
 
   // attach the state to the VM
+  bool const paged_state = context().block_index >= chain::PAGED_STATE_ACTIVATION_HEIGHT;
+  state_sentinel.EnablePagedState(paged_state);
   vm->SetIOObserver(state_sentinel);
+  vm->EnablePagedState(paged_state);
 
   vm::Variant output;
   std::string error{};
@@ -114,7 +114,8 @@ void SynergeticExecutor::Verify(WorkQueue &solutions, ProblemData const &problem
 
       // complete the work and resolve the work queue
       contract->Attach(storage_);
-      ContractContext ctx(&token_contract_, solution->address(), nullptr, &storage_adapter, 0);
+      ContractContext ctx(&token_contract_, solution->address(), nullptr, &storage_adapter,
+                          solution->block_index());
       contract->UpdateContractContext(ctx);
 
       // TODO(LDGR-622): charge limit
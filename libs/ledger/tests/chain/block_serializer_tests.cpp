@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ConstByteArray;
+using fetch::chain::TransactionLayout;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::Block;
+using fetch::serializers::MsgPackSerializer;
+
+Block CreateBlock(uint64_t block_number)
+{
+  Block block{};
+  block.block_number  = block_number;
+  block.timestamp     = 1000 + block_number;
+  block.previous_hash = Hash<SHA256>(std::to_string(block_number - 1));
+  block.slices.resize(2);
+
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    auto const digest = Hash<SHA256>(std::to_string(block_number) + "/" + std::to_string(i));
+    block.slices[i % 2].emplace_back(digest, BitVector{1}, 1, 0, 100);
+  }
+
+  block.UpdateDigest();
+
+  return block;
+}
+
+ConstByteArray Encode(Block const &block)
+{
+  MsgPackSerializer serializer;
+  serializer << block;
+  return serializer.data();
+}
+
+Block Decode(ConstByteArray const &encoded)
+{
+  MsgPackSerializer serializer{encoded};
+
+  Block block{};
+  serializer >> block;
+
+  return block;
+}
+
+TEST(BlockSerializerTests, CheckDecodedBlockRetainsItsEncoding)
+{
+  auto const block   = CreateBlock(10);
+  auto const encoded = Encode(block);
+
+  EXPECT_TRUE(block.encoding.empty());
+
+  auto const decoded = Decode(encoded);
+  EXPECT_EQ(encoded, decoded.encoding);
+  EXPECT_EQ(block.hash, decoded.hash);
+  EXPECT_EQ(block.GetTransactionCount(), decoded.GetTransactionCount());
+}
+
+TEST(BlockSerializerTests, CheckRelayedBlockIsNotReencoded)
+{
+  auto const encoded = Encode(CreateBlock(10));
+  auto const decoded = Decode(encoded);
+
+  // relaying the block must yield the bytes it was received in
+  auto relayed = decoded;
+  EXPECT_EQ(encoded, Encode(relayed));
+
+  // and it must remain decodable when nested inside other messages
+  MsgPackSerializer serializer;
+  serializer << uint32_t{7} << relayed << uint32_t{9};
+  serializer.seek(0);
+
+  uint32_t before{0};
+  uint32_t after{0};
+  Block    nested{};
+  serializer >> before >> nested >> after;
+
+  EXPECT_EQ(7u, before);
+  EXPECT_EQ(9u, after);
+  EXPECT_EQ(decoded.hash, nested.hash);
+  EXPECT_EQ(encoded, nested.encoding);
+}
+
+TEST(BlockSerializerTests, CheckEncodingSurvivesDigestCheck)
+{
+  auto const encoded = Encode(CreateBlock(10));
+  auto       decoded = Decode(encoded);
+
+  decoded.UpdateDigest();
+  EXPECT_EQ(encoded, decoded.encoding);
+}
+
+TEST(BlockSerializerTests, CheckStaleEncodingIsNotRelayed)
+{
+  auto const encoded = Encode(CreateBlock(10));
+
+  // the total weight is recalculated when the block is added to the chain
+  auto weighted         = Decode(encoded);
+  weighted.total_weight = 42;
+
+  auto const reweighted = Decode(Encode(weighted));
+  EXPECT_EQ(42u, reweighted.total_weight);
+  EXPECT_EQ(weighted.hash, reweighted.hash);
+
+  // and a block is signed after its digest has been calculated
+  auto signed_block            = Decode(encoded);
+  signed_block.miner_signature = ConstByteArray{"signature"};
+
+  auto const resigned = Decode(Encode(signed_block));
+  EXPECT_EQ(signed_block.miner_signature, resigned.miner_signature);
+
+  // restoring the fields makes the retained encoding current again
+  weighted.total_weight = Decode(encoded).total_weight;
+  EXPECT_TRUE(weighted.HasCurrentEncoding());
+  EXPECT_EQ(encoded, Encode(weighted));
+}
+
+TEST(BlockSerializerTests, CheckDetachedBlockReleasesTheReceivedBuffer)
+{
+  auto const block = CreateBlock(10);
+
+  // the block is received as part of a larger message
+  MsgPackSerializer message;
+  message << uint32_t{7} << block << block;
+  message.seek(0);
+
+  auto const unshared = message.data().UseCount();
+
+  uint32_t before{0};
+  Block    decoded{};
+  message >> before >> decoded;
+  EXPECT_GT(message.data().UseCount(), unshared);
+
+  decoded.total_weight = 42;
+  decoded.DetachFromBuffer();
+
+  // none of the fields refer to the received buffer any more, and the encoding has been updated
+  EXPECT_EQ(unshared, message.data().UseCount());
+  EXPECT_EQ(decoded.encoding.size(), decoded.encoding.capacity());
+  EXPECT_TRUE(decoded.HasCurrentEncoding());
+  EXPECT_EQ(42u, decoded.total_weight);
+  EXPECT_EQ(block.hash, decoded.hash);
+  EXPECT_EQ(block.slices, decoded.slices);
+
+  auto const redecoded = Decode(Encode(decoded));
+  EXPECT_EQ(42u, redecoded.total_weight);
+  EXPECT_EQ(block.hash, redecoded.hash);
+}
+
+TEST(BlockSerializerTests, CheckModifiedBlockIsReencoded)
+{
+  auto const original = CreateBlock(10);
+  auto       decoded  = Decode(Encode(original));
+
+  decoded.timestamp += 1;
+  decoded.UpdateDigest();
+
+  EXPECT_NE(original.hash, decoded.hash);
+  EXPECT_TRUE(decoded.encoding.empty());
+
+  auto const reencoded = Decode(Encode(decoded));
+  EXPECT_EQ(decoded.hash, reencoded.hash);
+  EXPECT_EQ(decoded.timestamp, reencoded.timestamp);
+}
+
+}  // namespace
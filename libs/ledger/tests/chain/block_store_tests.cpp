@@ -0,0 +1,320 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_db_record.hpp"
+#include "ledger/chain/block_store.hpp"
+#include "storage/object_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/storage_exception.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::TransactionLayout;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::Block;
+using fetch::ledger::BlockDbRecord;
+using fetch::ledger::BlockStore;
+using fetch::storage::ObjectStore;
+using fetch::storage::ResourceID;
+using fetch::storage::StorageException;
+
+using BlockStorePtr = std::unique_ptr<BlockStore>;
+using LegacyStore   = ObjectStore<BlockDbRecord>;
+
+constexpr char const *PREFIX       = "block_store_test";
+constexpr char const *LEGACY_DOC   = "block_store_test_legacy.db";
+constexpr char const *LEGACY_INDEX = "block_store_test_legacy.index.db";
+constexpr std::size_t NUM_SLICES = 2;
+
+class BlockStoreTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    RemoveFiles();
+
+    store_ = std::make_unique<BlockStore>();
+    store_->New(PREFIX);
+  }
+
+  void TearDown() override
+  {
+    store_.reset();
+    RemoveFiles();
+  }
+
+  static void RemoveFiles()
+  {
+    for (auto const *suffix : {".records.db", ".hashes.db", ".heights.db", ".headers.db",
+                               ".bodies.db"})
+    {
+      std::remove((std::string{PREFIX} + suffix).c_str());
+    }
+
+    std::remove(LEGACY_DOC);
+    std::remove(LEGACY_INDEX);
+  }
+
+  // write a chain of blocks, and a block on a fork, to a store in the previous format
+  static void CreateLegacyStore(uint64_t num_blocks, uint64_t missing_block = 0)
+  {
+    LegacyStore legacy_store{};
+    legacy_store.New(LEGACY_DOC, LEGACY_INDEX);
+
+    for (uint64_t i = 0; i < num_blocks; ++i)
+    {
+      if ((i != missing_block) || (i == 0))
+      {
+        auto const block = CreateBlock(i);
+        legacy_store.Set(ResourceID{block.hash}, BlockDbRecord{block, CreateBlock(i + 1).hash});
+      }
+    }
+
+    auto const fork = CreateBlock(num_blocks / 2, "fork");
+    legacy_store.Set(ResourceID{fork.hash}, BlockDbRecord{fork, {}});
+
+    legacy_store.Flush(false);
+  }
+
+  void Reload()
+  {
+    store_ = std::make_unique<BlockStore>();
+    store_->Load(PREFIX);
+  }
+
+  // create a block with a distinct hash, the hash does not need to be the digest of its contents
+  static Block CreateBlock(uint64_t block_number, std::string const &branch = {},
+                           std::size_t num_transactions = 3)
+  {
+    Block block{};
+    block.block_number  = block_number;
+    block.timestamp     = 1000 + block_number;
+    block.previous_hash = Hash<SHA256>(branch + std::to_string(block_number - 1));
+    block.hash          = Hash<SHA256>(branch + std::to_string(block_number));
+    block.slices.resize(NUM_SLICES);
+
+    for (std::size_t i = 0; i < num_transactions; ++i)
+    {
+      auto const digest = Hash<SHA256>(block.hash + std::to_string(i));
+      block.slices[i % NUM_SLICES].emplace_back(digest, BitVector{1}, 1, 0, 100);
+    }
+
+    return block;
+  }
+
+  static void ExpectHeaderEqual(Block const &expected, Block const &actual)
+  {
+    EXPECT_EQ(expected.hash, actual.hash);
+    EXPECT_EQ(expected.previous_hash, actual.previous_hash);
+    EXPECT_EQ(expected.block_number, actual.block_number);
+    EXPECT_EQ(expected.timestamp, actual.timestamp);
+  }
+
+  BlockStorePtr store_;
+};
+
+TEST_F(BlockStoreTests, CheckBlockRoundTrip)
+{
+  auto const block = CreateBlock(1);
+  auto const next  = CreateBlock(2);
+
+  EXPECT_FALSE(store_->Has(block.hash));
+
+  store_->Add(block, next.hash);
+
+  BlockDbRecord record{};
+  ASSERT_TRUE(store_->Has(block.hash));
+  ASSERT_TRUE(store_->Get(block.hash, record));
+
+  ExpectHeaderEqual(block, record.block);
+  EXPECT_EQ(next.hash, record.next_hash);
+  ASSERT_EQ(NUM_SLICES, record.block.slices.size());
+  EXPECT_EQ(block.slices, record.block.slices);
+}
+
+TEST_F(BlockStoreTests, CheckHeaderOnlyLookup)
+{
+  auto const block = CreateBlock(1);
+  store_->Add(block);
+
+  BlockDbRecord record{};
+  ASSERT_TRUE(store_->GetHeader(block.hash, record));
+
+  ExpectHeaderEqual(block, record.block);
+  EXPECT_TRUE(record.block.slices.empty());
+  EXPECT_TRUE(record.next_hash.empty());
+}
+
+TEST_F(BlockStoreTests, CheckMissingBlock)
+{
+  store_->Add(CreateBlock(1));
+
+  BlockDbRecord record{};
+  EXPECT_FALSE(store_->Has(CreateBlock(2).hash));
+  EXPECT_FALSE(store_->Get(CreateBlock(2).hash, record));
+  EXPECT_FALSE(store_->GetByIndex(1, record));
+  EXPECT_TRUE(store_->GetHashAtHeight(2).empty());
+}
+
+TEST_F(BlockStoreTests, CheckForwardReferenceAndHeightUpdates)
+{
+  auto const parent = CreateBlock(1);
+  auto const child  = CreateBlock(2);
+  auto const fork   = CreateBlock(2, "fork");
+
+  store_->Add(parent);
+  store_->Add(child);
+  EXPECT_EQ(child.hash, store_->GetHashAtHeight(2));
+
+  // a block on a fork at the same height replaces it in the height index
+  store_->Add(fork);
+  EXPECT_EQ(fork.hash, store_->GetHashAtHeight(2));
+
+  // adding a block again only updates its references
+  store_->Add(child);
+  EXPECT_EQ(child.hash, store_->GetHashAtHeight(2));
+  EXPECT_EQ(3u, store_->size());
+
+  EXPECT_TRUE(store_->SetNextHash(parent.hash, child.hash));
+  EXPECT_FALSE(store_->SetNextHash(CreateBlock(5).hash, child.hash));
+
+  BlockDbRecord record{};
+  ASSERT_TRUE(store_->GetHeader(parent.hash, record));
+  EXPECT_EQ(child.hash, record.next_hash);
+}
+
+TEST_F(BlockStoreTests, CheckPersistenceAcrossGrowth)
+{
+  // enough blocks to grow every file and the hash index a number of times
+  static constexpr uint64_t NUM_BLOCKS = 5000;
+
+  for (uint64_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    store_->Add(CreateBlock(i, {}, 10), CreateBlock(i + 1).hash);
+  }
+  store_->SetFilterHeight(NUM_BLOCKS / 2);
+
+  Reload();
+
+  ASSERT_EQ(NUM_BLOCKS, store_->size());
+  EXPECT_EQ(NUM_BLOCKS / 2, store_->filter_height());
+
+  for (uint64_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    auto const expected = CreateBlock(i, {}, 10);
+
+    BlockDbRecord record{};
+    ASSERT_TRUE(store_->Get(expected.hash, record));
+    ExpectHeaderEqual(expected, record.block);
+    EXPECT_EQ(expected.slices, record.block.slices);
+    EXPECT_EQ(CreateBlock(i + 1).hash, record.next_hash);
+
+    ASSERT_TRUE(store_->GetByIndex(i, record));
+    EXPECT_EQ(expected.hash, record.block.hash);
+    EXPECT_EQ(expected.hash, store_->GetHashAtHeight(i));
+  }
+}
+
+TEST_F(BlockStoreTests, CheckHashIndexIsRebuiltWhenMissing)
+{
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    store_->Add(CreateBlock(i));
+  }
+
+  store_.reset();
+  std::remove((std::string{PREFIX} + ".hashes.db").c_str());
+
+  Reload();
+
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    EXPECT_TRUE(store_->Has(CreateBlock(i).hash));
+  }
+}
+
+TEST_F(BlockStoreTests, CheckLoadWithoutCreate)
+{
+  store_.reset();
+  RemoveFiles();
+
+  BlockStore store{};
+  EXPECT_THROW(store.Load(PREFIX, false), StorageException);
+
+  store.Load(PREFIX);
+  EXPECT_EQ(0u, store.size());
+}
+
+TEST_F(BlockStoreTests, CheckImportFromLegacyStore)
+{
+  static constexpr uint64_t NUM_BLOCKS = 50;
+  CreateLegacyStore(NUM_BLOCKS);
+
+  auto const head = CreateBlock(NUM_BLOCKS - 1);
+  EXPECT_EQ(NUM_BLOCKS, store_->Import(LEGACY_DOC, LEGACY_INDEX, head.hash));
+
+  Reload();
+
+  // only the chain leading to the head is imported
+  ASSERT_EQ(NUM_BLOCKS, store_->size());
+  EXPECT_FALSE(store_->Has(CreateBlock(NUM_BLOCKS / 2, "fork").hash));
+
+  for (uint64_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    auto const expected = CreateBlock(i);
+
+    BlockDbRecord record{};
+    ASSERT_TRUE(store_->Get(expected.hash, record));
+    ExpectHeaderEqual(expected, record.block);
+    EXPECT_EQ(expected.slices, record.block.slices);
+    EXPECT_EQ(expected.hash, store_->GetHashAtHeight(i));
+
+    // the forward references follow the imported chain
+    EXPECT_EQ((i + 1 < NUM_BLOCKS) ? CreateBlock(i + 1).hash : Block::Hash{}, record.next_hash);
+  }
+}
+
+TEST_F(BlockStoreTests, CheckIncompleteLegacyStoreIsNotImported)
+{
+  static constexpr uint64_t NUM_BLOCKS = 20;
+
+  // no previous store
+  EXPECT_EQ(0u, store_->Import(LEGACY_DOC, LEGACY_INDEX, CreateBlock(NUM_BLOCKS - 1).hash));
+
+  CreateLegacyStore(NUM_BLOCKS, NUM_BLOCKS / 4);
+
+  EXPECT_EQ(0u, store_->Import(LEGACY_DOC, LEGACY_INDEX, CreateBlock(NUM_BLOCKS - 1).hash));
+  EXPECT_EQ(0u, store_->Import(LEGACY_DOC, LEGACY_INDEX, CreateBlock(NUM_BLOCKS).hash));
+  EXPECT_EQ(0u, store_->size());
+}
+
+}  // namespace
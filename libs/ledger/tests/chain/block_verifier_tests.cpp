@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_verifier.hpp"
+#include "ledger/testing/block_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::TransactionLayout;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::Block;
+using fetch::ledger::BlockVerifier;
+using fetch::ledger::Blocks;
+using fetch::ledger::testing::BlockGenerator;
+
+using Status = BlockVerifier::Status;
+
+constexpr std::size_t NUM_LANES  = 1;
+constexpr std::size_t NUM_SLICES = 4;
+
+class BlockVerifierTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::crypto::mcl::details::MCLInitialiser();
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  // create a chain of signed blocks, as they would be received with no digest
+  Blocks CreateBlocks(std::size_t num_blocks, std::size_t num_transactions)
+  {
+    Blocks blocks{};
+
+    auto previous = generator_.Generate();
+    for (std::size_t i = 0; i < num_blocks; ++i)
+    {
+      auto block = generator_.Generate(previous);
+
+      for (std::size_t j = 0; j < num_transactions; ++j)
+      {
+        auto const digest = Hash<SHA256>(std::to_string(i) + ':' + std::to_string(j));
+        block->slices[j % NUM_SLICES].emplace_back(digest, BitVector{NUM_LANES}, 1, 0, 100);
+      }
+
+      block->miner_id = signer_.identity();
+      block->UpdateDigest();
+      block->miner_signature = signer_.Sign(block->hash);
+
+      previous = block;
+      blocks.push_back(block);
+    }
+
+    for (auto &block : blocks)
+    {
+      block->hash = Block::Hash{};
+    }
+
+    return blocks;
+  }
+
+  static void AddDuplicate(Block &block)
+  {
+    block.slices.back().push_back(block.slices.front().front());
+  }
+
+  BlockGenerator generator_{NUM_LANES, NUM_SLICES};
+  ECDSASigner    signer_{};
+};
+
+TEST_F(BlockVerifierTests, SingleBlockDigestIsUpdated)
+{
+  auto blocks = CreateBlocks(1, 32);
+  auto block  = *blocks.front();
+
+  EXPECT_EQ(Status::VALID, BlockVerifier::Verify(*blocks.front()));
+
+  block.UpdateDigest();
+  EXPECT_EQ(block.hash, blocks.front()->hash);
+  EXPECT_TRUE(blocks.front()->IsMinerSignatureVerified());
+}
+
+TEST_F(BlockVerifierTests, GenesisIsValid)
+{
+  auto genesis = generator_.Generate();
+
+  EXPECT_EQ(Status::VALID, BlockVerifier::Verify(*genesis));
+  EXPECT_EQ(fetch::chain::GetGenesisDigest(), genesis->hash);
+}
+
+TEST_F(BlockVerifierTests, DuplicateTransactionIsInvalid)
+{
+  auto blocks = CreateBlocks(1, 32);
+  AddDuplicate(*blocks.front());
+
+  EXPECT_EQ(Status::DUPLICATE_TRANSACTION, BlockVerifier::Verify(*blocks.front()));
+}
+
+TEST_F(BlockVerifierTests, BadSignatureIsNotMarkedVerified)
+{
+  auto blocks = CreateBlocks(2, 32);
+  blocks[0]->miner_signature = blocks[1]->miner_signature;
+
+  // whether the signature is required is up to the consensus
+  EXPECT_EQ(Status::VALID, BlockVerifier::Verify(*blocks[0]));
+  EXPECT_FALSE(blocks[0]->IsMinerSignatureVerified());
+
+  EXPECT_EQ(Status::VALID, BlockVerifier::Verify(*blocks[1]));
+  EXPECT_TRUE(blocks[1]->IsMinerSignatureVerified());
+}
+
+TEST_F(BlockVerifierTests, BatchStatusesAreInBlockOrder)
+{
+  std::size_t const default_budget = BlockVerifier::DEFAULT_MAX_PENDING_TRANSACTIONS;
+
+  for (std::size_t num_threads : {1u, 2u, 4u})
+  {
+    for (std::size_t budget : {std::size_t{1}, std::size_t{64}, default_budget})
+    {
+      auto blocks = CreateBlocks(20, 16);
+      AddDuplicate(*blocks[3]);
+      AddDuplicate(*blocks[11]);
+
+      BlockVerifier verifier{num_threads, budget};
+      auto const    statuses = verifier.Verify(blocks);
+
+      ASSERT_EQ(blocks.size(), statuses.size());
+      for (std::size_t i = 0; i < blocks.size(); ++i)
+      {
+        bool const expected_valid = (i != 3) && (i != 11);
+
+        EXPECT_EQ(expected_valid ? Status::VALID : Status::DUPLICATE_TRANSACTION, statuses[i])
+            << "block: " << i << " threads: " << num_threads << " budget: " << budget;
+        EXPECT_EQ(expected_valid, blocks[i]->IsMinerSignatureVerified());
+      }
+    }
+  }
+}
+
+TEST_F(BlockVerifierTests, LargeBlocksAreSplitIntoTasks)
+{
+  for (std::size_t transactions_per_task : {1u, 4u, 64u})
+  {
+    auto blocks = CreateBlocks(6, 200);
+    AddDuplicate(*blocks[1]);
+
+    // a duplicate of a transaction at the end of the block
+    blocks[4]->slices.front().push_back(blocks[4]->slices.back().back());
+
+    BlockVerifier verifier{4, BlockVerifier::DEFAULT_MAX_PENDING_TRANSACTIONS,
+                           transactions_per_task};
+    auto const    statuses = verifier.Verify(blocks);
+
+    ASSERT_EQ(blocks.size(), statuses.size());
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+      bool const expected_valid = (i != 1) && (i != 4);
+
+      EXPECT_EQ(expected_valid ? Status::VALID : Status::DUPLICATE_TRANSACTION, statuses[i])
+          << "block: " << i << " transactions per task: " << transactions_per_task;
+      EXPECT_EQ(expected_valid, blocks[i]->IsMinerSignatureVerified());
+
+      // the digest matches the one calculated by the block itself
+      auto block = *blocks[i];
+      block.UpdateDigest();
+      EXPECT_EQ(block.hash, blocks[i]->hash);
+    }
+  }
+}
+
+TEST_F(BlockVerifierTests, VerifiedSignatureOnlyAppliesToTheCheckedBlock)
+{
+  auto blocks = CreateBlocks(2, 32);
+  ASSERT_EQ(Status::VALID, BlockVerifier::Verify(*blocks[0]));
+  ASSERT_TRUE(blocks[0]->IsMinerSignatureVerified());
+
+  // a different signature
+  auto block            = *blocks[0];
+  block.miner_signature = blocks[1]->miner_signature;
+  EXPECT_FALSE(block.IsMinerSignatureVerified());
+
+  // a different hash
+  block      = *blocks[0];
+  block.hash = blocks[1]->hash;
+  EXPECT_FALSE(block.IsMinerSignatureVerified());
+
+  // a different miner
+  ECDSASigner other{};
+  block          = *blocks[0];
+  block.miner_id = other.identity();
+  EXPECT_FALSE(block.IsMinerSignatureVerified());
+
+  // recalculating the same digest keeps the check
+  block = *blocks[0];
+  block.UpdateDigest();
+  EXPECT_TRUE(block.IsMinerSignatureVerified());
+}
+
+TEST_F(BlockVerifierTests, EmptyBatch)
+{
+  BlockVerifier verifier{2};
+
+  EXPECT_TRUE(verifier.Verify(Blocks{}).empty());
+}
+
+}  // namespace
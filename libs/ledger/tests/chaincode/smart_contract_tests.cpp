@@ -137,7 +137,7 @@ TEST_F(SmartContractTests, CheckSimpleContract)
     EXPECT_CALL(*storage_, Unlock(_));
 
     // from the query
-    EXPECT_CALL(*storage_, Get(expected_resource)).Times(2);
+    EXPECT_CALL(*storage_, Get(expected_resource));
   }
 
   // send the smart contract an "increment" action
@@ -292,10 +292,10 @@ TEST_F(SmartContractTests, CheckParameterizedActionAndQuery)
     EXPECT_CALL(*storage_, Unlock(_));
 
     // from the `value` query
-    EXPECT_CALL(*storage_, Get(expected_resource)).Times(2);
+    EXPECT_CALL(*storage_, Get(expected_resource));
 
     // from the `offset` query
-    EXPECT_CALL(*storage_, Get(expected_resource)).Times(2);
+    EXPECT_CALL(*storage_, Get(expected_resource));
   }
 
   // send the smart contract an "increment" action
@@ -374,22 +374,21 @@ TEST_F(SmartContractTests, CheckBasicTokenContract)
     EXPECT_CALL(*storage_, Unlock(_));
 
     // from query
-    EXPECT_CALL(*storage_, Get(owner_resource)).Times(2);  // from io.Exists() & io.Read()
+    EXPECT_CALL(*storage_, Get(owner_resource));  // from io.Read()
 
     // from the action
     EXPECT_CALL(*storage_, Lock(_));
-    EXPECT_CALL(*storage_, Get(owner_resource));                    // from io.Exists()
     EXPECT_CALL(*storage_, Get(owner_resource));                    // from io.Read()
     EXPECT_CALL(*storage_, Set(owner_resource, remaining_amount));  // from io.Write()
-    EXPECT_CALL(*storage_, Get(target_resource));                   // from io.Exists()
+    EXPECT_CALL(*storage_, Get(target_resource));                   // from io.Read()
     EXPECT_CALL(*storage_, Set(target_resource, transfer_amount));  // from io.Write()
     EXPECT_CALL(*storage_, Unlock(_));
 
     // from query
-    EXPECT_CALL(*storage_, Get(owner_resource)).Times(2);
+    EXPECT_CALL(*storage_, Get(owner_resource));
 
     // from query
-    EXPECT_CALL(*storage_, Get(target_resource)).Times(2);
+    EXPECT_CALL(*storage_, Get(target_resource));
   }
 
   auto const status_1{InvokeInit(certificate_->identity())};
@@ -482,12 +481,10 @@ TEST_F(SmartContractTests, CheckShardedStateSetAndQuery)
   EXPECT_CALL(*storage_, Set(expected_resource1, expected_value1)).WillOnce(Return());
   EXPECT_CALL(*storage_, Set(expected_resource2, expected_value2)).WillOnce(Return());
 
-  // from the action & query
+  // from the query
   EXPECT_CALL(*storage_, Get(expected_resource1))
-      .WillOnce(Return(fetch::storage::Document{}))
       .WillOnce(Return(fetch::storage::Document{expected_value1}));
   EXPECT_CALL(*storage_, Get(expected_resource2))
-      .WillOnce(Return(fetch::storage::Document{}))
       .WillOnce(Return(fetch::storage::Document{expected_value2}));
 
   // send the smart contract an "increment" action
@@ -548,9 +545,8 @@ TEST_F(SmartContractTests, CheckShardedStateSetWithAddressAsName)
   EXPECT_CALL(*storage_, Set(expected_resource1, expected_value1)).WillOnce(Return());
   EXPECT_CALL(*storage_, Unlock(lane1)).WillOnce(Return(true));
 
-  // from the action & query
+  // from the query
   EXPECT_CALL(*storage_, Get(expected_resource1))
-      .WillOnce(Return(fetch::storage::Document{}))
       .WillOnce(Return(fetch::storage::Document{expected_value1}));
 
   // send the smart contract an "increment" action
@@ -0,0 +1,318 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "ledger/storage_unit/transaction_segment_store.hpp"
+#include "transaction_generator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::chain::Transaction;
+using fetch::ledger::TransactionSegmentStore;
+
+constexpr char const *DOC_FILE   = "transaction_segment_store_tests.db";
+constexpr char const *INDEX_FILE = "transaction_segment_store_tests.index.db";
+
+// small enough that a few hundred transactions span several segments
+constexpr uint64_t SMALL_SEGMENT_SIZE = 1u << 14u;
+
+using StorePtr = std::unique_ptr<TransactionSegmentStore>;
+
+class TransactionSegmentStoreTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    store_ = std::make_unique<TransactionSegmentStore>(SMALL_SEGMENT_SIZE);
+    store_->New(DOC_FILE, INDEX_FILE);
+  }
+
+  void Reload()
+  {
+    store_.reset();
+    store_ = std::make_unique<TransactionSegmentStore>(SMALL_SEGMENT_SIZE);
+    store_->Load(DOC_FILE, INDEX_FILE);
+  }
+
+  void ExpectAllPresent(TransactionGenerator::Txs const &txs)
+  {
+    for (auto const &tx : txs)
+    {
+      Transaction retrieved;
+      ASSERT_TRUE(store_->Has(tx->digest()));
+      ASSERT_TRUE(store_->Get(tx->digest(), retrieved));
+      EXPECT_EQ(retrieved.digest(), tx->digest());
+      EXPECT_EQ(retrieved.data(), tx->data());
+    }
+  }
+
+  TransactionGenerator tx_gen_;
+  StorePtr             store_;
+};
+
+TEST_F(TransactionSegmentStoreTests, SimpleCheck)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(5);
+
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    EXPECT_EQ(store_->GetCount(), i);
+    EXPECT_FALSE(store_->Has(txs.at(i)->digest()));
+
+    store_->Add(*txs.at(i));
+
+    EXPECT_EQ(store_->GetCount(), i + 1);
+    EXPECT_TRUE(store_->Has(txs.at(i)->digest()));
+  }
+
+  ExpectAllPresent(txs);
+}
+
+TEST_F(TransactionSegmentStoreTests, DuplicatesAreIgnored)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(3);
+
+  for (auto const &tx : txs)
+  {
+    store_->Add(*tx);
+    store_->Add(*tx);
+  }
+
+  EXPECT_EQ(store_->GetCount(), txs.size());
+}
+
+TEST_F(TransactionSegmentStoreTests, SpansMultipleSegments)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(400);
+
+  for (auto const &tx : txs)
+  {
+    store_->Add(*tx);
+  }
+
+  EXPECT_EQ(store_->GetCount(), txs.size());
+  ExpectAllPresent(txs);
+}
+
+TEST_F(TransactionSegmentStoreTests, ReloadAfterFlush)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(300);
+
+  for (auto const &tx : txs)
+  {
+    store_->Add(*tx);
+  }
+  store_->Flush();
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), txs.size());
+  ExpectAllPresent(txs);
+}
+
+TEST_F(TransactionSegmentStoreTests, RecoversRecordsAfterLastCommit)
+{
+  auto const committed = tx_gen_.GenerateRandomTxs(10);
+  for (auto const &tx : committed)
+  {
+    store_->Add(*tx);
+  }
+  store_->Flush();
+
+  // take a copy of the index as it was at the last commit
+  std::vector<char> snapshot;
+  {
+    std::ifstream input(INDEX_FILE, std::ios::binary);
+    snapshot.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  }
+
+  auto const uncommitted = tx_gen_.GenerateRandomTxs(10);
+  for (auto const &tx : uncommitted)
+  {
+    store_->Add(*tx);
+  }
+  store_.reset();
+
+  // restore the index, simulating a crash before the next group commit reached the index
+  {
+    std::ofstream output(INDEX_FILE, std::ios::binary | std::ios::trunc);
+    output.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+  }
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), committed.size() + uncommitted.size());
+  ExpectAllPresent(committed);
+  ExpectAllPresent(uncommitted);
+}
+
+TEST_F(TransactionSegmentStoreTests, TornRecordEndsRecovery)
+{
+  auto const committed = tx_gen_.GenerateRandomTxs(10);
+  for (auto const &tx : committed)
+  {
+    store_->Add(*tx);
+  }
+  store_->Flush();
+
+  std::vector<char> snapshot;
+  {
+    std::ifstream input(INDEX_FILE, std::ios::binary);
+    snapshot.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  }
+
+  auto const uncommitted = tx_gen_.GenerateRandomTxs(10);
+  for (auto const &tx : uncommitted)
+  {
+    store_->Add(*tx);
+  }
+  store_.reset();
+
+  {
+    std::ofstream output(INDEX_FILE, std::ios::binary | std::ios::trunc);
+    output.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+  }
+
+  // the tail offset of the last commit is the sixth field of the index header
+  uint64_t tail_offset{0};
+  std::memcpy(&tail_offset, snapshot.data() + 5 * sizeof(uint64_t), sizeof(tail_offset));
+
+  // simulate the payload page of the first uncommitted record never reaching the disk
+  {
+    std::fstream segment(std::string{DOC_FILE} + ".000000",
+                         std::ios::in | std::ios::out | std::ios::binary);
+
+    uint32_t length{0};
+    segment.seekg(static_cast<std::streamoff>(tail_offset));
+    segment.read(reinterpret_cast<char *>(&length), sizeof(length));
+    ASSERT_GT(length, 0u);
+
+    auto const last = static_cast<std::streamoff>(tail_offset + 8 + 32 + length - 1);
+
+    char value{0};
+    segment.seekg(last);
+    segment.get(value);
+    value = static_cast<char>(~value);
+    segment.seekp(last);
+    segment.put(value);
+  }
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), committed.size());
+  ExpectAllPresent(committed);
+
+  for (auto const &tx : uncommitted)
+  {
+    EXPECT_FALSE(store_->Has(tx->digest()));
+  }
+
+  // the archive continues from the end of the last intact record
+  store_->Add(*uncommitted.back());
+  store_->Flush();
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), committed.size() + 1);
+  ExpectAllPresent(committed);
+  EXPECT_TRUE(store_->Has(uncommitted.back()->digest()));
+}
+
+TEST_F(TransactionSegmentStoreTests, IndexGrowth)
+{
+  // start from a 16 slot index so that it has to be grown several times
+  constexpr std::size_t NUM_TXS = 500;
+
+  store_ = std::make_unique<TransactionSegmentStore>(SMALL_SEGMENT_SIZE, 4);
+  store_->New(DOC_FILE, INDEX_FILE);
+
+  auto const txs = tx_gen_.GenerateRandomTxs(NUM_TXS);
+  for (auto const &tx : txs)
+  {
+    store_->Add(*tx);
+  }
+
+  EXPECT_EQ(store_->GetCount(), NUM_TXS);
+  ExpectAllPresent(txs);
+
+  Reload();
+  EXPECT_EQ(store_->GetCount(), NUM_TXS);
+}
+
+TEST_F(TransactionSegmentStoreTests, PullSubtree)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(500);
+
+  for (auto const &tx : txs)
+  {
+    store_->Add(*tx);
+  }
+
+  for (uint64_t bit_count : {1u, 4u, 8u, 12u})
+  {
+    for (uint64_t root = 0; root < 4; ++root)
+    {
+      ByteArray prefix;
+      prefix.Resize(sizeof(uint64_t));
+      std::memcpy(prefix.pointer(), &root, sizeof(root));
+
+      uint64_t const mask = (uint64_t{1} << bit_count) - 1;
+
+      // compute the expected subtree directly
+      std::vector<fetch::byte_array::ConstByteArray> expected;
+      for (auto const &tx : txs)
+      {
+        uint64_t key{0};
+        std::memcpy(&key, tx->digest().pointer(), sizeof(key));
+
+        if ((key & mask) == (root & mask))
+        {
+          expected.push_back(tx->digest());
+        }
+      }
+
+      std::vector<fetch::byte_array::ConstByteArray> actual;
+      for (auto const &tx : store_->PullSubtree(prefix, bit_count, txs.size()))
+      {
+        actual.push_back(tx.digest());
+      }
+
+      std::sort(expected.begin(), expected.end());
+      std::sort(actual.begin(), actual.end());
+
+      EXPECT_EQ(expected, actual) << "bit_count: " << bit_count << " root: " << root;
+
+      // check the pull limit is honoured
+      EXPECT_LE(store_->PullSubtree(prefix, bit_count, 2).size(), 2u);
+    }
+  }
+}
+
+}  // namespace
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+constexpr char const *ENABLED_NAME  = "LoggingBenchEnabled";
+constexpr char const *DISABLED_NAME = "LoggingBenchDisabled";
+
+void SetUpLevels()
+{
+  fetch::SetLogLevel(ENABLED_NAME, fetch::LogLevel::INFO);
+  fetch::SetLogLevel(DISABLED_NAME, fetch::LogLevel::WARNING);
+}
+
+// The cost of a call site whose level is disabled at runtime, the message is never formatted
+void BM_LogDisabled(benchmark::State &state)
+{
+  SetUpLevels();
+
+  uint64_t    counter{0};
+  std::string payload{"some payload"};
+
+  for (auto _ : state)
+  {
+    FETCH_LOG_INFO(DISABLED_NAME, "Dispatching item: ", counter++, " payload: ", payload);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// The cost of formatting a message, as paid by every enabled log call
+void BM_FormatOnly(benchmark::State &state)
+{
+  uint64_t    counter{0};
+  std::string payload{"some payload"};
+
+  for (auto _ : state)
+  {
+    auto message = fetch::detail::Format("Dispatching item: ", counter++, " payload: ", payload);
+    benchmark::DoNotOptimize(message);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// The cost of an enabled log call on the calling thread(s). The messages are identical so that the
+// duplicate filter keeps the output quiet, the writer thread still processes every record.
+void BM_LogEnabled(benchmark::State &state)
+{
+  SetUpLevels();
+
+  std::string payload{"some payload"};
+
+  for (auto _ : state)
+  {
+    FETCH_LOG_INFO(ENABLED_NAME, "Dispatching item payload: ", payload);
+  }
+
+  fetch::FlushLogs();
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Sustained throughput including the time for the writer to drain all the records
+void BM_LogEnabledAndFlushed(benchmark::State &state)
+{
+  SetUpLevels();
+
+  auto const  batch = static_cast<std::size_t>(state.range(0));
+  std::string payload{"some payload"};
+
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < batch; ++i)
+    {
+      FETCH_LOG_INFO(ENABLED_NAME, "Dispatching item payload: ", payload);
+    }
+
+    fetch::FlushLogs();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+
+}  // namespace
+
+BENCHMARK(BM_LogDisabled);
+BENCHMARK(BM_FormatOnly);
+BENCHMARK(BM_LogEnabled)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_LogEnabledAndFlushed)->Range(64, 4096);
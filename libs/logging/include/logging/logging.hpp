@@ -19,12 +19,19 @@
 
 #include "logging/backtrace.hpp"
 
+#include <atomic>
+#include <cstring>
+#include <memory>
 #include <ostream>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
 
+namespace spdlog {
+class logger;
+}  // namespace spdlog
+
 namespace fetch {
 namespace detail {
 
@@ -76,9 +83,69 @@ enum class LogLevel
 
 using LogLevelMap = std::unordered_map<std::string, LogLevel>;
 
+namespace detail {
+class LogRegistry;
+}  // namespace detail
+
+/**
+ * Handle to a named logger
+ *
+ * Handles are owned by the log registry and live for the duration of the program, which allows
+ * them to be cached at each logging call site. The level check is a single atomic load so that
+ * disabled messages are discarded before they are formatted.
+ */
+class LogHandle
+{
+public:
+  using LoggerPtr = std::shared_ptr<spdlog::logger>;
+
+  // Construction / Destruction
+  LogHandle(std::string name, LoggerPtr logger, LogLevel level);
+  LogHandle(LogHandle const &) = delete;
+  LogHandle(LogHandle &&)      = delete;
+  ~LogHandle();
+
+  char const *name() const
+  {
+    return name_.c_str();
+  }
+
+  bool IsEnabled(LogLevel level) const
+  {
+    return level >= threshold_.load(std::memory_order_relaxed);
+  }
+
+  void Log(LogLevel level, std::string &&message);
+
+  // Operators
+  LogHandle &operator=(LogHandle const &) = delete;
+  LogHandle &operator=(LogHandle &&) = delete;
+
+private:
+  std::string const     name_;
+  LoggerPtr const       logger_;
+  std::atomic<LogLevel> level_;
+  std::atomic<LogLevel> threshold_;
+
+  friend class detail::LogRegistry;
+};
+
 /// @name Log Library Functions
 /// @{
 
+/**
+ * Lookup (or create) the handle for the specified logger
+ *
+ * @param name The name of the logger
+ * @return The handle to the logger
+ */
+LogHandle &GetLogHandle(char const *name);
+
+/**
+ * Block until all the messages logged so far have been written out
+ */
+void FlushLogs();
+
 /**
  * Configure the runtime logging level
  *
@@ -107,43 +174,86 @@ LogLevelMap GetLogLevelMap();
 
 /// @}
 
+namespace detail {
+
+/**
+ * Per call site cache of the logger handle
+ *
+ * The handle is looked up on first use, the cached handle is only replaced if the call site is
+ * used with a different logger name (e.g. a name which is a member of the calling object)
+ */
+class LogCallSite
+{
+public:
+  constexpr LogCallSite() = default;
+
+  LogHandle &Get(char const *name)
+  {
+    LogHandle *handle = handle_.load(std::memory_order_acquire);
+
+    if ((handle == nullptr) ||
+        ((handle->name() != name) && (std::strcmp(handle->name(), name) != 0)))
+    {
+      handle = &GetLogHandle(name);
+      handle_.store(handle, std::memory_order_release);
+    }
+
+    return *handle;
+  }
+
+private:
+  std::atomic<LogHandle *> handle_{nullptr};
+};
+
+template <typename... Args>
+void LogWithHandle(LogHandle &handle, LogLevel level, Args &&... args)
+{
+  // the level is checked before the message is formatted
+  if (handle.IsEnabled(level))
+  {
+    handle.Log(level, Format(std::forward<Args>(args)...));
+  }
+}
+
+}  // namespace detail
+
 /// @name Helper Wrappers
 /// @{
 
 template <typename... Args>
 void LogTraceV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::TRACE, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogWithHandle(GetLogHandle(name), LogLevel::TRACE, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 void LogDebugV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::DEBUG, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogWithHandle(GetLogHandle(name), LogLevel::DEBUG, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 void LogInfoV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::INFO, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogWithHandle(GetLogHandle(name), LogLevel::INFO, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 void LogWarningV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::WARNING, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogWithHandle(GetLogHandle(name), LogLevel::WARNING, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 void LogErrorV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::ERROR, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogWithHandle(GetLogHandle(name), LogLevel::ERROR, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 void LogCriticalV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::CRITICAL, name, detail::Format(std::forward<Args>(args)...));
+  detail::LogWithHandle(GetLogHandle(name), LogLevel::CRITICAL, std::forward<Args>(args)...);
 }
 
 /// @}
@@ -151,10 +261,18 @@ void LogCriticalV2(char const *name, Args &&... args)
 /// @name Logging Macros
 /// @{
 
+// Each call site caches its logger handle, messages are only formatted when the level is enabled
+#define FETCH_LOG_AT_LEVEL(level, name, ...)                                          \
+  do                                                                                  \
+  {                                                                                   \
+    static fetch::detail::LogCallSite fetch_log_call_site_{};                         \
+    fetch::detail::LogWithHandle(fetch_log_call_site_.Get(name), level, __VA_ARGS__); \
+  } while (false)
+
 // Trace
 #if FETCH_COMPILE_LOGGING_LEVEL >= 6
 #define FETCH_LOG_TRACE_ENABLED
-#define FETCH_LOG_TRACE(name, ...) fetch::LogTraceV2(name, __VA_ARGS__)
+#define FETCH_LOG_TRACE(name, ...) FETCH_LOG_AT_LEVEL(fetch::LogLevel::TRACE, name, __VA_ARGS__)
 #else
 #define FETCH_LOG_TRACE(name, ...) (void)name
 #endif
@@ -162,7 +280,7 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Debug
 #if FETCH_COMPILE_LOGGING_LEVEL >= 5
 #define FETCH_LOG_DEBUG_ENABLED
-#define FETCH_LOG_DEBUG(name, ...) fetch::LogDebugV2(name, __VA_ARGS__)
+#define FETCH_LOG_DEBUG(name, ...) FETCH_LOG_AT_LEVEL(fetch::LogLevel::DEBUG, name, __VA_ARGS__)
 #else
 #define FETCH_LOG_DEBUG(name, ...) (void)name
 #endif
@@ -170,7 +288,7 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Info
 #if FETCH_COMPILE_LOGGING_LEVEL >= 4
 #define FETCH_LOG_INFO_ENABLED
-#define FETCH_LOG_INFO(name, ...) fetch::LogInfoV2(name, __VA_ARGS__)
+#define FETCH_LOG_INFO(name, ...) FETCH_LOG_AT_LEVEL(fetch::LogLevel::INFO, name, __VA_ARGS__)
 #else
 #define FETCH_LOG_INFO(name, ...) (void)name
 #endif
@@ -178,7 +296,7 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Warn
 #if FETCH_COMPILE_LOGGING_LEVEL >= 3
 #define FETCH_LOG_WARN_ENABLED
-#define FETCH_LOG_WARN(name, ...) fetch::LogWarningV2(name, __VA_ARGS__)
+#define FETCH_LOG_WARN(name, ...) FETCH_LOG_AT_LEVEL(fetch::LogLevel::WARNING, name, __VA_ARGS__)
 #else
 #define FETCH_LOG_WARN(name, ...) (void)name
 #endif
@@ -186,7 +304,7 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Error
 #if FETCH_COMPILE_LOGGING_LEVEL >= 2
 #define FETCH_LOG_ERROR_ENABLED
-#define FETCH_LOG_ERROR(name, ...) fetch::LogErrorV2(name, __VA_ARGS__)
+#define FETCH_LOG_ERROR(name, ...) FETCH_LOG_AT_LEVEL(fetch::LogLevel::ERROR, name, __VA_ARGS__)
 #else
 #define FETCH_LOG_ERROR(name, ...) (void)name
 #endif
@@ -194,7 +312,8 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Critical
 #if FETCH_COMPILE_LOGGING_LEVEL >= 1
 #define FETCH_LOG_CRITICAL_ENABLED
-#define FETCH_LOG_CRITICAL(name, ...) fetch::LogCriticalV2(name, __VA_ARGS__)
+#define FETCH_LOG_CRITICAL(name, ...) \
+  FETCH_LOG_AT_LEVEL(fetch::LogLevel::CRITICAL, name, __VA_ARGS__)
 #else
 #define FETCH_LOG_CRITICAL(name, ...) (void)name
 #endif
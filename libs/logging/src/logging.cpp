@@ -40,8 +40,16 @@
 
 #include "logging/logging.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #ifdef FETCH_ENABLE_BACKTRACE
 
@@ -52,78 +60,97 @@ backward::SignalHandling         sh([](std::string const &fatal_msg) {
 
 #endif
 
+
 namespace fetch {
 namespace {
 
-class LogRegistry
+using Timestamp = std::chrono::system_clock::time_point;
+
+constexpr std::size_t               BUFFER_CAPACITY = 1024;
+constexpr std::size_t               BUFFER_MASK     = BUFFER_CAPACITY - 1u;
+constexpr std::chrono::milliseconds WRITER_IDLE_INTERVAL{100};
+
+static_assert((BUFFER_CAPACITY & BUFFER_MASK) == 0, "Buffer capacity must be a power of 2");
+
+struct LogRecord
+{
+  LogHandle const *handle{nullptr};
+  LogLevel         level{LogLevel::INFO};
+  Timestamp        timestamp{};
+  std::string      message{};
+};
+
+using LogRecords = std::vector<LogRecord>;
+
+/**
+ * Single producer, single consumer ring of log records. Each logging thread owns one buffer which
+ * is drained by the writer thread.
+ */
+class ThreadBuffer
 {
 public:
   // Construction / Destruction
-  LogRegistry();
-  LogRegistry(LogRegistry const &) = delete;
-  LogRegistry(LogRegistry &&)      = delete;
-  ~LogRegistry()                   = default;
+  ThreadBuffer()                     = default;
+  ThreadBuffer(ThreadBuffer const &) = delete;
+  ThreadBuffer(ThreadBuffer &&)      = delete;
+  ~ThreadBuffer()                    = default;
 
-  void Log(LogLevel level, char const *name, std::string &&message);
-  void SetLevel(char const *name, LogLevel level);
-  void SetGlobalLevel(LogLevel level);
+  bool TryPush(LogRecord &&record)
+  {
+    std::size_t const head = head_.load(std::memory_order_relaxed);
+    std::size_t const tail = tail_.load(std::memory_order_acquire);
 
-  LogLevelMap GetLogLevelMap();
+    if ((head - tail) >= BUFFER_CAPACITY)
+    {
+      return false;
+    }
 
-  // Operators
-  LogRegistry &operator=(LogRegistry const &) = delete;
-  LogRegistry &operator=(LogRegistry &&) = delete;
+    records_[head & BUFFER_MASK] = std::move(record);
+    head_.store(head + 1u, std::memory_order_release);
 
-  LogLevel global_level() const
-  {
-    return global_level_;
+    return true;
   }
 
-private:
-  using Logger    = spdlog::logger;
-  using LoggerPtr = std::shared_ptr<Logger>;
-  using Registry  = std::unordered_map<std::string, LoggerPtr>;
+  std::size_t Drain(LogRecords &records)
+  {
+    std::size_t const tail = tail_.load(std::memory_order_relaxed);
+    std::size_t const head = head_.load(std::memory_order_acquire);
 
-  Logger &GetLogger(char const *name);
+    for (std::size_t index = tail; index != head; ++index)
+    {
+      records.emplace_back(std::move(records_[index & BUFFER_MASK]));
+    }
 
-  std::mutex            lock_;
-  Registry              registry_;
-  std::atomic<LogLevel> global_level_{LogLevel::TRACE};
-};
+    tail_.store(head, std::memory_order_release);
 
-LogRegistry                                          registry;
-std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> COLOUR_SINK;
+    return head - tail;
+  }
 
-LogLevel ConvertToLevel(spdlog::level::level_enum level)
-{
-  LogLevel new_level = LogLevel::INFO;
+  bool empty() const
+  {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+  }
 
-  switch (level)
+  void Retire()
   {
-  case spdlog::level::trace:
-    new_level = LogLevel::TRACE;
-    break;
-  case spdlog::level::debug:
-    new_level = LogLevel::DEBUG;
-    break;
-  case spdlog::level::info:
-    new_level = LogLevel::INFO;
-    break;
-  case spdlog::level::warn:
-    new_level = LogLevel::WARNING;
-    break;
-  case spdlog::level::err:
-    new_level = LogLevel::ERROR;
-    break;
-  case spdlog::level::critical:
-    new_level = LogLevel::CRITICAL;
-    break;
-  case spdlog::level::off:
-    break;
+    retired_ = true;
   }
 
-  return new_level;
-}
+  bool retired() const
+  {
+    return retired_;
+  }
+
+  // Operators
+  ThreadBuffer &operator=(ThreadBuffer const &) = delete;
+  ThreadBuffer &operator=(ThreadBuffer &&) = delete;
+
+private:
+  std::vector<LogRecord>   records_ = std::vector<LogRecord>(BUFFER_CAPACITY);
+  std::atomic<std::size_t> head_{0};
+  std::atomic<std::size_t> tail_{0};
+  std::atomic<bool>        retired_{false};
+};
 
 spdlog::level::level_enum ConvertFromLevel(LogLevel level)
 {
@@ -154,17 +181,145 @@ spdlog::level::level_enum ConvertFromLevel(LogLevel level)
   return new_level;
 }
 
-LogRegistry::LogRegistry() = default;
+}  // namespace
+
+namespace detail {
 
-void LogRegistry::Log(LogLevel level, char const *name, std::string &&message)
+/**
+ * The registry of loggers and the asynchronous backend which writes out their messages
+ *
+ * Logging threads push formatted records into their own lock free buffer, a single writer thread
+ * drains all the buffers and writes the records (in timestamp order) through the loggers. Errors
+ * and critical messages are flushed before the logging call returns.
+ */
+class LogRegistry
+{
+public:
+  // Construction / Destruction
+  LogRegistry();
+  LogRegistry(LogRegistry const &) = delete;
+  LogRegistry(LogRegistry &&)      = delete;
+  ~LogRegistry();
+
+  LogHandle &GetHandle(char const *name);
+  void       Enqueue(LogHandle const &handle, LogLevel level, std::string &&message);
+  void       Flush();
+
+  void SetLevel(char const *name, LogLevel level);
+  void SetGlobalLevel(LogLevel level);
+
+  LogLevelMap GetLogLevelMap();
+
+  // Operators
+  LogRegistry &operator=(LogRegistry const &) = delete;
+  LogRegistry &operator=(LogRegistry &&) = delete;
+
+private:
+  using HandlePtr  = std::unique_ptr<LogHandle>;
+  using Handles    = std::unordered_map<std::string, HandlePtr>;
+  using SinkPtr    = std::shared_ptr<spdlog::sinks::stdout_color_sink_mt>;
+  using BufferPtr  = std::shared_ptr<ThreadBuffer>;
+  using Buffers    = std::vector<BufferPtr>;
+  using Generation = uint64_t;
+
+  LogHandle &LookupHandle(char const *name);
+  void       UpdateThreshold(LogHandle &handle);
+
+  ThreadBuffer &LocalBuffer();
+  void          WakeWriter();
+  void          Writer();
+  bool          Drain(LogRecords &records);
+  bool          HasPending();
+
+  // loggers
+  std::mutex            lock_;
+  Handles               handles_;
+  SinkPtr               colour_sink_;
+  std::atomic<LogLevel> global_level_{LogLevel::TRACE};
+
+  // per thread buffers
+  std::mutex buffers_lock_;
+  Buffers    buffers_;
+
+  // writer
+  std::mutex              writer_lock_;
+  std::condition_variable writer_cv_;
+  std::condition_variable flushed_cv_;
+  std::atomic<bool>       writer_sleeping_{false};
+  bool                    running_{true};
+  Generation              flush_requested_{0};
+  Generation              flush_completed_{0};
+  std::thread             writer_;
+};
+
+LogRegistry &Registry()
+{
+  static LogRegistry registry;
+  return registry;
+}
+
+LogRegistry::LogRegistry()
+  : writer_{&LogRegistry::Writer, this}
+{}
+
+LogRegistry::~LogRegistry()
 {
-  if (level < global_level_)
   {
-    return;
+    std::lock_guard<std::mutex> guard(writer_lock_);
+    running_ = false;
   }
 
+  // the writer will drain all the buffers before exiting
+  writer_cv_.notify_all();
+  writer_.join();
+}
+
+LogHandle &LogRegistry::GetHandle(char const *name)
+{
   std::lock_guard<std::mutex> guard(lock_);
-  GetLogger(name).log(ConvertFromLevel(level), message);
+  return LookupHandle(name);
+}
+
+void LogRegistry::Enqueue(LogHandle const &handle, LogLevel level, std::string &&message)
+{
+  LogRecord record{&handle, level, std::chrono::system_clock::now(), std::move(message)};
+
+  auto &buffer = LocalBuffer();
+  while (!buffer.TryPush(std::move(record)))
+  {
+    // the buffer is full, apply back pressure until the writer catches up
+    WakeWriter();
+    std::this_thread::yield();
+  }
+
+  // make the record visible before checking if the writer is asleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (writer_sleeping_.load(std::memory_order_relaxed))
+  {
+    WakeWriter();
+  }
+
+  // the process might be about to terminate after errors, make sure they are written out
+  if (level >= LogLevel::ERROR)
+  {
+    Flush();
+  }
+}
+
+void LogRegistry::Flush()
+{
+  std::unique_lock<std::mutex> lock(writer_lock_);
+
+  if (!running_)
+  {
+    return;
+  }
+
+  Generation const generation = ++flush_requested_;
+  writer_cv_.notify_all();
+
+  flushed_cv_.wait(lock, [this, generation]() { return flush_completed_ >= generation; });
 }
 
 void LogRegistry::SetLevel(char const *name, LogLevel level)
@@ -172,18 +327,22 @@ void LogRegistry::SetLevel(char const *name, LogLevel level)
   std::lock_guard<std::mutex> guard(lock_);
 
   // Ensure logger exists to avoid races with setting level
-  GetLogger(name);
+  auto &handle = LookupHandle(name);
 
-  auto it = registry_.find(name);
-  if (it != registry_.end())
-  {
-    it->second->set_level(ConvertFromLevel(level));
-  }
+  handle.level_ = level;
+  UpdateThreshold(handle);
 }
 
 void LogRegistry::SetGlobalLevel(LogLevel level)
 {
+  std::lock_guard<std::mutex> guard(lock_);
+
   global_level_ = level;
+
+  for (auto &element : handles_)
+  {
+    UpdateThreshold(*element.second);
+  }
 }
 
 LogLevelMap LogRegistry::GetLogLevelMap()
@@ -191,66 +350,235 @@ LogLevelMap LogRegistry::GetLogLevelMap()
   std::lock_guard<std::mutex> guard(lock_);
 
   LogLevelMap level_map{};
-  level_map.reserve(registry_.size());
+  level_map.reserve(handles_.size());
 
-  for (auto const &element : registry_)
+  for (auto const &element : handles_)
   {
-    level_map[element.first] = ConvertToLevel(element.second->level());
+    level_map[element.first] = element.second->level_;
   }
 
   return level_map;
 }
 
-LogRegistry::Logger &LogRegistry::GetLogger(char const *name)
+LogHandle &LogRegistry::LookupHandle(char const *name)
 {
-  auto it = registry_.find(name);
-  if (it == registry_.end())
+  auto it = handles_.find(name);
+  if (it == handles_.end())
   {
     // create the new logger instance - note it suppresses duplicate messages
     auto dup_filter =
         std::make_shared<spdlog::sinks::dup_filter_sink_mt>(std::chrono::milliseconds(100));
 
-    if (!COLOUR_SINK)
+    if (!colour_sink_)
     {
-      COLOUR_SINK = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+      colour_sink_ = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     }
 
-    dup_filter->add_sink(COLOUR_SINK);
+    dup_filter->add_sink(colour_sink_);
 
     auto logger = std::make_shared<spdlog::logger>(name, dup_filter);
 
-    logger->set_level(ConvertFromLevel(global_level()));
+    // the level is applied at the call site, by the time the record is written out the level of the
+    // logger may have been changed
+    logger->set_level(spdlog::level::trace);
     logger->set_pattern("%^[%L]%$ %Y/%m/%d %T | %-30n : %v");
 
     // keep a reference of it
-    registry_[name] = logger;
-
-    return *logger;
+    auto handle = std::make_unique<LogHandle>(name, std::move(logger), global_level_);
+    it          = handles_.emplace(name, std::move(handle)).first;
   }
 
   return *(it->second);
 }
 
-}  // namespace
+/**
+ * Recalculate the level below which messages are discarded at the call site (lock must be held)
+ */
+void LogRegistry::UpdateThreshold(LogHandle &handle)
+{
+  handle.threshold_ = std::max(global_level_.load(), handle.level_.load());
+}
+
+ThreadBuffer &LogRegistry::LocalBuffer()
+{
+  struct LocalBuffer
+  {
+    ~LocalBuffer()
+    {
+      // the buffer is released by the writer once it has been drained
+      if (buffer)
+      {
+        buffer->Retire();
+      }
+    }
+
+    BufferPtr buffer{};
+  };
+
+  thread_local LocalBuffer local{};
+
+  if (!local.buffer)
+  {
+    local.buffer = std::make_shared<ThreadBuffer>();
+
+    std::lock_guard<std::mutex> guard(buffers_lock_);
+    buffers_.emplace_back(local.buffer);
+  }
+
+  return *local.buffer;
+}
+
+void LogRegistry::WakeWriter()
+{
+  std::lock_guard<std::mutex> guard(writer_lock_);
+  writer_cv_.notify_one();
+}
+
+void LogRegistry::Writer()
+{
+  LogRecords records{};
+
+  std::unique_lock<std::mutex> lock(writer_lock_);
+  for (;;)
+  {
+    Generation const generation = flush_requested_;
+    bool const       stopping   = !running_;
+    lock.unlock();
+
+    // write out everything which has been logged so far, in order
+    bool const written = Drain(records);
+
+    lock.lock();
+
+    if (generation > flush_completed_)
+    {
+      flush_completed_ = generation;
+      flushed_cv_.notify_all();
+    }
+
+    if (stopping)
+    {
+      break;
+    }
+
+    if (!written && running_ && (flush_requested_ == generation))
+    {
+      writer_sleeping_ = true;
+
+      // catch any record which was pushed before the writer was marked as asleep
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      lock.unlock();
+      bool const pending = HasPending();
+      lock.lock();
+
+      if (!pending && running_ && (flush_requested_ == generation))
+      {
+        writer_cv_.wait_for(lock, WRITER_IDLE_INTERVAL);
+      }
+
+      writer_sleeping_ = false;
+    }
+  }
+}
+
+bool LogRegistry::Drain(LogRecords &records)
+{
+  records.clear();
+
+  {
+    std::lock_guard<std::mutex> guard(buffers_lock_);
+
+    auto it = buffers_.begin();
+    while (it != buffers_.end())
+    {
+      auto &buffer = *it;
+
+      // check for retirement before draining so that no record can be missed
+      bool const retired = buffer->retired();
+      buffer->Drain(records);
+
+      if (retired)
+      {
+        it = buffers_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  // records are ordered per thread, merge them into a single timeline
+  std::stable_sort(records.begin(), records.end(), [](LogRecord const &a, LogRecord const &b) {
+    return a.timestamp < b.timestamp;
+  });
+
+  for (auto &record : records)
+  {
+    record.handle->logger_->log(ConvertFromLevel(record.level), record.message);
+  }
+
+  return !records.empty();
+}
+
+bool LogRegistry::HasPending()
+{
+  std::lock_guard<std::mutex> guard(buffers_lock_);
+
+  return std::any_of(buffers_.begin(), buffers_.end(),
+                     [](BufferPtr const &buffer) { return !buffer->empty(); });
+}
+
+}  // namespace detail
+
+LogHandle::LogHandle(std::string name, LoggerPtr logger, LogLevel level)
+  : name_{std::move(name)}
+  , logger_{std::move(logger)}
+  , level_{level}
+  , threshold_{level}
+{}
+
+LogHandle::~LogHandle() = default;
+
+void LogHandle::Log(LogLevel level, std::string &&message)
+{
+  detail::Registry().Enqueue(*this, level, std::move(message));
+}
+
+LogHandle &GetLogHandle(char const *name)
+{
+  return detail::Registry().GetHandle(name);
+}
+
+void FlushLogs()
+{
+  detail::Registry().Flush();
+}
 
 void SetLogLevel(char const *name, LogLevel level)
 {
-  registry.SetLevel(name, level);
+  detail::Registry().SetLevel(name, level);
 }
 
 void SetGlobalLogLevel(LogLevel level)
 {
-  registry.SetGlobalLevel(level);
+  detail::Registry().SetGlobalLevel(level);
 }
 
 void Log(LogLevel level, char const *name, std::string &&message)
 {
-  registry.Log(level, name, std::move(message));
+  auto &handle = GetLogHandle(name);
+
+  if (handle.IsEnabled(level))
+  {
+    handle.Log(level, std::move(message));
+  }
 }
 
 LogLevelMap GetLogLevelMap()
 {
-  return registry.GetLogLevelMap();
+  return detail::Registry().GetLogLevelMap();
 }
 
 }  // namespace fetch
@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::LogLevel;
+using fetch::detail::LogCallSite;
+using fetch::detail::LogWithHandle;
+
+/**
+ * Argument which counts the number of times it has been formatted
+ */
+struct CountedArgument
+{
+  std::atomic<std::size_t> &count;
+};
+
+std::ostream &operator<<(std::ostream &stream, CountedArgument const &argument)
+{
+  ++argument.count;
+  return stream << "counted";
+}
+
+// a single call site, as generated by the logging macros, used with a number of logger names
+template <typename... Args>
+void LogFromCallSite(LogLevel level, char const *name, Args &&... args)
+{
+  static LogCallSite call_site{};
+  LogWithHandle(call_site.Get(name), level, std::forward<Args>(args)...);
+}
+
+std::size_t CountOccurrences(std::string const &text, std::string const &pattern)
+{
+  std::size_t count{0};
+
+  auto pos = text.find(pattern);
+  while (pos != std::string::npos)
+  {
+    ++count;
+    pos = text.find(pattern, pos + pattern.size());
+  }
+
+  return count;
+}
+
+class LoggingTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // make sure no output of a previous test is captured
+    fetch::FlushLogs();
+    ::testing::internal::CaptureStdout();
+  }
+
+  void TearDown() override
+  {
+    if (capturing_)
+    {
+      ::testing::internal::GetCapturedStdout();
+    }
+  }
+
+  std::string Output(bool flush = true)
+  {
+    if (flush)
+    {
+      fetch::FlushLogs();
+    }
+
+    capturing_ = false;
+    return ::testing::internal::GetCapturedStdout();
+  }
+
+private:
+  bool capturing_{true};
+};
+
+TEST_F(LoggingTests, ErrorsAreWrittenBeforeTheCallReturns)
+{
+  fetch::LogInfoV2("LoggingTests.Flush", "queued-before-error");
+  fetch::LogErrorV2("LoggingTests.Flush", "error-is-flushed");
+
+  auto const output = Output(false);
+
+  // the error flushes everything which was queued before it
+  auto const queued = output.find("queued-before-error");
+  auto const error  = output.find("error-is-flushed");
+
+  ASSERT_NE(queued, std::string::npos);
+  ASSERT_NE(error, std::string::npos);
+  EXPECT_LT(queued, error);
+}
+
+TEST_F(LoggingTests, PerThreadRecordsAreAllWrittenInOrder)
+{
+  // more records than fit in a thread buffer, so that the producers have to wait for the writer
+  constexpr std::size_t NUM_THREADS = 4;
+  constexpr std::size_t NUM_RECORDS = 3000;
+
+  std::vector<std::thread> threads;
+  for (std::size_t thread = 0; thread < NUM_THREADS; ++thread)
+  {
+    threads.emplace_back([thread]() {
+      for (std::size_t record = 0; record < NUM_RECORDS; ++record)
+      {
+        fetch::LogInfoV2("LoggingTests.Threads", "thread-", thread, "-record-", record, ";");
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  auto const output = Output();
+
+  for (std::size_t thread = 0; thread < NUM_THREADS; ++thread)
+  {
+    std::size_t previous{0};
+    for (std::size_t record = 0; record < NUM_RECORDS; ++record)
+    {
+      auto const text =
+          "thread-" + std::to_string(thread) + "-record-" + std::to_string(record) + ";";
+      auto const pos = output.find(text);
+
+      ASSERT_NE(pos, std::string::npos) << text;
+      ASSERT_GE(pos, previous) << text;
+      previous = pos;
+    }
+  }
+}
+
+TEST_F(LoggingTests, LevelsAreAppliedAtEachCallSite)
+{
+  std::atomic<std::size_t> formatted{0};
+
+  fetch::SetLogLevel("LoggingTests.Quiet", LogLevel::WARNING);
+  fetch::SetLogLevel("LoggingTests.Verbose", LogLevel::INFO);
+
+  EXPECT_FALSE(fetch::GetLogHandle("LoggingTests.Quiet").IsEnabled(LogLevel::INFO));
+  EXPECT_TRUE(fetch::GetLogHandle("LoggingTests.Quiet").IsEnabled(LogLevel::WARNING));
+
+  // the call site caches its handle, but follows a change of logger name
+  LogFromCallSite(LogLevel::INFO, "LoggingTests.Quiet", "quiet-info ", CountedArgument{formatted});
+  LogFromCallSite(LogLevel::INFO, "LoggingTests.Verbose", "verbose-info ",
+                  CountedArgument{formatted});
+  LogFromCallSite(LogLevel::WARNING, "LoggingTests.Quiet", "quiet-warning ",
+                  CountedArgument{formatted});
+
+  // discarded messages are never formatted
+  EXPECT_EQ(2, formatted);
+
+  // the cached handle sees a later change of level
+  fetch::SetLogLevel("LoggingTests.Quiet", LogLevel::TRACE);
+  LogFromCallSite(LogLevel::INFO, "LoggingTests.Quiet", "quiet-info-enabled");
+
+  // the global level overrides a lower level of the logger
+  fetch::SetGlobalLogLevel(LogLevel::ERROR);
+  LogFromCallSite(LogLevel::WARNING, "LoggingTests.Quiet", "quiet-warning-global");
+  fetch::SetGlobalLogLevel(LogLevel::TRACE);
+
+  auto const output = Output();
+
+  EXPECT_EQ(std::string::npos, output.find("quiet-info "));
+  EXPECT_NE(std::string::npos, output.find("verbose-info "));
+  EXPECT_NE(std::string::npos, output.find("quiet-warning "));
+  EXPECT_NE(std::string::npos, output.find("quiet-info-enabled"));
+  EXPECT_EQ(std::string::npos, output.find("quiet-warning-global"));
+
+  // the configured level is reported, not the effective threshold
+  auto const levels = fetch::GetLogLevelMap();
+  EXPECT_EQ(LogLevel::TRACE, levels.at("LoggingTests.Quiet"));
+  EXPECT_EQ(LogLevel::INFO, levels.at("LoggingTests.Verbose"));
+}
+
+TEST_F(LoggingTests, RepeatedMessagesAreFiltered)
+{
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    fetch::LogInfoV2("LoggingTests.Duplicates", "repeated-message");
+  }
+
+  fetch::LogInfoV2("LoggingTests.Duplicates", "different-message");
+
+  auto const output = Output();
+
+  EXPECT_EQ(1, CountOccurrences(output, "repeated-message"));
+  EXPECT_EQ(1, CountOccurrences(output, "different-message"));
+}
+
+}  // namespace
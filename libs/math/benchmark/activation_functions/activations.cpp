@@ -21,14 +21,37 @@
 #include "math/activation_functions/relu.hpp"
 #include "math/activation_functions/sigmoid.hpp"
 #include "math/activation_functions/softmax.hpp"
+#include "math/standard_functions/exp.hpp"
+#include "math/standard_functions/log.hpp"
+#include "math/standard_functions/sqrt.hpp"
 #include "math/tensor/tensor.hpp"
+#include "math/trigonometry.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
 
 #include "benchmark/benchmark.h"
 
 #include <sstream>
+#include <string>
 
 using namespace fetch::math;
 
+using fp32_t = fetch::fixed_point::fp32_t;
+using fp64_t = fetch::fixed_point::fp64_t;
+
+// Spread the inputs over [from, to) so that the fixed point functions take their general path
+template <typename T>
+void FillRange(Tensor<T> &tensor, double from, double to)
+{
+  SizeType const count = tensor.size();
+  SizeType       i     = 0;
+  for (auto &x : tensor)
+  {
+    double const value = from + (to - from) * static_cast<double>(i) / static_cast<double>(count);
+    x                  = Type<T>(std::to_string(value));
+    ++i;
+  }
+}
+
 template <typename T, SizeType L, SizeType H, SizeType W>
 void BM_Elu(benchmark::State &state)
 {
@@ -104,6 +127,7 @@ void BM_Sigmoid(benchmark::State &state)
 {
   Tensor<T> input({L, H, W});
   Tensor<T> output({L, H, W});
+  FillRange(input, -8.0, 8.0);
 
   for (auto _ : state)
   {
@@ -123,6 +147,91 @@ BENCHMARK_TEMPLATE(BM_Sigmoid, int, 256, 256, 256)->Unit(benchmark::kMillisecond
 BENCHMARK_TEMPLATE(BM_Sigmoid, float, 256, 256, 256)->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_Sigmoid, double, 256, 256, 256)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp32_t, 2, 2, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp64_t, 2, 2, 2)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType H, SizeType W>
+void BM_TanH(benchmark::State &state)
+{
+  Tensor<T> input({H, W});
+  Tensor<T> output({H, W});
+  FillRange(input, -8.0, 8.0);
+
+  for (auto _ : state)
+  {
+    TanH(input, output);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_TanH, float, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp32_t, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp64_t, 128, 128)->Unit(benchmark::kMicrosecond);
+
+template <typename T, SizeType H, SizeType W>
+void BM_Exp(benchmark::State &state)
+{
+  Tensor<T> input({H, W});
+  Tensor<T> output({H, W});
+  FillRange(input, -8.0, 8.0);
+
+  for (auto _ : state)
+  {
+    Exp(input, output);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_Exp, float, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Exp, fp32_t, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Exp, fp64_t, 128, 128)->Unit(benchmark::kMicrosecond);
+
+template <typename T, SizeType H, SizeType W>
+void BM_Log(benchmark::State &state)
+{
+  Tensor<T> input({H, W});
+  Tensor<T> output({H, W});
+  FillRange(input, 0.01, 100.0);
+
+  for (auto _ : state)
+  {
+    Log(input, output);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_Log, float, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Log, fp32_t, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Log, fp64_t, 128, 128)->Unit(benchmark::kMicrosecond);
+
+template <typename T, SizeType H, SizeType W>
+void BM_Sqrt(benchmark::State &state)
+{
+  Tensor<T> input({H, W});
+  Tensor<T> output({H, W});
+  FillRange(input, 0.01, 100.0);
+
+  for (auto _ : state)
+  {
+    Sqrt(input, output);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_Sqrt, float, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Sqrt, fp32_t, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Sqrt, fp64_t, 128, 128)->Unit(benchmark::kMicrosecond);
+
 template <typename T, SizeType L, SizeType H>
 void BM_Softmax(benchmark::State &state)
 {
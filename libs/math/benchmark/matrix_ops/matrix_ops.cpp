@@ -713,4 +713,91 @@ BENCHMARK_TEMPLATE(BM_DynamicStitch, fetch::fixed_point::FixedPoint<16, 16>, 256
 BENCHMARK_TEMPLATE(BM_DynamicStitch, fetch::fixed_point::FixedPoint<32, 32>, 256, 256, 256)
     ->Unit(benchmark::kMillisecond);
 
+template <class T, int M, int N, int K>
+void SetGemmCounters(benchmark::State &state)
+{
+  // one multiply and one add per inner product term
+  double const flops_per_call = 2.0 * static_cast<double>(M) * N * K;
+  state.counters["GFLOP/s"]   = benchmark::Counter(
+      static_cast<double>(state.iterations()) * flops_per_call / 1e9, benchmark::Counter::kIsRate);
+}
+
+template <class T, int M, int N, int K>
+void BM_Dot(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{M, K});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{K, N});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{M, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::Dot(a, b, ret);
+  }
+
+  SetGemmCounters<T, M, N, K>(state);
+}
+
+BENCHMARK_TEMPLATE(BM_Dot, float, 64, 64, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Dot, double, 64, 64, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Dot, float, 256, 256, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Dot, double, 256, 256, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Dot, fetch::fixed_point::FixedPoint<32, 32>, 256, 256, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Dot, float, 1024, 1024, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Dot, double, 1024, 1024, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Dot, float, 2048, 64, 2048)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Dot, double, 2048, 64, 2048)->Unit(benchmark::kMillisecond);
+
+template <class T, int M, int N, int K>
+void BM_DotTranspose(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{M, K});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{N, K});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{M, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::DotTranspose(a, b, ret);
+  }
+
+  SetGemmCounters<T, M, N, K>(state);
+}
+
+BENCHMARK_TEMPLATE(BM_DotTranspose, float, 256, 256, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DotTranspose, double, 256, 256, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DotTranspose, float, 1024, 1024, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DotTranspose, double, 1024, 1024, 1024)->Unit(benchmark::kMillisecond);
+
+template <class T, int M, int N, int K>
+void BM_TransposeDot(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{K, M});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{K, N});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{M, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::TransposeDot(a, b, ret);
+  }
+
+  SetGemmCounters<T, M, N, K>(state);
+}
+
+BENCHMARK_TEMPLATE(BM_TransposeDot, float, 256, 256, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TransposeDot, double, 256, 256, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TransposeDot, float, 1024, 1024, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TransposeDot, double, 1024, 1024, 1024)->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
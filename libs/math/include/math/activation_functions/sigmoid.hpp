@@ -19,6 +19,7 @@
 
 #include "math/fundamental_operators.hpp"
 #include "math/standard_functions/exp.hpp"
+#include "math/standard_functions/fixed_point_kernel.hpp"
 
 namespace fetch {
 namespace math {
@@ -30,7 +31,7 @@ namespace math {
  * @param ret
  */
 template <typename ArrayType>
-void Sigmoid(ArrayType const &t, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Sigmoid(ArrayType const &t, ArrayType &ret)
 {
   using Type = typename ArrayType::Type;
 
@@ -55,6 +56,14 @@ void Sigmoid(ArrayType const &t, ArrayType &ret)
   }
 }
 
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Sigmoid(ArrayType const &t, ArrayType &ret)
+{
+  using Type = typename ArrayType::Type;
+  details::ApplyFixedPointKernel(
+      t, ret, [](Type const *x, Type *y, SizeType n) { vectorise::Sigmoid(x, y, n); });
+}
+
 template <typename ArrayType>
 ArrayType Sigmoid(ArrayType const &t)
 {
@@ -0,0 +1,56 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Cache blocked, packed general matrix multiplication
+ *
+ *   C = alpha * op(A) * op(B) + beta * C
+ *
+ * where op(X) is either X or X.T. The implementation follows the usual
+ * Goto / BLIS structure: op(B) is packed in KC x NC panels (sized for the
+ * L3 cache), op(A) in MC x KC blocks (sized for the L2 cache) and a
+ * register blocked MR x NR micro-kernel streams through the packed
+ * panels out of the L1 cache. Large products are split over threads.
+ *
+ * Only float and double are supported. For all other types, and for
+ * products too small to amortise the packing, PackedGemm returns false
+ * and the caller is expected to fall back to its own implementation.
+ */
+
+#include "math/tensor/tensor_view.hpp"
+
+namespace fetch {
+namespace math {
+namespace linalg {
+
+bool PackedGemm(bool transpose_a, bool transpose_b, float alpha, TensorView<float> a,
+                TensorView<float> b, float beta, TensorView<float> c);
+
+bool PackedGemm(bool transpose_a, bool transpose_b, double alpha, TensorView<double> a,
+                TensorView<double> b, double beta, TensorView<double> c);
+
+template <typename T>
+bool PackedGemm(bool /*transpose_a*/, bool /*transpose_b*/, T /*alpha*/, TensorView<T> /*a*/,
+                TensorView<T> /*b*/, T /*beta*/, TensorView<T> /*c*/)
+{
+  return false;
+}
+
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/fixed_point_kernel.hpp"
 #include "vectorise/fixed_point/fixed_point.hpp"
 
 #include <cassert>
@@ -61,7 +62,7 @@ meta::IfIsArithmetic<Type, Type> Exp(Type const &x)
 }
 
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
 {
   assert(ret.shape() == array.shape());
   auto it1 = array.cbegin();
@@ -74,6 +75,15 @@ meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
   }
 }
 
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+{
+  using Type = typename ArrayType::Type;
+  assert(ret.shape() == array.shape());
+  details::ApplyFixedPointKernel(
+      array, ret, [](Type const *x, Type *y, SizeType n) { vectorise::Exp(x, y, n); });
+}
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> Exp(ArrayType const &array)
 {
@@ -0,0 +1,65 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "vectorise/math/fixed_point_functions.hpp"
+
+namespace fetch {
+namespace math {
+namespace details {
+
+/**
+ * Applies a contiguous fixed point kernel, e.g. vectorise::Exp, to every element of array.
+ *
+ * Tensor columns are padded and often short, so the values are gathered into blocks which give
+ * the kernel enough elements to fill its registers regardless of the shape.
+ * @param array input
+ * @param ret output of the same size, may be the same array as the input
+ * @param kernel callable taking (input pointer, output pointer, count)
+ */
+template <typename ArrayType, typename Kernel>
+void ApplyFixedPointKernel(ArrayType const &array, ArrayType &ret, Kernel const &kernel)
+{
+  using Type = typename ArrayType::Type;
+
+  static constexpr SizeType BLOCK_SIZE = 256;
+  Type                      block[BLOCK_SIZE];
+
+  auto it  = array.cbegin();
+  auto rit = ret.begin();
+  while (it.is_valid())
+  {
+    SizeType count = 0;
+    for (; (count < BLOCK_SIZE) && it.is_valid(); ++count, ++it)
+    {
+      block[count] = *it;
+    }
+
+    kernel(block, block, count);
+
+    for (SizeType i = 0; i < count; ++i, ++rit)
+    {
+      *rit = block[i];
+    }
+  }
+}
+
+}  // namespace details
+}  // namespace math
+}  // namespace fetch
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/fixed_point_kernel.hpp"
 
 #include <cassert>
 
@@ -85,7 +86,7 @@ meta::IfIsArithmetic<Type, Type> Log(Type const &x)
 }
 
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Log(ArrayType const &array, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Log(ArrayType const &array, ArrayType &ret)
 {
   assert(ret.shape() == array.shape());
   auto it1 = array.cbegin();
@@ -98,6 +99,15 @@ meta::IfIsMathArray<ArrayType, void> Log(ArrayType const &array, ArrayType &ret)
   }
 }
 
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Log(ArrayType const &array, ArrayType &ret)
+{
+  using Type = typename ArrayType::Type;
+  assert(ret.shape() == array.shape());
+  details::ApplyFixedPointKernel(
+      array, ret, [](Type const *x, Type *y, SizeType n) { vectorise::Log(x, y, n); });
+}
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> Log(ArrayType const &array)
 {
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/fixed_point_kernel.hpp"
 
 #include <cassert>
 
@@ -55,7 +56,7 @@ meta::IfIsArithmetic<Type, Type> Sqrt(Type const &x)
 }
 
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Sqrt(ArrayType const &array, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Sqrt(ArrayType const &array, ArrayType &ret)
 {
   assert(ret.shape() == array.shape());
   auto arr_it = array.cbegin();
@@ -69,6 +70,15 @@ meta::IfIsMathArray<ArrayType, void> Sqrt(ArrayType const &array, ArrayType &ret
   }
 }
 
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Sqrt(ArrayType const &array, ArrayType &ret)
+{
+  using Type = typename ArrayType::Type;
+  assert(ret.shape() == array.shape());
+  details::ApplyFixedPointKernel(
+      array, ret, [](Type const *x, Type *y, SizeType n) { vectorise::Sqrt(x, y, n); });
+}
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> Sqrt(ArrayType const &array)
 {
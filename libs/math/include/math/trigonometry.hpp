@@ -19,6 +19,7 @@
 
 #include "math/kernels/trigonometry.hpp"
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/fixed_point_kernel.hpp"
 
 #include <cassert>
 
@@ -245,7 +246,8 @@ fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> CosH(ArrayType const &x)
  * @param x - array
  */
 template <typename ArrayType>
-fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, ArrayType &ret)
+fetch::math::meta::IfIsMathNonFixedPointArray<ArrayType, void> TanH(ArrayType const &x,
+                                                                    ArrayType &      ret)
 {
   assert(ret.size() == x.size());
   kernels::TanH s;
@@ -259,6 +261,16 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, Array
   }
 }
 
+template <typename ArrayType>
+fetch::math::meta::IfIsMathFixedPointArray<ArrayType, void> TanH(ArrayType const &x,
+                                                                 ArrayType &      ret)
+{
+  using Type = typename ArrayType::Type;
+  assert(ret.size() == x.size());
+  details::ApplyFixedPointKernel(
+      x, ret, [](Type const *in, Type *out, SizeType n) { vectorise::TanH(in, out, n); });
+}
+
 template <typename ArrayType>
 fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> TanH(ArrayType const &x)
 {
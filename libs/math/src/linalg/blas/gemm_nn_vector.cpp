@@ -19,6 +19,7 @@
 #include "math/linalg/blas/gemm_nn_vector.hpp"
 
 #include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_packed.hpp"
 #include "math/linalg/prototype.hpp"
 #include "math/tensor/tensor_view.hpp"
 
@@ -73,6 +74,11 @@ void Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
     return;
   }
 
+  if (PackedGemm(false, false, alpha, a, b, beta, c))
+  {
+    return;
+  }
+
   for (j = 0; j < c.width(); ++j)
   {
     std::size_t l;
@@ -0,0 +1,513 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/gemm_packed.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace math {
+namespace linalg {
+namespace {
+
+/**
+ * Blocking parameters. MR x NR is the register tile computed by the micro-kernel (two AVX
+ * registers high and six columns wide, i.e. 12 accumulators). KC x NR panels of B stay in L1,
+ * MC x KC blocks of A in L2 and KC x NC panels of B in L3.
+ */
+template <typename T>
+struct GemmBlocking;
+
+template <>
+struct GemmBlocking<float>
+{
+  static constexpr std::size_t MR = 16;
+  static constexpr std::size_t NR = 6;
+  static constexpr std::size_t KC = 256;
+  static constexpr std::size_t MC = 144;
+  static constexpr std::size_t NC = 2040;
+};
+
+template <>
+struct GemmBlocking<double>
+{
+  static constexpr std::size_t MR = 8;
+  static constexpr std::size_t NR = 6;
+  static constexpr std::size_t KC = 256;
+  static constexpr std::size_t MC = 96;
+  static constexpr std::size_t NC = 1020;
+};
+
+// Products smaller than this (in multiply-adds) are left to the unpacked implementations
+constexpr std::size_t PACKED_MIN_WORK = 16 * 16 * 16;
+
+// Products larger than this (in multiply-adds) are split across the thread pool
+constexpr std::size_t THREADED_MIN_WORK = 128 * 128 * 128;
+
+/**
+ * Column major operand with an optional transpose, addressed as op(X)(row, col)
+ */
+template <typename T>
+struct Operand
+{
+  T const *   data;
+  std::size_t row_stride;
+  std::size_t col_stride;
+
+  Operand(T const *d, std::size_t leading_dimension, bool transposed)
+    : data{d}
+    , row_stride{transposed ? leading_dimension : 1}
+    , col_stride{transposed ? 1 : leading_dimension}
+  {}
+
+  Operand Offset(std::size_t row, std::size_t col) const
+  {
+    Operand ret{*this};
+    ret.data += (row * row_stride) + (col * col_stride);
+    return ret;
+  }
+
+  T operator()(std::size_t row, std::size_t col) const
+  {
+    return data[(row * row_stride) + (col * col_stride)];
+  }
+};
+
+/**
+ * Packs an mc x kc block of op(A) into MR high micro-panels, each stored k-major so the
+ * micro-kernel reads MR contiguous values per step. Rows beyond mc are zero padded.
+ */
+template <typename T>
+void PackA(Operand<T> const &a, std::size_t mc, std::size_t kc, T *buffer)
+{
+  constexpr std::size_t MR = GemmBlocking<T>::MR;
+
+  for (std::size_t ir = 0; ir < mc; ir += MR)
+  {
+    std::size_t const rows  = std::min(MR, mc - ir);
+    T *               panel = buffer + (ir * kc);
+
+    if (a.row_stride == 1)
+    {
+      for (std::size_t p = 0; p < kc; ++p)
+      {
+        T const *   src = a.data + ir + (p * a.col_stride);
+        T *         dst = panel + (p * MR);
+        std::size_t i   = 0;
+        for (; i < rows; ++i)
+        {
+          dst[i] = src[i];
+        }
+        for (; i < MR; ++i)
+        {
+          dst[i] = T{0};
+        }
+      }
+    }
+    else
+    {
+      for (std::size_t i = 0; i < MR; ++i)
+      {
+        for (std::size_t p = 0; p < kc; ++p)
+        {
+          panel[(p * MR) + i] = (i < rows) ? a(ir + i, p) : T{0};
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Packs a kc x nc panel of op(B) into NR wide micro-panels, each stored k-major so the
+ * micro-kernel reads NR contiguous values per step. Columns beyond nc are zero padded.
+ */
+template <typename T>
+void PackB(Operand<T> const &b, std::size_t kc, std::size_t nc, T *buffer)
+{
+  constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+  for (std::size_t jr = 0; jr < nc; jr += NR)
+  {
+    std::size_t const cols  = std::min(NR, nc - jr);
+    T *               panel = buffer + (jr * kc);
+
+    if (b.col_stride == 1)
+    {
+      for (std::size_t p = 0; p < kc; ++p)
+      {
+        T const *   src = b.data + (p * b.row_stride) + jr;
+        T *         dst = panel + (p * NR);
+        std::size_t j   = 0;
+        for (; j < cols; ++j)
+        {
+          dst[j] = src[j];
+        }
+        for (; j < NR; ++j)
+        {
+          dst[j] = T{0};
+        }
+      }
+    }
+    else
+    {
+      for (std::size_t j = 0; j < NR; ++j)
+      {
+        for (std::size_t p = 0; p < kc; ++p)
+        {
+          panel[(p * NR) + j] = (j < cols) ? b(p, jr + j) : T{0};
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Computes the MR x NR tile C = alpha * A_panel * B_panel + beta * C. C is never read when
+ * beta is zero.
+ */
+template <typename T>
+void MicroKernel(std::size_t kc, T alpha, T const *a, T const *b, T beta, T *c, std::size_t ldc)
+{
+  constexpr std::size_t MR = GemmBlocking<T>::MR;
+  constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+  T ab[MR * NR] = {};
+  for (std::size_t p = 0; p < kc; ++p)
+  {
+    for (std::size_t j = 0; j < NR; ++j)
+    {
+      T const b_pj = b[(p * NR) + j];
+      for (std::size_t i = 0; i < MR; ++i)
+      {
+        ab[(j * MR) + i] += a[(p * MR) + i] * b_pj;
+      }
+    }
+  }
+
+  for (std::size_t j = 0; j < NR; ++j)
+  {
+    for (std::size_t i = 0; i < MR; ++i)
+    {
+      T &out = c[i + (j * ldc)];
+      out    = (beta == T{0}) ? alpha * ab[(j * MR) + i] : alpha * ab[(j * MR) + i] + beta * out;
+    }
+  }
+}
+
+#ifdef __AVX2__
+
+// AVX2 builds are not guaranteed to enable FMA (-mavx2 alone does not imply -mfma)
+inline __m256 MultiplyAdd(__m256 a, __m256 b, __m256 c)
+{
+#ifdef __FMA__
+  return _mm256_fmadd_ps(a, b, c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+inline __m256d MultiplyAdd(__m256d a, __m256d b, __m256d c)
+{
+#ifdef __FMA__
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+template <>
+void MicroKernel<float>(std::size_t kc, float alpha, float const *a, float const *b, float beta,
+                        float *c, std::size_t ldc)
+{
+  __m256 c0[6];
+  __m256 c1[6];
+  for (std::size_t j = 0; j < 6; ++j)
+  {
+    c0[j] = _mm256_setzero_ps();
+    c1[j] = _mm256_setzero_ps();
+  }
+
+  for (std::size_t p = 0; p < kc; ++p)
+  {
+    __m256 const a0 = _mm256_loadu_ps(a);
+    __m256 const a1 = _mm256_loadu_ps(a + 8);
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+      __m256 const b_pj = _mm256_broadcast_ss(b + j);
+      c0[j]             = MultiplyAdd(a0, b_pj, c0[j]);
+      c1[j]             = MultiplyAdd(a1, b_pj, c1[j]);
+    }
+    a += 16;
+    b += 6;
+  }
+
+  __m256 const alpha_v = _mm256_set1_ps(alpha);
+  __m256 const beta_v  = _mm256_set1_ps(beta);
+  for (std::size_t j = 0; j < 6; ++j)
+  {
+    float *col = c + (j * ldc);
+    __m256 r0  = _mm256_mul_ps(alpha_v, c0[j]);
+    __m256 r1  = _mm256_mul_ps(alpha_v, c1[j]);
+    if (beta != 0.0f)
+    {
+      r0 = MultiplyAdd(beta_v, _mm256_loadu_ps(col), r0);
+      r1 = MultiplyAdd(beta_v, _mm256_loadu_ps(col + 8), r1);
+    }
+    _mm256_storeu_ps(col, r0);
+    _mm256_storeu_ps(col + 8, r1);
+  }
+}
+
+template <>
+void MicroKernel<double>(std::size_t kc, double alpha, double const *a, double const *b,
+                         double beta, double *c, std::size_t ldc)
+{
+  __m256d c0[6];
+  __m256d c1[6];
+  for (std::size_t j = 0; j < 6; ++j)
+  {
+    c0[j] = _mm256_setzero_pd();
+    c1[j] = _mm256_setzero_pd();
+  }
+
+  for (std::size_t p = 0; p < kc; ++p)
+  {
+    __m256d const a0 = _mm256_loadu_pd(a);
+    __m256d const a1 = _mm256_loadu_pd(a + 4);
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+      __m256d const b_pj = _mm256_broadcast_sd(b + j);
+      c0[j]              = MultiplyAdd(a0, b_pj, c0[j]);
+      c1[j]              = MultiplyAdd(a1, b_pj, c1[j]);
+    }
+    a += 8;
+    b += 6;
+  }
+
+  __m256d const alpha_v = _mm256_set1_pd(alpha);
+  __m256d const beta_v  = _mm256_set1_pd(beta);
+  for (std::size_t j = 0; j < 6; ++j)
+  {
+    double *col = c + (j * ldc);
+    __m256d r0  = _mm256_mul_pd(alpha_v, c0[j]);
+    __m256d r1  = _mm256_mul_pd(alpha_v, c1[j]);
+    if (beta != 0.0)
+    {
+      r0 = MultiplyAdd(beta_v, _mm256_loadu_pd(col), r0);
+      r1 = MultiplyAdd(beta_v, _mm256_loadu_pd(col + 4), r1);
+    }
+    _mm256_storeu_pd(col, r0);
+    _mm256_storeu_pd(col + 4, r1);
+  }
+}
+
+#endif
+
+/**
+ * Runs the micro-kernel on a possibly partial tile. Partial tiles are computed into a
+ * scratch tile and only the valid part is merged into C.
+ */
+template <typename T>
+void Tile(std::size_t mr, std::size_t nr, std::size_t kc, T alpha, T const *a, T const *b, T beta,
+          T *c, std::size_t ldc)
+{
+  constexpr std::size_t MR = GemmBlocking<T>::MR;
+  constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+  if ((mr == MR) && (nr == NR))
+  {
+    MicroKernel<T>(kc, alpha, a, b, beta, c, ldc);
+    return;
+  }
+
+  T scratch[MR * NR];
+  MicroKernel<T>(kc, alpha, a, b, T{0}, scratch, MR);
+
+  for (std::size_t j = 0; j < nr; ++j)
+  {
+    for (std::size_t i = 0; i < mr; ++i)
+    {
+      T &out = c[i + (j * ldc)];
+      out    = (beta == T{0}) ? scratch[(j * MR) + i] : scratch[(j * MR) + i] + beta * out;
+    }
+  }
+}
+
+/**
+ * Single threaded blocked product of the m x n block of C starting at c
+ */
+template <typename T>
+void GemmBlock(std::size_t m, std::size_t n, std::size_t k, T alpha, Operand<T> const &a,
+               Operand<T> const &b, T beta, T *c, std::size_t ldc)
+{
+  using Blocking = GemmBlocking<T>;
+
+  constexpr std::size_t MR = Blocking::MR;
+  constexpr std::size_t NR = Blocking::NR;
+  constexpr std::size_t KC = Blocking::KC;
+  constexpr std::size_t MC = Blocking::MC;
+  constexpr std::size_t NC = Blocking::NC;
+
+  // packing buffers are reused across calls on the same thread
+  thread_local std::vector<T> packed_a;
+  thread_local std::vector<T> packed_b;
+  packed_a.resize(MC * KC);
+  packed_b.resize(std::min(NC, ((n + NR - 1) / NR) * NR) * KC);
+
+  for (std::size_t jc = 0; jc < n; jc += NC)
+  {
+    std::size_t const nc = std::min(NC, n - jc);
+
+    for (std::size_t pc = 0; pc < k; pc += KC)
+    {
+      std::size_t const kc = std::min(KC, k - pc);
+
+      // beta is only applied on the first pass over k, later passes accumulate
+      T const beta_pass = (pc == 0) ? beta : T{1};
+
+      PackB(b.Offset(pc, jc), kc, nc, packed_b.data());
+
+      for (std::size_t ic = 0; ic < m; ic += MC)
+      {
+        std::size_t const mc = std::min(MC, m - ic);
+
+        PackA(a.Offset(ic, pc), mc, kc, packed_a.data());
+
+        for (std::size_t jr = 0; jr < nc; jr += NR)
+        {
+          std::size_t const nr = std::min(NR, nc - jr);
+
+          for (std::size_t ir = 0; ir < mc; ir += MR)
+          {
+            std::size_t const mr = std::min(MR, mc - ir);
+
+            Tile(mr, nr, kc, alpha, packed_a.data() + (ir * kc), packed_b.data() + (jr * kc),
+                 beta_pass, c + (ic + ir) + ((jc + jr) * ldc), ldc);
+          }
+        }
+      }
+    }
+  }
+}
+
+fetch::threading::Pool &GemmPool()
+{
+  static fetch::threading::Pool pool{
+      std::max<std::size_t>(std::thread::hardware_concurrency(), 1), "GEMM"};
+  return pool;
+}
+
+template <typename T>
+bool PackedGemmImpl(bool transpose_a, bool transpose_b, T alpha, TensorView<T> const &a,
+                    TensorView<T> const &b, T beta, TensorView<T> &c)
+{
+  constexpr std::size_t MR = GemmBlocking<T>::MR;
+  constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+  std::size_t const m = c.height();
+  std::size_t const n = c.width();
+  std::size_t const k = transpose_a ? a.height() : a.width();
+
+  if ((m * n * k) < PACKED_MIN_WORK)
+  {
+    return false;
+  }
+
+  Operand<T> const op_a{a.data().pointer(), a.padded_height(), transpose_a};
+  Operand<T> const op_b{b.data().pointer(), b.padded_height(), transpose_b};
+  T *const         c_data = c.data().pointer();
+  std::size_t const ldc   = c.padded_height();
+
+  std::size_t threads = 1;
+  if ((m * n * k) >= THREADED_MIN_WORK)
+  {
+    threads = GemmPool().concurrency();
+  }
+
+  // split C along its larger dimension in whole register tiles
+  bool const        split_columns = (n >= m);
+  std::size_t const unit          = split_columns ? NR : MR;
+  std::size_t const extent        = split_columns ? n : m;
+  std::size_t const units         = (extent + unit - 1) / unit;
+
+  threads = std::min(threads, units);
+  if (threads <= 1)
+  {
+    GemmBlock(m, n, k, alpha, op_a, op_b, beta, c_data, ldc);
+    return true;
+  }
+
+  std::size_t const units_per_thread = (units + threads - 1) / threads;
+  std::size_t const chunk            = units_per_thread * unit;
+
+  auto const run_chunk = [&](std::size_t start) {
+    std::size_t const size = std::min(chunk, extent - start);
+    if (split_columns)
+    {
+      GemmBlock(m, size, k, alpha, op_a, op_b.Offset(0, start), beta, c_data + (start * ldc),
+                ldc);
+    }
+    else
+    {
+      GemmBlock(size, n, k, alpha, op_a.Offset(start, 0), op_b, beta, c_data + start, ldc);
+    }
+  };
+
+  std::vector<std::future<void>> pending;
+  for (std::size_t start = chunk; start < extent; start += chunk)
+  {
+    pending.emplace_back(GemmPool().Dispatch(run_chunk, start));
+  }
+
+  // the calling thread takes the first chunk itself
+  run_chunk(0);
+
+  for (auto &result : pending)
+  {
+    result.get();
+  }
+
+  return true;
+}
+
+}  // namespace
+
+bool PackedGemm(bool transpose_a, bool transpose_b, float alpha, TensorView<float> a,
+                TensorView<float> b, float beta, TensorView<float> c)
+{
+  return PackedGemmImpl(transpose_a, transpose_b, alpha, a, b, beta, c);
+}
+
+bool PackedGemm(bool transpose_a, bool transpose_b, double alpha, TensorView<double> a,
+                TensorView<double> b, double beta, TensorView<double> c)
+{
+  return PackedGemmImpl(transpose_a, transpose_b, alpha, a, b, beta, c);
+}
+
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
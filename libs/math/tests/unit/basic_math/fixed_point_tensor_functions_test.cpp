@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/activation_functions/sigmoid.hpp"
+#include "math/standard_functions/exp.hpp"
+#include "math/standard_functions/log.hpp"
+#include "math/standard_functions/sqrt.hpp"
+#include "math/tensor/tensor.hpp"
+#include "math/trigonometry.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+
+namespace fetch {
+namespace math {
+namespace test {
+
+template <typename T>
+class FixedPointTensorFunctionsTest : public ::testing::Test
+{
+protected:
+  using TensorType = T;
+  using DataType   = typename T::Type;
+
+  /// A height which is not a multiple of the register width, so every column is padded
+  static TensorType Input(SizeVector const &shape = {7, 5, 3})
+  {
+    TensorType t(shape);
+    int64_t    i = 0;
+    for (auto &x : t)
+    {
+      x = fetch::math::AsType<DataType>(static_cast<double>(i % 97 - 48) / 6.0);
+      ++i;
+    }
+
+    auto it = t.begin();
+    *it     = DataType::NaN;
+    ++it;
+    *it = DataType::POSITIVE_INFINITY;
+    ++it;
+    *it = DataType::_0;
+    return t;
+  }
+
+  template <typename TensorFunction, typename ScalarFunction>
+  static void ExpectElementWise(TensorFunction const &tensor_function,
+                                ScalarFunction const &scalar_function)
+  {
+    TensorType const input = Input();
+    TensorType       output(input.shape());
+    TensorType       in_place = input.Copy();
+
+    tensor_function(input, output);
+    tensor_function(in_place, in_place);
+
+    auto it  = input.cbegin();
+    auto out = output.cbegin();
+    auto inp = in_place.cbegin();
+    while (it.is_valid())
+    {
+      DataType const expected = scalar_function(*it);
+      EXPECT_TRUE((*out).Data() == expected.Data()) << "input " << *it;
+      EXPECT_TRUE((*inp).Data() == expected.Data()) << "input " << *it;
+      ++it;
+      ++out;
+      ++inp;
+    }
+  }
+
+  /// Checks that every value at or beyond the limits of the special cases sets the scalar fp_state
+  template <typename TensorFunction, typename ScalarFunction>
+  static void ExpectSameState(TensorFunction const &tensor_function,
+                              ScalarFunction const &scalar_function)
+  {
+    DataType const smallest = DataType::FromBase(1);
+    for (DataType const &x :
+         {DataType::NaN, DataType::POSITIVE_INFINITY, DataType::NEGATIVE_INFINITY, DataType::FP_MAX,
+          DataType::FP_MIN, DataType::MAX_EXP + smallest, DataType::MAX_EXP * DataType{2},
+          -DataType::MAX_EXP - smallest, DataType::MIN_EXP - smallest,
+          DataType::MIN_EXP * DataType{2}, DataType::_0, -DataType::_1})
+    {
+      TensorType input({7, 5, 3});
+      input.Fill(x);
+      TensorType output(input.shape());
+
+      DataType::StateClear();
+      tensor_function(input, output);
+      uint32_t const state = DataType::fp_state;
+
+      DataType::StateClear();
+      scalar_function(x);
+      EXPECT_EQ(DataType::fp_state, state) << "input " << x;
+    }
+    DataType::StateClear();
+  }
+};
+
+using TensorFixedPointTypes =
+    ::testing::Types<Tensor<fetch::fixed_point::fp32_t>, Tensor<fetch::fixed_point::fp64_t>,
+                     Tensor<fetch::fixed_point::fp128_t>>;
+TYPED_TEST_CASE(FixedPointTensorFunctionsTest, TensorFixedPointTypes);
+
+TYPED_TEST(FixedPointTensorFunctionsTest, exp)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectElementWise([](TensorType const &x, TensorType &ret) { fetch::math::Exp(x, ret); },
+                          [](DataType const &x) { return DataType::Exp(x); });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, log)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectElementWise([](TensorType const &x, TensorType &ret) { fetch::math::Log(x, ret); },
+                          [](DataType const &x) { return DataType::Log(x); });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, sqrt)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectElementWise([](TensorType const &x, TensorType &ret) { fetch::math::Sqrt(x, ret); },
+                          [](DataType const &x) { return DataType::Sqrt(x); });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, tanh)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectElementWise([](TensorType const &x, TensorType &ret) { fetch::math::TanH(x, ret); },
+                          [](DataType const &x) { return DataType::TanH(x); });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, sigmoid)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectElementWise(
+      [](TensorType const &x, TensorType &ret) { fetch::math::Sigmoid(x, ret); },
+      [](DataType const &x) {
+        if (x >= DataType{0})
+        {
+          return DataType{1} / (DataType{1} + DataType::Exp(-x));
+        }
+        DataType const e = DataType::Exp(x);
+        return e / (e + DataType{1});
+      });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, exp_and_log_set_scalar_state)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectSameState([](TensorType const &x, TensorType &ret) { fetch::math::Exp(x, ret); },
+                        [](DataType const &x) { return DataType::Exp(x); });
+  this->ExpectSameState([](TensorType const &x, TensorType &ret) { fetch::math::Log(x, ret); },
+                        [](DataType const &x) { return DataType::Log(x); });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, sqrt_and_tanh_set_scalar_state)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectSameState([](TensorType const &x, TensorType &ret) { fetch::math::Sqrt(x, ret); },
+                        [](DataType const &x) { return DataType::Sqrt(x); });
+  this->ExpectSameState([](TensorType const &x, TensorType &ret) { fetch::math::TanH(x, ret); },
+                        [](DataType const &x) { return DataType::TanH(x); });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, sigmoid_sets_scalar_state)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  this->ExpectSameState(
+      [](TensorType const &x, TensorType &ret) { fetch::math::Sigmoid(x, ret); },
+      [](DataType const &x) {
+        if (x >= DataType{0})
+        {
+          return DataType{1} / (DataType{1} + DataType::Exp(-x));
+        }
+        DataType const e = DataType::Exp(x);
+        return e / (e + DataType{1});
+      });
+}
+
+TYPED_TEST(FixedPointTensorFunctionsTest, tanh_into_tensor_of_different_shape)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+
+  TensorType const input = this->Input({6, 10});
+  TensorType       output({10, 6});
+  fetch::math::TanH(input, output);
+
+  auto it  = input.cbegin();
+  auto out = output.cbegin();
+  while (it.is_valid())
+  {
+    EXPECT_TRUE((*out).Data() == DataType::TanH(*it).Data());
+    ++it;
+    ++out;
+  }
+}
+
+}  // namespace test
+}  // namespace math
+}  // namespace fetch
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_vector.hpp"
+#include "math/linalg/blas/gemm_nt_novector.hpp"
+#include "math/linalg/blas/gemm_nt_vector.hpp"
+#include "math/linalg/blas/gemm_tn_novector.hpp"
+#include "math/linalg/blas/gemm_tn_vector.hpp"
+#include "math/linalg/blas/gemm_tt_novector.hpp"
+#include "math/linalg/blas/gemm_tt_vector.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor/tensor.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+using namespace fetch;
+using namespace fetch::math;
+using namespace fetch::math::linalg;
+
+namespace {
+
+template <typename T>
+class BlasGemmPackedTests : public ::testing::Test
+{
+};
+
+using PackedTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(BlasGemmPackedTests, PackedTypes);
+
+struct GemmShape
+{
+  SizeType m;
+  SizeType n;
+  SizeType k;
+};
+
+// Shapes chosen to exercise partial register tiles, several k passes and the threaded split
+GemmShape const SHAPES[] = {{17, 19, 23}, {64, 64, 64}, {97, 13, 301}, {13, 211, 37}, {300, 257, 129}};
+
+template <typename Type, typename Packed, typename Reference>
+void CheckAgainstReference(bool transpose_a, bool transpose_b, Type alpha, Type beta)
+{
+  Packed    packed;
+  Reference reference;
+
+  for (auto const &shape : SHAPES)
+  {
+    Tensor<Type> a(transpose_a ? SizeVector{shape.k, shape.m} : SizeVector{shape.m, shape.k});
+    Tensor<Type> b(transpose_b ? SizeVector{shape.n, shape.k} : SizeVector{shape.k, shape.n});
+    Tensor<Type> c({shape.m, shape.n});
+    a.FillUniformRandom();
+    b.FillUniformRandom();
+    c.FillUniformRandom();
+
+    Tensor<Type> expected = c.Copy();
+
+    packed(alpha, a.View(), b.View(), beta, c.View());
+    reference(alpha, a.View(), b.View(), beta, expected.View());
+
+    EXPECT_TRUE(expected.AllClose(c, Type(1e-4), Type(1e-4)))
+        << "m=" << shape.m << " n=" << shape.n << " k=" << shape.k;
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(BlasGemmPackedTests, gemm_nn_matches_reference)
+{
+  using Type = TypeParam;
+  using Packed =
+      Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+           Computes(_C <= _alpha * _A * _B + _beta * _C), platform::Parallelisation::VECTORISE>;
+  using Reference =
+      Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+           Computes(_C <= _alpha * _A * _B + _beta * _C), platform::Parallelisation::NOT_PARALLEL>;
+
+  CheckAgainstReference<Type, Packed, Reference>(false, false, Type(1), Type(0));
+  CheckAgainstReference<Type, Packed, Reference>(false, false, Type(0.5), Type(2));
+}
+
+TYPED_TEST(BlasGemmPackedTests, gemm_nt_matches_reference)
+{
+  using Type   = TypeParam;
+  using Packed = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                      Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                      platform::Parallelisation::VECTORISE>;
+  using Reference = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+
+  CheckAgainstReference<Type, Packed, Reference>(false, true, Type(1), Type(0));
+  CheckAgainstReference<Type, Packed, Reference>(false, true, Type(0.5), Type(2));
+}
+
+TYPED_TEST(BlasGemmPackedTests, gemm_tn_matches_reference)
+{
+  using Type   = TypeParam;
+  using Packed = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                      Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                      platform::Parallelisation::VECTORISE>;
+  using Reference = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+
+  CheckAgainstReference<Type, Packed, Reference>(true, false, Type(1), Type(0));
+  CheckAgainstReference<Type, Packed, Reference>(true, false, Type(0.5), Type(2));
+}
+
+TYPED_TEST(BlasGemmPackedTests, gemm_tt_matches_reference)
+{
+  using Type   = TypeParam;
+  using Packed = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                      Computes(_C <= _alpha * T(_A) * T(_B) + _beta * _C),
+                      platform::Parallelisation::VECTORISE>;
+  using Reference = Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * T(_A) * T(_B) + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+
+  CheckAgainstReference<Type, Packed, Reference>(true, true, Type(1), Type(0));
+  CheckAgainstReference<Type, Packed, Reference>(true, true, Type(0.5), Type(2));
+}
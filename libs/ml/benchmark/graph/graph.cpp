@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/core/graph_executor.hpp"
+#include "ml/layers/self_attention_encoder.hpp"
+#include "ml/ops/loss_functions/mean_square_error_loss.hpp"
+#include "ml/ops/placeholder.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <string>
+
+/**
+ * One forward and backward pass through a stack of L self attention encoder layers, as used by
+ * BERT, with model dimension D, H attention heads, sequence length S and batch size B. The
+ * benchmark argument is the number of executor threads, where 0 means the recursive evaluation
+ * without an executor.
+ */
+template <typename T, fetch::math::SizeType L, fetch::math::SizeType D, fetch::math::SizeType H,
+          fetch::math::SizeType S, fetch::math::SizeType B>
+void BM_SelfAttentionEncoder(benchmark::State &state)
+{
+  using SizeType   = fetch::math::SizeType;
+  using DataType   = T;
+  using TensorType = fetch::math::Tensor<DataType>;
+
+  auto const num_threads = static_cast<SizeType>(state.range(0));
+
+  auto g = std::make_shared<fetch::ml::Graph<TensorType>>();
+
+  std::string input = g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+  std::string mask  = g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Mask", {});
+  std::string label = g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Label", {});
+
+  std::string layer = input;
+  for (SizeType i = 0; i < L; ++i)
+  {
+    layer = g->template AddNode<fetch::ml::layers::SelfAttentionEncoder<TensorType>>(
+        "Encoder_" + std::to_string(i), {layer, mask}, H, D, 4 * D);
+  }
+  std::string loss =
+      g->template AddNode<fetch::ml::ops::MeanSquareErrorLoss<TensorType>>("Loss", {layer, label});
+
+  if (num_threads > 0)
+  {
+    g->SetExecutor(std::make_shared<fetch::ml::GraphExecutor>(num_threads));
+  }
+
+  TensorType input_data({D, S, B});
+  TensorType mask_data({S, S, B});
+  TensorType label_data({D, S, B});
+  input_data.FillUniformRandom();
+  label_data.FillUniformRandom();
+  mask_data.Fill(DataType{1});
+
+  g->SetInput(mask, mask_data);
+  g->SetInput(label, label_data);
+
+  for (auto _ : state)
+  {
+    g->SetInput(input, input_data);
+    benchmark::DoNotOptimize(g->Evaluate(loss));
+    g->BackPropagate(loss);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_SelfAttentionEncoder, float, 1, 64, 8, 32, 4)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SelfAttentionEncoder, float, 2, 128, 8, 64, 8)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SelfAttentionEncoder, double, 2, 128, 8, 64, 8)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
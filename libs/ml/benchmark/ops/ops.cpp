@@ -1057,6 +1057,29 @@ BENCHMARK_TEMPLATE(BM_Conv1DBackward, fetch::fixed_point::fp128_t, 1, 4, 16, 1,
 BENCHMARK_TEMPLATE(BM_Conv1DBackward, fetch::fixed_point::fp128_t, 1, 8, 16, 1, 16)
     ->Unit(benchmark::kMicrosecond);
 
+// Reports scratch allocations made by the op and the bytes it touches per pass, i.e. the inputs,
+// the output and the im2col workspace
+template <class OpType, class VecTensorType, class TensorType>
+void SetConvolutionCounters(benchmark::State &state, OpType &op, VecTensorType const &inputs,
+                            TensorType const &output)
+{
+  using DataType = typename TensorType::Type;
+
+  auto const &workspace = op.GetWorkspace();
+
+  std::size_t elements = output.size() + workspace->allocated_elements();
+  for (auto const &input : inputs)
+  {
+    elements += input->size();
+  }
+
+  state.counters["allocations"] = static_cast<double>(workspace->allocation_count());
+  state.counters["workspace_MB"] =
+      static_cast<double>(workspace->allocated_elements() * sizeof(DataType)) / 1e6;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(elements * sizeof(DataType)));
+}
+
 template <class T, int N, int C, int H, int W, int K, int V, int O>
 void BM_Conv2DForward(benchmark::State &state)
 {
@@ -1091,6 +1114,8 @@ void BM_Conv2DForward(benchmark::State &state)
   {
     conv_2d.Forward(inputs, output);
   }
+
+  SetConvolutionCounters(state, conv_2d, inputs, output);
 }
 
 BENCHMARK_TEMPLATE(BM_Conv2DForward, float, 1, 1, 2, 2, 1, 1, 1)->Unit(benchmark::kMicrosecond);
@@ -1261,6 +1286,8 @@ void BM_Conv2DBackward(benchmark::State &state)
   {
     conv_2d.Backward(inputs, output);
   }
+
+  SetConvolutionCounters(state, conv_2d, inputs, output);
 }
 
 BENCHMARK_TEMPLATE(BM_Conv2DBackward, float, 1, 1, 2, 2, 1, 1, 1)->Unit(benchmark::kMicrosecond);
@@ -1400,6 +1427,58 @@ BENCHMARK_TEMPLATE(BM_Conv2DBackward, fetch::fixed_point::fp128_t, 1, 1, 16, 16,
 BENCHMARK_TEMPLATE(BM_Conv2DBackward, fetch::fixed_point::fp128_t, 1, 1, 16, 16, 1, 1, 16)
     ->Unit(benchmark::kMicrosecond);
 
+// A full training step (forward and backward) on batched image-sized inputs, where the scratch
+// buffers are large enough for per-step allocation to matter
+template <class T, int N, int C, int H, int W, int K, int V, int O>
+void BM_Conv2DStep(benchmark::State &state)
+{
+  using SizeType      = fetch::math::SizeType;
+  using TensorType    = typename fetch::math::Tensor<T>;
+  using VecTensorType = typename fetch::ml::ops::Ops<TensorType>::VecTensorType;
+
+  SizeType input_channels  = C;
+  SizeType input_height    = H;
+  SizeType input_width     = W;
+  SizeType batch_size      = N;
+  SizeType output_channels = O;
+  SizeType kernel_height   = K;
+  SizeType kernel_width    = V;
+
+  fetch::math::Tensor<T> input({input_channels, input_height, input_width, batch_size});
+  fetch::math::Tensor<T> kernel({output_channels, input_channels, kernel_height, kernel_width, 1});
+
+  // Fill tensors with random values
+  input.FillUniformRandom();
+  kernel.FillUniformRandom();
+
+  VecTensorType inputs;
+  inputs.emplace_back(std::make_shared<TensorType>(input));
+  inputs.emplace_back(std::make_shared<TensorType>(kernel));
+
+  fetch::ml::ops::Convolution2D<TensorType> conv_2d;
+  fetch::math::Tensor<T>                    output(conv_2d.ComputeOutputShape(inputs));
+  fetch::math::Tensor<T>                    error_signal(output.shape());
+  error_signal.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    conv_2d.Forward(inputs, output);
+    benchmark::DoNotOptimize(conv_2d.Backward(inputs, error_signal));
+  }
+
+  SetConvolutionCounters(state, conv_2d, inputs, output);
+}
+
+BENCHMARK_TEMPLATE(BM_Conv2DStep, float, 32, 1, 28, 28, 5, 5, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DStep, float, 32, 3, 32, 32, 3, 3, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DStep, float, 32, 16, 32, 32, 3, 3, 32)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DStep, double, 32, 1, 28, 28, 5, 5, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DStep, double, 32, 3, 32, 32, 3, 3, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DStep, fetch::fixed_point::fp32_t, 32, 3, 32, 32, 3, 3, 16)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DStep, fetch::fixed_point::fp64_t, 32, 3, 32, 32, 3, 3, 16)
+    ->Unit(benchmark::kMillisecond);
+
 template <typename T, int N, int D, int P>
 void BM_EmbeddingsForward(benchmark::State &state)
 {
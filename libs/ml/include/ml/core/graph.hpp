@@ -18,7 +18,9 @@
 //------------------------------------------------------------------------------
 
 #include "ml/charge_estimation/ops/constants.hpp"
+#include "ml/core/graph_executor.hpp"
 #include "ml/core/node.hpp"
+#include "ml/core/workspace.hpp"
 #include "ml/exceptions/exceptions.hpp"
 #include "ml/ops/constant.hpp"
 #include "ml/ops/trainable.hpp"
@@ -81,6 +83,9 @@ public:
   using RegPtrType       = std::shared_ptr<fetch::ml::regularisers::Regulariser<T>>;
   using SPType           = GraphSaveableParams<TensorType>;
   using OpPtrType        = std::shared_ptr<fetch::ml::ops::Ops<TensorType>>;
+  using WorkspacePtrType = std::shared_ptr<Workspace<TensorType>>;
+  using ExecutorPtrType  = std::shared_ptr<GraphExecutor>;
+  using NodeErrorMapType = typename Node<TensorType>::NodeErrorMapType;
 
   static constexpr char const *DESCRIPTOR = "Graph";
 
@@ -98,6 +103,7 @@ public:
   void ResetCompile();
   void Compile();
   void ComputeAllNodeShapes();
+  void ReserveWorkspace();
 
   void AddTrainable(NodePtrType node_ptr, std::string const &node_name);
   void AddTrainable(NodePtrType node_ptr, std::string const &node_name,
@@ -154,6 +160,11 @@ public:
 
   fetch::ml::OperationsCount ChargeForward(std::string const &node_name);
 
+  WorkspacePtrType const &GetGraphWorkspace() const;
+
+  void                   SetExecutor(ExecutorPtrType executor);
+  ExecutorPtrType const &GetExecutor() const;
+
 protected:
   std::map<std::string, NodePtrType>                            nodes_;
   std::map<std::string, NodePtrType>                            trainable_lookup_;
@@ -163,8 +174,36 @@ protected:
   void       InsertSharedCopy(std::shared_ptr<Graph<TensorType>> output_ptr);
   TensorType ForwardPropagate(std::string const &node_name, bool is_training = true);
 
+  std::shared_ptr<TensorType> EvaluateNode(NodePtrType const &node, bool is_training);
+  NodeErrorMapType BackPropagateNode(NodePtrType const &node, TensorType const &error_signal);
+
 private:
-  GraphState graph_state_ = GraphState::NOT_COMPILED;
+  using NodeRawPtrType = Node<TensorType> *;
+
+  /**
+   * The nodes a forward or backward pass from one node visits, levelled for the executor: a
+   * node is on level 0 if it has no inputs, and one level above its highest input otherwise.
+   * Nodes of a level which share an op, directly or inside a subgraph, are put in the same group
+   * and run in order, since ops are not safe to run concurrently with themselves. Ops may return
+   * their own buffers as error signals, so those of nodes sharing an op are copied before the op
+   * runs again on a lower level.
+   */
+  struct ExecutionPlan
+  {
+    std::vector<NodeRawPtrType>                     nodes;         // topological order
+    std::unordered_map<NodeRawPtrType, SizeType>    index;         // position of a node in nodes
+    std::vector<std::vector<std::vector<SizeType>>> levels;        // groups of positions per level
+    std::vector<SizeType>                           input_slots;   // first input slot of a node
+    std::vector<std::vector<SizeType>>              output_slots;  // slots written by its outputs
+    std::vector<bool>                               shares_ops;    // op also used by other nodes
+    SizeType                                        slot_count{0};
+  };
+
+  GraphState       graph_state_     = GraphState::NOT_COMPILED;
+  WorkspacePtrType graph_workspace_ = std::make_shared<Workspace<TensorType>>();
+  ExecutorPtrType  executor_;
+
+  std::unordered_map<NodeRawPtrType, ExecutionPlan> execution_plans_;
 
   friend class optimisers::Optimiser<TensorType>;
   friend class model::ModelInterface<TensorType>;
@@ -187,6 +226,18 @@ private:
 
   void ResetGraphCache(bool input_size_changed, std::shared_ptr<Node<T>> n = {});
 
+  ///////////////////////////////////
+  /// scheduled execution helpers ///
+  ///////////////////////////////////
+
+  bool                 IsScheduled() const;
+  void                 GetOps(std::unordered_set<void const *> &ret) const;
+  ExecutionPlan const &GetExecutionPlan(NodeRawPtrType root);
+  void                 BackPropagateScheduled(ExecutionPlan const &plan, SizeType position,
+                                              TensorType const &error_signal,
+                                              std::vector<TensorType> &             errors,
+                                              std::vector<std::vector<TensorType>> &leaf_errors);
+
   //////////////////////////////////////////
   /// recursive implementation functions ///
   //////////////////////////////////////////
@@ -0,0 +1,89 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+
+/**
+ * A small pool of worker threads on which a Graph runs the independent nodes of one topological
+ * level at a time.
+ *
+ * Run hands over a batch of tasks and returns once all of them have completed. The calling thread
+ * works through the batch alongside the workers, and keeps executing queued tasks while it
+ * waits, so that a task may itself call Run (a subgraph node scheduling its own levels) without
+ * deadlocking the pool. A pool of size one has no workers and runs every batch in order on the
+ * calling thread.
+ */
+class GraphExecutor
+{
+public:
+  using SizeType = fetch::math::SizeType;
+  using Task     = std::function<void()>;
+  using Tasks    = std::vector<Task>;
+
+  explicit GraphExecutor(SizeType num_threads);
+  GraphExecutor(GraphExecutor const &other) = delete;
+  GraphExecutor &operator=(GraphExecutor const &other) = delete;
+  ~GraphExecutor();
+
+  void Run(Tasks const &tasks);
+
+  SizeType num_threads() const;
+
+private:
+  struct Batch
+  {
+    explicit Batch(Tasks const &t)
+      : tasks(t)
+      , remaining(t.size())
+      , errors(t.size())
+    {}
+
+    Tasks const &                   tasks;
+    SizeType                        next{0};
+    SizeType                        remaining;
+    std::vector<std::exception_ptr> errors;
+  };
+
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  std::vector<std::thread> workers_;
+  std::deque<BatchPtr>     queue_;  // batches with tasks not yet claimed
+  bool                     stop_{false};
+
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+
+  void WorkerLoop();
+  void RunOne(std::unique_lock<std::mutex> &lock);
+};
+
+}  // namespace ml
+}  // namespace fetch
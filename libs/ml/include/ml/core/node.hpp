@@ -115,9 +115,11 @@ public:
   VecTensorType               GatherInputs() const;
   std::shared_ptr<TensorType> Evaluate(bool is_training);
 
-  NodeErrorMapType BackPropagate(TensorType const &error_signal);
+  NodeErrorMapType        BackPropagate(TensorType const &error_signal);
+  std::vector<TensorType> Backward(TensorType const &error_signal);
 
   void                                AddInput(NodeWeakPtrType const &i);
+  std::vector<NodeWeakPtrType> const &GetInputs() const;
   std::vector<std::string>            GetInputNames();
   void                                AddOutput(NodeWeakPtrType const &o);
   std::vector<NodeWeakPtrType> const &GetOutputs() const;
@@ -0,0 +1,72 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+
+/**
+ * Scratch tensors shared by the ops of a graph.
+ *
+ * Ops request temporary buffers (e.g. im2col matrices) by slot instead of allocating them on
+ * every Forward / Backward call. A buffer is only reallocated when the requested shape changes,
+ * so once a training loop has seen a given batch size no further allocations happen. Buffers are
+ * keyed by the requesting op so that ops never alias each other's scratch space.
+ */
+template <typename TensorType>
+class Workspace
+{
+public:
+  using SizeType    = fetch::math::SizeType;
+  using Shape       = fetch::math::SizeVector;
+  using ShapeVector = std::vector<Shape>;
+
+  Workspace()  = default;
+  ~Workspace() = default;
+
+  Workspace(Workspace const &other) = delete;
+  Workspace &operator=(Workspace const &other) = delete;
+
+  TensorType &Get(void const *owner, SizeType slot, Shape const &shape);
+  void        Reserve(void const *owner, ShapeVector const &shapes);
+  void        Release(void const *owner);
+  void        Clear();
+
+  SizeType allocation_count() const;
+  SizeType allocated_elements() const;
+
+private:
+  using Key = std::pair<void const *, SizeType>;
+
+  TensorType &Acquire(Key const &key, Shape const &shape);
+
+  mutable std::mutex        mutex_;
+  std::map<Key, TensorType> buffers_;
+  SizeType                  allocation_count_{0};
+  SizeType                  allocated_elements_{0};
+};
+
+}  // namespace ml
+}  // namespace fetch
@@ -57,10 +57,10 @@ public:
   virtual void     Reset()                                                      = 0;
   virtual void     SetTestRatio(fixed_point::fp32_t new_test_ratio)             = 0;
   virtual void     SetValidationRatio(fixed_point::fp32_t new_validation_ratio) = 0;
-  void             SetMode(DataLoaderMode new_mode);
+  virtual void     SetMode(DataLoaderMode new_mode);
   virtual bool     IsModeAvailable(DataLoaderMode mode) = 0;
-  void             SetRandomMode(bool random_mode_state);
-  void             SetSeed(SizeType seed = 123);
+  virtual void     SetRandomMode(bool random_mode_state);
+  virtual void     SetSeed(SizeType seed = 123);
 
   template <typename X, typename D>
   friend struct fetch::serializers::MapSerializer;
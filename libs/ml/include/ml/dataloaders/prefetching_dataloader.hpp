@@ -0,0 +1,125 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/dataloader.hpp"
+#include "ml/meta/ml_type_traits.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Wraps another dataloader and prepares the next `depth` batches on a background thread while
+ * the caller trains on the current one. Batches are assembled by the wrapped loader in exactly the
+ * order a synchronous caller would see them (including the seeded random mode), and copied into
+ * a ring of reusable batch tensors so that steady state training does not allocate.
+ *
+ * A batch returned by PrepareBatch stays valid until the next call to PrepareBatch. The producer
+ * pauses at the end of every epoch until more batches are requested, so read-ahead never crosses
+ * an epoch boundary. Any call which changes the state of the wrapped loader (Reset, SetMode,
+ * SetSeed, ...) stops the producer first and discards batches which were prepared but not
+ * consumed. A depth of zero forwards every call to the wrapped loader.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+class PrefetchingDataLoader : public DataLoader<TensorType>
+{
+public:
+  using SizeType   = fetch::math::SizeType;
+  using ReturnType = std::pair<TensorType, std::vector<TensorType>>;
+  using LoaderPtr  = std::shared_ptr<DataLoader<TensorType>>;
+
+  static constexpr SizeType DEFAULT_DEPTH = 4;
+
+  explicit PrefetchingDataLoader(LoaderPtr loader, SizeType depth = DEFAULT_DEPTH);
+  PrefetchingDataLoader(PrefetchingDataLoader const &other) = delete;
+  PrefetchingDataLoader &operator=(PrefetchingDataLoader const &other) = delete;
+  ~PrefetchingDataLoader() override;
+
+  ReturnType GetNext() override;
+  ReturnType PrepareBatch(SizeType batch_size, bool &is_done_set) override;
+
+  bool AddData(std::vector<TensorType> const &data, TensorType const &label) override;
+
+  SizeType Size() const override;
+  bool     IsDone() const override;
+  void     Reset() override;
+  void     SetTestRatio(fixed_point::fp32_t new_test_ratio) override;
+  void     SetValidationRatio(fixed_point::fp32_t new_validation_ratio) override;
+  bool     IsModeAvailable(DataLoaderMode mode) override;
+  void     SetMode(DataLoaderMode new_mode) override;
+  void     SetRandomMode(bool random_mode_state) override;
+  void     SetSeed(SizeType seed) override;
+
+  LoaderType LoaderCode() override
+  {
+    return LoaderType::PREFETCH;
+  }
+
+  SizeType  depth() const;
+  LoaderPtr loader() const;
+
+protected:
+  // cursors are owned by the wrapped loader
+  void UpdateCursor() override
+  {}
+
+private:
+  struct Batch
+  {
+    ReturnType data;
+    bool       is_done_set{false};
+    bool       is_done{false};
+  };
+
+  LoaderPtr loader_;
+  SizeType  depth_;
+
+  // ring of depth_ + 1 slots: up to depth_ ready batches plus the one held by the consumer
+  std::vector<Batch> ring_;
+  SizeType           head_{0};   // next slot to be consumed
+  SizeType           ready_{0};  // number of produced but not yet consumed slots
+  SizeType           batch_size_{0};
+  bool               paused_{false};  // producer reached the end of an epoch
+  bool               stop_{false};
+  bool               done_{false};  // IsDone of the wrapped loader after the last consumed batch
+  std::exception_ptr error_;
+
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+  std::thread             producer_;
+
+  void Start(SizeType batch_size);
+  void Stop();
+  void Produce();
+  bool IsQuiescent() const;
+
+  static void AssignBatch(ReturnType &dst, ReturnType const &src);
+};
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
@@ -39,7 +39,8 @@ enum class LoaderType : uint8_t
   SGNS,
   W2V,
   COMMODITY,
-  C2V
+  C2V,
+  PREFETCH
 };
 
 enum class SliceType : uint8_t
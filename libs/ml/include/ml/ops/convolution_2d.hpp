@@ -36,6 +36,8 @@ public:
   using DataType      = typename TensorType::Type;
   using ArrayPtrType  = std::shared_ptr<TensorType>;
   using VecTensorType = typename Ops<T>::VecTensorType;
+  using Shape         = typename Ops<T>::Shape;
+  using ShapeVector   = typename Ops<T>::ShapeVector;
   using SPType        = OpConvolution2DSaveableParams<TensorType>;
   using MyType        = Convolution2D<TensorType>;
 
@@ -64,6 +66,8 @@ public:
   std::vector<typename TensorType::SizeType> ComputeOutputShape(
       VecTensorType const &inputs) const override;
 
+  ShapeVector ComputeWorkspaceShapes(ShapeVector const &input_shapes) const override;
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_CONVOLUTION_2D;
@@ -82,29 +86,15 @@ public:
   OperationsCount ChargeForward() override;
 
 private:
-  void FillVerticalStride(TensorType &input, TensorType &vertical_stride, SizeType output_channels,
-                          SizeType input_channels, SizeType kernel_height, SizeType kernel_width);
-
-  void ReverseFillVerticalStride(TensorType &input, TensorType &vertical_stride,
-                                 SizeType output_channels, SizeType input_channels,
-                                 SizeType kernel_height, SizeType kernel_width);
-
-  void FillHorizontalStride(TensorType &input, TensorType &horizontal_stride,
+  void FillHorizontalStride(TensorType const &input, TensorType &horizontal_stride,
                             SizeType output_height, SizeType output_width, SizeType input_channels,
                             SizeType kernel_height, SizeType kernel_width, SizeType batch_size);
 
-  void ReverseFillHorizontalStride(TensorType &input, TensorType &horizontal_stride,
+  void ReverseFillHorizontalStride(TensorType &input, TensorType const &horizontal_stride,
                                    SizeType output_height, SizeType output_width,
                                    SizeType input_channels, SizeType kernel_height,
                                    SizeType kernel_width, SizeType batch_size);
 
-  void FillOutput(TensorType const &gemm_output, TensorType &output, SizeType output_channels,
-                  SizeType output_height, SizeType output_width, SizeType batch_size);
-
-  void ReverseFillOutput(TensorType &gemm_output, TensorType const &output,
-                         SizeType output_channels, SizeType output_height, SizeType output_width,
-                         SizeType batch_size);
-
   SizeType ComputeOutputDim(SizeType input_dim, SizeType kernel_dim) const;
 
   SizeType stride_size_;
@@ -18,9 +18,11 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "core/macros.hpp"
 #include "math/matrix_operations.hpp"
 #include "math/tensor/tensor.hpp"
 #include "ml/charge_estimation/ops/constants.hpp"
+#include "ml/core/workspace.hpp"
 #include "ml/exceptions/exceptions.hpp"
 #include "ml/saveparams/saveable_params.hpp"
 
@@ -45,8 +47,15 @@ public:
   using VecTensorType = std::vector<std::shared_ptr<TensorType const>>;
   using Shape         = fetch::math::SizeVector;
   using ShapeVector   = std::vector<Shape>;
+  using WorkspacePtr  = std::shared_ptr<Workspace<TensorType>>;
 
-  virtual ~Ops() = default;
+  virtual ~Ops()
+  {
+    if (workspace_)
+    {
+      workspace_->Release(this);
+    }
+  }
 
   virtual void                    Forward(VecTensorType const &inputs, TensorType &output) = 0;
   virtual std::vector<TensorType> Backward(VecTensorType const &inputs,
@@ -127,6 +136,41 @@ public:
     return batch_input_shapes_;
   }
 
+  /**
+   * @brief ComputeWorkspaceShapes returns the shapes of the scratch tensors Forward and Backward
+   * request from the workspace for the given input shapes. Used by the graph to size its workspace
+   * at compile time. Ops that do not need scratch space keep this default.
+   * @param input_shapes
+   * @return shape of each scratch slot
+   */
+  virtual ShapeVector ComputeWorkspaceShapes(ShapeVector const &input_shapes) const
+  {
+    FETCH_UNUSED(input_shapes);
+    return {};
+  }
+
+  /**
+   * Sets the workspace this op takes scratch tensors from. Ops used outside of a graph
+   * lazily create a private workspace.
+   */
+  void SetWorkspace(WorkspacePtr workspace)
+  {
+    if (workspace_ && (workspace_ != workspace))
+    {
+      workspace_->Release(this);
+    }
+    workspace_ = std::move(workspace);
+  }
+
+  WorkspacePtr const &GetWorkspace()
+  {
+    if (!workspace_)
+    {
+      workspace_ = std::make_shared<Workspace<TensorType>>();
+    }
+    return workspace_;
+  }
+
   /// OOP polymorphic wrapper around each Ops/Layer OpCode() static method.
   virtual OpType OperationType() const  // TODO(ML-466): make a pure virtual.
   {
@@ -198,10 +242,20 @@ public:
   }
 
 protected:
+  /**
+   * Returns scratch tensor `slot` with the given shape from the workspace. The contents are
+   * unspecified and the tensor must not outlive the current Forward / Backward call.
+   */
+  TensorType &ScratchTensor(SizeType slot, Shape const &shape)
+  {
+    return GetWorkspace()->Get(this, slot, shape);
+  }
+
   bool is_training_ = true;
 
-  ShapeVector batch_input_shapes_{};
-  Shape       batch_output_shape_{};
+  ShapeVector  batch_input_shapes_{};
+  Shape        batch_output_shape_{};
+  WorkspacePtr workspace_{};
 };
 
 }  // namespace ops
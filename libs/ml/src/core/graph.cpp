@@ -21,6 +21,8 @@
 #include "ml/core/graph.hpp"
 #include "ml/ops/weights.hpp"
 
+#include <algorithm>
+
 namespace fetch {
 
 namespace ml {
@@ -35,6 +37,7 @@ template <typename TensorType>
 void Graph<TensorType>::ResetCompile()
 {
   graph_state_ = GraphState::NOT_COMPILED;
+  execution_plans_.clear();
 
   for (auto &connection : connections_)
   {
@@ -84,6 +87,7 @@ void Graph<TensorType>::Compile()
     if (valid)
     {
       ComputeAllNodeShapes();
+      ReserveWorkspace();
       graph_state_ = GraphState::COMPILED;
     }
     else
@@ -185,7 +189,7 @@ TensorType Graph<TensorType>::ForwardImplementation(std::string const &node_name
     case GraphState::UPDATED:
     {
       graph_state_ = GraphState::EVALUATED;
-      auto ret     = (*(nodes_[node_name]->Evaluate(is_training)));
+      auto ret     = (*EvaluateNode(nodes_[node_name], is_training));
       if (evaluate_mode)
       {
         return ret.Copy();
@@ -236,6 +240,41 @@ void Graph<TensorType>::ComputeAllNodeShapes()
   }
 }
 
+/**
+ * Hands the graph workspace to every op and preallocates the scratch tensors they report from
+ * shape inference, so that Forward and Backward calls reuse buffers instead of allocating them.
+ * Must be called after ComputeAllNodeShapes.
+ */
+template <typename TensorType>
+void Graph<TensorType>::ReserveWorkspace()
+{
+  for (auto const &node_name_and_ptr : nodes_)
+  {
+    auto op_ptr = node_name_and_ptr.second->GetOp();
+    if (!op_ptr)
+    {
+      continue;
+    }
+
+    op_ptr->SetWorkspace(graph_workspace_);
+
+    auto const &input_shapes = op_ptr->BatchInputShapes();
+    if (!input_shapes.empty())
+    {
+      graph_workspace_->Reserve(op_ptr.get(), op_ptr->ComputeWorkspaceShapes(input_shapes));
+    }
+  }
+}
+
+/**
+ * Returns the workspace from which the ops of this graph take their scratch tensors
+ */
+template <typename TensorType>
+typename Graph<TensorType>::WorkspacePtrType const &Graph<TensorType>::GetGraphWorkspace() const
+{
+  return graph_workspace_;
+}
+
 /**
  * Backpropagate given error signal through the graph
  * If no error signal is given, an empty error signal is used
@@ -267,7 +306,7 @@ void Graph<TensorType>::BackPropagate(std::string const &node_name, TensorType c
     case GraphState::BACKWARD:
     case GraphState::UPDATED:
     {
-      nodes_[node_name]->BackPropagate(error_signal);
+      BackPropagateNode(nodes_[node_name], error_signal);
       graph_state_ = GraphState::BACKWARD;
       break;
     }
@@ -284,14 +323,392 @@ void Graph<TensorType>::BackPropagate(std::string const &node_name, TensorType c
   }
 }
 
+/**
+ * Runs the forward and backward passes of this graph, and of all subgraphs in it, on the given
+ * executor. Independent nodes of the same topological level are then evaluated concurrently, and
+ * the error signals reaching a node through several outputs are summed in a fixed order before
+ * they are backpropagated once, so the gradients do not depend on the number of threads.
+ * Passing a null executor restores the recursive single threaded evaluation.
+ *
+ * Graphs over fixed point types always use the recursive evaluation, since the fixed point
+ * overflow and NaN state flags are shared by all threads.
+ * @param executor the pool to run on, shareable between graphs
+ */
+template <typename TensorType>
+void Graph<TensorType>::SetExecutor(ExecutorPtrType executor)
+{
+  executor_ = std::move(executor);
+
+  for (auto const &node : nodes_)
+  {
+    auto graph_ptr = std::dynamic_pointer_cast<Graph<TensorType>>(node.second->GetOp());
+    if (graph_ptr)
+    {
+      graph_ptr->SetExecutor(executor_);
+    }
+  }
+}
+
+template <typename TensorType>
+typename Graph<TensorType>::ExecutorPtrType const &Graph<TensorType>::GetExecutor() const
+{
+  return executor_;
+}
+
 /////////////////////////
 /// PROTECTED METHODS ///
 /////////////////////////
 
+/**
+ * Evaluates a node of this graph, on the executor if one is set
+ * @param node the node to evaluate
+ * @param is_training
+ * @return shallow copy of the output of the node
+ */
+template <typename TensorType>
+std::shared_ptr<TensorType> Graph<TensorType>::EvaluateNode(NodePtrType const &node,
+                                                            bool               is_training)
+{
+  if (!IsScheduled())
+  {
+    return node->Evaluate(is_training);
+  }
+
+  ExecutionPlan const &plan = GetExecutionPlan(node.get());
+
+  // set the training flags up front so that the concurrent passes only ever read them
+  for (auto const &n : plan.nodes)
+  {
+    n->GetOp()->SetTraining(is_training);
+  }
+
+  GraphExecutor::Tasks tasks;
+  for (auto const &level : plan.levels)
+  {
+    tasks.clear();
+    for (auto const &group : level)
+    {
+      bool valid_cache = true;
+      for (SizeType position : group)
+      {
+        valid_cache = valid_cache && plan.nodes[position]->HasValidCache();
+      }
+
+      if (!valid_cache)
+      {
+        tasks.emplace_back([&plan, &group, is_training]() {
+          for (SizeType position : group)
+          {
+            plan.nodes[position]->Evaluate(is_training);
+          }
+        });
+      }
+    }
+    executor_->Run(tasks);
+  }
+
+  return node->Evaluate(is_training);
+}
+
+/**
+ * Backpropagates an error signal from a node of this graph, on the executor if one is set. The
+ * forward pass to the node must have been completed.
+ * @param node the node to start backpropagation from
+ * @param error_signal the error signal at the output of the node
+ * @return the error signals of the nodes without inputs
+ */
+template <typename TensorType>
+typename Graph<TensorType>::NodeErrorMapType Graph<TensorType>::BackPropagateNode(
+    NodePtrType const &node, TensorType const &error_signal)
+{
+  if (!IsScheduled())
+  {
+    return node->BackPropagate(error_signal);
+  }
+
+  ExecutionPlan const &plan = GetExecutionPlan(node.get());
+
+  std::vector<TensorType>              errors(plan.slot_count);
+  std::vector<std::vector<TensorType>> leaf_errors(plan.nodes.size());
+
+  GraphExecutor::Tasks tasks;
+  for (auto level = plan.levels.rbegin(); level != plan.levels.rend(); ++level)
+  {
+    tasks.clear();
+    for (auto const &group : *level)
+    {
+      tasks.emplace_back([this, &plan, &group, &error_signal, &errors, &leaf_errors]() {
+        for (SizeType position : group)
+        {
+          BackPropagateScheduled(plan, position, error_signal, errors, leaf_errors);
+        }
+      });
+    }
+    executor_->Run(tasks);
+  }
+
+  NodeErrorMapType ret;
+  for (SizeType position = 0; position < plan.nodes.size(); ++position)
+  {
+    if (plan.nodes[position]->GetInputs().empty())
+    {
+      ret[plan.nodes[position]] = std::move(leaf_errors[position]);
+    }
+  }
+  return ret;
+}
+
 ///////////////////////
 /// PRIVATE METHODS ///
 ///////////////////////
 
+/**
+ * Whether passes run level by level on the executor rather than recursively
+ */
+template <typename TensorType>
+bool Graph<TensorType>::IsScheduled() const
+{
+  return static_cast<bool>(executor_) && !math::meta::IsFixedPoint<DataType>;
+}
+
+/**
+ * Collects the ops of all nodes in this graph and its subgraphs
+ * @param ret set the ops are added to
+ */
+template <typename TensorType>
+void Graph<TensorType>::GetOps(std::unordered_set<void const *> &ret) const
+{
+  for (auto const &node : nodes_)
+  {
+    auto op_ptr = node.second->GetOp();
+    ret.insert(op_ptr.get());
+
+    auto graph_ptr = std::dynamic_pointer_cast<Graph<TensorType>>(op_ptr);
+    if (graph_ptr)
+    {
+      graph_ptr->GetOps(ret);
+    }
+  }
+}
+
+/**
+ * Returns the execution plan of the passes from root, building it on first use. Plans are
+ * discarded whenever the graph is relinked.
+ * @param root the node evaluated or backpropagated from
+ * @return
+ */
+template <typename TensorType>
+typename Graph<TensorType>::ExecutionPlan const &Graph<TensorType>::GetExecutionPlan(
+    NodeRawPtrType root)
+{
+  auto it = execution_plans_.find(root);
+  if (it != execution_plans_.end())
+  {
+    return it->second;
+  }
+
+  ExecutionPlan plan;
+
+  // collect all nodes the root depends on in topological order with an iterative post order
+  // traversal, and level them
+  std::vector<SizeType>                            node_levels;
+  std::vector<std::pair<NodeRawPtrType, SizeType>> stack{{root, 0}};
+  std::unordered_set<NodeRawPtrType>               visited{root};
+  while (!stack.empty())
+  {
+    NodeRawPtrType current = stack.back().first;
+    SizeType &     next    = stack.back().second;
+    auto const &   inputs  = current->GetInputs();
+
+    if (next < inputs.size())
+    {
+      auto input_ptr = inputs[next++].lock();
+      if (!input_ptr)
+      {
+        throw std::runtime_error("Unable to lock weak pointer.");
+      }
+      if (visited.insert(input_ptr.get()).second)
+      {
+        stack.emplace_back(input_ptr.get(), 0);
+      }
+      continue;
+    }
+
+    SizeType level = 0;
+    for (auto const &input : inputs)
+    {
+      level = std::max(level, node_levels[plan.index.at(input.lock().get())] + 1);
+    }
+
+    plan.index[current] = plan.nodes.size();
+    plan.nodes.emplace_back(current);
+    node_levels.emplace_back(level);
+    stack.pop_back();
+  }
+
+  // group the nodes of every level by the ops they use
+  std::vector<std::unordered_set<void const *>> node_ops(plan.nodes.size());
+  for (SizeType position = 0; position < plan.nodes.size(); ++position)
+  {
+    auto op_ptr = plan.nodes[position]->GetOp();
+    node_ops[position].insert(op_ptr.get());
+
+    auto graph_ptr = std::dynamic_pointer_cast<Graph<TensorType>>(op_ptr);
+    if (graph_ptr)
+    {
+      graph_ptr->SetExecutor(executor_);
+      graph_ptr->GetOps(node_ops[position]);
+    }
+  }
+
+  std::unordered_map<void const *, SizeType> op_counts;
+  for (auto const &ops : node_ops)
+  {
+    for (auto const &op : ops)
+    {
+      ++op_counts[op];
+    }
+  }
+
+  plan.shares_ops.resize(plan.nodes.size());
+  for (SizeType position = 0; position < plan.nodes.size(); ++position)
+  {
+    plan.shares_ops[position] =
+        std::any_of(node_ops[position].begin(), node_ops[position].end(),
+                    [&op_counts](void const *op) { return op_counts.at(op) > 1; });
+  }
+
+  auto shares_ops = [&node_ops](SizeType a, SizeType b) {
+    for (auto const &op : node_ops[a])
+    {
+      if (node_ops[b].find(op) != node_ops[b].end())
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  SizeType const level_count = *std::max_element(node_levels.begin(), node_levels.end()) + 1;
+  plan.levels.resize(level_count);
+  for (SizeType position = 0; position < plan.nodes.size(); ++position)
+  {
+    auto &groups = plan.levels[node_levels[position]];
+
+    // merge all groups this node conflicts with into the first of them
+    std::vector<SizeType> *target = nullptr;
+    for (auto group = groups.begin(); group != groups.end();)
+    {
+      bool const conflict = std::any_of(group->begin(), group->end(), [&](SizeType other) {
+        return shares_ops(position, other);
+      });
+
+      if (!conflict)
+      {
+        ++group;
+      }
+      else if (target == nullptr)
+      {
+        target = &(*group);
+        ++group;
+      }
+      else
+      {
+        target->insert(target->end(), group->begin(), group->end());
+        group = groups.erase(group);
+      }
+    }
+
+    if (target == nullptr)
+    {
+      groups.emplace_back(std::vector<SizeType>{position});
+    }
+    else
+    {
+      target->emplace_back(position);
+      std::sort(target->begin(), target->end());
+    }
+  }
+
+  // assign an error signal slot to every input of every node
+  plan.input_slots.resize(plan.nodes.size());
+  plan.output_slots.resize(plan.nodes.size());
+  for (SizeType position = 0; position < plan.nodes.size(); ++position)
+  {
+    plan.input_slots[position] = plan.slot_count;
+
+    for (auto const &input : plan.nodes[position]->GetInputs())
+    {
+      plan.output_slots[plan.index.at(input.lock().get())].emplace_back(plan.slot_count);
+      ++plan.slot_count;
+    }
+  }
+
+  return execution_plans_.emplace(root, std::move(plan)).first->second;
+}
+
+/**
+ * Backpropagates the node at position of the plan: sums the error signals its outputs have
+ * written, in slot order, and writes the error signals for its inputs
+ * @param plan
+ * @param position position of the node in the plan
+ * @param error_signal error signal of the root of the plan
+ * @param errors error signal slots of the plan
+ * @param leaf_errors error signals of the nodes without inputs
+ */
+template <typename TensorType>
+void Graph<TensorType>::BackPropagateScheduled(ExecutionPlan const &plan, SizeType position,
+                                               TensorType const &                    error_signal,
+                                               std::vector<TensorType> &             errors,
+                                               std::vector<std::vector<TensorType>> &leaf_errors)
+{
+  auto const &slots = plan.output_slots[position];
+
+  TensorType signal;
+  if (slots.empty())
+  {
+    // only the root has no outputs in the plan
+    signal = error_signal;
+  }
+  else if (slots.size() == 1)
+  {
+    signal = std::move(errors[slots.front()]);
+  }
+  else
+  {
+    // ops may return aliasing error signals, so accumulate into a copy
+    signal = errors[slots.front()].Copy();
+    for (auto slot = std::next(slots.begin()); slot != slots.end(); ++slot)
+    {
+      signal.InlineAdd(errors[*slot]);
+      errors[*slot] = TensorType{};
+    }
+    errors[slots.front()] = TensorType{};
+  }
+
+  NodeRawPtrType          node          = plan.nodes[position];
+  std::vector<TensorType> error_signals = node->Backward(signal);
+
+  if (plan.shares_ops[position])
+  {
+    for (auto &error : error_signals)
+    {
+      error = error.Copy();
+    }
+  }
+
+  if (node->GetInputs().empty())
+  {
+    leaf_errors[position] = std::move(error_signals);
+    return;
+  }
+
+  for (SizeType i = 0; i < error_signals.size(); ++i)
+  {
+    errors[plan.input_slots[position] + i] = std::move(error_signals[i]);
+  }
+}
+
 /**
  * Set regularisation type and rate for all trainables in graph
  * @tparam TensorType
@@ -475,6 +892,7 @@ bool Graph<T>::InsertNode(std::string const &node_name, NodePtrType node_ptr)
 {
   // put node in look up table
   nodes_[node_name] = node_ptr;
+  execution_plans_.clear();
   return nodes_.find(node_name) != nodes_.end();
 }
 
@@ -717,6 +1135,8 @@ template <typename TensorType>
 void Graph<TensorType>::LinkNodesInGraph(std::string const &             node_name,
                                          std::vector<std::string> const &inputs)
 {
+  execution_plans_.clear();
+
   // assign inputs and outputs
   for (auto const &i : inputs)
   {
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/set_thread_name.hpp"
+#include "ml/core/graph_executor.hpp"
+
+namespace fetch {
+namespace ml {
+
+/**
+ * @param num_threads total number of threads executing a batch, including the caller of Run
+ */
+GraphExecutor::GraphExecutor(SizeType num_threads)
+{
+  SizeType const num_workers = (num_threads > 1) ? num_threads - 1 : 0;
+
+  workers_.reserve(num_workers);
+  for (SizeType i = 0; i < num_workers; ++i)
+  {
+    workers_.emplace_back([this, i]() {
+      SetThreadName("GraphExec", i);
+      WorkerLoop();
+    });
+  }
+}
+
+GraphExecutor::~GraphExecutor()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+
+  for (auto &worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+/**
+ * Executes every task of the batch and returns when all of them have finished. If tasks throw,
+ * the exception of the lowest indexed failing task is rethrown once the whole batch is done, so
+ * the reported error does not depend on the thread timing.
+ * @param tasks independent tasks, which may run concurrently and in any order
+ */
+void GraphExecutor::Run(Tasks const &tasks)
+{
+  if (workers_.empty() || (tasks.size() < 2))
+  {
+    for (auto const &task : tasks)
+    {
+      task();
+    }
+    return;
+  }
+
+  auto batch = std::make_shared<Batch>(tasks);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_.push_back(batch);
+  cv_.notify_all();
+
+  while (batch->remaining != 0)
+  {
+    if (queue_.empty())
+    {
+      cv_.wait(lock, [this, &batch]() { return (batch->remaining == 0) || !queue_.empty(); });
+    }
+    else
+    {
+      RunOne(lock);
+    }
+  }
+  lock.unlock();
+
+  for (auto const &error : batch->errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+GraphExecutor::SizeType GraphExecutor::num_threads() const
+{
+  return workers_.size() + 1;
+}
+
+void GraphExecutor::WorkerLoop()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;)
+  {
+    cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (stop_)
+    {
+      return;
+    }
+
+    RunOne(lock);
+  }
+}
+
+/**
+ * Claims the next task of the oldest queued batch and runs it with the lock released
+ * @param lock held lock on mutex_, which is held again on return
+ */
+void GraphExecutor::RunOne(std::unique_lock<std::mutex> &lock)
+{
+  BatchPtr       batch = queue_.front();
+  SizeType const index = batch->next++;
+  if (batch->next == batch->tasks.size())
+  {
+    queue_.pop_front();
+  }
+
+  lock.unlock();
+  try
+  {
+    batch->tasks[index]();
+  }
+  catch (...)
+  {
+    batch->errors[index] = std::current_exception();
+  }
+  lock.lock();
+
+  if (--batch->remaining == 0)
+  {
+    cv_.notify_all();
+  }
+}
+
+}  // namespace ml
+}  // namespace fetch
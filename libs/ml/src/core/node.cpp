@@ -286,7 +286,12 @@ typename Node<TensorType>::VecTensorType Node<TensorType>::GatherInputs() const
 template <typename TensorType>
 std::shared_ptr<TensorType> Node<TensorType>::Evaluate(bool is_training)
 {
-  op_ptr_->SetTraining(is_training);
+  // only write the flag when it changes, so that nodes evaluated concurrently by a GraphExecutor
+  // may read the cached output of a shared input node
+  if (op_ptr_->IsTraining() != is_training)
+  {
+    op_ptr_->SetTraining(is_training);
+  }
 
   if (cached_output_status_ != CachedOutputState::VALID_CACHE)
   {
@@ -383,6 +388,36 @@ typename Node<TensorType>::NodeErrorMapType Node<TensorType>::BackPropagate(
   assert(!math::state_overflow<DataType>());
   return ret;
 }
+/**
+ * Backpropagates error_signal through the op of this node only, without recursing into the input
+ * nodes. The input nodes must hold a valid cached output.
+ * @param error_signal the error signal at the output of this node
+ * @return the error signals for each of the inputs of this node, or for the node itself if it has
+ * no inputs
+ */
+template <typename TensorType>
+std::vector<TensorType> Node<TensorType>::Backward(TensorType const &error_signal)
+{
+  std::vector<TensorType> error_signals = op_ptr_->Backward(GatherInputs(), error_signal);
+  assert(error_signals.size() == input_nodes_.size() || input_nodes_.empty());
+
+  if (math::state_division_by_zero<DataType>())
+  {
+    throw std::runtime_error("Division by zero encountered in Node::Backward");
+  }
+  if (math::state_infinity<DataType>())
+  {
+    throw std::runtime_error("Infinity encountered in Node::Backward");
+  }
+  if (math::state_nan<DataType>())
+  {
+    throw std::runtime_error("NaN encountered in Node::Backward");
+  }
+
+  assert(!math::state_overflow<DataType>());
+  return error_signals;
+}
+
 /**
  * Resets input and output node ptr containers. Useful for graph decompiling.
  * @tparam T
@@ -406,6 +441,17 @@ void Node<TensorType>::AddInput(NodeWeakPtrType const &i)
   input_nodes_.push_back(i);
 }
 
+/**
+ * gets all registered inputs of this node
+ * @tparam T tensor type
+ * @return vector of pointers to input nodes
+ */
+template <typename TensorType>
+std::vector<typename Node<TensorType>::NodeWeakPtrType> const &Node<TensorType>::GetInputs() const
+{
+  return input_nodes_;
+}
+
 /**
  * registers a node as an input to this node
  * @tparam T tensor type
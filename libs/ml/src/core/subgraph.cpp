@@ -41,7 +41,7 @@ void SubGraph<TensorType>::Forward(VecTensorType const &inputs, TensorType &outp
   {
     this->SetInput(input_node_names_[i], *(inputs.at(i)));
   }
-  output = *(this->nodes_[output_node_name_]->Evaluate(this->is_training_));
+  output = *(this->EvaluateNode(this->nodes_[output_node_name_], this->is_training_));
 }
 
 /**
@@ -62,7 +62,7 @@ std::vector<TensorType> SubGraph<TensorType>::Backward(VecTensorType const &inpu
   std::vector<TensorType> ret;
 
   NodeErrorMapType map_node_error_signals =
-      this->nodes_[output_node_name_]->BackPropagate(error_signal);
+      this->BackPropagateNode(this->nodes_[output_node_name_], error_signal);
   for (std::size_t i = 0; i < input_node_names_.size(); i++)
   {
     NodePtrType node          = this->nodes_[input_node_names_[i]];
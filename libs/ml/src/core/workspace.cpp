@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/workspace.hpp"
+
+namespace fetch {
+namespace ml {
+
+/**
+ * Returns the scratch tensor `slot` of `owner`, (re)allocating it if it does not have the
+ * requested shape. The contents of the tensor are unspecified.
+ * @param owner the op requesting the buffer
+ * @param slot index of the buffer within the op
+ * @param shape required shape
+ * @return reference to the buffer, valid until the owner is released or the workspace cleared
+ */
+template <typename TensorType>
+TensorType &Workspace<TensorType>::Get(void const *owner, SizeType slot, Shape const &shape)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Acquire(Key{owner, slot}, shape);
+}
+
+/**
+ * Preallocates the scratch tensors of `owner`, one per shape. Called when a graph is compiled so
+ * that shape inference, rather than the first training step, determines the buffer sizes.
+ * @param owner the op the buffers belong to
+ * @param shapes shapes of slots 0..n-1
+ */
+template <typename TensorType>
+void Workspace<TensorType>::Reserve(void const *owner, ShapeVector const &shapes)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (SizeType slot{0}; slot < shapes.size(); ++slot)
+  {
+    Acquire(Key{owner, slot}, shapes.at(slot));
+  }
+}
+
+/**
+ * Frees all the scratch tensors of `owner`
+ */
+template <typename TensorType>
+void Workspace<TensorType>::Release(void const *owner)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffers_.lower_bound(Key{owner, 0});
+  while ((it != buffers_.end()) && (it->first.first == owner))
+  {
+    it = buffers_.erase(it);
+  }
+}
+
+template <typename TensorType>
+void Workspace<TensorType>::Clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.clear();
+}
+
+/**
+ * Number of times a buffer had to be (re)allocated since construction
+ */
+template <typename TensorType>
+typename Workspace<TensorType>::SizeType Workspace<TensorType>::allocation_count() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocation_count_;
+}
+
+/**
+ * Total number of elements (re)allocated since construction
+ */
+template <typename TensorType>
+typename Workspace<TensorType>::SizeType Workspace<TensorType>::allocated_elements() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_elements_;
+}
+
+template <typename TensorType>
+TensorType &Workspace<TensorType>::Acquire(Key const &key, Shape const &shape)
+{
+  auto it = buffers_.find(key);
+  if (it == buffers_.end())
+  {
+    it = buffers_.emplace(key, TensorType(shape)).first;
+  }
+  else if (it->second.shape() != shape)
+  {
+    it->second.Resize(shape);
+  }
+  else
+  {
+    return it->second;
+  }
+
+  ++allocation_count_;
+  allocated_elements_ += it->second.size();
+
+  return it->second;
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+template class Workspace<math::Tensor<int8_t>>;
+template class Workspace<math::Tensor<int16_t>>;
+template class Workspace<math::Tensor<int32_t>>;
+template class Workspace<math::Tensor<int64_t>>;
+template class Workspace<math::Tensor<float>>;
+template class Workspace<math::Tensor<double>>;
+template class Workspace<math::Tensor<fixed_point::fp32_t>>;
+template class Workspace<math::Tensor<fixed_point::fp64_t>>;
+template class Workspace<math::Tensor<fixed_point::fp128_t>>;
+
+}  // namespace ml
+}  // namespace fetch
@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+
+#include "math/tensor/tensor.hpp"
+#include "ml/exceptions/exceptions.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+template <typename TensorType>
+constexpr typename PrefetchingDataLoader<TensorType>::SizeType
+    PrefetchingDataLoader<TensorType>::DEFAULT_DEPTH;
+
+template <typename TensorType>
+PrefetchingDataLoader<TensorType>::PrefetchingDataLoader(LoaderPtr loader, SizeType depth)
+  : loader_(std::move(loader))
+  , depth_(depth)
+  , ring_(depth + 1)
+{
+  if (!loader_)
+  {
+    throw exceptions::InvalidInput("PrefetchingDataLoader requires a dataloader to wrap");
+  }
+}
+
+template <typename TensorType>
+PrefetchingDataLoader<TensorType>::~PrefetchingDataLoader()
+{
+  Stop();
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType PrefetchingDataLoader<TensorType>::GetNext()
+{
+  Stop();
+  return loader_->GetNext();
+}
+
+/**
+ * Returns the next batch prepared by the background thread, starting the thread on the first
+ * call and restarting it whenever the batch size changes. Blocks only if the producer has not yet
+ * caught up with the consumer.
+ * @param batch_size number of samples in the batch
+ * @param is_done_set set to true if the wrapped loader reached the end of the data set while
+ * preparing this batch
+ * @return pair of label tensor and vector of data tensors
+ */
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType PrefetchingDataLoader<TensorType>::
+    PrepareBatch(SizeType batch_size, bool &is_done_set)
+{
+  if (depth_ == 0)
+  {
+    return loader_->PrepareBatch(batch_size, is_done_set);
+  }
+
+  if (!producer_.joinable() || batch_size != batch_size_)
+  {
+    Stop();
+    Start(batch_size);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // the consumer asked for a batch past the end of the epoch, let the producer carry on
+  if (paused_ && ready_ == 0)
+  {
+    paused_ = false;
+    cv_.notify_all();
+  }
+
+  cv_.wait(lock, [this] { return (ready_ > 0) || error_; });
+
+  if (ready_ == 0)
+  {
+    std::exception_ptr error = error_;
+    lock.unlock();
+
+    Stop();
+    std::rethrow_exception(error);
+  }
+
+  Batch const &batch = ring_[head_];
+  head_              = (head_ + 1) % ring_.size();
+  --ready_;
+
+  if (batch.is_done_set)
+  {
+    is_done_set = true;
+  }
+  done_ = batch.is_done;
+
+  // the slot consumed on the previous call is now free for the producer
+  cv_.notify_all();
+
+  return batch.data;
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::AddData(std::vector<TensorType> const &data,
+                                                TensorType const &             label)
+{
+  Stop();
+  return loader_->AddData(data, label);
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::SizeType PrefetchingDataLoader<TensorType>::Size()
+    const
+{
+  return loader_->Size();
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::IsDone() const
+{
+  if (producer_.joinable())
+  {
+    return done_;
+  }
+
+  return loader_->IsDone();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Reset()
+{
+  Stop();
+  loader_->Reset();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetTestRatio(fixed_point::fp32_t new_test_ratio)
+{
+  Stop();
+  loader_->SetTestRatio(new_test_ratio);
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetValidationRatio(fixed_point::fp32_t new_validation_ratio)
+{
+  Stop();
+  loader_->SetValidationRatio(new_validation_ratio);
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::IsModeAvailable(DataLoaderMode mode)
+{
+  Stop();
+  return loader_->IsModeAvailable(mode);
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetMode(DataLoaderMode new_mode)
+{
+  Stop();
+  loader_->SetMode(new_mode);
+  this->mode_ = new_mode;
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetRandomMode(bool random_mode_state)
+{
+  Stop();
+  loader_->SetRandomMode(random_mode_state);
+  this->random_mode_ = random_mode_state;
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetSeed(SizeType seed)
+{
+  Stop();
+  loader_->SetSeed(seed);
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::SizeType PrefetchingDataLoader<TensorType>::depth()
+    const
+{
+  return depth_;
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::LoaderPtr PrefetchingDataLoader<TensorType>::loader()
+    const
+{
+  return loader_;
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Start(SizeType batch_size)
+{
+  batch_size_ = batch_size;
+  done_       = loader_->IsDone();
+  producer_   = std::thread([this] { Produce(); });
+}
+
+/**
+ * Stops the background thread. The producer always runs until the ring is full or the epoch has
+ * ended before it exits, so the state left in the wrapped loader only depends on the batches
+ * consumed so far and on the depth, never on thread timing.
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!producer_.joinable())
+    {
+      return;
+    }
+    stop_ = true;
+  }
+  cv_.notify_all();
+
+  producer_.join();
+
+  head_   = 0;
+  ready_  = 0;
+  paused_ = false;
+  stop_   = false;
+  error_  = nullptr;
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Produce()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  for (;;)
+  {
+    cv_.wait(lock, [this] { return stop_ || !IsQuiescent(); });
+
+    if (IsQuiescent())
+    {
+      break;
+    }
+
+    // with at most depth_ - 1 ready slots this can never be the slot held by the consumer
+    Batch &slot = ring_[(head_ + ready_) % ring_.size()];
+    lock.unlock();
+
+    try
+    {
+      bool is_done_set{false};
+      AssignBatch(slot.data, loader_->PrepareBatch(batch_size_, is_done_set));
+      slot.is_done_set = is_done_set;
+      slot.is_done     = loader_->IsDone();
+    }
+    catch (...)
+    {
+      lock.lock();
+      error_ = std::current_exception();
+      cv_.notify_all();
+      break;
+    }
+
+    lock.lock();
+    ++ready_;
+    if (slot.is_done_set || slot.is_done)
+    {
+      paused_ = true;
+    }
+    cv_.notify_all();
+  }
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::IsQuiescent() const
+{
+  return (ready_ >= depth_) || paused_ || error_;
+}
+
+/**
+ * Copies a batch into a ring slot, reusing the slot's buffers whenever the shapes match
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::AssignBatch(ReturnType &dst, ReturnType const &src)
+{
+  auto assign = [](TensorType &to, TensorType const &from) {
+    if (to.shape() == from.shape())
+    {
+      to.Assign(from);
+    }
+    else
+    {
+      to = from.Copy();
+    }
+  };
+
+  assign(dst.first, src.first);
+
+  dst.second.resize(src.second.size());
+  for (SizeType i{0}; i < src.second.size(); ++i)
+  {
+    assign(dst.second[i], src.second[i]);
+  }
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+template class PrefetchingDataLoader<math::Tensor<std::int32_t>>;
+template class PrefetchingDataLoader<math::Tensor<std::int64_t>>;
+template class PrefetchingDataLoader<math::Tensor<float>>;
+template class PrefetchingDataLoader<math::Tensor<double>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp32_t>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp64_t>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp128_t>>;
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "math/matrix_operations.hpp"
+#include "math/meta/math_type_traits.hpp"
 #include "ml/ops/convolution_2d.hpp"
 #include "ml/saveparams/saveable_params.hpp"
 
@@ -44,9 +45,78 @@ std::shared_ptr<fetch::ml::ops::Ops<TensorType>> Convolution2D<TensorType>::Make
   return copyshare;
 }
 
+namespace {
+
+enum WorkspaceSlot : math::SizeType
+{
+  IM2COL = 0,  // [input_channels * kernel_height * kernel_width x output positions * batch]
+};
+
+template <typename TensorType>
+constexpr uint64_t GemmOptimisationFlags()
+{
+  return math::meta::HasVectorSupport<typename TensorType::Type>::value
+             ? platform::Parallelisation::VECTORISE
+             : platform::Parallelisation::NOT_PARALLEL;
+}
+
+/**
+ * c = a * b, where a, b and c are the 2D views of (possibly higher dimensional) tensors. The
+ * product is written straight into the existing storage of c.
+ */
+template <typename TensorType>
+void GemmNN(TensorType const &a, TensorType const &b, TensorType &c)
+{
+  using DataType = typename TensorType::Type;
+  using namespace math::linalg;
+
+  Blas<DataType, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * _A * _B + _beta * _C), GemmOptimisationFlags<TensorType>()>
+      gemm;
+  gemm(static_cast<DataType>(1), a.View(), b.View(), static_cast<DataType>(0), c.View());
+}
+
+/**
+ * c = a * T(b), see GemmNN
+ */
+template <typename TensorType>
+void GemmNT(TensorType const &a, TensorType const &b, TensorType &c)
+{
+  using DataType = typename TensorType::Type;
+  using namespace math::linalg;
+
+  Blas<DataType, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * _A * T(_B) + _beta * _C), GemmOptimisationFlags<TensorType>()>
+      gemm;
+  gemm(static_cast<DataType>(1), a.View(), b.View(), static_cast<DataType>(0), c.View());
+}
+
+/**
+ * c = T(a) * b, see GemmNN
+ */
+template <typename TensorType>
+void GemmTN(TensorType const &a, TensorType const &b, TensorType &c)
+{
+  using DataType = typename TensorType::Type;
+  using namespace math::linalg;
+
+  Blas<DataType, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * T(_A) * _B + _beta * _C), GemmOptimisationFlags<TensorType>()>
+      gemm;
+  gemm(static_cast<DataType>(1), a.View(), b.View(), static_cast<DataType>(0), c.View());
+}
+
+}  // namespace
+
 /**
  * Applies 2D convolution using im2col with General Matrix Multiplication described here:
  * https://www.scss.tcd.ie/~andersan/static/papers/asap-2017.pdf
+ *
+ * The im2col matrix is laid out so that the kernel tensor and the output tensor can be used
+ * directly as the left operand and the result of the matrix multiplication: its rows follow the
+ * [input_channels x kernel_height x kernel_width] order of the kernels and its columns the
+ * [output_height x output_width x batch] order of the output. The only scratch space needed is
+ * the im2col matrix itself, which is taken from the graph workspace.
  * @param inputs vector of tensor references where at:
  * inputs[0] = input_data[input_channels x input_height x input_width x batch_position], inputs[1] =
  * kernel_data[kernel_channels x kernel_height x kernel_width x batch_position]
@@ -64,39 +134,29 @@ void Convolution2D<TensorType>::Forward(VecTensorType const &inputs, TensorType
   assert(inputs.at(1)->shape().size() == 5);
   assert(output.shape() == ComputeOutputShape(inputs));
 
-  TensorType input   = (*inputs.at(0));
-  TensorType kernels = (*inputs.at(1));
+  TensorType const &input   = (*inputs.at(0));
+  TensorType const &kernels = (*inputs.at(1));
 
-  SizeType input_channels  = input.shape().at(0);
-  SizeType batch_size      = input.shape().at(3);
-  SizeType output_channels = kernels.shape().at(0);
-  SizeType kernel_height   = kernels.shape().at(2);
-  SizeType kernel_width    = kernels.shape().at(3);
-  SizeType output_height   = output.shape().at(1);
-  SizeType output_width    = output.shape().at(2);
+  SizeType input_channels = input.shape().at(0);
+  SizeType batch_size     = input.shape().at(3);
+  SizeType kernel_height  = kernels.shape().at(2);
+  SizeType kernel_width   = kernels.shape().at(3);
+  SizeType output_height  = output.shape().at(1);
+  SizeType output_width   = output.shape().at(2);
 
   SizeType horizontal_stride_width  = kernel_width * kernel_height * input_channels;
   SizeType horizontal_stride_height = output_height * output_width * batch_size;
-  SizeType vertical_stride_width    = output_channels;
 
   // Horizontal stride contains input data
-  TensorType horizontal_stride{{horizontal_stride_width, horizontal_stride_height}};
-  // Vertical stride contains kernel data
-  TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
+  TensorType &horizontal_stride =
+      this->ScratchTensor(IM2COL, {horizontal_stride_width, horizontal_stride_height});
 
   // Reshape input data to horizontal stride - im2col
   FillHorizontalStride(input, horizontal_stride, output_height, output_width, input_channels,
                        kernel_height, kernel_width, batch_size);
 
-  // Reshape kernel data to vertical stride - im2col
-  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
-                     kernel_width);
-
-  // Do matmul
-  TensorType reshaped_output = fetch::math::Dot(vertical_stride, horizontal_stride);
-
-  // Reshape values after matmul to output
-  FillOutput(reshaped_output, output, output_channels, output_height, output_width, batch_size);
+  // Do matmul, kernels are already in vertical stride layout
+  GemmNN(kernels, horizontal_stride, output);
 }
 
 /**
@@ -128,49 +188,36 @@ std::vector<TensorType> Convolution2D<TensorType>::Backward(VecTensorType const
   SizeType output_height = error_signal.shape().at(1);
   SizeType output_width  = error_signal.shape().at(2);
 
-  TensorType input   = (*inputs.at(0));
-  TensorType kernels = (*inputs.at(1));
+  TensorType const &input   = (*inputs.at(0));
+  TensorType const &kernels = (*inputs.at(1));
 
-  SizeType   input_channels  = input.shape().at(0);
-  SizeType   batch_size      = input.shape().at(3);
-  SizeType   output_channels = kernels.shape().at(0);
-  SizeType   kernel_height   = kernels.shape().at(2);
-  SizeType   kernel_width    = kernels.shape().at(3);
+  SizeType   input_channels = input.shape().at(0);
+  SizeType   batch_size     = input.shape().at(3);
+  SizeType   kernel_height  = kernels.shape().at(2);
+  SizeType   kernel_width   = kernels.shape().at(3);
   TensorType input_error(input.shape());
   TensorType kernel_error(kernels.shape());
 
   SizeType horizontal_stride_width  = kernel_width * kernel_height * input_channels;
   SizeType horizontal_stride_height = output_height * output_width * batch_size;
-  SizeType vertical_stride_width    = output_channels;
 
   // Horizontal stride contains input data
-  TensorType horizontal_stride{{horizontal_stride_width, horizontal_stride_height}};
-  // Vertical stride contains kernel data
-  TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
+  TensorType &horizontal_stride =
+      this->ScratchTensor(IM2COL, {horizontal_stride_width, horizontal_stride_height});
 
   // Reshape input data to horizontal stride - im2col
   FillHorizontalStride(input, horizontal_stride, output_height, output_width, input_channels,
                        kernel_height, kernel_width, batch_size);
 
-  // Reshape kernel data to vertical stride - im2col
-  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
-                     kernel_width);
+  // Backwards matmul for the kernels, error_signal is already in the gemm output layout
+  GemmNT(error_signal, horizontal_stride, kernel_error);
 
-  // Reshape error_signal to error for matmul
-  TensorType error{{vertical_stride_width, horizontal_stride_height}};
-  ReverseFillOutput(error, error_signal, output_channels, output_height, output_width, batch_size);
-
-  // Backwards matmul
-  TensorType error2 = fetch::math::DotTranspose(error, horizontal_stride);
-  TensorType error1 = fetch::math::TransposeDot(vertical_stride, error);
+  // The im2col matrix is no longer needed, reuse it for the error with respect to the input
+  GemmTN(kernels, error_signal, horizontal_stride);
 
   // Reshape horizontal stride to input data error_signal - reversed im2col
-  ReverseFillHorizontalStride(input_error, error1, output_height, output_width, input_channels,
-                              kernel_height, kernel_width, batch_size);
-
-  // Reshape vertical stride to kernel data error_signal - reversed im2col
-  ReverseFillVerticalStride(kernel_error, error2, output_channels, input_channels, kernel_height,
-                            kernel_width);
+  ReverseFillHorizontalStride(input_error, horizontal_stride, output_height, output_width,
+                              input_channels, kernel_height, kernel_width, batch_size);
 
   return {input_error, kernel_error};
 }
@@ -204,81 +251,29 @@ math::SizeType Convolution2D<TensorType>::ComputeOutputDim(SizeType const input_
   return output_dim;
 }
 
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshapes input tensor to vertical_stride tensor using im2col
- * @tparam TensorType
- * @param input
- * @param vertical_stride
- * @param output_channels
- * @param input_channels
- * @param kernel_height
- * @param kernel_width
- */
 template <class TensorType>
-void Convolution2D<TensorType>::FillVerticalStride(TensorType &input, TensorType &vertical_stride,
-                                                   SizeType const output_channels,
-                                                   SizeType const input_channels,
-                                                   SizeType const kernel_height,
-                                                   SizeType const kernel_width)
+typename Convolution2D<TensorType>::ShapeVector Convolution2D<TensorType>::ComputeWorkspaceShapes(
+    ShapeVector const &input_shapes) const
 {
-  SizeType j_s;                                           // stride height iterator
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    j_s = 0;
-    for (SizeType i_ic{0}; i_ic < input_channels; ++i_ic)  // Iterate over input channels
-    {
+  assert(input_shapes.size() == 2);
 
-      for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
-      {
-        for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
-        {
-          vertical_stride(i_oc, j_s) = input.At(i_oc, i_ic, i_k, j_k, 0);
-          ++j_s;
-        }
-      }
-    }
-  }
-}
+  Shape const &input_shape  = input_shapes.at(0);
+  Shape const &kernel_shape = input_shapes.at(1);
 
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshapes vertical_stride tensor to input tensor using reversed im2col
- * @tparam TensorType
- * @param input
- * @param vertical_stride
- * @param output_channels
- * @param input_channels
- * @param kernel_height
- * @param kernel_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::ReverseFillVerticalStride(
-    TensorType &input, TensorType &vertical_stride, SizeType const output_channels,
-    SizeType const input_channels, SizeType const kernel_height, SizeType const kernel_width)
-{
-  SizeType j_s;                                           // stride height iterator
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    j_s = 0;
-    for (SizeType i_ic{0}; i_ic < input_channels; ++i_ic)  // Iterate over input channels
-    {
+  SizeType output_height = ComputeOutputDim(input_shape.at(1), kernel_shape.at(2));
+  SizeType output_width  = ComputeOutputDim(input_shape.at(2), kernel_shape.at(3));
 
-      for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
-      {
-        for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
-        {
-          input(i_oc, i_ic, i_k, j_k, 0) = vertical_stride.At(i_oc, j_s);
-          ++j_s;
-        }
-      }
-    }
-  }
+  SizeType horizontal_stride_width  = kernel_shape.at(1) * kernel_shape.at(2) * kernel_shape.at(3);
+  SizeType horizontal_stride_height = output_height * output_width * input_shape.at(3);
+
+  return {{horizontal_stride_width, horizontal_stride_height}};
 }
 
 // TODO(issue 943): Make im2col efficient using iterators
 /**
- * Reshapes kernel(input) tensor to horizontal_stride tensor using im2col
+ * Reshapes kernel(input) tensor to horizontal_stride tensor using im2col. Rows are ordered as
+ * [input_channels x kernel_height x kernel_width] and columns as [output_height x output_width x
+ * batch_size], matching the memory layout of the kernel and output tensors.
  * @tparam TensorType
  * @param input
  * @param horizontal_stride
@@ -290,7 +285,7 @@ void Convolution2D<TensorType>::ReverseFillVerticalStride(
  */
 template <class TensorType>
 void Convolution2D<TensorType>::FillHorizontalStride(
-    TensorType &input, TensorType &horizontal_stride, SizeType const output_height,
+    TensorType const &input, TensorType &horizontal_stride, SizeType const output_height,
     SizeType const output_width, SizeType const input_channels, SizeType const kernel_height,
     SizeType const kernel_width, SizeType const batch_size)
 {
@@ -300,17 +295,16 @@ void Convolution2D<TensorType>::FillHorizontalStride(
   j_s = 0;
   for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
   {
-    for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
+    for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
     {
-      for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
+      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
       {
         i_s = 0;
-        for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
+        for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
         {
-
           for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
           {
-            for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
+            for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
             {
               horizontal_stride(i_s, j_s) =
                   input.At(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b);
@@ -326,7 +320,8 @@ void Convolution2D<TensorType>::FillHorizontalStride(
 
 // TODO(issue 943): Make im2col efficient using iterators
 /**
- * Reshapes horizontal_stride tensor to kernel(input) tensor using reversed im2col
+ * Reshapes horizontal_stride tensor to kernel(input) tensor using reversed im2col. Uses the
+ * layout described in FillHorizontalStride.
  * @tparam TensorType
  * @param input
  * @param horizontal_stride
@@ -338,21 +333,18 @@ void Convolution2D<TensorType>::FillHorizontalStride(
  */
 template <class TensorType>
 void Convolution2D<TensorType>::ReverseFillHorizontalStride(
-    TensorType &input, TensorType &horizontal_stride, SizeType const output_height,
+    TensorType &input, TensorType const &horizontal_stride, SizeType const output_height,
     SizeType const output_width, SizeType const input_channels, SizeType const kernel_height,
     SizeType const kernel_width, SizeType const batch_size)
 {
-  SizeType i_s;  // stride width index
-  SizeType j_s;  // stride height index
-
-  j_s = 0;
   for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
   {
     for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
     {
       for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
       {
-        i_s = 0;
+        SizeType const j_s = i_o + output_height * (j_o + output_width * i_b);
+
         for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
         {
 
@@ -360,84 +352,13 @@ void Convolution2D<TensorType>::ReverseFillHorizontalStride(
           {
             for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
             {
+              SizeType const i_s = i_ic + input_channels * (i_k + kernel_height * j_k);
+
               input(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b) =
                   horizontal_stride.At(i_s, j_s);
-              ++i_s;
             }
           }
         }
-        ++j_s;
-      }
-    }
-  }
-}
-
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshape gemm_output tensor (result of matmul on vertical and horizontal stride) to output tensor
- * @tparam TensorType
- * @param gemm_output
- * @param output
- * @param output_channels
- * @param output_height
- * @param output_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::FillOutput(TensorType const &gemm_output, TensorType &output,
-                                           SizeType const output_channels,
-                                           SizeType const output_height,
-                                           SizeType const output_width, SizeType const batch_size)
-{
-
-  SizeType it;
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    it = 0;
-    for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-    {
-      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
-      {
-        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
-        {
-          output(i_oc, i_o, j_o, i_b) = gemm_output.At(i_oc, it);
-          ++it;
-        }
-      }
-    }
-  }
-}
-
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshape output tensor to gemm_output tensor (result of matmul on vertical and horizontal stride)
- * @tparam TensorType
- * @param gemm_output
- * @param output
- * @param output_channels
- * @param output_height
- * @param output_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::ReverseFillOutput(TensorType &gemm_output, TensorType const &output,
-                                                  SizeType const output_channels,
-                                                  SizeType const output_height,
-                                                  SizeType const output_width,
-                                                  SizeType const batch_size)
-{
-
-  SizeType it;
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    it = 0;
-    for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-    {
-      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
-      {
-        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
-        {
-          gemm_output(i_oc, it) = output.At(i_oc, i_o, j_o, i_b);
-          ++it;
-        }
       }
     }
   }
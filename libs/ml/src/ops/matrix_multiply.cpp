@@ -143,6 +143,17 @@ std::vector<T> MatrixMultiply<T>::Backward(VecTensorType const &inputs,
       batch_size = inputs.at(1)->shape().at(2);
     }
 
+    // the error signal of a broadcast 2D input is summed over the batch, so it must start from
+    // zero on every call rather than from the result of the previous one
+    if (inputs.at(0)->shape().size() == 2)
+    {
+      error_signal_1_.Fill(typename TensorType::Type{0});
+    }
+    if (inputs.at(1)->shape().size() == 2)
+    {
+      error_signal_2_.Fill(typename TensorType::Type{0});
+    }
+
     // Iterate over batch
     for (SizeType i{0}; i < batch_size; i++)
     {
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+
+#include "math/base_types.hpp"
+#include "test_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class PrefetchingDataloaderTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(PrefetchingDataloaderTest, math::test::TensorFloatingTypes);
+
+namespace {
+
+template <typename TensorType>
+class LoaderFactory
+{
+public:
+  LoaderFactory()
+    : label_(TensorType::UniformRandomIntegers(10, 0, 100))
+    , data1_(TensorType::UniformRandomIntegers(60, 0, 100))
+    , data2_(TensorType::UniformRandomIntegers(20, 0, 100))
+  {
+    label_.Reshape({1, 10});
+    data1_.Reshape({2, 3, 10});
+    data2_.Reshape({2, 10});
+  }
+
+  // every loader made by the same factory holds the same data and produces the same batches
+  std::shared_ptr<dataloaders::TensorDataLoader<TensorType>> Make(bool random_mode) const
+  {
+    auto loader = std::make_shared<dataloaders::TensorDataLoader<TensorType>>();
+    loader->AddData({data1_, data2_}, label_);
+    loader->SetRandomMode(random_mode);
+    loader->SetSeed(1337);
+
+    return loader;
+  }
+
+private:
+  TensorType label_;
+  TensorType data1_;
+  TensorType data2_;
+};
+
+template <typename TensorType>
+void ExpectSameBatches(dataloaders::DataLoader<TensorType> &expected,
+                       dataloaders::DataLoader<TensorType> &actual, math::SizeType batch_size,
+                       math::SizeType n_batches)
+{
+  for (math::SizeType i{0}; i < n_batches; ++i)
+  {
+    bool expected_done{false};
+    bool actual_done{false};
+
+    auto const expected_batch = expected.PrepareBatch(batch_size, expected_done);
+    auto const actual_batch   = actual.PrepareBatch(batch_size, actual_done);
+
+    EXPECT_EQ(expected_done, actual_done);
+    EXPECT_EQ(expected.IsDone(), actual.IsDone());
+    EXPECT_EQ(expected_batch.first.shape(), actual_batch.first.shape());
+    EXPECT_TRUE(expected_batch.first.AllClose(actual_batch.first));
+    ASSERT_EQ(expected_batch.second.size(), actual_batch.second.size());
+    for (math::SizeType j{0}; j < expected_batch.second.size(); ++j)
+    {
+      EXPECT_TRUE(expected_batch.second.at(j).AllClose(actual_batch.second.at(j)));
+    }
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(PrefetchingDataloaderTest, sequential_batches_match_synchronous_loader)
+{
+  LoaderFactory<TypeParam> factory;
+  auto                     source = factory.Make(false);
+
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching(factory.Make(false), 4);
+  EXPECT_EQ(prefetching.LoaderCode(), LoaderType::PREFETCH);
+  EXPECT_EQ(prefetching.Size(), source->Size());
+
+  // several epochs, with a batch size which does not divide the data set
+  ExpectSameBatches<TypeParam>(*source, prefetching, 3, 12);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, random_batches_match_synchronous_loader)
+{
+  LoaderFactory<TypeParam> factory;
+  auto                     source = factory.Make(true);
+
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching(factory.Make(true), 4);
+
+  ExpectSameBatches<TypeParam>(*source, prefetching, 4, 12);
+
+  // reseeding discards the read-ahead and restarts from the same point as the synchronous loader
+  source->SetSeed(42);
+  source->Reset();
+  prefetching.SetSeed(42);
+  prefetching.Reset();
+
+  ExpectSameBatches<TypeParam>(*source, prefetching, 2, 12);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, batch_size_change_restarts_producer)
+{
+  LoaderFactory<TypeParam> factory;
+  auto                     source = factory.Make(false);
+
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching(factory.Make(false), 2);
+
+  // run to the end of an epoch so the read-ahead stops at the boundary
+  ExpectSameBatches<TypeParam>(*source, prefetching, 5, 2);
+  EXPECT_TRUE(prefetching.IsDone());
+
+  source->Reset();
+  prefetching.Reset();
+
+  ExpectSameBatches<TypeParam>(*source, prefetching, 10, 3);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, zero_depth_forwards_to_loader)
+{
+  LoaderFactory<TypeParam> factory;
+  auto                     source = factory.Make(true);
+
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching(factory.Make(true), 0);
+  EXPECT_EQ(prefetching.depth(), 0);
+
+  ExpectSameBatches<TypeParam>(*source, prefetching, 3, 8);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/core/graph_executor.hpp"
+#include "ml/layers/fully_connected.hpp"
+#include "ml/layers/self_attention_encoder.hpp"
+#include "ml/ops/add.hpp"
+#include "ml/ops/loss_functions/mean_square_error_loss.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+using SizeType = fetch::math::SizeType;
+
+template <typename T>
+class GraphExecutorTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(GraphExecutorTest, math::test::HighPrecisionTensorFloatingTypes);
+
+/**
+ * Three fully connected branches on the same input, two of which share their weights, summed into
+ * a mean square error loss
+ */
+template <typename TensorType>
+std::shared_ptr<Graph<TensorType>> MakeBranchedGraph()
+{
+  auto g = std::make_shared<Graph<TensorType>>();
+
+  std::string input = g->template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  std::string label = g->template AddNode<ops::PlaceHolder<TensorType>>("Label", {});
+
+  std::string left =
+      g->template AddNode<layers::FullyConnected<TensorType>>("Left", {input}, 4u, 3u);
+  std::string right = g->template AddNode<layers::FullyConnected<TensorType>>(
+      "Right", {input}, 4u, 3u, details::ActivationType::RELU);
+  std::string shared =
+      g->template AddNode<layers::FullyConnected<TensorType>>("Left", {input}, 4u, 3u);
+
+  std::string sum   = g->template AddNode<ops::Add<TensorType>>("Sum", {left, right});
+  std::string total = g->template AddNode<ops::Add<TensorType>>("Total", {sum, shared});
+  g->template AddNode<ops::MeanSquareErrorLoss<TensorType>>("Loss", {total, label});
+
+  return g;
+}
+
+template <typename TensorType>
+std::shared_ptr<Graph<TensorType>> MakeEncoderGraph()
+{
+  using DataType = typename TensorType::Type;
+
+  auto g = std::make_shared<Graph<TensorType>>();
+
+  std::string input = g->template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  std::string mask  = g->template AddNode<ops::PlaceHolder<TensorType>>("Mask", {});
+  std::string label = g->template AddNode<ops::PlaceHolder<TensorType>>("Label", {});
+
+  std::string encoder = g->template AddNode<layers::SelfAttentionEncoder<TensorType>>(
+      "Encoder", {input, mask}, static_cast<SizeType>(4), static_cast<SizeType>(12),
+      static_cast<SizeType>(24), DataType{0}, DataType{0}, DataType{0});
+  g->template AddNode<ops::MeanSquareErrorLoss<TensorType>>("Loss", {encoder, label});
+
+  return g;
+}
+
+template <typename TensorType>
+TensorType MakeData(math::SizeVector const &shape, SizeType seed)
+{
+  using DataType = typename TensorType::Type;
+
+  TensorType data(shape);
+  SizeType   i = seed;
+  for (auto &value : data)
+  {
+    value = fetch::math::Type<DataType>(std::to_string(static_cast<int>(i % 17) - 8)) /
+            DataType{10};
+    i = i * 7 + 3;
+  }
+  return data;
+}
+
+/**
+ * Runs one forward and backward pass and returns the loss followed by all gradients
+ */
+template <typename TensorType>
+std::vector<TensorType> RunPass(Graph<TensorType> &g, std::vector<std::string> const &inputs,
+                                std::vector<TensorType> const &data)
+{
+  for (SizeType i = 0; i < inputs.size(); ++i)
+  {
+    g.SetInput(inputs[i], data[i]);
+  }
+
+  std::vector<TensorType> ret{g.Evaluate("Loss")};
+  g.BackPropagate("Loss");
+
+  for (auto const &gradient : g.GetGradients())
+  {
+    ret.emplace_back(gradient);
+  }
+  for (auto const &trainable : g.GetTrainables())
+  {
+    trainable->ResetGradients();
+  }
+  return ret;
+}
+
+template <typename TensorType>
+void ExpectClose(std::vector<TensorType> const &expected, std::vector<TensorType> const &actual)
+{
+  using DataType = typename TensorType::Type;
+
+  ASSERT_EQ(expected.size(), actual.size());
+  for (SizeType i = 0; i < expected.size(); ++i)
+  {
+    EXPECT_TRUE(expected[i].AllClose(actual[i], fetch::math::function_tolerance<DataType>(),
+                                     fetch::math::function_tolerance<DataType>()));
+  }
+}
+
+TEST(GraphExecutorTest, runs_every_task_once)
+{
+  GraphExecutor executor(4);
+  EXPECT_EQ(executor.num_threads(), 4);
+
+  std::vector<std::atomic<SizeType>> counts(100);
+  GraphExecutor::Tasks               tasks;
+  for (auto &count : counts)
+  {
+    count = 0;
+    tasks.emplace_back([&count]() { ++count; });
+  }
+
+  executor.Run(tasks);
+  executor.Run(tasks);
+
+  for (auto const &count : counts)
+  {
+    EXPECT_EQ(count, 2);
+  }
+}
+
+TEST(GraphExecutorTest, tasks_can_run_nested_batches)
+{
+  GraphExecutor         executor(3);
+  std::atomic<SizeType> count{0};
+
+  GraphExecutor::Tasks inner;
+  for (SizeType i = 0; i < 8; ++i)
+  {
+    inner.emplace_back([&count]() { ++count; });
+  }
+
+  GraphExecutor::Tasks outer;
+  for (SizeType i = 0; i < 8; ++i)
+  {
+    outer.emplace_back([&executor, &inner]() { executor.Run(inner); });
+  }
+
+  executor.Run(outer);
+  EXPECT_EQ(count, 64);
+}
+
+TEST(GraphExecutorTest, rethrows_error_of_first_failing_task)
+{
+  for (SizeType num_threads : {1, 4})
+  {
+    GraphExecutor         executor(num_threads);
+    std::atomic<SizeType> count{0};
+
+    GraphExecutor::Tasks tasks;
+    for (SizeType i = 0; i < 16; ++i)
+    {
+      tasks.emplace_back([i, &count]() {
+        if (i == 5 || i == 9)
+        {
+          throw std::runtime_error(std::to_string(i));
+        }
+        ++count;
+      });
+    }
+
+    try
+    {
+      executor.Run(tasks);
+      FAIL() << "expected an exception";
+    }
+    catch (std::runtime_error const &e)
+    {
+      EXPECT_EQ(std::string(e.what()), "5");
+    }
+
+    // a single thread stops at the first error, a pool completes the batch
+    EXPECT_EQ(count, (num_threads == 1) ? 5 : 14);
+  }
+}
+
+TYPED_TEST(GraphExecutorTest, branched_graph_matches_recursive_evaluation)
+{
+  using TensorType = TypeParam;
+
+  auto                           g      = MakeBranchedGraph<TensorType>();
+  std::vector<std::string> const inputs = {"Input", "Label"};
+  std::vector<TensorType> const  data   = {MakeData<TensorType>({4, 5}, 1),
+                                        MakeData<TensorType>({3, 5}, 2)};
+
+  auto const expected = RunPass(*g, inputs, data);
+
+  g->SetExecutor(std::make_shared<GraphExecutor>(4));
+  ExpectClose(expected, RunPass(*g, inputs, data));
+
+  // evaluating a cached output does not rerun anything
+  EXPECT_EQ(g->Evaluate("Loss"), expected.front());
+}
+
+TYPED_TEST(GraphExecutorTest, encoder_gradients_do_not_depend_on_thread_count)
+{
+  using TensorType = TypeParam;
+
+  auto                           g      = MakeEncoderGraph<TensorType>();
+  std::vector<std::string> const inputs = {"Input", "Mask", "Label"};
+  std::vector<TensorType>        data   = {MakeData<TensorType>({12, 6, 2}, 1),
+                                  TensorType({6, 6, 2}), MakeData<TensorType>({12, 6, 2}, 2)};
+  data[1].Fill(typename TensorType::Type{1});
+
+  auto const recursive = RunPass(*g, inputs, data);
+
+  g->SetExecutor(std::make_shared<GraphExecutor>(1));
+  auto const expected = RunPass(*g, inputs, data);
+  ExpectClose(recursive, expected);
+
+  for (SizeType num_threads : {2, 4, 8})
+  {
+    g->SetExecutor(std::make_shared<GraphExecutor>(num_threads));
+    auto const actual = RunPass(*g, inputs, data);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (SizeType i = 0; i < expected.size(); ++i)
+    {
+      EXPECT_EQ(expected[i], actual[i]);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
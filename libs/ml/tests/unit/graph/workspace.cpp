@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/workspace.hpp"
+#include "ml/ops/convolution_2d.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class WorkspaceTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(WorkspaceTest, math::test::TensorFloatingTypes);
+
+TYPED_TEST(WorkspaceTest, buffers_are_reused_for_same_shape)
+{
+  using TensorType = TypeParam;
+
+  Workspace<TensorType> workspace;
+  int                   owner{0};
+
+  TensorType &first  = workspace.Get(&owner, 0, {4, 5});
+  TensorType &second = workspace.Get(&owner, 0, {4, 5});
+
+  EXPECT_EQ(&first, &second);
+  EXPECT_EQ(workspace.allocation_count(), 1u);
+  EXPECT_EQ(workspace.allocated_elements(), 20u);
+
+  TensorType &resized = workspace.Get(&owner, 0, {2, 3});
+  EXPECT_EQ(resized.shape(), (math::SizeVector{2, 3}));
+  EXPECT_EQ(workspace.allocation_count(), 2u);
+}
+
+TYPED_TEST(WorkspaceTest, owners_and_slots_do_not_alias)
+{
+  using TensorType = TypeParam;
+
+  Workspace<TensorType> workspace;
+  int                   owner_a{0};
+  int                   owner_b{0};
+
+  TensorType &a0 = workspace.Get(&owner_a, 0, {3});
+  TensorType &a1 = workspace.Get(&owner_a, 1, {3});
+  TensorType &b0 = workspace.Get(&owner_b, 0, {3});
+
+  EXPECT_NE(&a0, &a1);
+  EXPECT_NE(&a0, &b0);
+  EXPECT_EQ(workspace.allocation_count(), 3u);
+
+  workspace.Release(&owner_a);
+  workspace.Get(&owner_b, 0, {3});
+  EXPECT_EQ(workspace.allocation_count(), 3u);
+
+  workspace.Get(&owner_a, 0, {3});
+  EXPECT_EQ(workspace.allocation_count(), 4u);
+}
+
+TYPED_TEST(WorkspaceTest, convolution_2d_does_not_reallocate_between_passes)
+{
+  using TensorType    = TypeParam;
+  using VecTensorType = typename ops::Ops<TensorType>::VecTensorType;
+
+  TensorType input({3, 6, 6, 2});
+  TensorType kernels({4, 3, 3, 3, 1});
+  input.FillUniformRandom();
+  kernels.FillUniformRandom();
+
+  VecTensorType inputs;
+  inputs.emplace_back(std::make_shared<TensorType>(input));
+  inputs.emplace_back(std::make_shared<TensorType>(kernels));
+
+  ops::Convolution2D<TensorType> op;
+  TensorType                     output(op.ComputeOutputShape(inputs));
+  TensorType                     error_signal(op.ComputeOutputShape(inputs));
+
+  op.Forward(inputs, output);
+  op.Backward(inputs, error_signal);
+
+  auto allocations = op.GetWorkspace()->allocation_count();
+  EXPECT_EQ(allocations, 1u);
+
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    op.Forward(inputs, output);
+    op.Backward(inputs, error_signal);
+  }
+
+  EXPECT_EQ(op.GetWorkspace()->allocation_count(), allocations);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
@@ -118,4 +118,31 @@ TYPED_TEST(MatrixMultiplyTest, backward_batch_test)
   EXPECT_TRUE(backpropagated_signals[1].AllClose(gradient_b));
 }
 
+TYPED_TEST(MatrixMultiplyTest, backward_broadcast_is_repeatable)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam a({3, 4});
+  TypeParam b({4, 3, 2});
+  TypeParam error({3, 3, 2});
+  a.Fill(DataType{1});
+  b.Fill(DataType{2});
+  error.Fill(DataType{1});
+
+  fetch::ml::ops::MatrixMultiply<TypeParam> op;
+
+  std::vector<TypeParam> first =
+      op.Backward({std::make_shared<TypeParam>(a), std::make_shared<TypeParam>(b)}, error);
+  TypeParam const first_a = first[0].Copy();
+
+  std::vector<TypeParam> second =
+      op.Backward({std::make_shared<TypeParam>(a), std::make_shared<TypeParam>(b)}, error);
+
+  // the error signal of the broadcast input is summed over the batch on every call
+  TypeParam expected_a({3, 4});
+  expected_a.Fill(DataType{12});
+  EXPECT_TRUE(first_a.AllClose(expected_a));
+  EXPECT_TRUE(second[0].AllClose(expected_a));
+}
+
 }  // namespace
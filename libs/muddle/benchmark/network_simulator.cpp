@@ -0,0 +1,784 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network_simulator.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/serializers/counter.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha512.hpp"
+#include "kademlia/peer_info.hpp"
+#include "kademlia/primitives.hpp"
+#include "network/uri.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace muddle {
+namespace simulation {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+constexpr uint16_t SERVICE_SIMULATOR = 1;
+constexpr uint16_t CHANNEL_BROADCAST = 1;
+
+using CpuClock = std::chrono::steady_clock;
+
+/**
+ * Determine the number of bytes a message would occupy on the wire
+ *
+ * @tparam T The type of the message
+ * @param message The message to be sent
+ * @return The size of the message including the muddle packet header
+ */
+template <typename T>
+std::size_t WireSize(T const &message)
+{
+  serializers::SizeCounter counter;
+  counter << message;
+
+  return Packet::HEADER_SIZE + counter.size();
+}
+
+/**
+ * Generate the deterministic address of a simulated node
+ *
+ * @param index The index of the node
+ * @return The generated address
+ */
+Packet::Address GenerateAddress(std::size_t index)
+{
+  auto const value = static_cast<uint64_t>(index);
+
+  return crypto::Hash<crypto::SHA512>(
+      ConstByteArray{reinterpret_cast<uint8_t const *>(&value), sizeof(value)});
+}
+
+/**
+ * Generate a unique (fictional) TCP address for a simulated node
+ *
+ * @param index The index of the node
+ * @return The generated uri
+ */
+network::Uri GenerateUri(std::size_t index)
+{
+  auto const host = std::to_string((index >> 16u) & 0xFFu) + '.' +
+                    std::to_string((index >> 8u) & 0xFFu) + '.' + std::to_string(index & 0xFFu);
+
+  return network::Uri{"tcp://10." + host + ":8001"};
+}
+
+}  // namespace
+
+/**
+ * Schedule a callback to be executed after the specified (virtual) delay
+ *
+ * @param delay The delay relative to the current virtual time
+ * @param callback The callback to be executed
+ */
+void EventLoop::Post(Duration const &delay, Callback callback)
+{
+  auto const offset = std::max(delay.count(), Duration::rep{0});
+  auto const due    = static_cast<Wheel::Tick>(now_.count() + offset);
+
+  wheel_.Add(due, std::move(callback));
+}
+
+/**
+ * Execute all the events which are due up to the specified deadline
+ *
+ * When the deadline is reached without the stop condition being met the virtual clock is moved
+ * forward to the deadline.
+ *
+ * @param deadline The virtual time up until which events should be executed
+ * @param stop The optional condition, checked after each step, which terminates the run early
+ * @return The number of events executed
+ */
+std::size_t EventLoop::RunUntil(Duration const &deadline, Condition const &stop)
+{
+  auto const execute = [](Callback &&callback) { callback(); };
+  auto const limit   = static_cast<Wheel::Tick>(deadline.count());
+
+  std::size_t count{0};
+  for (;;)
+  {
+    if (stop && stop())
+    {
+      executed_ += count;
+      return count;
+    }
+
+    auto const next = wheel_.NextEvent();
+    if ((next == Wheel::NEVER) || (next > limit))
+    {
+      break;
+    }
+
+    now_ = Duration{static_cast<Duration::rep>(next)};
+    count += wheel_.Advance(next, execute);
+  }
+
+  if ((deadline != Duration::max()) && (deadline > now_))
+  {
+    wheel_.Advance(limit, execute);
+    now_ = deadline;
+  }
+
+  executed_ += count;
+  return count;
+}
+
+EventLoop::Duration EventLoop::now() const
+{
+  return now_;
+}
+
+std::size_t EventLoop::pending() const
+{
+  return wheel_.size();
+}
+
+std::size_t EventLoop::executed() const
+{
+  return executed_;
+}
+
+constexpr NetworkSimulator::Duration NetworkSimulator::NOT_CONVERGED;
+
+/**
+ * Construct the simulated network
+ *
+ * @param config The parameters of the network
+ */
+NetworkSimulator::NetworkSimulator(NetworkConfig const &config)
+  : config_{config}
+  , network_id_{"SIML"}
+  , rng_{config.seed}
+  , nodes_(config.nodes)
+  , node_stats_(config.nodes)
+{
+  for (NodeIndex i = 0; i < nodes_.size(); ++i)
+  {
+    auto &node = nodes_[i];
+
+    node.address     = GenerateAddress(i);
+    node.raw_address = Router::ConvertAddress(node.address);
+    node.table       = std::make_unique<KademliaTable>(node.address, network_id_);
+
+    node.info.address          = node.address;
+    node.info.kademlia_address = KademliaAddress::Create(node.address);
+    node.info.uri              = GenerateUri(i);
+    node.info.verified         = true;
+
+    index_.emplace(node.address, i);
+  }
+
+  ComputeNearestPeers();
+}
+
+/**
+ * Build the initial topology and start the peer tracking on all the nodes
+ *
+ * Every node connects to a random node which joined before it, guaranteeing that the network is
+ * connected, and then to further random nodes until it has its bootstrap connections. These
+ * connections are never dropped, in the same way as the configured peers of a real node.
+ */
+void NetworkSimulator::Start()
+{
+  running_ = true;
+
+  for (NodeIndex i = 1; i < nodes_.size(); ++i)
+  {
+    std::uniform_int_distribution<NodeIndex> earlier{0, i - 1};
+    Establish(i, earlier(rng_), SampleLatency(), true);
+  }
+
+  if (nodes_.size() > config_.bootstrap_connections)
+  {
+    std::uniform_int_distribution<NodeIndex> any{0, nodes_.size() - 1};
+
+    for (NodeIndex i = 0; i < nodes_.size(); ++i)
+    {
+      while (nodes_[i].links.size() < config_.bootstrap_connections)
+      {
+        Establish(i, any(rng_), SampleLatency(), true);
+      }
+    }
+  }
+
+  std::uniform_int_distribution<Duration::rep> phase{0, config_.round_interval.count()};
+  for (NodeIndex i = 0; i < nodes_.size(); ++i)
+  {
+    ScheduleRound(i, Duration{phase(rng_)});
+  }
+}
+
+/**
+ * Stop the peer tracking, once the outstanding requests have completed the network is idle
+ */
+void NetworkSimulator::Stop()
+{
+  running_ = false;
+}
+
+/**
+ * Run the simulation until all the nodes are connected to their nearest peers
+ *
+ * @param timeout The maximum (virtual) duration of the run
+ * @return The (virtual) time at which the network converged, otherwise NOT_CONVERGED
+ */
+NetworkSimulator::Duration NetworkSimulator::RunUntilConverged(Duration const &timeout)
+{
+  loop_.RunUntil(loop_.now() + timeout, [this]() { return converged_nodes_ == nodes_.size(); });
+
+  return convergence_time_;
+}
+
+void NetworkSimulator::RunFor(Duration const &duration)
+{
+  loop_.RunUntil(loop_.now() + duration);
+}
+
+void NetworkSimulator::RunUntilIdle()
+{
+  loop_.RunUntil(Duration::max());
+}
+
+/**
+ * Broadcast a message from the specified node to the whole network
+ *
+ * @param origin The index of the broadcasting node
+ * @param payload The payload to be broadcast
+ */
+void NetworkSimulator::Broadcast(NodeIndex origin, Payload const &payload)
+{
+  std::size_t const broadcast = broadcast_stats_.size();
+
+  broadcast_stats_.emplace_back();
+  broadcast_stats_.back().started   = loop_.now();
+  broadcast_stats_.back().completed = loop_.now();
+
+  Execute(origin, [this, origin, broadcast, &payload]() {
+    Packet packet{nodes_[origin].address, network_id_.value()};
+    packet.SetService(SERVICE_SIMULATOR);
+    packet.SetChannel(CHANNEL_BROADCAST);
+    packet.SetMessageNum(counter_++);
+    packet.SetTTL(Router::DEFAULT_TTL);
+    packet.SetPayload(payload);
+    packet.SetBroadcast(true);
+
+    RoutePacket(origin, packet, broadcast, false);
+  });
+}
+
+std::size_t NetworkSimulator::size() const
+{
+  return nodes_.size();
+}
+
+std::size_t NetworkSimulator::connections() const
+{
+  return connections_;
+}
+
+std::size_t NetworkSimulator::converged_nodes() const
+{
+  return converged_nodes_;
+}
+
+NetworkSimulator::Duration NetworkSimulator::convergence_time() const
+{
+  return convergence_time_;
+}
+
+/**
+ * Determine the (virtual) time by which a fraction of the nodes had, at least momentarily, been
+ * connected to all of their nearest peers
+ *
+ * @param fraction The fraction of nodes
+ * @return The time at which the fraction of nodes had converged, otherwise NOT_CONVERGED
+ */
+NetworkSimulator::Duration NetworkSimulator::ConvergenceTime(double fraction) const
+{
+  std::vector<Duration> times{};
+  times.reserve(nodes_.size());
+  for (auto const &node : nodes_)
+  {
+    times.push_back(node.converged_at);
+  }
+
+  auto const required =
+      static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(times.size())));
+  if ((required == 0) || (required > times.size()))
+  {
+    return NOT_CONVERGED;
+  }
+
+  auto const nth = times.begin() + static_cast<std::ptrdiff_t>(required - 1u);
+  std::nth_element(times.begin(), nth, times.end());
+
+  return *nth;
+}
+
+NetworkSimulator::Duration NetworkSimulator::now() const
+{
+  return loop_.now();
+}
+
+std::size_t NetworkSimulator::events() const
+{
+  return loop_.executed();
+}
+
+NetworkSimulator::NodeStatsList const &NetworkSimulator::node_stats() const
+{
+  return node_stats_;
+}
+
+NetworkSimulator::BroadcastStatsList const &NetworkSimulator::broadcast_stats() const
+{
+  return broadcast_stats_;
+}
+
+/**
+ * Initiate a connection between two nodes, the connection is established after a round trip
+ *
+ * @param from The node initiating the connection
+ * @param to The node being connected to
+ */
+void NetworkSimulator::Connect(NodeIndex from, NodeIndex to)
+{
+  auto &node = nodes_[from];
+
+  if ((from == to) || (node.link_index.find(to) != node.link_index.end()) ||
+      !node.connecting.insert(to).second)
+  {
+    return;
+  }
+
+  auto const latency = SampleLatency();
+  loop_.Post(latency * 2, [this, from, to, latency]() {
+    nodes_[from].connecting.erase(to);
+    Establish(from, to, latency, false);
+  });
+}
+
+/**
+ * Establish a link between two nodes, both of which register the other as alive
+ *
+ * @param from The node initiating the connection
+ * @param to The node being connected to
+ * @param latency The one way latency of the link
+ * @param persistent Flag to signal that the connection should never be dropped
+ */
+void NetworkSimulator::Establish(NodeIndex from, NodeIndex to, Duration const &latency,
+                                 bool persistent)
+{
+  auto &a = nodes_[from];
+  auto &b = nodes_[to];
+
+  if ((from == to) || (a.link_index.find(to) != a.link_index.end()))
+  {
+    return;
+  }
+
+  a.link_index.emplace(to, a.links.size());
+  a.links.push_back(Link{to, latency, Duration{0}, true, persistent});
+  b.link_index.emplace(from, b.links.size());
+  b.links.push_back(Link{from, latency, Duration{0}, false, persistent});
+
+  a.table->ReportLiveliness(b.address, a.address, b.info);
+  b.table->ReportLiveliness(a.address, b.address, a.info);
+
+  ++connections_;
+
+  UpdateConvergence(from);
+  UpdateConvergence(to);
+}
+
+/**
+ * Remove the link between two nodes
+ *
+ * @param from The node dropping the connection
+ * @param to The node at the other end of the connection
+ */
+void NetworkSimulator::Disconnect(NodeIndex from, NodeIndex to)
+{
+  auto const remove = [this](NodeIndex node, NodeIndex peer) {
+    auto &n  = nodes_[node];
+    auto  it = n.link_index.find(peer);
+    if (it == n.link_index.end())
+    {
+      return;
+    }
+
+    // move the last link into the vacated position
+    auto const position = it->second;
+    n.link_index.erase(it);
+
+    if (position + 1u != n.links.size())
+    {
+      n.links[position]                    = n.links.back();
+      n.link_index[n.links[position].peer] = position;
+    }
+    n.links.pop_back();
+  };
+
+  remove(from, to);
+  remove(to, from);
+
+  --connections_;
+
+  UpdateConvergence(from);
+  UpdateConvergence(to);
+}
+
+/**
+ * Send a message over the link between two connected nodes
+ *
+ * Messages are serialised onto the link one after another at the bandwidth of the link and arrive
+ * at the other end after the latency of the link.
+ *
+ * @param from The sending node
+ * @param to The receiving node
+ * @param size The size of the message in bytes
+ * @param on_receipt The callback executed by the receiving node
+ */
+void NetworkSimulator::Transmit(NodeIndex from, NodeIndex to, std::size_t size,
+                                EventLoop::Callback on_receipt)
+{
+  // messages to a peer which is no longer connected are lost
+  auto const it = nodes_[from].link_index.find(to);
+  if (it == nodes_[from].link_index.end())
+  {
+    return;
+  }
+
+  auto &link = nodes_[from].links[it->second];
+
+  auto const now       = loop_.now();
+  auto const bandwidth = std::max<uint64_t>(config_.bandwidth, 1u);
+  auto const serialise = Duration{static_cast<Duration::rep>((size * 1000000u) / bandwidth)};
+
+  link.busy_until = std::max(link.busy_until, now) + serialise;
+
+  auto &sender = node_stats_[from];
+  ++sender.messages_sent;
+  sender.bytes_sent += size;
+
+  loop_.Post(link.busy_until + link.latency - now,
+             [this, to, size, on_receipt = std::move(on_receipt)]() {
+               auto &receiver = node_stats_[to];
+               ++receiver.messages_received;
+               receiver.bytes_received += size;
+
+               Execute(to, on_receipt);
+             });
+}
+
+/**
+ * Execute a callback on behalf of a node, accounting the processing time to the node
+ *
+ * @param node The node executing the callback
+ * @param callback The callback to execute
+ */
+void NetworkSimulator::Execute(NodeIndex node, EventLoop::Callback const &callback)
+{
+  auto const start = CpuClock::now();
+  callback();
+  node_stats_[node].cpu_time += CpuClock::now() - start;
+}
+
+/**
+ * Check if the node is connected to all of its nearest peers
+ *
+ * @param node The node to be checked
+ */
+void NetworkSimulator::UpdateConvergence(NodeIndex node)
+{
+  auto &n = nodes_[node];
+
+  bool const converged = std::all_of(n.nearest.begin(), n.nearest.end(), [&n](NodeIndex peer) {
+    return n.link_index.find(peer) != n.link_index.end();
+  });
+
+  if (converged == n.converged)
+  {
+    return;
+  }
+
+  n.converged = converged;
+  if (!converged)
+  {
+    --converged_nodes_;
+    return;
+  }
+
+  ++converged_nodes_;
+  if (n.converged_at == NOT_CONVERGED)
+  {
+    n.converged_at = loop_.now();
+  }
+
+  if ((converged_nodes_ == nodes_.size()) && (convergence_time_ == NOT_CONVERGED))
+  {
+    convergence_time_ = loop_.now();
+  }
+}
+
+NetworkSimulator::Duration NetworkSimulator::SampleLatency()
+{
+  std::uniform_int_distribution<Duration::rep> latency{config_.min_latency.count(),
+                                                       config_.max_latency.count()};
+  return Duration{latency(rng_)};
+}
+
+/**
+ * Determine (from global knowledge) the peers closest to each of the nodes
+ *
+ * Peers are ranked with the same ordering as the Kademlia table uses
+ */
+void NetworkSimulator::ComputeNearestPeers()
+{
+  auto const count = std::min(config_.kademlia_connections, nodes_.size() - 1u);
+
+  std::vector<PeerInfo> candidates{};
+  candidates.reserve(nodes_.size());
+  for (auto const &node : nodes_)
+  {
+    candidates.push_back(node.info);
+  }
+
+  NodeIndices order(nodes_.size());
+  for (NodeIndex i = 0; i < nodes_.size(); ++i)
+  {
+    auto const &own = nodes_[i].info.kademlia_address;
+
+    for (auto &candidate : candidates)
+    {
+      candidate.distance = GetKademliaDistance(own, candidate.kademlia_address);
+    }
+
+    // the node itself is always at distance zero and therefore ranked first
+    for (NodeIndex j = 0; j < order.size(); ++j)
+    {
+      order[j] = j;
+    }
+
+    auto const middle = order.begin() + static_cast<std::ptrdiff_t>(count + 1u);
+    std::partial_sort(order.begin(), middle, order.end(), [&candidates](NodeIndex a, NodeIndex b) {
+      return candidates[a] < candidates[b];
+    });
+
+    nodes_[i].nearest.assign(order.begin() + 1, middle);
+  }
+}
+
+void NetworkSimulator::ScheduleRound(NodeIndex node, Duration const &delay)
+{
+  loop_.Post(delay, [this, node]() {
+    if (running_)
+    {
+      Execute(node, [this, node]() { TrackPeers(node); });
+      ScheduleRound(node, config_.round_interval);
+    }
+  });
+}
+
+/**
+ * Perform a single round of peer tracking for a node
+ *
+ * The node asks some of its peers for the peers closest to its own address, connects to the
+ * nearest peers it currently knows about and drops the other connections it made. This is a
+ * simplified version of the pull and connect to nearest behaviour of the PeerTracker.
+ *
+ * @param node The node performing the round
+ */
+void NetworkSimulator::TrackPeers(NodeIndex node)
+{
+  auto &n = nodes_[node];
+
+  // pull peer knowledge from the connected peers in turn
+  std::size_t const pulls = std::min(config_.pulls_per_round, n.links.size());
+  for (std::size_t i = 0; i < pulls; ++i)
+  {
+    auto const peer = n.links[n.next_pull++ % n.links.size()].peer;
+
+    Transmit(node, peer, WireSize(n.address), [this, peer, node]() { OnFindPeers(peer, node); });
+  }
+
+  // rank the known peers by distance alone and connect to the nearest of them
+  auto peers = n.table->FindPeer(n.address);
+  for (auto &peer : peers)
+  {
+    peer.verified = true;
+  }
+  std::sort(peers.begin(), peers.end());
+
+  NodeSet desired{};
+  for (auto const &peer : peers)
+  {
+    if (desired.size() >= config_.kademlia_connections)
+    {
+      break;
+    }
+
+    auto const it = index_.find(peer.address);
+    if ((it == index_.end()) || (it->second == node))
+    {
+      continue;
+    }
+
+    desired.insert(it->second);
+    Connect(node, it->second);
+  }
+
+  // drop the connections made previously which are no longer wanted
+  NodeIndices unwanted{};
+  for (auto const &link : n.links)
+  {
+    if (link.outgoing && !link.persistent && (desired.find(link.peer) == desired.end()))
+    {
+      unwanted.push_back(link.peer);
+    }
+  }
+
+  for (auto const &peer : unwanted)
+  {
+    Disconnect(node, peer);
+  }
+}
+
+/**
+ * Handle a request for the peers closest to the requesting node
+ *
+ * @param node The node receiving the request
+ * @param requester The node which sent the request
+ */
+void NetworkSimulator::OnFindPeers(NodeIndex node, NodeIndex requester)
+{
+  auto peers = nodes_[node].table->FindPeer(nodes_[requester].address);
+  auto size  = WireSize(peers);
+
+  Transmit(node, requester, size, [this, node, requester, peers = std::move(peers)]() {
+    OnPeers(requester, node, peers);
+  });
+}
+
+/**
+ * Handle the response to a request for peers
+ *
+ * @param node The node receiving the response
+ * @param responder The node which sent the response
+ * @param peers The peers reported by the responder
+ */
+void NetworkSimulator::OnPeers(NodeIndex node, NodeIndex responder, Peers const &peers)
+{
+  auto &n = nodes_[node];
+
+  n.table->ReportLiveliness(nodes_[responder].address, n.address, nodes_[responder].info);
+  for (auto const &peer : peers)
+  {
+    n.table->ReportExistence(peer, nodes_[responder].address);
+  }
+}
+
+/**
+ * Route a broadcast packet following the rules of the router
+ *
+ * @param node The node routing the packet
+ * @param packet The packet to be routed
+ * @param broadcast The index of the broadcast being routed
+ * @param external Flag to signal that this packet originated from the network
+ */
+void NetworkSimulator::RoutePacket(NodeIndex node, Packet &packet, std::size_t broadcast,
+                                   bool external)
+{
+  auto &n     = nodes_[node];
+  auto &stats = broadcast_stats_[broadcast];
+
+  if (external)
+  {
+    if (!Router::ConsumeTTL(packet))
+    {
+      ++node_stats_[node].ttl_expired;
+      ++stats.ttl_expired;
+      return;
+    }
+
+    if (!Router::RegisterEcho(n.echo_cache, packet, CpuClock::now()))
+    {
+      ++node_stats_[node].duplicates;
+      ++stats.duplicates;
+      return;
+    }
+  }
+
+  // like the router, the origin does not dispatch its own broadcast but does forward the first
+  // echo of it which it receives
+  if (packet.GetSenderRaw() != n.raw_address)
+  {
+    ++node_stats_[node].broadcasts_delivered;
+    ++stats.deliveries;
+    stats.completed = loop_.now();
+  }
+
+  ByteArray buffer{};
+  buffer.Resize(packet.GetPacketSize());
+  if (!Packet::ToBuffer(packet, buffer.pointer(), buffer.size()))
+  {
+    return;
+  }
+
+  Buffer const data{buffer};
+  for (auto const &link : n.links)
+  {
+    auto const peer = link.peer;
+
+    ++stats.transmissions;
+    Transmit(node, peer, data.size(),
+             [this, peer, data, broadcast]() { OnPacket(peer, data, broadcast); });
+  }
+}
+
+/**
+ * Handle a broadcast packet arriving at a node
+ *
+ * @param node The receiving node
+ * @param buffer The serialised packet
+ * @param broadcast The index of the broadcast
+ */
+void NetworkSimulator::OnPacket(NodeIndex node, Buffer const &buffer, std::size_t broadcast)
+{
+  Packet packet{};
+  if (Packet::FromBuffer(packet, buffer.pointer(), buffer.size()) &&
+      (packet.GetNetworkId() == network_id_.value()))
+  {
+    RoutePacket(node, packet, broadcast, true);
+  }
+}
+
+}  // namespace simulation
+}  // namespace muddle
+}  // namespace fetch
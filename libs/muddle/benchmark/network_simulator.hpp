@@ -0,0 +1,268 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/containers/timer_wheel.hpp"
+#include "kademlia/table.hpp"
+#include "muddle/network_id.hpp"
+#include "muddle/packet.hpp"
+#include "router.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+namespace simulation {
+
+/**
+ * Single threaded event loop driven by a virtual clock
+ *
+ * Events are executed in order of their due time and, for events which are due at the same time,
+ * in the order in which they were posted. Since nothing in the loop depends on the wall clock a
+ * simulation run is completely deterministic.
+ */
+class EventLoop
+{
+public:
+  using Duration  = std::chrono::microseconds;
+  using Callback  = std::function<void()>;
+  using Condition = std::function<bool()>;
+
+  // Construction / Destruction
+  EventLoop()                  = default;
+  EventLoop(EventLoop const &) = delete;
+  EventLoop(EventLoop &&)      = delete;
+  ~EventLoop()                 = default;
+
+  void        Post(Duration const &delay, Callback callback);
+  std::size_t RunUntil(Duration const &deadline, Condition const &stop = Condition{});
+
+  Duration    now() const;
+  std::size_t pending() const;
+  std::size_t executed() const;
+
+  // Operators
+  EventLoop &operator=(EventLoop const &) = delete;
+  EventLoop &operator=(EventLoop &&) = delete;
+
+private:
+  using Wheel = core::TimerWheel<Callback>;
+
+  Wheel       wheel_{};
+  Duration    now_{0};
+  std::size_t executed_{0};
+};
+
+/**
+ * The parameters of a simulated network
+ */
+struct NetworkConfig
+{
+  using Duration = EventLoop::Duration;
+
+  std::size_t nodes{500};                 ///< The number of muddle instances
+  std::size_t bootstrap_connections{2};   ///< The number of random peers each node starts with
+  std::size_t kademlia_connections{4};    ///< The number of nearest peers each node connects to
+  std::size_t pulls_per_round{1};         ///< The number of peers queried in each round
+  Duration    round_interval{500000};     ///< The interval between peer tracking rounds
+  Duration    min_latency{5000};          ///< The minimum one way latency of a link
+  Duration    max_latency{50000};         ///< The maximum one way latency of a link
+  uint64_t    bandwidth{12500000};        ///< The bandwidth of each link in bytes per second
+  uint64_t    seed{42};                   ///< The seed for the topology and latencies
+};
+
+/**
+ * The aggregated statistics for a single node
+ */
+struct NodeStats
+{
+  using Duration = std::chrono::nanoseconds;
+
+  uint64_t messages_sent{0};
+  uint64_t bytes_sent{0};
+  uint64_t messages_received{0};
+  uint64_t bytes_received{0};
+  uint64_t broadcasts_delivered{0};
+  uint64_t duplicates{0};
+  uint64_t ttl_expired{0};
+  Duration cpu_time{0};
+};
+
+/**
+ * The statistics for a single broadcast message
+ */
+struct BroadcastStats
+{
+  using Duration = EventLoop::Duration;
+
+  Duration started{0};        ///< The virtual time at which the broadcast was sent
+  Duration completed{0};      ///< The virtual time of the last delivery
+  uint64_t deliveries{0};     ///< The number of nodes to which the message was dispatched
+  uint64_t transmissions{0};  ///< The number of times the message was sent over a link
+  uint64_t duplicates{0};     ///< The number of copies discarded by echo suppression
+  uint64_t ttl_expired{0};    ///< The number of copies discarded because of the TTL
+};
+
+/**
+ * Deterministic, single process simulation of a muddle network
+ *
+ * Each simulated node holds a real Kademlia table which is populated with the peer tracking
+ * protocol: nodes periodically ask their peers for the peers closest to their own address, connect
+ * to the nearest ones they learn about and drop the other connections they made. Broadcasts are
+ * flooded across the resulting topology using real muddle packets and the same echo suppression
+ * and TTL rules as the router.
+ *
+ * Links have a latency and a bandwidth, so that large messages queue up behind each other. All
+ * time is virtual, the only thing measured against the wall clock is the processing time of each
+ * node which is reported as its CPU time.
+ */
+class NetworkSimulator
+{
+public:
+  using Address            = Packet::Address;
+  using Duration           = EventLoop::Duration;
+  using Payload            = Packet::Payload;
+  using NodeIndex          = std::size_t;
+  using NodeStatsList      = std::vector<NodeStats>;
+  using BroadcastStatsList = std::vector<BroadcastStats>;
+
+  static constexpr Duration NOT_CONVERGED = Duration::max();
+
+  // Construction / Destruction
+  explicit NetworkSimulator(NetworkConfig const &config);
+  NetworkSimulator(NetworkSimulator const &) = delete;
+  NetworkSimulator(NetworkSimulator &&)      = delete;
+  ~NetworkSimulator()                        = default;
+
+  /// @name Simulation Control
+  /// @{
+  void     Start();
+  void     Stop();
+  Duration RunUntilConverged(Duration const &timeout);
+  void     RunFor(Duration const &duration);
+  void     RunUntilIdle();
+  void     Broadcast(NodeIndex origin, Payload const &payload);
+  /// @}
+
+  /// @name Results
+  /// @{
+  std::size_t               size() const;
+  std::size_t               connections() const;
+  std::size_t               converged_nodes() const;
+  Duration                  convergence_time() const;
+  Duration                  ConvergenceTime(double fraction) const;
+  Duration                  now() const;
+  std::size_t               events() const;
+  NodeStatsList const &     node_stats() const;
+  BroadcastStatsList const &broadcast_stats() const;
+  /// @}
+
+  // Operators
+  NetworkSimulator &operator=(NetworkSimulator const &) = delete;
+  NetworkSimulator &operator=(NetworkSimulator &&) = delete;
+
+private:
+  using Peers       = KademliaTable::Peers;
+  using TablePtr    = std::unique_ptr<KademliaTable>;
+  using RandomGen   = std::mt19937_64;
+  using Buffer      = byte_array::ConstByteArray;
+  using EchoCache   = Router::EchoCache;
+  using NodeIndices = std::vector<NodeIndex>;
+  using NodeSet     = std::unordered_set<NodeIndex>;
+  using AddressMap  = std::unordered_map<Address, NodeIndex>;
+
+  struct Link
+  {
+    NodeIndex peer;
+    Duration  latency;
+    Duration  busy_until;
+    bool      outgoing;
+    bool      persistent;
+  };
+
+  using Links     = std::vector<Link>;
+  using LinkIndex = std::unordered_map<NodeIndex, std::size_t>;
+
+  struct Node
+  {
+    Address            address{};
+    Packet::RawAddress raw_address{};
+    PeerInfo           info{};
+    TablePtr           table{};
+    Links              links{};
+    LinkIndex          link_index{};
+    NodeSet            connecting{};
+    NodeIndices        nearest{};
+    std::size_t        next_pull{0};
+    bool               converged{false};
+    Duration           converged_at{NOT_CONVERGED};
+    EchoCache          echo_cache{};
+  };
+
+  using Nodes = std::vector<Node>;
+
+  void Connect(NodeIndex from, NodeIndex to);
+  void Establish(NodeIndex from, NodeIndex to, Duration const &latency, bool persistent);
+  void Disconnect(NodeIndex from, NodeIndex to);
+  void Transmit(NodeIndex from, NodeIndex to, std::size_t size, EventLoop::Callback on_receipt);
+  void Execute(NodeIndex node, EventLoop::Callback const &callback);
+  void     UpdateConvergence(NodeIndex node);
+  Duration SampleLatency();
+  void ComputeNearestPeers();
+
+  /// @name Peer Tracking
+  /// @{
+  void ScheduleRound(NodeIndex node, Duration const &delay);
+  void TrackPeers(NodeIndex node);
+  void OnFindPeers(NodeIndex node, NodeIndex requester);
+  void OnPeers(NodeIndex node, NodeIndex responder, Peers const &peers);
+  /// @}
+
+  /// @name Broadcast
+  /// @{
+  void RoutePacket(NodeIndex node, Packet &packet, std::size_t broadcast, bool external);
+  void OnPacket(NodeIndex node, Buffer const &buffer, std::size_t broadcast);
+  /// @}
+
+  NetworkConfig      config_;
+  NetworkId          network_id_;
+  EventLoop          loop_{};
+  RandomGen          rng_;
+  Nodes              nodes_{};
+  AddressMap         index_{};
+  bool               running_{false};
+  uint16_t           counter_{0};
+  std::size_t        connections_{0};
+  std::size_t        converged_nodes_{0};
+  Duration           convergence_time_{NOT_CONVERGED};
+  NodeStatsList      node_stats_{};
+  BroadcastStatsList broadcast_stats_{};
+};
+
+}  // namespace simulation
+}  // namespace muddle
+}  // namespace fetch
@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network_simulator.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+using fetch::byte_array::ByteArray;
+using fetch::muddle::simulation::NetworkConfig;
+using fetch::muddle::simulation::NetworkSimulator;
+using fetch::muddle::simulation::NodeStats;
+
+namespace {
+
+using Duration = NetworkSimulator::Duration;
+
+constexpr std::size_t BROADCASTS_PER_RUN{10};
+constexpr Duration    CONVERGENCE_TIMEOUT{std::chrono::minutes{1}};
+
+// convergence times are reported in seconds, or as -1 if the network did not converge
+double ToConvergenceSeconds(Duration const &duration)
+{
+  if (duration == NetworkSimulator::NOT_CONVERGED)
+  {
+    return -1.0;
+  }
+
+  return std::chrono::duration<double>(duration).count();
+}
+
+double ToMilliseconds(Duration const &duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/**
+ * Simulate a complete network: bootstrap it, wait for the peer tracking to converge and then send
+ * a number of broadcasts from different nodes one after another.
+ *
+ * All reported metrics, except for the wall clock duration of the benchmark itself and the CPU
+ * time of the nodes, are measured in virtual time and are therefore deterministic.
+ *
+ * Arguments: the number of nodes and the size of the broadcast payload in bytes
+ */
+void MuddleNetworkSimulation(benchmark::State &state)
+{
+  NetworkConfig config{};
+  config.nodes = static_cast<std::size_t>(state.range(0));
+
+  ByteArray payload{};
+  payload.Resize(static_cast<std::size_t>(state.range(1)));
+  for (std::size_t i = 0; i < payload.size(); ++i)
+  {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+
+  for (auto _ : state)
+  {
+    NetworkSimulator simulator{config};
+
+    simulator.Start();
+    auto const convergence = simulator.RunUntilConverged(CONVERGENCE_TIMEOUT);
+    simulator.Stop();
+    simulator.RunUntilIdle();
+
+    for (std::size_t i = 0; i < BROADCASTS_PER_RUN; ++i)
+    {
+      simulator.Broadcast((i * 7919u) % simulator.size(), payload);
+      simulator.RunUntilIdle();
+    }
+
+    // aggregate the broadcast statistics
+    double deliveries{0};
+    double transmissions{0};
+    double duplicates{0};
+    double completion{0};
+    for (auto const &broadcast : simulator.broadcast_stats())
+    {
+      deliveries += static_cast<double>(broadcast.deliveries);
+      transmissions += static_cast<double>(broadcast.transmissions);
+      duplicates += static_cast<double>(broadcast.duplicates);
+      completion += ToMilliseconds(broadcast.completed - broadcast.started);
+    }
+
+    // aggregate the per node processing time
+    NodeStats::Duration cpu_total{0};
+    NodeStats::Duration cpu_max{0};
+    for (auto const &node : simulator.node_stats())
+    {
+      cpu_total += node.cpu_time;
+      cpu_max = std::max(cpu_max, node.cpu_time);
+    }
+
+    auto const nodes      = static_cast<double>(simulator.size());
+    auto const broadcasts = static_cast<double>(BROADCASTS_PER_RUN);
+    auto const forwarders = deliveries + broadcasts;
+    auto const degree     = 2.0 * static_cast<double>(simulator.connections()) / nodes;
+    auto const cpu_mean   = std::chrono::duration<double, std::micro>(cpu_total).count() / nodes;
+    auto const cpu_peak   = std::chrono::duration<double, std::micro>(cpu_max).count();
+
+    state.counters["degree"]            = degree;
+    state.counters["converged"]         = static_cast<double>(simulator.converged_nodes()) / nodes;
+    state.counters["convergence_s"]     = ToConvergenceSeconds(convergence);
+    state.counters["convergence_p99_s"] = ToConvergenceSeconds(simulator.ConvergenceTime(0.99));
+    state.counters["coverage"]          = deliveries / (broadcasts * (nodes - 1.0));
+    state.counters["fanout"]            = transmissions / forwarders;
+    state.counters["duplicates"]        = duplicates / deliveries;
+    state.counters["broadcast_ms"]      = completion / broadcasts;
+    state.counters["cpu_us_node"]       = cpu_mean;
+    state.counters["cpu_us_node_max"]   = cpu_peak;
+    state.counters["events"]            = static_cast<double>(simulator.events());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(MuddleNetworkSimulation)
+    ->Args({100, 1024})
+    ->Args({500, 1024})
+    ->Args({1000, 1024})
+    ->Args({2000, 1024})
+    ->Args({500, 65536})
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
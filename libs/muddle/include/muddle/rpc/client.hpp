@@ -20,11 +20,14 @@
 #include "core/mutex.hpp"
 #include "muddle/address.hpp"
 #include "muddle/muddle_endpoint.hpp"
+#include "muddle/rpc/local_transport.hpp"
+#include "network/service/call_context.hpp"
 #include "network/service/client_interface.hpp"
 #include "network/service/promise.hpp"
 #include "network/service/types.hpp"
 
 #include <atomic>
+#include <functional>
 #include <list>
 #include <memory>
 #include <thread>
@@ -93,6 +96,50 @@ public:
     return prom;
   }
 
+  /**
+   * Call a function on a server which lives in this process
+   *
+   * The protocol function is invoked directly on the calling thread, without serialising the
+   * arguments or the result. If there is no such server in this process the call is not made and
+   * the caller should fall back to CallSpecificAddress.
+   *
+   * @tparam Signature The exact signature of the exposed protocol function
+   * @param address The address of the server
+   * @param protocol The protocol identifier
+   * @param function The function identifier
+   * @param args The arguments to the function
+   * @return The result of the call
+   */
+  template <typename Signature, typename... Args>
+  LocalCallResult<typename std::function<Signature>::result_type> CallLocal(
+      Address const &address, ProtocolId const &protocol, FunctionId const &function,
+      Args &&... args)
+  {
+    return LocalTransport::Instance().Call<Signature>(network_id_, address, service_, channel_,
+                                                      protocol, function,
+                                                      std::forward<Args>(args)...);
+  }
+
+  /**
+   * Call a function which has been exposed with a client context on a server in this process
+   *
+   * The context is populated as if the call had arrived over the network from this client.
+   *
+   * @see CallLocal
+   */
+  template <typename Signature, typename... Args>
+  LocalCallResult<typename std::function<Signature>::result_type> CallLocalWithClientContext(
+      Address const &address, ProtocolId const &protocol, FunctionId const &function,
+      Args &&... args)
+  {
+    service::CallContext context;
+    context.sender_address      = endpoint_.GetAddress();
+    context.transmitter_address = endpoint_.GetAddress();
+    context.MarkAsValid();
+
+    return CallLocal<Signature>(address, protocol, function, context, std::forward<Args>(args)...);
+  }
+
   // Operators
   Client &operator=(Client const &) = delete;
   Client &operator=(Client &&) = delete;
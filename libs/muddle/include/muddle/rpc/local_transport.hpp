@@ -0,0 +1,205 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "muddle/address.hpp"
+#include "muddle/network_id.hpp"
+#include "network/service/protocol.hpp"
+#include "network/service/server_interface.hpp"
+#include "network/service/types.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+namespace rpc {
+
+/**
+ * The result of an in-process call
+ *
+ * @tparam R The return type of the called function
+ */
+template <typename R>
+struct LocalCallResult
+{
+  bool handled{false};  ///< Set when a server in this process served the call
+  R    value{};         ///< The value returned by the called function
+};
+
+template <>
+struct LocalCallResult<void>
+{
+  bool handled{false};  ///< Set when a server in this process served the call
+};
+
+/**
+ * Process wide registry of RPC servers that can be called in-process
+ *
+ * RPC servers that opt in are registered against the network, address, service and channel on
+ * which they are reachable over muddle. A client that wants to make a call to the same address can
+ * then invoke the protocol function directly, avoiding the serialisation of the arguments and the
+ * result as well as the trip through the router and the network.
+ *
+ * Deregistering a server waits for all the in-flight in-process calls to that server to complete,
+ * after which it is safe to destroy the server and its protocols.
+ */
+class LocalTransport
+{
+public:
+  using ProtocolId = service::ProtocolHandlerType;
+  using FunctionId = service::FunctionHandlerType;
+  using Server     = service::ServiceServerInterface;
+
+  // Construction / Destruction
+  LocalTransport()                       = default;
+  LocalTransport(LocalTransport const &) = delete;
+  LocalTransport(LocalTransport &&)      = delete;
+  ~LocalTransport()                      = default;
+
+  static LocalTransport &Instance();
+
+  /// @name Server Registration
+  /// @{
+  void Register(NetworkId const &network, Address const &address, uint16_t service,
+                uint16_t channel, Server &server);
+  void Deregister(Server &server);
+  /// @}
+
+  template <typename Signature, typename... Args>
+  LocalCallResult<typename std::function<Signature>::result_type> Call(
+      NetworkId const &network, Address const &address, uint16_t service, uint16_t channel,
+      ProtocolId const &protocol, FunctionId const &function, Args &&... args);
+
+  // Operators
+  LocalTransport &operator=(LocalTransport const &) = delete;
+  LocalTransport &operator=(LocalTransport &&) = delete;
+
+private:
+  using SharedMutex = std::shared_timed_mutex;
+  using ReadLock    = std::shared_lock<SharedMutex>;
+  using WriteLock   = std::unique_lock<SharedMutex>;
+
+  struct Entry
+  {
+    Entry(NetworkId const &n, uint16_t s, uint16_t c, Server *srv)
+      : network{n.value()}
+      , service{s}
+      , channel{c}
+      , server{srv}
+    {}
+
+    NetworkId::UnderlyingType const network;
+    uint16_t const                  service;
+    uint16_t const                  channel;
+
+    SharedMutex lock;    ///< Held shared for the duration of each call
+    Server *    server;  ///< The registered server, cleared when deregistered
+  };
+
+  using EntryPtr  = std::shared_ptr<Entry>;
+  using EntryList = std::vector<EntryPtr>;
+  using EntryMap  = std::unordered_map<Address, EntryList>;
+
+  /**
+   * Invokes the protocol function, storing the returned value
+   */
+  template <typename R>
+  struct Invoker
+  {
+    template <typename Signature, typename... Args>
+    static void Invoke(LocalCallResult<R> &result, service::Protocol &protocol,
+                       FunctionId const &function, Args &&... args)
+    {
+      result.value   = protocol.Invoke<Signature>(function, std::forward<Args>(args)...);
+      result.handled = true;
+    }
+  };
+
+  EntryPtr Lookup(NetworkId const &network, Address const &address, uint16_t service,
+                  uint16_t channel) const;
+
+  mutable SharedMutex lock_;
+  EntryMap            entries_;
+};
+
+template <>
+struct LocalTransport::Invoker<void>
+{
+  template <typename Signature, typename... Args>
+  static void Invoke(LocalCallResult<void> &result, service::Protocol &protocol,
+                     FunctionId const &function, Args &&... args)
+  {
+    protocol.Invoke<Signature>(function, std::forward<Args>(args)...);
+    result.handled = true;
+  }
+};
+
+/**
+ * Call a protocol function on a server in this process
+ *
+ * Exceptions thrown by the called function are propagated to the caller.
+ *
+ * @tparam Signature The exact signature of the exposed protocol function
+ * @tparam Args The argument types
+ * @param network The network of the server
+ * @param address The address of the server
+ * @param service The service of the server
+ * @param channel The channel of the server
+ * @param protocol The protocol identifier
+ * @param function The function identifier
+ * @param args The arguments to the function
+ * @return The result, not handled if there is no such server (or protocol) in this process
+ */
+template <typename Signature, typename... Args>
+LocalCallResult<typename std::function<Signature>::result_type> LocalTransport::Call(
+    NetworkId const &network, Address const &address, uint16_t service, uint16_t channel,
+    ProtocolId const &protocol, FunctionId const &function, Args &&... args)
+{
+  using ReturnType = typename std::function<Signature>::result_type;
+
+  LocalCallResult<ReturnType> result{};
+
+  auto entry = Lookup(network, address, service, channel);
+  if (entry)
+  {
+    ReadLock const lock{entry->lock};
+
+    if (entry->server != nullptr)
+    {
+      auto *proto = entry->server->LookupProtocol(protocol);
+      if (proto != nullptr)
+      {
+        Invoker<ReturnType>::template Invoke<Signature>(result, *proto, function,
+                                                        std::forward<Args>(args)...);
+      }
+    }
+  }
+
+  return result;
+}
+
+}  // namespace rpc
+}  // namespace muddle
+}  // namespace fetch
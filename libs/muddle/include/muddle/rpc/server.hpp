@@ -47,7 +47,13 @@ public:
   Server(MuddleEndpoint &endpoint, uint16_t service, uint16_t channel);
   Server(Server const &) = delete;
   Server(Server &&)      = delete;
-  ~Server() override     = default;
+  ~Server() override;
+
+  /// @name In-process Calls
+  /// @{
+  void EnableLocalCalls();
+  void DisableLocalCalls();
+  /// @}
 
   // Operators
   Server &operator=(Server const &) = delete;
@@ -79,6 +79,12 @@ public:
   // Helper functions
   static Packet::RawAddress ConvertAddress(Packet::Address const &address);
   static Packet::Address    ConvertAddress(Packet::RawAddress const &address);
+  static std::size_t        GenerateEchoId(Packet const &packet);
+
+  // Flooding rules, shared with the network simulator
+  static constexpr uint8_t DEFAULT_TTL = 40;
+  static bool              ConsumeTTL(Packet &packet);
+  static bool              RegisterEcho(EchoCache &cache, Packet const &packet, Timepoint now);
 
   // Construction / Destruction
   Router(NetworkId network_id, Address address, MuddleRegister &reg, Prover const &prover,
@@ -610,6 +610,7 @@ void Muddle::RunPeriodicMaintenance()
       switch (peer.scheme())
       {
       case Uri::Scheme::Tcp:
+      case Uri::Scheme::Local:
         CreateTcpClient(peer);
         break;
       default:
@@ -661,7 +662,8 @@ void Muddle::CreateTcpServer(uint16_t port)
 }
 
 /**
- * Create a new TCP client connection to the specified peer
+ * Create a new TCP client connection to the specified peer. Peers with a local:// URI are connected
+ * to over the Unix domain socket of their server instead.
  *
  * @param peer The peer to connect to
  */
@@ -749,9 +751,7 @@ void Muddle::CreateTcpClient(Uri const &peer)
     }
   });
 
-  auto const &tcp_peer = peer.GetTcpPeer();
-
-  client.Connect(tcp_peer.address(), tcp_peer.port());
+  client.Connect(peer);
 }
 
 }  // namespace muddle
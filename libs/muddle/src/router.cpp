@@ -49,8 +49,6 @@
 #include <stdexcept>
 #include <utility>
 
-static constexpr uint8_t DEFAULT_TTL = 40;
-
 using fetch::byte_array::ByteArray;
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ToBase64;
@@ -61,35 +59,6 @@ namespace {
 
 constexpr char const *BASE_NAME = "Router";
 
-/**
- * Generate an id for echo cancellation id
- *
- * @param packet The input packet to generate the echo id
- * @return
- */
-std::size_t GenerateEchoId(Packet const &packet)
-{
-  crypto::FNV hash;
-  hash.Reset();
-
-  auto const service = packet.GetService();
-  auto const channel = packet.GetChannel();
-  auto const counter = packet.GetMessageNum();
-
-  hash.Update(packet.GetSenderRaw().data(), packet.GetSenderRaw().size());
-  hash.Update(reinterpret_cast<uint8_t const *>(&service), sizeof(service));
-  hash.Update(reinterpret_cast<uint8_t const *>(&channel), sizeof(channel));
-  hash.Update(reinterpret_cast<uint8_t const *>(&counter), sizeof(counter));
-
-  std::size_t out = 0;
-
-  static_assert(sizeof(out) == decltype(hash)::SIZE_IN_BYTES,
-                "Output type has incorrect size to contain hash");
-  hash.Final(reinterpret_cast<uint8_t *>(&out));
-
-  return out;
-}
-
 /**
  * Internal; Function used to compare two fixed size addresses
  *
@@ -231,6 +200,35 @@ Packet::Address Router::ConvertAddress(Packet::RawAddress const &address)
   return {address.data(), address.size()};
 }
 
+/**
+ * Generate an id for echo cancellation id
+ *
+ * @param packet The input packet to generate the echo id
+ * @return The echo id of the packet
+ */
+std::size_t Router::GenerateEchoId(Packet const &packet)
+{
+  crypto::FNV hash;
+  hash.Reset();
+
+  auto const service = packet.GetService();
+  auto const channel = packet.GetChannel();
+  auto const counter = packet.GetMessageNum();
+
+  hash.Update(packet.GetSenderRaw().data(), packet.GetSenderRaw().size());
+  hash.Update(reinterpret_cast<uint8_t const *>(&service), sizeof(service));
+  hash.Update(reinterpret_cast<uint8_t const *>(&channel), sizeof(channel));
+  hash.Update(reinterpret_cast<uint8_t const *>(&counter), sizeof(counter));
+
+  std::size_t out = 0;
+
+  static_assert(sizeof(out) == decltype(hash)::SIZE_IN_BYTES,
+                "Output type has incorrect size to contain hash");
+  hash.Final(reinterpret_cast<uint8_t *>(&out));
+
+  return out;
+}
+
 /**
  * Constructs a muddle router instance
  *
@@ -668,7 +666,7 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
     FETCH_LOG_TRACE(logging_name_, "Routing external packet.");
 
     // Handle TTL based routing timeout
-    if (packet->GetTTL() <= 2u)
+    if (!ConsumeTTL(*packet))
     {
       ttl_expired_packet_total_->increment();
 
@@ -677,8 +675,6 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
       ClearDeliveryAttempt(packet);
       return;
     }
-    // decrement the TTL
-    packet->SetTTL(static_cast<uint8_t>(packet->GetTTL() - 1u));
 
     // if this packet is a broadcast echo we should no longer route this packet
     if (packet->IsBroadcast() && IsEcho(*packet))
@@ -931,29 +927,45 @@ void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
  */
 bool Router::IsEcho(Packet const &packet, bool register_echo)
 {
-  bool is_echo = true;
-
-  // combine the 3 fields together into a single index
-  std::size_t const index = GenerateEchoId(packet);
+  FETCH_LOCK(echo_cache_lock_);
 
+  if (register_echo)
   {
-    FETCH_LOCK(echo_cache_lock_);
+    return !RegisterEcho(echo_cache_, packet, Clock::now());
+  }
 
-    // look up if the echo is in the cache
-    auto it = echo_cache_.find(index);
-    if (it == echo_cache_.end())
-    {
-      // register the echo (in needed)
-      if (register_echo)
-      {
-        echo_cache_[index] = Clock::now();
-      }
+  return echo_cache_.find(GenerateEchoId(packet)) != echo_cache_.end();
+}
 
-      is_echo = false;
-    }
+/**
+ * Apply the TTL rule to a packet received from the network. Packets with a remaining TTL of 2 or
+ * less have expired, all others have their TTL decremented before being routed further
+ *
+ * @param packet The reference to the packet
+ * @return true if the packet should be routed, false if it has expired
+ */
+bool Router::ConsumeTTL(Packet &packet)
+{
+  if (packet.GetTTL() <= 2u)
+  {
+    return false;
   }
 
-  return is_echo;
+  packet.SetTTL(static_cast<uint8_t>(packet.GetTTL() - 1u));
+  return true;
+}
+
+/**
+ * Register a broadcast packet in an echo cache
+ *
+ * @param cache The echo cache to be updated
+ * @param packet The reference to the packet
+ * @param now The time at which the packet was seen
+ * @return true if this is the first time the packet has been seen, false if it is an echo
+ */
+bool Router::RegisterEcho(EchoCache &cache, Packet const &packet, Timepoint now)
+{
+  return cache.emplace(GenerateEchoId(packet), now).second;
 }
 
 /**
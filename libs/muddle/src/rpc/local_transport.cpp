@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle/rpc/local_transport.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
+namespace fetch {
+namespace muddle {
+namespace rpc {
+
+/**
+ * Get the process wide instance of the transport
+ *
+ * @return The transport
+ */
+LocalTransport &LocalTransport::Instance()
+{
+  static LocalTransport instance;
+  return instance;
+}
+
+/**
+ * Register a server to be callable in-process
+ *
+ * @param network The network on which the server is reachable
+ * @param address The address of the server's muddle endpoint
+ * @param service The service of the server
+ * @param channel The channel of the server
+ * @param server The server
+ */
+void LocalTransport::Register(NetworkId const &network, Address const &address, uint16_t service,
+                              uint16_t channel, Server &server)
+{
+  WriteLock const lock{lock_};
+
+  auto &list = entries_[address];
+
+  auto const same = [&network, service, channel](EntryPtr const &entry) {
+    return (entry->network == network.value()) && (entry->service == service) &&
+           (entry->channel == channel);
+  };
+
+  // a newer server on the same address, service and channel replaces the previous one
+  list.erase(std::remove_if(list.begin(), list.end(), same), list.end());
+  list.emplace_back(std::make_shared<Entry>(network, service, channel, &server));
+}
+
+/**
+ * Deregister a server
+ *
+ * Blocks until all the in-process calls that are currently being served by the server have
+ * completed.
+ *
+ * @param server The server to be removed
+ */
+void LocalTransport::Deregister(Server &server)
+{
+  EntryList removed{};
+
+  {
+    WriteLock const lock{lock_};
+
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+      auto &list = it->second;
+
+      for (auto &entry : list)
+      {
+        if (entry->server == &server)
+        {
+          removed.push_back(entry);
+        }
+      }
+
+      list.erase(std::remove_if(list.begin(), list.end(),
+                                [&server](EntryPtr const &entry) {
+                                  return entry->server == &server;
+                                }),
+                 list.end());
+
+      it = list.empty() ? entries_.erase(it) : std::next(it);
+    }
+  }
+
+  // wait for any in-flight calls to drain
+  for (auto &entry : removed)
+  {
+    WriteLock const lock{entry->lock};
+    entry->server = nullptr;
+  }
+}
+
+/**
+ * Internal: Look up the registration for the specified server
+ *
+ * @return The registration if present, otherwise nullptr
+ */
+LocalTransport::EntryPtr LocalTransport::Lookup(NetworkId const &network, Address const &address,
+                                                uint16_t service, uint16_t channel) const
+{
+  ReadLock const lock{lock_};
+
+  auto it = entries_.find(address);
+  if (it != entries_.end())
+  {
+    for (auto const &entry : it->second)
+    {
+      if ((entry->network == network.value()) && (entry->service == service) &&
+          (entry->channel == channel))
+      {
+        return entry;
+      }
+    }
+  }
+
+  return {};
+}
+
+}  // namespace rpc
+}  // namespace muddle
+}  // namespace fetch
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "muddle/rpc/local_transport.hpp"
 #include "muddle/rpc/server.hpp"
 
 namespace fetch {
@@ -32,6 +33,34 @@ Server::Server(MuddleEndpoint &endpoint, uint16_t service, uint16_t channel)
   subscription_->SetMessageHandler(this, &Server::OnMessage);
 }
 
+Server::~Server()
+{
+  DisableLocalCalls();
+}
+
+/**
+ * Allow clients in this process to call the server's protocols directly
+ *
+ * All the protocols that are added to the server must outlive the server or a call to
+ * DisableLocalCalls().
+ */
+void Server::EnableLocalCalls()
+{
+  LocalTransport::Instance().Register(endpoint_.network_id(), endpoint_.GetAddress(), service_,
+                                      channel_, *this);
+}
+
+/**
+ * Stop serving in-process calls
+ *
+ * Blocks until all the in-process calls that are currently being served have completed. Calls
+ * made over the network are unaffected.
+ */
+void Server::DisableLocalCalls()
+{
+  LocalTransport::Instance().Deregister(*this);
+}
+
 bool Server::DeliverResponse(ConstByteArray const &address, network::MessageBuffer const &data)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Server::DeliverResponse to: ", address.ToBase64(), " mdl ",
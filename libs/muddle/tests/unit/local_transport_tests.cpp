@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle/rpc/client.hpp"
+#include "muddle/rpc/local_transport.hpp"
+#include "muddle/rpc/server.hpp"
+#include "network/service/call_context.hpp"
+#include "network/service/protocol.hpp"
+
+#include "fake_muddle_endpoint.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::muddle::NetworkId;
+using fetch::muddle::rpc::Client;
+using fetch::muddle::rpc::Server;
+using fetch::service::CallContext;
+
+constexpr uint16_t SERVICE  = 10;
+constexpr uint16_t CHANNEL  = 12;
+constexpr uint64_t PROTOCOL = 5;
+
+class ReflectProtocol : public fetch::service::Protocol
+{
+public:
+  enum
+  {
+    REFLECT = 1,
+    STORE,
+    SENDER
+  };
+
+  using ReflectSignature   = ConstByteArray(ConstByteArray const &);
+  using StoreSignature  = void(uint32_t);
+  using SenderSignature = ConstByteArray(CallContext const &);
+
+  ReflectProtocol()
+  {
+    Expose(REFLECT, this, &ReflectProtocol::Reflect);
+    Expose(STORE, this, &ReflectProtocol::Store);
+    ExposeWithClientContext(SENDER, this, &ReflectProtocol::Sender);
+  }
+
+  uint32_t stored{0};
+
+private:
+  ConstByteArray Reflect(ConstByteArray const &value)
+  {
+    return value;
+  }
+
+  void Store(uint32_t value)
+  {
+    stored = value;
+  }
+
+  ConstByteArray Sender(CallContext const &context)
+  {
+    return context.sender_address;
+  }
+};
+
+class LocalTransportTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    server_endpoint_ = std::make_unique<FakeMuddleEndpoint>("server", NetworkId{"Test"});
+    client_endpoint_ = std::make_unique<FakeMuddleEndpoint>("client", NetworkId{"Test"});
+
+    server_ = std::make_unique<Server>(*server_endpoint_, SERVICE, CHANNEL);
+    server_->Add(PROTOCOL, &protocol_);
+
+    client_ = std::make_unique<Client>("Client", *client_endpoint_, SERVICE, CHANNEL);
+  }
+
+  void TearDown() override
+  {
+    client_.reset();
+    server_.reset();
+  }
+
+  ReflectProtocol                        protocol_;
+  std::unique_ptr<FakeMuddleEndpoint> server_endpoint_;
+  std::unique_ptr<FakeMuddleEndpoint> client_endpoint_;
+  std::unique_ptr<Server>             server_;
+  std::unique_ptr<Client>             client_;
+};
+
+TEST_F(LocalTransportTests, CallsAreNotHandledUntilEnabled)
+{
+  auto const result = client_->CallLocal<ReflectProtocol::ReflectSignature>(
+      "server", PROTOCOL, ReflectProtocol::REFLECT, ConstByteArray{"hello"});
+
+  EXPECT_FALSE(result.handled);
+}
+
+TEST_F(LocalTransportTests, CallsInvokeProtocolDirectly)
+{
+  server_->EnableLocalCalls();
+
+  auto const echo = client_->CallLocal<ReflectProtocol::ReflectSignature>(
+      "server", PROTOCOL, ReflectProtocol::REFLECT, ConstByteArray{"hello"});
+  ASSERT_TRUE(echo.handled);
+  EXPECT_EQ(echo.value, ConstByteArray{"hello"});
+
+  auto const store = client_->CallLocal<ReflectProtocol::StoreSignature>("server", PROTOCOL,
+                                                                      ReflectProtocol::STORE, 42u);
+  EXPECT_TRUE(store.handled);
+  EXPECT_EQ(protocol_.stored, 42u);
+}
+
+TEST_F(LocalTransportTests, ClientContextCarriesClientAddress)
+{
+  server_->EnableLocalCalls();
+
+  auto const sender = client_->CallLocalWithClientContext<ReflectProtocol::SenderSignature>(
+      "server", PROTOCOL, ReflectProtocol::SENDER);
+
+  ASSERT_TRUE(sender.handled);
+  EXPECT_EQ(sender.value, ConstByteArray{"client"});
+}
+
+TEST_F(LocalTransportTests, OnlyMatchingServersAreCalled)
+{
+  server_->EnableLocalCalls();
+
+  // unknown address
+  EXPECT_FALSE((client_->CallLocal<ReflectProtocol::ReflectSignature>(
+                    "other", PROTOCOL, ReflectProtocol::REFLECT, ConstByteArray{"hello"}))
+                   .handled);
+
+  // unknown protocol
+  EXPECT_FALSE((client_->CallLocal<ReflectProtocol::ReflectSignature>(
+                    "server", PROTOCOL + 1, ReflectProtocol::REFLECT, ConstByteArray{"hello"}))
+                   .handled);
+
+  // different network
+  FakeMuddleEndpoint other_network{"client", NetworkId{"Othr"}};
+  Client             other_client{"Other", other_network, SERVICE, CHANNEL};
+  EXPECT_FALSE((other_client.CallLocal<ReflectProtocol::ReflectSignature>(
+                    "server", PROTOCOL, ReflectProtocol::REFLECT, ConstByteArray{"hello"}))
+                   .handled);
+}
+
+TEST_F(LocalTransportTests, SignatureMismatchThrows)
+{
+  server_->EnableLocalCalls();
+
+  EXPECT_THROW(
+      (client_->CallLocal<ConstByteArray(std::string const &)>(
+          "server", PROTOCOL, ReflectProtocol::REFLECT, std::string{})),
+      fetch::serializers::SerializableException);
+}
+
+TEST_F(LocalTransportTests, DisabledServersAreNotCalled)
+{
+  server_->EnableLocalCalls();
+  server_->DisableLocalCalls();
+
+  EXPECT_FALSE((client_->CallLocal<ReflectProtocol::ReflectSignature>(
+                    "server", PROTOCOL, ReflectProtocol::REFLECT, ConstByteArray{"hello"}))
+                   .handled);
+
+  server_->EnableLocalCalls();
+  server_.reset();
+
+  EXPECT_FALSE((client_->CallLocal<ReflectProtocol::ReflectSignature>(
+                    "server", PROTOCOL, ReflectProtocol::REFLECT, ConstByteArray{"hello"}))
+                   .handled);
+}
+
+}  // namespace
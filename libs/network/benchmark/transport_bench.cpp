@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/mutex.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/tcp/tcp_client.hpp"
+#include "network/tcp/tcp_server.hpp"
+#include "network/uri.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::network::MessageBuffer;
+using fetch::network::NetworkManager;
+using fetch::network::SetLocalSocketDirectory;
+using fetch::network::TCPClient;
+using fetch::network::TCPServer;
+using fetch::network::Uri;
+
+enum Transport : int64_t
+{
+  TCP   = 0,
+  LOCAL = 1
+};
+
+constexpr std::size_t PIPELINE_DEPTH     = 64;
+constexpr std::size_t CONNECT_TIMEOUT_MS = 5000;
+constexpr char const *LOCAL_SOCKET_DIR   = "/tmp";
+
+// Server which sends every message straight back to the client which sent it
+class EchoServer : public TCPServer
+{
+public:
+  EchoServer(uint16_t port, NetworkManager const &network_manager)
+    : TCPServer(port, network_manager)
+  {}
+
+  ~EchoServer() override = default;
+
+  void PushRequest(ConnectionHandleType client, MessageBuffer const &msg) override
+  {
+    Send(client, msg);
+  }
+};
+
+// Client which counts the echoes received from the server
+class EchoClient : public TCPClient
+{
+public:
+  explicit EchoClient(NetworkManager const &network_manager)
+    : TCPClient(network_manager)
+  {
+    OnMessage([this](MessageBuffer const &) {
+      {
+        FETCH_LOCK(lock_);
+        ++received_;
+      }
+      cv_.notify_one();
+    });
+  }
+
+  ~EchoClient()
+  {
+    TCPClient::Cleanup();
+  }
+
+  void WaitForEchoes(std::size_t count)
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    cv_.wait(lock, [this, count] { return received_ >= count; });
+    received_ -= count;
+  }
+
+private:
+  std::mutex              lock_;
+  std::condition_variable cv_;
+  std::size_t             received_{0};
+};
+
+Uri MakeUri(int64_t transport, uint16_t port)
+{
+  if (transport == LOCAL)
+  {
+    return Uri{"local://" + std::to_string(port)};
+  }
+
+  return Uri{"tcp://127.0.0.1:" + std::to_string(port)};
+}
+
+void SetTransportLabel(benchmark::State &state)
+{
+  state.SetLabel(state.range(0) == LOCAL ? "local" : "tcp");
+}
+
+/**
+ * Measure the round trip time of a single message to an echo server on the same host
+ */
+void Transport_Latency(benchmark::State &state)
+{
+  SetLocalSocketDirectory(LOCAL_SOCKET_DIR);
+
+  NetworkManager network_manager{"TransportBench", 2};
+  network_manager.Start();
+
+  EchoServer server{0, network_manager};
+  server.Start();
+
+  EchoClient client{network_manager};
+  client.Connect(MakeUri(state.range(0), server.GetListeningPort()));
+
+  if (!client.WaitForAlive(CONNECT_TIMEOUT_MS))
+  {
+    state.SkipWithError("Unable to connect to echo server");
+    return;
+  }
+
+  ByteArray message;
+  message.Resize(static_cast<std::size_t>(state.range(1)));
+
+  for (auto _ : state)
+  {
+    client.Send(message);
+    client.WaitForEchoes(1);
+  }
+
+  SetTransportLabel(state);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(1) * 2);
+}
+
+/**
+ * Measure the throughput of an echo server on the same host when the client keeps a window of
+ * messages in flight
+ */
+void Transport_Throughput(benchmark::State &state)
+{
+  SetLocalSocketDirectory(LOCAL_SOCKET_DIR);
+
+  NetworkManager network_manager{"TransportBench", 2};
+  network_manager.Start();
+
+  EchoServer server{0, network_manager};
+  server.Start();
+
+  EchoClient client{network_manager};
+  client.Connect(MakeUri(state.range(0), server.GetListeningPort()));
+
+  if (!client.WaitForAlive(CONNECT_TIMEOUT_MS))
+  {
+    state.SkipWithError("Unable to connect to echo server");
+    return;
+  }
+
+  ByteArray message;
+  message.Resize(static_cast<std::size_t>(state.range(1)));
+
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < PIPELINE_DEPTH; ++i)
+    {
+      client.Send(message);
+    }
+
+    client.WaitForEchoes(PIPELINE_DEPTH);
+  }
+
+  auto const messages = static_cast<int64_t>(state.iterations() * PIPELINE_DEPTH);
+
+  SetTransportLabel(state);
+  state.SetItemsProcessed(messages);
+  state.SetBytesProcessed(messages * state.range(1) * 2);
+}
+
+void TransportArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t transport : {TCP, LOCAL})
+  {
+    for (int64_t size : {64, 1024, 16384, 262144})
+    {
+      b->Args({transport, size});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(Transport_Latency)
+    ->Apply(TransportArguments)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(Transport_Throughput)
+    ->Apply(TransportArguments)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
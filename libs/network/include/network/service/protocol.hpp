@@ -27,6 +27,9 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -117,6 +120,7 @@ public:
     }
 
     members_[n] = fnc;
+    ExposeDirect(n, instance, function);
   }
 
   template <typename C, typename R, typename... Args>
@@ -133,6 +137,46 @@ public:
     }
 
     members_[n] = fnc;
+    ExposeDirect(n, instance, function);
+  }
+
+  /* Invokes an exposed function directly, without serializing the
+   * arguments or the result.
+   * @Signature is the exact signature of the exposed member function,
+   * e.g. Document(ResourceID const &). For functions exposed with a
+   * client context the first argument is the CallContext.
+   * @n is the identifier of the exposed function.
+   *
+   * This is used by in-process transports where the caller and the
+   * protocol share an address space.
+   *
+   * This function throws a <SerializableException> if the identifier
+   * does not map to a callable or if the signature does not match.
+   *
+   * @return the value returned by the exposed function.
+   */
+  template <typename Signature, typename... Params>
+  typename std::function<Signature>::result_type Invoke(FunctionHandlerType const &n,
+                                                        Params &&... params)
+  {
+    using Function = std::function<Signature>;
+
+    auto iter = direct_members_.find(n);
+    if (iter == direct_members_.end())
+    {
+      throw serializers::SerializableException(
+          error::MEMBER_NOT_FOUND, ByteArrayType("Could not find protocol member function"));
+    }
+
+    if (iter->second.type != std::type_index(typeid(Function)))
+    {
+      throw serializers::SerializableException(
+          error::MEMBER_NOT_FOUND, ByteArrayType("Protocol member function signature mismatch"));
+    }
+
+    auto &function = *static_cast<Function *>(iter->second.function.get());
+
+    return function(std::forward<Params>(params)...);
   }
 
   virtual void ConnectionDropped(ConnectionHandleType /*connection_handle*/)
@@ -151,7 +195,31 @@ public:
 private:
   static constexpr char const *LOGGING_NAME = "Protocol";
 
-  std::map<FunctionHandlerType, StoredType> members_;
+  /* A type erased, typed handle to an exposed member function.
+   *
+   * The function is stored as a std::function<R(Args...)> and the type
+   * is recorded so that Invoke can check the requested signature.
+   */
+  struct DirectMember
+  {
+    std::type_index       type;
+    std::shared_ptr<void> function;
+  };
+
+  template <typename C, typename R, typename... Args>
+  void ExposeDirect(FunctionHandlerType const &n, C *instance, R (C::*function)(Args...))
+  {
+    using Function = std::function<R(Args...)>;
+
+    auto direct = std::make_shared<Function>([instance, function](Args... args) -> R {
+      return (instance->*function)(std::forward<Args>(args)...);
+    });
+
+    direct_members_.emplace(n, DirectMember{std::type_index(typeid(Function)), std::move(direct)});
+  }
+
+  std::map<FunctionHandlerType, StoredType>   members_;
+  std::map<FunctionHandlerType, DirectMember> direct_members_;
 };
 }  // namespace service
 }  // namespace fetch
@@ -60,6 +60,22 @@ public:
     members_[name] = protocol;
   }
 
+  /**
+   * Look up a previously added protocol
+   *
+   * @param name The protocol identifier
+   * @return The protocol if present, otherwise nullptr
+   */
+  Protocol *LookupProtocol(ProtocolHandlerType const &name) const
+  {
+    if (name < 1 || name > 255)
+    {
+      return nullptr;
+    }
+
+    return members_[name];
+  }
+
 protected:
   virtual bool DeliverResponse(ConstByteArray const &address, network::MessageBuffer const &) = 0;
 
@@ -24,6 +24,7 @@
 #include "network/management/client_manager.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/tcp/local_socket.hpp"
 
 #include "network/fetch_asio.hpp"
 #include <atomic>
@@ -47,11 +48,11 @@ public:
   using HandleType     = typename AbstractConnection::ConnectionHandleType;
   using Strand         = asio::io_service::strand;
   using StrongStrand   = std::shared_ptr<asio::io_service::strand>;
-  using Socket         = asio::ip::tcp::tcp::socket;
+  using Socket         = StreamSocketType;
   using SharedSelfType = std::shared_ptr<AbstractConnection>;
   using MutexType      = std::mutex;
 
-  ClientConnection(std::weak_ptr<asio::ip::tcp::tcp::socket> socket,
+  ClientConnection(std::weak_ptr<Socket> socket,
                    std::weak_ptr<ClientManager> manager, NetworkManager network_manager)
     : socket_(std::move(socket))
     , manager_(std::move(manager))
@@ -61,16 +62,13 @@ public:
     if (socket_ptr)
     {
 
-      // Prevent this from throwing
-      std::error_code         ec;
-      asio::ip::tcp::endpoint endpoint = (*socket_ptr).remote_endpoint(ec);
+      std::string const address = GetRemoteAddress(*socket_ptr);
 
-      if (!ec)
+      if (!address.empty())
       {
-        this->SetAddress(endpoint.address().to_string());
+        this->SetAddress(address);
 
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Connection from ",
-                        socket_ptr->remote_endpoint().address().to_string());
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Connection from ", address);
       }
       else
       {
@@ -178,9 +176,9 @@ public:
   }
 
 private:
-  std::atomic<bool>                         shutting_down_{false};
-  std::weak_ptr<asio::ip::tcp::tcp::socket> socket_;
-  std::weak_ptr<ClientManager>              manager_;
+  std::atomic<bool>            shutting_down_{false};
+  std::weak_ptr<Socket>        socket_;
+  std::weak_ptr<ClientManager> manager_;
 
   std::string address_;
 
@@ -27,11 +27,15 @@
 #include "network/management/abstract_connection.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/tcp/local_socket.hpp"
+#include "network/uri.hpp"
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace network {
@@ -42,9 +46,10 @@ public:
   using NetworkManagerType = NetworkManager;
   using SelfType           = std::weak_ptr<AbstractConnection>;
   using SharedSelfType     = std::shared_ptr<AbstractConnection>;
-  using SocketType         = asio::ip::tcp::tcp::socket;
+  using SocketType         = StreamSocketType;
   using StrandType         = asio::io_service::strand;
   using ResolverType       = asio::ip::tcp::resolver;
+  using EndpointsType      = std::vector<StreamEndpointType>;
   using MutexType          = std::mutex;
 
   static const uint64_t        NETWORK_MAGIC = 0xFE7C80A1FE7C80A1;
@@ -59,6 +64,10 @@ public:
 
   void Connect(byte_array::ConstByteArray const &host, byte_array::ConstByteArray const &port);
 
+  void ConnectLocal(uint16_t port);
+
+  void Connect(Uri const &uri);
+
   bool is_alive() const override;
 
   void Send(MessageBuffer const &omsg, Callback const &success = nullptr,
@@ -76,6 +85,8 @@ public:
   static void SetHeader(byte_array::ByteArray &header, uint64_t bufSize);
 
 private:
+  using ResolveFunction = std::function<EndpointsType()>;
+
   NetworkManagerType networkManager_;
   // IO objects should be guaranteed to have lifetime less than the
   // io_service/networkManager
@@ -93,6 +104,8 @@ private:
   mutable MutexType callback_mutex_;
   std::atomic<bool> connected_{false};
 
+  void Connect(uint16_t port, ResolveFunction resolve);
+
   void ReadHeader() noexcept;
   void ReadBody(byte_array::ByteArray const &header) noexcept;
 
@@ -0,0 +1,48 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/fetch_asio.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace fetch {
+namespace network {
+
+/**
+ * The socket type used for stream connections. A generic socket can carry either a TCP connection
+ * or a connection over a Unix domain socket, so that the same connection classes can serve both.
+ */
+using StreamSocketType   = asio::generic::stream_protocol::socket;
+using StreamEndpointType = asio::generic::stream_protocol::endpoint;
+using LocalEndpointType  = asio::local::stream_protocol::endpoint;
+using LocalAcceptorType  = asio::local::stream_protocol::acceptor;
+
+/**
+ * The address reported for connections made over a local (Unix domain) socket
+ */
+static constexpr char const *LOCAL_SOCKET_ADDRESS = "127.0.0.1";
+
+void        SetLocalSocketDirectory(std::string directory);
+std::string GetLocalSocketDirectory();
+std::string LocalSocketPath(uint16_t port);
+std::string GetRemoteAddress(StreamSocketType const &socket);
+
+}  // namespace network
+}  // namespace fetch
@@ -67,6 +67,11 @@ public:
     pointer_->Connect(host, port);
   }
 
+  void Connect(Uri const &uri)
+  {
+    pointer_->Connect(uri);
+  }
+
   // For safety, this MUST be called by the base class in its destructor
   // As closures to that class exist in the client implementation
   void Cleanup() noexcept
@@ -23,6 +23,7 @@
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
 #include "network/tcp/abstract_server.hpp"
+#include "network/tcp/local_socket.hpp"
 
 #include <cstdint>
 #include <deque>
@@ -41,6 +42,10 @@ class ClientManager;
  * them to the client manager. This can then be used for communication with
  * the rest of Fetch
  *
+ * When enabled with SetLocalSocketDirectory, the server additionally listens on a Unix domain
+ * socket (see LocalSocketPath) so that peers on the same host can connect with a local:// URI
+ * without going through the TCP stack
+ *
  */
 class TCPServer : public AbstractNetworkServer
 {
@@ -48,6 +53,7 @@ public:
   using ConnectionHandleType = typename AbstractConnection::ConnectionHandleType;
   using NetworkManagerType   = NetworkManager;
   using AcceptorType         = asio::ip::tcp::tcp::acceptor;
+  using LocalAcceptorType    = network::LocalAcceptorType;
   using MutexType            = std::mutex;
 
   static constexpr char const *LOGGING_NAME = "TCPServer";
@@ -97,7 +103,10 @@ public:
 private:
   using InFlightCounter = AtomicInFlightCounter<network::AtomicCounterName::TCP_PORT_STARTUP>;
 
-  void Accept(std::shared_ptr<asio::ip::tcp::tcp::acceptor> const &acceptor);
+  template <typename Acceptor>
+  void Accept(std::shared_ptr<Acceptor> const &acceptor);
+
+  void OpenLocalAcceptor();
 
   NetworkManagerType                        network_manager_;
   std::atomic<uint16_t>                     port_{0};
@@ -106,6 +115,8 @@ private:
   std::weak_ptr<AbstractConnectionRegister> connection_register_;
   std::shared_ptr<ClientManager>            manager_;
   std::weak_ptr<AcceptorType>               acceptor_;
+  std::weak_ptr<LocalAcceptorType>          local_acceptor_;
+  std::string                               local_path_;
   std::mutex                                start_mutex_;
 
   // Use this class to keep track of whether we are ready to accept connections
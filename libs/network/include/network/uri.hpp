@@ -39,7 +39,8 @@ public:
   {
     Unknown = 0,
     Tcp,
-    Muddle
+    Muddle,
+    Local
   };
 
   static constexpr char const *LOGGING_NAME = "Uri";
@@ -69,13 +70,15 @@ public:
   /// @{
   bool IsTcpPeer() const;
   bool IsMuddleAddress() const;
+  bool IsLocalPeer() const;
   bool IsValid() const
   {
-    return IsTcpPeer() || IsMuddleAddress();
+    return IsTcpPeer() || IsMuddleAddress() || IsLocalPeer();
   }
 
   Peer const &          GetTcpPeer() const;
   ConstByteArray const &GetMuddleAddress() const;
+  uint16_t              GetLocalPort() const;
   /// @}
 
   // Operators
@@ -98,6 +101,7 @@ private:
   Scheme         scheme_{Scheme::Unknown};
   ConstByteArray authority_;
   Peer           tcp_;
+  uint16_t       local_port_{0};
 };
 
 inline Uri::ConstByteArray const &Uri::uri() const
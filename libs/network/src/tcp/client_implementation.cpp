@@ -40,12 +40,85 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host, ui
 
 void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
                                       byte_array::ConstByteArray const &port)
+{
+  Connect(uint16_t(port.AsInt()), [this, host, port]() -> EndpointsType {
+    std::shared_ptr<ResolverType> res = networkManager_.CreateIO<ResolverType>();
+    if (!res)
+    {
+      return {};
+    }
+
+    std::error_code        resolve_ec{};
+    ResolverType::iterator it(res->resolve({std::string(host), std::string(port)}, resolve_ec));
+
+    if (resolve_ec)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Resolution failure: ", resolve_ec.message());
+      return {};
+    }
+
+    EndpointsType endpoints{};
+    for (; it != ResolverType::iterator{}; ++it)
+    {
+      endpoints.emplace_back(it->endpoint());
+    }
+
+    return endpoints;
+  });
+}
+
+/**
+ * Connect to a server on the same host through its Unix domain socket, bypassing the TCP stack
+ *
+ * @param port The TCP port of the server
+ */
+void TCPClientImplementation::ConnectLocal(uint16_t port)
+{
+  Connect(port, [port]() -> EndpointsType {
+    std::string const path = LocalSocketPath(port);
+    if (path.empty())
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to connect to local://", port,
+                     ", local sockets are not enabled");
+      return {};
+    }
+
+    return {LocalEndpointType{path}};
+  });
+}
+
+/**
+ * Connect to the peer described by the URI, using the transport selected by its scheme
+ *
+ * @param uri The URI of the peer
+ */
+void TCPClientImplementation::Connect(Uri const &uri)
+{
+  switch (uri.scheme())
+  {
+  case Uri::Scheme::Tcp:
+  {
+    auto const &peer = uri.GetTcpPeer();
+    Connect(peer.address(), peer.port());
+    break;
+  }
+  case Uri::Scheme::Local:
+    ConnectLocal(uri.GetLocalPort());
+    break;
+  default:
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to connect to unsupported URI: ", uri.ToString());
+    SignalLeave();
+    break;
+  }
+}
+
+void TCPClientImplementation::Connect(uint16_t port, ResolveFunction resolve)
 {
   SelfType self = shared_from_this();
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Client posting connect");
 
-  networkManager_.Post([this, self, host, port] {
+  networkManager_.Post([this, self, port, resolve] {
     SharedSelfType selfLock = self.lock();
     if (!selfLock)
     {
@@ -64,7 +137,7 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
       strand_ = strand;
     }
 
-    strand->post([this, self, host, port, strand] {
+    strand->post([this, self, port, resolve, strand] {
       SharedSelfType selfLock = self.lock();
       if (!selfLock)
       {
@@ -81,10 +154,11 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
         }
       }
 
-      std::shared_ptr<ResolverType> res = networkManager_.CreateIO<ResolverType>();
+      // the endpoints must outlive the asynchronous connect
+      auto endpoints = std::make_shared<EndpointsType>(resolve());
 
-      auto cb = [this, self, res, socket, strand, port](std::error_code ec,
-                                                        ResolverType::iterator) {
+      auto cb = [this, self, endpoints, socket, strand, port](std::error_code ec,
+                                                              EndpointsType::iterator) {
         SharedSelfType selfLock = self.lock();
         if (!selfLock)
         {
@@ -96,20 +170,17 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
         {
           FETCH_LOG_DEBUG(LOGGING_NAME, "Connection established!");
 
-          // Prevent this from throwing
-          std::error_code         ec2;
-          asio::ip::tcp::endpoint endpoint = (*socket).remote_endpoint(ec2);
+          std::string const address = GetRemoteAddress(*socket);
 
-          if (!ec2)
+          if (!address.empty())
           {
-            this->SetAddress(endpoint.address().to_string());
-            this->SetPort(uint16_t(port.AsInt()));
+            this->SetAddress(address);
+            this->SetPort(port);
             ReadHeader();
           }
           else
           {
-            FETCH_LOG_ERROR(LOGGING_NAME,
-                            "Failed to get endpoint of socket after connection: ", ec2.message());
+            FETCH_LOG_ERROR(LOGGING_NAME, "Failed to get endpoint of socket after connection");
           }
         }
         else
@@ -120,28 +191,21 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
         }
       };
 
-      if (socket && res)
+      if (!socket)
       {
-        std::error_code resolve_ec{};
-
-        ResolverType::iterator it(res->resolve({std::string(host), std::string(port)}, resolve_ec));
-
-        if (!resolve_ec)
-        {
-          assert(strand->running_in_this_thread());
-          asio::async_connect(*socket, it, strand->wrap(cb));
-        }
-        else
-        {
-          FETCH_LOG_ERROR(LOGGING_NAME, "Resolution failure: ", resolve_ec.message());
-          SignalLeave();
-        }
+        FETCH_LOG_ERROR(LOGGING_NAME, "Failed to create valid socket");
+        SignalLeave();
       }
-      else
+      else if (endpoints->empty())
       {
-        FETCH_LOG_ERROR(LOGGING_NAME, "Failed to create valid socket");
+        FETCH_LOG_WARN(LOGGING_NAME, "No endpoints to connect to on port ", port);
         SignalLeave();
       }
+      else
+      {
+        assert(strand->running_in_this_thread());
+        asio::async_connect(*socket, endpoints->begin(), endpoints->end(), strand->wrap(cb));
+      }
     });  // end strand post
   });    // end NM post
 }
@@ -205,7 +269,7 @@ void TCPClientImplementation::Close()
     {
       strand->post([socket] {
         std::error_code dummy;
-        socket->shutdown(asio::ip::tcp::socket::shutdown_both, dummy);
+        socket->shutdown(asio::socket_base::shutdown_both, dummy);
         socket->close(dummy);
       });
     }
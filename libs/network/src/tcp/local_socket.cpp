@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/local_socket.hpp"
+
+#include "core/mutex.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace fetch {
+namespace network {
+namespace {
+
+std::mutex  local_socket_lock;
+std::string local_socket_directory;
+
+}  // namespace
+
+/**
+ * Set the directory in which TCP servers create their Unix domain sockets and in which clients
+ * look for the sockets of local:// peers. Local sockets are disabled while no directory is set,
+ * which is the default.
+ *
+ * @param directory The directory for the sockets, or an empty string to disable local sockets
+ */
+void SetLocalSocketDirectory(std::string directory)
+{
+  FETCH_LOCK(local_socket_lock);
+  local_socket_directory = std::move(directory);
+}
+
+/**
+ * @return The directory for Unix domain sockets, empty if local sockets are disabled
+ */
+std::string GetLocalSocketDirectory()
+{
+  FETCH_LOCK(local_socket_lock);
+  return local_socket_directory;
+}
+
+/**
+ * Determine the path of the Unix domain socket on which a server listening on the specified TCP
+ * port also accepts connections from peers on the same host
+ *
+ * @param port The TCP port of the server
+ * @return The path of the socket, or an empty string if local sockets are disabled
+ */
+std::string LocalSocketPath(uint16_t port)
+{
+  std::string directory = GetLocalSocketDirectory();
+  if (directory.empty())
+  {
+    return {};
+  }
+
+  if (directory.back() != '/')
+  {
+    directory.push_back('/');
+  }
+
+  return directory + "fetch-network-" + std::to_string(port) + ".sock";
+}
+
+/**
+ * Determine the address of the remote end of a connected socket
+ *
+ * @param socket The connected socket
+ * @return The IP address of the remote end, LOCAL_SOCKET_ADDRESS for local sockets or an empty
+ * string if the address could not be determined
+ */
+std::string GetRemoteAddress(StreamSocketType const &socket)
+{
+  // Prevent this from throwing
+  std::error_code          ec;
+  StreamEndpointType const endpoint = socket.remote_endpoint(ec);
+
+  if (ec)
+  {
+    return {};
+  }
+
+  switch (endpoint.protocol().family())
+  {
+  case AF_INET:
+  case AF_INET6:
+  {
+    asio::ip::tcp::endpoint ip_endpoint{};
+    if (endpoint.size() > ip_endpoint.capacity())
+    {
+      return {};
+    }
+
+    std::memcpy(ip_endpoint.data(), endpoint.data(), endpoint.size());
+    ip_endpoint.resize(endpoint.size());
+
+    return ip_endpoint.address().to_string();
+  }
+  case AF_UNIX:
+    return LOCAL_SOCKET_ADDRESS;
+  default:
+    return {};
+  }
+}
+
+}  // namespace network
+}  // namespace fetch
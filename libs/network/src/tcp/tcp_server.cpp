@@ -20,6 +20,7 @@
 #include "network/tcp/tcp_server.hpp"
 
 #include <chrono>
+#include <cstdio>
 #include <exception>
 #include <memory>
 #include <new>
@@ -61,11 +62,27 @@ TCPServer::~TCPServer()
     }
   });
 
-  // Need to block until the acceptor has expired as it refers back to this class.
-  while (!acceptor_.expired())
+  std::weak_ptr<LocalAcceptorType> local_acceptor_weak = local_acceptor_;
+
+  network_manager_.Post([local_acceptor_weak] {
+    auto local_acceptor = local_acceptor_weak.lock();
+    if (local_acceptor)
+    {
+      std::error_code ec;
+      local_acceptor->close(ec);
+    }
+  });
+
+  // Need to block until the acceptors have expired as they refer back to this class.
+  while (!acceptor_.expired() || !local_acceptor_.expired())
   {
     std::this_thread::sleep_for(std::chrono::milliseconds(5));
   }
+
+  if (!local_path_.empty())
+  {
+    std::remove(local_path_.c_str());
+  }
 }
 
 void TCPServer::Start()
@@ -94,6 +111,8 @@ void TCPServer::Start()
           Accept(acceptor);
 
           FETCH_LOG_DEBUG(LOGGING_NAME, "Accepting TCP server connections");
+
+          OpenLocalAcceptor();
         }
       }
       catch (std::exception const &e)
@@ -181,9 +200,46 @@ std::string TCPServer::GetAddress(ConnectionHandleType const &client)
   return manager_->GetAddress(client);
 }
 
-void TCPServer::Accept(std::shared_ptr<asio::ip::tcp::tcp::acceptor> const &acceptor)
+/**
+ * Open the Unix domain socket on which peers on the same host can connect to this server, if local
+ * sockets have been enabled with SetLocalSocketDirectory. Failure is not fatal since those peers
+ * can always fall back to connecting over TCP.
+ */
+void TCPServer::OpenLocalAcceptor()
+{
+  std::string const path = LocalSocketPath(port_);
+  if (path.empty())
+  {
+    return;
+  }
+
+  // remove any stale socket file left behind by a server which did not shut down cleanly
+  std::remove(path.c_str());
+
+  try
+  {
+    auto acceptor = network_manager_.CreateIO<LocalAcceptorType>(LocalEndpointType{path});
+
+    if (acceptor)
+    {
+      local_acceptor_ = acceptor;
+      local_path_     = path;
+
+      Accept(acceptor);
+
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Accepting local server connections on ", path);
+    }
+  }
+  catch (std::exception const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to open local socket: ", path, " with error: ", e.what());
+  }
+}
+
+template <typename Acceptor>
+void TCPServer::Accept(std::shared_ptr<Acceptor> const &acceptor)
 {
-  auto strongSocket                = network_manager_.CreateIO<asio::ip::tcp::tcp::socket>();
+  auto strongSocket                = network_manager_.CreateIO<StreamSocketType>();
   std::weak_ptr<ClientManager> man = manager_;
 
   auto cb = [this, man, acceptor, strongSocket](std::error_code ec) {
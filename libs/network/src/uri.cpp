@@ -31,6 +31,7 @@ static const std::regex IDENTITY_FORMAT("^[a-zA-Z0-9/+]{86}==$");
 
 static const std::regex PEER_FORMAT(R"(^[0-9]+\.[0-9]+\.[0-9]+\.[0-9]+:[0-9]+$)");
 static const std::regex TCP_FORMAT("^tcp://([^:]+):([0-9]+)$");
+static const std::regex LOCAL_FORMAT("^[0-9]{1,5}$");
 
 Uri::Uri(Peer const &peer)
   : uri_(peer.ToUri())
@@ -85,6 +86,18 @@ bool Uri::Parse(std::string const &uri)
       scheme_    = Scheme::Muddle;
       authority_ = authority;
     }
+    else if (scheme == "local")
+    {
+      // local peers are identified by the port of the server on this host
+      success    = std::regex_match(authority, LOCAL_FORMAT) && (std::stoul(authority) <= 0xFFFFu);
+      scheme_    = Scheme::Local;
+      authority_ = authority;
+
+      if (success)
+      {
+        local_port_ = static_cast<uint16_t>(std::stoul(authority));
+      }
+    }
   }
 
   // only update the URI if value
@@ -106,6 +119,11 @@ bool Uri::IsMuddleAddress() const
   return scheme_ == Scheme::Muddle;
 }
 
+bool Uri::IsLocalPeer() const
+{
+  return scheme_ == Scheme::Local;
+}
+
 Peer const &Uri::GetTcpPeer() const
 {
   assert(scheme_ == Scheme::Tcp);
@@ -118,6 +136,12 @@ byte_array::ConstByteArray const &Uri::GetMuddleAddress() const
   return authority_;
 }
 
+uint16_t Uri::GetLocalPort() const
+{
+  assert(scheme_ == Scheme::Local);
+  return local_port_;
+}
+
 std::string Uri::ToString() const
 {
   switch (scheme_)
@@ -126,6 +150,8 @@ std::string Uri::ToString() const
     return std::string("tcp://") + tcp_.ToString();
   case Scheme::Muddle:
     return std::string("muddle://") + std::string(authority_);
+  case Scheme::Local:
+    return std::string("local://") + std::to_string(local_port_);
   case Scheme::Unknown:
   default:
     return "unknown:";
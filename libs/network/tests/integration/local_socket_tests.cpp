@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/tcp/local_socket.hpp"
+#include "network/tcp/tcp_client.hpp"
+#include "network/tcp/tcp_server.hpp"
+#include "network/uri.hpp"
+
+#include "gtest/gtest.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace fetch::network;
+using namespace std::chrono_literals;
+
+constexpr std::size_t CONNECT_TIMEOUT_MS = 5000;
+
+class Server : public TCPServer
+{
+public:
+  Server(uint16_t port, NetworkManager const &network_manager)
+    : TCPServer(port, network_manager)
+  {}
+
+  ~Server() override = default;
+
+  void PushRequest(ConnectionHandleType /*client*/, MessageBuffer const &msg) override
+  {
+    FETCH_LOCK(lock_);
+    messages_.push_back(msg);
+  }
+
+  std::vector<MessageBuffer> messages()
+  {
+    FETCH_LOCK(lock_);
+    return messages_;
+  }
+
+private:
+  std::mutex                 lock_;
+  std::vector<MessageBuffer> messages_;
+};
+
+class Client : public TCPClient
+{
+public:
+  explicit Client(NetworkManager const &network_manager)
+    : TCPClient(network_manager)
+  {}
+
+  ~Client()
+  {
+    TCPClient::Cleanup();
+  }
+};
+
+bool IsSocket(std::string const &path)
+{
+  struct stat info
+  {
+  };
+
+  return (::stat(path.c_str(), &info) == 0) && S_ISSOCK(info.st_mode);
+}
+
+Uri LocalUri(uint16_t port)
+{
+  return Uri{"local://" + std::to_string(port)};
+}
+
+class LocalSocketTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char directory[] = "/tmp/fetch-local-socket-tests-XXXXXX";
+    ASSERT_NE(::mkdtemp(directory), nullptr);
+
+    directory_ = directory;
+    network_manager_.Start();
+  }
+
+  void TearDown() override
+  {
+    network_manager_.Stop();
+    SetLocalSocketDirectory({});
+
+    ::rmdir(directory_.c_str());
+  }
+
+  std::string    directory_;
+  NetworkManager network_manager_{"LocalSocketTests", 1};
+};
+
+TEST_F(LocalSocketTests, ServersOnlyListenWhenEnabled)
+{
+  Server server{0, network_manager_};
+  server.Start();
+
+  auto const port = server.GetListeningPort();
+  EXPECT_TRUE(LocalSocketPath(port).empty());
+
+  // enabling local sockets after the server has started does not open its listener
+  SetLocalSocketDirectory(directory_);
+  EXPECT_FALSE(IsSocket(LocalSocketPath(port)));
+
+  Client client{network_manager_};
+  client.Connect(LocalUri(port));
+  EXPECT_FALSE(client.WaitForAlive(200));
+}
+
+TEST_F(LocalSocketTests, ClientsConnectOverTheLocalSocket)
+{
+  SetLocalSocketDirectory(directory_);
+
+  std::string path;
+  {
+    Server server{0, network_manager_};
+    server.Start();
+
+    auto const port = server.GetListeningPort();
+    path            = LocalSocketPath(port);
+
+    EXPECT_EQ(path.find(directory_), 0u);
+    ASSERT_TRUE(IsSocket(path));
+
+    Client client{network_manager_};
+    client.Connect(LocalUri(port));
+    ASSERT_TRUE(client.WaitForAlive(CONNECT_TIMEOUT_MS));
+
+    EXPECT_EQ(client.Address(), LOCAL_SOCKET_ADDRESS);
+
+    client.Send("hello over a local socket");
+
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+    while (server.messages().empty() && (std::chrono::steady_clock::now() < deadline))
+    {
+      std::this_thread::sleep_for(1ms);
+    }
+
+    auto const messages = server.messages();
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_EQ(messages.front(), "hello over a local socket");
+  }
+
+  // the socket is removed when the server shuts down
+  EXPECT_FALSE(IsSocket(path));
+}
+
+TEST_F(LocalSocketTests, ClientsOnlyUseTheConfiguredDirectory)
+{
+  SetLocalSocketDirectory(directory_);
+
+  Server server{0, network_manager_};
+  server.Start();
+
+  auto const port = server.GetListeningPort();
+  ASSERT_TRUE(IsSocket(LocalSocketPath(port)));
+
+  // a client looking in a different directory does not find the socket of the server
+  char other[] = "/tmp/fetch-local-socket-tests-XXXXXX";
+  ASSERT_NE(::mkdtemp(other), nullptr);
+  SetLocalSocketDirectory(other);
+
+  Client client{network_manager_};
+  client.Connect(LocalUri(port));
+  EXPECT_FALSE(client.WaitForAlive(200));
+
+  ::rmdir(other);
+}
+
+}  // namespace
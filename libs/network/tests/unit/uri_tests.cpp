@@ -42,6 +42,9 @@ std::ostream &operator<<(std::ostream &s, Uri::Scheme scheme)
   case Uri::Scheme::Muddle:
     s << "Muddle";
     break;
+  case Uri::Scheme::Local:
+    s << "Local";
+    break;
   default:
     s << "Unknown";
     break;
@@ -64,7 +67,10 @@ static const TestCase TEST_CASES[] = {
      "rOA3MfBt0DdRtZRSo/gBFP2aD/YQTsd9lOh/Oc/Pzchrzz1wfhTUMpf9z8cc1kRltUpdlWznGzwroO8/rbdPXA==",
      Uri::Scheme::Muddle, true},
     {"tcp://foo:bar", "foo:bar", Uri::Scheme::Muddle, false},
-    {"muddle://badIdentityName", "badIdentityName", Uri::Scheme::Muddle, false}};
+    {"muddle://badIdentityName", "badIdentityName", Uri::Scheme::Muddle, false},
+    {"local://8000", "8000", Uri::Scheme::Local, true},
+    {"local://70000", "70000", Uri::Scheme::Local, false},
+    {"local://127.0.0.1:8000", "127.0.0.1:8000", Uri::Scheme::Local, false}};
 
 class UriTests : public ::testing::TestWithParam<TestCase>
 {
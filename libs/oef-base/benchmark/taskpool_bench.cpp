@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-base/threading/ExitState.hpp"
+#include "oef-base/threading/Task.hpp"
+#include "oef-base/threading/Taskpool.hpp"
+#include "oef-base/threading/Threadpool.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using fetch::oef::base::ExitState;
+using fetch::oef::base::Task;
+using fetch::oef::base::Taskpool;
+using fetch::oef::base::Threadpool;
+
+namespace {
+
+constexpr std::size_t NUM_TASKS = 1000000;
+
+class CountingTask : public Task
+{
+public:
+  explicit CountingTask(std::atomic<std::size_t> &counter)
+    : counter_{counter}
+  {}
+  ~CountingTask() override = default;
+
+  bool IsRunnable() const override
+  {
+    return true;
+  }
+
+  ExitState run() override
+  {
+    counter_.fetch_add(1, std::memory_order_relaxed);
+    return ExitState::COMPLETE;
+  }
+
+private:
+  std::atomic<std::size_t> &counter_;
+};
+
+void WaitFor(std::atomic<std::size_t> const &counter, std::size_t expected)
+{
+  while (counter.load(std::memory_order_relaxed) < expected)
+  {
+    std::this_thread::yield();
+  }
+}
+
+void Taskpool_SubmitSmallTasks(benchmark::State &state)
+{
+  auto const num_workers = static_cast<std::size_t>(state.range(0));
+
+  auto       pool = std::make_shared<Taskpool>();
+  Threadpool workers;
+  workers.start(num_workers, std::function<void(std::size_t)>{std::bind(
+                                 &Taskpool::run, pool.get(), std::placeholders::_1)});
+
+  std::vector<std::shared_ptr<CountingTask>> tasks;
+  tasks.reserve(NUM_TASKS);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    std::atomic<std::size_t> counter{0};
+    tasks.clear();
+    for (std::size_t i = 0; i < NUM_TASKS; ++i)
+    {
+      tasks.emplace_back(std::make_shared<CountingTask>(counter));
+    }
+    state.ResumeTiming();
+
+    for (auto const &task : tasks)
+    {
+      pool->submit(task);
+    }
+
+    WaitFor(counter, NUM_TASKS);
+  }
+
+  pool->stop();
+  workers.stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_TASKS));
+}
+
+// Tasks submitting further tasks from within the pool, which exercises the worker local queues
+void Taskpool_FanOutFromWorkers(benchmark::State &state)
+{
+  static constexpr std::size_t NUM_ROOTS = 1000;
+
+  auto const num_workers = static_cast<std::size_t>(state.range(0));
+
+  auto       pool = std::make_shared<Taskpool>();
+  Threadpool workers;
+  workers.start(num_workers, std::function<void(std::size_t)>{std::bind(
+                                 &Taskpool::run, pool.get(), std::placeholders::_1)});
+
+  class FanOutTask : public Task
+  {
+  public:
+    FanOutTask(std::shared_ptr<Taskpool> pool, std::atomic<std::size_t> &counter)
+      : pool_{std::move(pool)}
+      , counter_{counter}
+    {}
+    ~FanOutTask() override = default;
+
+    bool IsRunnable() const override
+    {
+      return true;
+    }
+
+    ExitState run() override
+    {
+      for (std::size_t i = 0; i < (NUM_TASKS / NUM_ROOTS); ++i)
+      {
+        pool_->submit(std::make_shared<CountingTask>(counter_));
+      }
+      return ExitState::COMPLETE;
+    }
+
+  private:
+    std::shared_ptr<Taskpool> pool_;
+    std::atomic<std::size_t> &counter_;
+  };
+
+  for (auto _ : state)
+  {
+    std::atomic<std::size_t> counter{0};
+    for (std::size_t i = 0; i < NUM_ROOTS; ++i)
+    {
+      pool->submit(std::make_shared<FanOutTask>(pool, counter));
+    }
+
+    WaitFor(counter, NUM_TASKS);
+  }
+
+  pool->stop();
+  workers.stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_TASKS));
+}
+
+void Taskpool_DelayedTasks(benchmark::State &state)
+{
+  static constexpr std::size_t NUM_DELAYED = 10000;
+
+  auto const num_workers = static_cast<std::size_t>(state.range(0));
+
+  auto       pool = std::make_shared<Taskpool>();
+  Threadpool workers;
+  workers.start(num_workers, std::function<void(std::size_t)>{std::bind(
+                                 &Taskpool::run, pool.get(), std::placeholders::_1)});
+
+  for (auto _ : state)
+  {
+    std::atomic<std::size_t> counter{0};
+    for (std::size_t i = 0; i < NUM_DELAYED; ++i)
+    {
+      pool->after(std::make_shared<CountingTask>(counter), std::chrono::milliseconds{i % 10});
+    }
+
+    WaitFor(counter, NUM_DELAYED);
+  }
+
+  pool->stop();
+  workers.stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_DELAYED));
+}
+
+}  // namespace
+
+BENCHMARK(Taskpool_SubmitSmallTasks)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK(Taskpool_FanOutFromWorkers)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK(Taskpool_DelayedTasks)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
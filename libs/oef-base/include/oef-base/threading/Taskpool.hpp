@@ -17,15 +17,19 @@
 //
 //------------------------------------------------------------------------------
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <list>
 #include <map>
 #include <mutex>
-#include <queue>
 #include <set>
 #include <vector>
 
+#include "core/containers/timer_wheel.hpp"
 #include "oef-base/threading/ExitState.hpp"
 #include "oef-base/threading/Task.hpp"
 
@@ -33,11 +37,25 @@ namespace fetch {
 namespace oef {
 namespace base {
 
+/**
+ * Work stealing task pool.
+ *
+ * Each worker thread (i.e. each caller of run()) owns a deque of runnable tasks. Workers take
+ * tasks from the front of their own deque and, when it is empty, steal from the back of the
+ * deques of the other workers. Tasks submitted from a worker go to that worker's deque, tasks
+ * submitted from any other thread are spread round robin over the workers.
+ *
+ * Idle workers sleep on their own condition variable and are tracked in an atomic bit mask so
+ * that waking a worker never requires a pool wide lock. Delayed tasks are kept in a hierarchical
+ * timer wheel which idle workers advance.
+ */
 class Taskpool : public std::enable_shared_from_this<Taskpool>
 {
 public:
   static constexpr char const *LOGGING_NAME = "Taskpool";
 
+  static constexpr std::size_t MAX_WORKERS = 64;
+
   using Mutex = std::mutex;
   using Lock  = std::unique_lock<Mutex>;
 
@@ -86,33 +104,47 @@ public:
 
 protected:
 private:
-  Timestamp lockless_getNextWakeTime(const Timestamp &current_time, const Milliseconds &deflt);
-  TaskP     lockless_getNextFutureWork(const Timestamp &current_time);
-
-  mutable Mutex           mutex_;
-  std::atomic<bool>       quit_;
-  std::condition_variable work_available_;
-  Tasks                   pending_tasks_;
-  RunningTasks            running_tasks_;
-  SuspendedTasks          suspended_tasks_;
-
-  struct FutureTask
-  {
-    TaskP     task;
-    Timestamp due;
-  };
+  using SteadyClock = std::chrono::steady_clock;
+  using Timers      = core::TimerWheel<TaskP>;
+  using Tick        = Timers::Tick;
 
-  struct FutureTaskOrdering
+  struct Worker
   {
-    bool operator()(const FutureTask &a, const FutureTask &b)
-    {
-      return (a.due > b.due);
-    }
+    mutable Mutex           mutex;
+    std::deque<TaskP>       tasks;
+    TaskP                   running;
+    Mutex                   sleep_mutex;
+    std::condition_variable wake;
+    bool                    notified{false};
   };
 
-  using FutureTasks = std::priority_queue<FutureTask, std::vector<FutureTask>, FutureTaskOrdering>;
-
-  FutureTasks future_tasks_;
+  using Workers = std::array<Worker, MAX_WORKERS>;
+
+  void  Push(TaskP const &task, bool front);
+  TaskP Pop(std::size_t worker_idx);
+  TaskP Steal(std::size_t worker_idx);
+  TaskP PollTimers(std::size_t worker_idx);
+  void  Sleep(std::size_t worker_idx);
+  void  WakeOne();
+  void  WakeAll();
+  void  Execute(TaskP task, std::size_t worker_idx);
+  bool  IsPending(TaskP const &task) const;
+  Tick  CurrentTick() const;
+
+  std::atomic<bool>        quit_;
+  Workers                  workers_;
+  std::atomic<std::size_t> worker_count_{0};   ///< One more than the highest worker index seen
+  std::atomic<std::size_t> next_worker_{0};    ///< Round robin target for external submissions
+  std::atomic<std::size_t> pending_count_{0};  ///< Number of tasks across all worker deques
+  std::atomic<uint64_t>    idle_workers_{0};   ///< Bit mask of sleeping workers
+
+  mutable Mutex  suspended_mutex_;
+  SuspendedTasks suspended_tasks_;
+
+  mutable Mutex           timers_mutex_;
+  SteadyClock::time_point epoch_;
+  Timers                  future_tasks_;
+  std::atomic<Tick>       next_timer_due_{Timers::NEVER};
 };
 }  // namespace base
 }  // namespace oef
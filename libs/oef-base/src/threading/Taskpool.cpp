@@ -23,6 +23,7 @@
 #include "oef-base/threading/Taskpool.hpp"
 
 #include <algorithm>
+#include <utility>
 
 namespace fetch {
 namespace oef {
@@ -35,17 +36,38 @@ static Gauge gauge_running("mt-core.taskpool.gauge.running_tasks");
 static Gauge gauge_suspended("mt-core.taskpool.gauge.sleeping_tasks");
 static Gauge gauge_future("mt-core.taskpool.gauge.future_tasks");
 
+// Counters are resolved once up front since resolving a counter by name takes a lock
+static Counter counter_popped("mt-core.tasks.popped-for-run");
+static Counter counter_popped_immediate("mt-core.immediate-tasks.popped-for-run");
+static Counter counter_popped_future("mt-core.future-tasks.popped-for-run");
+static Counter counter_stolen("mt-core.tasks.stolen");
+static Counter counter_std_exception("mt-core.tasks.run.std::exception");
+static Counter counter_exception("mt-core.tasks.run.exception");
+static Counter counter_deferred("mt-core.tasks.run.deferred");
+static Counter counter_deferred_rerun("mt-core.tasks.run.deferred.rerun");
+static Counter counter_errored("mt-core.tasks.run.errored");
+static Counter counter_cancelled("mt-core.tasks.run.cancelled");
+static Counter counter_completed("mt-core.tasks.run.completed");
+static Counter counter_rerun("mt-core.tasks.run.rerun");
+static Counter counter_removed_runnable("mt-core.tasks.removed.runnable");
+static Counter counter_removed_sleeping("mt-core.tasks.removed.sleeping");
+static Counter counter_removed_notfound("mt-core.tasks.removed.notfound");
+static Counter counter_made_runnable("mt-core.tasks.made-runnable");
+static Counter counter_made_runnable_failed("mt-core.tasks.made-runnable.failed");
+static Counter counter_suspended("mt-core.tasks.suspended");
+static Counter counter_moved_to_runnable("mt-core.tasks.moved-to-runnable");
+static Counter counter_futured("mt-core.tasks.futured");
+
+// The pool and worker index of the calling thread, if it is a worker
+static thread_local Taskpool const *current_pool   = nullptr;
+static thread_local std::size_t     current_worker = 0;
+
+static constexpr Taskpool::Milliseconds MAX_IDLE_SLEEP{100};
+
 Taskpool::Taskpool()
   : quit_(false)
-{
-  Counter("mt-core.tasks.popped-for-run");
-  Counter("mt-core.tasks.run.std::exception");
-  Counter("mt-core.tasks.run.exception");
-  Counter("mt-core.tasks.run.deferred");
-  Counter("mt-core.tasks.run.errored");
-  Counter("mt-core.tasks.run.cancelled");
-  Counter("mt-core.tasks.run.completed");
-}
+  , epoch_{SteadyClock::now()}
+{}
 
 void Taskpool::SetDefault()
 {
@@ -59,154 +81,153 @@ std::weak_ptr<Taskpool> Taskpool::GetDefaultTaskpool()
 
 void Taskpool::run(std::size_t thread_idx)
 {
-  while (true)
+  if (thread_idx >= MAX_WORKERS)
   {
-    if (quit_)
-    {
-      return;
-    }
-
-    Timestamp now = Clock::now();
-    {
-      Lock lock(mutex_);
-      if (pending_tasks_.empty())
-      {
-        work_available_.wait_until(lock, lockless_getNextWakeTime(now, Milliseconds(100)));
-      }
-    }
+    FETCH_LOG_ERROR(LOGGING_NAME, "Worker index ", thread_idx, " exceeds the maximum of ",
+                    MAX_WORKERS, " workers");
+    return;
+  }
 
-    if (quit_)
-    {
-      return;
-    }
+  current_pool   = this;
+  current_worker = thread_idx;
 
-    TaskP mytask;
+  // Make this worker visible to submitters and thieves
+  std::size_t count = worker_count_.load();
+  while ((count < thread_idx + 1) && !worker_count_.compare_exchange_weak(count, thread_idx + 1))
+  {
+  }
 
-    now = Clock::now();
+  while (!quit_)
+  {
+    // Timers are checked first so that a busy worker can not starve delayed tasks
+    TaskP mytask = PollTimers(thread_idx);
 
+    if (!mytask)
     {
-      Lock lock(mutex_);
-      mytask = lockless_getNextFutureWork(now);
+      mytask = Pop(thread_idx);
     }
 
     if (!mytask)
     {
-      Lock lock(mutex_);
-      if (!pending_tasks_.empty())
-      {
-        mytask        = pending_tasks_.front();
-        mytask->pool_ = nullptr;
-        pending_tasks_.pop_front();
-        Counter("mt-core.tasks.popped-for-run")++;
-        Counter("mt-core.immediate-tasks.popped-for-run")++;
-      }
+      mytask = Steal(thread_idx);
     }
 
     if (!mytask)
     {
+      Sleep(thread_idx);
       continue;
     }
 
-    ExitState status;
+    Execute(std::move(mytask), thread_idx);
+  }
 
-    {
-      Lock lock(mutex_);
-      mytask->SetTaskState(Task::TaskState::NOT_PENDING);
-      running_tasks_[thread_idx] = mytask;
-    }
+  current_pool = nullptr;
+}
 
-    try
-    {
-      if (mytask->IsCancelled())
-      {
-        status = CANCELLED;
-      }
-      else
-      {
-        status = mytask->RunThunk();
-      }
-    }
-    catch (std::exception const &ex)
-    {
-      Counter("mt-core.tasks.run.std::exception")++;
-      FETCH_LOG_INFO(LOGGING_NAME, "Threadpool caught:", ex.what());
-      status = ERRORED;
-    }
-    catch (...)
-    {
-      Counter("mt-core.tasks.run.exception")++;
-      FETCH_LOG_INFO(LOGGING_NAME, "Threadpool caught: other exception");
-      status = ERRORED;
-    }
+void Taskpool::Execute(TaskP mytask, std::size_t worker_idx)
+{
+  auto &worker = workers_[worker_idx];
 
-    {
-      Lock lock(mutex_);
-      running_tasks_.erase(thread_idx);
-    }
+  ExitState status;
 
-    switch (status)
-    {
-    case DEFER:
-    {
-      if (mytask->GetMadeRunnableCountAndClear() == 0)
-      {
-        Counter("mt-core.tasks.run.deferred")++;
-        suspend(mytask);
-      }
-      else
-      {
-        Counter("mt-core.tasks.run.deferred.rerun")++;
-        submit(mytask);
-      }
-      break;
-    }
-    case ERRORED:
+  mytask->pool_ = nullptr;
+  mytask->SetTaskState(Task::TaskState::NOT_PENDING);
+  {
+    Lock lock(worker.mutex);
+    worker.running = mytask;
+  }
+
+  try
+  {
+    if (mytask->IsCancelled())
     {
-      Counter("mt-core.tasks.run.errored")++;
-      Lock lock(mutex_);
-      mytask->SetTaskState(Task::TaskState::DONE);
-      mytask.reset();
-      break;
+      status = CANCELLED;
     }
-    case CANCELLED:
+    else
     {
-      Counter("mt-core.tasks.run.cancelled")++;
-      Lock lock(mutex_);
-      mytask->SetTaskState(Task::TaskState::DONE);
-      mytask.reset();
-      break;
+      status = mytask->RunThunk();
     }
-    case COMPLETE:
+  }
+  catch (std::exception const &ex)
+  {
+    counter_std_exception++;
+    FETCH_LOG_INFO(LOGGING_NAME, "Threadpool caught:", ex.what());
+    status = ERRORED;
+  }
+  catch (...)
+  {
+    counter_exception++;
+    FETCH_LOG_INFO(LOGGING_NAME, "Threadpool caught: other exception");
+    status = ERRORED;
+  }
+
+  {
+    Lock lock(worker.mutex);
+    worker.running.reset();
+  }
+
+  switch (status)
+  {
+  case DEFER:
+  {
+    if (mytask->GetMadeRunnableCountAndClear() == 0)
     {
-      Counter("mt-core.tasks.run.completed")++;
-      Lock lock(mutex_);
-      mytask->SetTaskState(Task::TaskState::DONE);
-      mytask.reset();
-      break;
+      counter_deferred++;
+      suspend(mytask);
     }
-    case RERUN:
+    else
     {
-      Counter("mt-core.tasks.run.rerun")++;
+      counter_deferred_rerun++;
       submit(mytask);
-      break;
-    }
     }
+    break;
+  }
+  case ERRORED:
+  {
+    counter_errored++;
+    mytask->SetTaskState(Task::TaskState::DONE);
+    break;
+  }
+  case CANCELLED:
+  {
+    counter_cancelled++;
+    mytask->SetTaskState(Task::TaskState::DONE);
+    break;
+  }
+  case COMPLETE:
+  {
+    counter_completed++;
+    mytask->SetTaskState(Task::TaskState::DONE);
+    break;
+  }
+  case RERUN:
+  {
+    counter_rerun++;
+    submit(mytask);
+    break;
+  }
   }
 }
 
 void Taskpool::remove(TaskP task)
 {
-  Lock lock(mutex_);
   task->SetTaskState(Task::TaskState::DONE);
   bool did = false;
+
+  std::size_t const count = std::max<std::size_t>(worker_count_, 1);
+  for (std::size_t i = 0; i < count; ++i)
   {
-    auto iter = pending_tasks_.begin();
-    while (iter != pending_tasks_.end())
+    auto &worker = workers_[i];
+    Lock  lock(worker.mutex);
+
+    auto iter = worker.tasks.begin();
+    while (iter != worker.tasks.end())
     {
       if (*iter == task)
       {
-        iter = pending_tasks_.erase(iter);
-        Counter("mt-core.tasks.removed.runnable")++;
+        iter = worker.tasks.erase(iter);
+        --pending_count_;
+        counter_removed_runnable++;
         did = true;
       }
       else
@@ -215,96 +236,126 @@ void Taskpool::remove(TaskP task)
       }
     }
   }
+
   {
+    Lock lock(suspended_mutex_);
     auto iter = suspended_tasks_.find(task);
     if (iter != suspended_tasks_.end())
     {
       suspended_tasks_.erase(iter);
       did = true;
-      Counter("mt-core.tasks.removed.sleeping")++;
+      counter_removed_sleeping++;
     }
   }
+
   if (!did)
   {
-    Counter("mt-core.tasks.removed.notfound")++;
+    counter_removed_notfound++;
   }
 }
 
 bool Taskpool::MakeRunnable(TaskP task)
 {
-  Lock lock(mutex_);
-  bool status = false;
-  auto iter   = suspended_tasks_.find(task);
-  if (iter != suspended_tasks_.end())
-  {
-    Counter("mt-core.tasks.made-runnable")++;
-    auto t = *iter;
-    t->SetTaskState(Task::TaskState::PENDING);
-    suspended_tasks_.erase(iter);
-    pending_tasks_.push_front(t);
-    work_available_.notify_one();
-    status = true;
-  }
-  else
+  TaskP runnable;
   {
-    Counter("mt-core.tasks.made-runnable.failed")++;
-    bool in_pending =
-        std::find(pending_tasks_.begin(), pending_tasks_.end(), task) != pending_tasks_.end();
-    bool in_running = false;
-    for (const auto &e : running_tasks_)
+    Lock lock(suspended_mutex_);
+    auto iter = suspended_tasks_.find(task);
+    if (iter != suspended_tasks_.end())
     {
-      if (e.second->GetTaskId() == task->GetTaskId())
-      {
-        in_running = true;
-        break;
-      }
+      runnable = *iter;
+      runnable->SetTaskState(Task::TaskState::PENDING);
+      suspended_tasks_.erase(iter);
     }
-    FETCH_LOG_WARN(LOGGING_NAME, "Task ", task->GetTaskId(),
-                   " not in suspended_tasks list! in_pending=", in_pending,
-                   ", in_running=", in_running);
   }
-  return status;
+
+  if (runnable)
+  {
+    counter_made_runnable++;
+    Push(runnable, true);
+    return true;
+  }
+
+  counter_made_runnable_failed++;
+
+  bool const  in_pending = IsPending(task);
+  bool        in_running = false;
+  std::size_t count      = worker_count_;
+  for (std::size_t i = 0; (i < count) && !in_running; ++i)
+  {
+    Lock lock(workers_[i].mutex);
+    in_running = workers_[i].running && (workers_[i].running->GetTaskId() == task->GetTaskId());
+  }
+
+  FETCH_LOG_WARN(LOGGING_NAME, "Task ", task->GetTaskId(),
+                 " not in suspended_tasks list! in_pending=", in_pending,
+                 ", in_running=", in_running);
+  return false;
 }
 
 void Taskpool::UpdateStatus() const
 {
-  Lock lock(mutex_);
-  gauge_pending   = pending_tasks_.size();
-  gauge_running   = running_tasks_.size();
-  gauge_suspended = suspended_tasks_.size();
-  gauge_future    = future_tasks_.size();
+  std::size_t running = 0;
+  std::size_t count   = worker_count_;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Lock lock(workers_[i].mutex);
+    running += workers_[i].running ? 1u : 0u;
+  }
+
+  gauge_pending = pending_count_;
+  gauge_running = running;
+  {
+    Lock lock(suspended_mutex_);
+    gauge_suspended = suspended_tasks_.size();
+  }
+  {
+    Lock lock(timers_mutex_);
+    gauge_future = future_tasks_.size();
+  }
 }
 
 void Taskpool::stop()
 {
-  Lock lock(mutex_);
   quit_ = true;
 
-  for (auto const &t : pending_tasks_)
+  Tasks pending;
+  Tasks running;
+
+  std::size_t const count = std::max<std::size_t>(worker_count_, 1);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto &worker = workers_[i];
+    Lock  lock(worker.mutex);
+
+    pending.insert(pending.end(), worker.tasks.begin(), worker.tasks.end());
+    pending_count_ -= worker.tasks.size();
+    worker.tasks.clear();
+
+    if (worker.running)
+    {
+      running.push_back(worker.running);
+    }
+  }
+
+  // Cancelling takes the worker locks, so must only happen once they have been released
+  for (auto const &t : pending)
   {
     t->SetTaskState(Task::TaskState::DONE);
     t->cancel();
   }
-  pending_tasks_.clear();
 
-  for (auto const &kv : running_tasks_)
+  for (auto const &t : running)
   {
-    auto t = kv.second;
-    if (t)
-    {
-      t->cancel();
-    }
+    t->cancel();
   }
 
-  work_available_.notify_all();
-  work_available_.notify_all();
-  work_available_.notify_all();
+  WakeAll();
 }
 
 void Taskpool::suspend(TaskP task)
 {
-  Counter("mt-core.tasks.suspended")++;
-  Lock lock(mutex_);
+  counter_suspended++;
+  Lock lock(suspended_mutex_);
   if (task->GetTaskState() == Task::TaskState::PENDING)
   {
     // somebody else moved task to pending list while we were waiting for the mutex
@@ -320,11 +371,13 @@ void Taskpool::submit(TaskP task)
 {
   if (task->IsRunnable())
   {
-    Lock lock(mutex_);
-    Counter("mt-core.tasks.moved-to-runnable")++;
-    task->SetTaskState(Task::TaskState::PENDING);
-    pending_tasks_.push_back(task);
-    work_available_.notify_one();
+    counter_moved_to_runnable++;
+    {
+      // suspend and MakeRunnable read the state under this lock
+      Lock lock(suspended_mutex_);
+      task->SetTaskState(Task::TaskState::PENDING);
+    }
+    Push(task, false);
   }
   else
   {
@@ -334,97 +387,301 @@ void Taskpool::submit(TaskP task)
 
 void Taskpool::after(TaskP task, const Milliseconds &delay)
 {
-  Lock lock(mutex_);
+  {
+    Lock lock(suspended_mutex_);
+    task->SetTaskState(Task::TaskState::NOT_PENDING);
+  }
 
-  FutureTask ft;
-  ft.task = task;
-  ft.due  = Clock::now() + delay;
+  Tick const due = CurrentTick() + static_cast<Tick>(std::max<Milliseconds::rep>(delay.count(), 0));
+  {
+    Lock lock(timers_mutex_);
+    future_tasks_.Add(due, task);
+    next_timer_due_ = future_tasks_.NextEvent();
+  }
+  counter_futured++;
 
-  task->SetTaskState(Task::TaskState::NOT_PENDING);
-  future_tasks_.push(ft);
-  Counter("mt-core.tasks.futured")++;
+  // Make sure a sleeping worker recomputes how long it should sleep for
+  WakeOne();
 }
 
-Taskpool::Timestamp Taskpool::lockless_getNextWakeTime(const Timestamp &   current_time,
-                                                       const Milliseconds &deflt)
+void Taskpool::CancelTaskGroup(std::size_t group_id)
 {
-  Timestamp result = current_time + deflt;
-  if (!future_tasks_.empty())
+
+  FETCH_LOG_INFO(LOGGING_NAME, "CancelTaskGroup ", group_id);
+
+  std::list<TaskP> tasks;
+
+  std::size_t const count = std::max<std::size_t>(worker_count_, 1);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto &worker = workers_[i];
+    Lock  lock(worker.mutex);
+
+    auto iter = worker.tasks.begin();
+    while (iter != worker.tasks.end())
+    {
+      if ((*iter)->group_id_ == group_id)
+      {
+        (*iter)->SetTaskState(Task::TaskState::DONE);
+        tasks.push_back(*iter);
+        iter = worker.tasks.erase(iter);
+        --pending_count_;
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  {
+    Lock lock(suspended_mutex_);
+    auto iter = suspended_tasks_.begin();
+    while (iter != suspended_tasks_.end())
+    {
+      if ((*iter)->group_id_ == group_id)
+      {
+        (*iter)->SetTaskState(Task::TaskState::DONE);
+        tasks.push_back(*iter);
+        iter = suspended_tasks_.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  for (auto const &t : tasks)
   {
-    result = future_tasks_.top().due;
+    FETCH_LOG_INFO(LOGGING_NAME, "CancelTaskGroup ", group_id, " (P) task ", t->task_id_);
+    t->cancel();
   }
-  return result;
 }
 
-Taskpool::TaskP Taskpool::lockless_getNextFutureWork(const Timestamp &current_time)
+/**
+ * Adds a runnable task to a worker deque. Workers push onto their own deque, other threads
+ * distribute their tasks round robin over the workers.
+ */
+void Taskpool::Push(TaskP const &task, bool front)
 {
-  TaskP result;
-  while ((!future_tasks_.empty()) && future_tasks_.top().due <= current_time)
+  std::size_t worker_idx = 0;
+  if (current_pool == this)
+  {
+    worker_idx = current_worker;
+  }
+  else
+  {
+    std::size_t const count = worker_count_;
+    worker_idx              = (count == 0) ? 0 : (next_worker_++ % count);
+  }
+
   {
-    auto r = future_tasks_.top().task;
-    future_tasks_.pop();
+    auto &worker = workers_[worker_idx];
+    Lock  lock(worker.mutex);
 
-    if (!(r->IsCancelled()))
+    if (front)
     {
-      result        = r;
-      result->pool_ = nullptr;
-      Counter("mt-core.tasks.popped-for-run")++;
-      Counter("mt-core.future-tasks.popped-for-run")++;
-      break;
+      worker.tasks.push_front(task);
     }
+    else
+    {
+      worker.tasks.push_back(task);
+    }
+
+    ++pending_count_;
   }
-  return result;
+
+  WakeOne();
 }
 
-void Taskpool::CancelTaskGroup(std::size_t group_id)
+Taskpool::TaskP Taskpool::Pop(std::size_t worker_idx)
 {
+  auto &worker = workers_[worker_idx];
+  Lock  lock(worker.mutex);
 
-  FETCH_LOG_INFO(LOGGING_NAME, "CancelTaskGroup ", group_id);
+  if (worker.tasks.empty())
+  {
+    return nullptr;
+  }
 
-  std::list<TaskP> tasks;
+  TaskP task = std::move(worker.tasks.front());
+  worker.tasks.pop_front();
+  --pending_count_;
+
+  counter_popped++;
+  counter_popped_immediate++;
+  return task;
+}
 
+Taskpool::TaskP Taskpool::Steal(std::size_t worker_idx)
+{
+  std::size_t const count = worker_count_;
+  for (std::size_t offset = 1; offset < count; ++offset)
   {
-    Lock lock(mutex_);
+    auto &victim = workers_[(worker_idx + offset) % count];
+    Lock  lock(victim.mutex);
+
+    if (!victim.tasks.empty())
     {
-      auto iter = pending_tasks_.begin();
-      while (iter != pending_tasks_.end())
-      {
-        if ((*iter)->group_id_ == group_id)
-        {
-          (*iter)->SetTaskState(Task::TaskState::DONE);
-          tasks.push_back(*iter);
-          iter = pending_tasks_.erase(iter);
-        }
-        else
-        {
-          ++iter;
-        }
-      }
+      TaskP task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      --pending_count_;
+
+      counter_stolen++;
+      counter_popped++;
+      counter_popped_immediate++;
+      return task;
+    }
+  }
+
+  return nullptr;
+}
+
+/**
+ * Advances the timer wheel if any delayed task may be due. The first expired task is returned
+ * to be run straight away, the remainder are queued on the calling worker.
+ */
+Taskpool::TaskP Taskpool::PollTimers(std::size_t /*worker_idx*/)
+{
+  Tick const now = CurrentTick();
+  if (now < next_timer_due_)
+  {
+    return nullptr;
+  }
+
+  // Only one worker needs to advance the wheel
+  Lock lock(timers_mutex_, std::try_to_lock);
+  if (!lock)
+  {
+    return nullptr;
+  }
+
+  std::vector<TaskP> expired;
+  future_tasks_.Advance(now, [&expired](TaskP task) {
+    if (!task->IsCancelled())
+    {
+      expired.push_back(std::move(task));
+    }
+  });
+  next_timer_due_ = future_tasks_.NextEvent();
+  lock.unlock();
+
+  if (expired.empty())
+  {
+    return nullptr;
+  }
+
+  {
+    Lock suspended_lock(suspended_mutex_);
+    for (auto it = expired.begin() + 1; it != expired.end(); ++it)
+    {
+      (*it)->SetTaskState(Task::TaskState::PENDING);
+    }
+  }
+
+  for (auto it = expired.begin() + 1; it != expired.end(); ++it)
+  {
+    Push(*it, false);
+  }
+
+  counter_popped++;
+  counter_popped_future++;
+  return expired.front();
+}
+
+/**
+ * Puts a worker to sleep until it is woken by new work, the next timer becomes due or the idle
+ * timeout passes.
+ */
+void Taskpool::Sleep(std::size_t worker_idx)
+{
+  auto &         worker = workers_[worker_idx];
+  uint64_t const bit    = uint64_t{1} << worker_idx;
+
+  // Advertise as idle before the final check for work so that a concurrent Push either sees
+  // this worker as idle or its task is seen here
+  idle_workers_.fetch_or(bit);
+
+  Tick const now  = CurrentTick();
+  Tick const next = next_timer_due_;
+  if ((pending_count_ != 0) || quit_ || (now >= next))
+  {
+    idle_workers_.fetch_and(~bit);
+    return;
+  }
+
+  Milliseconds timeout = MAX_IDLE_SLEEP;
+  if (next != Timers::NEVER)
+  {
+    timeout = std::min(timeout, Milliseconds(static_cast<Milliseconds::rep>(next - now)));
+  }
+
+  {
+    Lock lock(worker.sleep_mutex);
+    worker.wake.wait_for(lock, timeout, [&worker]() { return worker.notified; });
+    worker.notified = false;
+  }
+
+  idle_workers_.fetch_and(~bit);
+}
+
+void Taskpool::WakeOne()
+{
+  uint64_t mask = idle_workers_;
+  while (mask != 0)
+  {
+    std::size_t worker_idx = 0;
+    while ((mask & (uint64_t{1} << worker_idx)) == 0)
+    {
+      ++worker_idx;
     }
 
+    uint64_t const bit = uint64_t{1} << worker_idx;
+    if (idle_workers_.compare_exchange_weak(mask, mask & ~bit))
     {
-      auto iter = suspended_tasks_.begin();
-      while (iter != suspended_tasks_.end())
+      auto &worker = workers_[worker_idx];
       {
-        if ((*iter)->group_id_ == group_id)
-        {
-          (*iter)->SetTaskState(Task::TaskState::DONE);
-          tasks.push_back(*iter);
-          iter = suspended_tasks_.erase(iter);
-        }
-        else
-        {
-          ++iter;
-        }
+        Lock lock(worker.sleep_mutex);
+        worker.notified = true;
       }
+      worker.wake.notify_one();
+      return;
     }
   }
+}
 
-  for (auto const &t : tasks)
+void Taskpool::WakeAll()
+{
+  for (auto &worker : workers_)
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "CancelTaskGroup ", group_id, " (P) task ", t->task_id_);
-    t->cancel();
+    {
+      Lock lock(worker.sleep_mutex);
+      worker.notified = true;
+    }
+    worker.wake.notify_all();
+  }
+}
+
+bool Taskpool::IsPending(TaskP const &task) const
+{
+  std::size_t const count = std::max<std::size_t>(worker_count_, 1);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Lock lock(workers_[i].mutex);
+    if (std::find(workers_[i].tasks.begin(), workers_[i].tasks.end(), task) !=
+        workers_[i].tasks.end())
+    {
+      return true;
+    }
   }
+  return false;
+}
+
+Taskpool::Tick Taskpool::CurrentTick() const
+{
+  return static_cast<Tick>(
+      std::chrono::duration_cast<Milliseconds>(SteadyClock::now() - epoch_).count());
 }
 
 }  // namespace base
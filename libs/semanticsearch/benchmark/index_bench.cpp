@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "semanticsearch/index/in_memory_db_index.hpp"
+#include "semanticsearch/index/morton_db_index.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using fetch::semanticsearch::InMemoryDBIndex;
+using fetch::semanticsearch::MortonDBIndex;
+using fetch::semanticsearch::SemanticCoordinateType;
+using fetch::semanticsearch::SemanticPosition;
+using fetch::semanticsearch::SemanticSubscription;
+
+namespace {
+
+using Subscriptions = std::vector<SemanticSubscription>;
+
+Subscriptions GenerateSubscriptions(std::size_t rank, std::size_t count)
+{
+  std::mt19937_64 rng{42};
+  Subscriptions   subscriptions(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    subscriptions[i].index = i;
+    subscriptions[i].position.resize(rank);
+    for (auto &coordinate : subscriptions[i].position)
+    {
+      coordinate = rng();
+    }
+  }
+  return subscriptions;
+}
+
+void InMemoryIndex_Load(benchmark::State &state)
+{
+  auto const rank          = static_cast<std::size_t>(state.range(0));
+  auto const count         = static_cast<std::size_t>(state.range(1));
+  auto const subscriptions = GenerateSubscriptions(rank, count);
+
+  for (auto _ : state)
+  {
+    InMemoryDBIndex index{rank};
+    for (auto const &subscription : subscriptions)
+    {
+      index.AddRelation(subscription);
+    }
+    benchmark::DoNotOptimize(index);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+void MortonIndex_BulkLoad(benchmark::State &state)
+{
+  auto const rank          = static_cast<std::size_t>(state.range(0));
+  auto const count         = static_cast<std::size_t>(state.range(1));
+  auto const subscriptions = GenerateSubscriptions(rank, count);
+
+  for (auto _ : state)
+  {
+    MortonDBIndex index{rank};
+    index.BulkLoad(subscriptions);
+    benchmark::DoNotOptimize(index);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+void InMemoryIndex_FindGroup(benchmark::State &state)
+{
+  auto const rank          = static_cast<std::size_t>(state.range(0));
+  auto const count         = static_cast<std::size_t>(state.range(1));
+  auto const subscriptions = GenerateSubscriptions(rank, count);
+
+  InMemoryDBIndex index{rank};
+  for (auto const &subscription : subscriptions)
+  {
+    index.AddRelation(subscription);
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state)
+  {
+    auto const &position = subscriptions[i++ % count].position;
+    benchmark::DoNotOptimize(index.Find(4, position));
+  }
+}
+
+void MortonIndex_FindGroup(benchmark::State &state)
+{
+  auto const rank          = static_cast<std::size_t>(state.range(0));
+  auto const count         = static_cast<std::size_t>(state.range(1));
+  auto const subscriptions = GenerateSubscriptions(rank, count);
+
+  MortonDBIndex index{rank};
+  index.BulkLoad(subscriptions);
+
+  std::size_t i = 0;
+  for (auto _ : state)
+  {
+    auto const &position = subscriptions[i++ % count].position;
+    benchmark::DoNotOptimize(index.FindGroup(4, position));
+  }
+}
+
+void MortonIndex_FindRange(benchmark::State &state)
+{
+  auto const rank          = static_cast<std::size_t>(state.range(0));
+  auto const count         = static_cast<std::size_t>(state.range(1));
+  auto const subscriptions = GenerateSubscriptions(rank, count);
+
+  MortonDBIndex index{rank};
+  index.BulkLoad(subscriptions);
+
+  // Hypercubes covering a sixteenth of each axis around existing records
+  SemanticCoordinateType const half_width = SemanticCoordinateType(-1) >> 5;
+
+  std::size_t i = 0;
+  std::size_t found{0};
+  for (auto _ : state)
+  {
+    auto const &centre = subscriptions[i++ % count].position;
+
+    SemanticPosition lower(rank);
+    SemanticPosition upper(rank);
+    for (std::size_t k = 0; k < rank; ++k)
+    {
+      lower[k] = (centre[k] > half_width) ? centre[k] - half_width : 0;
+      upper[k] = (centre[k] < ~half_width) ? centre[k] + half_width : ~SemanticCoordinateType{0};
+    }
+
+    auto const result = index.FindRange(lower, upper);
+    found += result.size();
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.counters["results"] =
+      benchmark::Counter(static_cast<double>(found), benchmark::Counter::kAvgIterations);
+}
+
+void SweepDimensionAndRecords(benchmark::internal::Benchmark *b)
+{
+  for (int64_t rank : {1, 2, 4, 8, 16})
+  {
+    for (int64_t count : {1000, 10000, 100000, 1000000})
+    {
+      b->Args({rank, count});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(InMemoryIndex_Load)->Apply(SweepDimensionAndRecords)->Unit(benchmark::kMillisecond);
+BENCHMARK(MortonIndex_BulkLoad)->Apply(SweepDimensionAndRecords)->Unit(benchmark::kMillisecond);
+BENCHMARK(InMemoryIndex_FindGroup)->Apply(SweepDimensionAndRecords);
+BENCHMARK(MortonIndex_FindGroup)->Apply(SweepDimensionAndRecords);
+BENCHMARK(MortonIndex_FindRange)->Apply(SweepDimensionAndRecords);
@@ -32,6 +32,7 @@ using SemanticPosition = std::vector<SemanticCoordinateType>;  ///< Position in
 
 using DBIndexSet    = std::set<DBIndexType>;  ///< Set of indices used to return search results.
 using DBIndexSetPtr = std::shared_ptr<DBIndexSet>;
+using DBIndexList   = std::vector<DBIndexType>;  ///< Sorted, unique list of indices.
 
 }  // namespace semanticsearch
 }  // namespace fetch
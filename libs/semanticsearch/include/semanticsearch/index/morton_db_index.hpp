@@ -0,0 +1,123 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "semanticsearch/index/base_types.hpp"
+#include "semanticsearch/index/database_index_interface.hpp"
+#include "semanticsearch/index/semantic_subscription.hpp"
+#include "semanticsearch/index/subscription_group.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace fetch {
+namespace semanticsearch {
+
+/* Flat alternative to the InMemoryDBIndex. Rather than keeping a set of
+ * indices for every subscription group at every depth, each subscription is
+ * stored once in a set of flat arrays sorted by the Morton (Z-order) code of
+ * its position:
+ *
+ *   y
+ *   ▲
+ *   │  ┌────┬────┐
+ *   │  │ 2 ─┼► 3 │        The Morton code interleaves the most significant
+ *   │  │ ▲ ╱│    │        bits of each coordinate. Consequently all points
+ *   │  ├─┼╱─┼────┤        inside an aligned cell share the same leading bits
+ *   │  │ 0 ─┼► 1 │        and form a single contiguous run in the sorted
+ *   │  └────┴────┘        arrays.
+ *   └──────────────► x
+ *
+ * Hypercube range queries walk the sorted codes, skipping runs outside the
+ * query box using the BIGMIN algorithm by Tropf and Herzog. Only the leading
+ * KeyBits() / rank() bits of each coordinate are part of the code; the full
+ * coordinates are kept alongside for exact filtering.
+ *
+ * Subscription groups follow the same definition as in the InMemoryDBIndex
+ * (see SubscriptionGroup): a group is the box of positions with the same
+ * quotient by the group width, and is looked up as a range query. Groups only
+ * exist for depths below MAX_GROUP_DEPTH. The sets returned by Find are
+ * cached until the index is next modified.
+ *
+ * Subscriptions added one at a time are kept in a small unsorted staging area
+ * which is merged into the sorted arrays once it is full. Large collections
+ * should be loaded with BulkLoad.
+ */
+class MortonDBIndex : public DatabaseIndexInterface
+{
+public:
+  using MortonCode         = uint64_t;
+  using SubscriptionList   = std::vector<SemanticSubscription>;
+  using CoordinateIterator = std::vector<SemanticCoordinateType>::const_iterator;
+
+  static constexpr std::size_t            MAX_STAGED_SUBSCRIPTIONS = 4096;
+  static constexpr SemanticCoordinateType MAX_GROUP_DEPTH          = 20;
+
+  explicit MortonDBIndex(std::size_t rank);
+
+  /// Database index interface
+  /// @{
+  void          AddRelation(SemanticSubscription const &obj) override;
+  DBIndexSetPtr Find(SemanticCoordinateType depth, SemanticPosition position) const override;
+  std::size_t   rank() const override;
+  /// @}
+
+  /// Flat index operations
+  /// @{
+  void        BulkLoad(SubscriptionList const &subscriptions);
+  DBIndexList FindGroup(SemanticCoordinateType depth, SemanticPosition const &position) const;
+  DBIndexList FindRange(SemanticPosition const &lower, SemanticPosition const &upper) const;
+  std::size_t size() const;
+  std::size_t KeyBits() const;
+  MortonCode  Encode(SemanticPosition const &position) const;
+  /// @}
+
+private:
+  void       Merge();
+  void       ClearCache();
+  void       ValidateRank(SemanticPosition const &position) const;
+  MortonCode BigMin(MortonCode code, MortonCode min_code, MortonCode max_code) const;
+  bool       CodeInBox(MortonCode code, MortonCode min_code, MortonCode max_code) const;
+  bool       InBox(CoordinateIterator coordinate, SemanticPosition const &lower,
+                   SemanticPosition const &upper) const;
+  SemanticCoordinateType Quantise(SemanticCoordinateType coordinate) const;
+
+  std::size_t rank_{0};
+  std::size_t bits_per_dimension_{0};  ///< Number of leading bits of each coordinate encoded
+  std::size_t key_bits_{0};            ///< Total number of bits used in a Morton code
+
+  std::vector<MortonCode> dimension_masks_{};  ///< Bits of the Morton code owned by each dimension
+
+  /// Sorted subscriptions stored as structure of arrays
+  /// @{
+  std::vector<MortonCode>             codes_{};
+  std::vector<DBIndexType>            entries_{};
+  std::vector<SemanticCoordinateType> coordinates_{};  ///< rank_ coordinates per entry
+  /// @}
+
+  SubscriptionList staged_{};  ///< Recently added, not yet sorted, subscriptions
+
+  mutable Mutex                                      cache_lock_;
+  mutable std::map<SubscriptionGroup, DBIndexSetPtr> group_cache_{};  ///< Results of Find
+};
+
+}  // namespace semanticsearch
+}  // namespace fetch
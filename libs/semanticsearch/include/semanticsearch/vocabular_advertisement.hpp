@@ -17,7 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
-#include "semanticsearch/index/in_memory_db_index.hpp"
+#include "semanticsearch/index/morton_db_index.hpp"
 #include "semanticsearch/schema/properties_map.hpp"
 #include "semanticsearch/schema/vocabulary_instance.hpp"
 
@@ -37,7 +37,7 @@ public:
 
   explicit VocabularyAdvertisement(VocabularySchema vocabulary_schema)
     : vocabulary_schema_(std::move(vocabulary_schema))
-    , index_{static_cast<std::size_t>(vocabulary_schema->rank())}
+    , index_{static_cast<std::size_t>(vocabulary_schema_->rank())}
   {}
 
   void SubscribeAgent(AgentId aid, SemanticPosition position)
@@ -54,6 +54,11 @@ public:
     return index_.Find(depth, std::move(position));
   }
 
+  DBIndexList FindAgentsInRange(SemanticPosition const &lower, SemanticPosition const &upper) const
+  {
+    return index_.FindRange(lower, upper);
+  }
+
   VocabularySchema const &vocabulary_schema() const
   {
     return vocabulary_schema_;
@@ -61,7 +66,7 @@ public:
 
 private:
   VocabularySchema vocabulary_schema_;
-  InMemoryDBIndex  index_;
+  MortonDBIndex    index_;
 };
 
 }  // namespace semanticsearch
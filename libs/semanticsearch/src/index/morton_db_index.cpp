@@ -0,0 +1,426 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "semanticsearch/index/morton_db_index.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <stdexcept>
+
+namespace fetch {
+namespace semanticsearch {
+namespace {
+
+constexpr std::size_t COORDINATE_BITS = sizeof(SemanticCoordinateType) * 8;
+constexpr std::size_t CODE_BITS       = sizeof(MortonDBIndex::MortonCode) * 8;
+constexpr auto        MAX_COORDINATE  = static_cast<SemanticCoordinateType>(-1);
+
+void SortAndRemoveDuplicates(DBIndexList &list)
+{
+  std::sort(list.begin(), list.end());
+  list.erase(std::unique(list.begin(), list.end()), list.end());
+}
+
+}  // namespace
+
+MortonDBIndex::MortonDBIndex(std::size_t rank)
+  : rank_{rank}
+{
+  bits_per_dimension_ = (rank_ == 0) ? 0 : CODE_BITS / rank_;
+  key_bits_           = bits_per_dimension_ * rank_;
+
+  // Bit t (counting from the most significant end of the code) belongs to dimension t % rank
+  dimension_masks_.resize(rank_, 0);
+  for (std::size_t t = 0; t < key_bits_; ++t)
+  {
+    dimension_masks_[t % rank_] |= MortonCode{1} << (key_bits_ - 1 - t);
+  }
+}
+
+void MortonDBIndex::AddRelation(SemanticSubscription const &obj)
+{
+  ValidateRank(obj.position);
+
+  ClearCache();
+
+  staged_.push_back(obj);
+  if (staged_.size() >= MAX_STAGED_SUBSCRIPTIONS)
+  {
+    Merge();
+  }
+}
+
+DBIndexSetPtr MortonDBIndex::Find(SemanticCoordinateType depth, SemanticPosition position) const
+{
+  ValidateRank(position);
+
+  if (depth >= MAX_GROUP_DEPTH)
+  {
+    return nullptr;
+  }
+
+  SubscriptionGroup const key{depth, position};
+
+  {
+    FETCH_LOCK(cache_lock_);
+
+    auto const it = group_cache_.find(key);
+    if (it != group_cache_.end())
+    {
+      return it->second;
+    }
+  }
+
+  DBIndexSetPtr ret{};
+
+  auto const group = FindGroup(depth, position);
+  if (!group.empty())
+  {
+    ret = std::make_shared<DBIndexSet>(group.begin(), group.end());
+  }
+
+  FETCH_LOCK(cache_lock_);
+  group_cache_.emplace(key, ret);
+
+  return ret;
+}
+
+std::size_t MortonDBIndex::rank() const
+{
+  return rank_;
+}
+
+/**
+ * Loads a large number of subscriptions at once. This is considerably faster than adding the
+ * subscriptions one at a time.
+ *
+ * @param subscriptions The subscriptions to add
+ */
+void MortonDBIndex::BulkLoad(SubscriptionList const &subscriptions)
+{
+  for (auto const &subscription : subscriptions)
+  {
+    ValidateRank(subscription.position);
+  }
+
+  ClearCache();
+
+  staged_.insert(staged_.end(), subscriptions.begin(), subscriptions.end());
+  Merge();
+}
+
+/**
+ * Finds the indices of all subscriptions belonging to the same subscription group as a position.
+ *
+ * @param depth The depth of the subscription group
+ * @param position A position inside the subscription group
+ * @return Sorted list of indices
+ */
+DBIndexList MortonDBIndex::FindGroup(SemanticCoordinateType  depth,
+                                     SemanticPosition const &position) const
+{
+  ValidateRank(position);
+
+  if (depth >= MAX_GROUP_DEPTH)
+  {
+    return {};
+  }
+
+  // A group holds the positions which have the same quotient by the group width along every axis
+  auto const width = SubscriptionGroup::CalculateWidthFromDepth(depth);
+
+  SemanticPosition lower;
+  SemanticPosition upper;
+  lower.reserve(rank_);
+  upper.reserve(rank_);
+  for (auto const &coordinate : position)
+  {
+    auto const first = (coordinate / width) * width;
+
+    lower.push_back(first);
+    upper.push_back(((MAX_COORDINATE - first) < width) ? MAX_COORDINATE : first + (width - 1));
+  }
+
+  return FindRange(lower, upper);
+}
+
+/**
+ * Finds the indices of all subscriptions inside a hypercube.
+ *
+ * @param lower The lower corner of the hypercube (inclusive)
+ * @param upper The upper corner of the hypercube (inclusive)
+ * @return Sorted list of indices
+ */
+DBIndexList MortonDBIndex::FindRange(SemanticPosition const &lower,
+                                     SemanticPosition const &upper) const
+{
+  ValidateRank(lower);
+  ValidateRank(upper);
+
+  DBIndexList ret;
+
+  for (std::size_t k = 0; k < rank_; ++k)
+  {
+    if (lower[k] > upper[k])
+    {
+      return ret;
+    }
+  }
+
+  MortonCode const min_code = Encode(lower);
+  MortonCode const max_code = Encode(upper);
+
+  auto it = std::lower_bound(codes_.begin(), codes_.end(), min_code);
+  while ((it != codes_.end()) && (*it <= max_code))
+  {
+    MortonCode const code = *it;
+
+    if (CodeInBox(code, min_code, max_code))
+    {
+      // The cell overlaps the box, check each of its entries exactly
+      for (; (it != codes_.end()) && (*it == code); ++it)
+      {
+        auto const i = static_cast<std::size_t>(it - codes_.begin());
+        if (InBox(coordinates_.begin() + static_cast<std::ptrdiff_t>(i * rank_), lower, upper))
+        {
+          ret.push_back(entries_[i]);
+        }
+      }
+    }
+    else
+    {
+      // Skip ahead to the next code which lies inside the box
+      MortonCode const next = BigMin(code, min_code, max_code);
+      if (next <= code)
+      {
+        break;
+      }
+
+      it = std::lower_bound(it, codes_.end(), next);
+    }
+  }
+
+  for (auto const &subscription : staged_)
+  {
+    if (InBox(subscription.position.begin(), lower, upper))
+    {
+      ret.push_back(subscription.index);
+    }
+  }
+
+  SortAndRemoveDuplicates(ret);
+  return ret;
+}
+
+std::size_t MortonDBIndex::size() const
+{
+  return codes_.size() + staged_.size();
+}
+
+std::size_t MortonDBIndex::KeyBits() const
+{
+  return key_bits_;
+}
+
+/**
+ * Computes the Morton code of a position by interleaving the leading bits of each coordinate.
+ *
+ * @param position The position to encode
+ * @return The Morton code
+ */
+MortonDBIndex::MortonCode MortonDBIndex::Encode(SemanticPosition const &position) const
+{
+  assert(position.size() == rank_);
+
+  MortonCode code = 0;
+  for (std::size_t level = 0; level < bits_per_dimension_; ++level)
+  {
+    auto const shift = bits_per_dimension_ - 1 - level;
+    for (std::size_t k = 0; k < rank_; ++k)
+    {
+      code = (code << 1u) | ((Quantise(position[k]) >> shift) & 1u);
+    }
+  }
+
+  return code;
+}
+
+void MortonDBIndex::Merge()
+{
+  if (staged_.empty())
+  {
+    return;
+  }
+
+  // Sort the staged subscriptions by their Morton code
+  std::vector<MortonCode> staged_codes;
+  staged_codes.reserve(staged_.size());
+  for (auto const &subscription : staged_)
+  {
+    staged_codes.push_back(Encode(subscription.position));
+  }
+
+  std::vector<std::size_t> order(staged_.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::sort(order.begin(), order.end(), [&staged_codes](std::size_t a, std::size_t b) {
+    return staged_codes[a] < staged_codes[b];
+  });
+
+  // Merge the two sorted sequences into fresh arrays
+  std::size_t const                   total = codes_.size() + staged_.size();
+  std::vector<MortonCode>             codes;
+  std::vector<DBIndexType>            entries;
+  std::vector<SemanticCoordinateType> coordinates;
+  codes.reserve(total);
+  entries.reserve(total);
+  coordinates.reserve(total * rank_);
+
+  std::size_t existing = 0;
+  std::size_t staged   = 0;
+  while ((existing < codes_.size()) || (staged < order.size()))
+  {
+    if ((staged == order.size()) ||
+        ((existing < codes_.size()) && (codes_[existing] <= staged_codes[order[staged]])))
+    {
+      auto const coordinate = coordinates_.begin() + static_cast<std::ptrdiff_t>(existing * rank_);
+      codes.push_back(codes_[existing]);
+      entries.push_back(entries_[existing]);
+      coordinates.insert(coordinates.end(), coordinate,
+                         coordinate + static_cast<std::ptrdiff_t>(rank_));
+      ++existing;
+    }
+    else
+    {
+      auto const &subscription = staged_[order[staged]];
+      codes.push_back(staged_codes[order[staged]]);
+      entries.push_back(subscription.index);
+      coordinates.insert(coordinates.end(), subscription.position.begin(),
+                         subscription.position.end());
+      ++staged;
+    }
+  }
+
+  codes_       = std::move(codes);
+  entries_     = std::move(entries);
+  coordinates_ = std::move(coordinates);
+  staged_.clear();
+}
+
+void MortonDBIndex::ClearCache()
+{
+  FETCH_LOCK(cache_lock_);
+  group_cache_.clear();
+}
+
+void MortonDBIndex::ValidateRank(SemanticPosition const &position) const
+{
+  // We require that only positions with same rank as the predefined
+  // rank can be used. This is to prevent trivial mistakes in the code.
+  if (position.size() != rank_)
+  {
+    throw std::runtime_error("Rank of position differs from index.");
+  }
+}
+
+/**
+ * Computes the smallest Morton code larger than `code` which lies inside the box spanned by
+ * `min_code` and `max_code` (Tropf and Herzog, 1981). `code` must lie between the two corners
+ * and outside the box.
+ */
+MortonDBIndex::MortonCode MortonDBIndex::BigMin(MortonCode code, MortonCode min_code,
+                                                MortonCode max_code) const
+{
+  MortonCode bigmin = 0;
+
+  for (std::size_t i = key_bits_; i-- > 0;)
+  {
+    MortonCode const bit          = MortonCode{1} << i;
+    MortonCode const dim_mask     = dimension_masks_[(key_bits_ - 1 - i) % rank_];
+    MortonCode const lower_bits   = dim_mask & (bit - 1);  // less significant, same dimension
+    MortonCode const keep         = ~(dim_mask & (bit | (bit - 1)));
+    bool const       code_bit     = (code & bit) != 0;
+    bool const       min_code_bit = (min_code & bit) != 0;
+    bool const       max_code_bit = (max_code & bit) != 0;
+
+    if (!code_bit && !min_code_bit && max_code_bit)
+    {
+      bigmin   = (min_code & keep) | bit;
+      max_code = (max_code & keep) | lower_bits;
+    }
+    else if (!code_bit && min_code_bit && max_code_bit)
+    {
+      return min_code;
+    }
+    else if (code_bit && !min_code_bit && !max_code_bit)
+    {
+      return bigmin;
+    }
+    else if (code_bit && !min_code_bit && max_code_bit)
+    {
+      min_code = (min_code & keep) | bit;
+    }
+  }
+
+  return bigmin;
+}
+
+/**
+ * Tests whether the cell of a Morton code overlaps the box. Since the bits of a single dimension
+ * preserve their order when masked out of the code, this is a per dimension comparison.
+ */
+bool MortonDBIndex::CodeInBox(MortonCode code, MortonCode min_code, MortonCode max_code) const
+{
+  for (auto const &mask : dimension_masks_)
+  {
+    MortonCode const value = code & mask;
+    if ((value < (min_code & mask)) || (value > (max_code & mask)))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool MortonDBIndex::InBox(CoordinateIterator coordinate, SemanticPosition const &lower,
+                          SemanticPosition const &upper) const
+{
+  for (std::size_t k = 0; k < rank_; ++k, ++coordinate)
+  {
+    if ((*coordinate < lower[k]) || (*coordinate > upper[k]))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+SemanticCoordinateType MortonDBIndex::Quantise(SemanticCoordinateType coordinate) const
+{
+  if (bits_per_dimension_ == 0)
+  {
+    return 0;
+  }
+
+  return coordinate >> (COORDINATE_BITS - bits_per_dimension_);
+}
+
+}  // namespace semanticsearch
+}  // namespace fetch
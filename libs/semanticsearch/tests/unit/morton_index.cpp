@@ -0,0 +1,218 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "semanticsearch/index/in_memory_db_index.hpp"
+#include "semanticsearch/index/morton_db_index.hpp"
+#include "semanticsearch/index/subscription_group.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace fetch::semanticsearch;
+
+namespace {
+
+std::vector<SemanticSubscription> RandomSubscriptions(std::size_t rank, std::size_t count)
+{
+  std::mt19937_64                   rng{42};
+  std::vector<SemanticSubscription> ret;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    SemanticSubscription rel;
+    for (std::size_t k = 0; k < rank; ++k)
+    {
+      rel.position.push_back(rng());
+    }
+    rel.index = i;
+    ret.push_back(rel);
+  }
+  return ret;
+}
+
+DBIndexList BruteForceRange(std::vector<SemanticSubscription> const &subscriptions,
+                            SemanticPosition const &lower, SemanticPosition const &upper)
+{
+  DBIndexList ret;
+  for (auto const &rel : subscriptions)
+  {
+    bool inside = true;
+    for (std::size_t k = 0; k < lower.size(); ++k)
+    {
+      inside = inside && (lower[k] <= rel.position[k]) && (rel.position[k] <= upper[k]);
+    }
+
+    if (inside)
+    {
+      ret.push_back(rel.index);
+    }
+  }
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+}  // namespace
+
+TEST(SemanticSearchMortonIndex, BasicOperations2D)
+{
+  MortonDBIndex          database_index{2};
+  SemanticCoordinateType width = static_cast<SemanticCoordinateType>(-1) / 4;
+
+  // Adding points in a grid
+  for (SemanticCoordinateType i = 0; i < 4; ++i)
+  {
+    for (SemanticCoordinateType j = 0; j < 4; ++j)
+    {
+      SemanticSubscription rel;
+      rel.position.push_back(width * i + (width >> 1));
+      rel.position.push_back(width * j + (width >> 1));
+      rel.index = i * 4 + j;
+      database_index.AddRelation(rel);
+    }
+  }
+
+  EXPECT_EQ(database_index.size(), 16);
+  EXPECT_THROW(database_index.Find(0, {width * 2}), std::runtime_error);
+
+  // Testing search
+  auto group0 = database_index.Find(0, {width * 2, width * 2});
+  ASSERT_NE(group0, nullptr);
+  EXPECT_EQ(*group0, std::set<DBIndexType>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}));
+
+  EXPECT_EQ(database_index.FindGroup(1, {width, width}), DBIndexList({0, 1, 4, 5}));
+  EXPECT_EQ(database_index.FindGroup(1, {width, 3 * width}), DBIndexList({2, 3, 6, 7}));
+  EXPECT_EQ(database_index.FindGroup(1, {3 * width, width}), DBIndexList({8, 9, 12, 13}));
+  EXPECT_EQ(database_index.FindGroup(1, {3 * width, 3 * width}), DBIndexList({10, 11, 14, 15}));
+  EXPECT_EQ(database_index.FindGroup(2, {width + 1, width + 1}), DBIndexList({5}));
+
+  // Testing range queries
+  EXPECT_EQ(database_index.FindRange({0, 0}, {2 * width, width}), DBIndexList({0, 4}));
+  EXPECT_EQ(database_index.FindRange({width, width}, {3 * width, 3 * width}),
+            DBIndexList({5, 6, 9, 10}));
+  EXPECT_TRUE(database_index.FindRange({width, 0}, {0, width}).empty());
+}
+
+TEST(SemanticSearchMortonIndex, RangeQueriesMatchBruteForce)
+{
+  for (std::size_t rank : {1u, 3u, 8u, 80u})
+  {
+    auto subscriptions = RandomSubscriptions(rank, 5000);
+
+    // Bulk load most of the records and stage the remainder
+    MortonDBIndex database_index{rank};
+    database_index.BulkLoad({subscriptions.begin(), subscriptions.begin() + 4500});
+    for (auto it = subscriptions.begin() + 4500; it != subscriptions.end(); ++it)
+    {
+      database_index.AddRelation(*it);
+    }
+    ASSERT_EQ(database_index.size(), subscriptions.size());
+
+    std::mt19937_64 rng{7};
+    for (std::size_t query = 0; query < 50; ++query)
+    {
+      SemanticPosition lower;
+      SemanticPosition upper;
+      for (std::size_t k = 0; k < rank; ++k)
+      {
+        auto const a = rng() >> 1;
+        lower.push_back(a);
+        upper.push_back(a + (rng() >> 2));
+      }
+
+      EXPECT_EQ(database_index.FindRange(lower, upper),
+                BruteForceRange(subscriptions, lower, upper));
+    }
+  }
+}
+
+TEST(SemanticSearchMortonIndex, GroupsMatchInMemoryIndex)
+{
+  std::size_t const rank = 3;
+
+  // Random points together with points right on (and next to) the group boundaries
+  std::mt19937_64                   rng{11};
+  std::vector<SemanticSubscription> subscriptions = RandomSubscriptions(rank, 2000);
+  for (SemanticCoordinateType depth = 0; depth < 22; ++depth)
+  {
+    auto const width  = SubscriptionGroup::CalculateWidthFromDepth(depth);
+    auto const groups = SemanticCoordinateType{1} << std::min<SemanticCoordinateType>(depth, 20);
+    for (SemanticCoordinateType offset : {SemanticCoordinateType{0}, SemanticCoordinateType{1}})
+    {
+      SemanticSubscription rel;
+      for (std::size_t k = 0; k < rank; ++k)
+      {
+        rel.position.push_back(width * ((rng() % groups) + 1) - offset);
+      }
+      rel.index = subscriptions.size();
+      subscriptions.push_back(rel);
+    }
+  }
+
+  SemanticSubscription top;
+  top.position = SemanticPosition(rank, static_cast<SemanticCoordinateType>(-1));
+  top.index    = subscriptions.size();
+  subscriptions.push_back(top);
+
+  InMemoryDBIndex reference{rank};
+  MortonDBIndex   database_index{rank};
+  for (auto const &rel : subscriptions)
+  {
+    reference.AddRelation(rel);
+  }
+  database_index.BulkLoad(subscriptions);
+
+  for (SemanticCoordinateType depth = 0; depth < 24; ++depth)
+  {
+    for (auto const &rel : subscriptions)
+    {
+      auto const expected = reference.Find(depth, rel.position);
+      auto const actual   = database_index.Find(depth, rel.position);
+
+      if (!expected)
+      {
+        EXPECT_EQ(actual, nullptr) << "depth " << depth;
+        continue;
+      }
+
+      ASSERT_NE(actual, nullptr) << "depth " << depth;
+      EXPECT_EQ(*expected, *actual) << "depth " << depth;
+    }
+  }
+}
+
+TEST(SemanticSearchMortonIndex, FindReturnsCachedGroupUntilModified)
+{
+  auto const    subscriptions = RandomSubscriptions(2, 100);
+  MortonDBIndex database_index{2};
+  database_index.BulkLoad(subscriptions);
+
+  auto const &position = subscriptions.front().position;
+  auto const  first    = database_index.Find(1, position);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first, database_index.Find(1, position));
+
+  SemanticSubscription rel;
+  rel.position = position;
+  rel.index    = 1000;
+  database_index.AddRelation(rel);
+
+  auto const updated = database_index.Find(1, position);
+  ASSERT_NE(updated, nullptr);
+  EXPECT_NE(first, updated);
+  EXPECT_EQ(first->size() + 1, updated->size());
+}
@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "storage/document_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::storage::ResourceAddress;
+
+using DocumentStore  = fetch::storage::DocumentStore<2048>;
+using AllocationMode = DocumentStore::FileObjectType::AllocationMode;
+
+constexpr std::size_t NUM_DOCUMENTS = 64;
+constexpr std::size_t GROWTH_STEPS  = 4;
+
+ByteArray RandomBytes(LinearCongruentialGenerator &rng, std::size_t size)
+{
+  ByteArray bytes;
+  bytes.Resize(size);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    bytes[i] = static_cast<uint8_t>(rng());
+  }
+
+  return bytes;
+}
+
+/**
+ * Populate a store with documents of the requested size. Documents are grown in several steps,
+ * round robin, which is the access pattern that fragments documents under linked allocation.
+ */
+std::vector<ResourceAddress> Populate(DocumentStore &store, LinearCongruentialGenerator &rng,
+                                      std::size_t document_size)
+{
+  std::vector<ResourceAddress> keys;
+  for (std::size_t i = 0; i < NUM_DOCUMENTS; ++i)
+  {
+    keys.emplace_back("document " + std::to_string(i));
+  }
+
+  for (std::size_t step = 1; step <= GROWTH_STEPS; ++step)
+  {
+    for (auto const &key : keys)
+    {
+      store.Set(key, RandomBytes(rng, (document_size * step) / GROWTH_STEPS));
+    }
+  }
+
+  return keys;
+}
+
+void Setup(DocumentStore &store, benchmark::State const &state)
+{
+  store.New("document_store_bench.db", "document_store_bench.diff.db",
+            "document_store_bench.index.db", "document_store_bench.index.diff.db");
+
+  store.SetAllocationMode(state.range(1) != 0 ? AllocationMode::EXTENT : AllocationMode::LINKED);
+}
+
+void DocumentStore_Get(benchmark::State &state)
+{
+  auto const document_size = static_cast<std::size_t>(state.range(0));
+
+  LinearCongruentialGenerator rng;
+  DocumentStore               store;
+  Setup(store, state);
+
+  auto const keys = Populate(store, rng, document_size);
+
+  for (auto _ : state)
+  {
+    auto document = store.Get(keys[rng() % keys.size()]);
+    benchmark::DoNotOptimize(document.document.pointer());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * document_size));
+}
+
+void DocumentStore_Set(benchmark::State &state)
+{
+  auto const document_size = static_cast<std::size_t>(state.range(0));
+
+  LinearCongruentialGenerator rng;
+  DocumentStore               store;
+  Setup(store, state);
+
+  auto const keys  = Populate(store, rng, document_size);
+  auto const value = RandomBytes(rng, document_size);
+
+  for (auto _ : state)
+  {
+    store.Set(keys[rng() % keys.size()], value);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * document_size));
+}
+
+void DocumentStore_ConvertToExtents(benchmark::State &state)
+{
+  auto const document_size = static_cast<std::size_t>(state.range(0));
+
+  LinearCongruentialGenerator rng;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    DocumentStore store;
+    Setup(store, state);
+    Populate(store, rng, document_size);
+    store.SetAllocationMode(AllocationMode::EXTENT);
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(store.ConvertToExtents());
+  }
+
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations() * document_size * NUM_DOCUMENTS));
+}
+
+// Arguments: document size in bytes, allocation mode (0 = linked, 1 = extent)
+void DocumentSizes(benchmark::internal::Benchmark *b)
+{
+  for (int64_t mode : {0, 1})
+  {
+    for (int64_t size = 256; size <= (256 << 10); size *= 4)
+    {
+      b->Args({size, mode});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(DocumentStore_Get)->Apply(DocumentSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DocumentStore_Set)->Apply(DocumentSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DocumentStore_ConvertToExtents)
+    ->Args({16 << 10, 0})
+    ->Args({64 << 10, 0})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/document_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage_bench_common.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage::benchmarks;
+
+using fetch::storage::ResourceID;
+
+using DocumentStore = fetch::storage::DocumentStore<2048>;
+using ResourceIDs   = std::vector<ResourceID>;
+
+constexpr std::size_t NUM_DOCUMENTS = 1024;
+
+ResourceIDs Populate(DocumentStore &store, Distribution distribution, std::size_t document_size)
+{
+  store.New("doc_store_bench.db", "doc_store_bench.diff.db", "doc_store_bench.index.db",
+            "doc_store_bench.index.diff.db");
+
+  LinearCongruentialGenerator rng;
+  auto const                  value = RandomBytes(rng, document_size);
+
+  ResourceIDs ids;
+  for (auto const &key : GenerateKeys(NUM_DOCUMENTS, distribution))
+  {
+    ids.emplace_back(key);
+    store.Set(ids.back(), value);
+  }
+
+  store.Flush(false);
+
+  return ids;
+}
+
+// Arguments: distribution, document size
+void DocumentStore_Set(benchmark::State &state)
+{
+  auto const distribution  = static_cast<Distribution>(state.range(0));
+  auto const document_size = static_cast<std::size_t>(state.range(1));
+
+  DocumentStore store;
+  auto const    ids = Populate(store, distribution, document_size);
+
+  LinearCongruentialGenerator rng;
+  KeySampler                  sampler{distribution, ids.size()};
+  OperationRecorder           recorder;
+  auto const                  value = RandomBytes(rng, document_size);
+
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+    store.Set(ids[sampler()], value);
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * document_size));
+  recorder.Report(state);
+}
+
+// Arguments: distribution, document size
+void DocumentStore_Get(benchmark::State &state)
+{
+  auto const distribution  = static_cast<Distribution>(state.range(0));
+  auto const document_size = static_cast<std::size_t>(state.range(1));
+
+  DocumentStore store;
+  auto const    ids = Populate(store, distribution, document_size);
+
+  KeySampler        sampler{distribution, ids.size()};
+  OperationRecorder recorder;
+
+  for (auto _ : state)
+  {
+    auto const start    = recorder.Start();
+    auto       document = store.Get(ids[sampler()]);
+    benchmark::DoNotOptimize(document.document.pointer());
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * document_size));
+  recorder.Report(state);
+}
+
+// Arguments: distribution, document size
+void Arguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t distribution : {0, 1, 2})
+  {
+    for (int64_t size : {64, 1024, 16384})
+    {
+      b->Args({distribution, size});
+    }
+  }
+}
+
+}  // namespace
+
+// commit and revert cycles are covered by the NewRevertibleDocumentStore benchmarks
+BENCHMARK(DocumentStore_Set)->Apply(Arguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DocumentStore_Get)->Apply(Arguments)->Unit(benchmark::kMicrosecond);
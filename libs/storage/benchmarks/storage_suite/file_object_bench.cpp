@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/file_object.hpp"
+#include "storage_bench_common.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage::benchmarks;
+
+using FileObject     = fetch::storage::FileObject<>;
+using AllocationMode = FileObject::AllocationMode;
+using FileIds        = std::vector<uint64_t>;
+
+constexpr std::size_t NUM_FILES = 256;
+
+FileIds Populate(FileObject &file_object, benchmark::State const &state)
+{
+  auto const file_size = static_cast<std::size_t>(state.range(1));
+
+  file_object.New("file_object_bench.db", "file_object_bench.history.db");
+  file_object.SetAllocationMode(state.range(2) != 0 ? AllocationMode::EXTENT
+                                                     : AllocationMode::LINKED);
+
+  LinearCongruentialGenerator rng;
+  auto const                  value = RandomBytes(rng, file_size);
+
+  FileIds ids;
+  for (std::size_t i = 0; i < NUM_FILES; ++i)
+  {
+    file_object.CreateNewFile(file_size);
+    file_object.Write(value);
+    ids.push_back(file_object.id());
+  }
+
+  file_object.Flush();
+
+  return ids;
+}
+
+// Arguments: distribution, file size, allocation mode (0 = linked, 1 = extent)
+void FileObject_Write(benchmark::State &state)
+{
+  auto const distribution = static_cast<Distribution>(state.range(0));
+  auto const file_size    = static_cast<std::size_t>(state.range(1));
+
+  FileObject file_object;
+  auto       ids = Populate(file_object, state);
+
+  LinearCongruentialGenerator rng;
+  KeySampler                  sampler{distribution, ids.size()};
+  OperationRecorder           recorder;
+  auto const                  value = RandomBytes(rng, file_size);
+
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+
+    auto &id = ids[sampler()];
+    file_object.SeekFile(id);
+    file_object.Resize(file_size);
+    file_object.Write(value);
+    file_object.Flush();
+
+    // the file may have been relocated by the resize
+    id = file_object.id();
+
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file_size));
+  recorder.Report(state);
+}
+
+// Arguments: distribution, file size, allocation mode (0 = linked, 1 = extent)
+void FileObject_Read(benchmark::State &state)
+{
+  auto const distribution = static_cast<Distribution>(state.range(0));
+  auto const file_size    = static_cast<std::size_t>(state.range(1));
+
+  FileObject file_object;
+  auto const ids = Populate(file_object, state);
+
+  KeySampler        sampler{distribution, ids.size()};
+  OperationRecorder recorder;
+
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+
+    file_object.SeekFile(ids[sampler()]);
+    auto document = file_object.AsDocument();
+    benchmark::DoNotOptimize(document.document.pointer());
+
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file_size));
+  recorder.Report(state);
+}
+
+// Arguments: distribution, file size, allocation mode
+void Arguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t mode : {0, 1})
+  {
+    for (int64_t distribution : {0, 1, 2})
+    {
+      for (int64_t size : {256, 4096, 65536})
+      {
+        b->Args({distribution, size, mode});
+      }
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(FileObject_Write)->Apply(Arguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(FileObject_Read)->Apply(Arguments)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/key_value_index.hpp"
+#include "storage_bench_common.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage::benchmarks;
+
+using fetch::storage::KeyValueIndex;
+using fetch::storage::KeyValuePair;
+
+using Index = KeyValueIndex<KeyValuePair<>>;
+
+constexpr std::size_t NUM_KEYS = 1u << 14u;
+
+void Populate(Index &index, std::vector<ConstByteArray> const &keys)
+{
+  index.New("kvi_bench.db", "kvi_bench.history.db");
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    index.Set(keys[i], i, keys[i]);
+  }
+
+  index.Flush(false);
+}
+
+// Arguments: distribution, commit every N writes (0 = never)
+void KeyValueIndex_Set(benchmark::State &state)
+{
+  auto const distribution = static_cast<Distribution>(state.range(0));
+  auto const commit_every = static_cast<std::size_t>(state.range(1));
+  auto const keys         = GenerateKeys(NUM_KEYS, distribution);
+
+  Index index;
+  Populate(index, keys);
+
+  KeySampler        sampler{distribution, keys.size()};
+  OperationRecorder recorder;
+  uint64_t          value{0};
+  std::size_t       writes{0};
+
+  for (auto _ : state)
+  {
+    auto const  start = recorder.Start();
+    auto const &key   = keys[sampler()];
+
+    index.Set(key, ++value, key);
+
+    if ((commit_every != 0) && ((++writes % commit_every) == 0))
+    {
+      index.Commit();
+    }
+
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  recorder.Report(state);
+}
+
+// Arguments: distribution
+void KeyValueIndex_Get(benchmark::State &state)
+{
+  auto const distribution = static_cast<Distribution>(state.range(0));
+  auto const keys         = GenerateKeys(NUM_KEYS, distribution);
+
+  Index index;
+  Populate(index, keys);
+
+  KeySampler        sampler{distribution, keys.size()};
+  OperationRecorder recorder;
+  Index::IndexType  value{0};
+
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+    benchmark::DoNotOptimize(index.GetIfExists(keys[sampler()], value));
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  recorder.Report(state);
+}
+
+// Arguments: revert depth (in commits), writes per commit
+void KeyValueIndex_Revert(benchmark::State &state)
+{
+  auto const depth             = static_cast<std::size_t>(state.range(0));
+  auto const writes_per_commit = static_cast<std::size_t>(state.range(1));
+  auto const keys              = GenerateKeys(NUM_KEYS, Distribution::UNIFORM);
+
+  Index index;
+  Populate(index, keys);
+
+  KeySampler        sampler{Distribution::UNIFORM, keys.size()};
+  OperationRecorder recorder;
+  uint64_t          value{0};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    recorder.Pause();
+    auto const bookmark = index.Commit();
+    for (std::size_t commit = 0; commit < depth; ++commit)
+    {
+      for (std::size_t write = 0; write < writes_per_commit; ++write)
+      {
+        auto const &key = keys[sampler()];
+        index.Set(key, ++value, key);
+      }
+
+      index.Commit();
+    }
+    recorder.Resume();
+    state.ResumeTiming();
+
+    auto const start = recorder.Start();
+    index.Revert(bookmark);
+    recorder.Stop(start);
+  }
+
+  recorder.Report(state);
+}
+
+void DistributionsAndCommits(benchmark::internal::Benchmark *b)
+{
+  for (int64_t distribution : {0, 1, 2})
+  {
+    for (int64_t commit_every : {0, 100, 1000})
+    {
+      b->Args({distribution, commit_every});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(KeyValueIndex_Set)->Apply(DistributionsAndCommits)->Unit(benchmark::kMicrosecond);
+BENCHMARK(KeyValueIndex_Get)->DenseRange(0, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK(KeyValueIndex_Revert)
+    ->Args({1, 100})
+    ->Args({10, 100})
+    ->Args({100, 100})
+    ->Unit(benchmark::kMicrosecond);
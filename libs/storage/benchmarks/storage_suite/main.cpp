@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "benchmark/benchmark.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+
+/**
+ * The suite creates its store files in the current directory. Set FETCH_STORAGE_BENCH_DIR to run
+ * it from a tmpfs mount (e.g. /dev/shm) or a specific disk instead. Changing directory, rather
+ * than passing full paths, is needed since some stores derive companion filenames by prefixing
+ * the path they are given.
+ */
+int main(int argc, char **argv)
+{
+  char const *directory = std::getenv("FETCH_STORAGE_BENCH_DIR");
+
+  if ((directory != nullptr) && (*directory != '\0') && (chdir(directory) != 0))
+  {
+    std::cerr << "Unable to change to the benchmark directory: " << directory << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    return EXIT_FAILURE;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  return EXIT_SUCCESS;
+}
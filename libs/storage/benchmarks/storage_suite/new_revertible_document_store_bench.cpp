@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage_bench_common.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage::benchmarks;
+
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceID;
+
+using ResourceIDs = std::vector<ResourceID>;
+
+constexpr std::size_t NUM_DOCUMENTS = 1024;
+
+ResourceIDs Populate(NewRevertibleDocumentStore &store, Distribution distribution,
+                     std::size_t document_size)
+{
+  store.New("rev_doc_store_bench.db", "rev_doc_store_bench.history.db",
+            "rev_doc_store_bench.index.db", "rev_doc_store_bench.index.history.db", true);
+
+  LinearCongruentialGenerator rng;
+  auto const                  value = RandomBytes(rng, document_size);
+
+  ResourceIDs ids;
+  for (auto const &key : GenerateKeys(NUM_DOCUMENTS, distribution))
+  {
+    ids.emplace_back(key);
+    store.Set(ids.back(), value);
+  }
+
+  store.Commit();
+
+  return ids;
+}
+
+// Arguments: distribution, document size, commit every N writes
+void NewRevertibleDocumentStore_Set(benchmark::State &state)
+{
+  auto const distribution  = static_cast<Distribution>(state.range(0));
+  auto const document_size = static_cast<std::size_t>(state.range(1));
+  auto const commit_every  = static_cast<std::size_t>(state.range(2));
+
+  NewRevertibleDocumentStore store;
+  auto const                 ids = Populate(store, distribution, document_size);
+
+  LinearCongruentialGenerator rng;
+  KeySampler                  sampler{distribution, ids.size()};
+  OperationRecorder           recorder;
+  auto const                  value = RandomBytes(rng, document_size);
+  std::size_t                 writes{0};
+
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+
+    store.Set(ids[sampler()], value);
+
+    if ((++writes % commit_every) == 0)
+    {
+      store.Commit();
+    }
+
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * document_size));
+  recorder.Report(state);
+}
+
+// Arguments: distribution, document size, writes per commit
+void NewRevertibleDocumentStore_Commit(benchmark::State &state)
+{
+  auto const distribution      = static_cast<Distribution>(state.range(0));
+  auto const document_size     = static_cast<std::size_t>(state.range(1));
+  auto const writes_per_commit = static_cast<std::size_t>(state.range(2));
+
+  NewRevertibleDocumentStore store;
+  auto const                 ids = Populate(store, distribution, document_size);
+
+  LinearCongruentialGenerator rng;
+  KeySampler                  sampler{distribution, ids.size()};
+  OperationRecorder           recorder;
+  auto const                  value = RandomBytes(rng, document_size);
+
+  // each sample covers a block worth of writes followed by the commit
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+
+    for (std::size_t i = 0; i < writes_per_commit; ++i)
+    {
+      store.Set(ids[sampler()], value);
+    }
+
+    benchmark::DoNotOptimize(store.Commit());
+
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * writes_per_commit));
+  recorder.Report(state, writes_per_commit);
+}
+
+// Arguments: revert depth (in commits), writes per commit
+void NewRevertibleDocumentStore_Revert(benchmark::State &state)
+{
+  auto const depth             = static_cast<std::size_t>(state.range(0));
+  auto const writes_per_commit = static_cast<std::size_t>(state.range(1));
+  auto const document_size     = std::size_t{256};
+
+  NewRevertibleDocumentStore store;
+  auto const                 ids = Populate(store, Distribution::UNIFORM, document_size);
+
+  LinearCongruentialGenerator rng;
+  KeySampler                  sampler{Distribution::UNIFORM, ids.size()};
+  OperationRecorder           recorder;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    recorder.Pause();
+    auto const target = store.Commit();
+    for (std::size_t commit = 0; commit < depth; ++commit)
+    {
+      for (std::size_t write = 0; write < writes_per_commit; ++write)
+      {
+        store.Set(ids[sampler()], RandomBytes(rng, document_size));
+      }
+
+      store.Commit();
+    }
+    recorder.Resume();
+    state.ResumeTiming();
+
+    auto const start = recorder.Start();
+    benchmark::DoNotOptimize(store.RevertToHash(target));
+    recorder.Stop(start);
+  }
+
+  recorder.Report(state);
+}
+
+void SetArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t distribution : {0, 1, 2})
+  {
+    for (int64_t size : {64, 1024, 16384})
+    {
+      for (int64_t commit_every : {100, 1000})
+      {
+        b->Args({distribution, size, commit_every});
+      }
+    }
+  }
+}
+
+void CommitArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t distribution : {0, 1, 2})
+  {
+    for (int64_t writes_per_commit : {10, 100, 1000})
+    {
+      b->Args({distribution, 256, writes_per_commit});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(NewRevertibleDocumentStore_Set)->Apply(SetArguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(NewRevertibleDocumentStore_Commit)
+    ->Apply(CommitArguments)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(NewRevertibleDocumentStore_Revert)
+    ->Args({1, 100})
+    ->Args({10, 100})
+    ->Args({50, 100})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/object_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage_bench_common.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage::benchmarks;
+
+using fetch::storage::ObjectStore;
+using fetch::storage::ResourceID;
+
+using Store       = ObjectStore<ConstByteArray>;
+using ResourceIDs = std::vector<ResourceID>;
+
+constexpr std::size_t NUM_OBJECTS = 1024;
+
+ResourceIDs Populate(Store &store, Distribution distribution, std::size_t object_size)
+{
+  store.New("object_store_bench.db", "object_store_bench.index.db");
+
+  LinearCongruentialGenerator rng;
+  ConstByteArray const        value = RandomBytes(rng, object_size);
+
+  ResourceIDs ids;
+  for (auto const &key : GenerateKeys(NUM_OBJECTS, distribution))
+  {
+    ids.emplace_back(key);
+    store.Set(ids.back(), value);
+  }
+
+  store.Flush(false);
+
+  return ids;
+}
+
+// Arguments: distribution, object size
+void ObjectStore_Set(benchmark::State &state)
+{
+  auto const distribution = static_cast<Distribution>(state.range(0));
+  auto const object_size  = static_cast<std::size_t>(state.range(1));
+
+  Store      store;
+  auto const ids = Populate(store, distribution, object_size);
+
+  LinearCongruentialGenerator rng;
+  KeySampler                  sampler{distribution, ids.size()};
+  OperationRecorder           recorder;
+  ConstByteArray const        value = RandomBytes(rng, object_size);
+
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+    store.Set(ids[sampler()], value);
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * object_size));
+  recorder.Report(state);
+}
+
+// Arguments: distribution, object size
+void ObjectStore_Get(benchmark::State &state)
+{
+  auto const distribution = static_cast<Distribution>(state.range(0));
+  auto const object_size  = static_cast<std::size_t>(state.range(1));
+
+  Store      store;
+  auto const ids = Populate(store, distribution, object_size);
+
+  KeySampler        sampler{distribution, ids.size()};
+  OperationRecorder recorder;
+  ConstByteArray    object;
+
+  for (auto _ : state)
+  {
+    auto const start = recorder.Start();
+    benchmark::DoNotOptimize(store.Get(ids[sampler()], object));
+    recorder.Stop(start);
+  }
+
+  state.SetLabel(ToString(distribution));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * object_size));
+  recorder.Report(state);
+}
+
+void Arguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t distribution : {0, 1, 2})
+  {
+    for (int64_t size : {64, 1024, 16384})
+    {
+      b->Args({distribution, size});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(ObjectStore_Set)->Apply(Arguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ObjectStore_Get)->Apply(Arguments)->Unit(benchmark::kMicrosecond);
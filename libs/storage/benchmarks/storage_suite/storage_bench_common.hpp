@@ -0,0 +1,266 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+namespace benchmarks {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+using random::LinearCongruentialGenerator;
+
+/**
+ * The access patterns the stores are driven with
+ */
+enum class Distribution : int64_t
+{
+  UNIFORM    = 0,  ///< Every key is equally likely
+  ZIPFIAN    = 1,  ///< A small set of hot keys receives most of the accesses
+  SEQUENTIAL = 2   ///< Keys are visited in digest order, i.e. neighbouring subtrees
+};
+
+inline char const *ToString(Distribution distribution)
+{
+  switch (distribution)
+  {
+  case Distribution::UNIFORM:
+    return "uniform";
+  case Distribution::ZIPFIAN:
+    return "zipfian";
+  case Distribution::SEQUENTIAL:
+    return "sequential";
+  }
+
+  return "unknown";
+}
+
+/**
+ * Generate a set of distinct 256 bit keys (the digests of their index). For sequential access the
+ * keys are ordered by digest, so that consecutive accesses land in neighbouring subtrees.
+ *
+ * @param count The number of keys
+ * @param distribution The distribution the keys will be accessed with
+ * @return The generated keys
+ */
+inline std::vector<ConstByteArray> GenerateKeys(std::size_t count, Distribution distribution)
+{
+  std::vector<ConstByteArray> keys;
+  keys.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    keys.emplace_back(crypto::Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  if (distribution == Distribution::SEQUENTIAL)
+  {
+    std::sort(keys.begin(), keys.end());
+  }
+
+  return keys;
+}
+
+inline ByteArray RandomBytes(LinearCongruentialGenerator &rng, std::size_t size)
+{
+  ByteArray bytes;
+  bytes.Resize(size);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    bytes[i] = static_cast<uint8_t>(rng());
+  }
+
+  return bytes;
+}
+
+/**
+ * Picks key indices in [0, count) according to a distribution
+ */
+class KeySampler
+{
+public:
+  static constexpr double ZIPF_EXPONENT = 0.99;
+
+  KeySampler(Distribution distribution, std::size_t count)
+    : distribution_{distribution}
+    , count_{count}
+  {
+    if (distribution_ == Distribution::ZIPFIAN)
+    {
+      // precompute the cumulative distribution over the key ranks
+      cdf_.resize(count_);
+
+      double total{0};
+      for (std::size_t i = 0; i < count_; ++i)
+      {
+        total += 1.0 / std::pow(static_cast<double>(i + 1), ZIPF_EXPONENT);
+        cdf_[i] = total;
+      }
+
+      for (auto &value : cdf_)
+      {
+        value /= total;
+      }
+    }
+  }
+
+  std::size_t operator()()
+  {
+    switch (distribution_)
+    {
+    case Distribution::UNIFORM:
+      return rng_() % count_;
+    case Distribution::ZIPFIAN:
+    {
+      // keys are generated from their index, so the hot keys are scattered over the key space
+      auto const it = std::lower_bound(cdf_.begin(), cdf_.end(), rng_.AsDouble());
+      return std::min(static_cast<std::size_t>(it - cdf_.begin()), count_ - 1);
+    }
+    case Distribution::SEQUENTIAL:
+      return (next_++) % count_;
+    }
+
+    return 0;
+  }
+
+private:
+  Distribution                distribution_;
+  std::size_t                 count_;
+  std::size_t                 next_{0};
+  std::vector<double>         cdf_;
+  LinearCongruentialGenerator rng_;
+};
+
+/**
+ * Records the latency of the individual operations of a benchmark along with the number of bytes
+ * the process wrote while executing them. Setup work between operations can be excluded from the
+ * byte count with Pause / Resume.
+ */
+class OperationRecorder
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timestamp = Clock::time_point;
+
+  OperationRecorder()
+    : resume_bytes_written_{BytesWritten()}
+  {}
+
+  Timestamp Start() const
+  {
+    return Clock::now();
+  }
+
+  void Stop(Timestamp const &start)
+  {
+    latencies_.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+  }
+
+  void Pause()
+  {
+    bytes_written_ += BytesWritten() - resume_bytes_written_;
+  }
+
+  void Resume()
+  {
+    resume_bytes_written_ = BytesWritten();
+  }
+
+  /**
+   * Publish the p50 / p99 latencies (in microseconds) and bytes written per operation
+   *
+   * @param state The benchmark state to be updated
+   * @param ops_per_sample The number of store operations covered by each recorded latency
+   */
+  void Report(benchmark::State &state, std::size_t ops_per_sample = 1)
+  {
+    if (latencies_.empty())
+    {
+      return;
+    }
+
+    double const ops = static_cast<double>(latencies_.size() * ops_per_sample);
+
+    state.counters["p50_us"] = Percentile(0.50);
+    state.counters["p99_us"] = Percentile(0.99);
+    Pause();
+    state.counters["bytes_written_per_op"] = static_cast<double>(bytes_written_) / ops;
+    state.counters["ops"]                  = benchmark::Counter(ops, benchmark::Counter::kIsRate);
+  }
+
+private:
+  double Percentile(double fraction)
+  {
+    auto const index =
+        static_cast<std::size_t>(fraction * static_cast<double>(latencies_.size() - 1));
+
+    std::nth_element(latencies_.begin(), latencies_.begin() + static_cast<std::ptrdiff_t>(index),
+                     latencies_.end());
+
+    return latencies_[index];
+  }
+
+  /**
+   * The number of bytes passed to write calls by this process. Page cache writes are counted, so
+   * the figure is comparable between tmpfs and disk, but stores writing through a memory mapping
+   * only report their stream based files.
+   */
+  static uint64_t BytesWritten()
+  {
+    std::ifstream io{"/proc/self/io"};
+
+    std::string key;
+    uint64_t    value{0};
+    while (io >> key >> value)
+    {
+      if (key == "wchar:")
+      {
+        return value;
+      }
+    }
+
+    return 0;
+  }
+
+  uint64_t            resume_bytes_written_;
+  uint64_t            bytes_written_{0};
+  std::vector<double> latencies_;
+};
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace fetch
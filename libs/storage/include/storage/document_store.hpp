@@ -41,6 +41,10 @@ namespace storage {
  * to locations
  * in the document store
  *
+ * Documents are allocated as extents (contiguous runs of blocks) so that they can be read back
+ * with a single read of the underlying file. Stores written with linked allocation can be
+ * upgraded in place with ConvertToExtents.
+ *
  */
 template <std::size_t BLOCK_SIZE = 2048, typename A = FileBlockType<BLOCK_SIZE>,
           typename B = KeyValueIndex<>, typename C = VersionedRandomAccessStack<A>,
@@ -63,7 +67,11 @@ public:
 
   static constexpr char const *LOGGING_NAME = "DocumentStore";
 
-  DocumentStore()                         = default;
+  DocumentStore()
+  {
+    file_object_.SetAllocationMode(FileObjectType::AllocationMode::EXTENT);
+  }
+
   DocumentStore(DocumentStore const &rhs) = delete;
   DocumentStore(DocumentStore &&rhs)      = delete;
   DocumentStore &operator=(DocumentStore const &rhs) = delete;
@@ -181,6 +189,48 @@ public:
     file_object_.Flush();
   }
 
+  void SetAllocationMode(typename FileObjectType::AllocationMode mode)
+  {
+    FETCH_LOCK(mutex_);
+    file_object_.SetAllocationMode(mode);
+  }
+
+  /**
+   * Migrate all documents which are not stored as a single extent, updating the key index to
+   * their new locations.
+   *
+   * @return: The number of documents that were moved
+   */
+  std::size_t ConvertToExtents()
+  {
+    FETCH_LOCK(mutex_);
+
+    // Collect the locations first, since updating the index invalidates its iterators
+    std::vector<std::pair<byte_array::ConstByteArray, IndexType>> locations;
+    for (auto it = key_index_.begin(); it != key_index_.end(); ++it)
+    {
+      auto kv = *it;
+      locations.emplace_back(kv.first, kv.second);
+    }
+
+    std::size_t moved{0};
+    for (auto const &location : locations)
+    {
+      file_object_.SeekFile(location.second);
+
+      if (file_object_.MakeContiguous())
+      {
+        key_index_.Set(location.first, file_object_.id(), file_object_.Hash());
+        ++moved;
+      }
+    }
+
+    file_object_.Flush();
+    key_index_.Flush();
+
+    return moved;
+  }
+
   void Flush(bool lazy = true)
   {
     FETCH_LOCK(mutex_);
@@ -46,6 +46,15 @@ public:
 
   static constexpr char const *LOGGING_NAME = "RevertibleDocumentStoreProtocol";
 
+  /// @name Handler signatures (for in-process calls)
+  /// @{
+  using GetSignature         = Document(ResourceID const &);
+  using GetOrCreateSignature = Document(ResourceID const &);
+  using SetSignature         = void(ResourceID const &, byte_array::ConstByteArray const &);
+  using LockSignature        = bool(CallContext const &);
+  using UnlockSignature      = bool(CallContext const &);
+  /// @}
+
   enum
   {
     GET = 0,
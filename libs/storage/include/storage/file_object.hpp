@@ -95,6 +95,12 @@ struct FileBlockType
  * The free block list is ordered, and files are ordered, to be incrementing in memory. This is
  * in order to reduce programmer error.
  *
+ * In EXTENT allocation mode every file is additionally kept in a single contiguous run of blocks
+ * (an extent). Files that are not contiguous, for example those written in LINKED mode, are
+ * relocated into a new extent the next time they grow, or explicitly via MakeContiguous.
+ * Note that relocation changes the id of the file. Reads of contiguous files are served with a
+ * single bulk read of the stack and never write back to it, irrespective of the allocation mode.
+ *
  */
 template <typename S = VersionedRandomAccessStack<FileBlockType<>>>
 class FileObject
@@ -106,6 +112,12 @@ public:
 
   static constexpr char const *LOGGING_NAME = "FileObject";
 
+  enum class AllocationMode
+  {
+    LINKED,  ///< Blocks are taken from anywhere in the free list
+    EXTENT   ///< Files always occupy a contiguous run of blocks
+  };
+
   FileObject(FileObject const &other) = delete;
   FileObject operator=(FileObject const &other) = delete;
   FileObject(FileObject &&other)                = default;  // NOLINT
@@ -163,6 +175,12 @@ public:
 
   bool VerifyConsistency(std::vector<uint64_t> const &ids);
 
+  void           SetAllocationMode(AllocationMode mode);
+  AllocationMode allocation_mode() const;
+
+  bool IsContiguous();
+  bool MakeContiguous();
+
   StackType *stack();
   StackType &underlying_stack();
 
@@ -186,6 +204,9 @@ private:
   uint64_t length_            = 0;  // length in bytes of file.
                                     // can be found from Get(id) right - any point in keeping?
 
+  AllocationMode         allocation_mode_ = AllocationMode::LINKED;
+  std::vector<BlockType> bulk_blocks_;  // scratch space for bulk reads of contiguous files
+
   // TODO(private 1067): BlockType -> BlockType etc.
   // TODO(private 1067): possibly some performance benefits by caching blocks like the free block
   // here
@@ -201,12 +222,22 @@ private:
 
   uint64_t GetFreeBlocks(uint64_t min_index, uint64_t num);
 
+  uint64_t GetFreeExtent(uint64_t min_index, uint64_t num);
+
   uint64_t FreeBlocks();
 
   void FreeBlocksInList(uint64_t remove_index);
 
   void ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action action);
 
+  bool ReadContiguous(uint8_t *bytes, uint64_t num);
+
+  bool GetContiguousBlocks(uint64_t index, uint64_t num);
+
+  void Relocate(uint64_t size);
+
+  static uint64_t BlocksForSize(uint64_t size);
+
   void Get(uint64_t index, BlockType &block);
 
   void Set(uint64_t index, BlockType const &block);
@@ -270,9 +301,31 @@ uint64_t FileObject<S>::Tell() const
   return byte_index_global_;
 }
 
+/**
+ * Resize the current file, preserving its contents up to the new size. In EXTENT mode a file that
+ * needs to grow but cannot do so in place is moved to a new extent and so receives a new id.
+ *
+ * @param: size The new size of the file in bytes
+ */
 template <typename S>
 void FileObject<S>::Resize(uint64_t size)
 {
+  auto const current_blocks = BlocksForSize(length_);
+  auto const target_blocks  = BlocksForSize(size);
+
+  if (allocation_mode_ == AllocationMode::EXTENT && target_blocks > current_blocks)
+  {
+    // A file can only grow in place when it is a single extent at the end of the stack, since
+    // that is where new blocks are appended
+    bool const at_end_of_stack = id_ + current_blocks == stack_.size();
+
+    if (!at_end_of_stack || !GetContiguousBlocks(id_, current_blocks))
+    {
+      Relocate(size);
+      return;
+    }
+  }
+
   // Reset variables which might otherwise point to invalid locations
   Seek(0);
   BlockType block;
@@ -286,11 +339,13 @@ void FileObject<S>::Resize(uint64_t size)
     length_ = size;
   }
 
-  // Traverse the blocks until the target blocks criteria is fulfilled.
-  auto target_blocks = platform::DivideCeil<uint64_t>(size, BlockType::CAPACITY);
+  // The block list itself is already the right length
+  if (target_blocks == current_blocks)
+  {
+    return;
+  }
 
-  // corner case when size is 0 - we need at least one block per file
-  target_blocks = target_blocks == 0 ? 1 : target_blocks;
+  // Traverse the blocks until the target blocks criteria is fulfilled.
 
   uint64_t block_number = 1;
   uint64_t block_index  = id_;
@@ -379,12 +434,14 @@ void FileObject<S>::ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action a
       break;
     case Action::WRITE:
       memcpy(block_being_written.data + byte_index_, bytes + bytes_offset, bytes_to_write_in_block);
+
+      // Write block back. Reads must not do this, as on versioned stacks every Set is recorded
+      // in the history
+      Set(block_index_being_written, block_being_written);
       break;
     }
 
-    // Write block back
-    byte_index_ = 0;
-    Set(block_index_being_written, block_being_written);
+    byte_index_               = 0;
     block_index_being_written = block_being_written.next;
 
     bytes_offset += bytes_to_write_in_block;
@@ -410,7 +467,164 @@ void FileObject<S>::Read(byte_array::ByteArray &arr)
 template <typename S>
 void FileObject<S>::Read(uint8_t *bytes, uint64_t m)
 {
-  ReadWriteHelper(bytes, m, Action::READ);
+  if (!ReadContiguous(bytes, m))
+  {
+    ReadWriteHelper(bytes, m, Action::READ);
+  }
+}
+
+/**
+ * Attempt to serve a read from the current position with a single bulk read of the stack. This
+ * only succeeds when the blocks being read are laid out contiguously, otherwise the caller has to
+ * fall back to following the block list.
+ *
+ * @param: bytes The buffer to read into
+ * @param: num The number of bytes to read
+ *
+ * @return: Whether the read was performed
+ */
+template <typename S>
+bool FileObject<S>::ReadContiguous(uint8_t *bytes, uint64_t num)
+{
+  if (num == 0)
+  {
+    return false;
+  }
+
+  auto const num_blocks = platform::DivideCeil<uint64_t>(byte_index_ + num, BlockType::CAPACITY);
+
+  if (!GetContiguousBlocks(block_index_, num_blocks))
+  {
+    return false;
+  }
+
+  uint64_t bytes_offset = 0;
+  uint64_t byte_index   = byte_index_;
+
+  for (uint64_t i = 0; i < num_blocks; ++i)
+  {
+    uint64_t const bytes_in_block = std::min(BlockType::CAPACITY - byte_index, num - bytes_offset);
+
+    memcpy(bytes + bytes_offset, bulk_blocks_[i].data + byte_index, bytes_in_block);
+
+    bytes_offset += bytes_in_block;
+    byte_index = 0;
+  }
+
+  byte_index_ = 0;
+
+  return true;
+}
+
+/**
+ * Bulk read num blocks starting at index into the scratch buffer, and check that they form a
+ * contiguous run of the block list.
+ *
+ * @param: index The location of the first block on the stack
+ * @param: num The number of blocks
+ *
+ * @return: Whether the blocks are contiguous
+ */
+template <typename S>
+bool FileObject<S>::GetContiguousBlocks(uint64_t index, uint64_t num)
+{
+  if (index == BlockType::UNDEFINED || num == 0 || index + num > stack_.size())
+  {
+    return false;
+  }
+
+  bulk_blocks_.resize(num);
+  stack_.GetBulk(index, num, bulk_blocks_.data());
+
+  for (uint64_t i = 0; i + 1 < num; ++i)
+  {
+    if (bulk_blocks_[i].next != index + i + 1)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Move the current file to a newly allocated extent of the given size, copying across as much of
+ * its contents as will fit. The file id changes as a result.
+ *
+ * @param: size The size of the file after relocation
+ */
+template <typename S>
+void FileObject<S>::Relocate(uint64_t size)
+{
+  byte_array::ByteArray contents;
+  contents.Resize(std::min(length_, size));
+
+  Seek(0);
+  Read(contents);
+
+  FreeBlocksInList(id_);
+
+  block_number_      = 0;
+  byte_index_        = 0;
+  byte_index_global_ = 0;
+  length_            = size;
+  block_index_ = id_ = GetFreeBlocks(1, BlocksForSize(size));
+
+  BlockType block;
+  Get(id_, block);
+  block.file_object_size = size;
+  Set(id_, block);
+
+  Write(contents);
+}
+
+template <typename S>
+uint64_t FileObject<S>::BlocksForSize(uint64_t size)
+{
+  auto const blocks = platform::DivideCeil<uint64_t>(size, BlockType::CAPACITY);
+
+  // corner case when size is 0 - we need at least one block per file
+  return blocks == 0 ? 1 : blocks;
+}
+
+template <typename S>
+void FileObject<S>::SetAllocationMode(AllocationMode mode)
+{
+  allocation_mode_ = mode;
+}
+
+template <typename S>
+typename FileObject<S>::AllocationMode FileObject<S>::allocation_mode() const
+{
+  return allocation_mode_;
+}
+
+/**
+ * Determine whether the current file occupies a single contiguous run of blocks
+ */
+template <typename S>
+bool FileObject<S>::IsContiguous()
+{
+  return GetContiguousBlocks(id_, BlocksForSize(length_));
+}
+
+/**
+ * Migrate the current file to a single extent if it is not one already. This is the upgrade path
+ * for files written in LINKED mode. Note the id of the file will change if it is moved.
+ *
+ * @return: Whether the file was moved
+ */
+template <typename S>
+bool FileObject<S>::MakeContiguous()
+{
+  if (IsContiguous())
+  {
+    return false;
+  }
+
+  Relocate(length_);
+
+  return true;
 }
 
 template <typename S>
@@ -478,12 +692,7 @@ void FileObject<S>::CreateNewFile(uint64_t size)
   byte_index_        = 0;
   byte_index_global_ = 0;
   length_            = size;
-  auto target_blocks = platform::DivideCeil<uint64_t>(size, BlockType::CAPACITY);
-
-  // corner case when size is 0 - we need at least one block per file
-  target_blocks = target_blocks == 0 ? 1 : target_blocks;
-
-  block_index_ = id_ = GetFreeBlocks(1, target_blocks);
+  block_index_ = id_ = GetFreeBlocks(1, BlocksForSize(size));
 
   BlockType block;
   Get(id_, block);
@@ -615,6 +824,12 @@ uint64_t FileObject<S>::GetFreeBlocks(uint64_t min_index, uint64_t num)
     return DefaultFreeAllocation(num);
   }
 
+  if (allocation_mode_ == AllocationMode::EXTENT)
+  {
+    uint64_t const extent = GetFreeExtent(min_index, num);
+    return (extent == BlockType::UNDEFINED) ? DefaultFreeAllocation(num) : extent;
+  }
+
   uint64_t index             = free_block.previous;  // Index of block in LL we wish to free
   uint64_t free_blocks_in_ll = 0;
 
@@ -673,6 +888,85 @@ uint64_t FileObject<S>::GetFreeBlocks(uint64_t min_index, uint64_t num)
   return DefaultFreeAllocation(num);
 }
 
+/**
+ * Cut the first run of adjacent free blocks which is long enough from the free list. Since the
+ * free list is ordered, adjacent blocks are also consecutive entries of the list.
+ *
+ * @param: min_index Lower bound on index
+ * @param: num The number of blocks required
+ *
+ * @return: Location on the stack of the first block, or UNDEFINED if there is no such run
+ */
+template <typename S>
+uint64_t FileObject<S>::GetFreeExtent(uint64_t min_index, uint64_t num)
+{
+  BlockType block;
+  Get(free_block_index_, block);
+
+  uint64_t run_start  = BlockType::UNDEFINED;
+  uint64_t run_length = 0;
+  uint64_t index      = block.next;
+
+  while (index != free_block_index_)
+  {
+    Get(index, block);
+
+    if (index >= min_index)
+    {
+      if ((run_length != 0) && (index == run_start + run_length))
+      {
+        ++run_length;
+      }
+      else
+      {
+        run_start  = index;
+        run_length = 1;
+      }
+
+      if (run_length == num)
+      {
+        break;
+      }
+    }
+
+    index = block.next;
+  }
+
+  if (run_length != num)
+  {
+    return BlockType::UNDEFINED;
+  }
+
+  uint64_t const run_end = run_start + num - 1;
+
+  // Terminate the run, which is already linked in order
+  Get(run_start, block);
+  uint64_t const index_prev = block.previous;
+  block.previous            = BlockType::UNDEFINED;
+  Set(run_start, block);
+
+  Get(run_end, block);
+  uint64_t const index_next = block.next;
+  block.next                = BlockType::UNDEFINED;
+  Set(run_end, block);
+
+  // Join the free blocks on either side, either of which might be the free block
+  Get(index_prev, block);
+  block.next = index_next;
+  Set(index_prev, block);
+
+  Get(index_next, block);
+  block.previous = index_prev;
+  Set(index_next, block);
+
+  Get(free_block_index_, block);
+  assert(block.free_blocks >= num);
+  block.free_blocks -= num;
+  Set(free_block_index_, block);
+
+  return run_start;
+}
+
 /**
  * Free blocks starting at index. We can't just append to the end of the free LL as we want to
  * maintain ordering.
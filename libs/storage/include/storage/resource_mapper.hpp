@@ -71,6 +71,7 @@ class ResourceAddress : public ResourceID
 {
 public:
   explicit ResourceAddress(byte_array::ConstByteArray const &address);
+  ResourceAddress(byte_array::ConstByteArray const &address, ResourceID const &group);
   explicit ResourceAddress(ResourceID const &rid);
 
   ResourceAddress() = default;
@@ -340,6 +340,15 @@ public:
     stack_.Get(i, object);
   }
 
+  /**
+   * Read a run of elements straight from the underlying stack. Reads are never recorded in the
+   * history.
+   */
+  void GetBulk(std::size_t i, std::size_t elements, type *objects)
+  {
+    stack_.GetBulk(i, elements, objects);
+  }
+
   void Set(std::size_t i, type const &object)
   {
     type old_data;
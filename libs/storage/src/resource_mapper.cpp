@@ -24,12 +24,28 @@
 #include "crypto/sha256.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <cstring>
 #include <limits>
 #include <type_traits>
 #include <utility>
 
 namespace fetch {
 namespace storage {
+namespace {
+
+byte_array::ConstByteArray GroupedId(byte_array::ConstByteArray const &address,
+                                     ResourceID const &                group)
+{
+  byte_array::ByteArray id{crypto::Hash<crypto::SHA256>(address)};
+
+  auto const group_id = group.id();
+  assert(group_id.size() >= sizeof(ResourceID::Group));
+  std::memcpy(id.pointer(), group_id.pointer(), sizeof(ResourceID::Group));
+
+  return {id};
+}
+
+}  // namespace
 
 /**
  * Constructs a Resource ID from an input hashed array
@@ -101,6 +117,19 @@ ResourceAddress::ResourceAddress(byte_array::ConstByteArray const &address)
   , address_{address}
 {}
 
+/**
+ * Constructs a Resource Address which belongs to the same resource group, and therefore the same
+ * lane, as another resource. The remainder of the id is derived from the address as usual.
+ *
+ * @param address The canonical resource address
+ * @param group The resource whose group is to be shared
+ */
+ResourceAddress::ResourceAddress(byte_array::ConstByteArray const &address,
+                                 ResourceID const &               group)
+  : ResourceID(GroupedId(address, group))
+  , address_{address}
+{}
+
 ResourceAddress::ResourceAddress(ResourceID const &rid)
   : ResourceID(rid)
 {}
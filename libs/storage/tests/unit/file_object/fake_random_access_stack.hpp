@@ -65,7 +65,7 @@ public:
     for (std::size_t increment = 0; increment < elements; ++increment)
     {
       ThrowOnBadAccess(i + increment, "SetBulk");
-      Set(i + increment, objects[i]);
+      Set(i + increment, objects[increment]);
     }
   }
 
@@ -81,7 +81,7 @@ public:
     for (std::size_t increment = 0; increment < elements; ++increment)
     {
       ThrowOnBadAccess(i + increment, "GetBulk");
-      Set(i + increment, objects[i]);
+      Get(i + increment, objects[increment]);
     }
   }
 
@@ -309,3 +309,152 @@ TEST_F(FileObjectTests, HashFiles)
 
   ASSERT_EQ(file_object_->Hash(), crypto::Hash<crypto::SHA256>(new_string));
 }
+
+TEST_F(FileObjectTests, ExtentFilesAreContiguousAfterResizing)
+{
+  file_object_->New("test");
+  file_object_->SetAllocationMode(FileObjectM::AllocationMode::EXTENT);
+
+  std::unordered_map<uint64_t, std::string> file_ids;
+
+  for (std::size_t i = 0; i < 50; ++i)
+  {
+    auto new_string = GetStringForTesting();
+
+    file_object_->CreateNewFile();
+    file_object_->Resize(new_string.size());
+    file_object_->Write(new_string);
+
+    file_ids[file_object_->id()] = new_string;
+  }
+
+  // Grow and shrink every file so that files are relocated and blocks are freed and reused
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    std::unordered_map<uint64_t, std::string> updated_ids;
+
+    for (auto const &file : file_ids)
+    {
+      auto new_string = GetStringForTesting() + ((rng_() % 2) != 0u ? GetStringForTesting() : "");
+
+      file_object_->SeekFile(file.first);
+      file_object_->Resize(new_string.size());
+      file_object_->Write(new_string);
+
+      ASSERT_TRUE(file_object_->IsContiguous());
+      updated_ids[file_object_->id()] = new_string;
+    }
+
+    file_ids = std::move(updated_ids);
+  }
+
+  consistency_check_.clear();
+  for (auto const &file : file_ids)
+  {
+    consistency_check_.push_back(file.first);
+
+    file_object_->SeekFile(file.first);
+    ASSERT_TRUE(file_object_->IsContiguous());
+    ASSERT_EQ(std::string{file_object_->AsDocument().document}, file.second);
+  }
+
+  ASSERT_EQ(file_object_->VerifyConsistency(consistency_check_), true);
+}
+
+TEST_F(FileObjectTests, ExtentFilesReuseFreedBlocksWhenResized)
+{
+  file_object_->New("test");
+  file_object_->SetAllocationMode(FileObjectM::AllocationMode::EXTENT);
+
+  constexpr std::size_t NUM_FILES = 20;
+  constexpr uint64_t    MAX_SIZE  = 4 * FileObjectM::BlockType::CAPACITY;
+
+  std::vector<uint64_t> ids;
+  for (std::size_t i = 0; i < NUM_FILES; ++i)
+  {
+    file_object_->CreateNewFile();
+    ids.push_back(file_object_->id());
+  }
+
+  std::vector<std::string> strings(NUM_FILES);
+
+  // Repeatedly grow and shrink files in the middle of the stack, each growth relocating the file
+  for (std::size_t cycle = 0; cycle < 100; ++cycle)
+  {
+    for (std::size_t i = 0; i < NUM_FILES; ++i)
+    {
+      strings[i] = std::string(1 + (rng_() % MAX_SIZE), NewChar());
+
+      file_object_->SeekFile(ids[i]);
+      file_object_->Resize(strings[i].size());
+      file_object_->Write(strings[i]);
+
+      ids[i] = file_object_->id();
+    }
+
+    // The stack only needs to hold every file at its largest plus the blocks freed by a move
+    EXPECT_LE(file_object_->underlying_stack().size(), 1 + (2 * NUM_FILES * 4) + 4)
+        << "cycle: " << cycle;
+  }
+
+  for (std::size_t i = 0; i < NUM_FILES; ++i)
+  {
+    file_object_->SeekFile(ids[i]);
+    ASSERT_TRUE(file_object_->IsContiguous());
+    ASSERT_EQ(std::string{file_object_->AsDocument().document}, strings[i]);
+  }
+
+  ASSERT_EQ(file_object_->VerifyConsistency(ids), true);
+}
+
+TEST_F(FileObjectTests, LinkedFilesCanBeMigratedToExtents)
+{
+  file_object_->New("test");
+
+  std::vector<uint64_t>    ids;
+  std::vector<std::string> strings;
+
+  // Growing files in turn interleaves their blocks
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    file_object_->CreateNewFile();
+    ids.push_back(file_object_->id());
+    strings.emplace_back();
+  }
+
+  for (std::size_t round = 0; round < 4; ++round)
+  {
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      strings[i] += GetStringForTesting();
+
+      file_object_->SeekFile(ids[i]);
+      file_object_->Resize(strings[i].size());
+      file_object_->Write(strings[i]);
+    }
+  }
+
+  file_object_->SeekFile(ids[0]);
+  ASSERT_FALSE(file_object_->IsContiguous());
+
+  file_object_->SetAllocationMode(FileObjectM::AllocationMode::EXTENT);
+
+  for (auto &id : ids)
+  {
+    file_object_->SeekFile(id);
+    file_object_->MakeContiguous();
+    ASSERT_TRUE(file_object_->IsContiguous());
+    ASSERT_FALSE(file_object_->MakeContiguous());
+
+    id = file_object_->id();
+  }
+
+  for (std::size_t i = 0; i < ids.size(); ++i)
+  {
+    file_object_->SeekFile(ids[i]);
+    ASSERT_EQ(std::string{file_object_->AsDocument().document}, strings[i]);
+    ASSERT_EQ(file_object_->Hash(), crypto::Hash<crypto::SHA256>(strings[i]));
+  }
+
+  ASSERT_EQ(file_object_->VerifyConsistency(ids), true);
+}
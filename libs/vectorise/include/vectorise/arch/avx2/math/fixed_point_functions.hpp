@@ -0,0 +1,542 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace vectorise {
+namespace details {
+
+/**
+ * Four fixed point numbers held as sign extended 64 bit lanes of an AVX2 register.
+ *
+ * The arithmetic reproduces the scalar FixedPoint operators bit for bit as long as operands and
+ * results stay below 2^(TOTAL_BITS - 2) in magnitude. NaN, the infinities and the saturation limits
+ * all lie outside of that range, so a lane which leaves it is marked as unresolved and has to be
+ * recomputed by the caller with the scalar implementation. This keeps both the special value
+ * handling and the fp_state flags identical to the scalar code.
+ */
+template <typename T>
+class FixedPointLanes
+{
+public:
+  static constexpr int32_t     FRACTIONAL_BITS = T::FRACTIONAL_BITS;
+  static constexpr int32_t     TOTAL_BITS      = T::TOTAL_BITS;
+  static constexpr int64_t     LIMIT           = int64_t{1} << (TOTAL_BITS - 2);
+  static constexpr std::size_t SIZE            = 4;
+
+  static __m256i Load(T const *x)
+  {
+    if (TOTAL_BITS == 32)
+    {
+      return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<__m128i const *>(x)));
+    }
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(x));
+  }
+
+  static void Store(T *x, __m256i v)
+  {
+    if (TOTAL_BITS == 32)
+    {
+      __m256i const packed =
+          _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(x), _mm256_castsi256_si128(packed));
+      return;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(x), v);
+  }
+
+  static __m256i Constant(T const &c)
+  {
+    return _mm256_set1_epi64x(static_cast<int64_t>(c.Data()));
+  }
+
+  static __m256i Zero()
+  {
+    return _mm256_setzero_si256();
+  }
+
+  /// mask ? a : b, masks are all ones or all zeros per lane
+  static __m256i Select(__m256i mask, __m256i a, __m256i b)
+  {
+    return _mm256_blendv_epi8(b, a, mask);
+  }
+
+  static __m256i Negate(__m256i v)
+  {
+    return _mm256_sub_epi64(Zero(), v);
+  }
+
+  static __m256i Abs(__m256i v)
+  {
+    __m256i const sign = _mm256_cmpgt_epi64(Zero(), v);
+    return _mm256_sub_epi64(_mm256_xor_si256(v, sign), sign);
+  }
+
+  /// Number of significant bits of positive lanes below 2^62, i.e. platform::HighestSetBit
+  static __m256i HighestSetBit(__m256i v)
+  {
+    __m256i const wide    = _mm256_cmpgt_epi64(v, _mm256_set1_epi64x(EXACT_INTEGER - 1));
+    __m256i const reduced = Select(wide, _mm256_srli_epi64(v, 12), v);
+    __m256i const exponent =
+        _mm256_srli_epi64(_mm256_castpd_si256(ToDouble(reduced)), 52);
+
+    // a double in [2^n, 2^(n+1)) has the biased exponent n + 1023 and n + 1 significant bits
+    return _mm256_add_epi64(_mm256_sub_epi64(exponent, _mm256_set1_epi64x(1022)),
+                            _mm256_and_si256(wide, _mm256_set1_epi64x(12)));
+  }
+
+  __m256i Checked(__m256i v)
+  {
+    __m256i const above = _mm256_cmpgt_epi64(v, _mm256_set1_epi64x(LIMIT - 1));
+    __m256i const below = _mm256_cmpgt_epi64(_mm256_set1_epi64x(1 - LIMIT), v);
+    Discard(_mm256_or_si256(above, below));
+    return v;
+  }
+
+  void Discard(__m256i mask)
+  {
+    unresolved_ = _mm256_or_si256(unresolved_, mask);
+  }
+
+  /// Bit i is set when lane i has to be recomputed with the scalar implementation
+  int Unresolved() const
+  {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(unresolved_));
+  }
+
+  __m256i Add(__m256i a, __m256i b)
+  {
+    return Checked(_mm256_add_epi64(a, b));
+  }
+
+  __m256i Sub(__m256i a, __m256i b)
+  {
+    return Checked(_mm256_sub_epi64(a, b));
+  }
+
+  __m256i Mul(__m256i a, __m256i b)
+  {
+    if (TOTAL_BITS == 32)
+    {
+      // the full product fits into the lane, the shift rounds towards negative infinity
+      __m256i const product = _mm256_mul_epi32(a, b);
+      __m256i const sign    = _mm256_cmpgt_epi64(Zero(), product);
+      return Checked(_mm256_or_si256(_mm256_srli_epi64(product, FRACTIONAL_BITS),
+                                     _mm256_slli_epi64(sign, 64 - FRACTIONAL_BITS)));
+    }
+    return Checked(MulWide(a, b));
+  }
+
+  __m256i Div(__m256i a, __m256i b)
+  {
+    __m256i const zero = Zero();
+    __m256i const one  = _mm256_set1_epi64x(1);
+    Discard(_mm256_cmpeq_epi64(b, zero));
+
+    // the quotient of the magnitudes truncates towards zero, the sign is applied afterwards
+    __m256i const negative =
+        _mm256_xor_si256(_mm256_cmpgt_epi64(zero, a), _mm256_cmpgt_epi64(zero, b));
+    __m256i const x = Abs(a);
+    __m256i const y = Abs(b);
+
+    // estimate the quotient in double precision, which is exact to within one for operands and
+    // quotients that fit into the mantissa
+    __m256i const exact = _mm256_set1_epi64x(EXACT_INTEGER - 1);
+    Discard(_mm256_or_si256(_mm256_cmpgt_epi64(x, exact), _mm256_cmpgt_epi64(y, exact)));
+    __m256d const numerator =
+        _mm256_mul_pd(ToDouble(x), _mm256_set1_pd(static_cast<double>(ONE)));
+    __m256d const estimate = _mm256_floor_pd(_mm256_div_pd(numerator, ToDouble(y)));
+    Discard(_mm256_castpd_si256(_mm256_cmp_pd(
+        estimate, _mm256_set1_pd(static_cast<double>(EXACT_INTEGER / 4)), _CMP_GE_OQ)));
+
+    __m256i quotient = _mm256_and_si256(
+        _mm256_castpd_si256(_mm256_add_pd(estimate, _mm256_set1_pd(TWO_POW_52))),
+        _mm256_set1_epi64x(EXACT_INTEGER / 2 - 1));
+
+    // correct the estimate using the exact remainder, which is small enough to be computed
+    // modulo 2^64
+    __m256i const remainder =
+        _mm256_sub_epi64(_mm256_slli_epi64(x, FRACTIONAL_BITS), MulLow(quotient, y));
+    quotient = _mm256_add_epi64(quotient, _mm256_cmpgt_epi64(zero, remainder));
+    quotient = _mm256_sub_epi64(quotient,
+                                _mm256_cmpgt_epi64(remainder, _mm256_sub_epi64(y, one)));
+
+    return Checked(Select(negative, Negate(quotient), quotient));
+  }
+
+private:
+  static constexpr int64_t ONE           = int64_t{1} << FRACTIONAL_BITS;
+  static constexpr int64_t EXACT_INTEGER = int64_t{1} << 53;
+  static constexpr double  TWO_POW_52    = 4503599627370496.0;
+
+  /// Exact conversion of non negative lanes below 2^53
+  static __m256d ToDouble(__m256i v)
+  {
+    __m256i const magic   = _mm256_set1_epi64x(0x4330000000000000);
+    __m256d const offset  = _mm256_set1_pd(TWO_POW_52);
+    __m256i const low     = _mm256_and_si256(v, _mm256_set1_epi64x(0xFFFFFFFF));
+    __m256d const high_pd = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(v, 32), magic)), offset);
+    __m256d const low_pd =
+        _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(low, magic)), offset);
+    return _mm256_add_pd(_mm256_mul_pd(high_pd, _mm256_set1_pd(4294967296.0)), low_pd);
+  }
+
+  /// Low 64 bits of the product
+  static __m256i MulLow(__m256i a, __m256i b)
+  {
+    __m256i const cross = _mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)),
+                                           _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b));
+    return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+  }
+
+  /// Product of two 32.32 numbers, assembled from the 128 bit product of the magnitudes
+  __m256i MulWide(__m256i a, __m256i b)
+  {
+    __m256i const zero     = Zero();
+    __m256i const low_mask = _mm256_set1_epi64x(0xFFFFFFFF);
+    __m256i const negative =
+        _mm256_xor_si256(_mm256_cmpgt_epi64(zero, a), _mm256_cmpgt_epi64(zero, b));
+    __m256i const x      = Abs(a);
+    __m256i const y      = Abs(b);
+    __m256i const x_high = _mm256_srli_epi64(x, 32);
+    __m256i const y_high = _mm256_srli_epi64(y, 32);
+
+    __m256i const ll  = _mm256_mul_epu32(x, y);
+    __m256i const lh  = _mm256_mul_epu32(x, y_high);
+    __m256i const hl  = _mm256_mul_epu32(x_high, y);
+    __m256i const hh  = _mm256_mul_epu32(x_high, y_high);
+    __m256i const mid = _mm256_add_epi64(
+        _mm256_add_epi64(_mm256_srli_epi64(ll, 32), _mm256_and_si256(lh, low_mask)),
+        _mm256_and_si256(hl, low_mask));
+    __m256i const high = _mm256_add_epi64(
+        _mm256_add_epi64(hh, _mm256_srli_epi64(lh, 32)),
+        _mm256_add_epi64(_mm256_srli_epi64(hl, 32), _mm256_srli_epi64(mid, 32)));
+
+    // the product shifted by the 32 fractional bits is high:mid, which has to stay below LIMIT
+    Discard(_mm256_cmpgt_epi64(high, _mm256_set1_epi64x((int64_t{1} << 30) - 1)));
+    __m256i const magnitude =
+        _mm256_or_si256(_mm256_slli_epi64(high, 32), _mm256_and_si256(mid, low_mask));
+
+    // an arithmetic shift of a negative product rounds away from zero unless it is exact
+    __m256i const exact = _mm256_cmpeq_epi64(_mm256_and_si256(ll, low_mask), zero);
+    __m256i const negated =
+        _mm256_sub_epi64(_mm256_sub_epi64(Negate(magnitude), _mm256_set1_epi64x(1)), exact);
+
+    return Select(negative, negated, magnitude);
+  }
+
+  __m256i unresolved_ = _mm256_setzero_si256();
+};
+
+/**
+ * e^x for the range reduced argument 0 < x <= MAX_EXP, following FixedPoint::Exp
+ */
+template <typename T>
+__m256i ExpPositive(FixedPointLanes<T> &lanes, __m256i x)
+{
+  using Lanes = FixedPointLanes<T>;
+
+  static T const P01 = static_cast<T>(fixed_point::Exp_P01);
+  static T const P02 = static_cast<T>(fixed_point::Exp_P02);
+  static T const P03 = static_cast<T>(fixed_point::Exp_P03);
+  static T const P04 = static_cast<T>(fixed_point::Exp_P04);
+  static T const P05 = static_cast<T>(fixed_point::Exp_P05);
+
+  __m256i const one = Lanes::Constant(T::_1);
+  __m256i const ln2 = Lanes::Constant(T::CONST_LN2);
+
+  // x = k * ln2 + r, e^x = 2^k * e^r
+  __m256i const k = _mm256_and_si256(lanes.Div(x, ln2),
+                                     _mm256_set1_epi64x(static_cast<int64_t>(T::INTEGER_MASK)));
+  __m256i const r  = lanes.Sub(x, lanes.Mul(k, ln2));
+  __m256i const e1 = lanes.Checked(
+      _mm256_sllv_epi64(one, _mm256_srli_epi64(k, Lanes::FRACTIONAL_BITS)));
+
+  __m256i const r2 = lanes.Mul(r, r);
+  __m256i const r3 = lanes.Mul(r2, r);
+  __m256i const r4 = lanes.Mul(r3, r);
+  __m256i const r5 = lanes.Mul(r4, r);
+  __m256i const c1 = lanes.Mul(r, Lanes::Constant(P01));
+  __m256i const c2 = lanes.Mul(r2, Lanes::Constant(P02));
+  __m256i const c3 = lanes.Mul(r3, Lanes::Constant(P03));
+  __m256i const c4 = lanes.Mul(r4, Lanes::Constant(P04));
+  __m256i const c5 = lanes.Mul(r5, Lanes::Constant(P05));
+
+  __m256i P = lanes.Add(lanes.Add(lanes.Add(lanes.Add(lanes.Add(one, c1), c2), c3), c4), c5);
+  __m256i Q = lanes.Sub(lanes.Add(lanes.Sub(lanes.Add(lanes.Sub(one, c1), c2), c3), c4), c5);
+
+  return lanes.Mul(e1, lanes.Div(P, Q));
+}
+
+/**
+ * e^x, see FixedPoint::Exp
+ */
+template <typename T>
+__m256i Exp(FixedPointLanes<T> &lanes, __m256i x)
+{
+  using Lanes = FixedPointLanes<T>;
+
+  __m256i const zero = Lanes::Zero();
+  __m256i const one  = Lanes::Constant(T::_1);
+  lanes.Checked(x);
+
+  __m256i const underflow = _mm256_cmpgt_epi64(Lanes::Constant(T::MIN_EXP), x);
+  __m256i const is_zero   = _mm256_cmpeq_epi64(x, zero);
+  __m256i const negative  = _mm256_cmpgt_epi64(zero, x);
+  __m256i const trivial   = _mm256_or_si256(underflow, is_zero);
+
+  // negative arguments are evaluated as 1 / e^-x, which only overflows for x > MAX_EXP
+  __m256i       magnitude = Lanes::Abs(x);
+  __m256i const overflow  = _mm256_cmpgt_epi64(magnitude, Lanes::Constant(T::MAX_EXP));
+  lanes.Discard(_mm256_andnot_si256(trivial, overflow));
+  magnitude = Lanes::Select(_mm256_or_si256(trivial, overflow), one, magnitude);
+
+  __m256i e = Lanes::Select(_mm256_cmpeq_epi64(magnitude, one), Lanes::Constant(T::CONST_E),
+                            ExpPositive(lanes, magnitude));
+  e         = Lanes::Select(negative, lanes.Div(one, Lanes::Select(negative, e, one)), e);
+  e         = Lanes::Select(underflow, zero, e);
+
+  return Lanes::Select(is_zero, one, e);
+}
+
+/**
+ * log2(x), see FixedPoint::Log2
+ */
+template <typename T>
+__m256i Log2(FixedPointLanes<T> &lanes, __m256i x)
+{
+  using Lanes = FixedPointLanes<T>;
+
+  __m256i const zero     = Lanes::Zero();
+  __m256i const one      = Lanes::Constant(T::_1);
+  __m256i const smallest = _mm256_set1_epi64x(1);
+  lanes.Checked(x);
+
+  // zero and negative numbers have no finite logarithm
+  __m256i const invalid = _mm256_cmpgt_epi64(smallest, x);
+  lanes.Discard(invalid);
+  __m256i const is_one      = _mm256_cmpeq_epi64(x, one);
+  __m256i const is_smallest = _mm256_cmpeq_epi64(x, smallest);
+  __m256i const y0 = Lanes::Select(_mm256_or_si256(invalid, is_smallest), one, x);
+
+  __m256i const above = _mm256_cmpgt_epi64(y0, one);
+  __m256i const below = _mm256_cmpgt_epi64(one, y0);
+  __m256i const sign =
+      Lanes::Select(above, one, Lanes::Select(below, Lanes::Negate(one), zero));
+
+  // y = 2^k * r
+  __m256i const y =
+      Lanes::Select(below, lanes.Div(one, Lanes::Select(below, y0, one)), y0);
+  __m256i const k = _mm256_sub_epi64(Lanes::HighestSetBit(y),
+                                     _mm256_set1_epi64x(Lanes::FRACTIONAL_BITS));
+  __m256i const r = lanes.Div(y, lanes.Checked(_mm256_sllv_epi64(one, k)));
+
+  __m256i const P00 = Lanes::Constant(T{137});
+  __m256i const P01 = Lanes::Constant(T{1762});
+  __m256i const P02 = Lanes::Constant(T{3762});
+  __m256i const Q0  = Lanes::Constant(T{30});
+  __m256i const Q01 = Lanes::Constant(T{24});
+  __m256i const Q02 = Lanes::Constant(T{76});
+
+  // P = (-1 + r) * (P00 + r * (P01 + r * (P02 + r * (P01 + r * P04))))
+  __m256i P = lanes.Mul(r, P00);
+  P         = lanes.Mul(r, lanes.Add(P01, P));
+  P         = lanes.Mul(r, lanes.Add(P02, P));
+  P         = lanes.Mul(r, lanes.Add(P01, P));
+  P         = lanes.Mul(lanes.Add(Lanes::Negate(one), r), lanes.Add(P00, P));
+
+  // Q = Q0 * (1 + r) * (1 + r * (Q01 + r * (Q02 + r * (Q01 + r)))) * ln2
+  __m256i Q = lanes.Add(Q01, r);
+  Q         = lanes.Add(Q02, lanes.Mul(r, Q));
+  Q         = lanes.Add(Q01, lanes.Mul(r, Q));
+  Q         = lanes.Add(one, lanes.Mul(r, Q));
+  Q         = lanes.Mul(lanes.Mul(lanes.Mul(Q0, lanes.Add(one, r)), Q),
+                Lanes::Constant(T::CONST_LN2));
+
+  __m256i const integer = _mm256_slli_epi64(k, Lanes::FRACTIONAL_BITS);
+  __m256i       result  = lanes.Mul(sign, lanes.Add(integer, lanes.Div(P, Q)));
+  result                = Lanes::Select(is_one, zero, result);
+
+  return Lanes::Select(
+      is_smallest,
+      _mm256_set1_epi64x(-(int64_t{Lanes::FRACTIONAL_BITS} << Lanes::FRACTIONAL_BITS)), result);
+}
+
+/**
+ * log(x), see FixedPoint::Log
+ */
+template <typename T>
+__m256i Log(FixedPointLanes<T> &lanes, __m256i x)
+{
+  using Lanes = FixedPointLanes<T>;
+  return lanes.Div(Log2(lanes, x), Lanes::Constant(T::CONST_LOG2E));
+}
+
+/**
+ * sqrt(x), see FixedPoint::Sqrt
+ */
+template <typename T>
+__m256i Sqrt(FixedPointLanes<T> &lanes, __m256i x)
+{
+  using Lanes = FixedPointLanes<T>;
+
+  __m256i const zero = Lanes::Zero();
+  __m256i const one  = Lanes::Constant(T::_1);
+  __m256i const half = Lanes::Constant(T::_half);
+  lanes.Checked(x);
+
+  __m256i const negative = _mm256_cmpgt_epi64(zero, x);
+  lanes.Discard(negative);
+  __m256i const is_one  = _mm256_cmpeq_epi64(x, one);
+  __m256i const is_zero = _mm256_cmpeq_epi64(x, zero);
+
+  // x = 4^k * r with 1 <= r <= 4, as done by FixedPoint::ReduceSqrt
+  __m256i       r     = Lanes::Select(_mm256_or_si256(negative, is_zero), one, x);
+  __m256i       k     = zero;
+  __m256i const four  = Lanes::Constant(T{4});
+  __m256i       shift = _mm256_cmpgt_epi64(r, four);
+  while (!_mm256_testz_si256(shift, shift))
+  {
+    k     = _mm256_sub_epi64(k, shift);
+    r     = Lanes::Select(shift, _mm256_srli_epi64(r, 2), r);
+    shift = _mm256_cmpgt_epi64(r, four);
+  }
+  shift = _mm256_cmpgt_epi64(one, r);
+  while (!_mm256_testz_si256(shift, shift))
+  {
+    k     = _mm256_add_epi64(k, shift);
+    r     = Lanes::Select(shift, _mm256_slli_epi64(r, 2), r);
+    shift = _mm256_cmpgt_epi64(one, r);
+  }
+
+  __m256i const P01 = Lanes::Constant(T{3});
+  __m256i const P02 = Lanes::Constant(T{11});
+  __m256i const P03 = Lanes::Constant(T{9});
+  __m256i const Q01 = Lanes::Constant(T{3});
+  __m256i const Q02 = Lanes::Constant(T{27});
+  __m256i const Q03 = Lanes::Constant(T{33});
+
+  // P = (1 + P01 * r) * (1 + P01 * r * (P02 + r * (P03 + r)))
+  __m256i const p01_r = lanes.Mul(P01, r);
+  __m256i       P     = lanes.Add(P03, r);
+  P                   = lanes.Add(P02, lanes.Mul(r, P));
+  P                   = lanes.Mul(lanes.Add(one, p01_r), lanes.Add(one, lanes.Mul(p01_r, P)));
+
+  // Q = (Q01 + r) * (Q01 + r * (Q02 + r * (Q03 + r)))
+  __m256i Q = lanes.Add(Q03, r);
+  Q         = lanes.Add(Q02, lanes.Mul(r, Q));
+  Q         = lanes.Mul(lanes.Add(Q01, r), lanes.Add(Q01, lanes.Mul(r, Q)));
+
+  // two iterations of Goldsmith's algorithm
+  __m256i const y_n = lanes.Div(one, lanes.Div(P, Q));
+  __m256i       x_n = lanes.Mul(r, y_n);
+  __m256i       h_n = lanes.Mul(half, y_n);
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    __m256i const r_n = lanes.Sub(half, lanes.Mul(x_n, h_n));
+    x_n               = lanes.Add(x_n, lanes.Mul(x_n, r_n));
+    h_n               = lanes.Add(h_n, lanes.Mul(h_n, r_n));
+  }
+  r = Lanes::Select(_mm256_cmpeq_epi64(r, one), r, x_n);
+
+  __m256i const twok =
+      Lanes::Select(_mm256_cmpgt_epi64(zero, k), _mm256_srlv_epi64(one, Lanes::Negate(k)),
+                    _mm256_sllv_epi64(one, k));
+  __m256i result = lanes.Mul(lanes.Checked(twok), r);
+  result         = Lanes::Select(is_one, one, result);
+
+  return Lanes::Select(is_zero, zero, result);
+}
+
+/**
+ * tanh(x), see FixedPoint::TanH
+ */
+template <typename T>
+__m256i TanH(FixedPointLanes<T> &lanes, __m256i x)
+{
+  using Lanes = FixedPointLanes<T>;
+
+  __m256i const e1 = Exp(lanes, x);
+  __m256i const e2 = Exp(lanes, Lanes::Negate(x));
+
+  return lanes.Div(lanes.Sub(e1, e2), lanes.Add(e1, e2));
+}
+
+/**
+ * The numerically stable sigmoid of math::Sigmoid, 1 / (1 + e^-x) for x >= 0 and e^x / (e^x + 1)
+ * otherwise
+ */
+template <typename T>
+__m256i Sigmoid(FixedPointLanes<T> &lanes, __m256i x)
+{
+  using Lanes = FixedPointLanes<T>;
+
+  __m256i const one = Lanes::Constant(T::_1);
+  __m256i const e   = Exp(lanes, Lanes::Negate(Lanes::Abs(x)));
+
+  return lanes.Div(Lanes::Select(_mm256_cmpgt_epi64(Lanes::Zero(), x), e, one),
+                   lanes.Add(e, one));
+}
+
+/**
+ * Applies a lane function to n contiguous values. Unresolved lanes and the remainder which does
+ * not fill a register are computed with the scalar function.
+ */
+template <typename T, typename LaneFunction, typename ScalarFunction>
+void ApplyFixedPointLanes(T const *x, T *ret, std::size_t n, LaneFunction const &lane_function,
+                          ScalarFunction const &scalar_function)
+{
+  using Lanes = FixedPointLanes<T>;
+
+  std::size_t i = 0;
+  for (; i + Lanes::SIZE <= n; i += Lanes::SIZE)
+  {
+    // keep a copy of the inputs as ret may alias x
+    T input[Lanes::SIZE];
+    for (std::size_t j = 0; j < Lanes::SIZE; ++j)
+    {
+      input[j] = x[i + j];
+    }
+
+    Lanes lanes;
+    Lanes::Store(ret + i, lane_function(lanes, Lanes::Load(input)));
+
+    for (int unresolved = lanes.Unresolved(); unresolved != 0; unresolved &= unresolved - 1)
+    {
+      auto const j = static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(unresolved)));
+      ret[i + j]   = scalar_function(input[j]);
+    }
+  }
+
+  for (; i < n; ++i)
+  {
+    ret[i] = scalar_function(x[i]);
+  }
+}
+
+}  // namespace details
+}  // namespace vectorise
+}  // namespace fetch
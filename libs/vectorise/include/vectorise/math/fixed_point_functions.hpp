@@ -0,0 +1,197 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/fixed_point/type_traits.hpp"
+#ifdef __AVX2__
+#include "vectorise/arch/avx2/math/fixed_point_functions.hpp"
+#endif
+
+#include <cstddef>
+#include <type_traits>
+
+namespace fetch {
+namespace vectorise {
+namespace details {
+
+template <typename T>
+using IsVectorisedFixedPoint =
+    std::integral_constant<bool, std::is_same<T, fixed_point::fp32_t>::value ||
+                                     std::is_same<T, fixed_point::fp64_t>::value>;
+
+template <typename T, typename Function>
+void FixedPointMap(T const *x, T *ret, std::size_t n, Function const &function,
+                   std::false_type /*vectorised*/)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    ret[i] = function(x[i]);
+  }
+}
+
+template <typename T, typename Function>
+void FixedPointMap(T const *x, T *ret, std::size_t n, Function const &function,
+                   std::true_type /*vectorised*/)
+{
+#ifdef __AVX2__
+  ApplyFixedPointLanes(x, ret, n, function, function);
+#else
+  FixedPointMap(x, ret, n, function, std::false_type{});
+#endif
+}
+
+template <typename T, typename Function>
+void FixedPointMap(T const *x, T *ret, std::size_t n, Function const &function)
+{
+  FixedPointMap(x, ret, n, function, IsVectorisedFixedPoint<T>{});
+}
+
+struct ExpFunction
+{
+  template <typename T>
+  T operator()(T const &x) const
+  {
+    return T::Exp(x);
+  }
+
+#ifdef __AVX2__
+  template <typename T>
+  __m256i operator()(FixedPointLanes<T> &lanes, __m256i x) const
+  {
+    return details::Exp(lanes, x);
+  }
+#endif
+};
+
+struct LogFunction
+{
+  template <typename T>
+  T operator()(T const &x) const
+  {
+    return T::Log(x);
+  }
+
+#ifdef __AVX2__
+  template <typename T>
+  __m256i operator()(FixedPointLanes<T> &lanes, __m256i x) const
+  {
+    return details::Log(lanes, x);
+  }
+#endif
+};
+
+struct SqrtFunction
+{
+  template <typename T>
+  T operator()(T const &x) const
+  {
+    return T::Sqrt(x);
+  }
+
+#ifdef __AVX2__
+  template <typename T>
+  __m256i operator()(FixedPointLanes<T> &lanes, __m256i x) const
+  {
+    return details::Sqrt(lanes, x);
+  }
+#endif
+};
+
+struct TanHFunction
+{
+  template <typename T>
+  T operator()(T const &x) const
+  {
+    return T::TanH(x);
+  }
+
+#ifdef __AVX2__
+  template <typename T>
+  __m256i operator()(FixedPointLanes<T> &lanes, __m256i x) const
+  {
+    return details::TanH(lanes, x);
+  }
+#endif
+};
+
+struct SigmoidFunction
+{
+  template <typename T>
+  T operator()(T const &x) const
+  {
+    if (x >= T{0})
+    {
+      return T{1} / (T{1} + T::Exp(-x));
+    }
+    T const e = T::Exp(x);
+    return e / (e + T{1});
+  }
+
+#ifdef __AVX2__
+  template <typename T>
+  __m256i operator()(FixedPointLanes<T> &lanes, __m256i x) const
+  {
+    return details::Sigmoid(lanes, x);
+  }
+#endif
+};
+
+}  // namespace details
+
+/**
+ * Element wise fixed point functions over n contiguous values, ret may alias x.
+ *
+ * The results are bit for bit those of the scalar FixedPoint functions. With AVX2 fp32_t and
+ * fp64_t are evaluated four values at a time, other types use the scalar functions.
+ */
+template <typename T>
+math::meta::IfIsFixedPoint<T, void> Exp(T const *x, T *ret, std::size_t n)
+{
+  details::FixedPointMap(x, ret, n, details::ExpFunction{});
+}
+
+template <typename T>
+math::meta::IfIsFixedPoint<T, void> Log(T const *x, T *ret, std::size_t n)
+{
+  details::FixedPointMap(x, ret, n, details::LogFunction{});
+}
+
+template <typename T>
+math::meta::IfIsFixedPoint<T, void> Sqrt(T const *x, T *ret, std::size_t n)
+{
+  details::FixedPointMap(x, ret, n, details::SqrtFunction{});
+}
+
+template <typename T>
+math::meta::IfIsFixedPoint<T, void> TanH(T const *x, T *ret, std::size_t n)
+{
+  details::FixedPointMap(x, ret, n, details::TanHFunction{});
+}
+
+/**
+ * The numerically stable sigmoid used by math::Sigmoid
+ */
+template <typename T>
+math::meta::IfIsFixedPoint<T, void> Sigmoid(T const *x, T *ret, std::size_t n)
+{
+  details::FixedPointMap(x, ret, n, details::SigmoidFunction{});
+}
+
+}  // namespace vectorise
+}  // namespace fetch
@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/fixed_point_functions.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace fetch::fixed_point;
+
+template <typename T>
+class FixedPointFunctionsTest : public ::testing::Test
+{
+protected:
+  using Type = typename T::Type;
+
+  /// Special values, range limits and a spread of raw values over the whole representable range
+  static std::vector<T> Inputs()
+  {
+    std::vector<T> values{T::NaN,         T::POSITIVE_INFINITY, T::NEGATIVE_INFINITY,
+                          T::FP_MAX,      T::FP_MIN,            T::MAX_EXP,
+                          T::MIN_EXP,     T::_0,                T::_1,
+                          -T::_1,         T::_half,             T::CONST_E,
+                          T::FromBase(1), T::FromBase(-1)};
+
+    constexpr int   WIDTH = T::TOTAL_BITS < 64 ? T::TOTAL_BITS : 64;
+    std::mt19937_64 rng(42);
+    for (std::size_t i = 0; i < 20000; ++i)
+    {
+      // shifting the random bits spreads the magnitudes evenly over all binary orders
+      auto const shift = static_cast<int>(rng() % WIDTH);
+      auto const raw   = static_cast<int64_t>(rng()) >> (64 - WIDTH + shift);
+      values.push_back(T::FromBase(static_cast<Type>(raw)));
+    }
+
+    // dense sampling of the range used by activation functions
+    for (int64_t i = -20000; i < 20000; ++i)
+    {
+      auto const raw = static_cast<Type>(static_cast<Type>(i) << (T::FRACTIONAL_BITS - 10));
+      values.push_back(T::FromBase(raw));
+    }
+
+    // an odd count exercises the scalar tail
+    values.push_back(T::_1 + T::_half);
+
+    return values;
+  }
+
+  /// The numerically stable sigmoid of math::Sigmoid
+  static T Sigmoid(T const &x)
+  {
+    if (x >= T{0})
+    {
+      return T{1} / (T{1} + T::Exp(-x));
+    }
+    T const e = T::Exp(x);
+    return e / (e + T{1});
+  }
+
+  template <typename Vectorised, typename Scalar>
+  static void ExpectBitExact(Vectorised const &vectorised, Scalar const &scalar)
+  {
+    std::vector<T> const input = Inputs();
+    std::vector<T>       output(input.size());
+    std::vector<T>       in_place{input};
+
+    vectorised(input.data(), output.data(), input.size());
+    vectorised(in_place.data(), in_place.data(), in_place.size());
+
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+      T const expected = scalar(input[i]);
+      // compare the raw values, NaN never compares equal to itself
+      ASSERT_TRUE(output[i].Data() == expected.Data()) << "input " << input[i];
+      ASSERT_TRUE(in_place[i].Data() == expected.Data()) << "input " << input[i];
+    }
+  }
+
+  /// Values at and beyond the limits of the special cases, which set the fp_state flags
+  static std::vector<T> StateInputs()
+  {
+    T const smallest = T::FromBase(1);
+    return {T::NaN,
+            T::POSITIVE_INFINITY,
+            T::NEGATIVE_INFINITY,
+            T::FP_MAX,
+            T::FP_MIN,
+            T::MAX_EXP,
+            T::MAX_EXP + smallest,
+            T::MAX_EXP * T{2},
+            -T::MAX_EXP,
+            -T::MAX_EXP - smallest,
+            T::MIN_EXP,
+            T::MIN_EXP - smallest,
+            T::MIN_EXP * T{2},
+            T::_0,
+            -T::_1,
+            smallest,
+            -smallest};
+  }
+
+  template <typename Vectorised, typename Scalar>
+  static void ExpectSameState(Vectorised const &vectorised, Scalar const &scalar)
+  {
+    std::vector<T> const input = StateInputs();
+
+    for (T const &x : input)
+    {
+      // a whole register of the value, so that it is not handled by the scalar tail
+      std::vector<T> lanes(4, x);
+
+      T::StateClear();
+      vectorised(lanes.data(), lanes.data(), lanes.size());
+      uint32_t const state = T::fp_state;
+
+      T::StateClear();
+      scalar(x);
+      EXPECT_EQ(T::fp_state, state) << "input " << x;
+    }
+
+    // the flags of a mixed block are those of all its values
+    std::vector<T> output(input.size());
+    T::StateClear();
+    vectorised(input.data(), output.data(), input.size());
+    uint32_t const state = T::fp_state;
+
+    T::StateClear();
+    for (T const &x : input)
+    {
+      scalar(x);
+    }
+    EXPECT_EQ(T::fp_state, state);
+    T::StateClear();
+  }
+};
+
+using FixedPointTypes = ::testing::Types<fp32_t, fp64_t>;
+TYPED_TEST_CASE(FixedPointFunctionsTest, FixedPointTypes);
+
+TYPED_TEST(FixedPointFunctionsTest, exp_matches_scalar)
+{
+  using T = TypeParam;
+  this->ExpectBitExact([](T const *x, T *ret, std::size_t n) { fetch::vectorise::Exp(x, ret, n); },
+                       [](T const &x) { return T::Exp(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, log_matches_scalar)
+{
+  using T = TypeParam;
+  this->ExpectBitExact([](T const *x, T *ret, std::size_t n) { fetch::vectorise::Log(x, ret, n); },
+                       [](T const &x) { return T::Log(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, sqrt_matches_scalar)
+{
+  using T = TypeParam;
+  this->ExpectBitExact(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::Sqrt(x, ret, n); },
+      [](T const &x) { return T::Sqrt(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, tanh_matches_scalar)
+{
+  using T = TypeParam;
+  this->ExpectBitExact(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::TanH(x, ret, n); },
+      [](T const &x) { return T::TanH(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, sigmoid_matches_scalar)
+{
+  using T = TypeParam;
+  this->ExpectBitExact(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::Sigmoid(x, ret, n); },
+      [](T const &x) { return FixedPointFunctionsTest<T>::Sigmoid(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, exp_sets_scalar_state)
+{
+  using T = TypeParam;
+  this->ExpectSameState(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::Exp(x, ret, n); },
+      [](T const &x) { return T::Exp(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, log_sets_scalar_state)
+{
+  using T = TypeParam;
+  this->ExpectSameState(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::Log(x, ret, n); },
+      [](T const &x) { return T::Log(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, sqrt_sets_scalar_state)
+{
+  using T = TypeParam;
+  this->ExpectSameState(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::Sqrt(x, ret, n); },
+      [](T const &x) { return T::Sqrt(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, tanh_sets_scalar_state)
+{
+  using T = TypeParam;
+  this->ExpectSameState(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::TanH(x, ret, n); },
+      [](T const &x) { return T::TanH(x); });
+}
+
+TYPED_TEST(FixedPointFunctionsTest, sigmoid_sets_scalar_state)
+{
+  using T = TypeParam;
+  this->ExpectSameState(
+      [](T const *x, T *ret, std::size_t n) { fetch::vectorise::Sigmoid(x, ret, n); },
+      [](T const &x) { return FixedPointFunctionsTest<T>::Sigmoid(x); });
+}
+
+}  // namespace
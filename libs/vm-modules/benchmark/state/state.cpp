@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "vm/io_observer_interface.hpp"
+#include "vm/map.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using namespace fetch::vm;
+
+using fetch::byte_array::ConstByteArray;
+using fetch::vm_modules::VMFactory;
+
+namespace {
+
+char const *SOURCE = R"(
+  function build(n : Int32) : Map<Int32, Int32>
+    var data = Map<Int32, Int32>();
+    for (i in 0:n)
+      data[i] = i;
+    endfor
+    return data;
+  endfunction
+
+  function store(n : Int32)
+    State<Map<Int32, Int32>>("map").set(build(n));
+  endfunction
+
+  function read(key : Int32) : Int32
+    return State<Map<Int32, Int32>>("map").get()[key];
+  endfunction
+
+  function update(key : Int32)
+    var state = State<Map<Int32, Int32>>("map");
+    var data = state.get();
+    data[key] = data[key] + 1;
+    state.set(data);
+  endfunction
+)";
+
+/**
+ * In memory state store which records the amount of IO performed by the VM
+ */
+class CountingIoObserver : public IoObserverInterface
+{
+public:
+  Status Read(std::string const &key, void *data, uint64_t &size) override
+  {
+    ConstByteArray value;
+    auto const     status = Get(key, value);
+    if (status != Status::OK)
+    {
+      return status;
+    }
+
+    if (size < value.size())
+    {
+      size = value.size();
+      return Status::BUFFER_TOO_SMALL;
+    }
+
+    value.ReadBytes(static_cast<uint8_t *>(data), value.size());
+    size = value.size();
+    return Status::OK;
+  }
+
+  Status Get(std::string const &key, ConstByteArray &value) override
+  {
+    ++reads;
+
+    auto it = store_.find(key);
+    if (it == store_.end())
+    {
+      return Status::ERROR;
+    }
+
+    value = it->second;
+    bytes_read += value.size();
+
+    return Status::OK;
+  }
+
+  Status Write(std::string const &key, void const *data, uint64_t size) override
+  {
+    ++writes;
+    bytes_written += size;
+
+    store_[key] = ConstByteArray{static_cast<uint8_t const *>(data), size};
+    return Status::OK;
+  }
+
+  Status Exists(std::string const &key) override
+  {
+    return (store_.find(key) != store_.end()) ? Status::OK : Status::ERROR;
+  }
+
+  void Set(std::string const &key, ConstByteArray const &value)
+  {
+    store_[key] = value;
+  }
+
+  void ResetCounters()
+  {
+    reads         = 0;
+    writes        = 0;
+    bytes_read    = 0;
+    bytes_written = 0;
+  }
+
+  uint64_t reads{0};
+  uint64_t writes{0};
+  uint64_t bytes_read{0};
+  uint64_t bytes_written{0};
+
+private:
+  std::unordered_map<std::string, ConstByteArray> store_;
+};
+
+class StateMapFixture
+{
+public:
+  StateMapFixture()
+    : module_{VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS)}
+  {
+    auto const errors = VMFactory::Compile(module_, {{"state.etch", SOURCE}}, executable_);
+    if (!errors.empty())
+    {
+      throw std::runtime_error("Unable to compile benchmark contract: " + errors.front());
+    }
+
+    vm_ = std::make_unique<VM>(module_.get());
+    vm_->SetIOObserver(observer_);
+    vm_->EnablePagedState(true);
+  }
+
+  template <typename... Args>
+  Variant Execute(std::string const &function, Args const &... args)
+  {
+    std::string error;
+    Variant     output;
+    if (!vm_->Execute(executable_, function, error, output, args...))
+    {
+      throw std::runtime_error("Execution of " + function + " failed: " + error);
+    }
+
+    return output;
+  }
+
+  /// Store the map in the paged representation, as written by the State
+  void StorePaged(int32_t entries)
+  {
+    Execute("store", entries);
+  }
+
+  /// Store the map serialised as a whole, which is how every map used to be stored
+  ConstByteArray StoreWhole(int32_t entries)
+  {
+    auto map = Execute("build", entries).Get<Ptr<IMap>>();
+
+    MsgPackSerializer buffer;
+    map->SerializeTo(buffer);
+    observer_.Set("map", buffer.data());
+
+    return buffer.data();
+  }
+
+  CountingIoObserver &observer()
+  {
+    return observer_;
+  }
+
+private:
+  std::shared_ptr<Module> module_;
+  Executable              executable_;
+  CountingIoObserver      observer_;
+  std::unique_ptr<VM>     vm_;
+};
+
+void ReportIo(benchmark::State &state, CountingIoObserver const &observer)
+{
+  auto const iterations = static_cast<double>(state.iterations());
+
+  state.counters["reads_per_tx"]         = static_cast<double>(observer.reads) / iterations;
+  state.counters["bytes_read_per_tx"]    = static_cast<double>(observer.bytes_read) / iterations;
+  state.counters["bytes_written_per_tx"] = static_cast<double>(observer.bytes_written) / iterations;
+}
+
+int32_t NextKey(int32_t key, int32_t entries)
+{
+  return static_cast<int32_t>((static_cast<int64_t>(key) + 7919) % entries);
+}
+
+void StateMap_ReadOneEntry_Whole(benchmark::State &state)
+{
+  auto const entries = static_cast<int32_t>(state.range(0));
+
+  StateMapFixture fixture;
+  fixture.StoreWhole(entries);
+  fixture.observer().ResetCounters();
+
+  int32_t key{0};
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(fixture.Execute("read", key));
+    key = NextKey(key, entries);
+  }
+
+  ReportIo(state, fixture.observer());
+}
+
+void StateMap_ReadOneEntry_Paged(benchmark::State &state)
+{
+  auto const entries = static_cast<int32_t>(state.range(0));
+
+  StateMapFixture fixture;
+  fixture.StorePaged(entries);
+  fixture.observer().ResetCounters();
+
+  int32_t key{0};
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(fixture.Execute("read", key));
+    key = NextKey(key, entries);
+  }
+
+  ReportIo(state, fixture.observer());
+}
+
+void StateMap_UpdateOneEntry_Whole(benchmark::State &state)
+{
+  auto const entries = static_cast<int32_t>(state.range(0));
+
+  StateMapFixture fixture;
+  auto const      whole = fixture.StoreWhole(entries);
+  fixture.observer().ResetCounters();
+
+  // the map is written back in full each time, since it is converted from the whole encoding
+  int32_t key{0};
+  for (auto _ : state)
+  {
+    fixture.Execute("update", key);
+    key = NextKey(key, entries);
+
+    state.PauseTiming();
+    fixture.observer().Set("map", whole);
+    state.ResumeTiming();
+  }
+
+  ReportIo(state, fixture.observer());
+}
+
+void StateMap_UpdateOneEntry_Paged(benchmark::State &state)
+{
+  auto const entries = static_cast<int32_t>(state.range(0));
+
+  StateMapFixture fixture;
+  fixture.StorePaged(entries);
+  fixture.observer().ResetCounters();
+
+  int32_t key{0};
+  for (auto _ : state)
+  {
+    fixture.Execute("update", key);
+    key = NextKey(key, entries);
+  }
+
+  ReportIo(state, fixture.observer());
+}
+
+}  // namespace
+
+// maps below StatePages::MIN_PAGED_ENTRIES are always stored as a whole
+BENCHMARK(StateMap_ReadOneEntry_Whole)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(StateMap_ReadOneEntry_Paged)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(StateMap_UpdateOneEntry_Whole)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(StateMap_UpdateOneEntry_Paged)->Arg(100)->Arg(1000)->Arg(10000);
@@ -1302,8 +1302,7 @@ TEST_F(MathTensorTests, tensor_state_test)
   ASSERT_TRUE(toolkit.Compile(tensor_deserialiase_src));
 
   Variant res;
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
   ASSERT_TRUE(toolkit.Run(&res));
 
   auto const                    tensor = res.Get<Ptr<fetch::vm_modules::math::VMTensor>>();
@@ -131,8 +131,7 @@ TEST_F(MLTests, DISABLED_dataloader_tensor_serialisation_test)
     )";
 
   ASSERT_TRUE(toolkit.Compile(dataloader_deserialise_src));
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
   ASSERT_TRUE(toolkit.Run());
 }
 
@@ -160,7 +159,6 @@ TEST_F(MLTests, DISABLED_trivial_persistent_tensor_dataloader_serialisation_test
     )";
 
   ASSERT_TRUE(toolkit.Compile(dataloader_deserialise_src));
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
   ASSERT_TRUE(toolkit.Run());
 }
 
@@ -240,8 +238,7 @@ TEST_F(MLTests, DISABLED_dataloader_serialisation_test)
   ASSERT_TRUE(toolkit.Compile(dataloader_deserialise_src));
 
   Variant res;
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
   ASSERT_TRUE(toolkit.Run(&res));
 
   auto const initial_training_pair = first_res.Get<fetch::vm::Ptr<fetch::vm::Pair<
@@ -340,8 +337,7 @@ TEST_F(MLTests, DISABLED_graph_serialisation_test)
   ASSERT_TRUE(toolkit.Compile(graph_deserialise_src));
 
   Variant res;
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
   ASSERT_TRUE(toolkit.Run(&res));
 
   auto const initial_loss = first_res.Get<Ptr<fetch::vm_modules::math::VMTensor>>();
@@ -415,8 +411,7 @@ TEST_F(MLTests, DISABLED_graph_string_serialisation_test)
   ASSERT_TRUE(toolkit.Compile(graph_deserialise_src));
 
   Variant res;
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
   ASSERT_TRUE(toolkit.Run(&res));
 
   auto const initial_loss = first_res.Get<Ptr<fetch::vm_modules::math::VMTensor>>();
@@ -525,8 +520,7 @@ TEST_F(MLTests, DISABLED_optimiser_sgd_serialisation)
 
   Variant second_res;
   ASSERT_TRUE(toolkit.Compile(optimiser_deserialise_src));
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
   ASSERT_TRUE(toolkit.Run(&second_res));
 
   auto const loss2 = second_res.Get<fetch::fixed_point::fp64_t>();
@@ -596,12 +590,9 @@ TEST_F(MLTests, DISABLED_serialisation_several_components_test)
     )";
 
   ASSERT_TRUE(toolkit.Compile(several_deserialise_src));
-  EXPECT_CALL(toolkit.observer(), Exists(graph_name));
-  EXPECT_CALL(toolkit.observer(), Exists(dl_name));
-  EXPECT_CALL(toolkit.observer(), Exists(opt_name));
-  EXPECT_CALL(toolkit.observer(), Read(graph_name, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(dl_name, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(opt_name, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(graph_name, _));
+  EXPECT_CALL(toolkit.observer(), Get(dl_name, _));
+  EXPECT_CALL(toolkit.observer(), Get(opt_name, _));
   ASSERT_TRUE(toolkit.Run());
 }
 
@@ -224,14 +224,10 @@ TEST_F(VMModelTests, serialisation_model)
     )";
 
   ASSERT_TRUE(toolkit.Compile(model_deserialise_src));
-  EXPECT_CALL(toolkit.observer(), Exists(model_name1));
-  EXPECT_CALL(toolkit.observer(), Exists(model_name2));
-  EXPECT_CALL(toolkit.observer(), Exists(model_name3));
-  EXPECT_CALL(toolkit.observer(), Exists(model_name4));
-  EXPECT_CALL(toolkit.observer(), Read(model_name1, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(model_name2, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(model_name3, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(model_name4, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(model_name1, _));
+  EXPECT_CALL(toolkit.observer(), Get(model_name2, _));
+  EXPECT_CALL(toolkit.observer(), Get(model_name3, _));
+  EXPECT_CALL(toolkit.observer(), Get(model_name4, _));
   ASSERT_TRUE(toolkit.Run());
 }
 
@@ -343,14 +339,10 @@ TEST_F(VMModelTests, model_string_serialisation_test)
   )";
 
   ASSERT_TRUE(toolkit.Compile(graph_deserialise_src));
-  EXPECT_CALL(toolkit.observer(), Exists(state_name1));
-  EXPECT_CALL(toolkit.observer(), Exists(state_name2));
-  EXPECT_CALL(toolkit.observer(), Exists(state_name3));
-  EXPECT_CALL(toolkit.observer(), Exists(state_name4));
-  EXPECT_CALL(toolkit.observer(), Read(state_name1, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(state_name2, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(state_name3, _, _)).Times(::testing::Between(1, 2));
-  EXPECT_CALL(toolkit.observer(), Read(state_name4, _, _)).Times(::testing::Between(1, 2));
+  EXPECT_CALL(toolkit.observer(), Get(state_name1, _));
+  EXPECT_CALL(toolkit.observer(), Get(state_name2, _));
+  EXPECT_CALL(toolkit.observer(), Get(state_name3, _));
+  EXPECT_CALL(toolkit.observer(), Get(state_name4, _));
   ASSERT_TRUE(toolkit.Run());
 }
 
@@ -20,6 +20,7 @@
 #include "vm/array.hpp"
 #include "vm/fixed.hpp"
 #include "vm/map.hpp"
+#include "vm/paged_state.hpp"
 #include "vm/pair.hpp"
 #include "vm_modules/core/byte_array_wrapper.hpp"
 #include "vm_test_toolkit.hpp"
@@ -30,6 +31,8 @@
 
 using namespace fetch::vm;
 using fetch::vm_modules::ByteArrayWrapper;
+using ::testing::Gt;
+using ::testing::HasSubstr;
 
 namespace {
 
@@ -70,8 +73,7 @@ TEST_F(StateTests, AddressSerialisationTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("addr"));
-  EXPECT_CALL(toolkit.observer(), Read("addr", _, _));
+  EXPECT_CALL(toolkit.observer(), Get("addr", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -104,8 +106,7 @@ TEST_F(StateTests, MapDeserializeTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("map"));
-  EXPECT_CALL(toolkit.observer(), Read("map", _, _));
+  EXPECT_CALL(toolkit.observer(), Get("map", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -138,8 +139,7 @@ TEST_F(StateTests, PairDeserializeBothTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), Get("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -171,8 +171,7 @@ TEST_F(StateTests, PairDeserializeFirstOnlyTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), Get("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -204,8 +203,7 @@ TEST_F(StateTests, PairDeserializeSecondOnlyTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), Get("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -236,8 +234,7 @@ TEST_F(StateTests, PairDeserializeNoneTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), Get("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -271,8 +268,7 @@ TEST_F(StateTests, ArrayDeserializeTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("state"));
-  EXPECT_CALL(toolkit.observer(), Read("state", _, _));
+  EXPECT_CALL(toolkit.observer(), Get("state", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -359,8 +355,7 @@ TEST_F(StateTests, test_serialisation_of_complex_type)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -434,8 +429,7 @@ TEST_F(StateTests, test_serialisation_of_complex_type_2)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -554,8 +548,7 @@ TEST_F(StateTests, test_serialisation_of_structured_data)
   )";
 
   toolkit.setStdout(std::cout);
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(2);
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -586,7 +579,6 @@ TEST_F(StateTests,
 
   EXPECT_CALL(toolkit.observer(), Write("account", _, _)).Times(2);
   EXPECT_CALL(toolkit.observer(), Read("account", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("account")).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -610,8 +602,7 @@ TEST_F(StateTests,
   )";
 
   EXPECT_CALL(toolkit.observer(), Write("name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Read("name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("name")).Times(2);
+  EXPECT_CALL(toolkit.observer(), Get("name", _)).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -637,7 +628,6 @@ TEST_F(
 
   EXPECT_CALL(toolkit.observer(), Write("account.balance", _, _)).Times(2);
   EXPECT_CALL(toolkit.observer(), Read("account.balance", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("account.balance")).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -662,8 +652,7 @@ TEST_F(
   )";
 
   EXPECT_CALL(toolkit.observer(), Write("personal_info.name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Read("personal_info.name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("personal_info.name")).Times(2);
+  EXPECT_CALL(toolkit.observer(), Get("personal_info.name", _)).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -698,8 +687,7 @@ TEST_F(StateTests, test_serialisation_of_fixed_point32)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -744,8 +732,7 @@ TEST_F(StateTests, test_serialisation_of_fixed_point64)
       return retrieved_state.get(Array<Fixed64>(0));
     endfunction
   )";
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -789,8 +776,7 @@ TEST_F(StateTests, test_serialisation_of_fixed_point128)
       return retrieved_state.get(Array<Fixed128>(0));
     endfunction
   )";
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), Get(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -808,4 +794,327 @@ TEST_F(StateTests, test_serialisation_of_fixed_point128)
             retval->PopFrontOne().Get<Ptr<fetch::vm::Fixed128>>()->data_);
 }
 
+class PagedStateTests : public StateTests
+{
+protected:
+  bool Compile(char const *text)
+  {
+    if (!toolkit.Compile(text))
+    {
+      return false;
+    }
+
+    toolkit.vm().EnablePagedState(true);
+    return true;
+  }
+};
+
+TEST_F(StateTests, LargeMapIsStoredWholeUnlessPagedStateIsEnabled)
+{
+  static char const *ser_src = R"(
+    function main()
+      var data = Map<Int32, Int32>();
+      for (i in 0:1000)
+        data[i] = i;
+      endfor
+      State<Map<Int32, Int32>>("map").set(data);
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Get(_, _)).Times(0);
+  EXPECT_CALL(toolkit.observer(), Write("map", _, _));
+  EXPECT_CALL(toolkit.observer(), Write(HasSubstr(StatePages::PAGE_KEY_SEPARATOR), _, _))
+      .Times(0);
+
+  ASSERT_TRUE(toolkit.Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+}
+
+TEST_F(StateTests, PageKeysAreOrdinaryStateNamesUnlessPagedStateIsEnabled)
+{
+  static char const *ser_src = R"(
+    function main()
+      State<Int32>("value.__page__.0").set(7);
+
+      var data = Map<Int32, Int32>();
+      for (i in 0:1000)
+        data[i] = i;
+      endfor
+      State<Map<Int32, Int32>>("map.__page__.1").set(data);
+    endfunction
+  )";
+
+  // each value is written whole under its own name, without looking up a previous layout
+  EXPECT_CALL(toolkit.observer(), Get(_, _)).Times(0);
+  EXPECT_CALL(toolkit.observer(), Write("value.__page__.0", _, _));
+  EXPECT_CALL(toolkit.observer(), Write("map.__page__.1", _, _));
+
+  ASSERT_TRUE(toolkit.Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main() : Int32
+      return State<Int32>("value.__page__.0").get() * 10000 +
+             State<Map<Int32, Int32>>("map.__page__.1").get().count();
+    endfunction
+  )";
+
+  // the map is read whole in a single lookup
+  EXPECT_CALL(toolkit.observer(), Get("map.__page__.1", _));
+
+  ASSERT_TRUE(toolkit.Compile(deser_src));
+
+  Variant ret;
+  ASSERT_TRUE(toolkit.Run(&ret));
+  EXPECT_EQ(71000, ret.Get<int32_t>());
+}
+
+TEST_F(PagedStateTests, PageKeysAreReservedStateNames)
+{
+  static char const *TEXT = R"(
+    function main()
+      State<Int32>("map.__page__.0").set(1);
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Write(_, _, _)).Times(0);
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_FALSE(toolkit.Run());
+}
+
+TEST_F(PagedStateTests, LargeMapIsStoredInPages)
+{
+  static char const *ser_src = R"(
+    function main()
+      var data = Map<Int32, Int32>();
+      for (i in 0:1000)
+        data[i] = i * 2;
+      endfor
+      State<Map<Int32, Int32>>("map").set(data);
+    endfunction
+  )";
+
+  auto const num_pages = StatePages::PagesFor(1000);
+
+  EXPECT_CALL(toolkit.observer(), Write("map", _, _));
+  EXPECT_CALL(toolkit.observer(), Write(HasSubstr(StatePages::PAGE_KEY_SEPARATOR), _, _))
+      .Times(static_cast<int>(num_pages));
+
+  ASSERT_TRUE(Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main() : Map<Int32, Int32>
+      return State<Map<Int32, Int32>>("map").get();
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(deser_src));
+
+  Variant ret;
+  ASSERT_TRUE(toolkit.Run(&ret));
+
+  // a map which is returned from the contract is loaded in full
+  auto const map{ret.Get<Ptr<IMap>>()};
+  ASSERT_TRUE(static_cast<bool>(map));
+  ASSERT_EQ(1000, map->Count());
+  auto const value = map->GetIndexedValue(TemplateParameter1{int32_t{499}, TypeIds::Int32});
+  EXPECT_EQ(998, value.Get<int32_t>());
+}
+
+TEST_F(PagedStateTests, LargeMapOnlyWritesModifiedPages)
+{
+  static char const *ser_src = R"(
+    function main()
+      var data = Map<Int32, Int32>();
+      for (i in 0:1000)
+        data[i] = i;
+      endfor
+      State<Map<Int32, Int32>>("map").set(data);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *update_src = R"(
+    function main() : Int32
+      var state = State<Map<Int32, Int32>>("map");
+      var data = state.get();
+      data[42] = data[42] + 100;
+      state.set(data);
+      return data.count();
+    endfunction
+  )";
+
+  // the header and the page holding the updated entry
+  EXPECT_CALL(toolkit.observer(), Get(_, _)).Times(2);
+  EXPECT_CALL(toolkit.observer(), Write("map", _, _)).Times(0);
+  EXPECT_CALL(toolkit.observer(), Write(HasSubstr(StatePages::PAGE_KEY_SEPARATOR), _, _));
+
+  ASSERT_TRUE(Compile(update_src));
+
+  Variant ret;
+  ASSERT_TRUE(toolkit.Run(&ret));
+  EXPECT_EQ(1000, ret.Get<int32_t>());
+
+  static char const *insert_src = R"(
+    function main() : Int32
+      var state = State<Map<Int32, Int32>>("map");
+      var data = state.get();
+      data[-1] = 7;
+      state.set(data);
+      return State<Map<Int32, Int32>>("map").get()[42] + data.count();
+    endfunction
+  )";
+
+  // the header and the page of the new entry, then both again for the second reader
+  EXPECT_CALL(toolkit.observer(), Get(_, _)).Times(4);
+  // the header is only written when the number of entries changes
+  EXPECT_CALL(toolkit.observer(), Write("map", _, _));
+  EXPECT_CALL(toolkit.observer(), Write(HasSubstr(StatePages::PAGE_KEY_SEPARATOR), _, _));
+
+  ASSERT_TRUE(Compile(insert_src));
+  ASSERT_TRUE(toolkit.Run(&ret));
+  EXPECT_EQ(142 + 1001, ret.Get<int32_t>());
+}
+
+TEST_F(PagedStateTests, LargeMapKeepsContentsWhenStateIsOverwritten)
+{
+  static char const *ser_src = R"(
+    function main()
+      var data = Map<String, Int64>();
+      for (i in 0:500)
+        data[toString(i)] = toInt64(i);
+      endfor
+      State<Map<String, Int64>>("map").set(data);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *overwrite_src = R"(
+    function main() : Int64
+      var first = State<Map<String, Int64>>("map").get();
+      var second = State<Map<String, Int64>>("map").get();
+      second["7"] = 700i64;
+      State<Map<String, Int64>>("map").set(second);
+      State<Map<String, Int64>>("map").set(Map<String, Int64>());
+      return first["7"] + second["7"] + toInt64(first.count());
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(overwrite_src));
+
+  Variant ret;
+  ASSERT_TRUE(toolkit.Run(&ret));
+  EXPECT_EQ(7 + 700 + 500, ret.Get<int64_t>());
+}
+
+TEST_F(PagedStateTests, LargeMapKeepsInPlaceModificationsOfObjectValues)
+{
+  static char const *ser_src = R"(
+    function main()
+      var data = Map<String, Array<Int32>>();
+      for (i in 0:300)
+        var values = Array<Int32>(0);
+        values.append(i);
+        data[toString(i)] = values;
+      endfor
+      State<Map<String, Array<Int32>>>("map").set(data);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *update_src = R"(
+    function main()
+      var state = State<Map<String, Array<Int32>>>("map");
+      var data = state.get();
+      data["7"].append(42);
+      state.set(data);
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Write(HasSubstr(StatePages::PAGE_KEY_SEPARATOR), _, _));
+
+  ASSERT_TRUE(Compile(update_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main() : Int32
+      var values = State<Map<String, Array<Int32>>>("map").get()["7"];
+      return values.count() * 100 + values[1];
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(deser_src));
+
+  Variant ret;
+  ASSERT_TRUE(toolkit.Run(&ret));
+  EXPECT_EQ(242, ret.Get<int32_t>());
+}
+
+TEST_F(PagedStateTests, StalePagesAreClearedWhenLayoutChanges)
+{
+  static char const *ser_src = R"(
+    function main()
+      var large = Map<Int32, Int32>();
+      for (i in 0:1000)
+        large[i] = i;
+      endfor
+      State<Map<Int32, Int32>>("large").set(large);
+      State<Map<Int32, Int32>>("replaced").set(large);
+
+      var small = Map<Int32, Int32>();
+      for (i in 0:300)
+        small[i] = i;
+      endfor
+      State<Map<Int32, Int32>>("small").set(small);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  auto const large_pages = StatePages::PagesFor(1000);
+  auto const small_pages = StatePages::PagesFor(300);
+
+  static char const *shrink_src = R"(
+    function main()
+      var small = State<Map<Int32, Int32>>("small").get();
+      State<Map<Int32, Int32>>("large").set(small);
+      State<Map<Int32, Int32>>("replaced").set(Map<Int32, Int32>());
+    endfunction
+  )";
+
+  // the pages of the smaller map, then an empty value for the pages beyond its layout and for
+  // every page of the replaced map
+  EXPECT_CALL(toolkit.observer(), Write("large", _, _));
+  EXPECT_CALL(toolkit.observer(), Write("replaced", _, _));
+  EXPECT_CALL(toolkit.observer(), Write(HasSubstr(StatePages::PAGE_KEY_SEPARATOR), _, Gt(0u)))
+      .Times(static_cast<int>(small_pages));
+  EXPECT_CALL(toolkit.observer(), Write(HasSubstr(StatePages::PAGE_KEY_SEPARATOR), _, 0u))
+      .Times(static_cast<int>((large_pages - small_pages) + large_pages));
+
+  ASSERT_TRUE(Compile(shrink_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main() : Int32
+      return State<Map<Int32, Int32>>("large").get().count() * 10 +
+             State<Map<Int32, Int32>>("replaced").get().count();
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(deser_src));
+
+  Variant ret;
+  ASSERT_TRUE(toolkit.Run(&ret));
+  EXPECT_EQ(3000, ret.Get<int32_t>());
+}
+
 }  // namespace
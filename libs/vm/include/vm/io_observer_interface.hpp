@@ -17,6 +17,8 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/const_byte_array.hpp"
+
 #include <cstdint>
 #include <string>
 
@@ -56,6 +58,20 @@ public:
    */
   virtual Status Read(std::string const &key, void *data, uint64_t &size) = 0;
 
+  /**
+   * Read a value from the state store, without copying it into a caller supplied buffer.
+   *
+   * Unlike Read, the size of the value does not need to be known in advance, so the value is
+   * always retrieved with a single lookup. The default implementation is built on top of Read,
+   * observers with direct access to the stored value should override it.
+   *
+   * @param key The key to be accessed
+   * @param value The output value, which may share the buffer of the stored value
+   * @return OK if the read was successful, PERMISSION_DENIED if the key is incorrect, otherwise
+   * ERROR
+   */
+  virtual Status Get(std::string const &key, byte_array::ConstByteArray &value);
+
   /**
    * Write a value to the state store
    *
@@ -18,11 +18,14 @@
 //------------------------------------------------------------------------------
 
 #include "vectorise/fixed_point/fixed_point.hpp"
+#include "vm/paged_state.hpp"
 #include "vm/vm.hpp"
 
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <string>
+#include <vector>
 
 namespace fetch {
 namespace vm {
@@ -71,8 +74,13 @@ struct MapComparator<T, IfIsPtr<T>>
   }
 };
 
+/**
+ * Map of Etch values. A map read from the state can be backed by the paged state representation,
+ * in which case only the entries on the pages touched by the contract are deserialised and only
+ * the modified pages are written back.
+ */
 template <typename Key, typename Value>
-struct Map : public IMap
+struct Map : public IMap, public IPagedState
 {
   Map(VM *vm, TypeId type_id)
     : IMap(vm, type_id)
@@ -81,11 +89,22 @@ struct Map : public IMap
 
   int32_t Count() const override
   {
+    if (pages_.IsAttached())
+    {
+      return int32_t(pages_.count());
+    }
+
     return int32_t(map.size());
   }
 
   TemplateParameter2 *Find(TemplateParameter1 const &key)
   {
+    // an object value can be modified in place through the returned reference
+    if (!TouchPage(key, IsPtr<Value> ? Access::MODIFY : Access::READ))
+    {
+      return nullptr;
+    }
+
     auto it = map.find(key);
     if (it != map.end())
     {
@@ -127,7 +146,10 @@ struct Map : public IMap
   template <typename U>
   IfIsPrimitive<U> Store(TemplateParameter1 const &key, TemplateParameter2 const &value)
   {
-    map[key] = value;
+    if (TouchPage(key, Access::STORE))
+    {
+      map[key] = value;
+    }
   }
 
   template <typename U>
@@ -135,7 +157,10 @@ struct Map : public IMap
   {
     if (key.object)
     {
-      map[key] = value;
+      if (TouchPage(key, Access::STORE))
+      {
+        map[key] = value;
+      }
       return;
     }
     RuntimeError("map key is null reference");
@@ -148,26 +173,12 @@ struct Map : public IMap
 
   bool SerializeTo(MsgPackSerializer &buffer) override
   {
-    auto constructor = buffer.NewMapConstructor();
-    auto map_ser     = constructor(map.size());
-
-    for (auto const &v : map)
+    if (!LoadAllPages())
     {
-      auto f1 = [&v, this](MsgPackSerializer &serializer) {
-        return SerializeElement<Key>(serializer, v.first);
-      };
-
-      auto f2 = [&v, this](MsgPackSerializer &serializer) {
-        return SerializeElement<Value>(serializer, v.second);
-      };
-
-      if (!map_ser.AppendUsingFunction(f1, f2))
-      {
-        return false;
-      }
+      return false;
     }
 
-    return true;
+    return SerializeEntries(buffer, map.begin(), map.end(), map.size());
   }
 
   bool DeserializeFrom(MsgPackSerializer &buffer) override
@@ -201,9 +212,255 @@ struct Map : public IMap
     return true;
   }
 
+  bool AttachToState(std::string const &name, byte_array::ConstByteArray const &header) override
+  {
+    if (!pages_.Attach(name, header))
+    {
+      return false;
+    }
+
+    map.clear();
+    vm_->AttachPagedState(name, Ptr<Object>::PtrFromThis(this));
+
+    return true;
+  }
+
+  bool IsAttachedTo(std::string const &name) const override
+  {
+    return pages_.IsAttached() && (pages_.name() == name);
+  }
+
+  bool WriteToState(std::string const &name, uint64_t &num_pages) override
+  {
+    if (pages_.IsAttached() && (pages_.name() != name))
+    {
+      // the map is being stored under another name, so it needs all of its current entries
+      if (!Materialise())
+      {
+        return false;
+      }
+    }
+
+    if (!pages_.IsAttached())
+    {
+      if (map.size() < StatePages::MIN_PAGED_ENTRIES)
+      {
+        num_pages = 0;
+        return true;
+      }
+
+      pages_.Reset(name, map.size());
+      vm_->AttachPagedState(name, Ptr<Object>::PtrFromThis(this));
+    }
+    else if (pages_.NeedsRepaging())
+    {
+      if (!LoadAllPages())
+      {
+        return false;
+      }
+
+      pages_.Reset(name, map.size());
+    }
+
+    num_pages = pages_.num_pages();
+    return FlushPages();
+  }
+
+  bool Materialise() override
+  {
+    if (!LoadAllPages())
+    {
+      return false;
+    }
+
+    pages_.Detach();
+    return true;
+  }
+
   std::map<TemplateParameter1, TemplateParameter2, MapComparator<Key>> map;
 
 private:
+  using Entries = std::map<TemplateParameter1, TemplateParameter2, MapComparator<Key>>;
+
+  enum class Access : uint8_t
+  {
+    READ,
+    MODIFY,
+    STORE
+  };
+
+  /**
+   * Ensure the page holding a key is loaded when the map is backed by the paged state
+   *
+   * @param key The key to be accessed
+   * @param access Whether the entry is only read, may be modified in place or is about to be stored
+   * @return true if successful, otherwise false
+   */
+  bool TouchPage(TemplateParameter1 const &key, Access access)
+  {
+    if (!pages_.IsAttached())
+    {
+      return true;
+    }
+
+    uint64_t page{0};
+    if (!PageOf(key, page) || !LoadPage(page))
+    {
+      return false;
+    }
+
+    if ((access == Access::STORE) && (map.find(key) == map.end()))
+    {
+      pages_.SetCount(pages_.count() + 1);
+    }
+
+    if (access != Access::READ)
+    {
+      pages_.MarkDirty(page);
+    }
+
+    return true;
+  }
+
+  bool PageOf(TemplateParameter1 const &key, uint64_t &page)
+  {
+    MsgPackSerializer encoded_key;
+    if (!SerializeElement<Key>(encoded_key, key))
+    {
+      return false;
+    }
+
+    page = pages_.PageOf(encoded_key.data());
+    return true;
+  }
+
+  bool LoadPage(uint64_t page)
+  {
+    if (pages_.IsLoaded(page))
+    {
+      return true;
+    }
+
+    byte_array::ConstByteArray encoded;
+    if (pages_.ReadPage(vm_, page, encoded) != IoObserverInterface::Status::OK)
+    {
+      RuntimeError("Unable to read page " + std::to_string(page) + " of " + pages_.name());
+      return false;
+    }
+
+    MsgPackSerializer buffer{encoded};
+    if (!DeserializeFrom(buffer))
+    {
+      if (!vm_->HasError())
+      {
+        RuntimeError("Unable to deserialise page " + std::to_string(page) + " of " +
+                     pages_.name());
+      }
+      return false;
+    }
+
+    pages_.MarkLoaded(page);
+    return true;
+  }
+
+  bool LoadAllPages()
+  {
+    for (uint64_t page = 0; pages_.IsAttached() && (page < pages_.num_pages()); ++page)
+    {
+      if (!LoadPage(page))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Write every modified page, followed by the header if it has changed. Only the entries which
+   * are held in memory are visited, and pages are marked as modified only after being loaded.
+   */
+  bool FlushPages()
+  {
+    std::map<uint64_t, std::vector<typename Entries::const_iterator>> dirty;
+    for (uint64_t page = 0; page < pages_.num_pages(); ++page)
+    {
+      if (pages_.IsDirty(page))
+      {
+        dirty[page];
+      }
+    }
+
+    for (auto it = map.cbegin(); !dirty.empty() && (it != map.cend()); ++it)
+    {
+      uint64_t page{0};
+      if (!PageOf(it->first, page))
+      {
+        return false;
+      }
+
+      auto entries = dirty.find(page);
+      if (entries != dirty.end())
+      {
+        entries->second.push_back(it);
+      }
+    }
+
+    for (auto const &entries : dirty)
+    {
+      MsgPackSerializer buffer;
+      if (!SerializeEntries(buffer, entries.second.begin(), entries.second.end(),
+                            entries.second.size()))
+      {
+        return false;
+      }
+
+      if (!pages_.WritePage(vm_, entries.first, buffer.data()))
+      {
+        return false;
+      }
+    }
+
+    return pages_.WriteHeader(vm_);
+  }
+
+  static typename Entries::value_type const &Entry(typename Entries::value_type const &v)
+  {
+    return v;
+  }
+
+  static typename Entries::value_type const &Entry(typename Entries::const_iterator const &it)
+  {
+    return *it;
+  }
+
+  template <typename Iterator>
+  bool SerializeEntries(MsgPackSerializer &buffer, Iterator begin, Iterator end, std::size_t size)
+  {
+    auto constructor = buffer.NewMapConstructor();
+    auto map_ser     = constructor(size);
+
+    for (auto it = begin; it != end; ++it)
+    {
+      auto const &v = Entry(*it);
+
+      auto f1 = [&v, this](MsgPackSerializer &serializer) {
+        return SerializeElement<Key>(serializer, v.first);
+      };
+
+      auto f2 = [&v, this](MsgPackSerializer &serializer) {
+        return SerializeElement<Value>(serializer, v.second);
+      };
+
+      if (!map_ser.AppendUsingFunction(f1, f2))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   template <typename U, typename TemplateParameterType>
   IfIsPtr<U, bool> SerializeElement(MsgPackSerializer &buffer, TemplateParameterType const &v)
   {
@@ -248,6 +505,8 @@ private:
     v.Construct(data, type_id);
     return true;
   }
+
+  StatePages pages_;
 };
 
 template <typename Key, template <typename, typename> class Container = Map>
@@ -0,0 +1,171 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "vm/io_observer_interface.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+class VM;
+
+/**
+ * Interface of objects which can be persisted as a small header stored under the state name
+ * together with a number of pages stored under derived sub-keys. Pages are only read when an
+ * entry on them is accessed and only the pages which have been modified are written back.
+ */
+class IPagedState
+{
+public:
+  IPagedState()          = default;
+  virtual ~IPagedState() = default;
+
+  /**
+   * Bind the object to the paged representation stored under the given state name
+   *
+   * @param name The state name
+   * @param header The value stored under the state name
+   * @return true if successful, otherwise false
+   */
+  virtual bool AttachToState(std::string const &name, byte_array::ConstByteArray const &header) = 0;
+
+  /**
+   * Determine if the object is currently backed by the paged representation under a state name
+   *
+   * @param name The state name
+   * @return true if the object is attached to the name, otherwise false
+   */
+  virtual bool IsAttachedTo(std::string const &name) const = 0;
+
+  /**
+   * Write the object to the given state name in its paged representation
+   *
+   * @param name The state name
+   * @param num_pages Set to the number of pages of the written layout, or to zero when the object
+   * should be serialised as a whole instead
+   * @return true if successful, otherwise false
+   */
+  virtual bool WriteToState(std::string const &name, uint64_t &num_pages) = 0;
+
+  /**
+   * Read every page which has not been loaded yet and detach the object from the state, after
+   * which the object no longer depends on the contents of the state store
+   *
+   * @return true if successful, otherwise false
+   */
+  virtual bool Materialise() = 0;
+};
+
+/**
+ * Bookkeeping for a value stored in the paged representation: the page geometry, the load and
+ * modification status of every page and the mapping of encoded keys onto pages.
+ *
+ * Entries are assigned to one of a power of two number of pages by a hash of their encoded key,
+ * so the layout only depends on the contents of the value and is identical on every node.
+ */
+class StatePages
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Status         = IoObserverInterface::Status;
+
+  /// Values with fewer entries than this are stored as a whole
+  static constexpr uint64_t MIN_PAGED_ENTRIES = 256;
+  /// The average number of entries per page when the page layout is chosen
+  static constexpr uint64_t ENTRIES_PER_PAGE = 64;
+  /// The average number of entries per page above which the value is paged again
+  static constexpr uint64_t MAX_ENTRIES_PER_PAGE = 4 * ENTRIES_PER_PAGE;
+
+  static std::string const PAGE_KEY_SEPARATOR;
+
+  static bool        IsHeader(ConstByteArray const &buffer);
+  static uint64_t    PagesFor(uint64_t count);
+  static std::string PageKey(std::string const &name, uint64_t page);
+  static bool        ParsePageKey(std::string const &key, std::string &name);
+  static bool        IsReservedName(std::string const &name);
+
+  /// @name Layout
+  /// @{
+  bool Attach(std::string name, ConstByteArray const &header);
+  void Reset(std::string name, uint64_t count);
+  void Detach();
+
+  bool IsAttached() const
+  {
+    return !name_.empty();
+  }
+
+  std::string const &name() const
+  {
+    return name_;
+  }
+
+  uint64_t count() const
+  {
+    return count_;
+  }
+
+  uint64_t num_pages() const
+  {
+    return status_.size();
+  }
+
+  void     SetCount(uint64_t count);
+  bool     NeedsRepaging() const;
+  uint64_t PageOf(ConstByteArray const &encoded_key) const;
+  /// @}
+
+  /// @name Page status
+  /// @{
+  bool IsLoaded(uint64_t page) const;
+  bool IsDirty(uint64_t page) const;
+  void MarkLoaded(uint64_t page);
+  void MarkDirty(uint64_t page);
+  /// @}
+
+  /// @name State IO
+  /// @{
+  Status ReadPage(VM *vm, uint64_t page, ConstByteArray &encoded) const;
+  bool   WritePage(VM *vm, uint64_t page, ConstByteArray const &encoded);
+  bool   WriteHeader(VM *vm);
+
+  static bool ReadNumPages(VM *vm, std::string const &name, uint64_t &num_pages);
+  static bool ClearPages(VM *vm, std::string const &name, uint64_t first, uint64_t last);
+  /// @}
+
+private:
+  enum class PageStatus : uint8_t
+  {
+    UNLOADED,
+    LOADED,
+    DIRTY
+  };
+
+  std::string             name_;
+  uint64_t                count_{0};
+  std::vector<PageStatus> status_;
+  bool                    header_dirty_{false};
+};
+
+}  // namespace vm
+}  // namespace fetch
@@ -248,6 +248,7 @@ class VM
 public:
   using InputDeviceMap  = std::unordered_map<std::string, std::istream *>;
   using OutputDeviceMap = std::unordered_map<std::string, std::ostream *>;
+  using PagedStateMap   = std::unordered_map<std::string, std::vector<Ptr<Object>>>;
 
   explicit VM(Module *module);
   ~VM() = default;
@@ -380,6 +381,29 @@ public:
     return *io_observer_;
   }
 
+  /// @name Paged State
+  /// @{
+  void AttachPagedState(std::string const &name, Ptr<Object> const &object);
+  bool ReleasePagedState(std::string const &name, Object const *except = nullptr);
+
+  /**
+   * Control whether large values are written in the paged representation. This changes the
+   * contents of the state, so it must only be enabled once the paged layout has been activated.
+   * Values which are already stored in the paged representation can always be read.
+   *
+   * @param enabled Whether paged writes are enabled
+   */
+  void EnablePagedState(bool enabled)
+  {
+    paged_state_enabled_ = enabled;
+  }
+
+  bool IsPagedStateEnabled() const
+  {
+    return paged_state_enabled_;
+  }
+  /// @}
+
   std::ostream &GetOutputDevice(std::string const &name)
   {
     if (output_devices_.find(name) == output_devices_.end())
@@ -667,6 +691,8 @@ private:
   ContractInvocationHandler      contract_invocation_handler_{};
   std::ostringstream             output_buffer_;
   IoObserverInterface *          io_observer_{};
+  PagedStateMap                  paged_states_;
+  bool                           paged_state_enabled_{false};
   OutputDeviceMap                output_devices_;
   InputDeviceMap                 input_devices_;
   DeserializeConstructorMap      deserialization_constructors_;
@@ -688,6 +714,7 @@ private:
 
   bool Execute(std::string &error, Variant &output);
   void Destruct(uint16_t scope_number);
+  void DetachPagedStates(bool materialise);
 
   TypeId FindType(std::string const &name) const
   {
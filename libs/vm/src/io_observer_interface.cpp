@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "vm/io_observer_interface.hpp"
+
+namespace fetch {
+namespace vm {
+namespace {
+
+constexpr uint64_t INITIAL_BUFFER_SIZE = 256;
+
+}  // namespace
+
+/**
+ * Read a value from the state store by means of the buffer based Read interface
+ *
+ * @param key The key to be accessed
+ * @param value The output value
+ * @return OK if the read was successful, PERMISSION_DENIED if the key is incorrect, otherwise ERROR
+ */
+IoObserverInterface::Status IoObserverInterface::Get(std::string const &key,
+                                                     byte_array::ConstByteArray &value)
+{
+  byte_array::ByteArray buffer;
+  buffer.Resize(INITIAL_BUFFER_SIZE);
+
+  uint64_t buffer_size = buffer.size();
+  auto     status      = Read(key, buffer.pointer(), buffer_size);
+
+  if (Status::BUFFER_TOO_SMALL == status)
+  {
+    // the value size is now known, make the second call to the observer
+    buffer.Resize(buffer_size);
+    status = Read(key, buffer.pointer(), buffer_size);
+  }
+
+  if (Status::OK == status)
+  {
+    buffer.Resize(buffer_size);
+    value = buffer;
+  }
+
+  return status;
+}
+
+}  // namespace vm
+}  // namespace fetch
@@ -0,0 +1,409 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/fnv_detail.hpp"
+#include "vm/paged_state.hpp"
+#include "vm/vm.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace fetch {
+namespace vm {
+namespace {
+
+using byte_array::ConstByteArray;
+using serializers::MsgPackSerializer;
+using Fnv64 = crypto::detail::FNV<crypto::detail::FNVConfig<uint64_t>,
+                                  crypto::detail::eFnvAlgorithm::fnv1a>;
+
+// a whole value is always encoded as a msgpack container, which can not start with this tag
+std::string const HEADER_TAG = "fetch.paged";
+
+ConstByteArray const &EncodedHeaderTag()
+{
+  static ConstByteArray const tag = [] {
+    MsgPackSerializer buffer;
+    buffer << HEADER_TAG;
+    return ConstByteArray{buffer.data()};
+  }();
+
+  return tag;
+}
+
+bool ParseHeader(ConstByteArray const &header, uint64_t &count, uint64_t &num_pages)
+{
+  std::string tag;
+
+  try
+  {
+    MsgPackSerializer buffer{header};
+    buffer >> tag >> count >> num_pages;
+  }
+  catch (std::exception const &)
+  {
+    return false;
+  }
+
+  // the number of pages must be a power of two for the key to page mapping
+  return (num_pages != 0) && ((num_pages & (num_pages - 1)) == 0) &&
+         (num_pages <= StatePages::PagesFor(std::numeric_limits<uint32_t>::max()));
+}
+
+}  // namespace
+
+constexpr uint64_t StatePages::MIN_PAGED_ENTRIES;
+constexpr uint64_t StatePages::ENTRIES_PER_PAGE;
+constexpr uint64_t StatePages::MAX_ENTRIES_PER_PAGE;
+
+std::string const StatePages::PAGE_KEY_SEPARATOR = ".__page__.";
+
+/**
+ * Determine if a value read from the state store is the header of a paged value
+ *
+ * @param buffer The encoded value
+ * @return true if the value is a paged header, otherwise false
+ */
+bool StatePages::IsHeader(ConstByteArray const &buffer)
+{
+  auto const &tag = EncodedHeaderTag();
+
+  return (buffer.size() > tag.size()) &&
+         (std::memcmp(buffer.pointer(), tag.pointer(), tag.size()) == 0);
+}
+
+/**
+ * Compute the number of pages for a value with the given number of entries
+ *
+ * @param count The number of entries
+ * @return The number of pages, always a power of two
+ */
+uint64_t StatePages::PagesFor(uint64_t count)
+{
+  uint64_t const required =
+      std::max<uint64_t>(1, (count + ENTRIES_PER_PAGE - 1) / ENTRIES_PER_PAGE);
+
+  uint64_t pages = 1;
+  while (pages < required)
+  {
+    pages <<= 1u;
+  }
+
+  return pages;
+}
+
+/**
+ * Build the state key under which a page of a paged value is stored
+ *
+ * @param name The state name of the value
+ * @param page The page index
+ * @return The page key
+ */
+std::string StatePages::PageKey(std::string const &name, uint64_t page)
+{
+  return name + PAGE_KEY_SEPARATOR + std::to_string(page);
+}
+
+/**
+ * Extract the state name of the value which a page key belongs to
+ *
+ * @param key The state key to be checked
+ * @param name The state name of the value, if the key is a page key
+ * @return true if the key is a page key, otherwise false
+ */
+bool StatePages::ParsePageKey(std::string const &key, std::string &name)
+{
+  auto const pos = key.rfind(PAGE_KEY_SEPARATOR);
+  if ((pos == std::string::npos) || (pos == 0))
+  {
+    return false;
+  }
+
+  auto const index_pos = pos + PAGE_KEY_SEPARATOR.size();
+  if ((index_pos == key.size()) ||
+      !std::all_of(key.begin() + static_cast<std::ptrdiff_t>(index_pos), key.end(),
+                   [](char c) { return (c >= '0') && (c <= '9'); }))
+  {
+    return false;
+  }
+
+  name = key.substr(0, pos);
+  return true;
+}
+
+/**
+ * Determine if a state name is reserved for the pages of paged values. Allowing such a name would
+ * let one value overwrite the pages of another.
+ *
+ * @param name The state name to be checked
+ * @return true if the name can not be used for a state value, otherwise false
+ */
+bool StatePages::IsReservedName(std::string const &name)
+{
+  std::string value_name;
+  return ParsePageKey(name, value_name);
+}
+
+/**
+ * Bind to the layout described by a header read from the state store. All pages start unloaded.
+ *
+ * @param name The state name of the value
+ * @param header The encoded header
+ * @return true if the header is valid, otherwise false
+ */
+bool StatePages::Attach(std::string name, ConstByteArray const &header)
+{
+  if (!IsHeader(header))
+  {
+    return false;
+  }
+
+  uint64_t count{0};
+  uint64_t num_pages{0};
+
+  if (!ParseHeader(header, count, num_pages))
+  {
+    return false;
+  }
+
+  name_  = std::move(name);
+  count_ = count;
+  status_.assign(num_pages, PageStatus::UNLOADED);
+  header_dirty_ = false;
+
+  return true;
+}
+
+/**
+ * Choose a new layout for a value whose entries are all held in memory. Every page is marked as
+ * modified so that the complete value is written on the next flush.
+ *
+ * @param name The state name of the value
+ * @param count The number of entries
+ */
+void StatePages::Reset(std::string name, uint64_t count)
+{
+  name_  = std::move(name);
+  count_ = count;
+  status_.assign(PagesFor(count), PageStatus::DIRTY);
+  header_dirty_ = true;
+}
+
+void StatePages::Detach()
+{
+  name_.clear();
+  count_ = 0;
+  status_.clear();
+  header_dirty_ = false;
+}
+
+void StatePages::SetCount(uint64_t count)
+{
+  if (count != count_)
+  {
+    count_        = count;
+    header_dirty_ = true;
+  }
+}
+
+/**
+ * Determine if the value has grown to the point where its pages should be rebalanced
+ *
+ * @return true if the value should be paged again, otherwise false
+ */
+bool StatePages::NeedsRepaging() const
+{
+  return count_ > (MAX_ENTRIES_PER_PAGE * num_pages());
+}
+
+/**
+ * Map an encoded key onto the page which holds its entry
+ *
+ * @param encoded_key The serialised key
+ * @return The page index
+ */
+uint64_t StatePages::PageOf(ConstByteArray const &encoded_key) const
+{
+  assert(!status_.empty());
+
+  Fnv64 hasher;
+  hasher.update(encoded_key.pointer(), encoded_key.size());
+
+  return hasher.context() & (num_pages() - 1);
+}
+
+bool StatePages::IsLoaded(uint64_t page) const
+{
+  return status_[page] != PageStatus::UNLOADED;
+}
+
+bool StatePages::IsDirty(uint64_t page) const
+{
+  return status_[page] == PageStatus::DIRTY;
+}
+
+void StatePages::MarkLoaded(uint64_t page)
+{
+  status_[page] = PageStatus::LOADED;
+}
+
+void StatePages::MarkDirty(uint64_t page)
+{
+  status_[page] = PageStatus::DIRTY;
+}
+
+/**
+ * Read the encoded entries of a page from the state store
+ *
+ * @param vm The VM providing the IO observer
+ * @param page The page index
+ * @param encoded The encoded entries of the page
+ * @return The status of the underlying read
+ */
+StatePages::Status StatePages::ReadPage(VM *vm, uint64_t page, ConstByteArray &encoded) const
+{
+  if (!vm->HasIoObserver())
+  {
+    return Status::ERROR;
+  }
+
+  return vm->GetIOObserver().Get(PageKey(name_, page), encoded);
+}
+
+/**
+ * Write the encoded entries of a modified page to the state store
+ *
+ * @param vm The VM providing the IO observer
+ * @param page The page index
+ * @param encoded The encoded entries of the page
+ * @return true if successful, otherwise false
+ */
+bool StatePages::WritePage(VM *vm, uint64_t page, ConstByteArray const &encoded)
+{
+  if (vm->HasIoObserver())
+  {
+    auto const status =
+        vm->GetIOObserver().Write(PageKey(name_, page), encoded.pointer(), encoded.size());
+
+    if (status != Status::OK)
+    {
+      return false;
+    }
+  }
+
+  status_[page] = PageStatus::LOADED;
+  return true;
+}
+
+/**
+ * Write the header to the state store if the layout or the number of entries has changed
+ *
+ * @param vm The VM providing the IO observer
+ * @return true if successful, otherwise false
+ */
+bool StatePages::WriteHeader(VM *vm)
+{
+  if (!header_dirty_)
+  {
+    return true;
+  }
+
+  if (vm->HasIoObserver())
+  {
+    MsgPackSerializer buffer;
+    buffer << HEADER_TAG << count_ << num_pages();
+
+    auto const status =
+        vm->GetIOObserver().Write(name_, buffer.data().pointer(), buffer.data().size());
+
+    if (status != Status::OK)
+    {
+      return false;
+    }
+  }
+
+  header_dirty_ = false;
+  return true;
+}
+
+/**
+ * Look up the number of pages of the value currently stored under a state name
+ *
+ * @param vm The VM providing the IO observer
+ * @param name The state name
+ * @param num_pages Set to the number of pages, zero if the name does not hold a paged value
+ * @return true if successful, otherwise false
+ */
+bool StatePages::ReadNumPages(VM *vm, std::string const &name, uint64_t &num_pages)
+{
+  num_pages = 0;
+
+  if (!vm->HasIoObserver())
+  {
+    return true;
+  }
+
+  ConstByteArray buffer;
+  auto const     status = vm->GetIOObserver().Get(name, buffer);
+
+  if (status == Status::PERMISSION_DENIED)
+  {
+    return false;
+  }
+
+  uint64_t count{0};
+  if ((status == Status::OK) && IsHeader(buffer) && !ParseHeader(buffer, count, num_pages))
+  {
+    num_pages = 0;
+  }
+
+  return true;
+}
+
+/**
+ * Clear a range of pages of a value which are no longer part of its layout. The state interface
+ * has no means of removing a key, so each page is overwritten with an empty value.
+ *
+ * @param vm The VM providing the IO observer
+ * @param name The state name of the value
+ * @param first The first page to be cleared
+ * @param last One past the last page to be cleared
+ * @return true if successful, otherwise false
+ */
+bool StatePages::ClearPages(VM *vm, std::string const &name, uint64_t first, uint64_t last)
+{
+  static uint8_t const empty{0};
+
+  for (uint64_t page = first; vm->HasIoObserver() && (page < last); ++page)
+  {
+    if (vm->GetIOObserver().Write(PageKey(name, page), &empty, 0) != Status::OK)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace vm
+}  // namespace fetch
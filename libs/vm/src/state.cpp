@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "vm/io_observer_interface.hpp"
+#include "vm/paged_state.hpp"
 #include "vm/state.hpp"
 
 namespace fetch {
@@ -24,17 +25,18 @@ namespace vm {
 
 namespace {
 
+using Status = IoObserverInterface::Status;
+
 template <typename T, typename = std::enable_if_t<IsPrimitive<T>>>
-bool ReadHelper(TypeId /*type_id*/, std::string const &name, T &val, VM *vm)
+Status ReadHelper(TypeId /*type_id*/, std::string const &name, T &val, VM *vm)
 {
   if (!vm->HasIoObserver())
   {
-    return true;
+    return Status::OK;
   }
 
-  uint64_t   buffer_size = sizeof(T);
-  auto const result      = vm->GetIOObserver().Read(name, &val, buffer_size);
-  return result == IoObserverInterface::Status::OK;
+  uint64_t buffer_size = sizeof(T);
+  return vm->GetIOObserver().Read(name, &val, buffer_size);
 }
 
 template <typename T, typename = std::enable_if_t<IsPrimitive<T>>>
@@ -45,17 +47,36 @@ bool WriteHelper(std::string const &name, T const &val, VM *vm)
     return true;
   }
 
+  uint64_t previous_pages{0};
+  if (vm->IsPagedStateEnabled() &&
+      (!vm->ReleasePagedState(name) || !StatePages::ReadNumPages(vm, name, previous_pages)))
+  {
+    return false;
+  }
+
   auto const result = vm->GetIOObserver().Write(name, &val, sizeof(T));
-  return result == IoObserverInterface::Status::OK;
+  return (result == IoObserverInterface::Status::OK) &&
+         StatePages::ClearPages(vm, name, 0, previous_pages);
 }
 
-bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *vm)
+/**
+ * Read and deserialise an object from the state store. The value is retrieved with a single
+ * lookup and deserialised directly from the buffer held by the observer. Objects stored in the
+ * paged representation only read their header here, their pages are loaded on access.
+ */
+Status ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *vm)
 {
-  using fetch::byte_array::ByteArray;
-
   if (!vm->HasIoObserver())
   {
-    return true;
+    return Status::OK;
+  }
+
+  byte_array::ConstByteArray buffer;
+  auto const                 status = vm->GetIOObserver().Get(name, buffer);
+
+  if (Status::OK != status)
+  {
+    return status;
   }
 
   if (!vm->IsDefaultSerializeConstructable(type_id))
@@ -63,52 +84,39 @@ bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *v
     vm->RuntimeError("Cannot deserialise object of type " + vm->GetTypeName(type_id) +
                      " for which no serialisation constructor exists.");
 
-    return false;
+    return Status::ERROR;
   }
 
   val = vm->DefaultSerializeConstruct(type_id);
 
-  // create an initial buffer size
-  ByteArray buffer;
-  buffer.Resize(256);
-
-  IoObserverInterface &io{vm->GetIOObserver()};
-
-  uint64_t buffer_size = buffer.size();
-  auto     result      = io.Read(name, buffer.pointer(), buffer_size);
-
-  if (IoObserverInterface::Status::OK == result)
+  auto *paged = dynamic_cast<IPagedState *>(val.operator->());
+  if ((paged != nullptr) && vm->IsPagedStateEnabled() && StatePages::IsHeader(buffer))
   {
-    // chop down the size of the buffer
-    buffer.Resize(buffer_size);
-  }
-  else if (IoObserverInterface::Status::BUFFER_TOO_SMALL == result)
-  {
-    // increase the buffer size
-    buffer.Resize(buffer_size);
+    if (!paged->AttachToState(name, buffer))
+    {
+      if (!vm->HasError())
+      {
+        vm->RuntimeError("Invalid paged state header");
+      }
 
-    // make the second call to the io observer
-    result = io.Read(name, buffer.pointer(), buffer_size);
-  }
+      return Status::ERROR;
+    }
 
-  bool retval = false;
+    return Status::OK;
+  }
 
-  // if we successfully extracted the data
-  if (IoObserverInterface::Status::OK == result)
+  MsgPackSerializer byte_buffer{buffer};
+  if (!val->DeserializeFrom(byte_buffer))
   {
-    MsgPackSerializer byte_buffer{buffer};
-
-    retval = val->DeserializeFrom(byte_buffer);
-    if (!retval)
+    if (!vm->HasError())
     {
-      if (!vm->HasError())
-      {
-        vm->RuntimeError("Object deserialisation failed");
-      }
+      vm->RuntimeError("Object deserialisation failed");
     }
+
+    return Status::ERROR;
   }
 
-  return retval;
+  return Status::OK;
 }
 
 bool WriteHelper(std::string const &name, Ptr<Object> const &val, VM *vm)
@@ -124,6 +132,41 @@ bool WriteHelper(std::string const &name, Ptr<Object> const &val, VM *vm)
     return false;
   }
 
+  auto *paged = dynamic_cast<IPagedState *>(val.operator->());
+
+  uint64_t previous_pages{0};
+  if (vm->IsPagedStateEnabled())
+  {
+    // other values read from this name keep the contents they had before the write
+    if (!vm->ReleasePagedState(name, val.operator->()))
+    {
+      return false;
+    }
+
+    // the pages of a previous paged value which are not overwritten must be cleared, a value read
+    // from this name shares its layout and only ever adds pages to it
+    if (((paged == nullptr) || !paged->IsAttachedTo(name)) &&
+        !StatePages::ReadNumPages(vm, name, previous_pages))
+    {
+      return false;
+    }
+  }
+
+  // large values only write the pages which have been modified
+  if ((paged != nullptr) && vm->IsPagedStateEnabled())
+  {
+    uint64_t num_pages{0};
+    if (!paged->WriteToState(name, num_pages))
+    {
+      return false;
+    }
+
+    if (num_pages != 0)
+    {
+      return StatePages::ClearPages(vm, name, num_pages, previous_pages);
+    }
+  }
+
   // convert the type into a byte stream
   MsgPackSerializer buffer;
   if (!val->SerializeTo(buffer))
@@ -137,7 +180,8 @@ bool WriteHelper(std::string const &name, Ptr<Object> const &val, VM *vm)
 
   auto const result =
       vm->GetIOObserver().Write(name, buffer.data().pointer(), buffer.data().size());
-  return result == IoObserverInterface::Status::OK;
+  return (result == IoObserverInterface::Status::OK) &&
+         StatePages::ClearPages(vm, name, 0, previous_pages);
 }
 
 enum class eModifStatus : uint8_t
@@ -213,15 +257,28 @@ private:
     {
       return {value_, template_param_type_id_};
     }
-    if (Existed())
+
+    // without an observer there is no stored value, as Existed() reports
+    auto status = Status::ERROR;
+    if (vm_->HasIoObserver())
     {
-      if (ReadHelper(template_param_type_id_, name_, value_, vm_))
-      {
-        mod_status_ = eModifStatus::deserialised;
-        return {value_, template_param_type_id_};
-      }
+      // a single lookup both checks for the existence of the value and retrieves it
+      status = ReadHelper(template_param_type_id_, name_, value_, vm_);
+    }
+
+    if (Status::OK == status)
+    {
+      mod_status_ = eModifStatus::deserialised;
+      return {value_, template_param_type_id_};
     }
-    else if (default_value != nullptr)
+
+    if (vm_->HasError())
+    {
+      return {};
+    }
+
+    // a value which is present but of the wrong size is not treated as missing
+    if ((default_value != nullptr) && (Status::BUFFER_TOO_SMALL != status))
     {
       return *default_value;
     }
@@ -336,6 +393,14 @@ Ptr<IState> IState::ConstructorFromAddress(VM *vm, TypeId type_id, Ptr<Address>
 Ptr<IState> IState::ConstructIntrinsic(VM *vm, TypeId type_id, TypeId template_param_type_id,
                                        Ptr<String> const &name)
 {
+  // the page key form is only reserved once values can be stored in pages
+  if (name && vm->IsPagedStateEnabled() && StatePages::IsReservedName(name->string()))
+  {
+    vm->RuntimeError("Failed to construct State: the name `" + name->string() +
+                     "` is reserved for paged state");
+    return {};
+  }
+
   return TypeIdAsCanonicalType<StateFactory>(template_param_type_id, vm, type_id,
                                              template_param_type_id, name);
 }
@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "vm/module.hpp"
+#include "vm/paged_state.hpp"
 #include "vm/vm.hpp"
 
 #include <algorithm>
@@ -320,7 +321,13 @@ bool VM::Execute(std::string &error, Variant &output)
       Variant &result = stack_[sp_--];
       output          = std::move(result);
     }
+  }
+
+  // paged state values can only read their pages while the IO observer is in use
+  DetachPagedStates(ok);
 
+  if (!HasError())
+  {
     // Success
     return true;
   }
@@ -344,6 +351,86 @@ bool VM::Execute(std::string &error, Variant &output)
   return false;
 }
 
+/**
+ * Register an object which lazily reads its contents from the paged state stored under a name
+ *
+ * @param name The state name
+ * @param object The paged state object
+ */
+void VM::AttachPagedState(std::string const &name, Ptr<Object> const &object)
+{
+  // an object is only ever backed by a single state name
+  for (auto &entry : paged_states_)
+  {
+    auto &objects = entry.second;
+    objects.erase(std::remove_if(objects.begin(), objects.end(),
+                                 [&object](Ptr<Object> const &other) {
+                                   return other.operator->() == object.operator->();
+                                 }),
+                  objects.end());
+  }
+
+  paged_states_[name].push_back(object);
+}
+
+/**
+ * Load the remaining pages of all objects backed by a state name which is about to be written,
+ * so that they keep the contents they had before the write
+ *
+ * @param name The state name
+ * @param except The object performing the write, if any
+ * @return true if successful, otherwise false
+ */
+bool VM::ReleasePagedState(std::string const &name, Object const *except)
+{
+  auto it = paged_states_.find(name);
+  if (it == paged_states_.end())
+  {
+    return true;
+  }
+
+  auto objects = std::move(it->second);
+  paged_states_.erase(it);
+
+  bool success{true};
+  for (auto &object : objects)
+  {
+    if (object.operator->() == except)
+    {
+      paged_states_[name].push_back(object);
+    }
+    else if (success)
+    {
+      success = dynamic_cast<IPagedState &>(*object).Materialise();
+    }
+  }
+
+  return success;
+}
+
+void VM::DetachPagedStates(bool materialise)
+{
+  auto states = std::move(paged_states_);
+  paged_states_.clear();
+
+  if (!materialise)
+  {
+    return;
+  }
+
+  for (auto &entry : states)
+  {
+    for (auto &object : entry.second)
+    {
+      // objects only referenced from here are destroyed along with the map
+      if ((object.RefCount() > 1) && !dynamic_cast<IPagedState &>(*object).Materialise())
+      {
+        return;
+      }
+    }
+  }
+}
+
 void VM::RuntimeError(std::string const &message)
 {
   uint16_t const    line = function_->FindLineNumber(instruction_pc_);